@@ -0,0 +1,357 @@
+#include <algorithm>
+#include <array>
+#include <chrono>  // NOLINT
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "binder/bind_node_visitor.h"
+#include "catalog/catalog.h"
+#include "catalog/catalog_accessor.h"
+#include "common/scoped_timer.h"
+#include "execution/compiler/compilation_context.h"
+#include "execution/compiler/executable_query.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/value.h"
+#include "execution/vm/vm_defs.h"
+#include "main/db_main.h"
+#include "optimizer/cost_model/cardinality_cost_model.h"
+#include "optimizer/cost_model/trivial_cost_model.h"
+#include "optimizer/optimize_result.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/parse_result.h"
+#include "parser/postgresparser.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "settings/settings_manager.h"
+#include "traffic_cop/traffic_cop_util.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+#include "util/query_exec_util.h"
+
+namespace noisepage {
+namespace {
+/** Number of heap allocations made by the current thread, counted by the replacement operator new below. */
+thread_local uint64_t num_allocations = 0;
+}  // namespace
+}  // namespace noisepage
+
+void *operator new(std::size_t size) {
+  noisepage::num_allocations++;
+  if (void *const ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t size) noexcept { std::free(ptr); }
+
+namespace noisepage {
+
+/**
+ * Runs OLTP statements through every phase of the frontend, the way the traffic cop does: parse, bind, optimize,
+ * compile and execute. The statements have the shapes of the TPC-C New-Order/Payment and YCSB workloads over a small
+ * loaded database, so that the frontend rather than the storage layer dominates.
+ *
+ * Every benchmark runs with the query cache off (Arg 0), where each execution goes through all phases, and on (Arg 1),
+ * where a statement is only planned and compiled on its first execution and later executions only bind new parameter
+ * values, like the extended query protocol with use_query_cache. Besides the overall time per workload transaction,
+ * each phase reports the 50th and 99th percentile of its latency and the number of heap allocations it makes per run,
+ * so that a regression in any single phase is visible.
+ */
+class FrontendBenchmark : public benchmark::Fixture {
+ public:
+  /** A parameterized statement of a workload. */
+  struct Query {
+    /** SQL text, with $n placeholders for the parameters. */
+    std::string sql_;
+    /** Produces the (integer) parameter values for the i-th iteration. */
+    std::function<std::vector<int32_t>(uint64_t)> params_;
+  };
+
+  void SetUp(const benchmark::State &state) final {
+    std::unordered_map<settings::Param, settings::ParamInfo> param_map;
+    settings::SettingsManager::ConstructParamMap(param_map);
+
+    db_main_ = DBMain::Builder()
+                   .SetSettingsParameterMap(std::move(param_map))
+                   .SetUseSettingsManager(true)
+                   .SetUseGC(true)
+                   .SetUseCatalog(true)
+                   .SetUseGCThread(true)
+                   .SetUseStatsStorage(true)
+                   .SetUseExecution(true)
+                   .Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+    stats_storage_ = db_main_->GetStatsStorage();
+    optimizer_timeout_ =
+        static_cast<uint64_t>(db_main_->GetSettingsManager()->GetInt(settings::Param::task_execution_timeout));
+
+    auto *txn = txn_manager_->BeginTransaction();
+    db_oid_ = catalog_->GetDatabaseOid(common::ManagedPointer(txn), catalog::DEFAULT_DATABASE);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    LoadDatabase();
+    for (auto &stats : phase_stats_) stats = {};
+  }
+
+  void TearDown(const benchmark::State &state) final { db_main_.reset(); }
+
+  /** Run the statements of a workload as one transaction per benchmark iteration. */
+  void RunWorkload(benchmark::State *state, const std::vector<Query> &queries) {
+    const bool use_query_cache = state->range(0) != 0;
+    std::vector<CachedQuery> cached_queries(queries.size());
+    uint64_t iteration = 0;
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      auto *txn = txn_manager_->BeginTransaction();
+      for (size_t i = 0; i < queries.size(); i++) {
+        RunQuery(common::ManagedPointer(txn), queries[i], iteration, use_query_cache, &cached_queries[i]);
+      }
+      NOISEPAGE_ASSERT(!txn->MustAbort(), "Workload transaction failed.");
+      txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      iteration++;
+    }
+    state->SetItemsProcessed(state->iterations() * queries.size());
+    ReportPhases(state);
+  }
+
+  /** TPC-C New-Order and Payment statements; the new order is inserted and deleted again to keep the table small. */
+  const std::vector<Query> tpcc_queries_ = {
+      {"SELECT w_tax FROM warehouse WHERE w_id = $1;", [](uint64_t i) { return std::vector<int32_t>{1}; }},
+      {"SELECT d_tax, d_next_o_id FROM district WHERE d_w_id = $1 AND d_id = $2;",
+       [](uint64_t i) { return std::vector<int32_t>{1, District(i)}; }},
+      {"UPDATE district SET d_next_o_id = d_next_o_id + 1 WHERE d_w_id = $1 AND d_id = $2;",
+       [](uint64_t i) { return std::vector<int32_t>{1, District(i)}; }},
+      {"SELECT c_discount, c_last, c_credit FROM customer WHERE c_w_id = $1 AND c_d_id = $2 AND c_id = $3;",
+       [](uint64_t i) { return std::vector<int32_t>{1, District(i), Customer(i)}; }},
+      {"INSERT INTO new_order (no_o_id, no_d_id, no_w_id) VALUES ($1, $2, $3);",
+       [](uint64_t i) { return std::vector<int32_t>{NewOrder(i), District(i), 1}; }},
+      {"SELECT i_price, i_name, i_data FROM item WHERE i_id = $1;",
+       [](uint64_t i) { return std::vector<int32_t>{Item(i)}; }},
+      {"SELECT s_quantity, s_data FROM stock WHERE s_i_id = $1 AND s_w_id = $2;",
+       [](uint64_t i) { return std::vector<int32_t>{Item(i), 1}; }},
+      {"UPDATE stock SET s_quantity = $1, s_ytd = s_ytd + 1 WHERE s_i_id = $2 AND s_w_id = $3;",
+       [](uint64_t i) { return std::vector<int32_t>{static_cast<int32_t>(10 + i % 90), Item(i), 1}; }},
+      {"UPDATE warehouse SET w_ytd = w_ytd + 10 WHERE w_id = $1;", [](uint64_t i) { return std::vector<int32_t>{1}; }},
+      {"UPDATE customer SET c_balance = c_balance - 10 WHERE c_w_id = $1 AND c_d_id = $2 AND c_id = $3;",
+       [](uint64_t i) { return std::vector<int32_t>{1, District(i), Customer(i)}; }},
+      {"DELETE FROM new_order WHERE no_w_id = $1 AND no_d_id = $2 AND no_o_id = $3;",
+       [](uint64_t i) { return std::vector<int32_t>{1, District(i), NewOrder(i)}; }},
+  };
+
+  /** YCSB reads, updates, a short scan, and an insert that is deleted again. */
+  const std::vector<Query> ycsb_queries_ = {
+      {"SELECT field0, field1, field2, field3 FROM usertable WHERE ycsb_key = $1;",
+       [](uint64_t i) { return std::vector<int32_t>{Key(i)}; }},
+      {"UPDATE usertable SET field1 = 'ycsb_update_value' WHERE ycsb_key = $1;",
+       [](uint64_t i) { return std::vector<int32_t>{Key(i * 7)}; }},
+      {"SELECT ycsb_key, field0 FROM usertable WHERE ycsb_key >= $1 AND ycsb_key < $2;",
+       [](uint64_t i) { return std::vector<int32_t>{Key(i), Key(i) + 10}; }},
+      {"INSERT INTO usertable VALUES ($1, 'field0', 'field1', 'field2', 'field3');",
+       [](uint64_t i) { return std::vector<int32_t>{static_cast<int32_t>(NUM_KEYS + i)}; }},
+      {"DELETE FROM usertable WHERE ycsb_key = $1;",
+       [](uint64_t i) { return std::vector<int32_t>{static_cast<int32_t>(NUM_KEYS + i)}; }},
+  };
+
+ private:
+  /** The phases that a statement goes through in the frontend. */
+  enum class Phase : uint8_t { PARSE = 0, BIND, OPTIMIZE, COMPILE, EXECUTE, NUM_PHASES };
+
+  static constexpr std::array<const char *, static_cast<uint8_t>(Phase::NUM_PHASES)> PHASE_NAMES = {
+      "parse", "bind", "optimize", "compile", "execute"};
+
+  /** Latencies and allocations of one phase over the whole benchmark run. */
+  struct PhaseStats {
+    std::vector<uint64_t> latencies_ns_;
+    uint64_t allocations_ = 0;
+  };
+
+  /** What the query cache keeps of a statement: everything up to the executable query. */
+  struct CachedQuery {
+    std::unique_ptr<parser::ParseResult> parse_result_;
+    std::unique_ptr<optimizer::OptimizeResult> optimize_result_;
+    std::unique_ptr<execution::compiler::ExecutableQuery> executable_query_;
+  };
+
+  static constexpr int32_t NUM_DISTRICTS = 10;
+  static constexpr int32_t NUM_CUSTOMERS = 100;
+  static constexpr int32_t NUM_ITEMS = 1000;
+  static constexpr int32_t NUM_KEYS = 1000;
+  static constexpr int32_t ROWS_PER_INSERT = 100;
+
+  static int32_t District(const uint64_t i) { return static_cast<int32_t>(1 + i % NUM_DISTRICTS); }
+  static int32_t Customer(const uint64_t i) { return static_cast<int32_t>(1 + (i * 31) % NUM_CUSTOMERS); }
+  static int32_t Item(const uint64_t i) { return static_cast<int32_t>(1 + (i * 17) % NUM_ITEMS); }
+  static int32_t NewOrder(const uint64_t i) { return static_cast<int32_t>(1000000 + i); }
+  static int32_t Key(const uint64_t i) { return static_cast<int32_t>((i * 13) % NUM_KEYS); }
+
+  /** Create the TPC-C subset and the YCSB table, and load them through the frontend. */
+  void LoadDatabase() {
+    util::QueryExecUtil util(txn_manager_, catalog_, db_main_->GetSettingsManager(), stats_storage_,
+                             optimizer_timeout_);
+    const std::vector<std::string> ddl = {
+        "CREATE TABLE warehouse (w_id INT PRIMARY KEY, w_tax REAL, w_ytd REAL);",
+        "CREATE TABLE district (d_w_id INT, d_id INT, d_tax REAL, d_ytd REAL, d_next_o_id INT, "
+        "PRIMARY KEY (d_w_id, d_id));",
+        "CREATE TABLE customer (c_w_id INT, c_d_id INT, c_id INT, c_last VARCHAR(16), c_credit VARCHAR(2), "
+        "c_discount REAL, c_balance REAL, PRIMARY KEY (c_w_id, c_d_id, c_id));",
+        "CREATE TABLE new_order (no_o_id INT, no_d_id INT, no_w_id INT, PRIMARY KEY (no_w_id, no_d_id, no_o_id));",
+        "CREATE TABLE item (i_id INT PRIMARY KEY, i_price REAL, i_name VARCHAR(24), i_data VARCHAR(50));",
+        "CREATE TABLE stock (s_i_id INT, s_w_id INT, s_quantity INT, s_ytd INT, s_data VARCHAR(50), "
+        "PRIMARY KEY (s_w_id, s_i_id));",
+        "CREATE TABLE usertable (ycsb_key INT PRIMARY KEY, field0 VARCHAR(100), field1 VARCHAR(100), "
+        "field2 VARCHAR(100), field3 VARCHAR(100));"};
+    util.BeginTransaction(db_oid_);
+    for (const auto &query : ddl) {
+      UNUSED_ATTRIBUTE const bool created = util.ExecuteDDL(query, false);
+      NOISEPAGE_ASSERT(created, "Failed to create benchmark table.");
+    }
+    util.EndTransaction(true);
+
+    std::vector<std::string> inserts = {"INSERT INTO warehouse VALUES (1, 0.1, 300000.0);"};
+    for (int32_t d = 1; d <= NUM_DISTRICTS; d++) {
+      inserts.emplace_back("INSERT INTO district VALUES (1, " + std::to_string(d) + ", 0.1, 30000.0, 3001);");
+      inserts.emplace_back(BatchInsert("customer", 1, NUM_CUSTOMERS, [d](int32_t c) {
+        return "(1, " + std::to_string(d) + ", " + std::to_string(c) + ", 'BARBARBAR', 'GC', 0.05, -10.0)";
+      }));
+    }
+    for (int32_t first = 1; first <= NUM_ITEMS; first += ROWS_PER_INSERT) {
+      inserts.emplace_back(BatchInsert("item", first, ROWS_PER_INSERT, [](int32_t i) {
+        return "(" + std::to_string(i) + ", 9.99, 'item_name', 'item_data')";
+      }));
+      inserts.emplace_back(BatchInsert("stock", first, ROWS_PER_INSERT, [](int32_t i) {
+        return "(" + std::to_string(i) + ", 1, 50, 0, 'stock_data')";
+      }));
+    }
+    for (int32_t first = 0; first < NUM_KEYS; first += ROWS_PER_INSERT) {
+      inserts.emplace_back(BatchInsert("usertable", first, ROWS_PER_INSERT, [](int32_t i) {
+        return "(" + std::to_string(i) + ", 'field0', 'field1', 'field2', 'field3')";
+      }));
+    }
+    util.BeginTransaction(db_oid_);
+    for (const auto &query : inserts) {
+      execution::exec::ExecutionSettings settings{};
+      UNUSED_ATTRIBUTE const bool loaded =
+          util.ExecuteDML(query, nullptr, nullptr, nullptr, nullptr, std::make_unique<optimizer::TrivialCostModel>(),
+                          std::nullopt, settings);
+      NOISEPAGE_ASSERT(loaded, "Failed to load benchmark table.");
+    }
+    util.EndTransaction(true);
+  }
+
+  /** @return a multi-row insert into the table, of the rows with the given consecutive ids */
+  static std::string BatchInsert(const std::string &table, const int32_t first_id, const int32_t num_rows,
+                                 const std::function<std::string(int32_t)> &row) {
+    std::string query = "INSERT INTO " + table + " VALUES ";
+    for (int32_t id = first_id; id < first_id + num_rows; id++) query += (id == first_id ? "" : ", ") + row(id);
+    return query + ";";
+  }
+
+  /** Run one statement through all phases, or only execute it if the query cache has it already. */
+  void RunQuery(const common::ManagedPointer<transaction::TransactionContext> txn, const Query &query,
+                const uint64_t iteration, const bool use_query_cache, CachedQuery *const cached) {
+    std::vector<parser::ConstantValueExpression> params;
+    std::vector<type::TypeId> param_types;
+    for (const auto value : query.params_(iteration)) {
+      params.emplace_back(type::TypeId::INTEGER, execution::sql::Integer(value));
+      param_types.emplace_back(type::TypeId::INTEGER);
+    }
+    auto accessor = catalog_->GetAccessor(txn, db_oid_, DISABLED);
+
+    if (!use_query_cache || cached->executable_query_ == nullptr) {
+      CachedQuery planned;
+      Measure(Phase::PARSE, [&] { planned.parse_result_ = parser::PostgresParser::BuildParseTree(query.sql_); });
+      Measure(Phase::BIND, [&] {
+        auto binder = binder::BindNodeVisitor(common::ManagedPointer(accessor), db_oid_);
+        binder.BindNameToNode(common::ManagedPointer(planned.parse_result_), common::ManagedPointer(&params),
+                              common::ManagedPointer(&param_types));
+      });
+      Measure(Phase::OPTIMIZE, [&] {
+        planned.optimize_result_ = trafficcop::TrafficCopUtil::Optimize(
+            txn, common::ManagedPointer(accessor), common::ManagedPointer(planned.parse_result_), db_oid_,
+            stats_storage_, std::make_unique<optimizer::CardinalityCostModel>(), optimizer_timeout_,
+            common::ManagedPointer(&params));
+      });
+      Measure(Phase::COMPILE, [&] {
+        planned.executable_query_ = execution::compiler::CompilationContext::Compile(
+            *planned.optimize_result_->GetPlanNode(), exec_settings_, accessor.get(),
+            execution::compiler::CompilationMode::OneShot, std::nullopt,
+            planned.optimize_result_->GetPlanMetaData());
+      });
+      *cached = std::move(planned);
+    }
+
+    Measure(Phase::EXECUTE, [&] {
+      execution::exec::OutputCallback callback = [](byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {};
+      const auto *const schema = cached->optimize_result_->GetPlanNode()->GetOutputSchema().Get();
+      auto exec_ctx = std::make_unique<execution::exec::ExecutionContext>(
+          db_oid_, txn, callback, schema, common::ManagedPointer(accessor), exec_settings_, DISABLED, DISABLED,
+          DISABLED);
+      exec_ctx->SetParams(common::ManagedPointer<const std::vector<parser::ConstantValueExpression>>(&params));
+      cached->executable_query_->Run(common::ManagedPointer(exec_ctx), execution::vm::ExecutionMode::Interpret);
+    });
+  }
+
+  /** Time a phase and count its allocations. */
+  template <typename F>
+  void Measure(const Phase phase, const F &run) {
+    const uint64_t allocations = num_allocations;
+    uint64_t elapsed_ns = 0;
+    {
+      common::ScopedTimer<std::chrono::nanoseconds> timer(&elapsed_ns);
+      run();
+    }
+    auto &stats = phase_stats_[static_cast<uint8_t>(phase)];
+    stats.allocations_ += num_allocations - allocations;
+    stats.latencies_ns_.emplace_back(elapsed_ns);
+  }
+
+  /** Report the latency percentiles and allocations of every phase as counters. */
+  void ReportPhases(benchmark::State *state) {
+    for (uint8_t phase = 0; phase < static_cast<uint8_t>(Phase::NUM_PHASES); phase++) {
+      auto &stats = phase_stats_[phase];
+      const std::string name = PHASE_NAMES[phase];
+      const auto runs = stats.latencies_ns_.size();
+      std::sort(stats.latencies_ns_.begin(), stats.latencies_ns_.end());
+      const auto percentile_us = [&stats, runs](const uint64_t percentile) {
+        return runs == 0 ? 0.0 : static_cast<double>(stats.latencies_ns_[(runs - 1) * percentile / 100]) / 1000.0;
+      };
+      state->counters[name + "_p50_us"] = percentile_us(50);
+      state->counters[name + "_p99_us"] = percentile_us(99);
+      state->counters[name + "_allocs"] = runs == 0 ? 0.0 : static_cast<double>(stats.allocations_) / runs;
+    }
+  }
+
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  common::ManagedPointer<catalog::Catalog> catalog_;
+  common::ManagedPointer<optimizer::StatsStorage> stats_storage_;
+  uint64_t optimizer_timeout_;
+  catalog::db_oid_t db_oid_;
+  execution::exec::ExecutionSettings exec_settings_{};
+  std::array<PhaseStats, static_cast<uint8_t>(Phase::NUM_PHASES)> phase_stats_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(FrontendBenchmark, TPCC)(benchmark::State &state) { RunWorkload(&state, tpcc_queries_); }
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(FrontendBenchmark, YCSB)(benchmark::State &state) { RunWorkload(&state, ycsb_queries_); }
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(FrontendBenchmark, TPCC)->ArgName("query_cache")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(FrontendBenchmark, YCSB)->ArgName("query_cache")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+// clang-format on
+
+}  // namespace noisepage
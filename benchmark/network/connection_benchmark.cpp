@@ -0,0 +1,95 @@
+#include <memory>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "main/db_main.h"
+#include "network/noisepage_server.h"
+#include "settings/settings_manager.h"
+#include "test_util/manual_packet_util.h"
+
+namespace noisepage {
+
+/**
+ * Opens and closes Postgres connections as fast as possible, the way clients that connect for every request do. Each
+ * connection goes through the startup handshake and is terminated right after the server is ready for queries, so this
+ * measures the cost of setting up and tearing down connections, which the network layer keeps low by reusing
+ * connection handles, their buffers and protocol interpreters.
+ */
+class ConnectionBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) final {
+    std::unordered_map<settings::Param, settings::ParamInfo> param_map;
+    settings::SettingsManager::ConstructParamMap(param_map);
+
+    db_main_ = DBMain::Builder()
+                   .SetSettingsParameterMap(std::move(param_map))
+                   .SetUseSettingsManager(true)
+                   .SetUseGC(true)
+                   .SetUseCatalog(true)
+                   .SetUseGCThread(true)
+                   .SetUseTrafficCop(true)
+                   .SetUseStatsStorage(true)
+                   .SetUseNetwork(true)
+                   .SetUseExecution(true)
+                   .Build();
+    db_main_->GetNetworkLayer()->GetServer()->RunServer();
+    port_ = static_cast<uint16_t>(db_main_->GetSettingsManager()->GetInt(settings::Param::port));
+  }
+
+  void TearDown(const benchmark::State &state) final { db_main_.reset(); }
+
+  /**
+   * Connect, wait for the server to be ready, disconnect and wait for the server to close the connection.
+   * @param num_connections number of connections to open one after the other
+   */
+  void ConnectAndDisconnect(const uint32_t num_connections) const {
+    for (uint32_t i = 0; i < num_connections; i++) {
+      auto io_socket = network::ManualPacketUtil::StartConnection(port_);
+      network::ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+      network::ManualPacketUtil::ReadUntilReadyOrClose(common::ManagedPointer(io_socket));
+      io_socket->Close();
+    }
+  }
+
+  static constexpr uint32_t NUM_CONNECTIONS = 1000;
+  static constexpr uint32_t NUM_CLIENTS = 8;
+
+  std::unique_ptr<DBMain> db_main_;
+  uint16_t port_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ConnectionBenchmark, SequentialClient)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    ConnectAndDisconnect(NUM_CONNECTIONS);
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_CONNECTIONS);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ConnectionBenchmark, ConcurrentClients)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    std::vector<std::thread> clients;
+    clients.reserve(NUM_CLIENTS);
+    for (uint32_t i = 0; i < NUM_CLIENTS; i++) {
+      clients.emplace_back([this] { ConnectAndDisconnect(NUM_CONNECTIONS / NUM_CLIENTS); });
+    }
+    for (auto &client : clients) client.join();
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_CONNECTIONS);
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(ConnectionBenchmark, SequentialClient)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_REGISTER_F(ConnectionBenchmark, ConcurrentClients)->Unit(benchmark::kMillisecond)->UseRealTime();
+// clang-format on
+
+}  // namespace noisepage
@@ -0,0 +1,109 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "execution/exec/output.h"
+#include "execution/sql/value.h"
+#include "network/network_io_utils.h"
+#include "network/postgres/postgres_packet_writer.h"
+#include "parser/expression/constant_value_expression.h"
+
+namespace noisepage {
+
+/**
+ * Streams the result of a large SELECT into a WriteQueue, the way OutputWriter does for every OutputBuffer batch
+ * produced by the execution engine. This measures only the cost of serializing DataRow messages, not the socket I/O.
+ */
+class DataRowBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) final {
+    std::vector<planner::OutputSchema::Column> columns;
+    for (const auto type : {type::TypeId::INTEGER, type::TypeId::BIGINT, type::TypeId::REAL, type::TypeId::DATE,
+                            type::TypeId::TIMESTAMP, type::TypeId::VARCHAR}) {
+      columns.emplace_back("col" + std::to_string(columns.size()), type,
+                           std::make_unique<parser::ConstantValueExpression>(type));
+    }
+    const auto layout = network::PostgresPacketWriter::ComputeDataRowLayout(columns, {network::FieldFormat::text});
+    const auto &last = layout.back();
+    tuple_size_ = last.offset_ + execution::sql::ValUtil::GetSqlSize(last.type_);
+    tuple_size_ = static_cast<uint32_t>(common::MathUtil::AlignTo(tuple_size_, alignof(uint64_t)));
+
+    // Fill a batch of rows in the layout of an OutputBuffer
+    std::default_random_engine generator;
+    std::uniform_int_distribution<int64_t> int_distribution(-1000000000, 1000000000);
+    std::uniform_real_distribution<double> real_distribution(-1000.0, 1000.0);
+    std::uniform_int_distribution<int32_t> day_distribution(1, 28);
+    tuples_.resize(static_cast<size_t>(tuple_size_) * execution::exec::OutputBuffer::BATCH_SIZE);
+    for (uint32_t row = 0; row < execution::exec::OutputBuffer::BATCH_SIZE; row++) {
+      byte *const tuple = tuples_.data() + row * tuple_size_;
+      new (tuple + layout[0].offset_) execution::sql::Integer(int_distribution(generator));
+      new (tuple + layout[1].offset_) execution::sql::Integer(int_distribution(generator) * 1000);
+      new (tuple + layout[2].offset_) execution::sql::Real(real_distribution(generator));
+      new (tuple + layout[3].offset_)
+          execution::sql::DateVal(execution::sql::Date::FromYMD(2020, 1 + row % 12, day_distribution(generator)));
+      new (tuple + layout[4].offset_) execution::sql::TimestampVal(
+          execution::sql::Timestamp::FromYMDHMSMU(2020, 1 + row % 12, day_distribution(generator), 12, 30, 15, 250, 5));
+      new (tuple + layout[5].offset_) execution::sql::StringVal(STRING_VALUE, sizeof(STRING_VALUE) - 1);
+    }
+    schema_ = std::make_unique<planner::OutputSchema>(std::move(columns));
+  }
+
+  void TearDown(const benchmark::State &state) final {
+    schema_.reset();
+    tuples_.clear();
+  }
+
+  /**
+   * Serialize NUM_ROWS rows in batches, flushing the write queue after every batch as the network layer would.
+   * @param field_format format the columns are sent in
+   */
+  void StreamResult(const network::FieldFormat field_format) {
+    network::WriteQueue queue;
+    network::PostgresPacketWriter writer{common::ManagedPointer<network::WriteQueue>(&queue)};
+    const std::vector<network::FieldFormat> field_formats{field_format};
+    execution::exec::OutputWriter output_writer(common::ManagedPointer<planner::OutputSchema>(schema_),
+                                                common::ManagedPointer<network::PostgresPacketWriter>(&writer),
+                                                field_formats);
+    for (uint32_t row = 0; row < NUM_ROWS; row += execution::exec::OutputBuffer::BATCH_SIZE) {
+      output_writer(tuples_.data(), execution::exec::OutputBuffer::BATCH_SIZE, tuple_size_);
+      queue.Reset();
+    }
+  }
+
+  static constexpr uint32_t NUM_ROWS = 1 << 20;
+  static constexpr char STRING_VALUE[] = "a string that is too long to be inlined";
+
+  std::unique_ptr<planner::OutputSchema> schema_;
+  std::vector<byte> tuples_;
+  uint32_t tuple_size_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(DataRowBenchmark, TextFormat)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    StreamResult(network::FieldFormat::text);
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_ROWS);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(DataRowBenchmark, BinaryFormat)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    StreamResult(network::FieldFormat::binary);
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_ROWS);
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(DataRowBenchmark, TextFormat)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(DataRowBenchmark, BinaryFormat)->Unit(benchmark::kMillisecond);
+// clang-format on
+
+}  // namespace noisepage
@@ -6,6 +6,7 @@
 
 #include "benchmark/benchmark.h"
 #include "parser/delete_statement.h"
+#include "parser/expression/abstract_expression.h"
 #include "parser/insert_statement.h"
 #include "parser/postgresparser.h"
 #include "parser/update_statement.h"
@@ -117,6 +118,24 @@ class ParserBenchmark : public benchmark::Fixture {
       os << (i != 0 ? " OR " : "") << "my_column = '" << i << "'";
     }
     deletes_complex_ = {"DELETE FROM xxx WHERE " + os.str() + ";"};
+
+    // -------------------------------
+    // POINT QUERIES
+    // -------------------------------
+
+    // The short statements that OLTP clients send at high rates, where the cost of building and freeing the parse
+    // tree is a large part of the frontend's work
+    // clang-format off
+    point_queries_ = {
+        "SELECT c_balance, c_first, c_middle, c_last FROM customer WHERE c_w_id = 1 AND c_d_id = 2 AND c_id = 3;",
+        "UPDATE district SET d_next_o_id = d_next_o_id + 1 WHERE d_w_id = 1 AND d_id = 2;",
+        "INSERT INTO new_order (no_o_id, no_d_id, no_w_id) VALUES (3001, 2, 1);",
+        "DELETE FROM new_order WHERE no_o_id = 3001 AND no_d_id = 2 AND no_w_id = 1;",
+        "SELECT s_quantity, s_data FROM stock WHERE s_i_id = $1 AND s_w_id = $2;",
+        "BEGIN;",
+        "COMMIT;"
+    };
+    // clang-format on
   }
 
   void TearDown(const benchmark::State &state) final {
@@ -131,6 +150,10 @@ class ParserBenchmark : public benchmark::Fixture {
   std::vector<std::string> inserts_complex_;
   std::vector<std::string> deletes_simple_;
   std::vector<std::string> deletes_complex_;
+  std::vector<std::string> point_queries_;
+
+  /** Number of parse trees that are alive at the same time in HeldParseTrees, e.g., in a statement cache. */
+  static constexpr uint32_t NUM_HELD_PARSE_TREES = 1000;
 };
 
 // NOLINTNEXTLINE
@@ -215,6 +238,51 @@ BENCHMARK_DEFINE_F(ParserBenchmark, NOOPs)(benchmark::State &state) {
   state.SetItemsProcessed(state.iterations());
 }
 
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ParserBenchmark, PointQueries)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    for (const auto &sql : point_queries_) {
+      auto result = parser::PostgresParser::BuildParseTree(sql);
+      NOISEPAGE_ASSERT(result->NumStatements() == 1, "Failed to parse point query");
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * point_queries_.size());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ParserBenchmark, HeldParseTrees)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    std::vector<std::unique_ptr<parser::ParseResult>> results;
+    results.reserve(NUM_HELD_PARSE_TREES);
+    for (uint32_t i = 0; i < NUM_HELD_PARSE_TREES; i++) {
+      results.emplace_back(parser::PostgresParser::BuildParseTree(point_queries_[i % point_queries_.size()]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_HELD_PARSE_TREES);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ParserBenchmark, ExpressionCopies)(benchmark::State &state) {
+  std::vector<std::unique_ptr<parser::ParseResult>> results;
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> exprs;
+  for (const auto &sql : selects_simple_) {
+    results.emplace_back(parser::PostgresParser::BuildParseTree(sql));
+    const auto select = results.back()->GetStatement(0).CastManagedPointerTo<parser::SelectStatement>();
+    for (const auto &column : select->GetSelectColumns()) exprs.emplace_back(column);
+    exprs.emplace_back(select->GetSelectCondition());
+  }
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    for (const auto &expr : exprs) {
+      auto copy = expr->Copy();
+      benchmark::DoNotOptimize(copy);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * exprs.size());
+}
+
 // ----------------------------------------------------------------------------
 // BENCHMARK REGISTRATION
 // ----------------------------------------------------------------------------
@@ -228,6 +296,9 @@ BENCHMARK_REGISTER_F(ParserBenchmark, InsertsComplex)->Unit(benchmark::kNanoseco
 BENCHMARK_REGISTER_F(ParserBenchmark, DeletesSimple)->Unit(benchmark::kNanosecond);
 BENCHMARK_REGISTER_F(ParserBenchmark, DeletesComplex)->Unit(benchmark::kNanosecond);
 BENCHMARK_REGISTER_F(ParserBenchmark, NOOPs)->Unit(benchmark::kNanosecond);
+BENCHMARK_REGISTER_F(ParserBenchmark, PointQueries)->Unit(benchmark::kNanosecond);
+BENCHMARK_REGISTER_F(ParserBenchmark, HeldParseTrees)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(ParserBenchmark, ExpressionCopies)->Unit(benchmark::kNanosecond);
 // clang-format on
 
 }  // namespace noisepage
@@ -395,6 +395,8 @@ class ExecutionRunners : public benchmark::Fixture {
     exec_settings.is_pipeline_metrics_enabled_ = true;
     exec_settings.is_parallel_execution_enabled_ = (num_threads != 0);
     exec_settings.number_of_parallel_execution_threads_ = num_threads;
+    // Every pipeline runs with the requested number of threads, regardless of the size of its input
+    exec_settings.parallel_execution_rows_per_thread_ = 0;
     exec_settings.is_counters_enabled_ = counters;
     exec_settings.is_static_partitioner_enabled_ = true;
     return exec_settings;
@@ -19,4 +19,7 @@ BENCHMARKS_TO_RUN = {
     "cuckoomap_benchmark": DEFAULT_FAILURE_THRESHOLD,
     "parser_benchmark": 20,
     "slot_iterator_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "data_row_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "connection_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "frontend_benchmark": DEFAULT_FAILURE_THRESHOLD,
 }
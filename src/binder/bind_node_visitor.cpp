@@ -32,6 +32,7 @@
 #include "parser/expression/type_cast_expression.h"
 #include "parser/parse_result.h"
 #include "parser/statements.h"
+#include "storage/recovery/index_expression_evaluator.h"
 
 namespace noisepage::binder {
 
@@ -117,15 +118,8 @@ void BindNodeVisitor::Visit(common::ManagedPointer<parser::CopyStatement> node)
   context_ = common::ManagedPointer(&context);
 
   if (node->GetCopyTable() != nullptr) {
+    // Only COPY FROM names a table, the parser turns COPY table TO into COPY (SELECT ... FROM table) TO
     node->GetCopyTable()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
-
-    // If the table is given, we're either writing or reading all columns
-    parser::TableStarExpression table_star = parser::TableStarExpression();
-    std::vector<common::ManagedPointer<parser::AbstractExpression>> new_select_list;
-    context_->GenerateAllColumnExpressions(common::ManagedPointer<parser::TableStarExpression>(&table_star),
-                                           sherpa_->GetParseResult(), common::ManagedPointer(&new_select_list));
-    auto col = node->GetSelectStatement()->GetSelectColumns();
-    col.insert(std::end(col), std::begin(new_select_list), std::end(new_select_list));
   } else {
     node->GetSelectStatement()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
   }
@@ -235,6 +229,18 @@ void BindNodeVisitor::Visit(common::ManagedPointer<parser::CreateStatement> node
                                    common::ErrorCode::ERRCODE_INVALID_OBJECT_DEFINITION);
         }
       }
+      if (node->GetIndexPredicate() != nullptr) {
+        auto predicate = node->GetIndexPredicate();
+        predicate->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
+        BinderUtil::ValidateWhereClause(predicate);
+        predicate->DeriveDepth();
+        predicate->DeriveSubqueryFlag();
+        if (predicate->HasSubquery()) {
+          throw BINDER_EXCEPTION("Cannot use subquery in index predicate.",
+                                 common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+        }
+      }
+      ValidateIndexExpressions(node);
       break;
     case parser::CreateStatement::CreateType::kTrigger:
       ValidateDatabaseName(node->GetDatabaseName());
@@ -376,7 +382,7 @@ void BindNodeVisitor::Visit(common::ManagedPointer<parser::InsertStatement> node
                             table->GetTableName());
 
   auto binder_table_data = context_->GetTableMapping(table->GetTableName());
-  const auto &table_schema = std::get<2>(*binder_table_data);
+  const auto &table_schema = *std::get<2>(*binder_table_data);
 
   // Perform input validation and and input conversion, e.g., parsing of strings into dates.
   {
@@ -616,7 +622,7 @@ void BindNodeVisitor::Visit(common::ManagedPointer<parser::UpdateStatement> node
   }
 
   auto binder_table_data = context_->GetTableMapping(table_ref->GetTableName());
-  const auto &table_schema = std::get<2>(*binder_table_data);
+  const auto &table_schema = *std::get<2>(*binder_table_data);
 
   for (auto &update : node->GetUpdateClauses()) {
     auto expr = update->GetUpdateValue();
@@ -674,7 +680,7 @@ void BindNodeVisitor::Visit(common::ManagedPointer<parser::ColumnValueExpression
   //  That is, the object would not be initialized using ColumnValueExpression(database_oid, table_oid, column_oid)
   //  at this point
   if (expr->GetTableOid() == catalog::INVALID_TABLE_OID) {
-    std::tuple<catalog::db_oid_t, catalog::table_oid_t, catalog::Schema> tuple;
+    BinderContext::TableMetadata tuple;
     std::string table_name = expr->GetTableName();
     std::string col_name = expr->GetColumnName();
     if (table_name.empty() && col_name.empty() && expr->GetColumnOid() != catalog::INVALID_COLUMN_OID) {
@@ -695,7 +701,7 @@ void BindNodeVisitor::Visit(common::ManagedPointer<parser::ColumnValueExpression
     } else {
       // Table name is present
       if (context_ != nullptr && context_->GetRegularTableObj(table_name, expr, common::ManagedPointer(&tuple))) {
-        if (!BinderContext::ColumnInSchema(std::get<2>(tuple), col_name)) {
+        if (!BinderContext::ColumnInSchema(*std::get<2>(tuple), col_name)) {
           throw BINDER_EXCEPTION(fmt::format("column \"{}\" does not exist", col_name),
                                  common::ErrorCode::ERRCODE_UNDEFINED_COLUMN);
         }
@@ -969,6 +975,36 @@ void BindNodeVisitor::ValidateDatabaseName(const std::string &db_name) {
                              common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
   }
 }
+
+void BindNodeVisitor::ValidateIndexExpressions(const common::ManagedPointer<parser::CreateStatement> node) {
+  const auto &attrs = node->GetIndexAttributes();
+  const bool has_expressions = node->GetIndexPredicate() != nullptr ||
+                               std::any_of(attrs.begin(), attrs.end(), [](const auto &attr) { return attr.HasExpr(); });
+  // Indexes on plain columns are rebuilt by copying the columns
+  if (!has_expressions) return;
+
+  const auto &table_schema = catalog_accessor_->GetSchema(catalog_accessor_->GetTableOid(node->GetTableName()));
+  for (const auto &attr : attrs) {
+    if (attr.HasExpr()) {
+      if (!storage::IndexExpressionEvaluator::IsSupported(
+              attr.GetExpression().CastManagedPointerTo<const parser::AbstractExpression>())) {
+        throw BINDER_EXCEPTION("Index key expression is not supported.",
+                               common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+      }
+    } else if (table_schema.GetColumn(attr.GetName()).Type() == type::TypeId::DECIMAL) {
+      throw BINDER_EXCEPTION(
+          fmt::format("DECIMAL column {} is not supported in an index with expressions.", attr.GetName()),
+          common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+    }
+  }
+  if (node->GetIndexPredicate() != nullptr &&
+      !storage::IndexExpressionEvaluator::IsSupported(
+          node->GetIndexPredicate().CastManagedPointerTo<const parser::AbstractExpression>())) {
+    throw BINDER_EXCEPTION("Index predicate expression is not supported.",
+                           common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+  }
+}
+
 void BindNodeVisitor::ValidateAndCorrectInsertValues(
     common::ManagedPointer<parser::InsertStatement> node,
     std::vector<common::ManagedPointer<parser::AbstractExpression>> *values, const catalog::Schema &table_schema) {
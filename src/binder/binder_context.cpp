@@ -57,8 +57,7 @@ void BinderContext::AddRegularTable(const common::ManagedPointer<catalog::Catalo
     }
   }
 
-  // TODO(Matt): deep copy of schema, should not be done
-  auto schema = accessor->GetSchema(table_id);
+  const auto &schema = accessor->GetSchema(table_id);
 
   if (nested_table_alias_map_.find(table_alias) != nested_table_alias_map_.end()) {
     throw BINDER_EXCEPTION(fmt::format("Duplicate alias \"{}\"", table_alias),
@@ -69,7 +68,7 @@ void BinderContext::AddRegularTable(const common::ManagedPointer<catalog::Catalo
     throw BINDER_EXCEPTION(fmt::format("Duplicate alias \"{}\"", table_alias),
                            common::ErrorCode::ERRCODE_DUPLICATE_ALIAS);
   }
-  regular_table_alias_map_[table_alias] = std::make_tuple(db_id, table_id, schema);
+  regular_table_alias_map_[table_alias] = std::make_tuple(db_id, table_id, common::ManagedPointer(&schema));
   regular_table_alias_list_.push_back(table_alias);
 }
 
@@ -171,10 +170,9 @@ bool BinderContext::ColumnInSchema(const catalog::Schema &schema, const std::str
   return true;
 }
 
-void BinderContext::SetColumnPosTuple(const std::string &col_name,
-                                      std::tuple<catalog::db_oid_t, catalog::table_oid_t, catalog::Schema> tuple,
+void BinderContext::SetColumnPosTuple(const std::string &col_name, const TableMetadata &tuple,
                                       common::ManagedPointer<parser::ColumnValueExpression> expr) {
-  auto column_object = std::get<2>(tuple).GetColumn(col_name);
+  const auto &column_object = std::get<2>(tuple)->GetColumn(col_name);
   expr->SetDatabaseOID(std::get<0>(tuple));
   expr->SetTableOID(std::get<1>(tuple));
   expr->SetColumnOID(column_object.Oid());
@@ -210,7 +208,7 @@ bool BinderContext::SetColumnPosTuple(common::ManagedPointer<parser::ColumnValue
   while (current_context != nullptr) {
     // Check regular table
     for (auto &entry : current_context->regular_table_alias_map_) {
-      bool get_matched = ColumnInSchema(std::get<2>(entry.second), col_name);
+      bool get_matched = ColumnInSchema(*std::get<2>(entry.second), col_name);
       if (get_matched) {
         if (!find_matched) {
           // First match
@@ -253,9 +251,9 @@ bool BinderContext::SetColumnPosTuple(common::ManagedPointer<parser::ColumnValue
   return false;
 }
 
-bool BinderContext::GetRegularTableObj(
-    const std::string &alias, common::ManagedPointer<parser::ColumnValueExpression> expr,
-    common::ManagedPointer<std::tuple<catalog::db_oid_t, catalog::table_oid_t, catalog::Schema>> tuple) {
+bool BinderContext::GetRegularTableObj(const std::string &alias,
+                                       common::ManagedPointer<parser::ColumnValueExpression> expr,
+                                       common::ManagedPointer<TableMetadata> tuple) {
   auto current_context = common::ManagedPointer(this);
   while (current_context != nullptr) {
     auto iter = current_context->regular_table_alias_map_.find(alias);
@@ -306,8 +304,8 @@ void BinderContext::GenerateAllColumnExpressions(
     }
 
     target_found = true;
-    auto table_data = regular_table_alias_map_[entry];
-    auto &schema = std::get<2>(table_data);
+    const auto &table_data = regular_table_alias_map_[entry];
+    const auto &schema = *std::get<2>(table_data);
     const auto col_cnt = schema.GetColumns().size();
     for (std::uint32_t i = 0; i < col_cnt; ++i) {
       const auto &col_obj = schema.GetColumn(i);
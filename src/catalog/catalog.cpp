@@ -213,7 +213,9 @@ std::unique_ptr<CatalogAccessor> Catalog::GetAccessor(const common::ManagedPoint
                                   transaction::TransactionUtil::NewerThan(last_ddl_change, cache->OldestEntry());
     if (invalidate_cache) cache->Reset(txn->StartTime());
   }
-  return std::make_unique<CatalogAccessor>(common::ManagedPointer(this), dbc, txn, cache);
+  // Connections that cache catalog lookups also read through the metadata snapshot that all connections share
+  const auto snapshot = cache != DISABLED ? dbc->GetSnapshot(txn) : nullptr;
+  return std::make_unique<CatalogAccessor>(common::ManagedPointer(this), dbc, txn, cache, snapshot);
 }
 
 bool Catalog::CreateDatabaseEntry(const common::ManagedPointer<transaction::TransactionContext> txn, const db_oid_t db,
@@ -6,7 +6,9 @@
 
 #include "catalog/catalog.h"
 #include "catalog/catalog_cache.h"
+#include "catalog/catalog_snapshot.h"
 #include "catalog/database_catalog.h"
+#include "catalog/index_schema.h"
 #include "catalog/postgres/pg_proc.h"
 
 namespace noisepage::catalog {
@@ -38,6 +40,10 @@ void CatalogAccessor::SetSearchPath(std::vector<namespace_oid_t> namespaces) {
 namespace_oid_t CatalogAccessor::GetNamespaceOid(std::string name) const {
   if (name.empty()) return catalog::postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID;
   NormalizeObjectName(&name);
+  if (const auto snapshot = Snapshot(); snapshot != nullptr) {
+    return CatalogSnapshot::GetOrLoad(&snapshot->namespace_oids_, name,
+                                      [&] { return dbc_->GetNamespaceOid(txn_, name); });
+  }
   return dbc_->GetNamespaceOid(txn_, name);
 }
 
@@ -50,8 +56,13 @@ bool CatalogAccessor::DropNamespace(namespace_oid_t ns) const { return dbc_->Del
 
 table_oid_t CatalogAccessor::GetTableOid(std::string name) const {
   NormalizeObjectName(&name);
+  const auto snapshot = Snapshot();
   for (const auto &path : search_path_) {
-    table_oid_t search_result = dbc_->GetTableOid(txn_, path, name);
+    table_oid_t search_result =
+        snapshot != nullptr
+            ? CatalogSnapshot::GetOrLoad(&snapshot->table_oids_, {path.UnderlyingValue(), name},
+                                         [&] { return dbc_->GetTableOid(txn_, path, name); })
+            : dbc_->GetTableOid(txn_, path, name);
     if (search_result != INVALID_TABLE_OID) return search_result;
   }
   return INVALID_TABLE_OID;
@@ -59,6 +70,10 @@ table_oid_t CatalogAccessor::GetTableOid(std::string name) const {
 
 table_oid_t CatalogAccessor::GetTableOid(namespace_oid_t ns, std::string name) const {
   NormalizeObjectName(&name);
+  if (const auto snapshot = Snapshot(); snapshot != nullptr) {
+    return CatalogSnapshot::GetOrLoad(&snapshot->table_oids_, {ns.UnderlyingValue(), name},
+                                      [&] { return dbc_->GetTableOid(txn_, ns, name); });
+  }
   return dbc_->GetTableOid(txn_, ns, name);
 }
 
@@ -84,6 +99,10 @@ common::ManagedPointer<storage::SqlTable> CatalogAccessor::GetTable(table_oid_t
     NOISEPAGE_ASSERT(result != temp_tables_.end(), "temp_tables_ does not contain desired table");
     return result->second;
   }
+  if (const auto snapshot = Snapshot(); snapshot != nullptr) {
+    return common::ManagedPointer(CatalogSnapshot::GetOrLoad(&snapshot->tables_, table,
+                                                             [&] { return dbc_->GetTable(txn_, table).Get(); }));
+  }
   if (cache_ != DISABLED) {
     auto table_ptr = cache_->GetTable(table);
     if (table_ptr == nullptr) {
@@ -100,13 +119,26 @@ bool CatalogAccessor::UpdateSchema(table_oid_t table, Schema *new_schema) const
   return dbc_->UpdateSchema(txn_, table, new_schema);
 }
 
-const Schema &CatalogAccessor::GetSchema(table_oid_t table) const { return dbc_->GetSchema(txn_, table); }
+const Schema &CatalogAccessor::GetSchema(table_oid_t table) const {
+  if (const auto snapshot = Snapshot(); snapshot != nullptr) {
+    return *CatalogSnapshot::GetOrLoad(&snapshot->schemas_, table, [&] { return &dbc_->GetSchema(txn_, table); });
+  }
+  return dbc_->GetSchema(txn_, table);
+}
 
 std::vector<constraint_oid_t> CatalogAccessor::GetConstraints(table_oid_t table) const {
+  if (const auto snapshot = Snapshot(); snapshot != nullptr) {
+    return CatalogSnapshot::GetOrLoad(&snapshot->table_constraints_, table,
+                                      [&] { return dbc_->GetConstraints(txn_, table); });
+  }
   return dbc_->GetConstraints(txn_, table);
 }
 
 std::vector<index_oid_t> CatalogAccessor::GetIndexOids(table_oid_t table) const {
+  if (const auto snapshot = Snapshot(); snapshot != nullptr) {
+    return CatalogSnapshot::GetOrLoad(&snapshot->table_indexes_, table,
+                                      [&] { return dbc_->GetIndexOids(txn_, table); });
+  }
   if (cache_ != DISABLED) {
     auto cache_lookup = cache_->GetIndexOids(table);
     if (!cache_lookup.first) {
@@ -127,8 +159,13 @@ std::vector<std::pair<common::ManagedPointer<storage::index::Index>, const Index
 
 index_oid_t CatalogAccessor::GetIndexOid(std::string name) const {
   NormalizeObjectName(&name);
+  const auto snapshot = Snapshot();
   for (const auto &path : search_path_) {
-    const index_oid_t search_result = dbc_->GetIndexOid(txn_, path, name);
+    const index_oid_t search_result =
+        snapshot != nullptr
+            ? CatalogSnapshot::GetOrLoad(&snapshot->index_oids_, {path.UnderlyingValue(), name},
+                                         [&] { return dbc_->GetIndexOid(txn_, path, name); })
+            : dbc_->GetIndexOid(txn_, path, name);
     if (search_result != INVALID_INDEX_OID) return search_result;
   }
   return INVALID_INDEX_OID;
@@ -136,6 +173,10 @@ index_oid_t CatalogAccessor::GetIndexOid(std::string name) const {
 
 index_oid_t CatalogAccessor::GetIndexOid(namespace_oid_t ns, std::string name) const {
   NormalizeObjectName(&name);
+  if (const auto snapshot = Snapshot(); snapshot != nullptr) {
+    return CatalogSnapshot::GetOrLoad(&snapshot->index_oids_, {ns.UnderlyingValue(), name},
+                                      [&] { return dbc_->GetIndexOid(txn_, ns, name); });
+  }
   return dbc_->GetIndexOid(txn_, ns, name);
 }
 
@@ -146,6 +187,10 @@ index_oid_t CatalogAccessor::CreateIndex(namespace_oid_t ns, table_oid_t table,
 }
 
 const IndexSchema &CatalogAccessor::GetIndexSchema(index_oid_t index) const {
+  if (const auto snapshot = Snapshot(); snapshot != nullptr) {
+    return *CatalogSnapshot::GetOrLoad(&snapshot->index_schemas_, index,
+                                       [&] { return &dbc_->GetIndexSchema(txn_, index); });
+  }
   return dbc_->GetIndexSchema(txn_, index);
 }
 
@@ -156,6 +201,10 @@ bool CatalogAccessor::SetIndexPointer(index_oid_t index, storage::index::Index *
 }
 
 common::ManagedPointer<storage::index::Index> CatalogAccessor::GetIndex(index_oid_t index) const {
+  if (const auto snapshot = Snapshot(); snapshot != nullptr) {
+    return common::ManagedPointer(CatalogSnapshot::GetOrLoad(&snapshot->indexes_, index,
+                                                             [&] { return dbc_->GetIndex(txn_, index).Get(); }));
+  }
   if (cache_ != DISABLED) {
     auto index_ptr = cache_->GetIndex(index);
     if (index_ptr == nullptr) {
@@ -170,6 +219,8 @@ common::ManagedPointer<storage::index::Index> CatalogAccessor::GetIndex(index_oi
 
 std::string_view CatalogAccessor::GetIndexName(index_oid_t index) const { return dbc_->GetIndexName(txn_, index); }
 
+std::string_view CatalogAccessor::GetTableName(table_oid_t table) const { return dbc_->GetTableName(txn_, table); }
+
 language_oid_t CatalogAccessor::CreateLanguage(const std::string &lanname) {
   return dbc_->CreateLanguage(txn_, lanname);
 }
@@ -217,6 +268,11 @@ std::unique_ptr<optimizer::ColumnStatsBase> CatalogAccessor::GetColumnStatistics
   return dbc_->GetColumnStatistics(txn_, table_oid, col_oid);
 }
 
+bool CatalogAccessor::SetColumnGroupStatistics(table_oid_t table_oid,
+                                               const std::vector<optimizer::ColumnGroupStats> &group_stats) {
+  return dbc_->SetColumnGroupStatistics(txn_, table_oid, group_stats);
+}
+
 optimizer::TableStats CatalogAccessor::GetTableStatistics(table_oid_t table_oid) {
   return dbc_->GetTableStatistics(txn_, table_oid);
 }
@@ -234,4 +290,9 @@ void CatalogAccessor::RegisterTempTable(table_oid_t table_oid, const common::Man
   temp_tables_[table_oid] = table;
 }
 
+common::ManagedPointer<CatalogSnapshot> CatalogAccessor::Snapshot() const {
+  if (snapshot_ == nullptr || dbc_->IsLockedBy(txn_)) return nullptr;
+  return snapshot_;
+}
+
 }  // namespace noisepage::catalog
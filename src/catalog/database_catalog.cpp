@@ -26,6 +26,7 @@
 #include "transaction/transaction_context.h"
 #include "transaction/transaction_defs.h"
 #include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
 #include "type/type_id.h"
 
 namespace noisepage::catalog {
@@ -33,6 +34,7 @@ namespace noisepage::catalog {
 DatabaseCatalog::DatabaseCatalog(const db_oid_t oid,
                                  const common::ManagedPointer<storage::GarbageCollector> garbage_collector)
     : write_lock_(transaction::INITIAL_TXN_TIMESTAMP),
+      snapshot_(new CatalogSnapshot(transaction::INITIAL_TXN_TIMESTAMP)),
       db_oid_(oid),
       garbage_collector_(garbage_collector),
       pg_core_(db_oid_),
@@ -227,6 +229,14 @@ std::string_view DatabaseCatalog::GetIndexName(const common::ManagedPointer<tran
   return name_pair.first;
 }
 
+std::string_view DatabaseCatalog::GetTableName(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                               table_oid_t table) {
+  const auto name_pair = pg_core_.GetClassNameKind(txn, table.UnderlyingValue());
+  NOISEPAGE_ASSERT(name_pair.second == postgres::PgClass::RelKind::REGULAR_TABLE,
+                   "Called GetTableName with an OID for an object that doesn't have type REGULAR_TABLE");
+  return name_pair.first;
+}
+
 const Schema &DatabaseCatalog::GetSchema(const common::ManagedPointer<transaction::TransactionContext> txn,
                                          const table_oid_t table) {
   const auto ptr_pair = pg_core_.GetClassSchemaPtrKind(txn, table.UnderlyingValue());
@@ -392,11 +402,35 @@ std::unique_ptr<optimizer::ColumnStatsBase> DatabaseCatalog::GetColumnStatistics
   return pg_stat_.GetColumnStatistics(txn, common::ManagedPointer(this), table_oid, col_oid);
 }
 
+bool DatabaseCatalog::SetColumnGroupStatistics(common::ManagedPointer<transaction::TransactionContext> txn,
+                                               table_oid_t table_oid,
+                                               const std::vector<optimizer::ColumnGroupStats> &group_stats) {
+  return pg_stat_.SetColumnGroupStatistics(txn, table_oid, group_stats);
+}
+
 optimizer::TableStats DatabaseCatalog::GetTableStatistics(common::ManagedPointer<transaction::TransactionContext> txn,
                                                           table_oid_t table_oid) {
   return pg_stat_.GetTableStatistics(txn, common::ManagedPointer(this), table_oid);
 }
 
+common::ManagedPointer<CatalogSnapshot> DatabaseCatalog::GetSnapshot(
+    const common::ManagedPointer<transaction::TransactionContext> txn) const {
+  const auto version = write_lock_.load();
+  // A DDL change that is in progress (the lock holds a txn id) or committed after the txn started is not what the txn
+  // sees of the catalog, but it is what the snapshot will describe.
+  if (!transaction::TransactionUtil::Committed(version) ||
+      transaction::TransactionUtil::NewerThan(version, txn->StartTime())) {
+    return nullptr;
+  }
+  // The snapshot may already have been replaced by a newer commit, or not yet by the one whose version was just read
+  auto *const snapshot = snapshot_.load();
+  return snapshot->Version() == version ? common::ManagedPointer(snapshot) : nullptr;
+}
+
+bool DatabaseCatalog::IsLockedBy(const common::ManagedPointer<transaction::TransactionContext> txn) const {
+  return write_lock_.load() == txn->FinishTime();
+}
+
 bool DatabaseCatalog::TryLock(const common::ManagedPointer<transaction::TransactionContext> txn) {
   auto current_val = write_lock_.load();
 
@@ -419,7 +453,15 @@ bool DatabaseCatalog::TryLock(const common::ManagedPointer<transaction::Transact
   if (write_lock_.compare_exchange_strong(current_val, txn_id)) {
     // acquired the lock
     auto *const write_lock = &write_lock_;
-    txn->RegisterCommitAction([=]() -> void { write_lock->store(txn->FinishTime()); });
+    auto *const snapshot = &snapshot_;
+    txn->RegisterCommitAction([=](transaction::DeferredActionManager *deferred_action_manager) -> void {
+      const auto commit_time = txn->FinishTime();
+      write_lock->store(commit_time);
+      // The cached metadata no longer describes the catalog that new transactions see. Transactions that started
+      // before this commit may still be reading the old snapshot, so it is freed once they are done.
+      auto *const stale_snapshot = snapshot->exchange(new CatalogSnapshot(commit_time));
+      deferred_action_manager->RegisterDeferredAction([=]() { delete stale_snapshot; });
+    });
     txn->RegisterAbortAction([=]() -> void { write_lock->store(current_val); });
     return true;
   }
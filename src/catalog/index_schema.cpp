@@ -58,6 +58,7 @@ nlohmann::json IndexSchema::ToJson() const {
   j["exclusion"] = is_exclusion_;
   j["immediate"] = is_immediate_;
   j["options"] = index_options_;
+  j["predicate"] = predicate_ == nullptr ? nlohmann::json(nullptr) : predicate_->ToJson();
   return j;
 }
 
@@ -75,8 +76,15 @@ std::unique_ptr<IndexSchema> IndexSchema::DeserializeSchema(const nlohmann::json
   auto type = static_cast<storage::index::IndexType>(j.at("type").get<char>());
   auto index_options = j.at("options").get<IndexOptions>();
 
-  auto schema =
-      std::make_unique<IndexSchema>(columns, type, unique, primary, exclusion, immediate, std::move(index_options));
+  std::unique_ptr<parser::AbstractExpression> predicate = nullptr;
+  if (j.find("predicate") != j.end() && !j.at("predicate").is_null()) {
+    auto deserialized = parser::DeserializeExpression(j.at("predicate"));
+    predicate = std::move(deserialized.result_);
+    NOISEPAGE_ASSERT(deserialized.non_owned_exprs_.empty(), "There should be 0 non owned expressions");
+  }
+
+  auto schema = std::make_unique<IndexSchema>(columns, type, unique, primary, exclusion, immediate,
+                                              std::move(index_options), std::move(predicate));
 
   return schema;
 }
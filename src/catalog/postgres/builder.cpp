@@ -322,6 +322,10 @@ Schema Builder::GetIndexTableSchema() {
                        parser::ConstantValueExpression(type::TypeId::TINYINT));
   columns.back().SetOid(PgIndex::IND_TYPE.oid_);
 
+  columns.emplace_back("indpred", type::TypeId::VARCHAR, 4096, true,
+                       parser::ConstantValueExpression(type::TypeId::VARCHAR));
+  columns.back().SetOid(PgIndex::INDPRED.oid_);
+
   return Schema(columns);
 }
 
@@ -753,6 +753,11 @@ bool PgCoreImpl::CreateIndexEntry(const common::ManagedPointer<transaction::Tran
       PgIndex::INDISREADY.Set(delta, pm, true);
       PgIndex::INDISLIVE.Set(delta, pm, true);
       PgIndex::IND_TYPE.Set(delta, pm, static_cast<char>(schema.type_));
+      if (schema.IsPartial()) {
+        PgIndex::INDPRED.Set(delta, pm, storage::StorageUtil::CreateVarlen(schema.GetPredicate()->ToJson().dump()));
+      } else {
+        PgIndex::INDPRED.SetNull(delta, pm);
+      }
 
       // Insert into pg_index.
       const auto indexes_tuple_slot = indexes_->Insert(txn, indexes_insert_redo);
@@ -805,8 +810,9 @@ bool PgCoreImpl::CreateIndexEntry(const common::ManagedPointer<transaction::Tran
   {
     std::vector<IndexSchema::Column> cols =
         GetColumns<IndexSchema::Column, index_oid_t, indexkeycol_oid_t>(txn, index_oid);
+    auto predicate = schema.IsPartial() ? schema.GetPredicate()->Copy() : nullptr;
     auto *new_schema = new IndexSchema(cols, schema.Type(), schema.Unique(), schema.Primary(), schema.Exclusion(),
-                                       schema.Immediate(), schema.GetIndexOptions());
+                                       schema.Immediate(), schema.GetIndexOptions(), std::move(predicate));
     txn->RegisterAbortAction([=]() { delete new_schema; });
 
     auto *const update_redo = txn->StageWrite(db_oid_, PgClass::CLASS_TABLE_OID, set_class_schema_pri_);
@@ -1,13 +1,18 @@
 #include "catalog/postgres/pg_statistic_impl.h"
 
+#include <string>
+#include <vector>
+
 #include "catalog/database_catalog.h"
 #include "catalog/index_schema.h"
 #include "catalog/postgres/builder.h"
 #include "catalog/postgres/pg_namespace.h"
 #include "catalog/schema.h"
+#include "optimizer/statistics/column_group_stats.h"
 #include "optimizer/statistics/column_stats.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
+#include "storage/storage_util.h"
 
 namespace noisepage::catalog::postgres {
 
@@ -130,6 +135,62 @@ bool PgStatisticImpl::DeleteColumnStatistics(const common::ManagedPointer<transa
   return true;
 }
 
+bool PgStatisticImpl::SetColumnGroupStatistics(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                               const table_oid_t table_oid,
+                                               const std::vector<optimizer::ColumnGroupStats> &group_stats) {
+  const auto &oid_pri = statistic_oid_index_->GetProjectedRowInitializer();
+  const auto &oid_prm = statistic_oid_index_->GetKeyOidToOffsetMap();
+  auto &pm = pg_statistic_all_cols_prm_;
+
+  byte *const key_buffer = common::AllocationUtil::AllocateAligned(oid_pri.ProjectedRowSize());
+
+  for (const auto &group : group_stats) {
+    const auto group_oid =
+        optimizer::ColumnGroupStats::EncodeGroupOid(group.GetFirstColumnID(), group.GetSecondColumnID());
+    auto *key_pr = oid_pri.InitializeRow(key_buffer);
+    key_pr->Set<table_oid_t, false>(oid_prm.at(indexkeycol_oid_t(1)), table_oid, false);
+    key_pr->Set<col_oid_t, false>(oid_prm.at(indexkeycol_oid_t(2)), group_oid, false);
+
+    // Delete the statistics of the column group from an earlier ANALYZE.
+    std::vector<storage::TupleSlot> index_results;
+    statistic_oid_index_->ScanKey(*txn, *key_pr, &index_results);
+    for (const auto &slot : index_results) {
+      txn->StageDelete(db_oid_, PgStatistic::STATISTIC_TABLE_OID, slot);
+      if (!statistics_->Delete(txn, slot)) {  // Someone else is analyzing the table. Ask to abort.
+        delete[] key_buffer;
+        return false;
+      }
+      statistic_oid_index_->Delete(txn, *key_pr, slot);
+    }
+
+    // Insert the new statistics into pg_statistic.
+    size_t top_k_size;
+    const auto top_k = group.GetTopK()->Serialize(&top_k_size);
+    auto *const redo = txn->StageWrite(db_oid_, PgStatistic::STATISTIC_TABLE_OID, pg_statistic_all_cols_pri_);
+    auto delta = common::ManagedPointer(redo->Delta());
+    {
+      PgStatistic::STARELID.Set(delta, pm, table_oid);
+      PgStatistic::STAATTNUM.Set(delta, pm, group_oid);
+      PgStatistic::STA_NUMROWS.Set(delta, pm, group.GetNumRows());
+      PgStatistic::STA_NONNULLROWS.Set(delta, pm, group.GetNonNullRows());
+      PgStatistic::STA_DISTINCTROWS.Set(delta, pm, group.GetDistinctValues());
+      const std::string top_k_str(reinterpret_cast<const char *>(top_k.get()), top_k_size);
+      PgStatistic::STA_TOPK.Set(delta, pm, storage::StorageUtil::CreateVarlen(top_k_str));
+      PgStatistic::STA_HISTOGRAM.SetNull(delta, pm);
+    }
+    const auto tuple_slot = statistics_->Insert(txn, redo);
+
+    // Insert into pg_statistic_index.
+    if (!statistic_oid_index_->InsertUnique(txn, *key_pr, tuple_slot)) {
+      delete[] key_buffer;
+      return false;
+    }
+  }
+
+  delete[] key_buffer;
+  return true;
+}
+
 std::unique_ptr<optimizer::ColumnStatsBase> PgStatisticImpl::GetColumnStatistics(
     common::ManagedPointer<transaction::TransactionContext> txn,
     common::ManagedPointer<DatabaseCatalog> database_catalog, table_oid_t table_oid, col_oid_t col_oid) {
@@ -188,18 +249,42 @@ optimizer::TableStats PgStatisticImpl::GetTableStatistics(common::ManagedPointer
   NOISEPAGE_ASSERT(!index_results.empty(), "Every table should have column stats");
 
   std::vector<std::unique_ptr<optimizer::ColumnStatsBase>> col_stats_list;
+  std::vector<std::unique_ptr<optimizer::ColumnGroupStats>> group_stats_list;
 
   auto all_cols_pr = common::ManagedPointer(pg_statistic_all_cols_pri_.InitializeRow(buffer));
   for (const auto &slot : index_results) {
     statistics_->Select(txn, slot, all_cols_pr.Get());
 
     auto col_oid = *PgStatistic::STAATTNUM.Get(all_cols_pr, pg_statistic_all_cols_prm_);
+    if (optimizer::ColumnGroupStats::IsGroupOid(col_oid)) {
+      group_stats_list.emplace_back(CreateColumnGroupStats(all_cols_pr, col_oid));
+      continue;
+    }
     auto type = database_catalog->GetSchema(txn, table_oid).GetColumn(col_oid).Type();
     col_stats_list.emplace_back(CreateColumnStats(all_cols_pr, table_oid, col_oid, type));
   }
   delete[] buffer;
   delete[] key_buffer;
-  return optimizer::TableStats(db_oid_, table_oid, &col_stats_list);
+
+  optimizer::TableStats table_stats(db_oid_, table_oid, &col_stats_list);
+  for (auto &group_stats : group_stats_list) table_stats.AddColumnGroupStats(std::move(group_stats));
+  return table_stats;
+}
+
+std::unique_ptr<optimizer::ColumnGroupStats> PgStatisticImpl::CreateColumnGroupStats(
+    common::ManagedPointer<storage::ProjectedRow> all_cols_pr, col_oid_t group_oid) {
+  auto num_rows = *PgStatistic::STA_NUMROWS.Get(all_cols_pr, pg_statistic_all_cols_prm_);
+  auto non_null_rows = *PgStatistic::STA_NONNULLROWS.Get(all_cols_pr, pg_statistic_all_cols_prm_);
+  auto distinct_values = *PgStatistic::STA_DISTINCTROWS.Get(all_cols_pr, pg_statistic_all_cols_prm_);
+  const auto *top_k_str = PgStatistic::STA_TOPK.Get(all_cols_pr, pg_statistic_all_cols_prm_);
+
+  auto top_k = top_k_str != nullptr
+                   ? optimizer::TopKElements<int64_t>::Deserialize(top_k_str->Content(), top_k_str->Size())
+                   : optimizer::TopKElements<int64_t>();
+  const auto [first_col_oid, second_col_oid] = optimizer::ColumnGroupStats::DecodeGroupOid(group_oid);
+  return std::make_unique<optimizer::ColumnGroupStats>(
+      first_col_oid, second_col_oid, num_rows, non_null_rows, distinct_values,
+      std::make_unique<optimizer::TopKElements<int64_t>>(std::move(top_k)));
 }
 
 std::unique_ptr<optimizer::ColumnStatsBase> PgStatisticImpl::CreateColumnStats(
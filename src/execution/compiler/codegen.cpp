@@ -645,10 +645,11 @@ ast::Expr *CodeGen::TableIterClose(ast::Expr *table_iter) {
 }
 
 ast::Expr *CodeGen::IterateTableParallel(catalog::table_oid_t table_oid, ast::Identifier col_oids,
-                                         ast::Expr *query_state, ast::Expr *exec_ctx, ast::Identifier worker_name) {
-  ast::Expr *call =
-      CallBuiltin(ast::Builtin::TableIterParallel, {Const32(table_oid.UnderlyingValue()), MakeExpr(col_oids),
-                                                    query_state, exec_ctx, Const32(0), MakeExpr(worker_name)});
+                                         ast::Expr *query_state, ast::Expr *exec_ctx, ast::Identifier worker_name,
+                                         uint32_t num_threads) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::TableIterParallel,
+                                {Const32(table_oid.UnderlyingValue()), MakeExpr(col_oids), query_state, exec_ctx,
+                                 ConstU32(num_threads), MakeExpr(worker_name)});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
   return call;
 }
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <atomic>
 #include <sstream>
+#include <utility>
 
 #include "catalog/catalog_accessor.h"
 #include "common/error/exception.h"
@@ -124,19 +125,38 @@ ast::FunctionDecl *CompilationContext::GenerateTearDownFunction() {
   return builder.Finish();
 }
 
-void CompilationContext::GeneratePlan(const planner::AbstractPlanNode &plan,
-                                      common::ManagedPointer<planner::PlanMetaData> plan_meta_data) {
+void CompilationContext::PrepareTranslators(const planner::AbstractPlanNode &plan,
+                                            common::ManagedPointer<planner::PlanMetaData> plan_meta_data,
+                                            Pipeline *main_pipeline) {
   exec_ctx_ =
       query_state_.DeclareStateEntry(GetCodeGen(), "execCtx", codegen_.PointerType(ast::BuiltinType::ExecutionContext));
+  plan_meta_data_ = plan_meta_data;
 
   // Recursively prepare all translators for the query.
-  Pipeline main_pipeline(this);
   if (plan.GetOutputSchema()->NumColumns() != 0) {
-    PrepareOut(plan, &main_pipeline);
+    PrepareOut(plan, main_pipeline);
   } else {
-    Prepare(plan, &main_pipeline);
+    Prepare(plan, main_pipeline);
   }
   query_state_.ConstructFinalType(&codegen_);
+}
+
+void CompilationContext::PreparePipeline(Pipeline *pipeline) {
+  pipeline->Prepare(query_->GetExecutionSettings());
+  uint32_t degree_of_parallelism = 1;
+  if (pipeline->IsParallel()) {
+    degree_of_parallelism = pipeline->GetDegreeOfParallelism() != 0
+                                ? pipeline->GetDegreeOfParallelism()
+                                : Pipeline::GetMaxDegreeOfParallelism(query_->GetExecutionSettings());
+  }
+  query_->AddPipelineInfo({pipeline->GetPipelineId().UnderlyingValue(), pipeline->GetStepsDescription(),
+                           degree_of_parallelism, pipeline->GetEstimatedInputRows()});
+}
+
+void CompilationContext::GeneratePlan(const planner::AbstractPlanNode &plan,
+                                      common::ManagedPointer<planner::PlanMetaData> plan_meta_data) {
+  Pipeline main_pipeline(this);
+  PrepareTranslators(plan, plan_meta_data, &main_pipeline);
 
   // Collect top-level structures and declarations.
   util::RegionVector<ast::StructDecl *> top_level_structs(query_->GetContext()->GetRegion());
@@ -145,6 +165,7 @@ void CompilationContext::GeneratePlan(const planner::AbstractPlanNode &plan,
     (void)_;
     op->DefineHelperStructs(&top_level_structs);
     op->DefineHelperFunctions(&top_level_funcs);
+    query_->AddTranslatorPlan(op->GetTranslatorId(), &op->GetPlan());
   }
   top_level_structs.push_back(query_state_.GetType());
 
@@ -174,7 +195,7 @@ void CompilationContext::GeneratePlan(const planner::AbstractPlanNode &plan,
     auto features = recorder.RecordTranslators(pipeline->GetTranslators());
     codegen_.GetPipelineOperatingUnits()->RecordOperatingUnit(pipeline->GetPipelineId(), std::move(features));
 
-    pipeline->Prepare(query_->GetExecutionSettings());
+    PreparePipeline(pipeline);
     {
       util::RegionVector<ast::FunctionDecl *> pipeline_decls(query_->GetContext()->GetRegion());
       for (auto &[_, op] : ops_) {
@@ -216,6 +237,24 @@ std::unique_ptr<ExecutableQuery> CompilationContext::Compile(
   return query;
 }
 
+// static
+std::vector<ExecutableQuery::PipelineInfo> CompilationContext::DescribePipelines(
+    const planner::AbstractPlanNode &plan, const exec::ExecutionSettings &exec_settings,
+    catalog::CatalogAccessor *accessor, common::ManagedPointer<planner::PlanMetaData> plan_meta_data) {
+  // The query only provides the AST context that the translators are prepared in, it is never compiled
+  auto query = std::make_unique<ExecutableQuery>(plan, exec_settings, accessor->GetTxn()->StartTime());
+  CompilationContext ctx(query.get(), query->GetQueryId(), accessor, CompilationMode::Interleaved, exec_settings);
+
+  Pipeline main_pipeline(&ctx);
+  ctx.PrepareTranslators(plan, plan_meta_data, &main_pipeline);
+  std::vector<Pipeline *> execution_order;
+  main_pipeline.CollectDependencies(&execution_order);
+  for (auto *pipeline : execution_order) {
+    if (!pipeline->IsPrepared()) ctx.PreparePipeline(pipeline);
+  }
+  return query->GetPipelineInfos();
+}
+
 uint32_t CompilationContext::RegisterPipeline(Pipeline *pipeline) {
   NOISEPAGE_ASSERT(std::find(pipelines_.begin(), pipelines_.end(), pipeline) == pipelines_.end(),
                    "Duplicate pipeline in context");
@@ -438,6 +477,14 @@ ExpressionTranslator *CompilationContext::LookupTranslator(const parser::Abstrac
 
 std::string CompilationContext::GetFunctionPrefix() const { return "Query" + std::to_string(unique_id_); }
 
+const exec::ExecutionSettings &CompilationContext::GetExecutionSettings() const {
+  return query_->GetExecutionSettings();
+}
+
+void CompilationContext::SetTableSample(catalog::table_oid_t table_oid, uint32_t stride) {
+  query_->SetTableSample(table_oid, stride);
+}
+
 util::RegionVector<ast::FieldDecl *> CompilationContext::QueryParams() const {
   ast::Expr *state_type = codegen_.PointerType(codegen_.MakeExpr(query_state_type_));
   ast::FieldDecl *field = codegen_.MakeField(query_state_var_, state_type);
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 
+#include "catalog/catalog_accessor.h"
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
 #include "execution/ast/context.h"
@@ -10,6 +11,7 @@
 #include "execution/sema/error_reporter.h"
 #include "execution/vm/module.h"
 #include "loggers/execution_logger.h"
+#include "planner/plannodes/abstract_plan_node.h"
 #include "self_driving/modeling/operating_unit.h"
 #include "transaction/transaction_context.h"
 
@@ -166,6 +168,7 @@ void ExecutableQuery::Run(common::ManagedPointer<exec::ExecutionContext> exec_ct
   exec_ctx->SetExecutionMode(static_cast<uint8_t>(mode));
   exec_ctx->SetPipelineOperatingUnits(GetPipelineOperatingUnits());
   exec_ctx->SetQueryId(query_id_);
+  if (sample_stride_ > 1) exec_ctx->SetTableSample(sampled_table_oid_, sample_stride_);
 
   // Now run through fragments.
   for (const auto &fragment : fragments_) {
@@ -177,4 +180,37 @@ void ExecutableQuery::Run(common::ManagedPointer<exec::ExecutionContext> exec_ct
   exec_ctx->SetQueryState(nullptr);
 }
 
+std::unordered_map<planner::plan_node_id_t, size_t> ExecutableQuery::GetObservedOutputRows(
+    const exec::ExecutionContext &exec_ctx) const {
+  std::unordered_map<planner::plan_node_id_t, size_t> output_rows;
+  const auto observe = [&output_rows](const planner::AbstractPlanNode *plan, size_t num_rows) {
+    if (plan != nullptr) output_rows[plan->GetPlanNodeId()] = num_rows;
+  };
+
+  for (const auto &[key, observed] : exec_ctx.GetObservedRows()) {
+    const auto it = translator_plans_.find(key.first);
+    if (it == translator_plans_.end()) continue;
+    const auto *plan = it->second;
+
+    switch (key.second) {
+      case selfdriving::ExecutionOperatingUnitType::OUTPUT:
+        observe(plan, observed.num_rows_);
+        break;
+      case selfdriving::ExecutionOperatingUnitType::HASHJOIN_PROBE:
+        observe(plan, observed.cardinality_);
+        if (plan->GetChildrenSize() > 1) observe(plan->GetChild(1), observed.num_rows_);
+        break;
+      case selfdriving::ExecutionOperatingUnitType::HASHJOIN_BUILD:
+      case selfdriving::ExecutionOperatingUnitType::AGGREGATE_BUILD:
+      case selfdriving::ExecutionOperatingUnitType::SORT_BUILD:
+        if (plan->GetChildrenSize() > 0) observe(plan->GetChild(0), observed.num_rows_);
+        break;
+      default:
+        // Scans count the tuples they read before filtering, and the remaining units do not count rows of the plan
+        break;
+    }
+  }
+  return output_rows;
+}
+
 }  // namespace noisepage::execution::compiler
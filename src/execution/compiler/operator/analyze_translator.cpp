@@ -41,6 +41,13 @@ AnalyzeTranslator::AnalyzeTranslator(const planner::AnalyzePlanNode &plan, Compi
   compilation_context->Prepare(*plan.GetChild(0), pipeline);
   auto *codegen = GetCodeGen();
 
+  // Large tables are analyzed from a sample of their blocks, the counts are scaled back up in PerformPipelineWork
+  const auto sample_blocks = compilation_context->GetExecutionSettings().GetAnalyzeSampleBlocks();
+  const auto num_blocks = codegen->GetCatalogAccessor()->GetTable(plan.GetTableOid())->GetNumBlocks();
+  if (sample_blocks != 0 && num_blocks > sample_blocks) {
+    sample_stride_ = static_cast<uint32_t>((num_blocks + sample_blocks - 1) / sample_blocks);
+    compilation_context->SetTableSample(plan.GetTableOid(), sample_stride_);
+  }
   pg_statistic_column_lookup_[catalog::postgres::PgStatistic::STARELID.oid_] = table_oid_;
   pg_statistic_column_lookup_[catalog::postgres::PgStatistic::STAATTNUM.oid_] = col_oid_;
   pg_statistic_column_lookup_[catalog::postgres::PgStatistic::STA_NUMROWS.oid_] = num_rows_;
@@ -146,6 +153,32 @@ void AnalyzeTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilde
     }
     loop.EndLoop();
   }
+
+  // @analyzeColumnGroups(queryState.execCtx, table_oid, group_col_oids)
+  if (plan.GetColumnOids().size() > 1) AnalyzeColumnGroups(function);
+}
+
+void AnalyzeTranslator::AnalyzeColumnGroups(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  const auto &plan = GetPlanAs<planner::AnalyzePlanNode>();
+  const auto &col_oids = plan.GetColumnOids();
+
+  // The aggregates above only see one column at a time, so the statistics of the pairs of columns are collected by a
+  // scan of their own over the same sample of blocks
+  // var group_col_oids: [num_cols]uint32
+  auto group_col_oids = codegen->MakeFreshIdentifier("group_col_oids");
+  function->Append(
+      codegen->DeclareVarNoInit(group_col_oids, codegen->ArrayType(col_oids.size(), ast::BuiltinType::Kind::Uint32)));
+  for (size_t i = 0; i < col_oids.size(); i++) {
+    // group_col_oids[i] = ...
+    function->Append(
+        codegen->Assign(codegen->ArrayAccess(group_col_oids, i), codegen->ConstU32(col_oids[i].UnderlyingValue())));
+  }
+  auto *call = codegen->CallBuiltin(ast::Builtin::AnalyzeColumnGroups,
+                                    {GetCompilationContext()->GetExecutionContextPtrFromQueryState(),
+                                     codegen->Const32(plan.GetTableOid().UnderlyingValue()),
+                                     codegen->MakeExpr(group_col_oids)});
+  function->Append(codegen->MakeStmt(call));
 }
 
 void AnalyzeTranslator::SetPgStatisticColOids(FunctionBuilder *function) const {
@@ -170,8 +203,8 @@ void AnalyzeTranslator::InitPgStatisticVariables(WorkContext *context, FunctionB
   // var col_oid: Integer
   function->Append(codegen->DeclareVarNoInit(col_oid_, ast::BuiltinType::Kind::Integer));
   // The first aggregate is COUNT(*)
-  // var num_rows = @aggResult(queryState.execCtx, &aggRow.agg_term_attr0)
-  function->Append(codegen->DeclareVarWithInit(num_rows_, GetChildOutput(context, 0, 0)));
+  // var num_rows = @aggResult(queryState.execCtx, &aggRow.agg_term_attr0) * sample_stride
+  function->Append(codegen->DeclareVarWithInit(num_rows_, ScaleBySampleStride(GetChildOutput(context, 0, 0))));
 
   // var agg_col: type
   for (size_t i = 0; i < catalog::postgres::PgStatisticImpl::NUM_ANALYZE_AGGREGATES; i++) {
@@ -206,6 +239,35 @@ void AnalyzeTranslator::AssignColumnStatistics(WorkContext *context, FunctionBui
     // agg_var = @aggResult(queryState.execCtx, &aggRow.agg_term_attr<agg_offset>)
     function->Append(codegen->Assign(lhs, rhs));
   }
+
+  if (sample_stride_ > 1) ScaleSampledColumnStatistics(function);
+}
+
+void AnalyzeTranslator::ScaleSampledColumnStatistics(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  auto non_null_rows = pg_statistic_column_lookup_.at(catalog::postgres::PgStatistic::STA_NONNULLROWS.oid_);
+  auto distinct_rows = pg_statistic_column_lookup_.at(catalog::postgres::PgStatistic::STA_DISTINCTROWS.oid_);
+
+  // A column without a single duplicate in the sample is assumed to be unique. Otherwise, the sample most likely saw
+  // (almost) all the distinct values already, so its distinct count is kept as is.
+  // if (distinct_rows == non_null_rows) { distinct_rows = distinct_rows * sample_stride }
+  If unique(function, codegen->Compare(parsing::Token::Type::EQUAL_EQUAL, codegen->MakeExpr(distinct_rows),
+                                       codegen->MakeExpr(non_null_rows)));
+  {
+    function->Append(codegen->Assign(codegen->MakeExpr(distinct_rows),
+                                     ScaleBySampleStride(codegen->MakeExpr(distinct_rows))));
+  }
+  unique.EndIf();
+
+  // non_null_rows = non_null_rows * sample_stride
+  function->Append(
+      codegen->Assign(codegen->MakeExpr(non_null_rows), ScaleBySampleStride(codegen->MakeExpr(non_null_rows))));
+}
+
+ast::Expr *AnalyzeTranslator::ScaleBySampleStride(ast::Expr *sampled_count) const {
+  if (sample_stride_ == 1) return sampled_count;
+  auto *codegen = GetCodeGen();
+  return codegen->BinaryOp(parsing::Token::Type::STAR, sampled_count, codegen->IntToSql(sample_stride_));
 }
 
 void AnalyzeTranslator::InitPgStatisticIterator(FunctionBuilder *function) const {
@@ -1,5 +1,6 @@
 #include "execution/compiler/operator/delete_translator.h"
 
+#include <memory>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
@@ -26,6 +27,9 @@ DeleteTranslator::DeleteTranslator(const planner::DeletePlanNode &plan, Compilat
     for (const auto &index_col : index_schema.GetColumns()) {
       compilation_context->Prepare(*index_col.StoredExpression());
     }
+    if (index_schema.IsPartial()) {
+      compilation_context->Prepare(*index_schema.GetPredicate());
+    }
   }
 
   num_deletes_ = CounterDeclare("num_deletes", pipeline);
@@ -102,6 +106,16 @@ void DeleteTranslator::GenTableDelete(FunctionBuilder *builder) const {
 void DeleteTranslator::GenIndexDelete(FunctionBuilder *builder, WorkContext *context,
                                       const catalog::index_oid_t &index_oid) const {
   // var delete_index_pr = @getIndexPR(&pipelineState.storageInterface, oid)
+  const auto &index_schema = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid);
+  const auto &op = GetPlanAs<planner::DeletePlanNode>();
+  const auto &child = GetCompilationContext()->LookupTranslator(*op.GetChild(0));
+
+  // if (index predicate) { ... } -- only tuples satisfying the predicate of a partial index were ever inserted into it
+  std::unique_ptr<If> partial;
+  if (index_schema.IsPartial()) {
+    partial = std::make_unique<If>(builder, context->DeriveValue(*index_schema.GetPredicate(), child));
+  }
+
   auto delete_index_pr = GetCodeGen()->MakeFreshIdentifier("delete_index_pr");
   std::vector<ast::Expr *> pr_call_args{si_deleter_.GetPtr(GetCodeGen()),
                                         GetCodeGen()->Const32(index_oid.UnderlyingValue())};
@@ -110,11 +124,8 @@ void DeleteTranslator::GenIndexDelete(FunctionBuilder *builder, WorkContext *con
 
   auto index = GetCodeGen()->GetCatalogAccessor()->GetIndex(index_oid);
   const auto &index_pm = index->GetKeyOidToOffsetMap();
-  const auto &index_schema = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid);
   const auto &index_cols = index_schema.GetColumns();
 
-  const auto &op = GetPlanAs<planner::DeletePlanNode>();
-  const auto &child = GetCompilationContext()->LookupTranslator(*op.GetChild(0));
   for (const auto &index_col : index_cols) {
     // @prSetCall(delete_index_pr, type, nullable, attr_idx, val)
     // NOTE: index expressions refer to columns in the child translator.
@@ -129,6 +140,8 @@ void DeleteTranslator::GenIndexDelete(FunctionBuilder *builder, WorkContext *con
   std::vector<ast::Expr *> delete_args{si_deleter_.GetPtr(GetCodeGen()), child->GetSlotAddress()};
   auto *index_delete_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexDelete, delete_args);
   builder->Append(GetCodeGen()->MakeStmt(index_delete_call));
+
+  if (partial != nullptr) partial->EndIf();
 }
 
 void DeleteTranslator::SetOids(FunctionBuilder *builder) const {
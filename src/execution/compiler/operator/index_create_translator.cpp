@@ -1,5 +1,8 @@
 #include "execution/compiler/operator/index_create_translator.h"
 
+#include <algorithm>
+#include <memory>
+
 #include "catalog/catalog_accessor.h"
 #include "execution/ast/context.h"
 #include "execution/compiler/codegen.h"
@@ -35,6 +38,9 @@ IndexCreateTranslator::IndexCreateTranslator(const planner::CreateIndexPlanNode
   for (const auto &index_col : index_schema.GetColumns()) {
     compilation_context->Prepare(*index_col.StoredExpression());
   }
+  if (index_schema.IsPartial()) {
+    compilation_context->Prepare(*index_schema.GetPredicate());
+  }
   pipeline->RegisterSource(this, Pipeline::Parallelism::Parallel);
 
   // col_oids is a global array
@@ -263,25 +269,15 @@ void IndexCreateTranslator::IndexInsert(WorkContext *ctx, FunctionBuilder *funct
   const auto &index_schema = codegen_->GetCatalogAccessor()->GetIndexSchema(index_oid_);
   auto *index_pr_expr = local_index_pr_.Get(codegen_);
 
-  std::unordered_map<catalog::col_oid_t, uint16_t> oid_offset;
-  for (uint16_t i = 0; i < all_oids_.size(); i++) {
-    oid_offset[all_oids_[i]] = i;
+  // if (index predicate) { ... } -- a partial index skips the tuples that do not satisfy its predicate
+  std::unique_ptr<If> partial;
+  if (index_schema.IsPartial()) {
+    partial = std::make_unique<If>(function, ctx->DeriveValue(*index_schema.GetPredicate(), this));
   }
 
   for (const auto &index_col : index_schema.GetColumns()) {
-    auto stored_expr = index_col.StoredExpression();
-    NOISEPAGE_ASSERT(stored_expr->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE,
-                     "CREATE INDEX supported on base columns only");
-
-    // col_expr comes from the base table so we need to use TableSchema to get the correct scan_offset.
-    // col_expr = @VPIGet(vpi_var_, attr_sql_type, true, oid)
-    auto cve = stored_expr.CastManagedPointerTo<const parser::ColumnValueExpression>();
-    NOISEPAGE_ASSERT(cve->GetColumnOid() != catalog::INVALID_COLUMN_OID, "CREATE INDEX column oid not bound");
-    NOISEPAGE_ASSERT(oid_offset.find(cve->GetColumnOid()) != oid_offset.end(), "CREATE INDEX missing column scan");
-    auto &tbl_col = table_schema_.GetColumn(cve->GetColumnOid());
-    auto sql_type = sql::GetTypeId(tbl_col.Type());
-    auto scan_offset = oid_offset[cve->GetColumnOid()];
-    const auto &col_expr = codegen_->VPIGet(codegen_->MakeExpr(vpi_var_), sql_type, tbl_col.Nullable(), scan_offset);
+    // Key expressions read the scanned tuple through GetTableColumn(), i.e., @VPIGet(vpi_var_, ...).
+    const auto &col_expr = ctx->DeriveValue(*index_col.StoredExpression(), this);
 
     // @prSet(insert_index_pr, attr_type, attr_idx, nullable, attr_index, col_expr, false)
     uint16_t attr_offset = index_pm.at(index_col.Oid());
@@ -299,6 +295,18 @@ void IndexCreateTranslator::IndexInsert(WorkContext *ctx, FunctionBuilder *funct
   If success(function, cond);
   { function->Append(codegen_->AbortTxn(GetExecutionContext())); }
   success.EndIf();
+
+  if (partial != nullptr) partial->EndIf();
+}
+
+ast::Expr *IndexCreateTranslator::GetTableColumn(catalog::col_oid_t col_oid) const {
+  // The scan reads every column of the table, in the order of all_oids_.
+  const auto it = std::find(all_oids_.cbegin(), all_oids_.cend(), col_oid);
+  NOISEPAGE_ASSERT(it != all_oids_.cend(), "CREATE INDEX missing column scan");
+  const auto scan_offset = static_cast<uint32_t>(std::distance(all_oids_.cbegin(), it));
+  const auto &tbl_col = table_schema_.GetColumn(col_oid);
+  return codegen_->VPIGet(codegen_->MakeExpr(vpi_var_), sql::GetTypeId(tbl_col.Type()), tbl_col.Nullable(),
+                          scan_offset);
 }
 
 ast::FunctionDecl *IndexCreateTranslator::GenerateEndHookFunction() const {
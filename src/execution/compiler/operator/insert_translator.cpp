@@ -1,5 +1,6 @@
 #include "execution/compiler/operator/insert_translator.h"
 
+#include <memory>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
@@ -58,6 +59,9 @@ InsertTranslator::InsertTranslator(const planner::InsertPlanNode &plan, Compilat
     for (const auto &index_col : index_schema.GetColumns()) {
       compilation_context->Prepare(*index_col.StoredExpression());
     }
+    if (index_schema.IsPartial()) {
+      compilation_context->Prepare(*index_schema.GetPredicate());
+    }
   }
 
   num_inserts_ = CounterDeclare("num_inserts", pipeline);
@@ -232,12 +236,19 @@ void InsertTranslator::GenIndexInsert(WorkContext *context, FunctionBuilder *bui
   const auto &insert_index_pr = GetCodeGen()->MakeFreshIdentifier("insert_index_pr");
   std::vector<ast::Expr *> pr_call_args{si_inserter_.GetPtr(GetCodeGen()),
                                         GetCodeGen()->Const32(index_oid.UnderlyingValue())};
+  const auto &index_schema = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid);
+
+  // if (index predicate) { ... } -- a partial index only holds the tuples satisfying its predicate
+  std::unique_ptr<If> partial;
+  if (index_schema.IsPartial()) {
+    partial = std::make_unique<If>(builder, context->DeriveValue(*index_schema.GetPredicate(), this));
+  }
+
   auto *get_index_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::GetIndexPR, pr_call_args);
   builder->Append(GetCodeGen()->DeclareVar(insert_index_pr, nullptr, get_index_pr_call));
 
   const auto &index = GetCodeGen()->GetCatalogAccessor()->GetIndex(index_oid);
   const auto &index_pm = index->GetKeyOidToOffsetMap();
-  const auto &index_schema = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid);
   auto *index_pr_expr = GetCodeGen()->MakeExpr(insert_index_pr);
 
   for (const auto &index_col : index_schema.GetColumns()) {
@@ -257,6 +268,8 @@ void InsertTranslator::GenIndexInsert(WorkContext *context, FunctionBuilder *bui
   If success(builder, cond);
   { builder->Append(GetCodeGen()->AbortTxn(GetExecutionContext())); }
   success.EndIf();
+
+  if (partial != nullptr) partial->EndIf();
 }
 
 std::vector<catalog::col_oid_t> InsertTranslator::AllColOids(const catalog::Schema &table_schema) {
@@ -13,6 +13,7 @@
 #include "execution/compiler/work_context.h"
 #include "parser/expression/column_value_expression.h"
 #include "parser/expression_util.h"
+#include "planner/plannodes/plan_meta_data.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "storage/sql_table.h"
 
@@ -27,7 +28,17 @@ SeqScanTranslator::SeqScanTranslator(const planner::SeqScanPlanNode &plan, Compi
           MakeInputOids(*(GetCodeGen()->GetCatalogAccessor()), GetTableOid(), GetPlanAs<planner::SeqScanPlanNode>())),
       tvi_var_(GetCodeGen()->MakeFreshIdentifier("tvi")),
       col_oids_var_(GetCodeGen()->MakeFreshIdentifier("col_oids")) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Parallel);
+  // Size the pipeline after the table when the optimizer estimated it from statistics. Temporary tables are filled by
+  // the query itself, and tables without statistics may be of any size, so their scans keep every parallel thread.
+  const auto plan_meta_data = compilation_context->GetPlanMetaData();
+  if (plan_meta_data != nullptr && !catalog::IsTempOid(GetTableOid()) &&
+      plan_meta_data->HasPlanNodeMetaData(plan.GetPlanNodeId()) &&
+      plan_meta_data->GetPlanNodeMetaData(plan.GetPlanNodeId()).HasTableNumRows()) {
+    const auto table_num_rows = plan_meta_data->GetPlanNodeMetaData(plan.GetPlanNodeId()).GetTableNumRows();
+    pipeline->RegisterSource(this, Pipeline::Parallelism::Parallel, table_num_rows);
+  } else {
+    pipeline->RegisterSource(this, Pipeline::Parallelism::Parallel);
+  }
   // If there's a predicate, prepare the expression and register a filter manager.
   if (HasPredicate()) {
     compilation_context->Prepare(*plan.GetScanPredicate());
@@ -349,7 +360,8 @@ util::RegionVector<ast::FieldDecl *> SeqScanTranslator::GetWorkerParams() const
 void SeqScanTranslator::LaunchWork(FunctionBuilder *function, ast::Identifier work_func) const {
   DeclareColOids(function);
   function->Append(GetCodeGen()->IterateTableParallel(GetTableOid(), col_oids_var_, GetQueryStatePtr(),
-                                                      GetExecutionContext(), work_func));
+                                                      GetExecutionContext(), work_func,
+                                                      GetPipeline()->GetDegreeOfParallelism()));
 }
 
 ast::Expr *SeqScanTranslator::GetTableColumn(catalog::col_oid_t col_oid) const {
@@ -1,5 +1,6 @@
 #include "execution/compiler/operator/update_translator.h"
 
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -35,6 +36,9 @@ UpdateTranslator::UpdateTranslator(const planner::UpdatePlanNode &plan, Compilat
     for (const auto &index_col : index_schema.GetColumns()) {
       compilation_context->Prepare(*index_col.StoredExpression());
     }
+    if (index_schema.IsPartial()) {
+      compilation_context->Prepare(*index_schema.GetPredicate());
+    }
   }
 
   num_updates_ = CounterDeclare("num_updates", pipeline);
@@ -229,12 +233,19 @@ void UpdateTranslator::GenIndexInsert(WorkContext *context, FunctionBuilder *bui
   const auto &insert_index_pr = GetCodeGen()->MakeFreshIdentifier("insert_index_pr");
   std::vector<ast::Expr *> pr_call_args{si_updater_.GetPtr(GetCodeGen()),
                                         GetCodeGen()->Const32(index_oid.UnderlyingValue())};
+  const auto &index_schema = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid);
+
+  // if (index predicate) { ... } -- a partial index only holds the tuples satisfying its predicate
+  std::unique_ptr<If> partial;
+  if (index_schema.IsPartial()) {
+    partial = std::make_unique<If>(builder, context->DeriveValue(*index_schema.GetPredicate(), this));
+  }
+
   auto *get_index_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::GetIndexPR, pr_call_args);
   builder->Append(GetCodeGen()->DeclareVar(insert_index_pr, nullptr, get_index_pr_call));
 
   const auto &index = GetCodeGen()->GetCatalogAccessor()->GetIndex(index_oid);
   const auto &index_pm = index->GetKeyOidToOffsetMap();
-  const auto &index_schema = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid);
   auto *index_pr_expr = GetCodeGen()->MakeExpr(insert_index_pr);
 
   for (const auto &index_col : index_schema.GetColumns()) {
@@ -254,6 +265,8 @@ void UpdateTranslator::GenIndexInsert(WorkContext *context, FunctionBuilder *bui
   If success(builder, cond);
   { builder->Append(GetCodeGen()->AbortTxn(GetExecutionContext())); }
   success.EndIf();
+
+  if (partial != nullptr) partial->EndIf();
 }
 
 void UpdateTranslator::GenTableDelete(FunctionBuilder *builder) const {
@@ -276,6 +289,16 @@ void UpdateTranslator::GenTableDelete(FunctionBuilder *builder) const {
 void UpdateTranslator::GenIndexDelete(FunctionBuilder *builder, WorkContext *context,
                                       const catalog::index_oid_t &index_oid) const {
   // var delete_index_pr = @getIndexPR(&pipelineState.storageInterface, oid)
+  const auto &index_schema = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid);
+  const auto &op = GetPlanAs<planner::UpdatePlanNode>();
+  const auto &child = GetCompilationContext()->LookupTranslator(*op.GetChild(0));
+
+  // if (index predicate) { ... } -- only tuples satisfying the predicate of a partial index were ever inserted into it
+  std::unique_ptr<If> partial;
+  if (index_schema.IsPartial()) {
+    partial = std::make_unique<If>(builder, context->DeriveValue(*index_schema.GetPredicate(), child));
+  }
+
   auto delete_index_pr = GetCodeGen()->MakeFreshIdentifier("delete_index_pr");
   std::vector<ast::Expr *> pr_call_args{si_updater_.GetPtr(GetCodeGen()),
                                         GetCodeGen()->Const32(index_oid.UnderlyingValue())};
@@ -284,11 +307,8 @@ void UpdateTranslator::GenIndexDelete(FunctionBuilder *builder, WorkContext *con
 
   auto index = GetCodeGen()->GetCatalogAccessor()->GetIndex(index_oid);
   const auto &index_pm = index->GetKeyOidToOffsetMap();
-  const auto &index_schema = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid);
   const auto &index_cols = index_schema.GetColumns();
 
-  const auto &op = GetPlanAs<planner::UpdatePlanNode>();
-  const auto &child = GetCompilationContext()->LookupTranslator(*op.GetChild(0));
   for (const auto &index_col : index_cols) {
     // @prSetCall(delete_index_pr, type, nullable, attr_idx, val)
     // NOTE: index expressions refer to columns in the child translator.
@@ -303,6 +323,8 @@ void UpdateTranslator::GenIndexDelete(FunctionBuilder *builder, WorkContext *con
   std::vector<ast::Expr *> delete_args{si_updater_.GetPtr(GetCodeGen()), child->GetSlotAddress()};
   auto *index_delete_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexDelete, delete_args);
   builder->Append(GetCodeGen()->MakeStmt(index_delete_call));
+
+  if (partial != nullptr) partial->EndIf();
 }
 
 std::vector<catalog::col_oid_t> UpdateTranslator::CollectOids(const catalog::Schema &schema) {
@@ -1,6 +1,8 @@
 #include "execution/compiler/pipeline.h"
 
 #include <algorithm>
+#include <string>
+#include <thread>  // NOLINT
 
 #include "common/macros.h"
 #include "common/settings.h"
@@ -56,6 +58,33 @@ void Pipeline::RegisterSource(PipelineDriver *driver, Pipeline::Parallelism para
   UpdateParallelism(parallelism);
 }
 
+void Pipeline::RegisterSource(PipelineDriver *driver, Pipeline::Parallelism parallelism,
+                              uint64_t estimated_input_rows) {
+  RegisterSource(driver, parallelism);
+  estimated_input_rows_ = estimated_input_rows;
+
+  // The decision has to be made now rather than in Prepare(), since translators registered after the source look at
+  // IsParallel() to decide whether they need thread-local state.
+  const auto &exec_settings = compilation_context_->GetExecutionSettings();
+  const uint64_t rows_per_thread = exec_settings.GetParallelExecutionRowsPerThread();
+  if (!IsParallel() || rows_per_thread == 0) return;
+
+  // Rounded up without adding to the estimate, which may be as large as the type allows
+  const uint64_t wanted =
+      estimated_input_rows / rows_per_thread + (estimated_input_rows % rows_per_thread != 0 ? 1 : 0);
+  if (wanted <= 1) {
+    UpdateParallelism(Parallelism::Serial);
+    return;
+  }
+  degree_of_parallelism_ = static_cast<uint32_t>(std::min<uint64_t>(wanted, GetMaxDegreeOfParallelism(exec_settings)));
+}
+
+uint32_t Pipeline::GetMaxDegreeOfParallelism(const exec::ExecutionSettings &exec_settings) {
+  const auto num_threads = exec_settings.GetNumberOfParallelExecutionThreads();
+  if (num_threads > 0) return static_cast<uint32_t>(num_threads);
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
 void Pipeline::UpdateParallelism(Pipeline::Parallelism parallelism) {
   if (check_parallelism_) {
     parallelism_ = std::min(parallelism, parallelism_);
@@ -226,24 +255,28 @@ void Pipeline::Prepare(const exec::ExecutionSettings &exec_settings) {
     parallelism_ = Pipeline::Parallelism::Parallel;
   }
 
-  // Pretty print.
-  {
-    std::string result;
-    bool first = true;
-    for (auto iter = Begin(), end = End(); iter != end; ++iter) {
-      if (!first) result += " --> ";
-      first = false;
-      std::string plan_type = planner::PlanNodeTypeToString((*iter)->GetPlan().GetPlanNodeType());
-      std::transform(plan_type.begin(), plan_type.end(), plan_type.begin(), ::tolower);
-      result.append(plan_type);
-    }
-    EXECUTION_LOG_TRACE("Pipeline-{}: parallel={}, vectorized={}, steps=[{}]", id_, IsParallel(), IsVectorized(),
-                        result);
-  }
+  // A pipeline that ended up serial runs on a single thread, whatever its estimate asked for.
+  if (!IsParallel()) degree_of_parallelism_ = 0;
+
+  EXECUTION_LOG_TRACE("Pipeline-{}: parallel={}, dop={}, vectorized={}, steps=[{}]", id_, IsParallel(),
+                      degree_of_parallelism_, IsVectorized(), GetStepsDescription());
 
   prepared_ = true;
 }
 
+std::string Pipeline::GetStepsDescription() const {
+  std::string result;
+  bool first = true;
+  for (auto iter = Begin(), end = End(); iter != end; ++iter) {
+    if (!first) result += " --> ";
+    first = false;
+    std::string plan_type = planner::PlanNodeTypeToString((*iter)->GetPlan().GetPlanNodeType());
+    std::transform(plan_type.begin(), plan_type.end(), plan_type.begin(), ::tolower);
+    result.append(plan_type);
+  }
+  return result;
+}
+
 ast::FunctionDecl *Pipeline::GenerateSetupPipelineStateFunction() const {
   auto name = GetSetupPipelineStateFunctionName();
   FunctionBuilder builder(codegen_, name, PipelineParams(), codegen_->Nil());
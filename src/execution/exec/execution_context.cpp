@@ -130,6 +130,16 @@ void ExecutionContext::StartPipelineTracker(pipeline_id_t pipeline_id) {
 
 void ExecutionContext::EndPipelineTracker(query_id_t query_id, pipeline_id_t pipeline_id,
                                           selfdriving::ExecOUFeatureVector *ouvec) {
+  if (observe_rows_) {
+    // Parallel pipelines end once per thread, each with the counts of the tuples that thread processed
+    common::SpinLatch::ScopedSpinLatch guard(&observed_rows_latch_);
+    for (const auto &feature : *ouvec->pipeline_features_) {
+      auto &observed = observed_rows_[{feature.GetTranslatorId(), feature.GetExecutionOperatingUnitType()}];
+      observed.num_rows_ += feature.GetNumRows();
+      observed.cardinality_ += feature.GetCardinality();
+    }
+  }
+
   if (common::thread_context.metrics_store_ != nullptr && common::thread_context.resource_tracker_.IsRunning()) {
     if (common::thread_context.nesting_depth_ == 0) {
       common::thread_context.resource_tracker_.Stop();
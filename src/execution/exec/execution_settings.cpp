@@ -10,6 +10,9 @@ void ExecutionSettings::UpdateFromSettingsManager(common::ManagedPointer<setting
     number_of_parallel_execution_threads_ = settings->GetInt(settings::Param::num_parallel_execution_threads);
     is_counters_enabled_ = settings->GetBool(settings::Param::counters_enable);
     is_pipeline_metrics_enabled_ = settings->GetBool(settings::Param::pipeline_metrics_enable);
+    analyze_sample_blocks_ = static_cast<uint32_t>(settings->GetInt(settings::Param::analyze_sample_blocks));
+    parallel_execution_rows_per_thread_ =
+        static_cast<uint32_t>(settings->GetInt(settings::Param::parallel_execution_rows_per_thread));
   }
 }
 
@@ -1,7 +1,9 @@
 #include "execution/exec/output.h"
 
+#include "common/error/exception.h"
 #include "execution/sql/value.h"
 #include "loggers/execution_logger.h"
+#include "network/postgres/portal_execution.h"
 #include "network/postgres/postgres_packet_writer.h"
 
 namespace noisepage::execution::exec {
@@ -92,15 +94,37 @@ void OutputPrinter::operator()(byte *tuples, uint32_t num_tuples, uint32_t tuple
   printed_++;
 }
 
+OutputWriter::OutputWriter(const common::ManagedPointer<planner::OutputSchema> schema,
+                           const common::ManagedPointer<network::PostgresPacketWriter> out,
+                           const std::vector<network::FieldFormat> &field_formats,
+                           const network::CopyFormat *const copy_format,
+                           const common::ManagedPointer<network::PortalExecution> portal_execution)
+    : out_(out),
+      layout_(network::PostgresPacketWriter::ComputeDataRowLayout(schema->GetColumns(), field_formats)),
+      copy_format_(copy_format != nullptr ? std::make_optional(*copy_format) : std::nullopt),
+      portal_execution_(portal_execution) {}
+
+OutputWriter::~OutputWriter() = default;
+
 void OutputWriter::operator()(byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {
   std::scoped_lock latch(output_synchronization_);
 
-  // Write out the rows for this batch
-  for (uint32_t row = 0; row < num_tuples; row++) {
-    const byte *const tuple = tuples + row * tuple_size;
-    out_->WriteDataRow(tuple, schema_->GetColumns(), field_formats_);
+  // Write out the rows for this batch. A portal with a row limit may only let part of the batch through before the
+  // query is suspended, the rest is written once the client asks for more rows.
+  for (uint32_t written = 0; written < num_tuples;) {
+    auto count = num_tuples - written;
+    if (portal_execution_ != nullptr) {
+      count = portal_execution_->AwaitRows(count);
+      if (count == 0) throw ABORT_EXCEPTION("portal closed");
+    }
+    byte *const batch = tuples + static_cast<size_t>(written) * tuple_size;
+    if (copy_format_.has_value()) {
+      out_->WriteCopyDataRows(batch, count, tuple_size, layout_, *copy_format_);
+    } else {
+      out_->WriteDataRows(batch, count, tuple_size, layout_);
+    }
+    written += count;
+    num_rows_ += count;
   }
-
-  num_rows_ += num_tuples;
 }
 }  // namespace noisepage::execution::exec
@@ -3097,6 +3097,33 @@ void Sema::CheckBuiltinAbortCall(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
+void Sema::CheckBuiltinAnalyzeColumnGroupsCall(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 3)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+  // The first argument is the execution context
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), ast::BuiltinType::ExecutionContext)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(ast::BuiltinType::ExecutionContext)->PointerTo());
+    return;
+  }
+  // The second argument is the table oid
+  if (!call_args[1]->GetType()->IsIntegerType()) {
+    ReportIncorrectCallArg(call, 1, "Second argument should be an integer type.");
+    return;
+  }
+  // The third argument is a uint32_t array of the analyzed column oids
+  auto *arr_type = call_args[2]->GetType()->SafeAs<ast::ArrayType>();
+  if (arr_type == nullptr || !arr_type->GetElementType()->IsSpecificBuiltin(ast::BuiltinType::Uint32) ||
+      !arr_type->HasKnownLength()) {
+    ReportIncorrectCallArg(call, 2, "Third argument should be a fixed length uint32 array");
+    return;
+  }
+
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckBuiltinParamCall(ast::CallExpr *call, ast::Builtin builtin) {
   if (!CheckArgCount(call, 2)) {
     return;
@@ -3971,6 +3998,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinAbortCall(call);
       break;
     }
+    case ast::Builtin::AnalyzeColumnGroups: {
+      CheckBuiltinAnalyzeColumnGroupsCall(call);
+      break;
+    }
     case ast::Builtin::GetParamBool:
     case ast::Builtin::GetParamTinyInt:
     case ast::Builtin::GetParamSmallInt:
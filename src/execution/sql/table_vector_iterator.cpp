@@ -16,6 +16,7 @@
 #include "execution/util/timer.h"
 #include "loggers/execution_logger.h"
 #include "storage/index/index.h"
+#include "transaction/transaction_context.h"
 
 namespace noisepage::execution::sql {
 
@@ -29,6 +30,7 @@ bool TableVectorIterator::Init() { return Init(0, storage::DataTable::GetMaxBloc
 
 bool TableVectorIterator::Init(uint32_t block_start, uint32_t block_end) {
   auto table = exec_ctx_->GetAccessor()->GetTable(table_oid_);
+  sample_stride_ = exec_ctx_->GetTableSampleStride(table_oid_);
   return Init(table, block_start, block_end);
 }
 
@@ -42,7 +44,14 @@ bool TableVectorIterator::Init(common::ManagedPointer<storage::SqlTable> table,
   // Set up the table and the iterator.
   table_ = table;
   NOISEPAGE_ASSERT(table_ != nullptr, "Table must exist!!");
-  if (block_start == 0 && block_end == storage::DataTable::GetMaxBlocks()) {
+  if (sample_stride_ > 1) {
+    // Vary the sampled blocks between transactions so that repeated samples do not always miss the same blocks
+    sample_offset_ = static_cast<uint32_t>(exec_ctx_->GetTxn()->StartTime().UnderlyingValue() % sample_stride_);
+    end_block_ = std::min(block_end, static_cast<uint32_t>(table_->GetNumBlocks()));
+    next_block_ = std::min(block_start, end_block_);
+    iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->GetBlockedSlotIterator(end_block_, end_block_));
+    NextSampledBlock();
+  } else if (block_start == 0 && block_end == storage::DataTable::GetMaxBlocks()) {
     iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->begin());
   } else {
     iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->GetBlockedSlotIterator(block_start, block_end));
@@ -81,9 +90,11 @@ bool TableVectorIterator::Advance() {
     return false;
   }
 
-  // If the iterator is out of data, then we are done.
-  if (*iter_ == table_->end() || (**iter_).GetBlock() == nullptr) {
-    return false;
+  // If the iterator is out of data, then move on to the next sampled block. Without sampling, we are done.
+  while (*iter_ == table_->end() || (**iter_).GetBlock() == nullptr) {
+    if (sample_stride_ == 1 || !NextSampledBlock()) {
+      return false;
+    }
   }
 
   // Otherwise, scan the table to set the vector projection.
@@ -93,6 +104,18 @@ bool TableVectorIterator::Advance() {
   return true;
 }
 
+bool TableVectorIterator::NextSampledBlock() {
+  const auto remainder = (next_block_ + sample_offset_) % sample_stride_;
+  if (remainder != 0) next_block_ += sample_stride_ - remainder;
+  if (next_block_ >= end_block_) {
+    next_block_ = end_block_;
+    return false;
+  }
+  *iter_ = table_->GetBlockedSlotIterator(next_block_, next_block_ + 1);
+  next_block_++;
+  return true;
+}
+
 namespace {
 
 class ScanTask {
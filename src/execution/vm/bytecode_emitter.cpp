@@ -406,6 +406,11 @@ void BytecodeEmitter::EmitStorageInterfaceGetIndexPR(Bytecode bytecode, LocalVar
 
 void BytecodeEmitter::EmitAbortTxn(Bytecode bytecode, LocalVar exec_ctx) { EmitAll(bytecode, exec_ctx); }
 
+void BytecodeEmitter::EmitAnalyzeColumnGroups(LocalVar exec_ctx, LocalVar table_oid, LocalVar col_oids,
+                                              uint32_t num_oids) {
+  EmitAll(Bytecode::AnalyzeColumnGroups, exec_ctx, table_oid, col_oids, num_oids);
+}
+
 void BytecodeEmitter::EmitConcat(LocalVar ret, LocalVar exec_ctx, LocalVar inputs, uint32_t num_inputs) {
   EmitAll(Bytecode::Concat, ret, exec_ctx, inputs, num_inputs);
 }
@@ -2041,6 +2041,14 @@ void BytecodeGenerator::VisitAbortTxn(ast::CallExpr *call) {
   GetEmitter()->EmitAbortTxn(Bytecode::AbortTxn, exec_ctx);
 }
 
+void BytecodeGenerator::VisitAnalyzeColumnGroups(ast::CallExpr *call) {
+  LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[0]);
+  LocalVar table_oid = VisitExpressionForRValue(call->Arguments()[1]);
+  auto *arr_type = call->Arguments()[2]->GetType()->As<ast::ArrayType>();
+  LocalVar col_oids = VisitExpressionForLValue(call->Arguments()[2]);
+  GetEmitter()->EmitAnalyzeColumnGroups(exec_ctx, table_oid, col_oids, static_cast<uint32_t>(arr_type->GetLength()));
+}
+
 void BytecodeGenerator::VisitBuiltinTestCatalogLookup(ast::CallExpr *call) {
   LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[0]);
   auto table_name_lit = call->Arguments()[1]->As<ast::LitExpr>()->StringVal();
@@ -3087,6 +3095,10 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitAbortTxn(call);
       break;
     }
+    case ast::Builtin::AnalyzeColumnGroups: {
+      VisitAnalyzeColumnGroups(call);
+      break;
+    }
     case ast::Builtin::GetParamBool:
     case ast::Builtin::GetParamTinyInt:
     case ast::Builtin::GetParamSmallInt:
@@ -1,11 +1,15 @@
 #include "execution/vm/bytecode_handlers.h"
 
+#include <vector>
+
+#include "catalog/catalog_accessor.h"
 #include "catalog/catalog_defs.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/cte_scan_iterator.h"
 #include "execution/sql/index_iterator.h"
 #include "execution/sql/storage_interface.h"
 #include "execution/sql/vector_projection_iterator.h"
+#include "optimizer/statistics/column_group_stats_collector.h"
 #include "self_driving/modeling/operating_unit_defs.h"
 
 extern "C" {
@@ -431,4 +435,23 @@ void OpAggregateMetricsThread(noisepage::execution::exec::ExecutionContext *exec
   exec_ctx->AggregateMetricsThread();
 }
 
+// ---------------------------------------------------------
+// Analyze
+// ---------------------------------------------------------
+
+void OpAnalyzeColumnGroups(noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t table_oid,
+                           const uint32_t *col_oids, uint32_t num_oids) {
+  const noisepage::catalog::table_oid_t analyzed_table_oid(table_oid);
+  std::vector<noisepage::catalog::col_oid_t> analyzed_col_oids;
+  analyzed_col_oids.reserve(num_oids);
+  for (uint32_t i = 0; i < num_oids; i++) analyzed_col_oids.emplace_back(col_oids[i]);
+
+  const auto group_stats = noisepage::optimizer::ColumnGroupStatsCollector::Collect(
+      noisepage::common::ManagedPointer(exec_ctx), analyzed_table_oid, analyzed_col_oids);
+  if (!exec_ctx->GetAccessor()->SetColumnGroupStatistics(analyzed_table_oid, group_stats)) {
+    exec_ctx->GetTxn()->SetMustAbort();
+    throw noisepage::ABORT_EXCEPTION("transaction aborted");
+  }
+}
+
 }  //
@@ -2120,6 +2120,15 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(AnalyzeColumnGroups) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto table_oid = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto *col_oids = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
+    auto num_oids = READ_UIMM4();
+    OpAnalyzeColumnGroups(exec_ctx, table_oid, col_oids, num_oids);
+    DISPATCH_NEXT();
+  }
+
   // -------------------------------------------------------
   // PR Calls
   // -------------------------------------------------------
@@ -127,6 +127,13 @@ class BindNodeVisitor final : public SqlNodeVisitor {
    */
   void ValidateDatabaseName(const std::string &db_name);
 
+  /**
+   * Validate that recovery can rebuild an index from its bound key expressions and predicate, which it interprets
+   * against the replayed tuples instead of running compiled code.
+   * @param node The CREATE INDEX statement
+   */
+  void ValidateIndexExpressions(common::ManagedPointer<parser::CreateStatement> node);
+
   /**
    * Validate values that are being inserted into table and add any default/null values for missing columns
    * @param node InsertStatement to validate
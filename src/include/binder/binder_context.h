@@ -40,8 +40,12 @@ namespace binder {
  */
 class BinderContext {
  public:
-  /** TableMetadata is currently a tuple of database oid, table oid, and schema of the table. */
-  using TableMetadata = std::tuple<catalog::db_oid_t, catalog::table_oid_t, catalog::Schema>;
+  /**
+   * TableMetadata is currently a tuple of database oid, table oid, and schema of the table. The schema is the catalog's
+   * own, which outlives the binding transaction, so binding never copies it.
+   */
+  using TableMetadata =
+      std::tuple<catalog::db_oid_t, catalog::table_oid_t, common::ManagedPointer<const catalog::Schema>>;
 
   /**
    * Initializes the BinderContext object which has an empty regular table map and an empty nested table map.
@@ -131,8 +135,7 @@ class BinderContext {
    * @param tuple Tuple of database oid, table oid, and schema object
    * @param expr Column value expression
    */
-  static void SetColumnPosTuple(const std::string &col_name,
-                                std::tuple<catalog::db_oid_t, catalog::table_oid_t, catalog::Schema> tuple,
+  static void SetColumnPosTuple(const std::string &col_name, const TableMetadata &tuple,
                                 common::ManagedPointer<parser::ColumnValueExpression> expr);
 
   /**
@@ -159,9 +162,8 @@ class BinderContext {
    * @param tuple Tuple of database oid, table oid, and schema object
    * @return Return true if the alias is found, false otherwise
    */
-  bool GetRegularTableObj(
-      const std::string &alias, common::ManagedPointer<parser::ColumnValueExpression> expr,
-      common::ManagedPointer<std::tuple<catalog::db_oid_t, catalog::table_oid_t, catalog::Schema>> tuple);
+  bool GetRegularTableObj(const std::string &alias, common::ManagedPointer<parser::ColumnValueExpression> expr,
+                          common::ManagedPointer<TableMetadata> tuple);
 
   /**
    * Check if the table, represented by the table alias, has the column indicated by the column name.
@@ -35,6 +35,7 @@ namespace noisepage::catalog {
 class Catalog;
 class DatabaseCatalog;
 class CatalogCache;
+class CatalogSnapshot;
 class IndexSchema;
 
 /**
@@ -290,6 +291,13 @@ class EXPORT CatalogAccessor {
    */
   std::string_view GetIndexName(index_oid_t index) const;
 
+  /**
+   * Obtain the name of the table
+   * @param table to which we want the name. The oid must be valid, otherwise triggers assertion
+   * @return name of the table.
+   */
+  std::string_view GetTableName(table_oid_t table) const;
+
   /**
    * Adds a language to the catalog (with default parameters for now) if
    * it doesn't exist in pg_language already
@@ -374,6 +382,14 @@ class EXPORT CatalogAccessor {
    */
   std::unique_ptr<optimizer::ColumnStatsBase> GetColumnStatistics(table_oid_t table_oid, col_oid_t col_oid);
 
+  /**
+   * Stores the statistics of pairs of columns of a table in pg_statistic, replacing any earlier statistics of the pairs
+   * @param table_oid table oid of table
+   * @param group_stats statistics of the column groups
+   * @return true if the statistics were stored, false if the transaction should abort
+   */
+  bool SetColumnGroupStatistics(table_oid_t table_oid, const std::vector<optimizer::ColumnGroupStats> &group_stats);
+
   /**
    * Gets the statistics of a table from pg_statistic
    * @param table_oid table oid of table
@@ -418,18 +434,22 @@ class EXPORT CatalogAccessor {
    * @param dbc pointer to the database catalog being accessed
    * @param txn the transaction context for this accessor
    * @param cache CatalogCache object for this connection, or nullptr if disabled
+   * @param snapshot shared metadata snapshot of the database that matches what the transaction sees, or nullptr to
+   *                 always read the catalog tables
    * @warning This constructor should never be called directly.  Instead you should get accessors from the catalog.
    */
   CatalogAccessor(const common::ManagedPointer<Catalog> catalog, const common::ManagedPointer<DatabaseCatalog> dbc,
                   const common::ManagedPointer<transaction::TransactionContext> txn,
-                  const common::ManagedPointer<CatalogCache> cache)
+                  const common::ManagedPointer<CatalogCache> cache,
+                  const common::ManagedPointer<CatalogSnapshot> snapshot = nullptr)
       : catalog_(catalog),
         dbc_(dbc),
         txn_(txn),
         search_path_({postgres::PgNamespace::NAMESPACE_CATALOG_NAMESPACE_OID,
                       postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID}),
         default_namespace_(postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID),
-        cache_(cache) {}
+        cache_(cache),
+        snapshot_(snapshot) {}
 
  private:
   const common::ManagedPointer<Catalog> catalog_;
@@ -438,6 +458,7 @@ class EXPORT CatalogAccessor {
   std::vector<namespace_oid_t> search_path_;
   namespace_oid_t default_namespace_;
   const common::ManagedPointer<CatalogCache> cache_ = nullptr;
+  const common::ManagedPointer<CatalogSnapshot> snapshot_ = nullptr;
 
   /**
    * temporary table catalog that hosts mappings from a temporary table oid
@@ -454,6 +475,12 @@ class EXPORT CatalogAccessor {
   static void NormalizeObjectName(std::string *name) {
     std::transform(name->begin(), name->end(), name->begin(), [](auto &&c) { return std::tolower(c); });
   }
+
+  /**
+   * @return the snapshot to read metadata through, or nullptr if this accessor was created without one or its
+   * transaction changed the catalog since, which it has to see
+   */
+  common::ManagedPointer<CatalogSnapshot> Snapshot() const;
 };
 
 }  // namespace noisepage::catalog
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/container/concurrent_map.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "transaction/transaction_defs.h"
+#include "xxHash/xxh3.h"
+
+namespace noisepage {
+class CatalogTests_SnapshotDDLBypassTest_Test;
+class CatalogTests_SnapshotLookupTest_Test;
+class CatalogTests_SnapshotNegativeEntryTest_Test;
+}  // namespace noisepage
+
+namespace noisepage::storage {
+class SqlTable;
+namespace index {
+class Index;
+}
+}  // namespace noisepage::storage
+
+namespace noisepage::catalog {
+class CatalogAccessor;
+class IndexSchema;
+class Schema;
+
+/**
+ * Metadata of one database's catalog as of a catalog version, shared by all connections. The version is the commit
+ * timestamp of the last DDL change to the database, so every transaction that started after that commit and before the
+ * next DDL commit sees exactly the same catalog, and their CatalogAccessors read it from here instead of scanning the
+ * catalog tables.
+ *
+ * Entries are filled in lazily by the first transaction that looks them up and never change afterwards: a DDL commit
+ * replaces the whole snapshot (see DatabaseCatalog::TryLock) instead of updating it. Lookups and insertions go through
+ * concurrent maps, so readers never take a latch. Missing objects are remembered too, since creating them takes DDL.
+ *
+ * Most operations are expected to only be performed by CatalogAccessor, which is why most of this class is private and
+ * the CatalogAccessor is designated as a friend class.
+ */
+class CatalogSnapshot {
+ public:
+  /**
+   * Create an empty snapshot.
+   * @param version commit timestamp of the last DDL change that the snapshot reflects
+   */
+  explicit CatalogSnapshot(const transaction::timestamp_t version) : version_(version) {}
+
+  /** This class cannot be copied or moved. */
+  DISALLOW_COPY_AND_MOVE(CatalogSnapshot);
+
+  /** @return The commit timestamp of the last DDL change that this snapshot reflects */
+  transaction::timestamp_t Version() const { return version_; }
+
+ private:
+  friend class CatalogAccessor;
+
+  friend class noisepage::CatalogTests_SnapshotDDLBypassTest_Test;
+  friend class noisepage::CatalogTests_SnapshotLookupTest_Test;
+  friend class noisepage::CatalogTests_SnapshotNegativeEntryTest_Test;
+
+  /** Name of an object within a namespace. */
+  using NameKey = std::pair<uint32_t, std::string>;
+
+  /** We'll use xxHash for the names, seeded with the namespace, since it's a fast hash algorithm for strings. */
+  struct NameKeyHasher {
+    std::size_t operator()(const NameKey &key) const {
+      return XXH3_64bits_withSeed(key.second.data(), key.second.length(), key.first);
+    }
+  };
+
+  template <typename K, typename V, typename Hasher = std::hash<K>>
+  using Map = common::ConcurrentMap<K, V, Hasher>;
+
+  /**
+   * Look up a key, and load and remember its value if this is the first lookup of the key in this snapshot.
+   * @param map map to look in
+   * @param key key to look up
+   * @param load loads the value from the catalog tables
+   * @return the value of the key
+   */
+  template <typename K, typename V, typename Hasher, typename Loader>
+  static V GetOrLoad(Map<K, V, Hasher> *const map, const K &key, const Loader &load) {
+    const auto it = map->Find(key);
+    if (it != map->end()) return it->second;
+    // Concurrent loads of the same key produce the same value, so it does not matter whose insertion wins
+    V value = load();
+    map->Insert(key, value);
+    return value;
+  }
+
+  const transaction::timestamp_t version_;
+
+  Map<std::string, namespace_oid_t> namespace_oids_;
+  Map<NameKey, table_oid_t, NameKeyHasher> table_oids_;
+  Map<NameKey, index_oid_t, NameKeyHasher> index_oids_;
+  Map<table_oid_t, storage::SqlTable *> tables_;
+  Map<table_oid_t, const Schema *> schemas_;
+  Map<table_oid_t, std::vector<index_oid_t>> table_indexes_;
+  Map<table_oid_t, std::vector<constraint_oid_t>> table_constraints_;
+  Map<index_oid_t, storage::index::Index *> indexes_;
+  Map<index_oid_t, const IndexSchema *> index_schemas_;
+};
+
+}  // namespace noisepage::catalog
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "catalog/catalog_snapshot.h"
 #include "catalog/postgres/pg_constraint_impl.h"
 #include "catalog/postgres/pg_core_impl.h"
 #include "catalog/postgres/pg_language_impl.h"
@@ -43,12 +45,32 @@ namespace noisepage::catalog {
  */
 class DatabaseCatalog {
  public:
+  /** @brief Free the current metadata snapshot, older ones were freed by the DDL commits that replaced them. */
+  ~DatabaseCatalog() { delete snapshot_.load(); }
+
   /**
    * @brief Bootstrap the entire catalog with default entries.
    * @param txn         The transaction to bootstrap in.
    */
   void Bootstrap(common::ManagedPointer<transaction::TransactionContext> txn);
 
+  /**
+   * @brief Get the shared snapshot of this database's metadata that matches what the transaction sees of the catalog.
+   *
+   * @param txn         The requesting transaction.
+   * @return            The snapshot, or nullptr if the transaction cannot use it: a DDL change is in progress, or one
+   *                    was committed after the transaction started.
+   */
+  common::ManagedPointer<CatalogSnapshot> GetSnapshot(
+      common::ManagedPointer<transaction::TransactionContext> txn) const;
+
+  /**
+   * @param txn         The transaction to check.
+   * @return            True if the transaction holds the DDL lock, i.e., changed this database's catalog. Its own
+   *                    changes are not part of any snapshot.
+   */
+  bool IsLockedBy(common::ManagedPointer<transaction::TransactionContext> txn) const;
+
   /** @brief Create a new namespace, may fail with INVALID_NAMESPACE_OID. @see PgCoreImpl::CreateNamespace */
   namespace_oid_t CreateNamespace(common::ManagedPointer<transaction::TransactionContext> txn, const std::string &name);
   /** @brief Delete the specified namespace. @see PgCoreImpl::DeleteNamespace */
@@ -113,6 +135,9 @@ class DatabaseCatalog {
   /** @brief Get the name of the specified index */
   std::string_view GetIndexName(common::ManagedPointer<transaction::TransactionContext> txn, index_oid_t index);
 
+  /** @brief Get the name of the specified table */
+  std::string_view GetTableName(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table);
+
   /** @brief Get the schema for the specified table. */
   const Schema &GetSchema(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table);
   /** @brief Get the index schema for the specified index. */
@@ -186,6 +211,10 @@ class DatabaseCatalog {
   std::unique_ptr<optimizer::ColumnStatsBase> GetColumnStatistics(
       common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table_oid, col_oid_t col_oid);
 
+  /** @brief Set the column group statistics of the specified table. @see PgStatisticImpl::SetColumnGroupStatistics */
+  bool SetColumnGroupStatistics(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table_oid,
+                                const std::vector<optimizer::ColumnGroupStats> &group_stats);
+
   /** @brief Get the statistics for the specified table. @see PgStatisticImpl::GetTableStatistics */
   optimizer::TableStats GetTableStatistics(common::ManagedPointer<transaction::TransactionContext> txn,
                                            table_oid_t table_oid);
@@ -216,6 +245,7 @@ class DatabaseCatalog {
   // Miscellaneous state.
   std::atomic<uint32_t> next_oid_;                    ///< The next OID, shared across different pg tables.
   std::atomic<transaction::timestamp_t> write_lock_;  ///< Used to prevent concurrent DDL change.
+  std::atomic<CatalogSnapshot *> snapshot_;           ///< Metadata as of the last DDL commit, replaced by every commit.
   const db_oid_t db_oid_;  ///< The OID of the database that this DatabaseCatalog is established in.
   const common::ManagedPointer<storage::GarbageCollector> garbage_collector_;  ///< The garbage collector used.
 
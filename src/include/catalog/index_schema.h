@@ -491,23 +491,69 @@ class IndexSchema {
    * @param is_exclusion indicating whether this index is for exclusion constraints
    * @param is_immediate indicating that the uniqueness check fails at insertion time
    * @param index_options that are options for building the index
+   * @param predicate partial index predicate, nullptr if every tuple of the table is indexed
    */
   IndexSchema(std::vector<Column> columns, const storage::index::IndexType type, const bool is_unique,
               const bool is_primary, const bool is_exclusion, const bool is_immediate,
-              const IndexOptions &index_options)
+              const IndexOptions &index_options, std::unique_ptr<parser::AbstractExpression> predicate = nullptr)
       : columns_(std::move(columns)),
         type_(type),
         is_unique_(is_unique),
         is_primary_(is_primary),
         is_exclusion_(is_exclusion),
         is_immediate_(is_immediate),
-        index_options_(index_options) {
+        index_options_(index_options),
+        predicate_(std::move(predicate)) {
     NOISEPAGE_ASSERT((is_primary && is_unique) || (!is_primary), "is_primary requires is_unique to be true as well.");
     ExtractIndexedColOids();
   }
 
   IndexSchema() = default;
 
+  /**
+   * Overrides default copy constructor to ensure we do a deep copy on the predicate
+   * @param other index schema to be copied
+   */
+  IndexSchema(const IndexSchema &other)
+      : columns_(other.columns_),
+        type_(other.type_),
+        indexed_oids_(other.indexed_oids_),
+        is_unique_(other.is_unique_),
+        is_primary_(other.is_primary_),
+        is_exclusion_(other.is_exclusion_),
+        is_immediate_(other.is_immediate_),
+        index_options_(other.index_options_),
+        predicate_(other.predicate_ == nullptr ? nullptr : other.predicate_->Copy()) {}
+
+  /** Default move constructor */
+  IndexSchema(IndexSchema &&other) = default;
+
+  /**
+   * Allows operator= to call IndexSchema's custom copy-constructor.
+   * @param other index schema to be copied
+   * @return the current index schema after update
+   */
+  IndexSchema &operator=(const IndexSchema &other) {
+    if (this == &other) return *this;
+    columns_ = other.columns_;
+    type_ = other.type_;
+    indexed_oids_ = other.indexed_oids_;
+    is_unique_ = other.is_unique_;
+    is_primary_ = other.is_primary_;
+    is_exclusion_ = other.is_exclusion_;
+    is_immediate_ = other.is_immediate_;
+    index_options_ = IndexOptions(other.index_options_);
+    predicate_ = other.predicate_ == nullptr ? nullptr : other.predicate_->Copy();
+    return *this;
+  }
+
+  /**
+   * Default move assignment
+   * @param other index schema to be moved
+   * @return the current index schema after update
+   */
+  IndexSchema &operator=(IndexSchema &&other) = default;
+
   /**
    * @return the columns which define the index's schema
    */
@@ -596,6 +642,27 @@ class IndexSchema {
    */
   const IndexOptions &GetIndexOptions() const { return index_options_; }
 
+  /**
+   * @return the predicate of a partial index, nullptr if every tuple of the table is indexed
+   */
+  common::ManagedPointer<const parser::AbstractExpression> GetPredicate() const {
+    return common::ManagedPointer(static_cast<const parser::AbstractExpression *>(predicate_.get()));
+  }
+
+  /**
+   * @return true if the index only covers the tuples satisfying its predicate
+   */
+  bool IsPartial() const { return predicate_ != nullptr; }
+
+  /**
+   * @return true if any key column is computed from an expression rather than being a plain table column
+   */
+  bool HasExpressionKeys() const {
+    return std::any_of(columns_.cbegin(), columns_.cend(), [](const Column &col) {
+      return col.StoredExpression()->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE;
+    });
+  }
+
   /**
    * @warning Calling this function will traverse the entire expression tree for each column, which may be expensive
    * for large expressions. Thus, it should only be called once during object construction.
@@ -643,6 +710,7 @@ class IndexSchema {
     hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(is_exclusion_));
     hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(is_immediate_));
     hash = common::HashUtil::CombineHashes(hash, index_options_.Hash());
+    if (predicate_ != nullptr) hash = common::HashUtil::CombineHashes(hash, predicate_->Hash());
     return hash;
   }
 
@@ -660,6 +728,8 @@ class IndexSchema {
     // TODO(Ling): Does column order matter for compare equal?
     if (indexed_oids_ != rhs.indexed_oids_) return false;
     if (columns_ != rhs.columns_) return false;
+    if ((predicate_ == nullptr) != (rhs.predicate_ == nullptr)) return false;
+    if (predicate_ != nullptr && *predicate_ != *rhs.predicate_) return false;
     return index_options_ == rhs.index_options_;
   }
 
@@ -685,6 +755,7 @@ class IndexSchema {
   bool is_exclusion_;
   bool is_immediate_;
   IndexOptions index_options_;
+  std::unique_ptr<parser::AbstractExpression> predicate_;
 };
 
 DEFINE_JSON_HEADER_DECLARATIONS(IndexOptions);
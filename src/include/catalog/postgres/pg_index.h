@@ -39,12 +39,14 @@ class PgIndex {
   static constexpr CatalogColumnDef<bool> INDISREADY{col_oid_t{8}};                 // BOOLEAN
   static constexpr CatalogColumnDef<bool> INDISLIVE{col_oid_t{9}};                  // BOOLEAN
   static constexpr CatalogColumnDef<char, uint8_t> IND_TYPE{col_oid_t{10}};         // CHAR (see IndexSchema)
+  static constexpr CatalogColumnDef<storage::VarlenEntry> INDPRED{col_oid_t{11}};   // VARCHAR (JSON, NULL if full)
 
-  static constexpr uint8_t NUM_PG_INDEX_COLS = 10;
+  static constexpr uint8_t NUM_PG_INDEX_COLS = 11;
 
   static constexpr std::array<col_oid_t, NUM_PG_INDEX_COLS> PG_INDEX_ALL_COL_OIDS = {
       INDOID.oid_,       INDRELID.oid_,   INDISUNIQUE.oid_, INDISPRIMARY.oid_, INDISEXCLUSION.oid_,
-      INDIMMEDIATE.oid_, INDISVALID.oid_, INDISREADY.oid_,  INDISLIVE.oid_,    IND_TYPE.oid_};
+      INDIMMEDIATE.oid_, INDISVALID.oid_, INDISREADY.oid_,  INDISLIVE.oid_,    IND_TYPE.oid_,
+      INDPRED.oid_};
 };
 
 }  // namespace noisepage::catalog::postgres
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "catalog/catalog_defs.h"
 #include "catalog/postgres/pg_statistic.h"
@@ -119,6 +120,17 @@ class PgStatisticImpl {
    */
   bool DeleteColumnStatistics(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table_oid);
 
+  /**
+   * Insert or replace the column group statistic entries for a table in pg_statistic.
+   *
+   * @param txn                 The transaction to use.
+   * @param table_oid           The OID of the table.
+   * @param group_stats         The statistics of pairs of columns of the table.
+   * @return                    True if the entries were written. False if the transaction should abort.
+   */
+  bool SetColumnGroupStatistics(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table_oid,
+                                const std::vector<optimizer::ColumnGroupStats> &group_stats);
+
   /**
    * Retrieve the column statistic entry for a particular column from pg_statistic.
    *
@@ -159,6 +171,18 @@ class PgStatisticImpl {
       common::ManagedPointer<storage::ProjectedRow> all_cols_pr, table_oid_t table_oid, col_oid_t col_oid,
       type::TypeId type);
 
+  /**
+   * Helper method that creates a column group statistics object from a projected row
+   *
+   * @pre Projected row must be initialed with row contents
+   *
+   * @param all_cols_pr     Projected row from pg_statistic table. Must already be initialized with a row's contents
+   * @param group_oid       Encoded column group oid of the row, see optimizer::ColumnGroupStats::EncodeGroupOid
+   * @return                Column group statistics
+   */
+  std::unique_ptr<optimizer::ColumnGroupStats> CreateColumnGroupStats(
+      common::ManagedPointer<storage::ProjectedRow> all_cols_pr, col_oid_t group_oid);
+
   /**
    * Helper method that creates a columns statistics object from supplied information
    * @tparam T                  SQL type of the column
@@ -126,5 +126,18 @@ struct Constants {
    * Flag indicating if static partitioner is used
    */
   static constexpr const bool IS_STATIC_PARTITIONER_ENABLED = false;
+
+  /**
+   * Number of blocks ANALYZE reads from a table, larger tables are sampled. Zero disables sampling.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint32_t ANALYZE_SAMPLE_BLOCKS = 256;
+
+  /**
+   * Estimated number of input rows per thread of a parallel pipeline. Pipelines estimated to read fewer rows run
+   * serially. Zero runs every parallel pipeline with all threads.
+   * This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const uint32_t PARALLEL_EXECUTION_ROWS_PER_THREAD = 16384;
 };
 }  // namespace noisepage::common
@@ -50,6 +50,26 @@ class ResourceTracker {
               << rusage_.ru_oublock << ", " << memory_b_ << ", " << elapsed_us_;
     }
 
+    /**
+     * Writes the metrics out to a binary file, as one 8-byte value per column of COLUMNS
+     * @param outfile opened ofstream to write to
+     */
+    void ToBinary(std::ofstream &outfile) const {
+      auto ref_cycles = execution::CpuInfo::Instance()->GetRefCyclesUs();
+      metrics::MetricsUtil::WriteBinary<uint64_t>(&outfile, start_);
+      metrics::MetricsUtil::WriteBinary<int64_t>(&outfile, cpu_id_);
+      metrics::MetricsUtil::WriteBinary<uint64_t>(&outfile, counters_.cpu_cycles_);
+      metrics::MetricsUtil::WriteBinary<uint64_t>(&outfile, counters_.instructions_);
+      metrics::MetricsUtil::WriteBinary<uint64_t>(&outfile, counters_.cache_references_);
+      metrics::MetricsUtil::WriteBinary<uint64_t>(&outfile, counters_.cache_misses_);
+      metrics::MetricsUtil::WriteBinary<uint64_t>(&outfile,
+                                                  (ref_cycles == 0) ? 0 : counters_.ref_cpu_cycles_ / ref_cycles);
+      metrics::MetricsUtil::WriteBinary<int64_t>(&outfile, rusage_.ru_inblock);
+      metrics::MetricsUtil::WriteBinary<int64_t>(&outfile, rusage_.ru_oublock);
+      metrics::MetricsUtil::WriteBinary<uint64_t>(&outfile, memory_b_);
+      metrics::MetricsUtil::WriteBinary<uint64_t>(&outfile, elapsed_us_);
+    }
+
     /** Column headers to emit when writing to CSV */
     static constexpr std::string_view COLUMNS = {
         "start_time, cpu_id, cpu_cycles, instructions, cache_ref, cache_miss, ref_cpu_cycles, "
@@ -402,6 +402,7 @@ namespace noisepage::execution::ast {
   F(AggregateMetricsThread, aggregateMetricsThread)                     \
                                                                         \
   F(AbortTxn, abortTxn)                                                 \
+  F(AnalyzeColumnGroups, analyzeColumnGroups)                           \
                                                                         \
   /* FOR TESTING USE ONLY!!!!! */                                       \
   F(TestCatalogLookup, testCatalogLookup)                               \
@@ -594,11 +594,12 @@ class CodeGen {
    * @param query_state The query state pointer.
    * @param exec_ctx The execution context that we are running in.
    * @param worker_name The work function name.
+   * @param num_threads The number of threads to scan with, 0 for the configured number of parallel threads.
    * @return The call.
    */
   [[nodiscard]] ast::Expr *IterateTableParallel(catalog::table_oid_t table_oid, ast::Identifier col_oids,
                                                 ast::Expr *query_state, ast::Expr *exec_ctx,
-                                                ast::Identifier worker_name);
+                                                ast::Identifier worker_name, uint32_t num_threads = 0);
 
   /**
    * Call \@tempTableIterInitBind(&tvi, execCtx, oids, &cte_scan_iterator)
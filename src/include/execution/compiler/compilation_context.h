@@ -62,6 +62,18 @@ class CompilationContext {
       std::optional<execution::query_id_t> override_qid = std::nullopt,
       common::ManagedPointer<planner::PlanMetaData> plan_meta_data = nullptr);
 
+  /**
+   * Lay out the pipelines of the given plan the way Compile() would, without generating or compiling their code.
+   * @param plan The plan to lay out.
+   * @param exec_settings The execution settings that the plan would be compiled with.
+   * @param accessor The catalog accessor to use.
+   * @param plan_meta_data Query plan meta data (stores cardinality information)
+   * @return How each pipeline of the plan would run, in execution order.
+   */
+  static std::vector<ExecutableQuery::PipelineInfo> DescribePipelines(
+      const planner::AbstractPlanNode &plan, const exec::ExecutionSettings &exec_settings,
+      catalog::CatalogAccessor *accessor, common::ManagedPointer<planner::PlanMetaData> plan_meta_data = nullptr);
+
   /**
    * Register a pipeline in this context.
    * @param pipeline The pipeline.
@@ -133,6 +145,19 @@ class CompilationContext {
   /** @return Query Id associated with the query */
   query_id_t GetQueryId() const { return query_id_; }
 
+  /** @return The execution settings the query is compiled with. */
+  const exec::ExecutionSettings &GetExecutionSettings() const;
+
+  /** @return The meta data (estimated cardinalities) of the plan being compiled, nullptr if there is none. */
+  common::ManagedPointer<planner::PlanMetaData> GetPlanMetaData() const { return plan_meta_data_; }
+
+  /**
+   * Makes the compiled query scan only a sample of the blocks of the given table.
+   * @param table_oid The table to sample.
+   * @param stride Only one out of every stride blocks of the table is scanned.
+   */
+  void SetTableSample(catalog::table_oid_t table_oid, uint32_t stride);
+
  private:
   // Private to force use of static Compile() function.
   explicit CompilationContext(ExecutableQuery *query, query_id_t query_id_, catalog::CatalogAccessor *accessor,
@@ -142,6 +167,13 @@ class CompilationContext {
   void GeneratePlan(const planner::AbstractPlanNode &plan,
                     common::ManagedPointer<planner::PlanMetaData> plan_meta_data);
 
+  // Prepare the translators of every plan node, rooted at the main pipeline.
+  void PrepareTranslators(const planner::AbstractPlanNode &plan,
+                          common::ManagedPointer<planner::PlanMetaData> plan_meta_data, Pipeline *main_pipeline);
+
+  // Finalize the state and the parallelism of a pipeline, and record how it runs.
+  void PreparePipeline(Pipeline *pipeline);
+
   // Generate the query initialization function.
   ast::FunctionDecl *GenerateInitFunction();
 
@@ -175,6 +207,9 @@ class CompilationContext {
   StateDescriptor query_state_;
   StateDescriptor::Entry exec_ctx_;
 
+  // The meta data of the plan being compiled, if any.
+  common::ManagedPointer<planner::PlanMetaData> plan_meta_data_{nullptr};
+
   // The operator and expression translators.
   std::unordered_map<const planner::AbstractPlanNode *, std::unique_ptr<OperatorTranslator>> ops_;
   std::unordered_map<const parser::AbstractExpression *, std::unique_ptr<ExpressionTranslator>> expressions_;
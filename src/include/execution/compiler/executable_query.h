@@ -2,14 +2,19 @@
 
 #include <iosfwd>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "catalog/catalog_defs.h"
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "execution/ast/ast_fwd.h"
 #include "execution/exec_defs.h"
 #include "execution/vm/vm_defs.h"
+#include "planner/plannodes/plan_node_defs.h"
 #include "transaction/transaction_defs.h"
 
 namespace noisepage {
@@ -172,6 +177,56 @@ class ExecutableQuery {
   /** @return The query fragments in this module. */
   const std::vector<std::unique_ptr<Fragment>> &GetFragments() const { return fragments_; }
 
+  /** How a pipeline of the query was compiled to run, as shown by EXPLAIN. */
+  struct PipelineInfo {
+    /** The ID of the pipeline. */
+    uint32_t pipeline_id_;
+    /** The steps of the pipeline from the source onwards. */
+    std::string steps_;
+    /** The number of threads the pipeline runs on, 1 if it runs serially. */
+    uint32_t degree_of_parallelism_;
+    /** The number of rows the source of the pipeline was estimated to produce, if known. */
+    std::optional<uint64_t> estimated_input_rows_;
+  };
+
+  /**
+   * Records how a pipeline of the query was compiled.
+   * @param info The pipeline.
+   */
+  void AddPipelineInfo(PipelineInfo info) { pipeline_infos_.emplace_back(std::move(info)); }
+
+  /** @return The pipelines of the query, in the order they were compiled. */
+  const std::vector<PipelineInfo> &GetPipelineInfos() const { return pipeline_infos_; }
+
+  /**
+   * Records the plan node that an operator translator generated code for.
+   * @param translator_id The ID of the translator.
+   * @param plan The plan node of the translator.
+   */
+  void AddTranslatorPlan(translator_id_t translator_id, const planner::AbstractPlanNode *plan) {
+    translator_plans_[translator_id] = plan;
+  }
+
+  /**
+   * Attributes the rows that the operating units counted during a run to the plan nodes that produced them. Most
+   * operating units count the rows flowing into them, which are the rows produced by the child plan node feeding the
+   * pipeline. A hash join probe additionally counts the rows produced by the join itself.
+   * @param exec_ctx The context the query ran in, which must have been observing rows.
+   * @return The number of rows produced by every plan node that could be observed.
+   */
+  std::unordered_map<planner::plan_node_id_t, size_t> GetObservedOutputRows(
+      const exec::ExecutionContext &exec_ctx) const;
+
+  /**
+   * Makes every execution of this query scan only a sample of the blocks of the given table.
+   * @param table_oid The table to sample.
+   * @param stride Only one out of every stride blocks of the table is scanned.
+   */
+  void SetTableSample(catalog::table_oid_t table_oid, uint32_t stride) {
+    sampled_table_oid_ = table_oid;
+    sample_stride_ = stride;
+  }
+
  private:
   // The plan.
   const planner::AbstractPlanNode &plan_;
@@ -193,6 +248,16 @@ class ExecutableQuery {
   // The pipeline operating units that were generated as part of this query.
   std::unique_ptr<selfdriving::PipelineOperatingUnits> pipeline_operating_units_;
 
+  // The pipelines of the query, in the order they were compiled.
+  std::vector<PipelineInfo> pipeline_infos_;
+
+  // The plan node that each operator translator generated code for.
+  std::unordered_map<translator_id_t, const planner::AbstractPlanNode *> translator_plans_;
+
+  // The table whose scans are restricted to a sample of its blocks, if any, and the sampling stride.
+  catalog::table_oid_t sampled_table_oid_{catalog::INVALID_TABLE_OID};
+  uint32_t sample_stride_{1};
+
   // For mini_runners.cpp
 
   /** Legacy constructor that creates a hardcoded fragment with main(ExecutionContext*)->int32. */
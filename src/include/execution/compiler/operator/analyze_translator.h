@@ -89,6 +89,8 @@ class AnalyzeTranslator : public OperatorTranslator, public PipelineDriver {
   ast::Identifier pg_statistic_index_pr_;
   StateDescriptor::Entry pg_statistic_updater_;  ///< Storage interface for updates.
   ast::Identifier pg_statistic_update_pr_;
+  // Only one out of every sample_stride_ blocks of the analyzed table is scanned
+  uint32_t sample_stride_{1};
 
   void SetPgStatisticColOids(FunctionBuilder *function) const;
   void InitPgStatisticVariables(WorkContext *context, FunctionBuilder *function) const;
@@ -96,6 +98,8 @@ class AnalyzeTranslator : public OperatorTranslator, public PipelineDriver {
   void InitPgStatisticIterator(FunctionBuilder *function) const;
   void InitPgStatisticIndexPR(FunctionBuilder *function) const;
   void AssignColumnStatistics(WorkContext *context, FunctionBuilder *function, size_t column_offset) const;
+  void ScaleSampledColumnStatistics(FunctionBuilder *function) const;
+  ast::Expr *ScaleBySampleStride(ast::Expr *sampled_count) const;
   void DeclarePgStatisticSlot(FunctionBuilder *function, ast::Identifier slot) const;
   void DeclareAndInitPgStatisticUpdater(FunctionBuilder *function) const;
   void DeclarePgStatisticUpdatePr(FunctionBuilder *function) const;
@@ -106,6 +110,7 @@ class AnalyzeTranslator : public OperatorTranslator, public PipelineDriver {
   void DeleteFromPgStatisticIndex(FunctionBuilder *function, ast::Identifier slot,
                                   catalog::index_oid_t index_oid) const;
   void InsertIntoPgStatisticIndex(FunctionBuilder *function, catalog::index_oid_t index_oid) const;
+  void AnalyzeColumnGroups(FunctionBuilder *function) const;
   void FreePgStatisticUpdater(FunctionBuilder *function) const;
   void FreePgStatisticIterator(FunctionBuilder *function) const;
 
@@ -248,6 +248,9 @@ class OperatorTranslator : public ColumnValueProvider {
   /** @return Feature type. */
   selfdriving::ExecutionOperatingUnitType GetFeatureType() const { return feature_type_; }
 
+  /** @return The ID of this OperatorTranslator, used for identifying features in operating unit feature vectors. */
+  execution::translator_id_t GetTranslatorId() const { return translator_id_; }
+
   /** @return The plan node as a generic node. */
   const planner::AbstractPlanNode *Op() const { return &plan_; }
 
@@ -290,9 +293,6 @@ class OperatorTranslator : public ColumnValueProvider {
   void GetAllChildOutputFields(uint32_t child_index, const std::string &field_name_prefix,
                                util::RegionVector<ast::FieldDecl *> *fields) const;
 
-  /** @return The ID of this OperatorTranslator, used for identifying features in operating unit feature vectors. */
-  execution::translator_id_t GetTranslatorId() const { return translator_id_; }
-
   /** @return True if we should collect counters in TPL, used for Lin's models. */
   bool IsCountersEnabled() const;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -83,6 +84,17 @@ class Pipeline {
    */
   void RegisterSource(PipelineDriver *driver, Parallelism parallelism);
 
+  /**
+   * Register the source/driver for the pipeline and choose the degree of parallelism from the number of rows the
+   * driver is estimated to produce. A parallel pipeline is made serial if the estimate is too small to keep a second
+   * thread busy, i.e., at most parallel_execution_rows_per_thread rows. Otherwise, it runs on one thread per
+   * parallel_execution_rows_per_thread rows, up to the number of parallel execution threads.
+   * @param driver The single driver for the pipeline.
+   * @param parallelism The driver's requested parallelism.
+   * @param estimated_input_rows The number of rows the driver is estimated to produce.
+   */
+  void RegisterSource(PipelineDriver *driver, Parallelism parallelism, uint64_t estimated_input_rows);
+
   /**
    * Update the current parallelism level for this pipeline to the value provided.
    * @param parallelism The desired parallelism level.
@@ -153,6 +165,24 @@ class Pipeline {
    */
   bool IsVectorized() const { return false; }
 
+  /**
+   * @return The number of threads a parallel pipeline should run on, 0 if it was not chosen from an estimate and the
+   *         configured number of parallel execution threads applies.
+   */
+  uint32_t GetDegreeOfParallelism() const { return degree_of_parallelism_; }
+
+  /** @return The number of rows the driver of the pipeline is estimated to produce, if an estimate was given. */
+  std::optional<uint64_t> GetEstimatedInputRows() const { return estimated_input_rows_; }
+
+  /** @return The steps of the pipeline from the source onwards, e.g., "seqscan --> hashjoin". */
+  std::string GetStepsDescription() const;
+
+  /**
+   * @param exec_settings The execution settings used for query compilation.
+   * @return The largest number of threads a parallel pipeline may run on.
+   */
+  static uint32_t GetMaxDegreeOfParallelism(const exec::ExecutionSettings &exec_settings);
+
   /**
    * Typedef used to specify an iterator over the steps in a pipeline.
    */
@@ -325,6 +355,10 @@ class Pipeline {
   std::vector<ast::FieldDecl *> extra_pipeline_params_;
   // Configured parallelism.
   Parallelism parallelism_;
+  // Number of threads chosen for a parallel pipeline, 0 if not chosen from an estimate.
+  uint32_t degree_of_parallelism_{0};
+  // Number of rows the driver is estimated to produce.
+  std::optional<uint64_t> estimated_input_rows_;
   // Whether to check for parallelism in new pipeline elements.
   bool check_parallelism_;
   // Whether or not this is a nested pipeline
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "catalog/catalog_defs.h"
 #include "common/managed_pointer.h"
+#include "common/spin_latch.h"
 #include "execution/exec/execution_settings.h"
 #include "execution/exec/output.h"
 #include "execution/exec_defs.h"
@@ -173,6 +176,30 @@ class EXPORT ExecutionContext {
    */
   void EndPipelineTracker(query_id_t query_id, pipeline_id_t pipeline_id, selfdriving::ExecOUFeatureVector *ouvec);
 
+  /** Rows counted by an operating unit of a translator, summed over all threads that ran its pipeline */
+  struct ObservedRows {
+    /** Counted NUM_ROWS feature */
+    size_t num_rows_ = 0;
+    /** Counted CARDINALITY feature */
+    size_t cardinality_ = 0;
+  };
+
+  /** Identifies an operating unit of a translator */
+  using ObservedRowsKey = std::pair<translator_id_t, selfdriving::ExecutionOperatingUnitType>;
+
+  /**
+   * Sets whether EndPipelineTracker keeps the rows counted by the operating units of every pipeline, so that they can
+   * be compared against the estimates of the optimizer after the query ran. This requires the query to be compiled
+   * with counters and pipeline metrics enabled.
+   * @param observe_rows whether to keep the counted rows
+   */
+  void SetObserveRows(bool observe_rows) { observe_rows_ = observe_rows; }
+
+  /**
+   * @return the rows counted by the operating units of the pipelines that ran, if SetObserveRows was enabled
+   */
+  const std::map<ObservedRowsKey, ObservedRows> &GetObservedRows() const { return observed_rows_; }
+
   /**
    * Initializes an OU feature vector for a given pipeline
    * @param ouvec OU Feature Vector to initialize
@@ -284,6 +311,21 @@ class EXPORT ExecutionContext {
    */
   void SetQueryId(execution::query_id_t query_id) { query_id_ = query_id; }
 
+  /**
+   * Restricts every scan of the given table to a sample of its blocks, as used by ANALYZE on large tables.
+   * @param table_oid The table to sample.
+   * @param stride Only one out of every stride blocks of the table is scanned.
+   */
+  void SetTableSample(catalog::table_oid_t table_oid, uint32_t stride) {
+    sampled_table_oid_ = table_oid;
+    sample_stride_ = stride;
+  }
+
+  /** @return One out of how many blocks of the given table are scanned, 1 if the whole table is scanned. */
+  uint32_t GetTableSampleStride(catalog::table_oid_t table_oid) const {
+    return table_oid == sampled_table_oid_ ? sample_stride_ : 1;
+  }
+
   /**
    * Overrides recording from memory tracker
    * This should never be used by parallel threads directly
@@ -356,6 +398,8 @@ class EXPORT ExecutionContext {
   common::ManagedPointer<metrics::MetricsManager> metrics_manager_;
   common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> params_;
   uint8_t execution_mode_;
+  catalog::table_oid_t sampled_table_oid_{catalog::INVALID_TABLE_OID};
+  uint32_t sample_stride_{1};
   uint32_t rows_affected_ = 0;
 
   common::ManagedPointer<replication::ReplicationManager> replication_manager_;
@@ -366,5 +410,9 @@ class EXPORT ExecutionContext {
   uint32_t num_concurrent_estimate_ = 0;
   std::vector<HookFn> hooks_{};
   void *query_state_;
+
+  bool observe_rows_ = false;
+  common::SpinLatch observed_rows_latch_;
+  std::map<ObservedRowsKey, ObservedRows> observed_rows_;
 };
 }  // namespace noisepage::execution::exec
@@ -94,6 +94,12 @@ class EXPORT ExecutionSettings {
   /** @return True if static partitioner is enabled. */
   constexpr bool GetIsStaticPartitionerEnabled() const { return is_static_partitioner_enabled_; }
 
+  /** @return The number of blocks ANALYZE reads from a table before it samples instead, zero disables sampling. */
+  uint32_t GetAnalyzeSampleBlocks() const { return analyze_sample_blocks_; }
+
+  /** @return The estimated number of input rows per thread of a parallel pipeline, zero always uses all threads. */
+  uint32_t GetParallelExecutionRowsPerThread() const { return parallel_execution_rows_per_thread_; }
+
  private:
   double select_opt_threshold_{common::Constants::SELECT_OPT_THRESHOLD};
   double arithmetic_full_compute_opt_threshold_{common::Constants::ARITHMETIC_FULL_COMPUTE_THRESHOLD};
@@ -104,6 +110,8 @@ class EXPORT ExecutionSettings {
   bool is_pipeline_metrics_enabled_{common::Constants::IS_PIPELINE_METRICS_ENABLED};
   int number_of_parallel_execution_threads_{common::Constants::NUM_PARALLEL_EXECUTION_THREADS};
   bool is_static_partitioner_enabled_{common::Constants::IS_STATIC_PARTITIONER_ENABLED};
+  uint32_t analyze_sample_blocks_{common::Constants::ANALYZE_SAMPLE_BLOCKS};
+  uint32_t parallel_execution_rows_per_thread_{common::Constants::PARALLEL_EXECUTION_ROWS_PER_THREAD};
   compiler::CompilerSettings compiler_settings_{};  ///< The settings for compiling the TPL input.
 
   // MiniRunners needs to set query_identifier and pipeline_operating_units_.
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <mutex>  // NOLINT
+#include <optional>
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
@@ -15,7 +16,9 @@
 #include "parser/parser_defs.h"
 
 namespace noisepage::network {
+class PortalExecution;
 class PostgresPacketWriter;
+struct DataRowColumn;
 }  // namespace noisepage::network
 
 namespace noisepage::planner {
@@ -137,14 +140,22 @@ class OutputWriter {
    * @param schema final schema to output for this query
    * @param out packet writer to use
    * @param field_formats reference to the field formats for this query
+   * @param copy_format if not null, the rows are sent as the CopyData of a COPY TO STDOUT instead of DataRows
+   * @param portal_execution if not null, the execution of a portal that the client fetches from with a row limit,
+   * which suspends the query once the client has the rows it asked for
    */
   OutputWriter(const common::ManagedPointer<planner::OutputSchema> schema,
                const common::ManagedPointer<network::PostgresPacketWriter> out,
-               const std::vector<network::FieldFormat> &field_formats)
-      : schema_(schema), out_(out), field_formats_(field_formats) {}
+               const std::vector<network::FieldFormat> &field_formats,
+               const network::CopyFormat *copy_format = nullptr,
+               common::ManagedPointer<network::PortalExecution> portal_execution = nullptr);
+
+  /** Out of line, because the layout's element type is only forward-declared here. */
+  ~OutputWriter();
 
   /**
    * Callback that writes results to PostgresPacketWriter.
+   * @throw AbortException if the portal the rows are written for was closed, which stops the query
    *
    * @param tuples batch of tuples
    * @param num_tuples number of tuples
@@ -165,9 +176,11 @@ class OutputWriter {
    * (parallel scan)
    */
   std::mutex output_synchronization_;
-  const common::ManagedPointer<planner::OutputSchema> schema_;
   const common::ManagedPointer<network::PostgresPacketWriter> out_;
-  const std::vector<network::FieldFormat> &field_formats_;
+  /** Where each column lives in the tuples, computed once instead of for every row written. */
+  const std::vector<network::DataRowColumn> layout_;
+  const std::optional<network::CopyFormat> copy_format_;
+  const common::ManagedPointer<network::PortalExecution> portal_execution_;
 };
 
 /**
@@ -163,6 +163,7 @@ class Sema : public ast::AstVisitor<Sema> {
   void CheckBuiltinIndexIteratorFree(ast::CallExpr *call);
   void CheckBuiltinIndexIteratorPRCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinAbortCall(ast::CallExpr *call);
+  void CheckBuiltinAnalyzeColumnGroupsCall(ast::CallExpr *call);
   void CheckBuiltinParamCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinCteScanCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinStringCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -2,6 +2,8 @@
 
 #include <tbb/enumerable_thread_specific.h>
 
+#include <algorithm>
+
 namespace noisepage::execution::sql {
 
 /**
@@ -24,7 +26,11 @@ class EXPORT MemoryTracker {
    * Increments number of allocated bytes
    * @param size number to increment by
    */
-  void Increment(size_t size) { stats_.local().allocated_bytes_ += size; }
+  void Increment(size_t size) {
+    auto &stats = stats_.local();
+    stats.allocated_bytes_ += size;
+    stats.peak_bytes_ = std::max(stats.peak_bytes_, stats.allocated_bytes_);
+  }
 
   /**
    * Decrements number of allocated bytes
@@ -32,6 +38,17 @@ class EXPORT MemoryTracker {
    */
   void Decrement(size_t size) { stats_.local().allocated_bytes_ -= size; }
 
+  /**
+   * The peaks of the threads need not have happened at the same time, so the sum is an upper bound of the memory the
+   * tracked work used. Must not be called while other threads are still allocating.
+   * @returns sum of the largest number of bytes each thread had allocated at once over the lifetime of the tracker
+   */
+  size_t GetPeakAllocatedSize() const {
+    size_t peak = 0;
+    for (const auto &stats : stats_) peak += stats.peak_bytes_;
+    return peak;
+  }
+
  private:
   /**
    * Struct to store per-thread tracking data.
@@ -39,6 +56,8 @@ class EXPORT MemoryTracker {
   struct Stats {
     // Number of bytes allocated
     size_t allocated_bytes_ = 0;
+    // Largest allocated_bytes_ so far, which Reset() leaves alone
+    size_t peak_bytes_ = 0;
   };
   tbb::enumerable_thread_specific<Stats> stats_;
 };
@@ -146,9 +146,19 @@ class EXPORT TableVectorIterator {
   // An iterator over the currently active projection.
   VectorProjectionIterator vector_projection_iterator_;
 
+  // ANALYZE on large tables only visits the blocks whose index plus the offset is a multiple of the stride. The stride
+  // is 1 if every block is visited. next_block_ and end_block_ delimit the blocks that have not been visited yet.
+  uint32_t sample_stride_{1};
+  uint32_t sample_offset_{0};
+  uint32_t next_block_{0};
+  uint32_t end_block_{0};
+
   // True if the iterator has been initialized.
   bool initialized_{false};
   bool Init(common::ManagedPointer<storage::SqlTable> table, uint32_t block_start, uint32_t block_end);
+
+  // Point the iterator at the next sampled block, returning false if there is none.
+  bool NextSampledBlock();
 };
 
 }  // namespace noisepage::execution::sql
@@ -466,6 +466,11 @@ class BytecodeEmitter {
    */
   void EmitAbortTxn(Bytecode bytecode, LocalVar exec_ctx);
 
+  /**
+   * Emits bytecode to collect and store the statistics of the column groups of an analyzed table
+   */
+  void EmitAnalyzeColumnGroups(LocalVar exec_ctx, LocalVar table_oid, LocalVar col_oids, uint32_t num_oids);
+
   /**
    * @brief Emits a concat instruction
    * @param ret where to store the result of concat instruction
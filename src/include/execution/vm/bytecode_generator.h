@@ -71,6 +71,7 @@ class BytecodeGenerator final : public ast::AstVisitor<BytecodeGenerator> {
   FunctionInfo *AllocateFunc(const std::string &func_name, ast::FunctionType *func_type);
 
   void VisitAbortTxn(ast::CallExpr *call);
+  void VisitAnalyzeColumnGroups(ast::CallExpr *call);
 
   // ONLY FOR TESTING!
   void VisitBuiltinTestCatalogLookup(ast::CallExpr *call);
@@ -2171,6 +2171,13 @@ VM_OP_WARM void OpAbortTxn(noisepage::execution::exec::ExecutionContext *exec_ct
   throw noisepage::ABORT_EXCEPTION("transaction aborted");
 }
 
+/**
+ * Collects the statistics of the pairs of the analyzed columns of a table and writes them to pg_statistic, as part of
+ * ANALYZE. Aborts the transaction if they cannot be written.
+ */
+VM_OP_COLD void OpAnalyzeColumnGroups(noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t table_oid,
+                                      const uint32_t *col_oids, uint32_t num_oids);
+
 // Parameter calls
 #define GEN_SCALAR_PARAM_GET(Name, SqlType)                                                                     \
   VM_OP_HOT void OpGetParam##Name(noisepage::execution::sql::SqlType *ret,                                      \
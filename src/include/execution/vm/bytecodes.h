@@ -757,6 +757,7 @@ namespace noisepage::execution::vm {
   F(ExtractYearFromDate, OperandType::Local, OperandType::Local)                                                      \
                                                                                                                       \
   F(AbortTxn, OperandType::Local)                                                                                     \
+  F(AnalyzeColumnGroups, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::UImm4)              \
                                                                                                                       \
   /* Mini-runners. */                                                                                                 \
   F(NpRunnersEmitInt, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,                 \
@@ -7,15 +7,18 @@
 
 #include "catalog/catalog.h"
 #include "common/action_context.h"
+#include "common/error/exception.h"
 #include "common/dedicated_thread_registry.h"
 #include "common/managed_pointer.h"
 #include "messenger/messenger.h"
 #include "metrics/metrics_defs.h"
 #include "metrics/metrics_thread.h"
 #include "network/connection_handle_factory.h"
+#include "network/execution_worker_pool.h"
 #include "network/noisepage_server.h"
 #include "network/postgres/postgres_command_factory.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
+#include "optimizer/statistics/auto_analyzer_thread.h"
 #include "optimizer/statistics/stats_storage.h"
 #include "replication/primary_replication_manager.h"
 #include "replication/replica_replication_manager.h"
@@ -303,17 +306,30 @@ class DBMain {
      * @param port argument to TerrierServer
      * @param connection_thread_count argument to TerrierServer
      * @param socket_directory argument to TerrierServer
+     * @param connection_acceptor_count argument to TerrierServer
+     * @param execution_thread_count number of threads in the ExecutionWorkerPool, 0 to process packets on the
+     *        connection handler threads
+     * @param execution_blocking_thread_limit argument to the ExecutionWorkerPool
+     * @param metrics_manager argument to the ExecutionWorkerPool
      */
     NetworkLayer(const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
                  const common::ManagedPointer<trafficcop::TrafficCop> traffic_cop, const uint16_t port,
-                 const uint16_t connection_thread_count, const std::string &socket_directory) {
-      connection_handle_factory_ = std::make_unique<network::ConnectionHandleFactory>(traffic_cop);
+                 const uint16_t connection_thread_count, const std::string &socket_directory,
+                 const uint16_t connection_acceptor_count = 1, const uint16_t execution_thread_count = 0,
+                 const uint16_t execution_blocking_thread_limit = 64,
+                 const common::ManagedPointer<metrics::MetricsManager> metrics_manager = DISABLED) {
+      // Even without execution threads, the pool runs the queries of portals that are fetched a few rows at a time
+      execution_pool_ = std::make_unique<network::ExecutionWorkerPool>(
+          execution_thread_count, execution_blocking_thread_limit, metrics_manager);
+      connection_handle_factory_ =
+          std::make_unique<network::ConnectionHandleFactory>(traffic_cop, common::ManagedPointer(execution_pool_));
       command_factory_ = std::make_unique<network::PostgresCommandFactory>();
       provider_ =
           std::make_unique<network::PostgresProtocolInterpreter::Provider>(common::ManagedPointer(command_factory_));
       server_ = std::make_unique<network::TerrierServer>(
           common::ManagedPointer(provider_), common::ManagedPointer(connection_handle_factory_), thread_registry, port,
-          connection_thread_count, socket_directory);
+          connection_thread_count, socket_directory, connection_acceptor_count,
+          common::ManagedPointer(execution_pool_));
     }
 
     /**
@@ -326,6 +342,8 @@ class DBMain {
     std::unique_ptr<network::ConnectionHandleFactory> connection_handle_factory_;
     std::unique_ptr<network::PostgresCommandFactory> command_factory_;
     std::unique_ptr<network::ProtocolInterpreterProvider> provider_;
+    // Workers process packets through the handles, commands and interpreters above, so they are joined first.
+    std::unique_ptr<network::ExecutionWorkerPool> execution_pool_;
     std::unique_ptr<network::TerrierServer> server_;
   };
 
@@ -383,12 +401,19 @@ class DBMain {
       std::unique_ptr<settings::SettingsManager> settings_manager =
           use_settings_manager_ ? BootstrapSettingsManager(common::ManagedPointer(db_main)) : DISABLED;
 
+      // A query waits for admission on the thread that executes it, which must not be a connection handler thread that
+      // serves other connections too
+      if (use_admission_control_ && use_network_ && execution_thread_count_ == 0) {
+        throw SETTINGS_EXCEPTION("admission_control_enable requires execution_thread_count to be greater than 0",
+                                 common::ErrorCode::ERRCODE_INVALID_PARAMETER_VALUE);
+      }
+
       std::unique_ptr<metrics::MetricsManager> metrics_manager = DISABLED;
       if (use_metrics_) metrics_manager = BootstrapMetricsManager();
 
       std::unique_ptr<optimizer::StatsStorage> stats_storage = DISABLED;
       if (use_stats_storage_) {
-        stats_storage = std::make_unique<optimizer::StatsStorage>();
+        stats_storage = std::make_unique<optimizer::StatsStorage>(stats_storage_memory_limit_);
       }
 
       std::unique_ptr<common::DedicatedThreadRegistry> thread_registry = DISABLED;
@@ -514,7 +539,12 @@ class DBMain {
             txn_layer->GetTransactionManager(), catalog_layer->GetCatalog(),
             common::ManagedPointer(replication_manager), common::ManagedPointer(recovery_manager),
             common::ManagedPointer(settings_manager), common::ManagedPointer(stats_storage), optimizer_timeout_,
-            use_query_cache_, execution_mode_);
+            optimizer_threads_, use_query_cache_, execution_mode_,
+            use_admission_control_ ? std::make_unique<trafficcop::AdmissionController>(
+                                         admission_oltp_slots_, admission_analytic_slots_,
+                                         admission_analytic_cost_threshold_, admission_memory_budget_,
+                                         std::chrono::milliseconds(admission_queue_timeout_))
+                                   : nullptr);
       }
 
       std::unique_ptr<NetworkLayer> network_layer = DISABLED;
@@ -522,7 +552,9 @@ class DBMain {
         NOISEPAGE_ASSERT(use_traffic_cop_ && traffic_cop != DISABLED, "NetworkLayer needs TrafficCopLayer.");
         network_layer =
             std::make_unique<NetworkLayer>(common::ManagedPointer(thread_registry), common::ManagedPointer(traffic_cop),
-                                           network_port_, connection_thread_count_, uds_file_directory_);
+                                           network_port_, connection_thread_count_, uds_file_directory_,
+                                           connection_acceptor_count_, execution_thread_count_,
+                                           execution_blocking_thread_limit_, common::ManagedPointer(metrics_manager));
       }
 
       std::unique_ptr<modelserver::ModelServerManager> model_server_manager = DISABLED;
@@ -551,6 +583,19 @@ class DBMain {
             std::chrono::microseconds{forecast_train_interval_}, pilot_planning_);
       }
 
+      std::unique_ptr<optimizer::AutoAnalyzer> auto_analyzer = DISABLED;
+      std::unique_ptr<optimizer::AutoAnalyzerThread> auto_analyzer_thread = DISABLED;
+      if (use_auto_analyze_thread_) {
+        NOISEPAGE_ASSERT(use_stats_storage_ && stats_storage != DISABLED, "AutoAnalyzer needs StatsStorage.");
+        NOISEPAGE_ASSERT(task_manager != DISABLED, "AutoAnalyzer needs the task manager to run ANALYZE.");
+        auto_analyzer = std::make_unique<optimizer::AutoAnalyzer>(
+            common::ManagedPointer(catalog_layer->GetCatalog()), txn_layer->GetTransactionManager(),
+            common::ManagedPointer(stats_storage), common::ManagedPointer(task_manager), auto_analyze_threshold_,
+            auto_analyze_scale_factor_);
+        auto_analyzer_thread = std::make_unique<optimizer::AutoAnalyzerThread>(
+            common::ManagedPointer(auto_analyzer), std::chrono::microseconds{auto_analyze_interval_});
+      }
+
       NOISEPAGE_ASSERT(!(async_replication_enable_ && !use_replication_),
                        "async_replication_enable only controls whether replication is sync or async, you also need "
                        "use_replication.");
@@ -597,6 +642,8 @@ class DBMain {
       db_main->replication_manager_ = std::move(replication_manager);
       db_main->query_exec_util_ = std::move(query_exec_util);
       db_main->task_manager_ = std::move(task_manager);
+      db_main->auto_analyzer_ = std::move(auto_analyzer);
+      db_main->auto_analyzer_thread_ = std::move(auto_analyzer_thread);
       return db_main;
     }
 
@@ -762,6 +809,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value use component
+     * @return self reference for chaining
+     */
+    Builder &SetUseAutoAnalyzeThread(const bool value) {
+      use_auto_analyze_thread_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -798,6 +854,33 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value NetworkLayer argument
+     * @return self reference for chaining
+     */
+    Builder &SetConnectionAcceptorCount(const uint16_t value) {
+      connection_acceptor_count_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value NetworkLayer argument
+     * @return self reference for chaining
+     */
+    Builder &SetExecutionThreadCount(const uint16_t value) {
+      execution_thread_count_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value NetworkLayer argument
+     * @return self reference for chaining
+     */
+    Builder &SetExecutionBlockingThreadLimit(const uint16_t value) {
+      execution_blocking_thread_limit_ = value;
+      return *this;
+    }
+
     /**
      * @param port Messenger port
      * @return self reference for chaining
@@ -852,6 +935,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetOptimizerThreads(const uint32_t value) {
+      optimizer_threads_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value use component
+     * @return self reference for chaining
+     */
+    Builder &SetUseAdmissionControl(const bool value) {
+      use_admission_control_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -937,7 +1038,18 @@ class DBMain {
     uint64_t block_store_size_ = 1e5;
     uint64_t block_store_reuse_ = 1e3;
     uint64_t optimizer_timeout_ = 5000;
+    uint32_t optimizer_threads_ = 1;
+    bool use_admission_control_ = false;
+    uint32_t admission_oltp_slots_ = 64;
+    uint32_t admission_analytic_slots_ = 2;
+    double admission_analytic_cost_threshold_ = 100000.0;
+    uint64_t admission_memory_budget_ = 0;
+    uint32_t admission_queue_timeout_ = 10000;
     uint64_t forecast_sample_limit_ = 5;
+    uint64_t auto_analyze_interval_ = 1e7;
+    uint64_t auto_analyze_threshold_ = 50;
+    double auto_analyze_scale_factor_ = 0.1;
+    uint64_t stats_storage_memory_limit_ = optimizer::StatsStorage::DEFAULT_MEMORY_LIMIT;
 
     std::string wal_file_path_ = "wal.log";
     std::string ou_model_save_path_;
@@ -963,18 +1075,25 @@ class DBMain {
     metrics::MetricsOutput query_trace_metrics_output_ = metrics::MetricsOutput::CSV;
     bool pipeline_metrics_ = false;
     uint8_t pipeline_metrics_sample_rate_ = 10;
+    metrics::MetricsOutput pipeline_metrics_output_ = metrics::MetricsOutput::CSV;
+    uint64_t metrics_buffer_capacity_ = metrics::MetricsManager::DEFAULT_BUFFER_CAPACITY;
+    uint64_t metrics_aggregation_limit_ = metrics::MetricsManager::DEFAULT_BUFFER_CAPACITY;
     bool transaction_metrics_ = false;
     bool logging_metrics_ = false;
     uint8_t logging_metrics_sample_rate_ = 100;
     bool gc_metrics_ = false;
     bool bind_command_metrics_ = false;
     bool execute_command_metrics_ = false;
+    bool admission_control_metrics_ = false;
     int32_t wal_serialization_interval_ = 100;
     int32_t wal_persist_interval_ = 100;
     int32_t gc_interval_ = 1000;
     uint32_t task_pool_size_ = 1;
 
     uint16_t connection_thread_count_ = 4;
+    uint16_t connection_acceptor_count_ = 1;
+    uint16_t execution_thread_count_ = 0;
+    uint16_t execution_blocking_thread_limit_ = 64;
     uint16_t network_port_ = 15721;
     uint16_t messenger_port_ = 9022;
     uint16_t replication_port_ = 15445;
@@ -999,6 +1118,7 @@ class DBMain {
     bool model_server_enable_python_coverage_ = false;
     bool use_pilot_thread_ = false;
     bool pilot_planning_ = false;
+    bool use_auto_analyze_thread_ = false;
 
     /**
      * Instantiates the SettingsManager and reads all of the settings to override the Builder's settings.
@@ -1031,6 +1151,11 @@ class DBMain {
       use_metrics_thread_ = settings_manager->GetBool(settings::Param::use_metrics_thread);
       use_pilot_thread_ = settings_manager->GetBool(settings::Param::use_pilot_thread);
       pilot_planning_ = settings_manager->GetBool(settings::Param::pilot_planning);
+      use_auto_analyze_thread_ = settings_manager->GetBool(settings::Param::auto_analyze_enable);
+      auto_analyze_interval_ = settings_manager->GetInt64(settings::Param::auto_analyze_interval);
+      auto_analyze_threshold_ = settings_manager->GetInt64(settings::Param::auto_analyze_threshold);
+      auto_analyze_scale_factor_ = settings_manager->GetDouble(settings::Param::auto_analyze_scale_factor);
+      stats_storage_memory_limit_ = settings_manager->GetInt64(settings::Param::stats_storage_memory_limit);
 
       gc_interval_ = settings_manager->GetInt(settings::Param::gc_interval);
       pilot_interval_ = settings_manager->GetInt64(settings::Param::pilot_interval);
@@ -1051,8 +1176,25 @@ class DBMain {
       network_identity_ = settings_manager->GetString(settings::Param::network_identity);
       connection_thread_count_ =
           static_cast<uint16_t>(settings_manager->GetInt(settings::Param::connection_thread_count));
+      connection_acceptor_count_ =
+          static_cast<uint16_t>(settings_manager->GetInt(settings::Param::connection_acceptor_count));
+      execution_thread_count_ =
+          static_cast<uint16_t>(settings_manager->GetInt(settings::Param::execution_thread_count));
+      execution_blocking_thread_limit_ =
+          static_cast<uint16_t>(settings_manager->GetInt(settings::Param::execution_blocking_thread_limit));
       optimizer_timeout_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
+      optimizer_threads_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::optimizer_threads));
       use_query_cache_ = settings_manager->GetBool(settings::Param::use_query_cache);
+      use_admission_control_ = settings_manager->GetBool(settings::Param::admission_control_enable);
+      admission_oltp_slots_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::admission_oltp_slots));
+      admission_analytic_slots_ =
+          static_cast<uint32_t>(settings_manager->GetInt(settings::Param::admission_analytic_slots));
+      admission_analytic_cost_threshold_ =
+          settings_manager->GetDouble(settings::Param::admission_analytic_cost_threshold);
+      admission_memory_budget_ =
+          static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::admission_memory_budget));
+      admission_queue_timeout_ =
+          static_cast<uint32_t>(settings_manager->GetInt(settings::Param::admission_queue_timeout));
 
       execution_mode_ = settings_manager->GetBool(settings::Param::compiled_query_execution)
                             ? execution::vm::ExecutionMode::Compiled
@@ -1061,16 +1203,25 @@ class DBMain {
 
       query_trace_metrics_ = settings_manager->GetBool(settings::Param::query_trace_metrics_enable);
       query_trace_metrics_output_ = *metrics::MetricsUtil::FromMetricsOutputString(
+          metrics::MetricsComponent::QUERY_TRACE,
           settings_manager->GetString(settings::Param::query_trace_metrics_output));
       forecast_sample_limit_ = settings_manager->GetInt(settings::Param::forecast_sample_limit);
       pipeline_metrics_ = settings_manager->GetBool(settings::Param::pipeline_metrics_enable);
       pipeline_metrics_sample_rate_ = settings_manager->GetInt(settings::Param::pipeline_metrics_sample_rate);
+      pipeline_metrics_output_ = *metrics::MetricsUtil::FromMetricsOutputString(
+          metrics::MetricsComponent::EXECUTION_PIPELINE,
+          settings_manager->GetString(settings::Param::pipeline_metrics_output));
+      metrics_buffer_capacity_ =
+          static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::metrics_buffer_capacity));
+      metrics_aggregation_limit_ =
+          static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::metrics_aggregation_limit));
       logging_metrics_sample_rate_ = settings_manager->GetInt(settings::Param::logging_metrics_sample_rate);
       transaction_metrics_ = settings_manager->GetBool(settings::Param::transaction_metrics_enable);
       logging_metrics_ = settings_manager->GetBool(settings::Param::logging_metrics_enable);
       gc_metrics_ = settings_manager->GetBool(settings::Param::gc_metrics_enable);
       bind_command_metrics_ = settings_manager->GetBool(settings::Param::bind_command_metrics_enable);
       execute_command_metrics_ = settings_manager->GetBool(settings::Param::execute_command_metrics_enable);
+      admission_control_metrics_ = settings_manager->GetBool(settings::Param::admission_control_metrics_enable);
 
       use_messenger_ = settings_manager->GetBool(settings::Param::messenger_enable);
       messenger_port_ = settings_manager->GetInt(settings::Param::messenger_port);
@@ -1089,7 +1240,8 @@ class DBMain {
      * @return
      */
     std::unique_ptr<metrics::MetricsManager> BootstrapMetricsManager() {
-      std::unique_ptr<metrics::MetricsManager> metrics_manager = std::make_unique<metrics::MetricsManager>();
+      std::unique_ptr<metrics::MetricsManager> metrics_manager =
+          std::make_unique<metrics::MetricsManager>(metrics_buffer_capacity_, metrics_aggregation_limit_);
       metrics_manager->SetMetricSampleRate(metrics::MetricsComponent::EXECUTION_PIPELINE,
                                            pipeline_metrics_sample_rate_);
       metrics_manager->SetMetricSampleRate(metrics::MetricsComponent::LOGGING, logging_metrics_sample_rate_);
@@ -1099,12 +1251,14 @@ class DBMain {
       metrics::QueryTraceMetricRawData::query_segment_interval = workload_forecast_interval_;
       metrics_manager->SetMetricOutput(metrics::MetricsComponent::QUERY_TRACE, query_trace_metrics_output_);
 
+      metrics_manager->SetMetricOutput(metrics::MetricsComponent::EXECUTION_PIPELINE, pipeline_metrics_output_);
       if (pipeline_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::EXECUTION_PIPELINE);
       if (transaction_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::TRANSACTION);
       if (logging_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::LOGGING);
       if (gc_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::GARBAGECOLLECTION);
       if (bind_command_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::BIND_COMMAND);
       if (execute_command_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::EXECUTE_COMMAND);
+      if (admission_control_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::ADMISSION_CONTROL);
 
       return metrics_manager;
     }
@@ -1191,6 +1345,13 @@ class DBMain {
     return common::ManagedPointer(pilot_thread_);
   }
 
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<optimizer::AutoAnalyzerThread> GetAutoAnalyzerThread() const {
+    return common::ManagedPointer(auto_analyzer_thread_);
+  }
+
   /**
    * @return ManagedPointer to the component, can be nullptr if disabled
    */
@@ -1254,6 +1415,8 @@ class DBMain {
   std::unique_ptr<modelserver::ModelServerManager> model_server_manager_;
   std::unique_ptr<util::QueryExecUtil> query_exec_util_;
   std::unique_ptr<task::TaskManager> task_manager_;
+  std::unique_ptr<optimizer::AutoAnalyzer> auto_analyzer_;               // Depends on task manager.
+  std::unique_ptr<optimizer::AutoAnalyzerThread> auto_analyzer_thread_;  // Depends on auto analyzer.
 };
 
 }  // namespace noisepage
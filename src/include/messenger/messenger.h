@@ -9,12 +9,14 @@
 #include <optional>
 #include <queue>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "common/dedicated_thread_owner.h"
 #include "common/dedicated_thread_task.h"
+#include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "messenger/connection_destination.h"
 #include "messenger/messenger_defs.h"
@@ -24,6 +26,7 @@
 // The prediction is that doing this won't hurt performance too much.
 namespace zmq {
 class context_t;
+class message_t;
 class socket_t;
 }  // namespace zmq
 
@@ -32,11 +35,28 @@ namespace noisepage::messenger {
 class ConnectionDestination;
 class Messenger;
 class MessengerPolledSockets;
+class MessengerTests_ResendTest_Test;
 class ZmqUtil;
 
-/** An abstraction around ZeroMQ messages which explicitly have the sender specified. */
+/**
+ * An abstraction around ZeroMQ messages which explicitly have the sender specified.
+ *
+ * The payload stays in the ZeroMQ message that it was received in (or built into), so the views returned here point
+ * straight into the frame and are valid for as long as the ZmqMessage is alive.
+ */
 class ZmqMessage {
  public:
+  DISALLOW_COPY(ZmqMessage);
+
+  /** Move constructor. */
+  ZmqMessage(ZmqMessage &&other) noexcept;
+
+  /** Move assignment. */
+  ZmqMessage &operator=(ZmqMessage &&other) noexcept;
+
+  /** An explicit destructor is necessary because of the unique_ptr around a forward-declared type. */
+  ~ZmqMessage();
+
   /** @return The ID of this message. */
   message_id_t GetMessageId() const { return message_id_; }
 
@@ -53,7 +73,7 @@ class ZmqMessage {
   std::string_view GetMessage() const { return message_; }
 
   /** @return The raw payload of the message. */
-  std::string_view GetRawPayload() const { return std::string_view(payload_); }
+  std::string_view GetRawPayload() const { return raw_payload_; }
 
  private:
   friend Messenger;
@@ -65,27 +85,31 @@ class ZmqMessage {
    * @param source_cb_id    The callback ID of the message on the source.
    * @param dest_cb_id      The callback ID of the message on the destination.
    * @param routing_id      The routing ID of the message sender. Roughly speaking, "who sent this message".
-   * @param message         The contents of the message.
+   * @param message         The contents of the message. Its buffer is handed over to ZeroMQ.
    * @return A ZmqMessage encapsulating the given message.
    */
   static ZmqMessage Build(message_id_t message_id, callback_id_t source_cb_id, callback_id_t dest_cb_id,
-                          const std::string &routing_id, std::string_view message);
+                          const std::string &routing_id, std::string message);
 
   /**
    * Parse the given payload into a ZmqMessage.
    * @param routing_id      The message's routing ID.
-   * @param message         The message for the destination.
-   * @return A ZmqMessage encapsulating the given message.
+   * @param payload         The received frame holding the message for the destination.
+   * @return A ZmqMessage encapsulating the given message, or std::nullopt if the payload does not start with a
+   *         well-formed header.
    */
-  static ZmqMessage Parse(const std::string &routing_id, const std::string &message);
+  static std::optional<ZmqMessage> Parse(std::string routing_id, std::unique_ptr<zmq::message_t> payload);
 
-  /** Construct a new ZmqMessage with the given routing ID and payload. Payload of form ID-MESSAGE. */
-  ZmqMessage(std::string routing_id, std::string payload);
+  /**
+   * Construct a new ZmqMessage with the given routing ID and payload, which is of form HEADER-MESSAGE. The header is
+   * filled in by Build() or Parse().
+   */
+  ZmqMessage(std::string routing_id, std::unique_ptr<zmq::message_t> payload);
 
   /** The routing ID of the message. */
   std::string routing_id_;
-  /** The payload in the message, of form ID-MESSAGE.  */
-  std::string payload_;
+  /** The ZeroMQ message holding the payload, of form ID-MESSAGE. Heap allocated so that the views below stay valid. */
+  std::unique_ptr<zmq::message_t> payload_;
 
   /** The cached id of the message. */
   message_id_t message_id_;
@@ -93,6 +117,8 @@ class ZmqMessage {
   callback_id_t source_cb_id_;
   /** The cached callback id of the message (destination). */
   callback_id_t dest_cb_id_;
+  /** The entire payload. */
+  std::string_view raw_payload_;
   /** The cached actual message. */
   std::string_view message_;
 };
@@ -251,13 +277,13 @@ class Messenger : public common::DedicatedThreadTask {
    * @warning   Remember that ConnectionId can only be used from the same thread that created it!
    *
    * @param connection_id   The connection to send the message over.
-   * @param message         The message to be sent.
+   * @param message         The message to be sent. Its buffer is handed over to ZeroMQ, move it in where possible.
    * @param callback        The callback function to be invoked locally on the response. Can be nullptr.
    * @param remote_cb_id    The callback function to be invoked remotely on the destination to handle this message.
    *                        For example, used for invoking preregistered functions or messages sent in response.
    *                        To invoke preregistered functions, use static_cast<uint8_t>(Messenger::BuiltinCallback).
    */
-  void SendMessage(connection_id_t connection_id, const std::string &message, CallbackFn callback,
+  void SendMessage(connection_id_t connection_id, std::string message, CallbackFn callback,
                    callback_id_t remote_cb_id);
 
   /**
@@ -267,18 +293,19 @@ class Messenger : public common::DedicatedThreadTask {
    *
    * @param router_id       The connection router to send the message over.
    * @param recv_id         The routing ID of the destination.
-   * @param message         The message to be sent.
+   * @param message         The message to be sent. Its buffer is handed over to ZeroMQ, move it in where possible.
    * @param callback        The callback function to be invoked on the response. Can be nullptr.
    * @param remote_cb_id    The callback function to be invoked remotely on the destination to handle this message.
    *                        For example, used for invoking preregistered functions or messages sent in response.
    *                        To invoke preregistered functions, use static_cast<uint8_t>(Messenger::BuiltinCallback).
    */
-  void SendMessage(router_id_t router_id, const std::string &recv_id, const std::string &message, CallbackFn callback,
+  void SendMessage(router_id_t router_id, const std::string &recv_id, std::string message, CallbackFn callback,
                    callback_id_t remote_cb_id);
 
  private:
   friend ConnectionId;
   friend ConnectionRouter;
+  friend MessengerTests_ResendTest_Test;
 
   static constexpr const char *MESSENGER_DEFAULT_TCP = "*";
   static constexpr const char *MESSENGER_DEFAULT_IPC = "./noisepage-ipc-{}";
@@ -291,6 +318,12 @@ class Messenger : public common::DedicatedThreadTask {
   /** @return The next callback ID to be used when sending messages. */
   callback_id_t GetNextSendCallbackId();
 
+  /**
+   * Wake the server loop up from its poll, so that work queued by another thread (messages to be sent, routers and
+   * connections to be added) is picked up right away instead of after MESSENGER_POLL_TIMER.
+   */
+  void WakeServerLoop();
+
   /** The main server loop. */
   void ServerLoop();
   /** Add listening points. */
@@ -299,7 +332,7 @@ class Messenger : public common::DedicatedThreadTask {
   void ServerLoopMakeConnections();
   /** Send all queued messages. */
   void ServerLoopSendMessages();
-  /** Receive and process any outstanding messages. */
+  /** Wait for incoming messages or a wakeup, then receive and process any outstanding messages. */
   void ServerLoopRecvAndProcessMessages();
 
   struct PendingMessage {
@@ -341,6 +374,8 @@ class Messenger : public common::DedicatedThreadTask {
   std::unique_ptr<zmq::context_t> zmq_ctx_;
   std::unique_ptr<zmq::socket_t> zmq_default_socket_;
   std::unique_ptr<MessengerPolledSockets> polled_sockets_;
+  /** An eventfd that is polled alongside the sockets, signalled by WakeServerLoop(). */
+  int wakeup_fd_;
   std::unordered_map<callback_id_t, CallbackFn> callbacks_;
 
   std::vector<RouterToBeAdded> routers_to_be_added_;
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "common/macros.h"
+#include "execution/util/execution_common.h"
 #include "metrics/metrics_defs.h"
 
 namespace noisepage::util {
@@ -54,5 +55,14 @@ class AbstractRawData {
    * @param outfile vector of ofstreams to write to that have been opened by the MetricsManager
    */
   virtual void ToCSV(std::vector<std::ofstream> *outfile) = 0;
+
+  /**
+   * Writes the data to binary files, and then clears the data. Only metrics that define BINARY_FILES support this,
+   * the MetricsManager writes all others as CSV.
+   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   */
+  virtual void ToBinary(std::vector<std::ofstream> *outfiles) {
+    UNREACHABLE("This metric does not have a binary output format.");
+  }
 };
 }  // namespace noisepage::metrics
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "metrics/abstract_metric.h"
+#include "metrics/metrics_util.h"
+
+namespace noisepage::metrics {
+
+/**
+ * Raw data object for holding stats collected when the admission controller admits or rejects a query
+ */
+class AdmissionControlMetricRawData : public AbstractRawData {
+ public:
+  void Aggregate(AbstractRawData *const other) override {
+    auto other_db_metric = dynamic_cast<AdmissionControlMetricRawData *>(other);
+    if (!other_db_metric->admission_data_.empty()) {
+      admission_data_.splice(admission_data_.cend(), other_db_metric->admission_data_);
+    }
+  }
+
+  /**
+   * @return the type of the metric this object is holding the data for
+   */
+  MetricsComponent GetMetricType() const override { return MetricsComponent::ADMISSION_CONTROL; }
+
+  /**
+   * Writes the data out to ofstreams
+   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   */
+  void ToCSV(std::vector<std::ofstream> *const outfiles) final {
+    NOISEPAGE_ASSERT(outfiles->size() == FILES.size(), "Number of files passed to metric is wrong.");
+    NOISEPAGE_ASSERT(std::count_if(outfiles->cbegin(), outfiles->cend(),
+                                   [](const std::ofstream &outfile) { return !outfile.is_open(); }) == 0,
+                     "Not all files are open.");
+
+    auto &outfile = (*outfiles)[0];
+
+    for (const auto &data : admission_data_) {
+      outfile << data.timestamp_ << ", " << static_cast<uint32_t>(data.workload_class_) << ", "
+              << data.estimated_cost_ << ", " << data.estimated_memory_ << ", " << data.queue_depth_ << ", "
+              << data.wait_us_ << ", " << data.admitted_ << ", ";
+      outfile << std::endl;
+    }
+    admission_data_.clear();
+  }
+
+  /**
+   * Files to use for writing to CSV.
+   */
+  static constexpr std::array<std::string_view, 1> FILES = {"./admission_control.csv"};
+
+  /**
+   * Columns to use for writing to CSV.
+   * Note: This includes the columns for the input feature, but not the output (resource counters)
+   */
+  static constexpr std::array<std::string_view, 1> FEATURE_COLUMNS = {
+      "timestamp, workload_class, estimated_cost, estimated_memory_b, queue_depth, wait_us, admitted"};
+
+ private:
+  friend class AdmissionControlMetric;
+
+  void RecordAdmission(uint8_t workload_class, double estimated_cost, uint64_t estimated_memory, uint64_t queue_depth,
+                       uint64_t wait_us, bool admitted) {
+    admission_data_.emplace_back(MetricsUtil::Now(), workload_class, estimated_cost, estimated_memory, queue_depth,
+                                 wait_us, admitted);
+  }
+
+  struct AdmissionData {
+    AdmissionData(uint64_t timestamp, uint8_t workload_class, double estimated_cost, uint64_t estimated_memory,
+                  uint64_t queue_depth, uint64_t wait_us, bool admitted)
+        : timestamp_(timestamp),
+          workload_class_(workload_class),
+          estimated_cost_(estimated_cost),
+          estimated_memory_(estimated_memory),
+          queue_depth_(queue_depth),
+          wait_us_(wait_us),
+          admitted_(admitted) {}
+
+    const uint64_t timestamp_;
+    const uint8_t workload_class_;
+    const double estimated_cost_;
+    const uint64_t estimated_memory_;
+    const uint64_t queue_depth_;
+    const uint64_t wait_us_;
+    const bool admitted_;
+  };
+
+  std::list<AdmissionData> admission_data_;
+};
+
+/**
+ * Metrics for the admission control of the traffic cop, collected for every query that had to be admitted
+ */
+class AdmissionControlMetric : public AbstractMetric<AdmissionControlMetricRawData> {
+ private:
+  friend class MetricsStore;
+
+  void RecordAdmission(uint8_t workload_class, double estimated_cost, uint64_t estimated_memory, uint64_t queue_depth,
+                       uint64_t wait_us, bool admitted) {
+    GetRawData()->RecordAdmission(workload_class, estimated_cost, estimated_memory, queue_depth, wait_us, admitted);
+  }
+};
+}  // namespace noisepage::metrics
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "metrics/abstract_raw_data.h"
+#include "metrics/metrics_ring_buffer.h"
+
+namespace noisepage::metrics {
+
+/**
+ * @brief Metric whose data points travel to the aggregator through a MetricsRingBuffer instead of a swapped RawData.
+ *
+ * AbstractMetric makes every data point take a latch and append to a RawData object that the aggregator later swaps
+ * out whole. That is fine for metrics that are recorded a few times per second, but for per-query or per-transaction
+ * metrics the collecting thread keeps allocating list nodes while the aggregator falls behind, and memory grows
+ * without bound. A BufferedMetric instead pushes fixed-size records into a bounded per-thread ring, which the
+ * aggregator drains into a fresh RawData on every Swap(). When the aggregator cannot keep up, records are dropped and
+ * counted rather than buffered.
+ *
+ * DataType must define a Record type and a method Append(Record &&) that adds one record to the RawData.
+ *
+ * @tparam DataType the type of AbstractRawData the records are aggregated into
+ */
+template <typename DataType>
+class BufferedMetric {
+ public:
+  /** The type of the records that are buffered. */
+  using Record = typename DataType::Record;
+
+  /**
+   * @param capacity number of records buffered per thread before they are dropped
+   */
+  explicit BufferedMetric(const uint64_t capacity) : records_(capacity) {}
+
+  /**
+   * Move buffered records into a new RawData. Must only be called from the aggregator.
+   * @param limit maximum number of records to move, which bounds the work of a single call; the rest stay buffered
+   * @return the oldest records recorded since the last call, at most limit of them
+   */
+  std::unique_ptr<AbstractRawData> Swap(const uint64_t limit = std::numeric_limits<uint64_t>::max()) {
+    auto data = std::make_unique<DataType>();
+    records_.Drain([&data](Record &&record) { data->Append(std::move(record)); }, limit);
+    return data;
+  }
+
+  /**
+   * Read and reset the number of dropped records. Must only be called from the aggregator.
+   * @return number of records dropped since the last call because the buffer was full
+   */
+  uint64_t TakeDropped() { return records_.TakeDropped(); }
+
+ protected:
+  /**
+   * Buffer a record for the aggregator. Must only be called from the thread that owns the metric.
+   * @param record the record
+   */
+  void Push(Record &&record) { records_.Push(std::move(record)); }
+
+ private:
+  MetricsRingBuffer<Record> records_;
+};
+
+}  // namespace noisepage::metrics
@@ -14,6 +14,7 @@ enum class MetricsComponent : uint8_t {
   BIND_COMMAND,
   EXECUTE_COMMAND,
   QUERY_TRACE,
+  ADMISSION_CONTROL,
 };
 
 /**
@@ -26,8 +27,9 @@ enum class MetricsOutput : uint8_t {
   CSV,
   DB,
   CSV_AND_DB,
+  BINARY,
 };
 
-constexpr uint8_t NUM_COMPONENTS = 8;
+constexpr uint8_t NUM_COMPONENTS = 9;
 
 }  // namespace noisepage::metrics
@@ -27,15 +27,27 @@ namespace noisepage::metrics {
  */
 class MetricsManager {
  public:
-  MetricsManager();
+  /** Default number of pipeline and transaction records that each thread buffers until they are aggregated. */
+  static constexpr uint64_t DEFAULT_BUFFER_CAPACITY = 4096;
+
+  /**
+   * @param buffer_capacity number of pipeline and transaction records that each thread buffers until they are
+   * aggregated, records beyond it are dropped
+   * @param aggregation_limit maximum number of those records that Aggregate() takes from each thread
+   */
+  explicit MetricsManager(uint64_t buffer_capacity = DEFAULT_BUFFER_CAPACITY,
+                          uint64_t aggregation_limit = DEFAULT_BUFFER_CAPACITY);
 
   /**
    * Aggregate metrics from all threads which have collected stats, combine with what was previously collected
    *
    * @warning this method should be called before manipulating the worker pool, especially if
    * some of the worker threads are reassigned to tasks other than execution.
+   *
+   * @param drain true to take every buffered record, for callers that need all the data recorded so far; false to
+   * take at most the aggregation limit from each thread, which bounds how long the periodic aggregation holds the latch
    */
-  void Aggregate();
+  void Aggregate(bool drain = false);
 
   /**
    * Called by the thread to get a MetricsStore object
@@ -53,6 +65,16 @@ class MetricsManager {
    */
   std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> &AggregatedMetrics() { return aggregated_metrics_; }
 
+  /**
+   * @param component to be queried
+   * @return number of records of this component that were dropped because a thread recorded them faster than they
+   * were aggregated
+   */
+  uint64_t DroppedRecords(const MetricsComponent component) const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return dropped_records_[static_cast<uint8_t>(component)];
+  }
+
   /**
    * @param component to be tested
    * @return true if metrics are enabled for this component, false otherwise
@@ -119,6 +141,11 @@ class MetricsManager {
    */
   void ToCSV(uint8_t component) const;
 
+  /**
+   * Dump aggregated metrics to binary files, or to CSV files for metrics without a binary format.
+   */
+  void ToBinary(uint8_t component) const;
+
   /**
    * Dump aggregated metrics to internal tables.
    */
@@ -126,10 +153,14 @@ class MetricsManager {
 
   void ResetMetric(MetricsComponent component) const;
 
+  const uint64_t buffer_capacity_;
+  const uint64_t aggregation_limit_;
+
   mutable common::SpinLatch latch_;
   std::unordered_map<std::thread::id, std::unique_ptr<MetricsStore>> stores_map_;
 
   std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> aggregated_metrics_;
+  std::array<uint64_t, NUM_COMPONENTS> dropped_records_{};
 
   std::bitset<NUM_COMPONENTS> enabled_metrics_ = 0x0;
 
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "common/math_util.h"
+
+namespace noisepage::metrics {
+
+/**
+ * @brief Bounded single-producer single-consumer queue that carries metric records from a collecting thread to the
+ * metrics thread.
+ *
+ * The producer is the thread that owns the MetricsStore, the consumer is whoever aggregates (always under the
+ * MetricsManager's latch). Neither side ever blocks the other: a record is published with one release store, and when
+ * the ring is full the record is dropped and counted instead of growing memory. The slots are allocated on the first
+ * push, so threads that never record a given metric do not pay for its ring.
+ *
+ * @tparam Record record type held in each slot, must be default-constructible and move-assignable
+ */
+template <typename Record>
+class MetricsRingBuffer {
+ public:
+  /**
+   * @param capacity minimum number of records the ring can hold, rounded up to a power of two
+   */
+  explicit MetricsRingBuffer(const uint64_t capacity) : mask_(common::MathUtil::PowerOf2Ceil(capacity) - 1) {}
+
+  /** Free the slots. */
+  ~MetricsRingBuffer() { delete[] slots_.load(std::memory_order_relaxed); }
+
+  DISALLOW_COPY_AND_MOVE(MetricsRingBuffer);
+
+  /**
+   * Append a record. Must only be called by the producer.
+   * @param record record to move into the ring
+   * @return true if the record was enqueued, false if the ring was full and the record was dropped
+   */
+  bool Push(Record &&record) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) > mask_) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    Record *slots = slots_.load(std::memory_order_relaxed);
+    if (slots == nullptr) {
+      slots = new Record[mask_ + 1];
+      slots_.store(slots, std::memory_order_release);
+    }
+    slots[tail & mask_] = std::move(record);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Move records out of the ring, oldest first. Must only be called by the consumer.
+   * @tparam Consumer callable taking Record &&
+   * @param consumer invoked once per record
+   * @param limit maximum number of records to take, so that a single pass has bounded cost
+   * @return number of records taken
+   */
+  template <typename Consumer>
+  uint64_t Drain(Consumer &&consumer, const uint64_t limit = std::numeric_limits<uint64_t>::max()) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const uint64_t count = std::min(tail_.load(std::memory_order_acquire) - head, limit);
+    if (count == 0) return 0;
+    Record *const slots = slots_.load(std::memory_order_acquire);
+    for (uint64_t i = 0; i < count; i++) {
+      consumer(std::move(slots[(head + i) & mask_]));
+    }
+    head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  /**
+   * Read and reset the number of records dropped since the last call. Must only be called by the consumer.
+   * @return number of records dropped because the ring was full
+   */
+  uint64_t TakeDropped() { return dropped_.exchange(0, std::memory_order_relaxed); }
+
+  /** @return number of records the ring can hold */
+  uint64_t Capacity() const { return mask_ + 1; }
+
+ private:
+  const uint64_t mask_;
+  std::atomic<Record *> slots_{nullptr};
+  // The consumer and producer indices are on separate cache lines, since they are written by different threads.
+  alignas(common::Constants::CACHELINE_SIZE) std::atomic<uint64_t> head_{0};
+  alignas(common::Constants::CACHELINE_SIZE) std::atomic<uint64_t> tail_{0};
+  std::atomic<uint64_t> dropped_{0};
+};
+
+}  // namespace noisepage::metrics
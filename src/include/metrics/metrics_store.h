@@ -13,6 +13,7 @@
 #include "loggers/metrics_logger.h"
 #include "metrics/abstract_metric.h"
 #include "metrics/abstract_raw_data.h"
+#include "metrics/admission_control_metric.h"
 #include "metrics/bind_command_metric.h"
 #include "metrics/execute_command_metric.h"
 #include "metrics/execution_metric.h"
@@ -225,6 +226,24 @@ class MetricsStore {
     query_trace_metric_->RecordQueryTrace(db_oid, query_id, timestamp, param);
   }
 
+  /**
+   * Record the admission of a query by the admission controller
+   * @param workload_class workload class of the query
+   * @param estimated_cost cost of the query estimated by the optimizer
+   * @param estimated_memory memory the query was expected to use
+   * @param queue_depth number of queries of the same class that were queued ahead of it
+   * @param wait_us time the query waited to be admitted
+   * @param admitted false if the query timed out in the queue
+   */
+  void RecordAdmission(uint8_t workload_class, double estimated_cost, uint64_t estimated_memory, uint64_t queue_depth,
+                       uint64_t wait_us, bool admitted) {
+    NOISEPAGE_ASSERT(ComponentEnabled(MetricsComponent::ADMISSION_CONTROL), "AdmissionControlMetric not enabled.");
+    NOISEPAGE_ASSERT(admission_control_metric_ != nullptr,
+                     "AdmissionControlMetric not allocated. Check MetricsStore constructor.");
+    admission_control_metric_->RecordAdmission(workload_class, estimated_cost, estimated_memory, queue_depth, wait_us,
+                                               admitted);
+  }
+
   /**
    * @param component metrics component to test
    * @return true if metrics enabled for this component, false otherwise
@@ -262,9 +281,19 @@ class MetricsStore {
 
   explicit MetricsStore(common::ManagedPointer<metrics::MetricsManager> metrics_manager,
                         const std::bitset<NUM_COMPONENTS> &enabled_metrics,
-                        const std::array<std::vector<bool>, NUM_COMPONENTS> &samples_mask_);
+                        const std::array<std::vector<bool>, NUM_COMPONENTS> &samples_mask_,
+                        uint64_t buffer_capacity);
 
-  std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> GetDataToAggregate();
+  /**
+   * @param buffered_limit maximum number of records taken from each buffered metric, see BufferedMetric::Swap
+   * @return the data of each enabled component that was recorded since the last call
+   */
+  std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> GetDataToAggregate(uint64_t buffered_limit);
+
+  /**
+   * @return number of records per component that were dropped since the last call because their buffer was full
+   */
+  std::array<uint64_t, NUM_COMPONENTS> TakeDroppedRecords();
 
   std::unique_ptr<LoggingMetric> logging_metric_;
   std::unique_ptr<QueryTraceMetric> query_trace_metric_;
@@ -274,6 +303,7 @@ class MetricsStore {
   std::unique_ptr<PipelineMetric> pipeline_metric_;
   std::unique_ptr<BindCommandMetric> bind_command_metric_;
   std::unique_ptr<ExecuteCommandMetric> execute_command_metric_;
+  std::unique_ptr<AdmissionControlMetric> admission_control_metric_;
 
   const std::bitset<NUM_COMPONENTS> &enabled_metrics_;
   const std::array<std::vector<bool>, NUM_COMPONENTS> &samples_mask_;
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <chrono>  // NOLINT
+#include <fstream>
 #include <optional>
 #include <string>
+#include <type_traits>
 
 #include "execution/util/cpu_info.h"
 #include "metrics/metrics_defs.h"
@@ -35,23 +37,48 @@ struct MetricsUtil {
   }
 
   /**
-   * Converts a metrics output string to the enum.
-   * Mainly used to convert a settings flag (string) to internal enum.
-   * @param metrics output string
-   * @return MetricsOutput corresponding to it
+   * Converts a metrics output string to the enum, if the component can write that output.
+   * Mainly used to convert a settings flag (string) to internal enum. Pipeline metrics have no internal tables to be
+   * written to, and query traces have no binary format.
+   * @param component metrics component whose output the string selects
+   * @param metrics output string, one of NONE, CSV, DB, CSV_AND_DB and BINARY
+   * @return MetricsOutput corresponding to it, or nullopt if the string is unknown or the component cannot write it
    */
-  static std::optional<MetricsOutput> FromMetricsOutputString(const std::string_view &metrics) {
+  static std::optional<MetricsOutput> FromMetricsOutputString(const MetricsComponent component,
+                                                              const std::string_view &metrics) {
     std::optional<MetricsOutput> type{std::nullopt};
-    if (metrics == "CSV") {
+    if (metrics == "NONE") {
+      type = MetricsOutput::NONE;
+    } else if (metrics == "CSV") {
       type = MetricsOutput::CSV;
     } else if (metrics == "DB") {
       type = MetricsOutput::DB;
     } else if (metrics == "CSV_AND_DB") {
       type = MetricsOutput::CSV_AND_DB;
+    } else if (metrics == "BINARY") {
+      type = MetricsOutput::BINARY;
+    }
+
+    const bool to_db = type == MetricsOutput::DB || type == MetricsOutput::CSV_AND_DB;
+    if ((to_db && component == MetricsComponent::EXECUTION_PIPELINE) ||
+        (type == MetricsOutput::BINARY && component == MetricsComponent::QUERY_TRACE)) {
+      return std::nullopt;
     }
     return type;
   }
 
+  /**
+   * Append a value to a binary metrics file, in host byte order.
+   * @tparam T arithmetic type of the value
+   * @param outfile opened ofstream to write to
+   * @param value value to write
+   */
+  template <typename T>
+  static void WriteBinary(std::ofstream *const outfile, const T value) {
+    static_assert(std::is_arithmetic_v<T>, "Binary metrics files only hold plain numbers.");
+    outfile->write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
   /**
    * @return The hardware context to record
    */
@@ -11,7 +11,8 @@
 
 #include "catalog/catalog_defs.h"
 #include "common/resource_tracker.h"
-#include "metrics/abstract_metric.h"
+#include "metrics/abstract_raw_data.h"
+#include "metrics/buffered_metric.h"
 #include "metrics/metrics_util.h"
 #include "self_driving/modeling/operating_unit.h"
 #include "self_driving/modeling/operating_unit_util.h"
@@ -29,6 +30,31 @@ namespace noisepage::metrics {
  */
 class PipelineMetricRawData : public AbstractRawData {
  public:
+  /**
+   * A pipeline data point as it is buffered by the thread that executed the pipeline
+   */
+  struct Record {
+    /** Query Identifier */
+    execution::query_id_t query_id_;
+    /** Pipeline Identifier */
+    execution::pipeline_id_t pipeline_id_;
+    /** Execution Mode */
+    uint8_t execution_mode_;
+    /** Feature Vector */
+    std::vector<selfdriving::ExecutionOperatingUnitFeature> features_;
+    /** Metrics */
+    common::ResourceTracker::Metrics resource_metrics_;
+  };
+
+  /**
+   * Add a buffered data point
+   * @param record the data point
+   */
+  void Append(Record &&record) {
+    pipeline_data_.emplace_back(record.query_id_, record.pipeline_id_, record.execution_mode_,
+                                std::move(record.features_), record.resource_metrics_);
+  }
+
   void Aggregate(AbstractRawData *const other) override {
     auto other_db_metric = dynamic_cast<PipelineMetricRawData *>(other);
     if (!other_db_metric->pipeline_data_.empty()) {
@@ -77,6 +103,41 @@ class PipelineMetricRawData : public AbstractRawData {
     pipeline_data_.clear();
   }
 
+  /**
+   * Writes the data out to binary files. Every data point is written as query_id (u32), pipeline_id (u32),
+   * exec_mode (u8), cpu_freq (f64) and num_features (u32), followed by num_features features of type (u32), num_rows,
+   * key_size, num_keys, est_cardinality (u64), mem_factor (f64), num_loops, num_concurrent, specific_feature0 and
+   * specific_feature1 (u64), followed by the resource metrics (@see common::ResourceTracker::Metrics::ToBinary).
+   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   */
+  void ToBinary(std::vector<std::ofstream> *const outfiles) final {
+    NOISEPAGE_ASSERT(outfiles->size() == BINARY_FILES.size(), "Number of files passed to metric is wrong.");
+    auto *const outfile = &(*outfiles)[0];
+    auto context = MetricsUtil::GetHardwareContext();
+
+    for (const auto &data : pipeline_data_) {
+      MetricsUtil::WriteBinary<uint32_t>(outfile, data.query_id_.UnderlyingValue());
+      MetricsUtil::WriteBinary<uint32_t>(outfile, data.pipeline_id_.UnderlyingValue());
+      MetricsUtil::WriteBinary<uint8_t>(outfile, data.execution_mode_);
+      MetricsUtil::WriteBinary<double>(outfile, context.cpu_mhz_);
+      MetricsUtil::WriteBinary<uint32_t>(outfile, static_cast<uint32_t>(data.features_.size()));
+      for (const auto &feature : data.features_) {
+        MetricsUtil::WriteBinary<uint32_t>(outfile, static_cast<uint32_t>(feature.GetExecutionOperatingUnitType()));
+        MetricsUtil::WriteBinary<uint64_t>(outfile, feature.GetNumRows());
+        MetricsUtil::WriteBinary<uint64_t>(outfile, feature.GetKeySize());
+        MetricsUtil::WriteBinary<uint64_t>(outfile, feature.GetNumKeys());
+        MetricsUtil::WriteBinary<uint64_t>(outfile, feature.GetCardinality());
+        MetricsUtil::WriteBinary<double>(outfile, feature.GetMemFactor());
+        MetricsUtil::WriteBinary<uint64_t>(outfile, feature.GetNumLoops());
+        MetricsUtil::WriteBinary<uint64_t>(outfile, feature.GetNumConcurrent());
+        MetricsUtil::WriteBinary<uint64_t>(outfile, feature.GetSpecificFeature0());
+        MetricsUtil::WriteBinary<uint64_t>(outfile, feature.GetSpecificFeature1());
+      }
+      data.resource_metrics_.ToBinary(*outfile);
+    }
+    pipeline_data_.clear();
+  }
+
   /**
    * Files to use for writing to CSV.
    */
@@ -90,6 +151,11 @@ class PipelineMetricRawData : public AbstractRawData {
       "query_id, pipeline_id, num_features, features, cpu_freq, exec_mode, num_rows, key_sizes, num_keys, "
       "est_cardinalities, mem_factor, num_loops, num_concurrent, specific_feature0, specific_feature1"};
 
+  /**
+   * Files to use for writing binary output.
+   */
+  static constexpr std::array<std::string_view, 1> BINARY_FILES = {"./pipeline.bin"};
+
  private:
   friend class PipelineMetric;
   friend class selfdriving::pilot::PilotUtil;
@@ -110,7 +176,7 @@ class PipelineMetricRawData : public AbstractRawData {
         : query_id_(query_id),
           pipeline_id_(pipeline_id),
           execution_mode_(execution_mode),
-          features_(features),
+          features_(std::move(features)),
           resource_metrics_(resource_metrics) {}
 
     template <class T>
@@ -217,16 +283,23 @@ class PipelineMetricRawData : public AbstractRawData {
 };
 
 /**
- * Metrics for the execution engine of the system collected at the pipeline level
+ * Metrics for the execution engine of the system collected at the pipeline level. Pipelines are recorded once per
+ * query execution, so the data points are buffered in a ring rather than appended under a latch.
  */
-class PipelineMetric : public AbstractMetric<PipelineMetricRawData> {
+class PipelineMetric : public BufferedMetric<PipelineMetricRawData> {
+ public:
+  /**
+   * @param capacity number of records buffered per thread before they are dropped
+   */
+  explicit PipelineMetric(const uint64_t capacity) : BufferedMetric(capacity) {}
+
  private:
   friend class MetricsStore;
 
   void RecordPipelineData(execution::query_id_t query_id, execution::pipeline_id_t pipeline_id, uint8_t execution_mode,
                           std::vector<selfdriving::ExecutionOperatingUnitFeature> &&features,
                           const common::ResourceTracker::Metrics &resource_metrics) {
-    GetRawData()->RecordPipelineData(query_id, pipeline_id, execution_mode, std::move(features), resource_metrics);
+    Push({query_id, pipeline_id, execution_mode, std::move(features), resource_metrics});
   }
 };
 }  // namespace noisepage::metrics
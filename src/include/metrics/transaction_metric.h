@@ -8,7 +8,9 @@
 #include <vector>
 
 #include "catalog/catalog_defs.h"
-#include "metrics/abstract_metric.h"
+#include "common/resource_tracker.h"
+#include "metrics/abstract_raw_data.h"
+#include "metrics/buffered_metric.h"
 #include "metrics/metrics_util.h"
 #include "transaction/transaction_defs.h"
 
@@ -19,6 +21,30 @@ namespace noisepage::metrics {
  */
 class TransactionMetricRawData : public AbstractRawData {
  public:
+  /**
+   * A transaction data point as it is buffered by the thread that began or committed the transaction
+   */
+  struct Record {
+    /** True for a commit, false for a begin */
+    bool is_commit_;
+    /** Whether the committed transaction was read-only, unused for a begin */
+    uint64_t is_readonly_;
+    /** Metrics */
+    common::ResourceTracker::Metrics resource_metrics_;
+  };
+
+  /**
+   * Add a buffered data point
+   * @param record the data point
+   */
+  void Append(Record &&record) {
+    if (record.is_commit_) {
+      RecordCommitData(record.is_readonly_, record.resource_metrics_);
+    } else {
+      RecordBeginData(record.resource_metrics_);
+    }
+  }
+
   void Aggregate(AbstractRawData *const other) override {
     auto other_db_metric = dynamic_cast<TransactionMetricRawData *>(other);
     if (!other_db_metric->begin_data_.empty()) {
@@ -60,11 +86,37 @@ class TransactionMetricRawData : public AbstractRawData {
     commit_data_.clear();
   }
 
+  /**
+   * Writes the data out to binary files. A begin is written as its resource metrics, a commit as is_readonly (u64)
+   * followed by its resource metrics (@see common::ResourceTracker::Metrics::ToBinary).
+   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   */
+  void ToBinary(std::vector<std::ofstream> *const outfiles) final {
+    NOISEPAGE_ASSERT(outfiles->size() == BINARY_FILES.size(), "Number of files passed to metric is wrong.");
+    auto &begin_outfile = (*outfiles)[0];
+    auto &commit_outfile = (*outfiles)[1];
+
+    for (const auto &data : begin_data_) {
+      data.resource_metrics_.ToBinary(begin_outfile);
+    }
+    for (const auto &data : commit_data_) {
+      MetricsUtil::WriteBinary<uint64_t>(&commit_outfile, data.is_readonly_);
+      data.resource_metrics_.ToBinary(commit_outfile);
+    }
+    begin_data_.clear();
+    commit_data_.clear();
+  }
+
   /**
    * Files to use for writing to CSV.
    */
   static constexpr std::array<std::string_view, 2> FILES = {"./txn_begin.csv", "./txn_commit.csv"};
 
+  /**
+   * Files to use for writing binary output.
+   */
+  static constexpr std::array<std::string_view, 2> BINARY_FILES = {"./txn_begin.bin", "./txn_commit.bin"};
+
   /**
    * Columns to use for writing to CSV.
    */
@@ -73,6 +125,7 @@ class TransactionMetricRawData : public AbstractRawData {
  private:
   friend class TransactionMetric;
   FRIEND_TEST(MetricsTests, TransactionCSVTest);
+  FRIEND_TEST(MetricsTests, AggregationLimitTest);
 
   void RecordBeginData(const common::ResourceTracker::Metrics &resource_metrics) {
     begin_data_.emplace_back(resource_metrics);
@@ -100,17 +153,24 @@ class TransactionMetricRawData : public AbstractRawData {
 };
 
 /**
- * Metrics for the transaction components of the system: currently begin gate and table latch
+ * Metrics for the transaction components of the system: currently begin gate and table latch. Every transaction
+ * records data points, so they are buffered in a ring rather than appended under a latch.
  */
-class TransactionMetric : public AbstractMetric<TransactionMetricRawData> {
+class TransactionMetric : public BufferedMetric<TransactionMetricRawData> {
+ public:
+  /**
+   * @param capacity number of records buffered per thread before they are dropped
+   */
+  explicit TransactionMetric(const uint64_t capacity) : BufferedMetric(capacity) {}
+
  private:
   friend class MetricsStore;
 
   void RecordBeginData(const common::ResourceTracker::Metrics &resource_metrics) {
-    GetRawData()->RecordBeginData(resource_metrics);
+    Push({false, 0, resource_metrics});
   }
   void RecordCommitData(const uint64_t is_readonly, const common::ResourceTracker::Metrics &resource_metrics) {
-    GetRawData()->RecordCommitData(is_readonly, resource_metrics);
+    Push({true, is_readonly, resource_metrics});
   }
 };
 }  // namespace noisepage::metrics
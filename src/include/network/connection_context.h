@@ -13,6 +13,8 @@
 
 namespace noisepage::network {
 
+class ExecutionWorkerPool;
+
 /**
  * A ConnectionContext stores the state of a connection. There should be as little as possible that is protocol-specific
  * in this layer, and if you find yourself wanting to put more the design should be discussed.
@@ -161,6 +163,22 @@ class ConnectionContext {
    */
   void *CallbackArg() const { return callback_arg_; }
 
+  /**
+   * @param execution_pool pool that the connection's queries execute on, nullptr or a pool without execution threads if
+   *        they execute inline
+   * @warning only to be used by ConnectionHandle's constructor
+   */
+  void SetExecutionPool(const common::ManagedPointer<ExecutionWorkerPool> execution_pool) {
+    execution_pool_ = execution_pool;
+  }
+
+  /**
+   * @return pool that the connection's queries execute on, nullptr or a pool without execution threads if they execute
+   * inline. It also runs the queries of portals that are fetched a few rows at a time. It is a property of the
+   * ConnectionHandle rather than the connection, so Reset() keeps it.
+   */
+  common::ManagedPointer<ExecutionWorkerPool> ExecutionPool() const { return execution_pool_; }
+
   /**
    * @return CatalogCache to be injected into requests for CatalogAcessors
    */
@@ -214,6 +232,11 @@ class ConnectionContext {
   network::NetworkCallback callback_;
   void *callback_arg_;
 
+  /**
+   * Pool that the ConnectionHandle executes queries on, e.g., to run portals that are fetched a few rows at a time.
+   */
+  common::ManagedPointer<ExecutionWorkerPool> execution_pool_ = nullptr;
+
   catalog::CatalogCache catalog_cache_;
 };
 
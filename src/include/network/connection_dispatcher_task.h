@@ -19,6 +19,9 @@ class ProtocolInterpreterProvider;
 /**
  * @brief ConnectionDispatcherTask dispatches incoming connections to a pool of handler threads.
  *
+ * A server may run several dispatchers (acceptors). Each one owns its handler threads, which only ever receive
+ * connections from that dispatcher, so acceptors never contend with each other when they hand off a connection.
+ *
  * Task life-cycle:
  * - RunTask()   : This task registers all of its ConnectionHandlerTask instances with the DedicatedThreadRegistry.
  * - Terminate() : This task stops and removes all its ConnectionHandlerTask instances from the DedicatedThreadRegistry.
@@ -35,22 +38,27 @@ class ConnectionDispatcherTask : public common::NotifiableTask {
    * @brief Create a new ConnectionDispatcherTask.
    *
    * @param num_handlers The number of handler tasks to spawn.
+   * @param first_handler_id The task id of the first handler task, the others are numbered consecutively.
    * @param dedicated_thread_owner The DedicatedThreadOwner associated with this task.
    * @param interpreter_provider Provider that constructs protocol interpreters.
    * @param connection_handle_factory The connection handle factory pointer to pass down to the handlers.
    * @param thread_registry DedicatedThreadRegistry, needed because it eventually spawns more threads in RunTask.
-   * @param file_descriptors The list of file descriptors to listen on.
+   * @param file_descriptors The list of file descriptors to listen on, which have to be non-blocking.
    */
-  ConnectionDispatcherTask(uint32_t num_handlers, common::DedicatedThreadOwner *dedicated_thread_owner,
+  ConnectionDispatcherTask(uint32_t num_handlers, uint32_t first_handler_id,
+                           common::DedicatedThreadOwner *dedicated_thread_owner,
                            common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider,
                            common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory,
                            common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
                            std::initializer_list<int> file_descriptors);
 
   /**
-   * @brief Dispatches the supplied client connection to a handler.
+   * @brief Accepts the pending client connections of a listening socket and dispatches each of them to a handler.
+   *
+   * At most MAX_ACCEPTS_PER_WAKEUP connections are accepted at a time, so that a connection storm on one socket does
+   * not starve the other sockets of this dispatcher.
    *
-   * @param fd The socket file descriptor of the client connection to be dispatched.
+   * @param fd The listening socket file descriptor that has connections pending.
    * @param provider The protocol that should be used to handle this request.
    */
   void DispatchConnection(uint32_t fd, common::ManagedPointer<ProtocolInterpreterProvider> provider);
@@ -69,8 +77,12 @@ class ConnectionDispatcherTask : public common::NotifiableTask {
   /** @return The offset in handlers_ of the next handler to dispatch to. This function mutates internal state. */
   uint64_t NextDispatchHandlerOffset();
 
+  /** The maximum number of connections accepted from one socket before the event loop gets to run again. */
+  static constexpr uint32_t MAX_ACCEPTS_PER_WAKEUP = 64;
+
   /** The maximum number of handler tasks that will be spawned. */
   const uint32_t num_handlers_;
+  const uint32_t first_handler_id_;
   common::DedicatedThreadOwner *const dedicated_thread_owner_;
   const common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory_;
   const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry_;
@@ -12,8 +12,10 @@ struct event;
 namespace noisepage::network {
 
 class ConnectionHandlerTask;
+class ExecutionWorkerPool;
 class NetworkIoWrapper;
 class ProtocolInterpreter;
+class ProtocolInterpreterProvider;
 
 /**
  * ConnectionHandle encapsulates IO-related information throughout the lifetime of a client connection.
@@ -28,11 +30,14 @@ class ConnectionHandle {
    * @param sock_fd Client connection's file descriptor.
    * @param task The task responsible for this handle's creation.
    * @param tcop The traffic cop to be used.
-   * @param interpreter protocol Interpreter to use for this connection handle.
+   * @param interpreter_provider Provider of the protocol interpreter to use for this connection handle.
+   * @param execution_pool The pool that runs query execution, or nullptr to execute on the handler thread, as does a
+   *                       pool without execution threads.
    */
   ConnectionHandle(int sock_fd, common::ManagedPointer<ConnectionHandlerTask> task,
                    common::ManagedPointer<trafficcop::TrafficCop> tcop,
-                   std::unique_ptr<ProtocolInterpreter> interpreter);
+                   common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider,
+                   common::ManagedPointer<ExecutionWorkerPool> execution_pool = nullptr);
 
   /** Reset this connection handle. */
   ~ConnectionHandle();
@@ -73,18 +78,23 @@ class ConnectionHandle {
 
   /**
    * @brief Processes the client's input that has been fed into the ReadBuffer
+   *
+   * Packets that execute queries are handed to the execution worker pool if there is one, in which case the handle
+   * waits for the worker to wake it up (Transition::NEED_RESULT).
    * @return The transition to trigger in the state machine after
    */
   Transition Process();
 
   /**
-   * @brief Gets a computed result that the client requested
-   * @return The transition to trigger in the state machine after
+   * @brief Gets a computed result that the client requested, i.e., resumes after an execution worker processed a packet
+   * @return The transition that the execution worker's processing produced
    */
   Transition GetResult();
 
   /**
    * @brief Tries to close the current client connection
+   *
+   * Once the connection is closed, the handle is given back to its ConnectionHandlerTask for the next connection.
    * @return The transition to trigger in the state machine after
    */
   Transition TryCloseConnection();
@@ -112,9 +122,20 @@ class ConnectionHandle {
   static void Callback(void *callback_args);
 
  private:
-  /** Reset the state of this connection handle for reuse. This should only be called by ConnectionHandleFactory. */
-  void ResetForReuse(connection_id_t connection_id, common::ManagedPointer<ConnectionHandlerTask> task,
-                     std::unique_ptr<ProtocolInterpreter> interpreter);
+  friend class ExecutionWorkerPool;
+
+  /** Process the client's input through the protocol interpreter on the calling thread. */
+  Transition ProcessPacket();
+
+  /** Process the client's input on an execution worker, then wake up the handler thread through workpool_event_. */
+  void ProcessOnWorker();
+
+  /**
+   * Reset the state of this connection handle for a new connection, keeping its buffers and, if the new connection
+   * uses the same protocol, its protocol interpreter. This should only be called by ConnectionHandleFactory.
+   */
+  void ResetForReuse(int sock_fd, common::ManagedPointer<ConnectionHandlerTask> task,
+                     common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider);
 
   /**
    * A state machine is defined to be a set of states, a set of symbols it
@@ -167,12 +188,17 @@ class ConnectionHandle {
   std::unique_ptr<NetworkIoWrapper> io_wrapper_;
   common::ManagedPointer<ConnectionHandlerTask> conn_handler_task_;
   common::ManagedPointer<trafficcop::TrafficCop> traffic_cop_;
+  common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider_;
   std::unique_ptr<ProtocolInterpreter> protocol_interpreter_;
 
   StateMachine state_machine_{};
   struct event *network_event_ = nullptr;
   struct event *workpool_event_ = nullptr;
 
+  common::ManagedPointer<ExecutionWorkerPool> execution_pool_;
+  /** Transition produced by the last packet processed on an execution worker, consumed by GetResult(). */
+  Transition worker_transition_ = Transition::PROCEED;
+
   ConnectionContext context_;
 };
 }  // namespace noisepage::network
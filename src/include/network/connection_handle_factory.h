@@ -1,7 +1,7 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 #include "network/connection_handle.h"
 
@@ -12,43 +12,59 @@ class TrafficCop;
 namespace noisepage::network {
 
 class ConnectionHandlerTask;
-class ProtocolInterpreter;
+class ExecutionWorkerPool;
+class ProtocolInterpreterProvider;
 
 /**
  * @brief ConnectionHandleFactory constructs and reuses ConnectionHandle objects.
  *
  * Reasons for reuse:
- * - ConnectionHandle wraps read and write buffers which are expensive to reallocate. Therefore reuse is desirable.
+ * - ConnectionHandle wraps read and write buffers and a protocol interpreter which are expensive to reallocate.
+ *   Short-lived connections would otherwise spend a good share of their time setting them up and tearing them down.
  * - Moreover, as noted by Tianyu, from a lifetime perspective losing track of a ConnectionHandle leaves the
  *   lost ConnectionHandle completely managed by libevent. libevent does not clean up raw pointers. This leaks memory.
  *
- * @warning As noted in NewConnectionHandle, the file descriptors provided to this factory should no longer be in use.
+ * A handle whose connection was closed goes back to the free list of its ConnectionHandlerTask. The factory owns all
+ * handles, but only ever reuses a handle on the thread that released it, which is the only thread that touched it.
  */
 class ConnectionHandleFactory {
  public:
-  /** Instantiate a new ConnectionHandleFactory that uses the provided TrafficCop for all the handles created. */
-  explicit ConnectionHandleFactory(common::ManagedPointer<trafficcop::TrafficCop> tcop) : traffic_cop_(tcop) {}
+  /**
+   * Instantiate a new ConnectionHandleFactory that uses the provided TrafficCop for all the handles created.
+   * @param tcop The traffic cop that the handles use.
+   * @param execution_pool The pool that the handles execute queries on, or nullptr to execute on the handler threads.
+   */
+  explicit ConnectionHandleFactory(common::ManagedPointer<trafficcop::TrafficCop> tcop,
+                                   common::ManagedPointer<ExecutionWorkerPool> execution_pool = nullptr)
+      : traffic_cop_(tcop), execution_pool_(execution_pool) {}
 
   /**
    * @brief Create a new connection handle.
    *
+   * Reuses a handle from the free list of the task if there is one. Must be called on the thread of the task.
+   *
    * @param conn_fd File descriptor for the client connection.
-   * @param interpreter The protocol interpreter to use for the new ConnectionHandle.
+   * @param interpreter_provider Provider of the protocol interpreter to use for the new ConnectionHandle.
    * @param task The task to be assigned to the new ConnectionHandle.
    *
-   * @warning If the file descriptor provided is currently in use, the old ConnectionHandle that was associated
-   *          with that file descriptor will be completely stomped on. There are no asserts that check this.
-   *
-   * @return A new ConnectionHandle object.
+   * @return A new or reused ConnectionHandle object.
    */
-  ConnectionHandle &NewConnectionHandle(int conn_fd, std::unique_ptr<ProtocolInterpreter> interpreter,
+  ConnectionHandle &NewConnectionHandle(int conn_fd,
+                                        common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider,
                                         common::ManagedPointer<ConnectionHandlerTask> task);
 
+  /** @return The number of ConnectionHandle objects that were ever created, i.e., not reused. */
+  size_t NumConnectionHandles() {
+    common::SpinLatch::ScopedSpinLatch guard(&handles_latch_);
+    return handles_.size();
+  }
+
  private:
-  /** This latch protects reusable_handles_. */
-  common::SpinLatch reusable_handles_latch_;
-  /** Maps from file descriptors -> Connection Handle. Protected by reusable_handles_latch_.*/
-  std::unordered_map<int, ConnectionHandle> reusable_handles_;
+  /** This latch protects handles_. */
+  common::SpinLatch handles_latch_;
+  /** All handles created by this factory, whether in use or free. Protected by handles_latch_. */
+  std::vector<std::unique_ptr<ConnectionHandle>> handles_;
   common::ManagedPointer<trafficcop::TrafficCop> traffic_cop_;
+  common::ManagedPointer<ExecutionWorkerPool> execution_pool_;
 };
 }  // namespace noisepage::network
@@ -3,6 +3,7 @@
 #include <deque>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "common/notifiable_task.h"
 #include "network/network_defs.h"
@@ -10,6 +11,7 @@
 
 namespace noisepage::network {
 
+class ConnectionHandle;
 class ConnectionHandleFactory;
 
 /**
@@ -38,9 +40,27 @@ class ConnectionHandlerTask : public common::NotifiableTask {
    * the necessary data structure so the handler thread is woken up.
    *
    * @param conn_fd the client connection socket fd.
-   * @param protocol_interpreter the protocol interpreter handlers should use to process this request
+   * @param interpreter_provider provider of the protocol interpreter that handlers should use to process this request
    */
-  void Notify(int conn_fd, std::unique_ptr<ProtocolInterpreter> protocol_interpreter);
+  void Notify(int conn_fd, common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider);
+
+  /**
+   * Keep a closed connection handle around, so that the next connection of this task reuses it along with its buffers
+   * and protocol interpreter. Must be called on the thread of this task.
+   * @param handle handle whose connection was closed
+   */
+  void ReleaseConnectionHandle(common::ManagedPointer<ConnectionHandle> handle) { free_handles_.push_back(handle); }
+
+  /**
+   * Take a closed connection handle to reuse for a new connection. Must be called on the thread of this task.
+   * @return a handle released by a previous connection of this task, or nullptr if there is none
+   */
+  common::ManagedPointer<ConnectionHandle> AcquireConnectionHandle() {
+    if (free_handles_.empty()) return nullptr;
+    const auto handle = free_handles_.back();
+    free_handles_.pop_back();
+    return handle;
+  }
 
  private:
   /**
@@ -58,11 +78,15 @@ class ConnectionHandlerTask : public common::NotifiableTask {
    */
   common::SpinLatch jobs_latch_;
   /**
-   * each pair is represents <connection fd, ProtocolInterpreter>
+   * each pair is represents <connection fd, ProtocolInterpreterProvider>
    */
-  std::deque<std::pair<int, std::unique_ptr<ProtocolInterpreter>>> jobs_;
+  std::deque<std::pair<int, common::ManagedPointer<ProtocolInterpreterProvider>>> jobs_;
   event *notify_event_;
   common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory_;
+  /**
+   * Handles of closed connections, ready for reuse. Only accessed on the thread of this task, so no latch is needed.
+   */
+  std::vector<common::ManagedPointer<ConnectionHandle>> free_handles_;
 };
 
 }  // namespace noisepage::network
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <list>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <unordered_set>
+
+#include "common/managed_pointer.h"
+#include "common/worker_pool.h"
+
+namespace noisepage::metrics {
+class MetricsManager;
+}  // namespace noisepage::metrics
+
+namespace noisepage::network {
+
+class ConnectionHandle;
+
+/**
+ * ExecutionWorkerPool runs the work of a connection that may take arbitrarily long, e.g., executing a query, off the
+ * ConnectionHandlerTask threads.
+ *
+ * A ConnectionHandlerTask multiplexes many connections onto a single libevent loop. If it executed queries inline, one
+ * long analytical query would stall every other connection assigned to that handler. Instead, the handler reads and
+ * frames the packet, hands the connection to this pool, and stops listening for network events on it
+ * (Transition::NEED_RESULT). A worker then processes the packet and wakes the connection back up through its
+ * workpool_event_, at which point the handler thread resumes the state machine with the worker's transition.
+ *
+ * At most one task is ever in flight per connection, so a connection's state is only touched by one thread at a time.
+ *
+ * Work that may block for arbitrarily long, like the query of a portal that waits for the client to fetch more rows,
+ * does not run on those workers: the packets that unblock it may be queued behind it. The pool runs such work on
+ * threads that it keeps for blocking tasks instead. It starts another one whenever all of them are busy, up to a
+ * limit beyond which blocking tasks are refused, and threads that stay idle for BLOCKING_WORKER_IDLE_TIMEOUT exit.
+ * Queueing a blocking task behind busy threads is not an option, since they may only return once the client of the
+ * queued task gets its rows.
+ *
+ * A pool without execution threads still runs blocking tasks, while the packets are processed on the handler threads.
+ */
+class ExecutionWorkerPool {
+ public:
+  /** Work that may block for arbitrarily long, see SubmitBlocking() */
+  class BlockingTask {
+   public:
+    virtual ~BlockingTask() = default;
+
+    /** Runs the task on a thread of the pool */
+    virtual void Run() = 0;
+
+    /** Called by Shutdown() while the task is queued or running. Has to make Run() return soon, without blocking. */
+    virtual void Cancel() = 0;
+
+    /** Called once Run() returned, after which the pool does not touch the task anymore */
+    virtual void Finished() = 0;
+  };
+
+  /** Time after which a thread for blocking tasks exits if no task was submitted to it */
+  static constexpr std::chrono::seconds BLOCKING_WORKER_IDLE_TIMEOUT{10};
+
+  /**
+   * Start the pool.
+   * @param num_workers number of execution threads, 0 to leave packets to the handler threads
+   * @param max_blocking_workers maximum number of threads for blocking tasks
+   * @param metrics_manager metrics manager that the execution threads register with, may be DISABLED
+   */
+  ExecutionWorkerPool(uint32_t num_workers, uint32_t max_blocking_workers,
+                      common::ManagedPointer<metrics::MetricsManager> metrics_manager);
+
+  /** Waits for in-flight work to finish and stops the workers. */
+  ~ExecutionWorkerPool() { Shutdown(); }
+
+  DISALLOW_COPY_AND_MOVE(ExecutionWorkerPool);
+
+  /**
+   * Process the next packet of the connection on a worker thread. The handle is woken up through
+   * ConnectionHandle::Callback once its transition is available.
+   * @param handle connection whose packet should be processed, which must not be processed elsewhere until woken up
+   * @return false if the pool was shut down or has no execution threads, in which case the caller has to process the
+   *         packet itself
+   */
+  bool Submit(common::ManagedPointer<ConnectionHandle> handle);
+
+  /**
+   * Run a task that may block for arbitrarily long on a thread of the pool that is kept for such tasks.
+   * @param task task to run, which has to stay alive until its Finished() was called
+   * @return false if the pool was shut down or all of its max_blocking_workers threads are busy, in which case the task
+   *         does not run
+   */
+  bool SubmitBlocking(common::ManagedPointer<BlockingTask> task);
+
+  /**
+   * Finish the queued and in-flight work and stop the worker threads. Blocking tasks are cancelled rather than waited
+   * for. The pool cannot be used afterwards.
+   * The network server calls this before stopping the handler threads that the workers signal.
+   */
+  void Shutdown();
+
+  /** @return number of execution threads */
+  uint32_t NumWorkers() const { return workers_.NumWorkers(); }
+
+  /** @return number of connections that are queued or being processed */
+  uint64_t NumPending() const { return num_pending_.load(std::memory_order_relaxed); }
+
+  /** @return number of blocking tasks that are queued or running */
+  uint64_t NumBlocking() const {
+    std::lock_guard<std::mutex> guard(blocking_mutex_);
+    return blocking_queue_.size() + running_blocking_tasks_.size();
+  }
+
+  /** @return number of threads for blocking tasks that did not exit */
+  uint64_t NumBlockingWorkers() const {
+    std::lock_guard<std::mutex> guard(blocking_mutex_);
+    return blocking_workers_.size();
+  }
+
+ private:
+  void RunBlockingTasks(std::list<std::thread>::iterator worker);
+  void JoinExitedBlockingWorkers();
+
+  common::WorkerPool workers_;
+  common::ManagedPointer<metrics::MetricsManager> metrics_manager_;
+  std::atomic<uint64_t> num_pending_{0};
+  /** Protects running_, so that no work is queued once Shutdown() started draining the pool. */
+  std::mutex running_mutex_;
+  bool running_ = true;
+
+  const uint32_t max_blocking_workers_;
+  /** Protects everything below */
+  mutable std::mutex blocking_mutex_;
+  // Threads for blocking tasks. A thread that exits moves itself to exited_blocking_workers_, to be joined later.
+  std::list<std::thread> blocking_workers_;
+  std::list<std::thread> exited_blocking_workers_;
+  // Signalled when a blocking task is queued and when the pool shuts down
+  std::condition_variable blocking_cv_;
+  std::deque<BlockingTask *> blocking_queue_;
+  std::unordered_set<BlockingTask *> running_blocking_tasks_;
+  // Threads for blocking tasks that wait for a task, minus the tasks that were queued for them
+  uint32_t num_idle_blocking_workers_ = 0;
+  bool blocking_running_ = true;
+};
+
+}  // namespace noisepage::network
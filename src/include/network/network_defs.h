@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "common/strong_typedef.h"
+#include "parser/parser_defs.h"
 
 namespace noisepage::trafficcop {
 class TrafficCop;
@@ -71,6 +72,12 @@ enum class NetworkMessageType : unsigned char {
   PG_PARAMETER_DESCRIPTION = 't',
   PG_ROW_DESCRIPTION = 'T',
   PG_DATA_ROW = 'D',
+  PG_PORTAL_SUSPENDED = 's',
+  PG_COPY_IN_RESPONSE = 'G',
+  PG_COPY_OUT_RESPONSE = 'H',
+  // Sent in both directions
+  PG_COPY_DATA = 'd',
+  PG_COPY_DONE = 'c',
   // Commands
   PG_EXECUTE_COMMAND = 'E',
   PG_SYNC_COMMAND = 'S',
@@ -80,6 +87,8 @@ enum class NetworkMessageType : unsigned char {
   PG_PARSE_COMMAND = 'P',
   PG_SIMPLE_QUERY_COMMAND = 'Q',
   PG_CLOSE_COMMAND = 'C',
+  PG_FLUSH_COMMAND = 'H',
+  PG_COPY_FAIL_COMMAND = 'f',
 
   ////////////////////////
   // ITP message types  //
@@ -143,4 +152,18 @@ enum class NetworkTransactionStateType : unsigned char {
 // postgres uses 0 for text, 1 for binary, so this is fine
 enum class FieldFormat : bool { text = false, binary = true };
 
+/**
+ * How the rows of a COPY FROM STDIN or COPY TO STDOUT are encoded in the CopyData messages exchanged with the client.
+ */
+struct CopyFormat {
+  /** text, CSV, or binary */
+  parser::ExternalFileFormat format_;
+  /** separates the columns of a row in the text and CSV formats */
+  char delimiter_;
+  /** quotes values in the CSV format */
+  char quote_;
+  /** escapes quote characters inside quoted values in the CSV format */
+  char escape_;
+};
+
 }  // namespace noisepage::network
@@ -7,6 +7,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "common/error/exception.h"
@@ -94,7 +95,7 @@ class Buffer {
   /**
    * Capacity of the buffer
    */
-  const size_t capacity_ = SOCKET_BUFFER_CAPACITY;
+  size_t capacity_ = SOCKET_BUFFER_CAPACITY;
 
   /**
    * Actual character buffer where bytes are held
@@ -107,10 +108,13 @@ class Buffer {
 };
 
 // Helper method for reading nul-terminated string for the read buffer
-static std::string ReadCString(ByteBuf::const_iterator begin, ByteBuf::const_iterator end) {
+static std::string_view ReadCString(ByteBuf::const_iterator begin, ByteBuf::const_iterator end) {
+  if (begin == end) throw NETWORK_PROCESS_EXCEPTION("Expected nil in read buffer, none found");
+  const auto *const head = reinterpret_cast<const char *>(&*begin);
+  const auto len = static_cast<size_t>(end - begin);
   // search for the nul terminator
-  for (auto head = begin; head != end; ++head)
-    if (*head == 0) return std::string(begin, head);
+  const auto *const nul = static_cast<const char *>(std::memchr(head, 0, len));
+  if (nul != nullptr) return std::string_view(head, static_cast<size_t>(nul - head));
   // No nul terminator found
   throw NETWORK_PROCESS_EXCEPTION("Expected nil in read buffer, none found");
 }
@@ -134,7 +138,7 @@ class ReadBufferView {
    * @param dest Desired memory location to read into
    */
   void Read(size_t bytes, void *dest) {
-    std::copy(begin_ + offset_, begin_ + offset_ + bytes, reinterpret_cast<uchar *>(dest));
+    if (bytes > 0) std::memcpy(dest, &*(begin_ + offset_), bytes);
     offset_ += bytes;
   }
 
@@ -192,23 +196,44 @@ class ReadBufferView {
    * if no nul-terminator is found within packet range.
    * @return string at head of read buffer
    */
-  std::string ReadString() {
-    std::string result = ReadCString(begin_ + offset_, begin_ + size_);
+  std::string ReadString() { return std::string(ReadStringView()); }
+
+  /**
+   * Read a not nul-terminated string off the read buffer of specified length
+   * @return string at head of read buffer
+   */
+  std::string ReadString(size_t len) { return std::string(ReadStringView(len)); }
+
+  /**
+   * Read a nul-terminated string off the read buffer without copying it, or throw an exception if no nul-terminator is
+   * found within packet range.
+   * @return view of the string at head of read buffer, valid as long as the underlying read buffer is not modified
+   */
+  std::string_view ReadStringView() {
+    const auto result = ReadCString(begin_ + offset_, begin_ + size_);
     // extra byte of nul-terminator
     offset_ += result.size() + 1;
     return result;
   }
 
   /**
-   * Read a not nul-terminated string off the read buffer of specified length
-   * @return string at head of read buffer
+   * Read a not nul-terminated string of specified length off the read buffer without copying it.
+   * @param len length of the string
+   * @return view of the string at head of read buffer, valid as long as the underlying read buffer is not modified
    */
-  std::string ReadString(size_t len) {
-    std::string result(begin_ + offset_, begin_ + offset_ + len);
+  std::string_view ReadStringView(size_t len) {
+    if (offset_ + len > size_) throw NETWORK_PROCESS_EXCEPTION("String length exceeds the packet.");
+    if (len == 0) return {};
+    const std::string_view result(reinterpret_cast<const char *>(&*(begin_ + offset_)), len);
     offset_ += len;
     return result;
   }
 
+  /**
+   * @return number of bytes of the view that have not been read yet
+   */
+  size_t BytesAvailable() const { return size_ - offset_; }
+
   /**
    * Read a value of type T off of the buffer, advancing cursor by appropriate
    * amount. Does NOT convert from network bytes order. It is the caller's
@@ -236,7 +261,32 @@ class ReadBuffer : public Buffer {
   /**
    * Instantiates a new buffer and reserve capacity many bytes.
    */
-  explicit ReadBuffer(size_t capacity = SOCKET_BUFFER_CAPACITY) : Buffer(capacity) {}
+  explicit ReadBuffer(size_t capacity = SOCKET_BUFFER_CAPACITY) : Buffer(capacity), initial_capacity_(capacity) {}
+
+  /**
+   * Grow the buffer so that a message larger than its capacity can be read in place, rather than being copied piece by
+   * piece into a separate buffer. Unread bytes are moved to the head of the buffer. This invalidates all views into
+   * the buffer.
+   * @param capacity number of bytes that have to fit into the buffer starting from the cursor
+   */
+  void Reserve(const size_t capacity) {
+    MoveContentToHead();
+    if (capacity <= capacity_) return;
+    buf_.resize(capacity);
+    capacity_ = capacity;
+  }
+
+  /**
+   * Release the memory of a grown buffer once all its bytes were consumed, so that idle connections keep only the
+   * initial capacity around.
+   */
+  void ShrinkIfEmpty() {
+    if (capacity_ == initial_capacity_ || HasMore()) return;
+    Reset();
+    buf_.resize(initial_capacity_);
+    buf_.shrink_to_fit();
+    capacity_ = initial_capacity_;
+  }
 
   /**
    * Read as many bytes as possible using Posix from an fd
@@ -313,10 +363,13 @@ class ReadBuffer : public Buffer {
    * @return The read string
    */
   std::string ReadString() {
-    std::string result = ReadCString(buf_.begin() + offset_, buf_.begin() + size_);
+    std::string result(ReadCString(buf_.begin() + offset_, buf_.begin() + size_));
     offset_ += result.size() + 1;
     return result;
   }
+
+ private:
+  const size_t initial_capacity_;
 };
 
 /**
@@ -399,9 +452,17 @@ class WriteQueue {
   WriteQueue() { Reset(); }
 
   /**
-   * Reset the write queue to its default state.
+   * Reset the write queue to its default state. Up to MAX_SPARE_BUFFERS of the buffers beyond the first are kept for
+   * the next responses, so that a connection that regularly sends large results does not reallocate them every time.
    */
   void Reset() {
+    while (buffers_.size() > 1) {
+      if (spare_buffers_.size() < MAX_SPARE_BUFFERS) {
+        buffers_.back()->Reset();
+        spare_buffers_.emplace_back(std::move(buffers_.back()));
+      }
+      buffers_.pop_back();
+    }
     buffers_.resize(1);
     offset_ = 0;
     flush_ = false;
@@ -411,6 +472,11 @@ class WriteQueue {
       buffers_[0]->Reset();
   }
 
+  /**
+   * @return The number of buffers that are kept for reuse, beyond the one that is always held.
+   */
+  size_t NumSpareBuffers() const { return spare_buffers_.size(); }
+
   /**
    * @return The head of the WriteQueue
    */
@@ -455,7 +521,12 @@ class WriteQueue {
       // Only write partially if we are allowed to
       size_t written = breakup ? tail.RemainingCapacity() : 0;
       tail.AppendRaw(src, written);
-      buffers_.push_back(std::make_unique<WriteBuffer>());
+      if (spare_buffers_.empty()) {
+        buffers_.push_back(std::make_unique<WriteBuffer>());
+      } else {
+        buffers_.push_back(std::move(spare_buffers_.back()));
+        spare_buffers_.pop_back();
+      }
       BufferWriteRaw(reinterpret_cast<const uchar *>(src) + written, len - written);
     }
   }
@@ -474,9 +545,14 @@ class WriteQueue {
     BufferWriteRaw(&val, sizeof(T), breakup);
   }
 
+  /** The maximum number of buffers beyond the first that are kept for reuse. */
+  static constexpr size_t MAX_SPARE_BUFFERS = 4;
+
  private:
   friend class PacketWriter;
   std::vector<std::unique_ptr<WriteBuffer>> buffers_;
+  // Empty buffers kept by Reset() for reuse
+  std::vector<std::unique_ptr<WriteBuffer>> spare_buffers_;
   size_t offset_ = 0;
   bool flush_ = false;
 };
@@ -485,10 +561,6 @@ class WriteQueue {
  * Encapsulates an input packet
  */
 struct InputPacket {
-  ~InputPacket() {
-    if (extended_) delete buf_;
-  }
-
   /**
    * Type of message this packet encodes
    */
@@ -500,7 +572,7 @@ struct InputPacket {
   size_t len_ = 0;
 
   /**
-   * ReadBuffer containing this packet's contents
+   * ReadBuffer containing this packet's contents, which is always the I/O layer's buffer
    */
   ReadBuffer *buf_;
 
@@ -509,22 +581,14 @@ struct InputPacket {
    */
   bool header_parsed_ = false;
 
-  /**
-   * Whether or not this packet's buffer was extended
-   */
-  bool extended_ = false;
-
   /**
    * Clears the packet's contents
    */
   virtual void Clear() {
     msg_type_ = NetworkMessageType::NULL_COMMAND;
     len_ = 0;
-
-    if (extended_) delete buf_;
     buf_ = nullptr;
     header_parsed_ = false;
-    extended_ = false;
   }
 };
 
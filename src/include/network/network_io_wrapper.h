@@ -60,9 +60,10 @@ class NetworkIoWrapper {
   Transition Close();
 
   /**
-   * @brief Restarts this IOWrapper
+   * @brief Restarts this IOWrapper on a new connection, keeping its buffers
+   * @param sock_fd The socket file descriptor of the new connection
    */
-  void Restart();
+  void Restart(int sock_fd);
 
   /**
    * @return The socket file descriptor this IOWrapper communicates on
@@ -81,7 +82,7 @@ class NetworkIoWrapper {
 
  private:
   // The file descriptor associated with this NetworkIoWrapper
-  const int sock_fd_;
+  int sock_fd_;
   // The ReadBuffer associated with this NetworkIoWrapper
   std::unique_ptr<ReadBuffer> in_;
   // The WriteQueue associated with this NetworkIoWrapper
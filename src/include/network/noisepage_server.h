@@ -3,6 +3,7 @@
 #include <condition_variable>  // NOLINT
 #include <mutex>               // NOLINT
 #include <string>
+#include <vector>
 
 #include "common/dedicated_thread_owner.h"
 
@@ -10,19 +11,34 @@ namespace noisepage::network {
 
 class ConnectionDispatcherTask;
 class ConnectionHandleFactory;
+class ExecutionWorkerPool;
 class ProtocolInterpreterProvider;
 
 // The name is based on https://www.postgresql.org/docs/9.3/runtime-config-connection.html
 constexpr std::string_view UNIX_DOMAIN_SOCKET_FORMAT_STRING = "{0}/.s.PGSQL.{1}";
 
-/** TerrierServer is the entry point to the network layer. */
+/**
+ * TerrierServer is the entry point to the network layer.
+ *
+ * Connections are accepted by one or more ConnectionDispatcherTasks (acceptors), each of which owns a share of the
+ * connection handler threads. Every acceptor listens on a networked socket of its own, bound to the same port with
+ * SO_REUSEPORT, so that the kernel spreads incoming connections across the acceptors and a connection storm is not
+ * serialized behind a single accept loop. The Unix domain socket cannot be shared out that way, so every acceptor
+ * watches the one Unix domain socket, and whichever acceptor gets to a connection first hands it to its handlers.
+ */
 class TerrierServer : public common::DedicatedThreadOwner {
  public:
-  /** @brief Construct a new TerrierServer instance. */
+  /**
+   * @brief Construct a new TerrierServer instance.
+   * @param acceptor_count The number of threads that accept connections, at most connection_thread_count.
+   * @param execution_pool The pool that the connection handles execute queries on, nullptr if they execute inline.
+   *                       It is drained when the server stops, before the handler threads that it wakes up go away.
+   */
   TerrierServer(common::ManagedPointer<ProtocolInterpreterProvider> protocol_provider,
                 common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory,
                 common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry, uint16_t port,
-                uint16_t connection_thread_count, std::string socket_directory);
+                uint16_t connection_thread_count, std::string socket_directory, uint16_t acceptor_count = 1,
+                common::ManagedPointer<ExecutionWorkerPool> execution_pool = nullptr);
 
   /** @brief Destructor. */
   ~TerrierServer() override = default;
@@ -45,6 +61,9 @@ class TerrierServer : public common::DedicatedThreadOwner {
   /** @return The network port that the server is listening on. */
   uint16_t GetPort() const { return port_; }
 
+  /** @return The number of threads that accept connections. */
+  uint16_t GetAcceptorCount() const { return acceptor_count_; }
+
  private:
   // TODO(Matt): somewhere there's probably a stronger assertion to be made about the state of the server and if
   // threads can be safely taken away, but I don't understand the networking stuff well enough to say for sure what
@@ -52,8 +71,9 @@ class TerrierServer : public common::DedicatedThreadOwner {
   bool OnThreadRemoval(common::ManagedPointer<common::DedicatedThreadTask> task) override { return true; }
   enum SocketType { UNIX_DOMAIN_SOCKET, NETWORKED_SOCKET };
 
+  /** @return The file descriptor of a new socket of the given type that is listening for connections. */
   template <SocketType type>
-  void RegisterSocket();
+  int RegisterSocket();
 
   std::mutex running_mutex_;
   bool running_;
@@ -61,17 +81,20 @@ class TerrierServer : public common::DedicatedThreadOwner {
 
   /** The port number of the server. */
   uint16_t port_;
-  /** The networked socket file descriptor that the server is listening on. */
-  int network_socket_fd_ = -1;
+  /** The networked socket file descriptors that the server is listening on, one per acceptor. */
+  std::vector<int> network_socket_fds_;
   /** The unix-based local socket file descriptor that the server may be listening on. */
   int unix_domain_socket_fd_ = -1;
   /** The directory to store the Unix domain socket. */
   const std::string socket_directory_;
   /** The maximum number of connections to the server. */
   const uint32_t max_connections_;
+  /** The number of threads that accept connections. */
+  const uint16_t acceptor_count_;
 
   common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory_;
   common::ManagedPointer<ProtocolInterpreterProvider> provider_;
-  common::ManagedPointer<ConnectionDispatcherTask> dispatcher_task_;
+  std::vector<common::ManagedPointer<ConnectionDispatcherTask>> dispatcher_tasks_;
+  common::ManagedPointer<ExecutionWorkerPool> execution_pool_;
 };
 }  // namespace noisepage::network
@@ -41,6 +41,15 @@ class PacketWriter {
    */
   void WriteType(NetworkMessageType type) { queue_->BufferWriteRawValue(type); }
 
+  /**
+   * Make sure what was written so far is sent to the client once the current message is processed, even if the message
+   * does not normally flush its response
+   */
+  void ForceFlush() { queue_->ForceFlush(); }
+
+  /** @return the WriteQueue this writer writes to */
+  common::ManagedPointer<WriteQueue> GetWriteQueue() const { return queue_; }
+
   /**
    * Write out a packet with a single type
    * @param type Type of message to write out
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "common/managed_pointer.h"
+#include "network/postgres/portal_execution.h"
 #include "network/postgres/postgres_defs.h"
 #include "network/postgres/statement.h"
 #include "parser/expression/constant_value_expression.h"
@@ -70,10 +71,30 @@ class Portal {
     return common::ManagedPointer(&params_);
   }
 
+  /**
+   * @return execution of the portal's query that the client fetches from with a row limit, nullptr if there is none
+   */
+  common::ManagedPointer<PortalExecution> Execution() const { return common::ManagedPointer(execution_); }
+
+  /**
+   * @param execution execution of the portal's query that the client fetches from with a row limit
+   */
+  void SetExecution(std::unique_ptr<PortalExecution> &&execution) { execution_ = std::move(execution); }
+
+  /**
+   * Stops the query of a portal that is suspended in the middle of its result. This has to happen before the
+   * transaction the query runs in ends.
+   */
+  void CloseExecution() {
+    if (execution_ != nullptr) execution_->Close();
+  }
+
  private:
   const common::ManagedPointer<network::Statement> statement_;
   std::vector<parser::ConstantValueExpression> params_;
   const std::vector<FieldFormat> result_formats_;
+  // Destroyed first, which stops the query before the parameters it may still read go away
+  std::unique_ptr<PortalExecution> execution_;
 };
 
 }  // namespace noisepage::network
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <utility>
+
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "network/execution_worker_pool.h"
+#include "network/postgres/postgres_packet_writer.h"
+#include "traffic_cop/traffic_cop_defs.h"
+
+namespace noisepage::network {
+
+/**
+ * Runs the query of a portal that the client fetches a limited number of rows at a time, with Execute messages that
+ * set a row limit.
+ *
+ * The execution engine runs a query to completion once it started, so the query runs as a blocking task of the
+ * ExecutionWorkerPool, which bounds the number of such queries. The OutputWriter asks the execution for
+ * permission before it writes rows, and that thread blocks once the client got as many rows as it asked for. The
+ * query is resumed by the next Execute message, so only the rows of one Execute are ever buffered, no matter how large
+ * the result is.
+ *
+ * The thread that processes the client's messages and the thread that runs the query take turns, so they never touch
+ * the connection's transaction at the same time.
+ */
+class PortalExecution : public ExecutionWorkerPool::BlockingTask {
+ public:
+  /**
+   * Runs the query, writing its rows with the given writer, and returns the result of the query. The execution has to
+   * be handed to the OutputWriter, which calls AwaitRows().
+   */
+  using Runner = std::function<trafficcop::TrafficCopResult(common::ManagedPointer<PostgresPacketWriter>,
+                                                            common::ManagedPointer<PortalExecution>)>;
+
+  /**
+   * The query is started by the first Fetch().
+   * @param write_queue write queue of the connection, which the rows are written to
+   * @param runner runs the query
+   * @param execution_pool pool that runs the query
+   */
+  PortalExecution(common::ManagedPointer<WriteQueue> write_queue, Runner runner,
+                  common::ManagedPointer<ExecutionWorkerPool> execution_pool)
+      : writer_(write_queue), runner_(std::move(runner)), execution_pool_(execution_pool) {}
+
+  /** Stops the query if it is still running. */
+  ~PortalExecution() override { Close(); }
+
+  DISALLOW_COPY_AND_MOVE(PortalExecution);
+
+  /**
+   * Let the query write up to max_rows more rows, and wait until it wrote them or finished.
+   * @param max_rows maximum number of rows to write, 0 for no limit
+   * @param[out] num_rows number of rows that were written
+   * @return the result of the query if it finished, or nullopt if it is suspended until the next Fetch(). An error if
+   *         the portal was closed, or if the pool had no thread left to start the query on.
+   */
+  std::optional<trafficcop::TrafficCopResult> Fetch(uint32_t max_rows, uint32_t *num_rows);
+
+  /**
+   * Stops the query if it is still running, and waits for it to return. Rows the query would have written from now on
+   * are dropped.
+   */
+  void Close();
+
+  /**
+   * Called by the OutputWriter on the thread of the query before it writes rows. Blocks while the execution is
+   * suspended.
+   * @param num_rows number of rows the OutputWriter wants to write
+   * @return number of rows it may write, at least one, or 0 if the portal was closed or may not resume, and the query
+   *         has to stop
+   */
+  uint32_t AwaitRows(uint32_t num_rows);
+
+  /**
+   * Sets hooks that run on the thread of the query around a suspension, e.g., to give back what the query holds while
+   * it waits for the client. They are only called while the runner runs.
+   * @param on_suspend called before the query suspends
+   * @param on_resume called before a suspended query goes on, returns false if the query has to stop instead
+   */
+  void SetSuspendHooks(std::function<void()> on_suspend, std::function<bool()> on_resume) {
+    on_suspend_ = std::move(on_suspend);
+    on_resume_ = std::move(on_resume);
+  }
+
+  /** @return true if the portal was closed, which makes a query that did not finish stop early */
+  bool IsClosed() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return closed_;
+  }
+
+ private:
+  // ExecutionWorkerPool::BlockingTask
+  void Run() override;
+  void Cancel() override;
+  void Finished() override;
+
+  PostgresPacketWriter writer_;
+  const Runner runner_;
+  const common::ManagedPointer<ExecutionWorkerPool> execution_pool_;
+  // Only touched by the thread of the query
+  std::function<void()> on_suspend_;
+  std::function<bool()> on_resume_;
+
+  mutable std::mutex mutex_;
+  // Signalled when the query may write more rows or has to stop, and when it suspended or finished
+  std::condition_variable cv_;
+  // Rows the query may still write before it suspends
+  uint32_t remaining_rows_ = 0;
+  // Rows written since the last Fetch()
+  uint32_t fetched_rows_ = 0;
+  bool suspended_ = false;
+  bool closed_ = false;
+  bool started_ = false;
+  // Whether the pool or the thread that ran the query is done with the execution
+  bool finished_ = false;
+  std::optional<trafficcop::TrafficCopResult> result_;
+};
+
+}  // namespace noisepage::network
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "execution/sql/runtime_types.h"
+
+namespace noisepage::network {
+
+/**
+ * Converts SQL values between their internal representation and Postgres' binary format, for the types whose binary
+ * form is not just the value in network byte order.
+ *
+ * Postgres counts dates and timestamps from 2000-01-01, while the execution engine counts them from the start of the
+ * Julian calendar. NUMERIC parameters arrive as base-10000 digits with a weight and a scale (see numeric_send() in
+ * Postgres).
+ */
+class PostgresBinaryFormatter {
+ public:
+  /** Julian day of 2000-01-01, the day that Postgres counts binary dates and timestamps from. */
+  static constexpr int64_t POSTGRES_EPOCH_JDATE = 2451545;
+
+  /**
+   * @param value date to convert
+   * @return days since 2000-01-01, the binary form of a Postgres date
+   */
+  static int32_t DateToPostgres(const execution::sql::Date value) {
+    return static_cast<int32_t>(static_cast<int64_t>(value.ToNative()) - POSTGRES_EPOCH_JDATE);
+  }
+
+  /**
+   * @param days days since 2000-01-01
+   * @return the date
+   */
+  static execution::sql::Date DateFromPostgres(const int32_t days) {
+    return execution::sql::Date::FromNative(static_cast<execution::sql::Date::NativeType>(days + POSTGRES_EPOCH_JDATE));
+  }
+
+  /**
+   * @param value timestamp to convert
+   * @return microseconds since 2000-01-01 00:00:00, the binary form of a Postgres timestamp
+   */
+  static int64_t TimestampToPostgres(const execution::sql::Timestamp value) {
+    return static_cast<int64_t>(value.ToNative()) - POSTGRES_EPOCH_JDATE * execution::sql::K_MICRO_SECONDS_PER_DAY;
+  }
+
+  /**
+   * @param micros microseconds since 2000-01-01 00:00:00
+   * @return the timestamp
+   */
+  static execution::sql::Timestamp TimestampFromPostgres(const int64_t micros) {
+    return execution::sql::Timestamp::FromNative(static_cast<execution::sql::Timestamp::NativeType>(
+        micros + POSTGRES_EPOCH_JDATE * execution::sql::K_MICRO_SECONDS_PER_DAY));
+  }
+
+  /**
+   * Read a NUMERIC in Postgres' binary format.
+   * @param bytes the binary form, without the length that precedes it in a message
+   * @return the closest double, NaN for the NUMERIC NaN
+   * @throw NetworkProcessException if the bytes are not a valid NUMERIC
+   */
+  static double ParseNumeric(std::string_view bytes);
+};
+
+}  // namespace noisepage::network
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "network/network_defs.h"
+#include "parser/expression/constant_value_expression.h"
+#include "type/type_id.h"
+
+namespace noisepage::network {
+
+/**
+ * Decodes the rows a client streams to COPY FROM STDIN in CopyData messages.
+ *
+ * Clients split the data into CopyData messages wherever they like, so a row may start in one message and end in a
+ * later one. The reader decodes every complete row of a message right away and only keeps the incomplete tail until
+ * the next message arrives, which means the data of a COPY is never buffered in full.
+ */
+class PostgresCopyReader {
+ public:
+  /** A decoded row, with one value for each column the COPY fills in. */
+  using Row = std::vector<parser::ConstantValueExpression>;
+
+  /**
+   * @param format format of the data sent by the client
+   * @param column_types types of the columns the COPY fills in, in the order the values come in
+   */
+  PostgresCopyReader(const CopyFormat &format, std::vector<type::TypeId> column_types)
+      : format_(format), column_types_(std::move(column_types)) {}
+
+  /**
+   * @param type column type
+   * @param format format of the data
+   * @return true if values of the type can be read in the format
+   */
+  static bool SupportsType(type::TypeId type, parser::ExternalFileFormat format);
+
+  /**
+   * Decode the rows that a CopyData message completes.
+   * @param data payload of the CopyData message
+   * @param[out] rows complete rows are appended here
+   * @throw NetworkProcessException if the data is malformed
+   * @throw ConversionException if a value is not valid for its column
+   */
+  void Consume(std::string_view data, std::vector<Row> *rows);
+
+  /**
+   * Decode what is left once the client sent CopyDone. The last line of text and CSV data does not need a line ending.
+   * @param[out] rows complete rows are appended here
+   * @throw NetworkProcessException if the data is malformed or ends in the middle of a row
+   * @throw ConversionException if a value is not valid for its column
+   */
+  void Finish(std::vector<Row> *rows);
+
+ private:
+  // Each returns the number of bytes of input it decoded. When done is false, a trailing incomplete row is left alone.
+  size_t Decode(std::string_view input, bool done, std::vector<Row> *rows);
+  size_t DecodeText(std::string_view input, bool done, std::vector<Row> *rows);
+  size_t DecodeCsv(std::string_view input, bool done, std::vector<Row> *rows);
+  bool DecodeCsvRow(std::string_view input, bool done, size_t *pos, Row *row);
+  size_t DecodeBinary(std::string_view input, std::vector<Row> *rows);
+
+  // Converts the text of the next value of a row that already has num_values values
+  parser::ConstantValueExpression TextValue(std::string_view text, size_t num_values) const;
+  void CheckColumnCount(size_t num_values) const;
+
+  const CopyFormat format_;
+  const std::vector<type::TypeId> column_types_;
+  // Incomplete row carried over to the next CopyData message
+  std::string pending_;
+  // Scratch space for values that contain escapes
+  std::string value_;
+  bool header_read_ = false;
+  // The end-of-data marker was seen, anything after it is ignored
+  bool end_of_data_ = false;
+};
+
+}  // namespace noisepage::network
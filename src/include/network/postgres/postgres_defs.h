@@ -30,6 +30,21 @@ constexpr std::string_view POSTGRES_BOOLEAN_STR_TRUE = "t";
  */
 constexpr std::string_view POSTGRES_BOOLEAN_STR_FALSE = "f";
 
+/**
+ * How the text format of COPY spells NULL
+ */
+constexpr std::string_view POSTGRES_COPY_TEXT_NULL = "\\N";
+
+/**
+ * A line of COPY FROM STDIN data in the text or CSV format that ends the data
+ */
+constexpr std::string_view POSTGRES_COPY_END_OF_DATA = "\\.";
+
+/**
+ * Start of the binary format of COPY, followed by 32 bits of flags and the length of a header extension
+ */
+constexpr std::string_view POSTGRES_COPY_BINARY_SIGNATURE{"PGCOPY\n\377\r\n\0", 11};
+
 /**
  * Hardcoded server parameter values to send to the client
  */
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "common/managed_pointer.h"
@@ -46,6 +47,14 @@ class PostgresPacketUtil {
   static parser::ConstantValueExpression TextValueToInternalValue(common::ManagedPointer<ReadBufferView> read_buffer,
                                                                   int32_t size, type::TypeId type);
 
+  /**
+   * Converts a text value that is not NULL to a ConstantValueExpression for that type
+   * @param text text representation of the value
+   * @param type internal type of the value
+   * @return ConstantValueExpression containing the value
+   */
+  static parser::ConstantValueExpression TextValueToInternalValue(std::string_view text, type::TypeId type);
+
   /**
    * Given a read buffer that starts at a binary value, consumes it and returns a ConstantValueExpression for that type
    * @param read_buffer incoming postgres packet with next field as a value
@@ -56,6 +65,15 @@ class PostgresPacketUtil {
   static parser::ConstantValueExpression BinaryValueToInternalValue(common::ManagedPointer<ReadBufferView> read_buffer,
                                                                     int32_t size, type::TypeId type);
 
+  /**
+   * Converts a binary value that is not NULL to a ConstantValueExpression for that type
+   * @param bytes binary representation of the value, in network byte order
+   * @param type internal type of the value
+   * @return ConstantValueExpression containing the value
+   * @throw NetworkProcessException if the number of bytes does not match the type
+   */
+  static parser::ConstantValueExpression BinaryValueToInternalValue(std::string_view bytes, type::TypeId type);
+
   /**
    * Given a read buffer that starts at the parameter types for a Parse message, reads the values out
    * @param read_buffer incoming postgres packet with next fields as parameter types
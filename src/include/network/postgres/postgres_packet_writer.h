@@ -18,6 +18,20 @@ class ErrorData;
 }
 
 namespace noisepage::network {
+
+/**
+ * Location and wire format of one column of the tuples in an OutputBuffer. A batch of DataRows is serialized from a
+ * layout that is computed once per query, instead of re-aligning every column of every row.
+ */
+struct DataRowColumn {
+  /** type of the column */
+  type::TypeId type_;
+  /** offset of the column's execution::sql::Val within the tuple */
+  uint32_t offset_;
+  /** format in which the column is sent to the client */
+  FieldFormat format_;
+};
+
 /**
  * Wrapper around an I/O layer WriteQueue to provide Postgres-specific
  * helper methods.
@@ -63,6 +77,11 @@ class PostgresPacketWriter : public PacketWriter {
    */
   void WriteNoData();
 
+  /**
+   * Writes a portal suspended response, which ends an Execute that reached its row limit before the end of the result
+   */
+  void WritePortalSuspended();
+
   /**
    * Writes parameter description (used in Describe command)
    * @param param_types The types of the parameters in the statement
@@ -177,22 +196,90 @@ class PostgresPacketWriter : public PacketWriter {
   void WriteDataRow(const byte *tuple, const std::vector<planner::OutputSchema::Column> &columns,
                     const std::vector<FieldFormat> &field_formats);
 
+  /**
+   * Write a batch of data rows from the execution engine back to the client. Prefer this over WriteDataRow for result
+   * sets: the layout is computed once, and values are formatted without any heap allocation.
+   * @param tuples pointer to the start of the first row
+   * @param num_tuples number of rows in the batch
+   * @param tuple_size distance in bytes between consecutive rows
+   * @param layout columns of the rows, see ComputeDataRowLayout
+   */
+  void WriteDataRows(const byte *tuples, uint32_t num_tuples, uint32_t tuple_size,
+                     const std::vector<DataRowColumn> &layout);
+
+  /**
+   * Compute where each column lives in the tuples produced by the execution engine and in which format it is sent.
+   * @param columns OutputSchema describing the tuple
+   * @param field_formats formats for the attributes to write, either one per column or a single one for all columns
+   * @return layout to pass to WriteDataRows
+   */
+  static std::vector<DataRowColumn> ComputeDataRowLayout(const std::vector<planner::OutputSchema::Column> &columns,
+                                                         const std::vector<FieldFormat> &field_formats);
+
+  /**
+   * Tells the client to start sending the rows of a COPY FROM STDIN in CopyData messages.
+   * @param format encoding of the rows
+   * @param num_columns number of columns in each row
+   */
+  void WriteCopyInResponse(const CopyFormat &format, uint16_t num_columns);
+
+  /**
+   * Tells the client that the rows of a COPY TO STDOUT follow in CopyData messages. The header of the binary format is
+   * sent right away.
+   * @param format encoding of the rows
+   * @param num_columns number of columns in each row
+   */
+  void WriteCopyOutResponse(const CopyFormat &format, uint16_t num_columns);
+
+  /**
+   * Write a batch of rows from the execution engine as CopyData messages of a COPY TO STDOUT, one message per row like
+   * Postgres does.
+   * @param tuples pointer to the start of the first row
+   * @param num_tuples number of rows in the batch
+   * @param tuple_size distance in bytes between consecutive rows
+   * @param layout columns of the rows, see ComputeDataRowLayout
+   * @param format encoding of the rows
+   */
+  void WriteCopyDataRows(const byte *tuples, uint32_t num_tuples, uint32_t tuple_size,
+                         const std::vector<DataRowColumn> &layout, const CopyFormat &format);
+
+  /**
+   * Tells the client that all the rows of a COPY TO STDOUT were sent, after the trailer of the binary format.
+   * @param format encoding of the rows
+   */
+  void WriteCopyOutDone(const CopyFormat &format);
+
  private:
   template <class native_type, class val_type>
   void WriteBinaryVal(const execution::sql::Val *val, type::TypeId type);
 
-  template <class native_type, class val_type>
-  void WriteBinaryValNeedsToNative(const execution::sql::Val *val, type::TypeId type);
-
-  uint32_t WriteBinaryAttribute(const execution::sql::Val *val, type::TypeId type);
+  void WriteBinaryAttribute(const execution::sql::Val *val, type::TypeId type);
 
   /**
-   * Write a data row in Postgres' text format coming from an OutputBuffer in the execution engine. Simple Query
+   * Write an attribute in Postgres' text format coming from an OutputBuffer in the execution engine. Simple Query
    * messages always reply with text format data.
-   * @param tuple pointer to the start of the row
-   * @param columns OutputSchema describing the tuple
+   * @param val value to write
+   * @param type type of the value
+   */
+  void WriteTextAttribute(const execution::sql::Val *val, type::TypeId type);
+
+  /**
+   * Write an attribute of a row in the text or CSV format of COPY TO STDOUT, which escapes values instead of prefixing
+   * them with their length.
+   * @param val value to write
+   * @param type type of the value
+   * @param format encoding of the row
+   */
+  void WriteCopyTextAttribute(const execution::sql::Val *val, type::TypeId type, const CopyFormat &format);
+
+  /**
+   * Format a value of a type that is not a string in Postgres' text format.
+   * @param val value to format, not NULL
+   * @param type type of the value
+   * @param out destination, which must have room for PostgresTextFormatter::MAX_TEXT_LENGTH characters
+   * @return pointer one past the last character written
    */
-  uint32_t WriteTextAttribute(const execution::sql::Val *val, type::TypeId type);
+  static char *FormatTextValue(const execution::sql::Val *val, type::TypeId type, char *out);
 };
 
 }  // namespace noisepage::network
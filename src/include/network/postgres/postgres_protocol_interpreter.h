@@ -4,12 +4,14 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "loggers/network_logger.h"
 #include "network/connection_context.h"
 #include "network/connection_handle.h"
 #include "network/postgres/portal.h"
 #include "network/postgres/postgres_command_factory.h"
+#include "network/postgres/postgres_copy_reader.h"
 #include "network/postgres/postgres_network_commands.h"
 #include "network/postgres/postgres_packet_writer.h"
 #include "network/postgres/statement.h"
@@ -22,6 +24,35 @@ constexpr uint32_t INITIAL_BACKOFF_TIME = 2;
 constexpr uint32_t BACKOFF_FACTOR = 2;
 constexpr uint32_t MAX_BACKOFF_TIME = 20;
 
+/**
+ * State of a COPY FROM STDIN, from the CopyInResponse until the client sends CopyDone or CopyFail.
+ */
+struct CopyInState {
+  /** Number of decoded rows that are inserted together */
+  static constexpr size_t BATCH_SIZE = 1024;
+  /** Most rows a single execution of the INSERT takes, a power of two that divides BATCH_SIZE */
+  static constexpr size_t ROWS_PER_INSERT = 64;
+  /** Most parameters of an INSERT, which bounds the size of its code for tables with many columns */
+  static constexpr size_t MAX_PARAMS_PER_INSERT = 4096;
+
+  /** INSERT of a single row, with one parameter for every column the COPY fills in */
+  std::unique_ptr<Statement> statement_;
+  /** Portal of the single row INSERT, compiled once and run for the rows that do not fill a whole batch INSERT */
+  std::unique_ptr<Portal> portal_;
+  /** INSERT of rows_per_insert_ rows at a time, null if it would only take one */
+  std::unique_ptr<Statement> batch_statement_;
+  /** Portal of the batch INSERT, compiled once and run for every rows_per_insert_ rows */
+  std::unique_ptr<Portal> batch_portal_;
+  /** Number of rows the batch INSERT takes */
+  size_t rows_per_insert_;
+  /** Decodes the CopyData messages */
+  PostgresCopyReader reader_;
+  /** Rows that were decoded but not inserted yet */
+  std::vector<PostgresCopyReader::Row> rows_;
+  /** Number of rows inserted so far */
+  uint32_t num_rows_ = 0;
+};
+
 /**
  * Interprets the network protocol for postgres clients. Any state/logic that is Postgres protocol-specific should live
  * at this layer.
@@ -60,6 +91,7 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
 
   /**
    * @see ProtocolIntepreter::Process
+   * Processes every complete message in the buffer, until one of them requires flushing the results to the client.
    * @param in buffer to read packets from
    * @param out buffer to send results back out on (doesn't really happen if TERMINATE is returned)
    * @param t_cop non-owning pointer to the traffic cop to pass down to the command layer
@@ -90,6 +122,20 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
    */
   void GetResult(const common::ManagedPointer<WriteQueue> out) override {}
 
+  /**
+   * Simple Query and Execute messages run queries, so they are processed on an execution worker, along with the
+   * messages pipelined behind them.
+   * @param in The ReadBuffer to read input from
+   * @return true if the next complete packet executes a query
+   */
+  bool ShouldProcessOnWorker(common::ManagedPointer<ReadBuffer> in) override;
+
+  /**
+   * @see ProtocolInterpreter::ResetForReuse
+   * Statements and portals are dropped, since they were prepared for the database and user of the previous connection.
+   */
+  void ResetForReuse() override;
+
   /**
    * Used to clear the waiting for sync, explicit txn block, and portals. Call whenever a transaction is ended.
    */
@@ -210,12 +256,48 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
     portals_[name] = std::move(portal);
   }
 
+  /**
+   * Stops the queries of the portals that are suspended in the middle of their result. Call before the transaction that
+   * the queries run in ends.
+   */
+  void ClosePortalExecutions() {
+    for (const auto &portal : portals_) portal.second->CloseExecution();
+  }
+
   /**
    * close a Portal. We don't care about return value since it's not an error to call Close on non-existent portal
    * @param name portal to be removed
    */
   void ClosePortal(const std::string &name) { portals_.erase(name); }
 
+  /**
+   * Enters the copy-in mode of a COPY FROM STDIN, in which only CopyData, CopyDone and CopyFail are expected
+   * @param copy_in state of the COPY
+   */
+  void BeginCopyIn(std::unique_ptr<CopyInState> &&copy_in) { copy_in_ = std::move(copy_in); }
+
+  /**
+   * @return state of the COPY FROM STDIN in progress, nullptr if there is none
+   */
+  common::ManagedPointer<CopyInState> GetCopyIn() const { return common::ManagedPointer(copy_in_); }
+
+  /**
+   * Leaves the copy-in mode once the COPY FROM STDIN is over, either way
+   */
+  void EndCopyIn() { copy_in_.reset(); }
+
+  /**
+   * Aborts the COPY FROM STDIN in progress. The error is sent to the client, the transaction fails and, unless it is
+   * an explicit transaction block, is rolled back, and the client is told that the server is ready for a new query.
+   * @param out packet writer to send the response with
+   * @param t_cop traffic cop to end the transaction with
+   * @param connection connection-specific state
+   * @param error why the COPY failed
+   */
+  void FailCopyIn(common::ManagedPointer<PostgresPacketWriter> out,
+                  common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                  common::ManagedPointer<ConnectionContext> connection, const common::ErrorData &error);
+
  protected:
   /**
    * @see ProtocolInterpreter::GetPacketHeaderSize
@@ -233,6 +315,10 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
   bool startup_ = true;
   bool waiting_for_sync_ = false;
   bool explicit_txn_block_ = false;
+  // true once the ConnectionHandle asked ShouldProcessOnWorker, i.e., queries are executed on execution workers
+  bool execution_offloaded_ = false;
+  // true if ShouldProcessOnWorker handed the next call to Process to an execution worker
+  bool processing_on_worker_ = false;
 
   common::ManagedPointer<PostgresCommandFactory> command_factory_;
 
@@ -244,6 +330,15 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
   // name to portal
   std::unordered_map<std::string, std::unique_ptr<network::Portal>> portals_;
 
+  // COPY FROM STDIN in progress, if any
+  std::unique_ptr<CopyInState> copy_in_;
+
+  /** @return true if the current packet executes a query */
+  bool IsQueryExecution() const;
+
+  /** @return true if the current packet belongs to the data of a COPY FROM STDIN */
+  bool IsCopyInMessage() const;
+
   /**
    * close all Portals constructed from a Statement. We don't care about return value since it's not an error to call
    * Close on non-existent statement
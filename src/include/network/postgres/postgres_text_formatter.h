@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "execution/sql/runtime_types.h"
+
+namespace noisepage::network {
+
+/**
+ * Formats fixed-width SQL values into Postgres' text representation directly into a caller-provided buffer.
+ *
+ * Result sets are serialized one value at a time, so going through std::to_string or fmt::format would allocate a
+ * temporary std::string for every value sent. These routines never allocate. They produce exactly the output of the
+ * std::to_string/fmt::to_string/ToString() calls they replace, so clients see no difference.
+ */
+class PostgresTextFormatter {
+ public:
+  /** Number of bytes that is always enough for the text form of any value handled by this class. */
+  static constexpr uint32_t MAX_TEXT_LENGTH = 48;
+
+  /**
+   * Write the decimal representation of an integer.
+   * @param value value to format
+   * @param out destination, which must have room for 20 characters
+   * @return pointer one past the last character written
+   */
+  static char *FormatInteger(const int64_t value, char *out) {
+    auto magnitude = static_cast<uint64_t>(value);
+    if (value < 0) {
+      *out++ = '-';
+      magnitude = 0 - magnitude;
+    }
+
+    uint32_t num_digits = 1;
+    for (uint64_t threshold = 10; num_digits < 20 && magnitude >= threshold; threshold *= 10) num_digits++;
+
+    // Fill in the digits back to front, two at a time
+    char *const end = out + num_digits;
+    char *pos = end;
+    while (magnitude >= 100) {
+      pos -= 2;
+      WriteTwoDigits(static_cast<uint32_t>(magnitude % 100), pos);
+      magnitude /= 100;
+    }
+    if (magnitude >= 10) {
+      WriteTwoDigits(static_cast<uint32_t>(magnitude), pos - 2);
+    } else {
+      *(pos - 1) = static_cast<char>('0' + magnitude);
+    }
+    return end;
+  }
+
+  /**
+   * Write the shortest representation of a double that round-trips, i.e. fmt::to_string(value).
+   * @param value value to format
+   * @param out destination, which must have room for MAX_TEXT_LENGTH characters
+   * @return pointer one past the last character written
+   */
+  static char *FormatReal(double value, char *out);
+
+  /**
+   * Write a date as YYYY-MM-DD, i.e. Date::ToString().
+   * @param value value to format
+   * @param out destination, which must have room for MAX_TEXT_LENGTH characters
+   * @return pointer one past the last character written
+   */
+  static char *FormatDate(execution::sql::Date value, char *out);
+
+  /**
+   * Write a timestamp as YYYY-MM-DD HH:MM:SS.UUUUUU, i.e. Timestamp::ToString().
+   * @param value value to format
+   * @param out destination, which must have room for MAX_TEXT_LENGTH characters
+   * @return pointer one past the last character written
+   */
+  static char *FormatTimestamp(execution::sql::Timestamp value, char *out);
+
+ private:
+  /** "00" "01" ... "99", so that two digits are produced with a single division. */
+  static constexpr std::array<char, 200> DIGIT_PAIRS = [] {
+    std::array<char, 200> pairs{};
+    for (uint32_t i = 0; i < 100; i++) {
+      pairs[2 * i] = static_cast<char>('0' + i / 10);
+      pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+  }();
+
+  static void WriteTwoDigits(const uint32_t value, char *const out) {
+    out[0] = DIGIT_PAIRS[2 * value];
+    out[1] = DIGIT_PAIRS[2 * value + 1];
+  }
+};
+
+}  // namespace noisepage::network
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -80,7 +81,7 @@ class Statement {
    * @return the optimize result of the query
    */
   common::ManagedPointer<optimizer::OptimizeResult> OptimizeResult() const {
-    return common::ManagedPointer(optimize_result_);
+    return common::ManagedPointer(optimize_result_.get());
   }
 
   /**
@@ -92,16 +93,127 @@ class Statement {
    * @return the compiled executable query
    */
   common::ManagedPointer<execution::compiler::ExecutableQuery> GetExecutableQuery() const {
-    return common::ManagedPointer(executable_query_);
+    return common::ManagedPointer(executable_query_.get());
   }
 
   /**
+   * A portal whose query is suspended in the middle of its result keeps running the plan it started with, while the
+   * statement may be planned again for a later Bind in the meantime.
+   * @return shared ownership of the optimize result, nullptr if there is none
+   */
+  std::shared_ptr<optimizer::OptimizeResult> ShareOptimizeResult() const { return optimize_result_; }
+
+  /**
+   * @see ShareOptimizeResult()
+   * @return shared ownership of the compiled executable query, nullptr if there is none
+   */
+  std::shared_ptr<execution::compiler::ExecutableQuery> ShareExecutableQuery() const { return executable_query_; }
+
+  /**
+   * Replaces the plan of the statement, dropping the code compiled for the previous plan. A generic plan that was in
+   * use is set aside for later executions.
    * @param optimize_result optimize result to take ownership of
    */
   void SetOptimizeResult(std::unique_ptr<optimizer::OptimizeResult> &&optimize_result) {
+    if (generic_plan_active_) {
+      generic_optimize_result_ = std::move(optimize_result_);
+      generic_executable_query_ = std::move(executable_query_);
+      generic_plan_active_ = false;
+    }
     optimize_result_ = std::move(optimize_result);
+    executable_query_ = nullptr;
+    plan_stale_ = false;
   }
 
+  /**
+   * Counts a plan that was optimized for the parameter values of an execution
+   * @param cost estimated cost of the plan
+   */
+  void RecordCustomPlan(double cost) {
+    num_custom_plans_++;
+    total_custom_plan_cost_ += cost;
+  }
+
+  /** @return number of plans optimized for the parameter values of an execution */
+  uint32_t GetNumCustomPlans() const { return num_custom_plans_; }
+
+  /** @return average estimated cost of the plans optimized for the parameter values of an execution */
+  double GetAverageCustomPlanCost() const {
+    return num_custom_plans_ == 0 ? 0 : total_custom_plan_cost_ / num_custom_plans_;
+  }
+
+  /**
+   * Sets the generic plan of the statement aside, to be used by UseGenericPlan()
+   * @param optimize_result plan optimized without parameter values
+   */
+  void SetGenericPlan(std::unique_ptr<optimizer::OptimizeResult> &&optimize_result) {
+    NOISEPAGE_ASSERT(!HasGenericPlan(), "The statement already has a generic plan");
+    generic_optimize_result_ = std::move(optimize_result);
+    generic_executable_query_ = nullptr;
+  }
+
+  /** @return whether the statement has a generic plan */
+  bool HasGenericPlan() const { return generic_plan_active_ || generic_optimize_result_ != nullptr; }
+
+  /** @return the generic plan of the statement, whether it is in use or set aside */
+  common::ManagedPointer<optimizer::OptimizeResult> GenericOptimizeResult() const {
+    return generic_plan_active_ ? common::ManagedPointer(optimize_result_.get())
+                                : common::ManagedPointer(generic_optimize_result_.get());
+  }
+
+  /** Makes the generic plan, and the code compiled for it, the plan of the statement */
+  void UseGenericPlan() {
+    NOISEPAGE_ASSERT(HasGenericPlan(), "The statement has no generic plan");
+    if (generic_plan_active_) return;
+    optimize_result_ = std::move(generic_optimize_result_);
+    executable_query_ = std::move(generic_executable_query_);
+    generic_plan_active_ = true;
+    plan_stale_ = false;
+  }
+
+  /** @return whether the plan of the statement is its generic plan */
+  bool IsGenericPlanActive() const { return generic_plan_active_; }
+
+  /** Records that the generic plan was estimated to be more expensive than the plans for the parameter values */
+  void RejectGenericPlan() { generic_plan_rejected_ = true; }
+
+  /** @return whether the generic plan was rejected */
+  bool IsGenericPlanRejected() const { return generic_plan_rejected_; }
+
+  /**
+   * Drops the generic plan and the history of plans for parameter values, e.g. because the plans are outdated. The
+   * statement goes back to optimizing for the parameter values of its executions.
+   */
+  void ClearGenericPlan() {
+    generic_optimize_result_ = nullptr;
+    generic_executable_query_ = nullptr;
+    generic_plan_active_ = false;
+    generic_plan_rejected_ = false;
+    num_custom_plans_ = 0;
+    total_custom_plan_cost_ = 0;
+  }
+
+  /**
+   * Marks the cached plan as one that the optimizer would no longer pick, e.g. because it was chosen based on
+   * cardinality estimates that execution proved wrong. The plan is re-optimized before its next execution.
+   */
+  void MarkPlanStale() { plan_stale_ = true; }
+
+  /**
+   * @return whether the cached plan must be re-optimized before its next execution
+   */
+  bool IsPlanStale() const { return plan_stale_; }
+
+  /**
+   * Records the memory an execution of the statement used, which the admission controller expects later executions to
+   * need as well
+   * @param bytes peak memory of the execution
+   */
+  void RecordPeakMemory(uint64_t bytes) { peak_memory_ = std::max(peak_memory_, bytes); }
+
+  /** @return largest memory (bytes) an execution of the statement used, 0 if it has not been observed */
+  uint64_t GetPeakMemory() const { return peak_memory_; }
+
   /**
    * @param executable_query executable query to take ownership of
    */
@@ -134,6 +246,8 @@ class Statement {
     optimize_result_ = nullptr;
     executable_query_ = nullptr;
     desired_param_types_ = {};
+    peak_memory_ = 0;
+    ClearGenericPlan();
   }
 
  private:
@@ -146,9 +260,22 @@ class Statement {
   // The following objects can be "cached" in Statement objects for future statement invocations. Though they don't
   // relate to the Postgres Statement concept, these objects should be compatible with future queries that match the
   // same query text. The exception to this that DDL changes can break these cached objects.
-  std::unique_ptr<optimizer::OptimizeResult> optimize_result_ = nullptr;              // generated in the Bind phase
-  std::unique_ptr<execution::compiler::ExecutableQuery> executable_query_ = nullptr;  // generated in the Execute phase
+  // The plan and its code are shared with the executions that use them, see ShareOptimizeResult()
+  std::shared_ptr<optimizer::OptimizeResult> optimize_result_ = nullptr;              // generated in the Bind phase
+  std::shared_ptr<execution::compiler::ExecutableQuery> executable_query_ = nullptr;  // generated in the Execute phase
   std::vector<type::TypeId> desired_param_types_;                                     // generated in the Bind phase
+  bool plan_stale_ = false;  // set in the Execute phase when cardinality feedback invalidated the plan
+  uint64_t peak_memory_ = 0;  // observed in the Execute phase when admission control is enabled
+
+  // Plan cache of a statement with parameters: the first executions are optimized for their parameter values (custom
+  // plans), after which a plan optimized without them (the generic plan) is used if it is about as cheap. The generic
+  // plan and its code are set aside here while a custom plan is in use.
+  std::shared_ptr<optimizer::OptimizeResult> generic_optimize_result_ = nullptr;
+  std::shared_ptr<execution::compiler::ExecutableQuery> generic_executable_query_ = nullptr;
+  bool generic_plan_active_ = false;    // whether optimize_result_ is the generic plan
+  bool generic_plan_rejected_ = false;  // whether the generic plan was too expensive
+  uint32_t num_custom_plans_ = 0;
+  double total_custom_plan_cost_ = 0;
 };
 
 }  // namespace noisepage::network
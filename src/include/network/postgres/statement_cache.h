@@ -37,6 +37,11 @@ class StatementCache {
     cache_[statement->GetQueryText()] = std::move(statement);
   }
 
+  /**
+   * Remove all Statements from the cache
+   */
+  void Clear() { cache_.clear(); }
+
  private:
   /**
    * We'll use xxHash for the keys since it's a fast hash algorithm for strings.
@@ -48,6 +48,20 @@ class ProtocolInterpreter {
    */
   virtual void GetResult(common::ManagedPointer<WriteQueue> out) = 0;
 
+  /**
+   * Decides whether the next packet should be processed on an execution worker instead of the connection handler
+   * thread. Only packets that may run for a long time, i.e., execute queries, are worth the hand-off.
+   * @param in The ReadBuffer to read input from
+   * @return true if a complete packet is buffered and processing it should be handed to an execution worker
+   */
+  virtual bool ShouldProcessOnWorker(common::ManagedPointer<ReadBuffer> in) { return false; }
+
+  /**
+   * Returns the interpreter to the state of a newly constructed one, so that it can serve the next connection. Called
+   * after Teardown() of the previous connection.
+   */
+  virtual void ResetForReuse() = 0;
+
   /**
    * Default destructor for ProtocolInterpreter
    */
@@ -93,19 +107,7 @@ class ProtocolInterpreter {
       throw NETWORK_PROCESS_EXCEPTION("Packet too large");
     }
 
-    NOISEPAGE_ASSERT(!curr_input_packet_.extended_,
-                     "InputPacket shouldn't already be extended before beginning parsing of the body.");
-
-    // Extend the buffer as needed
-    if (curr_input_packet_.len_ > in->Capacity()) {
-      // Allocate a larger buffer and copy bytes off from the I/O layer's buffer
-      curr_input_packet_.buf_ = new ReadBuffer(curr_input_packet_.len_);
-      NETWORK_LOG_TRACE("Extended Buffer size required for packet of size {0}", curr_input_packet_.len_);
-      curr_input_packet_.extended_ = true;
-    } else {
-      curr_input_packet_.buf_ = in.Get();
-    }
-
+    curr_input_packet_.buf_ = in.Get();
     curr_input_packet_.header_parsed_ = true;
     return true;
   }
@@ -118,24 +120,13 @@ class ProtocolInterpreter {
   bool TryBuildPacket(const common::ManagedPointer<ReadBuffer> in) {
     if (!TryReadPacketHeader(in)) return false;
 
-    size_t size_needed = curr_input_packet_.extended_
-                             ? curr_input_packet_.len_ - curr_input_packet_.buf_->BytesAvailable()
-                             : curr_input_packet_.len_;
-
-    size_t can_read = std::min(size_needed, in->BytesAvailable());
-    size_t remaining_bytes = size_needed - can_read;
-
-    // copy bytes only if the packet is longer than the read buffer,
-    // otherwise we can use the read buffer to save space
-    if (curr_input_packet_.extended_) {
-      NOISEPAGE_ASSERT(
-          curr_input_packet_.len_ == curr_input_packet_.buf_->Capacity(),
-          "The buffer should have been extended to support the packet length. Otherwise, there's a mismatch "
-          "between the extended_ flag.");
-      curr_input_packet_.buf_->FillBufferFrom(in, can_read);
+    // Grow the I/O layer's buffer for messages that do not fit, so that they are still read in place and commands can
+    // refer to their contents without copying them out
+    if (curr_input_packet_.len_ > in->Capacity()) {
+      NETWORK_LOG_TRACE("Growing read buffer for packet of size {0}", curr_input_packet_.len_);
+      in->Reserve(curr_input_packet_.len_);
     }
-
-    return remaining_bytes <= 0;
+    return in->HasMore(curr_input_packet_.len_);
   }
 };
 
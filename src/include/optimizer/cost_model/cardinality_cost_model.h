@@ -0,0 +1,285 @@
+#pragma once
+
+#include <cstddef>
+
+#include "common/macros.h"
+#include "optimizer/cost_model/abstract_cost_model.h"
+
+namespace noisepage::optimizer {
+
+class Group;
+class Memo;
+class GroupExpression;
+
+/**
+ * Calibration constants used by the CardinalityCostModel.
+ *
+ * All costs are expressed in abstract units per tuple (or per tuple per operation). The defaults are hand-tuned for an
+ * in-memory system: "IO" refers to touching a tuple in the table heap (sequentially or at random) and "memory" refers
+ * to materializing a tuple into an operator-private structure such as a hash table or sort buffer. The constants can be
+ * refitted from the per-tuple latencies predicted by the self-driving operating unit models (e.g., SEQ_SCAN,
+ * IDX_SCAN, HASHJOIN_BUILD, HASHJOIN_PROBE, SORT_BUILD) and passed to the cost model constructor.
+ */
+struct CostModelParameters {
+  /** Cost of producing a single output tuple */
+  double tuple_cpu_cost_ = 0.01;
+  /** Cost of processing a single index entry */
+  double index_tuple_cpu_cost_ = 0.005;
+  /** Cost of a single root-to-leaf index traversal, used when the size of the index is unknown */
+  double index_probe_cost_ = 0.02;
+  /** Cost of evaluating a single predicate or expression on a tuple */
+  double operator_cpu_cost_ = 0.0025;
+  /** Cost of reading a tuple sequentially from the table heap */
+  double seq_io_cost_ = 0.001;
+  /** Cost of reading a tuple at a random location in the table heap */
+  double random_io_cost_ = 0.004;
+  /** Cost of inserting a single tuple into a hash table */
+  double hash_build_cost_ = 0.02;
+  /** Cost of probing a hash table with a single tuple */
+  double hash_probe_cost_ = 0.01;
+  /** Cost of a single key comparison while sorting */
+  double sort_compare_cost_ = 0.005;
+  /** Cost of materializing a single tuple in memory */
+  double memory_tuple_cost_ = 0.001;
+  /** Number of rows assumed for a table that has never been analyzed */
+  size_t default_table_rows_ = 1000;
+  /** Selectivity assumed for an index key bound when no statistics are available */
+  double default_key_selectivity_ = 0.1;
+};
+
+/**
+ * Cost model driven by the cardinalities that StatsCalculator derives for every group in the memo.
+ *
+ * The cost of a GroupExpression is the local cost of its operator only; child costs are accumulated by the optimizer.
+ * The output cardinality of the expression is read from its own group, and input cardinalities are read from the
+ * groups of its children. Operators that are not costed explicitly are assumed to be free.
+ */
+class CardinalityCostModel : public AbstractCostModel {
+ public:
+  /**
+   * Constructor using the default calibration constants
+   */
+  CardinalityCostModel() = default;
+
+  /**
+   * Constructor
+   * @param params calibration constants to cost operators with
+   */
+  explicit CardinalityCostModel(const CostModelParameters &params) : params_(params) {}
+
+  /**
+   * Costs a GroupExpression
+   * @param txn TransactionContext that query is generated under
+   * @param accessor CatalogAccessor
+   * @param memo Memo object containing all relevant groups
+   * @param gexpr GroupExpression to calculate cost for
+   */
+  double CalculateCost(transaction::TransactionContext *txn, catalog::CatalogAccessor *accessor, Memo *memo,
+                       GroupExpression *gexpr) override;
+
+  /**
+   * Visit a SeqScan operator
+   * @param op operator
+   */
+  void Visit(const SeqScan *op) override;
+
+  /**
+   * Visit a IndexScan operator
+   * @param op operator
+   */
+  void Visit(const IndexScan *op) override;
+
+  /**
+   * Visit a QueryDerivedScan operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const QueryDerivedScan *op) override { output_cost_ = 0.f; }
+
+  /**
+   * Visit a OrderBy operator
+   * @param op operator
+   */
+  void Visit(const OrderBy *op) override;
+
+  /**
+   * Visit a Limit operator
+   * @param op operator
+   */
+  void Visit(const Limit *op) override;
+
+  /**
+   * Visit a InnerIndexJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerIndexJoin *op) override;
+
+  /**
+   * Visit a InnerNLJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerNLJoin *op) override;
+
+  /**
+   * Visit a LeftNLJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const LeftNLJoin *op) override { CostNLJoin(1); }
+
+  /**
+   * Visit a RightNLJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const RightNLJoin *op) override { CostNLJoin(1); }
+
+  /**
+   * Visit a OuterNLJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const OuterNLJoin *op) override { CostNLJoin(1); }
+
+  /**
+   * Visit a InnerHashJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerHashJoin *op) override;
+
+  /**
+   * Visit a LeftHashJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftHashJoin *op) override;
+
+  /**
+   * Visit a RightHashJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) override { CostHashJoin(1); }
+
+  /**
+   * Visit a OuterHashJoin operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) override { CostHashJoin(1); }
+
+  /**
+   * Visit a LeftSemiHashJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftSemiHashJoin *op) override;
+
+  /**
+   * Visit a Insert operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const Insert *op) override { output_cost_ = 0.f; }
+
+  /**
+   * Visit a InsertSelect operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const InsertSelect *op) override { CostPassThrough(); }
+
+  /**
+   * Visit a Delete operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const Delete *op) override { CostPassThrough(); }
+
+  /**
+   * Visit a Update operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const Update *op) override { CostPassThrough(); }
+
+  /**
+   * Visit a HashGroupBy operator
+   * @param op operator
+   */
+  void Visit(const HashGroupBy *op) override;
+
+  /**
+   * Visit a SortGroupBy operator
+   * @param op operator
+   */
+  void Visit(const SortGroupBy *op) override;
+
+  /**
+   * Visit a Aggregate operator
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const Aggregate *op) override { CostPassThrough(); }
+
+  /** @return the calibration constants used by this cost model */
+  const CostModelParameters &GetParameters() const { return params_; }
+
+ private:
+  /**
+   * @param group group to get the cardinality of
+   * @return estimated number of rows output by the group, or the default table size if stats were never derived
+   */
+  double GetGroupRows(Group *group) const;
+
+  /** @return estimated number of rows output by the expression being costed */
+  double GetOutputRows() const;
+
+  /**
+   * @param child_idx index of the child
+   * @return estimated number of rows output by the specified child of the expression being costed
+   */
+  double GetChildRows(size_t child_idx) const;
+
+  /** @return estimated number of rows in the base table scanned by the expression being costed */
+  double GetTableRows() const;
+
+  /**
+   * Cost a nested loop join, the right child is rescanned for every tuple of the left child.
+   * @param num_predicates number of join predicates evaluated per pair of tuples
+   */
+  void CostNLJoin(size_t num_predicates);
+
+  /**
+   * Cost a hash join, the left child is the build side and the right child is the probe side.
+   * @param num_predicates number of join predicates evaluated per matching pair of tuples
+   */
+  void CostHashJoin(size_t num_predicates);
+
+  /** Cost an operator that consumes its single child's output tuple by tuple */
+  void CostPassThrough();
+
+  /**
+   * @param num_rows number of rows to sort
+   * @param num_keys number of sort keys
+   * @return cost of sorting the rows
+   */
+  double SortCost(double num_rows, size_t num_keys) const;
+
+  /** Calibration constants */
+  CostModelParameters params_;
+
+  /**
+   * GroupExpression to cost
+   */
+  GroupExpression *gexpr_;
+
+  /**
+   * Memo table to use
+   */
+  Memo *memo_;
+
+  /**
+   * Transaction Context
+   */
+  transaction::TransactionContext *txn_;
+
+  /**
+   * Accessor
+   */
+  catalog::CatalogAccessor *accessor_;
+
+  /**
+   * Computed output cost
+   */
+  double output_cost_ = 0;
+};
+
+}  // namespace noisepage::optimizer
@@ -145,6 +145,29 @@ class Group {
    */
   size_t GetTableNumRows() const { return table_num_rows_; }
 
+  /**
+   * Set the signature that keys the cardinality feedback of this group
+   * @param signature cardinality signature
+   */
+  void SetCardinalitySignature(size_t signature) { cardinality_signature_ = signature; }
+
+  /**
+   * Gets the signature that keys the cardinality feedback of this group
+   * @returns cardinality signature, CardinalityFeedback::NO_SIGNATURE if the group does not take feedback
+   */
+  size_t GetCardinalitySignature() const { return cardinality_signature_; }
+
+  /**
+   * Set whether the number of rows of this group was taken from cardinality feedback instead of being estimated
+   * @param from_feedback whether the number of rows was observed
+   */
+  void SetCardinalityFromFeedback(bool from_feedback) { cardinality_from_feedback_ = from_feedback; }
+
+  /**
+   * @returns whether the number of rows of this group was taken from cardinality feedback
+   */
+  bool IsCardinalityFromFeedback() const { return cardinality_from_feedback_; }
+
   /**
    * Add the selectivity of a filter column (multiply selectivities for the same column, assuming conjunction AND)
    * @param column_id column ID
@@ -240,6 +263,16 @@ class Group {
    */
   size_t table_num_rows_ = UNINITIALIZED_NUM_ROWS;
 
+  /**
+   * Signature of the rows this group produces, keying its cardinality feedback (0 if it takes none)
+   */
+  size_t cardinality_signature_ = 0;
+
+  /**
+   * Whether num_rows_ was observed through cardinality feedback
+   */
+  bool cardinality_from_feedback_ = false;
+
   /**
    * Cost Lower Bound
    */
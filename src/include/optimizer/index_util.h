@@ -90,6 +90,7 @@ class IndexUtil {
 
  private:
   friend class selfdriving::OperatingUnitRecorder;
+  friend class IndexUtilTests;
 
   /**
    * Check whether predicate can take part in index computation
@@ -113,8 +114,70 @@ class IndexUtil {
       std::unordered_map<catalog::indexkeycol_oid_t, std::vector<planner::IndexExpression>> *bounds);
 
   /**
-   * Retrieves the catalog::col_oid_t equivalent for the index
-   * @requires SatisfiesBaseColumnRequirement(schema)
+   * Checks whether the conjunction of the query predicates implies the predicate of a partial index, i.e., whether
+   * every tuple the query can return is guaranteed to be in the index. An index conjunct is implied if it matches a
+   * query predicate, if it is a range over a numeric constant implied by a query predicate on the same column, or if
+   * it is "col IS NOT NULL" and a query predicate compares col against a value.
+   * @param schema Schema of a partial index
+   * @param predicates Conjunctive query predicates
+   * @param residual Query predicates that are not already guaranteed by the index predicate
+   * @returns TRUE if the index holds every tuple satisfying the predicates
+   */
+  static bool ImpliesIndexPredicate(const catalog::IndexSchema &schema,
+                                    const std::vector<AnnotatedExpression> &predicates,
+                                    std::vector<AnnotatedExpression> *residual);
+
+  /**
+   * Finds the index key column whose stored expression computes the same value as expr.
+   * This is how predicates over expressions, e.g. lower(name) = 'x', are matched to expression indexes.
+   * @param schema Index Schema
+   * @param expr Expression to look for
+   * @returns the key column, or INVALID_INDEXKEYCOL_OID if no key column is built on expr
+   */
+  static catalog::indexkeycol_oid_t MatchExpressionKey(const catalog::IndexSchema &schema,
+                                                       common::ManagedPointer<parser::AbstractExpression> expr);
+
+  /**
+   * Structural comparison of expressions that ignores aliases and table names.
+   * Column values are compared by column oid and functions by name and arguments.
+   * @param lhs Expression to compare
+   * @param rhs Expression to compare
+   * @returns TRUE if both expressions compute the same value
+   */
+  static bool ExpressionsMatch(common::ManagedPointer<const parser::AbstractExpression> lhs,
+                               common::ManagedPointer<const parser::AbstractExpression> rhs);
+
+  /**
+   * Checks whether a single query predicate implies a single conjunct of an index predicate.
+   * @param pred Query predicate
+   * @param conjunct Index predicate conjunct that does not match any query predicate
+   * @returns TRUE if every tuple satisfying pred satisfies conjunct
+   */
+  static bool ImpliesConjunct(common::ManagedPointer<const parser::AbstractExpression> pred,
+                              common::ManagedPointer<const parser::AbstractExpression> conjunct);
+
+  /**
+   * Decomposes a comparison of the form [column] op [value/parameter] or [value/parameter] op [column].
+   * @param expr Expression to decompose
+   * @param[out] col_oid Compared column
+   * @param[out] type Comparison, reversed if the column is on the right
+   * @param[out] value Value the column is compared against
+   * @returns TRUE if expr is such a comparison
+   */
+  static bool DecomposeComparison(common::ManagedPointer<const parser::AbstractExpression> expr,
+                                  catalog::col_oid_t *col_oid, parser::ExpressionType *type,
+                                  common::ManagedPointer<const parser::AbstractExpression> *value);
+
+  /**
+   * @param expr Expression to evaluate
+   * @param[out] value Value of the constant
+   * @returns TRUE if expr is a non-NULL integer or real constant
+   */
+  static bool NumericConstant(common::ManagedPointer<const parser::AbstractExpression> expr, double *value);
+
+  /**
+   * Retrieves the catalog::col_oid_t equivalent for the base column keys of the index.
+   * Key columns built on expressions are skipped.
    * @param accessor CatalogAccessor to use
    * @param tbl_oid Table the index belongs to
    * @param schema Schema
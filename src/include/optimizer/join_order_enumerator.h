@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/graph.h"
+
+namespace noisepage::optimizer {
+
+/**
+ * JoinOrderEnumerator computes a cost-based join order for a set of relations connected by inner join predicates.
+ *
+ * Relations are numbered in the order they are added and sets of relations are represented as bitmasks. Regions of up
+ * to MAX_DP_RELATIONS relations are enumerated exhaustively with DPccp (Moerkotte and Neumann, "Analysis of Two
+ * Existing and One New Dynamic Programming Algorithm for the Generation of Optimal Bushy Join Trees without Cross
+ * Products"), which only considers pairs of connected subgraphs and therefore never builds a cross product that the
+ * query does not require. Larger regions fall back to greedy operator ordering, which repeatedly joins the pair of
+ * subtrees with the smallest result.
+ *
+ * Plans are compared with the C_out cost function: the cost of a join tree is the sum of the estimated cardinalities
+ * of all of its intermediate results. The cardinality of a set of relations is the product of the base relation
+ * cardinalities and of the selectivities of all predicates that only reference relations in the set. Disconnected
+ * components of the join graph are connected with artificial cross product edges so that a complete plan always exists.
+ */
+class JoinOrderEnumerator {
+ public:
+  /** Set of relations, bit i is set if relation i is in the set */
+  using RelationSet = uint64_t;
+
+  /** Largest number of relations enumerated with dynamic programming, larger regions are ordered greedily */
+  static constexpr size_t MAX_DP_RELATIONS = 15;
+
+  /** Largest number of relations that can be ordered at all, bounded by the width of RelationSet */
+  static constexpr size_t MAX_RELATIONS = 64;
+
+  /**
+   * Adds a base relation
+   * @param num_rows estimated cardinality of the relation
+   * @return index of the relation
+   */
+  size_t AddRelation(double num_rows);
+
+  /**
+   * Adds a join predicate
+   * @param relations set of relations referenced by the predicate
+   * @param selectivity fraction of the cross product of the relations that satisfies the predicate
+   */
+  void AddPredicate(RelationSet relations, double selectivity);
+
+  /**
+   * Computes the best join tree over all relations added so far.
+   * Must be called exactly once, after all relations and predicates were added.
+   */
+  void Enumerate();
+
+  /** @return number of relations */
+  size_t GetNumRelations() const { return relation_rows_.size(); }
+
+  /** @return set containing all relations, which is the root of the best join tree */
+  RelationSet GetAllRelations() const {
+    return relation_rows_.size() == MAX_RELATIONS ? ~RelationSet{0} : (RelationSet{1} << relation_rows_.size()) - 1;
+  }
+
+  /** @return whether the join tree was found with dynamic programming (as opposed to greedily) */
+  bool UsedDynamicProgramming() const { return used_dp_; }
+
+  /**
+   * @param set set of relations that is a node of the best join tree
+   * @return set of relations joined by the left and right child of the node, both are zero for base relations
+   */
+  std::pair<RelationSet, RelationSet> GetChildren(RelationSet set) const {
+    const auto &plan = best_plans_.at(set);
+    return {plan.left_, plan.right_};
+  }
+
+  /**
+   * @param set set of relations that is a node of the best join tree
+   * @return estimated cardinality of the join of the relations
+   */
+  double GetCardinality(RelationSet set) const { return best_plans_.at(set).cardinality_; }
+
+  /**
+   * @param set set of relations that is a node of the best join tree
+   * @return C_out cost of the best join tree for the relations
+   */
+  double GetCost(RelationSet set) const { return best_plans_.at(set).cost_; }
+
+ private:
+  /** Best join tree found so far for a set of relations */
+  struct JoinPlan {
+    RelationSet left_;
+    RelationSet right_;
+    double cardinality_;
+    double cost_;
+  };
+
+  /** Builds the join graph and the neighbourhood of every relation, adding edges between disconnected components */
+  void BuildJoinGraph();
+
+  /** Renumbers relations in breadth-first order of the join graph, as required by DPccp */
+  std::vector<size_t> BreadthFirstOrder() const;
+
+  /** Runs DPccp over all relations */
+  void EnumerateDP();
+
+  /** Runs greedy operator ordering over all relations */
+  void EnumerateGreedy();
+
+  /** DPccp: enumerates all connected subgraphs reachable from set without touching the excluded relations */
+  void EnumerateCsgRec(RelationSet set, RelationSet excluded);
+
+  /** DPccp: enumerates all connected complements of a connected subgraph */
+  void EmitCsg(RelationSet set);
+
+  /** DPccp: grows the complement of a connected subgraph without touching the excluded relations */
+  void EnumerateCmpRec(RelationSet set, RelationSet complement, RelationSet excluded);
+
+  /** Considers joining the best plans of two disjoint and connected sets of relations */
+  void EmitCsgCmp(RelationSet left, RelationSet right);
+
+  /** @return all relations adjacent to at least one relation in the set, excluding the set itself */
+  RelationSet Neighbors(RelationSet set) const;
+
+  /** @return estimated cardinality of the join of all relations in the set */
+  double EstimateCardinality(RelationSet set) const;
+
+  /** Maps every set in best_plans_ from the internal (breadth-first) numbering back to the caller's numbering */
+  void RestoreNumbering(const std::vector<size_t> &order);
+
+  /** Estimated cardinality of every relation */
+  std::vector<double> relation_rows_;
+
+  /** Every predicate as the set of relations it references and its selectivity */
+  std::vector<std::pair<RelationSet, double>> predicates_;
+
+  /** Join graph, relations are vertices and there is an edge in both directions between joined relations */
+  common::Graph join_graph_;
+
+  /** Neighbourhood of every relation in the join graph */
+  std::vector<RelationSet> neighbors_;
+
+  /** Best join tree for every set of relations that was considered */
+  std::unordered_map<RelationSet, JoinPlan> best_plans_;
+
+  /** Whether the join tree was found with dynamic programming */
+  bool used_dp_ = false;
+};
+
+}  // namespace noisepage::optimizer
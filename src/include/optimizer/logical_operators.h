@@ -1281,13 +1281,15 @@ class LogicalCreateIndex : public OperatorNodeContents<LogicalCreateIndex> {
    * @param index_name Name of the index
    * @param index_attrs Attributes of the index
    * @param index_options Index options
+   * @param index_predicate Partial index predicate, nullptr if the index covers every row
    * @return
    */
   static Operator Make(catalog::db_oid_t database_oid, catalog::namespace_oid_t namespace_oid,
                        catalog::table_oid_t table_oid, parser::IndexType index_type, bool unique,
                        std::string index_name,
                        std::vector<common::ManagedPointer<parser::AbstractExpression>> index_attrs,
-                       catalog::IndexOptions index_options);
+                       catalog::IndexOptions index_options,
+                       common::ManagedPointer<parser::AbstractExpression> index_predicate = nullptr);
 
   /**
    * Copy
@@ -1338,6 +1340,11 @@ class LogicalCreateIndex : public OperatorNodeContents<LogicalCreateIndex> {
    */
   const catalog::IndexOptions &GetIndexOptions() const { return index_options_; }
 
+  /**
+   * @return partial index predicate, nullptr if the index covers every row
+   */
+  common::ManagedPointer<parser::AbstractExpression> GetIndexPredicate() const { return index_predicate_; }
+
  private:
   /**
    * OID of the database
@@ -1378,6 +1385,11 @@ class LogicalCreateIndex : public OperatorNodeContents<LogicalCreateIndex> {
    * Index options
    */
   catalog::IndexOptions index_options_;
+
+  /**
+   * Partial index predicate
+   */
+  common::ManagedPointer<parser::AbstractExpression> index_predicate_;
 };
 
 /**
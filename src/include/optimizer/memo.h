@@ -1,9 +1,12 @@
 #pragma once
 
+#include <array>
 #include <map>
 #include <unordered_set>
 #include <vector>
 
+#include "common/shared_latch.h"
+#include "common/spin_latch.h"
 #include "optimizer/group.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/operator_node.h"
@@ -41,9 +44,17 @@ struct GExprPtrEq {
 /**
  * Memo class provides for tracking Groups and GroupExpressions and provides the
  * mechanisms by which we can do duplicate group detection.
+ *
+ * The memo may be shared by optimizer tasks running on several threads. GroupExpressions are deduplicated in a hash
+ * table split into latched stripes, so that insertions of unrelated expressions rarely contend, and the vector of
+ * groups is protected by a reader-writer latch. The contents of a Group are not latched: tasks running concurrently
+ * must work on disjoint sets of groups (see ParallelGroupOptimizer).
  */
 class Memo {
  public:
+  /** Number of independently latched stripes of the GroupExpression hash table */
+  static constexpr uint32_t NUM_EXPRESSION_STRIPES = 16;
+
   /**
    * Constructor
    */
@@ -97,6 +108,7 @@ class Memo {
    * @returns Group with specified ID
    */
   Group *GetGroupByID(group_id_t id) const {
+    common::SharedLatch::ScopedSharedLatch guard(&groups_latch_);
     auto idx = id.UnderlyingValue();
     NOISEPAGE_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
     return groups_[idx];
@@ -109,12 +121,18 @@ class Memo {
    * @param group_id GroupID of Group to erase
    */
   void EraseExpression(group_id_t group_id) {
-    auto idx = group_id.UnderlyingValue();
-    NOISEPAGE_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
+    auto group = GetGroupByID(group_id);
+    auto gexpr = group->GetLogicalExpression();
+    auto &stripe = GetStripe(gexpr);
+    common::SpinLatch::ScopedSpinLatch guard(&stripe.latch_);
+    stripe.group_expressions_.erase(gexpr);
+    group->EraseLogicalExpression();
+  }
 
-    auto gexpr = groups_[idx]->GetLogicalExpression();
-    group_expressions_.erase(gexpr);
-    groups_[idx]->EraseLogicalExpression();
+  /** @return number of groups in the memo */
+  size_t GetNumGroups() const {
+    common::SharedLatch::ScopedSharedLatch guard(&groups_latch_);
+    return groups_.size();
   }
 
  private:
@@ -126,10 +144,32 @@ class Memo {
   group_id_t AddNewGroup(GroupExpression *gexpr);
 
   /**
-   * Vector of tracked GroupExpressions
-   * Group owns GroupExpressions, not the memo
+   * One stripe of the GroupExpression hash table
+   */
+  struct ExpressionStripe {
+    /** Latch protecting the stripe */
+    common::SpinLatch latch_;
+    /** Tracked GroupExpressions whose hash falls into this stripe, owned by their Group */
+    std::unordered_set<GroupExpression *, GExprPtrHash, GExprPtrEq> group_expressions_;
+  };
+
+  /**
+   * @param gexpr GroupExpression to look up
+   * @returns the stripe of the hash table that gexpr belongs to
+   */
+  ExpressionStripe &GetStripe(GroupExpression *gexpr) {
+    return expression_stripes_[GExprPtrHash()(gexpr) % NUM_EXPRESSION_STRIPES];
+  }
+
+  /**
+   * Tracked GroupExpressions, partitioned by hash
+   */
+  std::array<ExpressionStripe, NUM_EXPRESSION_STRIPES> expression_stripes_;
+
+  /**
+   * Latch protecting groups_
    */
-  std::unordered_set<GroupExpression *, GExprPtrHash, GExprPtrEq> group_expressions_;
+  mutable common::SharedLatch groups_latch_;
 
   /**
    * Vector of groups tracked
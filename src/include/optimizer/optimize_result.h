@@ -2,8 +2,11 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "catalog/catalog_defs.h"
 #include "common/managed_pointer.h"
+#include "parser/expression_defs.h"
 #include "planner/plannodes/abstract_plan_node.h"
 #include "planner/plannodes/plan_meta_data.h"
 
@@ -14,8 +17,73 @@ namespace noisepage::optimizer {
  */
 class OptimizeResult {
  public:
+  /**
+   * Selectivity that a plan assumed for a [column (operator) parameter] predicate, estimated without the parameter
+   * value for a generic plan and from the bound value for a custom plan
+   */
+  struct ParameterSelectivity {
+    /** Index of the parameter */
+    uint32_t param_idx_;
+    /** Database of the compared column */
+    catalog::db_oid_t db_oid_;
+    /** Table of the compared column */
+    catalog::table_oid_t table_oid_;
+    /** The compared column */
+    catalog::col_oid_t col_oid_;
+    /** Comparison, with the column on the left */
+    parser::ExpressionType type_;
+    /** Assumed selectivity of the predicate */
+    double selectivity_;
+  };
+
   OptimizeResult() { plan_meta_data_ = std::make_unique<planner::PlanMetaData>(); }
 
+  /**
+   * Set the estimated cost of the plan
+   * @param cost estimated cost
+   */
+  void SetCost(double cost) { cost_ = cost; }
+
+  /**
+   * @return estimated cost of the plan, as computed by the cost model it was optimized with
+   */
+  double GetCost() const { return cost_; }
+
+  /**
+   * Set the invalidation epoch of the statistics the plan was optimized with
+   * @param stats_epoch epoch observed before optimizing
+   */
+  void SetStatsEpoch(uint64_t stats_epoch) { stats_epoch_ = stats_epoch; }
+
+  /**
+   * @return invalidation epoch of the statistics the plan was optimized with, see StatsStorage::GetInvalidationEpoch
+   */
+  uint64_t GetStatsEpoch() const { return stats_epoch_; }
+
+  /**
+   * Set the number of groups that were optimized on the worker pool ahead of the serial search
+   * @param num_parallel_groups number of groups
+   */
+  void SetNumParallelGroups(size_t num_parallel_groups) { num_parallel_groups_ = num_parallel_groups; }
+
+  /**
+   * @return number of groups that were optimized on the worker pool, 0 if the plan was optimized serially
+   */
+  size_t GetNumParallelGroups() const { return num_parallel_groups_; }
+
+  /**
+   * Set the selectivities assumed for parameters
+   * @param parameter_selectivities assumed selectivities
+   */
+  void SetParameterSelectivities(std::vector<ParameterSelectivity> &&parameter_selectivities) {
+    parameter_selectivities_ = std::move(parameter_selectivities);
+  }
+
+  /**
+   * @return selectivities assumed for parameters, empty if no predicate compares a column with a parameter
+   */
+  const std::vector<ParameterSelectivity> &GetParameterSelectivities() const { return parameter_selectivities_; }
+
   /**
    * Set plan node after buildPlanNode
    * @param plan_node generated plan node
@@ -41,5 +109,9 @@ class OptimizeResult {
  private:
   std::unique_ptr<planner::AbstractPlanNode> plan_node_;
   std::unique_ptr<planner::PlanMetaData> plan_meta_data_;
+  double cost_ = 0;
+  size_t num_parallel_groups_ = 0;
+  uint64_t stats_epoch_ = 0;
+  std::vector<ParameterSelectivity> parameter_selectivities_;
 };
 }  // namespace noisepage::optimizer
@@ -22,6 +22,10 @@ namespace catalog {
 class CatalogAccessor;
 }
 
+namespace common {
+class WorkerPool;
+}  // namespace common
+
 namespace transaction {
 class TransactionContext;
 }  // namespace transaction
@@ -45,11 +49,14 @@ class Optimizer : public AbstractOptimizer {
    * Constructor for Optimizer with a cost_model
    * @param model Cost Model to use for the optimizer
    * @param task_execution_timeout time in ms to spend on a task
+   * @param worker_pool worker pool to optimize independent subtrees of a query on, nullptr to optimize serially
    */
-  explicit Optimizer(std::unique_ptr<AbstractCostModel> model, const uint64_t task_execution_timeout)
+  explicit Optimizer(std::unique_ptr<AbstractCostModel> model, const uint64_t task_execution_timeout,
+                     common::ManagedPointer<common::WorkerPool> worker_pool = nullptr)
       : cost_model_(std::move(model)),
         context_(std::make_unique<OptimizerContext>(common::ManagedPointer(cost_model_))),
-        task_execution_timeout_(task_execution_timeout) {}
+        task_execution_timeout_(task_execution_timeout),
+        worker_pool_(worker_pool) {}
 
   /**
    * Build the plan tree for query execution
@@ -58,7 +65,8 @@ class Optimizer : public AbstractOptimizer {
    * @param storage StatsStorage
    * @param query_info Information about the query
    * @param op_tree Logical operator tree for execution
-   * @param parameters parameters for the query, can be nullptr if there are no parameters
+   * @param parameters parameters for the query, nullptr if there are none or to optimize a generic plan that does not
+   *        depend on their values
    * @returns execution plan
    */
   std::unique_ptr<OptimizeResult> BuildPlanTree(
@@ -77,8 +85,9 @@ class Optimizer : public AbstractOptimizer {
    * The optimization pass includes rewriting and optimization logic.
    * @param root_group_id Group to begin optimization at
    * @param required_props Physical properties to enforce
+   * @param optimize_result result to record the number of groups optimized on the worker pool in
    */
-  void OptimizeLoop(group_id_t root_group_id, PropertySet *required_props);
+  void OptimizeLoop(group_id_t root_group_id, PropertySet *required_props, OptimizeResult *optimize_result);
 
   /**
    * Retrieve the lowest cost execution plan with the given properties
@@ -118,6 +127,7 @@ class Optimizer : public AbstractOptimizer {
   std::unique_ptr<AbstractCostModel> cost_model_;
   std::unique_ptr<OptimizerContext> context_;
   const uint64_t task_execution_timeout_;
+  common::ManagedPointer<common::WorkerPool> worker_pool_;
 };
 
 }  // namespace optimizer
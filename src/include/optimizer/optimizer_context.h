@@ -1,13 +1,17 @@
 #pragma once
 
+#include <mutex>  // NOLINT
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "common/settings.h"
+#include "common/spin_latch.h"
 #include "optimizer/cost_model/abstract_cost_model.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/memo.h"
+#include "optimizer/optimize_result.h"
 #include "optimizer/rule.h"
 #include "optimizer/statistics/stats_storage.h"
 
@@ -93,6 +97,18 @@ class OptimizerContext {
     return keys;
   }
 
+  /**
+   * Marks a group whose join order was chosen by EnumerateJoinOrder, joins in the group are no longer reassociated
+   * @param group_id ID of the group
+   */
+  void MarkJoinOrderFixed(group_id_t group_id) { fixed_join_order_groups_.insert(group_id); }
+
+  /**
+   * @param group_id ID of the group
+   * @returns whether the join order of the group was chosen by EnumerateJoinOrder
+   */
+  bool IsJoinOrderFixed(group_id_t group_id) const { return fixed_join_order_groups_.count(group_id) > 0; }
+
   /**
    * Gets the StatsStorage
    * @returns StatsStorage
@@ -101,21 +117,65 @@ class OptimizerContext {
 
   /**
    * Gets the param list
-   * @return list of param values
+   * @return list of param values, nullptr if the query is optimized without parameter values
    */
   common::ManagedPointer<std::vector<parser::ConstantValueExpression>> GetParams() { return params_; }
 
+  /**
+   * Records the selectivity assumed for a parameter, whether the query is optimized with or without parameter values.
+   * Duplicates, which arise when several groups filter on the same predicate, are recorded once.
+   * @param parameter_selectivity assumed selectivity
+   */
+  void AddParameterSelectivity(const OptimizeResult::ParameterSelectivity &parameter_selectivity) {
+    common::SpinLatch::ScopedSpinLatch guard(&parameter_selectivities_latch_);
+    for (const auto &recorded : parameter_selectivities_) {
+      if (recorded.param_idx_ == parameter_selectivity.param_idx_ &&
+          recorded.table_oid_ == parameter_selectivity.table_oid_ &&
+          recorded.col_oid_ == parameter_selectivity.col_oid_ && recorded.type_ == parameter_selectivity.type_) {
+        return;
+      }
+    }
+    parameter_selectivities_.push_back(parameter_selectivity);
+  }
+
+  /**
+   * Takes the selectivities assumed for parameters during optimization
+   * @return assumed selectivities
+   */
+  std::vector<OptimizeResult::ParameterSelectivity> TakeParameterSelectivities() {
+    common::SpinLatch::ScopedSpinLatch guard(&parameter_selectivities_latch_);
+    return std::move(parameter_selectivities_);
+  }
+
   /**
    * Adds a OptimizationContext to the tracking list
    * @param ctx OptimizationContext to add to tracking
    */
-  void AddOptimizationContext(OptimizationContext *ctx) { track_list_.push_back(ctx); }
+  void AddOptimizationContext(OptimizationContext *ctx) {
+    common::SpinLatch::ScopedSpinLatch guard(&track_list_latch_);
+    track_list_.push_back(ctx);
+  }
 
   /**
-   * Pushes a task to the task pool managed
+   * Pushes a task to the task pool managed, or to the task pool of the worker running on this thread
    * @param task Task to push
    */
-  void PushTask(OptimizerTask *task) { task_pool_->Push(task); }
+  void PushTask(OptimizerTask *task) { (worker_task_pool != nullptr ? worker_task_pool : task_pool_)->Push(task); }
+
+  /**
+   * Sets the task pool that tasks running on this thread push to, instead of the task pool of the context.
+   * Used by the workers of ParallelGroupOptimizer, which each run the tasks of one group on their own stack.
+   * @param task_pool task pool of the worker, not owned by any context, or nullptr to reset it
+   */
+  static void SetWorkerTaskPool(OptimizerTaskPool *task_pool) { worker_task_pool = task_pool; }
+
+  /**
+   * Gets the latch protecting the state that is shared by all tasks but is not thread-safe: the catalog accessor (and
+   * the catalog cache behind it) and the cost model. Tasks take it around the calls into them, so that they can run
+   * on several threads.
+   * @returns latch of the shared state
+   */
+  std::mutex &GetSharedStateLatch() { return shared_state_latch_; }
 
   /**
    * Gets the cost model
@@ -252,8 +312,16 @@ class OptimizerContext {
   StatsStorage *stats_storage_{};
   transaction::TransactionContext *txn_{};
   std::vector<OptimizationContext *> track_list_;
+  common::SpinLatch track_list_latch_;
+  std::mutex shared_state_latch_;
   std::unordered_map<catalog::table_oid_t, catalog::Schema> cte_schemas_;
+  std::unordered_set<group_id_t> fixed_join_order_groups_;
   common::ManagedPointer<std::vector<parser::ConstantValueExpression>> params_;
+  common::SpinLatch parameter_selectivities_latch_;
+  std::vector<OptimizeResult::ParameterSelectivity> parameter_selectivities_;
+
+  // Task pool of the ParallelGroupOptimizer worker running on this thread, if any
+  inline static thread_local OptimizerTaskPool *worker_task_pool = nullptr;  // NOLINT
 };
 
 }  // namespace optimizer
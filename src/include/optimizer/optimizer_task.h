@@ -36,6 +36,7 @@ enum class OptimizerTaskType {
   APPLY_RULE,
   OPTIMIZE_INPUTS,
   DERIVE_STATS,
+  ENUMERATE_JOIN_ORDER,
   REWRITE_EXPR,
   APPLY_REWIRE_RULE,
   TOP_DOWN_REWRITE,
@@ -95,6 +96,15 @@ class OptimizerTask {
   virtual ~OptimizerTask() = default;
 
  protected:
+  /**
+   * Removes the rules that reorder joins from valid_rules if the join order of the group expression
+   * was already chosen by EnumerateJoinOrder. Rules that swap the sides of a join are kept.
+   *
+   * @param group_expr The group expression the rules apply to
+   * @param valid_rules The valid rules to filter
+   */
+  void RemoveJoinReorderingRules(GroupExpression *group_expr, std::vector<RuleWithPromise> *valid_rules);
+
   /**
    * Type of the OptimizerTask
    */
@@ -371,6 +381,58 @@ class DeriveStats : public OptimizerTask {
   bool children_derived_;
 };
 
+/**
+ * EnumerateJoinOrder picks the join order of every region of consecutive inner joins below a group using a
+ * JoinOrderEnumerator, and records the resulting join tree as an alternative logical expression of the region's
+ * root group. Join associativity is then no longer explored within the region, since DPccp already considered every
+ * bushy join tree (or the region was too large to explore exhaustively). Must run after the stats of the logical
+ * plan were derived, since base relation cardinalities drive the enumeration.
+ */
+class EnumerateJoinOrder : public OptimizerTask {
+ public:
+  /** Regions with fewer relations are left to the join associativity and commutativity rules */
+  static constexpr size_t MIN_REORDER_RELATIONS = 4;
+
+  /** Cardinality assumed for a relation whose stats could not be derived */
+  static constexpr double DEFAULT_RELATION_ROWS = 1000.0;
+
+  /**
+   * Constructor for EnumerateJoinOrder
+   * @param group_id Group to reorder the joins below
+   * @param context Current optimize context
+   */
+  EnumerateJoinOrder(group_id_t group_id, OptimizationContext *context)
+      : OptimizerTask(context, OptimizerTaskType::ENUMERATE_JOIN_ORDER), group_id_(group_id) {}
+
+  /**
+   * Function to execute the task
+   */
+  void Execute() override;
+
+ private:
+  /**
+   * Collects the relations and join predicates of the region of inner joins rooted at a group
+   * @param group_id Group that is an inner join of the region
+   * @param[out] relations Groups joined by the region
+   * @param[out] predicates Join predicates of the region
+   * @param[out] joins Inner join groups of the region
+   */
+  void FlattenJoinRegion(group_id_t group_id, std::vector<group_id_t> *relations,
+                         std::vector<AnnotatedExpression> *predicates, std::vector<group_id_t> *joins);
+
+  /**
+   * Marks the inner join groups of a newly recorded join tree as having a fixed join order
+   * @param gexpr Root of the join tree
+   * @param relations Groups joined by the tree, where marking stops
+   */
+  void MarkJoinTree(GroupExpression *gexpr, const std::vector<group_id_t> &relations);
+
+  /**
+   * GroupID to reorder the joins below
+   */
+  group_id_t group_id_;
+};
+
 /**
  * TopDownRewrite performs a top-down rewrite pass. A generally held assumption for
  * any RuleSet utilizing TopDownRewrite is that once a tree level has been saturated,
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <exception>
+#include <mutex>  // NOLINT
+#include <unordered_set>
+#include <vector>
+
+#include "common/managed_pointer.h"
+#include "optimizer/optimizer_defs.h"
+
+namespace noisepage::common {
+class WorkerPool;
+}  // namespace noisepage::common
+
+namespace noisepage::optimizer {
+
+class OptimizerContext;
+
+/**
+ * Optimizes the independent subtrees of a query on a worker pool before the serial Cascades search runs on the whole
+ * query.
+ *
+ * The memo is split top-down at groups whose children cover disjoint sets of tables and share no group. Every
+ * expression that the rules derive below such a child only involves the tables of the child, so the children can be
+ * explored and costed concurrently without ever touching the same group. The split children are optimized bottom-up
+ * in waves, each by a single worker that runs OptimizeGroup for the empty property set on its own task stack, which
+ * keeps the LIFO order that the tasks rely on. The serial search then finds these groups explored and costed and only
+ * has to optimize the groups above them.
+ */
+class ParallelGroupOptimizer {
+ public:
+  /**
+   * Constructor
+   * @param context OptimizerContext whose memo is optimized
+   * @param worker_pool worker pool to run the subtrees on
+   * @param task_execution_timeout time in milliseconds after which the subtrees stop optimizing once they have a plan
+   */
+  ParallelGroupOptimizer(OptimizerContext *context, common::ManagedPointer<common::WorkerPool> worker_pool,
+                         uint64_t task_execution_timeout)
+      : context_(context), worker_pool_(worker_pool), task_execution_timeout_(task_execution_timeout) {}
+
+  /**
+   * Optimizes the independent subtrees below the root group. The root group itself is left to the serial search,
+   * since it is the only group with required properties.
+   *
+   * Like the serial search, the subtrees stop early once task_execution_timeout has passed, but only after their group
+   * has a plan. The remaining waves are then skipped, and the serial search optimizes whatever is left under its own
+   * timeout.
+   * @param root_group_id ID of the root group of the query
+   * @returns number of groups that were optimized ahead of the serial search
+   */
+  size_t Optimize(group_id_t root_group_id);
+
+ private:
+  /**
+   * Schedules the independent subtrees below a group into waves, such that every subtree runs after the subtrees
+   * below it.
+   * @param group_id ID of the group
+   * @param waves waves of groups to optimize, extended as needed
+   * @returns number of waves the subtrees below the group need
+   */
+  size_t ScheduleBelow(group_id_t group_id, std::vector<std::vector<group_id_t>> *waves) const;
+
+  /**
+   * Picks the logical expression of a group whose children can be optimized independently, preferring the one whose
+   * largest child is the smallest.
+   * @param group_id ID of the group
+   * @returns the children of the expression, empty if no expression of the group has independent children
+   */
+  std::vector<group_id_t> ChooseSplit(group_id_t group_id) const;
+
+  /**
+   * Collects the groups reachable from a group through its logical expressions.
+   * @param group_id ID of the group
+   * @param groups set to add the group and its descendants to
+   */
+  void CollectGroups(group_id_t group_id, std::unordered_set<group_id_t> *groups) const;
+
+  /**
+   * Runs one wave of groups on the worker pool and waits for all of them to finish.
+   * @param wave groups to optimize, which must be independent of each other
+   */
+  void RunWave(const std::vector<group_id_t> &wave);
+
+  /**
+   * Runs OptimizeGroup on a group, and all the tasks it spawns, on the calling thread.
+   * @param group_id ID of the group
+   */
+  void OptimizeSubtree(group_id_t group_id);
+
+  OptimizerContext *context_;
+  common::ManagedPointer<common::WorkerPool> worker_pool_;
+  const uint64_t task_execution_timeout_;
+  std::chrono::steady_clock::time_point start_time_;
+  std::atomic<bool> timed_out_{false};
+
+  std::mutex wave_latch_;
+  std::condition_variable wave_cv_;
+  size_t running_subtrees_{0};
+  std::exception_ptr error_;
+};
+
+}  // namespace noisepage::optimizer
@@ -380,9 +380,10 @@ class QueryDerivedScan : public OperatorNodeContents<QueryDerivedScan> {
 class OrderBy : public OperatorNodeContents<OrderBy> {
  public:
   /**
+   * @param num_sort_keys number of columns of the sort property this OrderBy enforces
    * @return an OrderBy operator
    */
-  static Operator Make();
+  static Operator Make(size_t num_sort_keys);
 
   /**
    * Copy
@@ -392,6 +393,17 @@ class OrderBy : public OperatorNodeContents<OrderBy> {
 
   bool operator==(const BaseOperatorNodeContents &r) override;
   common::hash_t Hash() const override;
+
+  /**
+   * @return number of columns to sort on
+   */
+  size_t GetNumSortKeys() const { return num_sort_keys_; }
+
+ private:
+  /**
+   * Number of columns to sort on
+   */
+  size_t num_sort_keys_;
 };
 
 /**
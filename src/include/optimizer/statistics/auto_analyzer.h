@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "common/managed_pointer.h"
+#include "optimizer/statistics/stats_storage.h"
+
+namespace noisepage::catalog {
+class Catalog;
+}  // namespace noisepage::catalog
+
+namespace noisepage::task {
+class TaskManager;
+}  // namespace noisepage::task
+
+namespace noisepage::transaction {
+class TransactionManager;
+}  // namespace noisepage::transaction
+
+namespace noisepage::optimizer {
+
+/**
+ * AutoAnalyzer keeps the statistics used by the optimizer fresh without manual ANALYZE statements.
+ *
+ * A table is re-analyzed once the number of tuples inserted, updated or deleted since it was last analyzed by the
+ * AutoAnalyzer exceeds threshold + scale_factor * number of tuples, which mirrors autovacuum_analyze_threshold and
+ * autovacuum_analyze_scale_factor in PostgreSQL. Only tables whose statistics are cached in StatsStorage, i.e. tables
+ * that the optimizer has planned queries over, are considered. Modifications are counted from the first invocation that
+ * sees a table, so changes made before then never trigger an ANALYZE on their own.
+ */
+class AutoAnalyzer {
+ public:
+  /**
+   * Constructor
+   * @param catalog catalog used to look up the tables
+   * @param txn_manager transaction manager used to read the catalog
+   * @param stats_storage stats storage that is invalidated after a table is analyzed
+   * @param task_manager task manager that runs the ANALYZE statements
+   * @param threshold minimum number of modified tuples before a table is analyzed
+   * @param scale_factor fraction of the tuples of a table that are added to the threshold
+   */
+  AutoAnalyzer(common::ManagedPointer<catalog::Catalog> catalog,
+               common::ManagedPointer<transaction::TransactionManager> txn_manager,
+               common::ManagedPointer<StatsStorage> stats_storage,
+               common::ManagedPointer<task::TaskManager> task_manager, uint64_t threshold, double scale_factor)
+      : catalog_(catalog),
+        txn_manager_(txn_manager),
+        stats_storage_(stats_storage),
+        task_manager_(task_manager),
+        threshold_(threshold),
+        scale_factor_(scale_factor) {}
+
+  /**
+   * Analyzes every table whose statistics are stale. Blocks until all of the ANALYZE statements have finished.
+   * @return number of tables that were analyzed successfully
+   */
+  uint32_t PerformAutoAnalyze();
+
+ private:
+  const common::ManagedPointer<catalog::Catalog> catalog_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  const common::ManagedPointer<StatsStorage> stats_storage_;
+  const common::ManagedPointer<task::TaskManager> task_manager_;
+  const uint64_t threshold_;
+  const double scale_factor_;
+
+  // Modification count of every table when the AutoAnalyzer last analyzed it
+  std::unordered_map<TableStatsKey, uint64_t> analyzed_modifications_;
+};
+
+}  // namespace noisepage::optimizer
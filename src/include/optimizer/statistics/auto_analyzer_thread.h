@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>  //NOLINT
+#include <thread>  //NOLINT
+
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "optimizer/statistics/auto_analyzer.h"
+
+namespace noisepage::optimizer {
+
+/**
+ * Class for spinning off a thread that runs the AutoAnalyzer at a fixed interval.
+ */
+class AutoAnalyzerThread {
+ public:
+  /**
+   * @param auto_analyzer pointer to the auto analyzer object to be run on this thread
+   * @param auto_analyze_period sleep time between AutoAnalyzer invocations
+   */
+  AutoAnalyzerThread(common::ManagedPointer<AutoAnalyzer> auto_analyzer, std::chrono::microseconds auto_analyze_period);
+
+  ~AutoAnalyzerThread() {
+    if (run_auto_analyze_) StopAutoAnalyze();
+  }
+
+  /**
+   * Kill the AutoAnalyzer thread.
+   */
+  void StopAutoAnalyze() {
+    NOISEPAGE_ASSERT(run_auto_analyze_, "AutoAnalyzer should already be running.");
+    run_auto_analyze_ = false;
+    auto_analyze_thread_.join();
+  }
+
+  /**
+   * Pause the AutoAnalyzer from running, typically for use in tests that rely on fixed statistics.
+   */
+  void PauseAutoAnalyze() {
+    NOISEPAGE_ASSERT(!auto_analyze_paused_, "AutoAnalyzer should not already be paused.");
+    auto_analyze_paused_ = true;
+  }
+
+  /**
+   * Resume the AutoAnalyzer after being paused.
+   */
+  void ResumeAutoAnalyze() {
+    NOISEPAGE_ASSERT(auto_analyze_paused_, "AutoAnalyzer should already be paused.");
+    auto_analyze_paused_ = false;
+  }
+
+  /**
+   * @return the underlying AutoAnalyzer object
+   */
+  common::ManagedPointer<AutoAnalyzer> GetAutoAnalyzer() { return auto_analyzer_; }
+
+ private:
+  static constexpr int64_t SHUTDOWN_CHECK_INTERVAL_US = 100000;
+
+  const common::ManagedPointer<AutoAnalyzer> auto_analyzer_;
+  volatile bool run_auto_analyze_;
+  volatile bool auto_analyze_paused_;
+  std::chrono::microseconds auto_analyze_period_;
+  std::thread auto_analyze_thread_;
+
+  void AutoAnalyzeThreadLoop() {
+    // The period is typically long, so sleep in short slices to not hold up shutdown
+    const auto slice = std::min(auto_analyze_period_, std::chrono::microseconds(SHUTDOWN_CHECK_INTERVAL_US));
+    while (run_auto_analyze_) {
+      for (std::chrono::microseconds slept{0}; run_auto_analyze_ && slept < auto_analyze_period_; slept += slice) {
+        std::this_thread::sleep_for(slice);
+      }
+      if (run_auto_analyze_ && !auto_analyze_paused_) auto_analyzer_->PerformAutoAnalyze();
+    }
+  }
+};
+
+}  // namespace noisepage::optimizer
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <deque>
+#include <optional>
+#include <unordered_map>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "common/spin_latch.h"
+
+namespace noisepage::optimizer {
+
+/**
+ * Cardinalities observed while executing plans, fed back into the cardinality estimates of later optimizations.
+ *
+ * Observations are keyed by a cardinality signature that StatsCalculator derives for a group from the tables it reads
+ * and the predicates applied to them, independently of the join order and the order of the predicates. Two queries
+ * that compute the same set of rows therefore share their observations, and a misestimate on skewed data is only
+ * made once instead of on every optimization of the query.
+ *
+ * The store is bounded by a number of entries. When it is full, the oldest signature is evicted.
+ *
+ * Every table has a version that is part of the signatures of its scans, and thus of every join above them. When the
+ * statistics of a table change, its version is bumped, so the estimates derived from the new statistics are not
+ * overridden by rows observed before. The outdated observations are never looked up again and age out of the store.
+ */
+class CardinalityFeedback {
+ public:
+  /** Default maximum number of signatures kept */
+  static constexpr size_t DEFAULT_MAX_ENTRIES = 16384;
+
+  /** Signature of a group without feedback */
+  static constexpr size_t NO_SIGNATURE = 0;
+
+  /** Estimated and actual number of rows produced for a signature */
+  struct Observation {
+    /** Number of rows the optimizer estimated */
+    size_t estimated_rows_;
+    /** Number of rows the plan actually produced the last time it ran */
+    size_t actual_rows_;
+  };
+
+  /**
+   * Constructor
+   * @param max_entries maximum number of signatures kept
+   */
+  explicit CardinalityFeedback(size_t max_entries = DEFAULT_MAX_ENTRIES) : max_entries_(max_entries) {
+    NOISEPAGE_ASSERT(max_entries > 0, "CardinalityFeedback must be able to hold a signature");
+  }
+
+  /**
+   * Records an execution of a plan node, replacing any earlier observation of the signature
+   * @param signature cardinality signature of the plan node
+   * @param estimated_rows number of rows the optimizer estimated
+   * @param actual_rows number of rows the plan node produced
+   * @return the observation the signature had before, if any
+   */
+  std::optional<Observation> Record(size_t signature, size_t estimated_rows, size_t actual_rows);
+
+  /**
+   * @param signature cardinality signature of a group
+   * @return the number of rows last observed for the signature, if any
+   */
+  std::optional<size_t> GetActualRows(size_t signature);
+
+  /** @return number of signatures with an observation */
+  size_t GetNumEntries();
+
+  /** Drops all observations */
+  void Clear();
+
+  /**
+   * @param db_oid database of the table
+   * @param table_oid table
+   * @return version of the observations of the table, to be included in the signatures of its scans
+   */
+  uint64_t GetTableVersion(catalog::db_oid_t db_oid, catalog::table_oid_t table_oid);
+
+  /**
+   * Invalidates all observations that involve a table, e.g. because ANALYZE changed its statistics
+   * @param db_oid database of the table
+   * @param table_oid table
+   */
+  void InvalidateTable(catalog::db_oid_t db_oid, catalog::table_oid_t table_oid);
+
+  /**
+   * Checks whether an estimate is off by at least the given factor in either direction. Both sides are clamped to at
+   * least one row so that estimating 0 rows for a handful of rows does not count as an infinite misestimate.
+   * @param estimated_rows number of rows the optimizer estimated
+   * @param actual_rows number of rows actually produced
+   * @param factor misestimation factor, must be at least 1
+   * @return whether the estimate is off by at least factor
+   */
+  static bool IsMisestimate(size_t estimated_rows, size_t actual_rows, double factor);
+
+ private:
+  const size_t max_entries_;
+  common::SpinLatch latch_;
+  std::unordered_map<size_t, Observation> observations_;
+  /** Signatures in the order they were first recorded, for eviction */
+  std::deque<size_t> insertion_order_;
+  /** Version of every table that has been invalidated at least once, keyed by database and table oid */
+  std::unordered_map<uint64_t, uint64_t> table_versions_;
+
+  static uint64_t TableKey(catalog::db_oid_t db_oid, catalog::table_oid_t table_oid) {
+    return static_cast<uint64_t>(db_oid.UnderlyingValue()) << 32 | table_oid.UnderlyingValue();
+  }
+};
+
+}  // namespace noisepage::optimizer
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "catalog/catalog_defs.h"
+#include "common/hash_util.h"
+#include "execution/sql/runtime_types.h"
+#include "optimizer/statistics/top_k_elements.h"
+#include "storage/storage_defs.h"
+#include "type/type_id.h"
+
+namespace noisepage::parser {
+class ConstantValueExpression;
+}  // namespace noisepage::parser
+
+namespace noisepage::optimizer {
+
+/**
+ * Extended statistics over a pair of columns of a table, used to estimate the selectivity of correlated equality
+ * predicates such as (city = 'Pittsburgh' AND zip = 15213) that the per-column statistics would assume independent.
+ *
+ * A column group stores the number of distinct (first, second) combinations and the most common combinations, both
+ * computed over the combined hash of the two values. The functional dependency degree between the two columns is
+ * derived from the number of distinct values of each column and of the pair, as in the ndistinct based dependency
+ * estimate of PostgreSQL.
+ *
+ * Column groups are stored in pg_statistic next to the column statistics, with an encoded staattnum (see
+ * EncodeGroupOid) that can never collide with the oid of a real column.
+ */
+class ColumnGroupStats {
+ public:
+  /** Flag set in the staattnum of every column group row of pg_statistic */
+  static constexpr uint32_t GROUP_OID_FLAG = 1U << 31U;
+  /** Number of bits used for each column oid in the staattnum of a column group */
+  static constexpr uint32_t GROUP_OID_BITS = 15;
+  /** Maximum number of columns of a table that column groups are collected for, resulting in up to 28 pairs */
+  static constexpr uint32_t MAX_GROUP_COLUMNS = 8;
+
+  /**
+   * Constructor
+   * @param first_column_id oid of the first column of the group, which must be smaller than second_column_id
+   * @param second_column_id oid of the second column of the group
+   * @param num_rows number of rows in the table
+   * @param non_null_rows number of rows in which neither column is null
+   * @param distinct_values number of distinct (first, second) combinations
+   * @param top_k most common combinations, keyed by CombineValueHashes
+   */
+  ColumnGroupStats(catalog::col_oid_t first_column_id, catalog::col_oid_t second_column_id, size_t num_rows,
+                   size_t non_null_rows, size_t distinct_values, std::unique_ptr<TopKElements<int64_t>> top_k)
+      : first_column_id_(first_column_id),
+        second_column_id_(second_column_id),
+        num_rows_(num_rows),
+        non_null_rows_(non_null_rows),
+        distinct_values_(distinct_values),
+        top_k_(std::move(top_k)) {
+    NOISEPAGE_ASSERT(first_column_id < second_column_id, "Column groups are ordered by column oid");
+  }
+
+  /** @return oid of the first column of the group */
+  catalog::col_oid_t GetFirstColumnID() const { return first_column_id_; }
+
+  /** @return oid of the second column of the group */
+  catalog::col_oid_t GetSecondColumnID() const { return second_column_id_; }
+
+  /** @return number of rows in the table */
+  size_t GetNumRows() const { return num_rows_; }
+
+  /** @return number of rows in which neither column is null */
+  size_t GetNonNullRows() const { return non_null_rows_; }
+
+  /** @return number of distinct (first, second) combinations */
+  size_t GetDistinctValues() const { return distinct_values_; }
+
+  /** @return most common (first, second) combinations, keyed by CombineValueHashes */
+  common::ManagedPointer<TopKElements<int64_t>> GetTopK() const { return common::ManagedPointer(top_k_); }
+
+  /**
+   * Computes the degree to which one column of the group functionally determines the other one, i.e. the fraction of
+   * the rows for which knowing the value of the determining column is enough to know the other value.
+   * @param determining_distinct_values number of distinct values of the determining column
+   * @return dependency degree between 0 and 1
+   */
+  double GetDependencyDegree(size_t determining_distinct_values) const;
+
+  /**
+   * Estimates the selectivity of (first = first_value AND second = second_value).
+   * @param value_hash combined hash of the two values, std::nullopt if the values could not be hashed
+   * @param first_selectivity selectivity of the predicate on the first column alone
+   * @param first_distinct_values number of distinct values of the first column
+   * @param second_selectivity selectivity of the predicate on the second column alone
+   * @param second_distinct_values number of distinct values of the second column
+   * @return estimated selectivity of the conjunction
+   */
+  double EstimateEqualitySelectivity(std::optional<common::hash_t> value_hash, double first_selectivity,
+                                     size_t first_distinct_values, double second_selectivity,
+                                     size_t second_distinct_values) const;
+
+  /** @return approximate memory usage of this column group in bytes, including its top-k list */
+  size_t EstimateHeapUsage() const { return sizeof(*this) + top_k_->EstimateHeapUsage(); }
+
+  /**
+   * @param first_column_id oid of one column of the group
+   * @param second_column_id oid of the other column of the group
+   * @return whether the pair of columns can be stored as a column group
+   */
+  static bool CanEncodeGroupOid(catalog::col_oid_t first_column_id, catalog::col_oid_t second_column_id) {
+    return first_column_id != second_column_id && first_column_id.UnderlyingValue() < (1U << GROUP_OID_BITS) &&
+           second_column_id.UnderlyingValue() < (1U << GROUP_OID_BITS);
+  }
+
+  /**
+   * @param first_column_id oid of one column of the group
+   * @param second_column_id oid of the other column of the group
+   * @return the staattnum under which the column group is stored in pg_statistic, independent of the column order
+   */
+  static catalog::col_oid_t EncodeGroupOid(catalog::col_oid_t first_column_id, catalog::col_oid_t second_column_id) {
+    NOISEPAGE_ASSERT(CanEncodeGroupOid(first_column_id, second_column_id), "Column oids are too large to be encoded");
+    if (second_column_id < first_column_id) std::swap(first_column_id, second_column_id);
+    return catalog::col_oid_t(GROUP_OID_FLAG | (first_column_id.UnderlyingValue() << GROUP_OID_BITS) |
+                              second_column_id.UnderlyingValue());
+  }
+
+  /** @return whether the given staattnum belongs to a column group rather than to a single column */
+  static bool IsGroupOid(catalog::col_oid_t oid) { return (oid.UnderlyingValue() & GROUP_OID_FLAG) != 0; }
+
+  /** @return the ordered column oids encoded in the given column group staattnum */
+  static std::pair<catalog::col_oid_t, catalog::col_oid_t> DecodeGroupOid(catalog::col_oid_t group_oid) {
+    NOISEPAGE_ASSERT(IsGroupOid(group_oid), "Not a column group oid");
+    constexpr uint32_t mask = (1U << GROUP_OID_BITS) - 1;
+    return {catalog::col_oid_t((group_oid.UnderlyingValue() >> GROUP_OID_BITS) & mask),
+            catalog::col_oid_t(group_oid.UnderlyingValue() & mask)};
+  }
+
+  /** @return whether column groups can be collected for columns of the given type */
+  static bool IsSupportedType(type::TypeId type);
+
+  /**
+   * Hashes a column value as it is stored in a table. Values are normalized by type family, so that an INTEGER value
+   * and a BIGINT constant with the same value hash identically.
+   * @tparam T storage type of the column
+   * @param value the value to hash
+   * @return hash of the value
+   */
+  template <typename T>
+  static common::hash_t HashValue(const T &value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      return common::HashUtil::Hash(value);
+    } else if constexpr (std::is_integral_v<T>) {
+      return common::HashUtil::Hash(static_cast<int64_t>(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+      return common::HashUtil::Hash(static_cast<double>(value));
+    } else if constexpr (std::is_same_v<T, execution::sql::Date> || std::is_same_v<T, execution::sql::Timestamp>) {
+      return common::HashUtil::Hash(value.ToNative());
+    } else {
+      static_assert(std::is_same_v<T, storage::VarlenEntry>, "Unsupported column group value type");
+      return common::HashUtil::Hash(value.StringView());
+    }
+  }
+
+  /**
+   * Hashes a constant compared against a column, consistently with HashValue on the stored values of the column.
+   * @param column_type type of the column the constant is compared against
+   * @param value the constant
+   * @return hash of the constant, std::nullopt if the constant is NULL or cannot be compared without a cast
+   */
+  static std::optional<common::hash_t> HashValue(type::TypeId column_type,
+                                                 const parser::ConstantValueExpression &value);
+
+  /** @return the hash of a (first, second) combination, given the hashes of the first and the second value */
+  static common::hash_t CombineValueHashes(common::hash_t first_hash, common::hash_t second_hash) {
+    return common::HashUtil::CombineHashes(first_hash, second_hash);
+  }
+
+ private:
+  catalog::col_oid_t first_column_id_;
+  catalog::col_oid_t second_column_id_;
+  size_t num_rows_;
+  size_t non_null_rows_;
+  size_t distinct_values_;
+  std::unique_ptr<TopKElements<int64_t>> top_k_;
+};
+
+}  // namespace noisepage::optimizer
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/managed_pointer.h"
+#include "optimizer/statistics/column_group_stats.h"
+
+namespace noisepage::execution::exec {
+class ExecutionContext;
+}  // namespace noisepage::execution::exec
+
+namespace noisepage::optimizer {
+
+/**
+ * Computes the ColumnGroupStats of the pairs of analyzed columns of a table as part of ANALYZE.
+ *
+ * The aggregates generated for ANALYZE only see one column at a time, so the column groups are computed by a separate
+ * scan over the same (possibly sampled) blocks of the table.
+ */
+class ColumnGroupStatsCollector {
+ public:
+  /** Precision of the HyperLogLog used to count the distinct combinations of a column group */
+  static constexpr int HLL_PRECISION = 12;
+
+  /**
+   * Collects the statistics of every pair among the first ColumnGroupStats::MAX_GROUP_COLUMNS analyzed columns of a
+   * supported type.
+   * @param exec_ctx execution context of the ANALYZE query, which determines the transaction and the table sample
+   * @param table_oid oid of the analyzed table
+   * @param col_oids oids of the analyzed columns
+   * @return statistics of the column groups, empty if there are less than two eligible columns
+   */
+  static std::vector<ColumnGroupStats> Collect(common::ManagedPointer<execution::exec::ExecutionContext> exec_ctx,
+                                               catalog::table_oid_t table_oid,
+                                               const std::vector<catalog::col_oid_t> &col_oids);
+};
+
+}  // namespace noisepage::optimizer
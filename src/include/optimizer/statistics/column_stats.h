@@ -71,6 +71,10 @@ class ColumnStatsBase {
    * Marks this column stat as stale
    */
   virtual void MarkStale() = 0;
+  /**
+   * @return approximate memory usage of this column stat in bytes, including its top-k list and histogram
+   */
+  virtual size_t EstimateHeapUsage() const = 0;
 };
 
 /**
@@ -246,6 +250,14 @@ class ColumnStats : public ColumnStatsBase {
    */
   void MarkStale() override { stale_ = true; }
 
+  /**
+   * @return approximate memory usage of this column stat in bytes, including its top-k list and histogram
+   */
+  size_t EstimateHeapUsage() const override {
+    return sizeof(*this) + sizeof(*top_k_) + top_k_->EstimateHeapUsage() + sizeof(*histogram_) +
+           histogram_->EstimateHeapUsage();
+  }
+
  private:
   /**
    * database oid
@@ -384,6 +384,11 @@ class Histogram {
    */
   double GetTotalValueCount() const { return std::floor(total_); }
 
+  /**
+   * @return approximate heap usage of the histogram in bytes
+   */
+  size_t EstimateHeapUsage() const { return bins_.capacity() * sizeof(Bin); }
+
   /**
    * @return the maximum number of bins that this histogram supports
    */
@@ -13,6 +13,9 @@ namespace noisepage::optimizer {
 
 static constexpr double DEFAULT_SELECTIVITY_VALUE = 0.5;
 
+/** Selectivity assumed for a range comparison against an unknown value */
+static constexpr double DEFAULT_INEQUALITY_SELECTIVITY = 1.0 / 3;
+
 /**
  * A utility class for computing the selectivity (Values satisfying a condition / Total values in column)
  * of columns based on column statistics.
@@ -40,6 +43,18 @@ class SelectivityUtil {
    */
   static double ComputeSelectivity(const TableStats &table_stats, const ValueCondition &condition);
 
+  /**
+   * Compute selectivity of comparing a column against a value that is not known yet, such as the parameter of a
+   * prepared statement. Equality assumes that every distinct value is equally frequent, while range comparisons
+   * assume that a third of the non-null values qualify.
+   * @param table_stats Table Statistics
+   * @param col_oid the compared column
+   * @param type the comparison, with the column on the left
+   * @return selectivity
+   */
+  static double ComputeGenericSelectivity(const TableStats &table_stats, catalog::col_oid_t col_oid,
+                                          parser::ExpressionType type);
+
   /**
    * Compute selectivity of a condition
    * @param column_stats Column Statistics
@@ -209,5 +224,16 @@ class SelectivityUtil {
                           UNUSED_ATTRIBUTE const ValueCondition &condition) {
     return 1 - column_stats->GetFracNull();
   }
+
+ private:
+  /**
+   * Computes the factor that scales counts taken from the top-k list or histogram of a column up to the whole column.
+   * The factor is 1 unless the summaries were built from a sample of the table.
+   * @param column_stats - column statistics
+   * @param num_summarized - number of values the summary was built from
+   * @returns scale factor
+   */
+  template <typename T>
+  static double SampleScaleFactor(common::ManagedPointer<ColumnStats<T>> column_stats, double num_summarized);
 };
 }  // namespace noisepage::optimizer
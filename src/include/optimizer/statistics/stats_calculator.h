@@ -120,6 +120,49 @@ class StatsCalculator : public OperatorVisitor {
   double CalculateSelectivityForPredicate(Group *group, const TableStats &predicate_table_stats,
                                           common::ManagedPointer<parser::AbstractExpression> expr);
 
+  /**
+   * Calculates the combined selectivity of pairs of [column = value] conjuncts whose columns have column group
+   * statistics, which account for correlations between the columns
+   * @param group The Group to calculate selectivity for
+   * @param predicate_table_stats Table Statistics
+   * @param predicates conjunction predicates
+   * @param[out] estimated set to true for every predicate that is covered by the returned selectivity
+   * @returns selectivity estimate of the covered predicates
+   */
+  double CalculateSelectivityForColumnGroups(Group *group, const TableStats &predicate_table_stats,
+                                             const std::vector<AnnotatedExpression> &predicates,
+                                             std::vector<bool> *estimated);
+
+  /**
+   * Computes the signature of the rows produced by a join, which is the same for every join order and every order of
+   * the predicates that compute them. Inner joins combine the signatures of their inputs and predicates with a
+   * commutative sum, so that nested inner joins over the same tables flatten to the same signature.
+   * @param left_group Group of the left input
+   * @param right_group Group of the right input
+   * @param predicates join predicates
+   * @param is_semi_join whether the join only keeps the rows of the left input
+   * @returns cardinality signature, CardinalityFeedback::NO_SIGNATURE if an input has none
+   */
+  size_t ComputeJoinSignature(Group *left_group, Group *right_group, const std::vector<AnnotatedExpression> &predicates,
+                              bool is_semi_join) const;
+
+  /**
+   * Sets the cardinality signature and number of rows of a group, replacing the estimate with the number of rows last
+   * observed for the signature if the plan has run before
+   * @param group The Group to set the number of rows of
+   * @param signature cardinality signature of the group
+   * @param estimated_rows number of rows estimated from the statistics
+   */
+  void SetNumRowsWithFeedback(Group *group, size_t signature, size_t estimated_rows);
+
+  /**
+   * Gets the value that a column is compared against in a predicate
+   * @param expr ConstantValueExpression or ParameterValueExpression
+   * @returns copy of the constant, or of the bound parameter; nullptr for a parameter when optimizing a generic plan
+   */
+  std::unique_ptr<parser::ConstantValueExpression> GetComparedValue(
+      common::ManagedPointer<parser::AbstractExpression> expr) const;
+
   /**
    * GroupExpression
    */
@@ -129,6 +172,12 @@ class StatsCalculator : public OperatorVisitor {
    * Metadata
    */
   OptimizerContext *context_;
+
+  /**
+   * Database and table whose predicates are being estimated
+   */
+  catalog::db_oid_t filtered_db_oid_{catalog::INVALID_DATABASE_OID};
+  catalog::table_oid_t filtered_table_oid_{catalog::INVALID_TABLE_OID};
 };
 
 }  // namespace noisepage::optimizer
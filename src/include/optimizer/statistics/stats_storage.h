@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <unordered_map>
@@ -12,6 +13,7 @@
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "common/shared_latch.h"
+#include "optimizer/statistics/cardinality_feedback.h"
 #include "optimizer/statistics/table_stats.h"
 
 namespace noisepage::optimizer {
@@ -28,38 +30,22 @@ struct TableStatsKey {
   /** table oid */
   catalog::table_oid_t table_oid_;
 };
-/** Thread safe value for cache */
-struct TableStatsValue {
+/**
+ * Immutable snapshot of the statistics of a table handed out to consumers of the cache. The snapshot stays valid for as
+ * long as the consumer holds on to it, even if the cache refreshes or evicts the table in the meantime, so no latches
+ * are held while the statistics are used.
+ */
+struct TableStatsSnapshot {
   /**
    * Constructor
-   * @param table_stats Table Statistics
+   * @param snapshot shared ownership of the table stats
    */
-  explicit TableStatsValue(TableStats table_stats) : table_stats_(std::move(table_stats)) {}
-  /** Table Statistics */
-  TableStats table_stats_;
-  /** Shared Latch for Table Statistics */
-  common::SharedLatch shared_latch_;
-};
-
-/** Thread safe value to return back to consumers of cache */
-struct LatchedTableStatsReference {
-  /**
-   * Constructor
-   * @param table_stats reference to the table stats
-   * @param table_stats_shared_latch acquired read latch on the table stats
-   * @param stats_storage_shared_latch acquired read latch on stats storage
-   */
-  explicit LatchedTableStatsReference(const TableStats &table_stats, common::SharedLatchGuard table_stats_shared_latch,
-                                      common::SharedLatchGuard stats_storage_shared_latch)
-      : table_stats_(table_stats),
-        table_stats_shared_latch_(std::move(table_stats_shared_latch)),
-        stats_storage_shared_latch_(std::move(stats_storage_shared_latch)) {}
+  explicit TableStatsSnapshot(std::shared_ptr<const TableStats> snapshot)
+      : snapshot_(std::move(snapshot)), table_stats_(*snapshot_) {}
+  /** Keeps the table statistics alive */
+  std::shared_ptr<const TableStats> snapshot_;
   /** Table Statistics */
   const TableStats &table_stats_;
-  /** Acquired Shared Latch on Table Stats */
-  common::SharedLatchGuard table_stats_shared_latch_;
-  /** Acquired Shared Latch on Stats Storage */
-  common::SharedLatchGuard stats_storage_shared_latch_;
 };
 }  // namespace noisepage::optimizer
 
@@ -102,33 +88,43 @@ struct equal_to<noisepage::optimizer::TableStatsKey> {
 
 namespace noisepage::optimizer {
 /**
- * Manages all the existing table stats objects. Stores them in an
- * unordered map and keeps track of them using their database and table oids. Can
- * add, update, or delete table stats objects from the storage map.
+ * Manages all the existing table stats objects. Caches them in an unordered map keyed by their database and table oids
+ * and loads them from the catalog on a miss.
+ *
+ * Every cached table holds an immutable TableStats snapshot. Lookups only take the cache latch in shared mode for as
+ * long as it takes to copy the snapshot pointer. When ANALYZE commits, the table is marked stale and the next lookup
+ * loads a fresh snapshot from the catalog and swaps it in, while consumers of the old snapshot keep using it.
  *
- * TODO(Joe Koshakow) Currently there is no cache eviction policy, which means that stats storage will grow forever. If
- *  this becomes an issue we can implement a max number of columns to store with some eviction policy
+ * The cache is bounded by an approximate memory budget. When it is exceeded, the least recently used tables are
+ * evicted.
  */
 class StatsStorage {
  public:
+  /** Default memory budget of the cache in bytes */
+  static constexpr uint64_t DEFAULT_MEMORY_LIMIT = 64 * 1024 * 1024;
+
   /**
-   * Returns a reference of a TableStats object for a specific table, an acquired shared latch for that TableStats
-   * object, and an acquired shared latch on the entire Stats Storage. No locking or unlocking is needed from the
-   * consumer, both latches are already acquired and will automatically unlock when they fall out of scope.
+   * Constructor
+   * @param memory_limit approximate memory budget of the cache in bytes
+   */
+  explicit StatsStorage(uint64_t memory_limit = DEFAULT_MEMORY_LIMIT) : memory_limit_(memory_limit) {}
+
+  /**
+   * Returns a snapshot of the TableStats object for a specific table, loading it from the catalog if it is not cached
+   * or stale. No locking or unlocking is needed from the consumer.
    *
    * @param database_id - oid of database
    * @param table_id - oid of table
    * @param accessor - catalog accessor
-   * @return reference to a TableStats object, an acquired shared latch for that TableStats object, and an acquired
-   * shared latch on StatsStorage
+   * @return snapshot of the TableStats object
    */
-  LatchedTableStatsReference GetTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
-                                           catalog::CatalogAccessor *accessor);
+  TableStatsSnapshot GetTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
+                                   catalog::CatalogAccessor *accessor);
 
   /**
-   * Mark column statistic objects in the cache as having stale information. Next time someone tries to retrieve this
-   * column we will get an updated version from the catalog. Columns will get stale whenever someone runs ANALYZE on
-   * them
+   * Mark the statistics of a table in the cache as having stale information. Next time someone tries to retrieve this
+   * table we will get an updated version from the catalog. Columns will get stale whenever someone runs ANALYZE on
+   * them. The cardinality feedback involving the table is invalidated as well.
    * @param database_id database oid of database containing the column
    * @param table_id table oid of table containing the column
    * @param col_ids column oids of columns to mark stale
@@ -136,42 +132,92 @@ class StatsStorage {
   void MarkStatsStale(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
                       const std::vector<catalog::col_oid_t> &col_ids);
 
+  /**
+   * @return number of times the statistics of any table were marked stale. A plan optimized while this had a different
+   *   value may have been sized after statistics that changed since.
+   */
+  uint64_t GetInvalidationEpoch() const { return invalidation_epoch_.load(std::memory_order_acquire); }
+
+  /**
+   * @return the database and table oids of every table that currently has statistics cached in StatsStorage
+   */
+  std::vector<TableStatsKey> GetTableStatsKeys();
+
+  /**
+   * @return approximate memory usage of all cached statistics in bytes
+   */
+  uint64_t GetMemoryUsage() const { return memory_usage_.load(std::memory_order_relaxed); }
+
+  /**
+   * @return cardinalities observed while executing plans, which correct the estimates derived from the statistics
+   */
+  common::ManagedPointer<CardinalityFeedback> GetCardinalityFeedback() { return common::ManagedPointer(&feedback_); }
+
  private:
+  FRIEND_TEST(StatsStorageTests, InvalidateDuringLoadTest);
+
+  /** Cached statistics of a table */
+  struct TableStatsEntry {
+    /** Current snapshot, only replaced under the exclusive cache latch */
+    std::shared_ptr<const TableStats> snapshot_;
+    /** Approximate memory usage of the snapshot */
+    uint64_t memory_usage_ = 0;
+    /** Bumped whenever the table is marked stale */
+    std::atomic<uint64_t> generation_{0};
+    /** Value of generation_ when the snapshot was loaded, the snapshot is stale if they differ */
+    uint64_t snapshot_generation_ = 0;
+    /** Value of the access clock when the table was last looked up */
+    std::atomic<uint64_t> last_access_{0};
+  };
+
   /**
-   * An unordered map mapping TableStatsKey objects (database_id and table_id) to
-   * TableStats pointers. This represents the storage for TableStats objects.
+   * An unordered map mapping TableStatsKey objects (database_id and table_id) to their cache entries. This represents
+   * the storage for TableStats objects.
    */
-  std::unordered_map<TableStatsKey, TableStatsValue> table_stats_storage_;
+  std::unordered_map<TableStatsKey, TableStatsEntry> table_stats_storage_;
 
   /**
-   * latch for reading and modifying table_stats_storage_.
+   * latch for reading and modifying table_stats_storage_. Entries are only inserted, replaced and evicted under the
+   * exclusive latch.
    */
   common::SharedLatch stats_storage_latch_;
 
+  /** Approximate memory budget of the cache in bytes */
+  const uint64_t memory_limit_;
+
+  /** Approximate memory usage of the cache in bytes */
+  std::atomic<uint64_t> memory_usage_{0};
+
+  /** Logical clock that orders lookups for LRU eviction */
+  std::atomic<uint64_t> access_clock_{0};
+
   /**
-   * Checks with StatsStorage contains stats for a certain table
-   * @param database_id - oid of database
-   * @param table_id - oid of table
-   * @return true if StatsStorage contains stats for specified table, false otherwise
+   * Bumped whenever any table is marked stale, including tables that are not cached. A table that is loaded into the
+   * cache while this changes may have been read before the invalidation, so it is installed as stale.
    */
-  bool ContainsTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id);
+  std::atomic<uint64_t> invalidation_epoch_{0};
+
+  /** Cardinalities observed while executing plans */
+  CardinalityFeedback feedback_;
 
   /**
-   * Inserts a TableStats pointer in the table stats storage map.
+   * Loads the statistics of a table from the catalog and installs them in the cache
    * @param database_id - oid of database
    * @param table_id - oid of table
-   * @param table_stats - TableStats object to be inserted
+   * @param generation - generation of the entry observed before loading, or 0 if the table was not cached
+   * @param epoch - invalidation epoch observed before loading
+   * @param accessor - catalog accessor
+   * @return the loaded snapshot
    */
-  void InsertTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
-                        catalog::CatalogAccessor *accessor);
+  std::shared_ptr<const TableStats> LoadTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
+                                                   uint64_t generation, uint64_t epoch,
+                                                   catalog::CatalogAccessor *accessor);
 
   /**
-   * Update the stale columns of a TableStats
-   * @param database_id - oid of database
-   * @param table_id - oid of table
-   * @param accessor - catalog accessor
+   * Evicts least recently used tables until the cache fits in its memory budget. Must be called while holding the
+   * exclusive cache latch.
+   * @param keep - table that must not be evicted
    */
-  static void UpdateStaleColumns(catalog::table_oid_t table_id, TableStatsValue *table_stats_value,
-                                 catalog::CatalogAccessor *accessor);
+  void EvictIfNeeded(const TableStatsKey &keep);
 };
 }  // namespace noisepage::optimizer
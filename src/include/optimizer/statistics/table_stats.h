@@ -9,6 +9,7 @@
 #include "catalog/catalog_defs.h"
 #include "common/macros.h"
 #include "common/managed_pointer.h"
+#include "optimizer/statistics/column_group_stats.h"
 #include "optimizer/statistics/column_stats.h"
 
 namespace noisepage::optimizer {
@@ -80,6 +81,27 @@ class TableStats {
    */
   void RemoveColumnStats(catalog::col_oid_t column_id);
 
+  /**
+   * Adds a ColumnGroupStats object, replacing the existing statistics of the same pair of columns
+   * @param group_stats - ColumnGroupStats object to add
+   */
+  void AddColumnGroupStats(std::unique_ptr<ColumnGroupStats> group_stats);
+
+  /**
+   * Retrieves the statistics of a pair of columns
+   * @param first_column_id - the oid of one column of the pair
+   * @param second_column_id - the oid of the other column of the pair
+   * @return the pointer to the ColumnGroupStats object, nullptr if the pair has no statistics
+   */
+  common::ManagedPointer<ColumnGroupStats> GetColumnGroupStats(catalog::col_oid_t first_column_id,
+                                                               catalog::col_oid_t second_column_id) const;
+
+  /**
+   * Gets the number of column groups with statistics in the table
+   * @return the number of column groups
+   */
+  size_t GetColumnGroupCount() const { return column_group_stats_.size(); }
+
   /**
    * Gets the number of rows in the table
    * @return the number of rows
@@ -100,6 +122,16 @@ class TableStats {
     return std::any_of(column_stats_.begin(), column_stats_.end(), [](const auto &it) { return it.second->IsStale(); });
   }
 
+  /**
+   * @return approximate memory usage of this table stat and all of its column stats in bytes
+   */
+  size_t EstimateHeapUsage() const {
+    size_t usage = sizeof(*this);
+    for (const auto &it : column_stats_) usage += it.second->EstimateHeapUsage();
+    for (const auto &it : column_group_stats_) usage += it.second->EstimateHeapUsage();
+    return usage;
+  }
+
   /**
    * Serializes a table stats object
    * @return table stats object serialized to json
@@ -131,6 +163,11 @@ class TableStats {
    * stores the ColumnStats objects for the columns in the table
    */
   std::unordered_map<catalog::col_oid_t, std::unique_ptr<ColumnStatsBase>> column_stats_;
+
+  /**
+   * stores the ColumnGroupStats objects for pairs of columns in the table, keyed by ColumnGroupStats::EncodeGroupOid
+   */
+  std::unordered_map<catalog::col_oid_t, std::unique_ptr<ColumnGroupStats>> column_group_stats_;
 };
 DEFINE_JSON_HEADER_DECLARATIONS(TableStats);
 }  // namespace noisepage::optimizer
@@ -238,6 +238,23 @@ class TopKElements {
    */
   size_t GetSize() const { return entries_.size(); }
 
+  /**
+   * @param key the key to look for
+   * @return whether the key is in the top-k list, as opposed to only being estimated by the sketch
+   */
+  bool IsTopKey(const KeyType &key) const { return entries_.find(key) != entries_.end(); }
+
+  /**
+   * @return the total count of all the keys added to the sketch, which is the number of values the top-k list
+   * summarizes
+   */
+  size_t GetTotalCount() const { return sketch_.GetTotalCount(); }
+
+  /**
+   * @return approximate heap usage of the top-k list and its sketch in bytes
+   */
+  size_t EstimateHeapUsage() const { return entries_.size() * (sizeof(KeyType) + sizeof(int64_t)) + sketch_.GetSize(); }
+
   /**
    * Generate a vector of the top-k keys sorted by their current counts
    * @return the vector of the top-k keys
@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "binder/sql_node_visitor.h"
 #include "common/managed_pointer.h"
@@ -20,18 +21,21 @@ class CopyStatement : public SQLStatement {
   /**
    * @param table table to copy from
    * @param select_stmt select statement to copy from
-   * @param file_path path to output file
+   * @param columns columns to copy, all of them if empty
+   * @param file_path path to output file, empty for STDIN or STDOUT
    * @param format file format
    * @param is_from true if FROM, false if TO
    * @param delimiter delimiter to be used for copying
    * @param quote quote character
    * @param escape escape character
    */
-  CopyStatement(std::unique_ptr<TableRef> table, std::unique_ptr<SelectStatement> select_stmt, std::string file_path,
-                ExternalFileFormat format, bool is_from, char delimiter, char quote, char escape)
+  CopyStatement(std::unique_ptr<TableRef> table, std::unique_ptr<SelectStatement> select_stmt,
+                std::vector<std::string> columns, std::string file_path, ExternalFileFormat format, bool is_from,
+                char delimiter, char quote, char escape)
       : SQLStatement(StatementType::COPY),
         table_(std::move(table)),
         select_stmt_(std::move(select_stmt)),
+        columns_(std::move(columns)),
         file_path_(std::move(file_path)),
         format_(format),
         is_from_(is_from),
@@ -49,9 +53,15 @@ class CopyStatement : public SQLStatement {
   /** @return select statement */
   common::ManagedPointer<SelectStatement> GetSelectStatement() { return common::ManagedPointer(select_stmt_); }
 
+  /** @return columns to copy, all of them if empty */
+  const std::vector<std::string> &GetColumns() const { return columns_; }
+
   /** @return file path */
   std::string GetFilePath() { return file_path_; }
 
+  /** @return true if the data is exchanged with the client (FROM STDIN or TO STDOUT) instead of a file */
+  bool IsStdio() const { return file_path_.empty(); }
+
   /** @return external file format */
   ExternalFileFormat GetExternalFileFormat() { return format_; }
 
@@ -70,6 +80,7 @@ class CopyStatement : public SQLStatement {
  private:
   const std::unique_ptr<TableRef> table_;
   const std::unique_ptr<SelectStatement> select_stmt_;
+  const std::vector<std::string> columns_;
   const std::string file_path_;
   const ExternalFileFormat format_;
 
@@ -9,6 +9,7 @@
 #include "common/error/exception.h"
 #include "loggers/parser_logger.h"
 #include "parser/expression/abstract_expression.h"
+#include "parser/parse_arena.h"
 #include "parser/parser_defs.h"
 #include "parser/select_statement.h"
 #include "parser/sql_statement.h"
@@ -19,7 +20,7 @@ namespace parser {
 /**
  * ColumnDefinition represents the logical description of a table column.
  */
-struct ColumnDefinition {
+struct ColumnDefinition : public ParseArenaObject {
   // TODO(WAN): I really hate how everything is mashed together.
   // There were also a number of unused attributes e.g. primary_keys, multi_unique...
   // that were never used.
@@ -413,16 +414,19 @@ class CreateStatement : public TableRefStatement {
    * @param index_name index name
    * @param index_attrs index attributes
    * @param index_options index options
+   * @param index_predicate partial index predicate, nullptr if the index covers every row
    */
   CreateStatement(std::unique_ptr<TableInfo> table_info, IndexType index_type, bool unique, std::string index_name,
-                  std::vector<IndexAttr> index_attrs, const catalog::IndexOptions &index_options)
+                  std::vector<IndexAttr> index_attrs, const catalog::IndexOptions &index_options,
+                  common::ManagedPointer<AbstractExpression> index_predicate = nullptr)
       : TableRefStatement(StatementType::CREATE, std::move(table_info)),
         create_type_(kIndex),
         index_type_(index_type),
         unique_index_(unique),
         index_name_(std::move(index_name)),
         index_attrs_(std::move(index_attrs)),
-        index_options_(index_options) {}
+        index_options_(index_options),
+        index_predicate_(index_predicate) {}
 
   /**
    * CREATE SCHEMA
@@ -510,6 +514,9 @@ class CreateStatement : public TableRefStatement {
   /** @return move index options for [CREATE INDEX] */
   catalog::IndexOptions &&MoveIndexOptions() { return std::move(index_options_); }
 
+  /** @return partial index predicate (WHERE clause) for [CREATE INDEX], nullptr if there is none */
+  common::ManagedPointer<AbstractExpression> GetIndexPredicate() { return index_predicate_; }
+
   /** @return true if "IF NOT EXISTS" for [CREATE SCHEMA], false otherwise */
   bool IsIfNotExists() { return if_not_exists_; }
 
@@ -551,6 +558,8 @@ class CreateStatement : public TableRefStatement {
   const std::string index_name_;
   const std::vector<IndexAttr> index_attrs_;
   catalog::IndexOptions index_options_;
+  const common::ManagedPointer<AbstractExpression> index_predicate_ =
+      common::ManagedPointer<AbstractExpression>(nullptr);
 
   // CREATE SCHEMA
   const bool if_not_exists_ = false;
@@ -9,6 +9,7 @@
 #include "common/json_header.h"
 #include "common/managed_pointer.h"
 #include "parser/expression_defs.h"
+#include "parser/parse_arena.h"
 #include "type/type_id.h"
 
 namespace noisepage::optimizer {
@@ -120,7 +121,7 @@ class AliasType {
  * TODO(WAN): So these are supposed to be dumb and immutable, but we're cheating in the binder. Figure out how to
  * document these assumptions exactly.
  */
-class AbstractExpression {
+class AbstractExpression : public ParseArenaObject {
   friend class optimizer::OptimizerUtil;
   friend class optimizer::ExpressionNodeContents;
 
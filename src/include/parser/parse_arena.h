@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "common/macros.h"
+#include "execution/util/region.h"
+
+namespace noisepage::parser {
+
+/**
+ * A ParseArena is the memory region that the parse tree nodes of one query string are allocated from. Parsing a short
+ * statement creates dozens of small statement, table reference and expression objects; taking them from a region
+ * replaces one malloc/free pair per node with a pointer bump, and keeps the nodes of a statement close together.
+ *
+ * The nodes stay owned by std::unique_ptr as before, so ownership can still be handed out of the ParseResult (e.g., to
+ * a plan or a test). The arena is therefore reference counted: the ParseResult holds one reference and every node that
+ * was allocated from the arena holds another. Deleting a node only drops its reference; the region is freed once the
+ * ParseResult and all of its nodes are gone.
+ *
+ * Allocation happens through ParseArenaObject::operator new while a ParseArena::Scope is active on the thread, which
+ * PostgresParser sets up for the duration of the transformation. Nodes that are created outside of a scope, e.g., by
+ * the binder or by deserialization, come from the heap as usual.
+ */
+class ParseArena {
+ public:
+  /**
+   * Activates an arena for the nodes allocated by the current thread, for as long as the scope lives.
+   */
+  class Scope {
+   public:
+    /**
+     * Activate the arena.
+     * @param arena arena to allocate parse tree nodes from
+     */
+    explicit Scope(ParseArena *arena) : previous_(current) { current = arena; }
+
+    /** Restore the arena that was active before. */
+    ~Scope() { current = previous_; }
+
+    DISALLOW_COPY_AND_MOVE(Scope);
+
+   private:
+    ParseArena *const previous_;
+  };
+
+  /** Create an arena, referenced by its creator. */
+  ParseArena() : region_("parse_arena") {}
+
+  DISALLOW_COPY_AND_MOVE(ParseArena);
+
+  /** Drop a reference, which frees the arena if it was the last one. */
+  void Release() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+  }
+
+  /** @return the number of bytes handed out to parse tree nodes */
+  uint64_t Allocated() const { return region_.Allocated(); }
+
+ private:
+  friend class ParseArenaObject;
+
+  ~ParseArena() = default;
+
+  /** Allocate memory for a node, which holds a reference to the arena until it is deleted. */
+  void *Allocate(const std::size_t size, const std::size_t alignment) {
+    refs_.fetch_add(1, std::memory_order_relaxed);
+    return region_.Allocate(size, alignment);
+  }
+
+  /** Arena that the current thread allocates parse tree nodes from, if any. */
+  static thread_local ParseArena *current;
+
+  execution::util::Region region_;
+  std::atomic<uint64_t> refs_{1};
+};
+
+/**
+ * Base class for parse tree nodes. Nodes allocated while a ParseArena::Scope is active come from that arena, all others
+ * from the heap. Each allocation is prefixed with the arena it came from (or nullptr), so that deleting a node through
+ * its std::unique_ptr does the right thing either way.
+ */
+class ParseArenaObject {
+ public:
+  /**
+   * Allocate a node from the current thread's arena, or from the heap if there is none.
+   * @param size size of the node
+   * @return pointer to the memory for the node
+   */
+  static void *operator new(std::size_t size);
+
+  /**
+   * Release the memory of a node.
+   * @param ptr pointer to the node's memory
+   */
+  static void operator delete(void *ptr);
+
+ private:
+  /** Size of the arena pointer in front of every node, padded to keep the node maximally aligned. */
+  static constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+};
+
+}  // namespace noisepage::parser
@@ -4,7 +4,9 @@
 #include <utility>
 #include <vector>
 
+#include "common/macros.h"
 #include "common/managed_pointer.h"
+#include "parser/parse_arena.h"
 
 namespace noisepage::parser {
 
@@ -15,9 +17,29 @@ class SQLStatement;
  * ParseResult is the parser's output to the binder. It allows you to obtain non-owning managed pointers to the
  * statements and expressions that were generated during the parse. If you need to take ownership, you can do that
  * too, but then the parse result's copy is invalidated.
+ *
+ * The nodes that the parser creates for the parse result come from its ParseArena, which lives until the parse result
+ * and all of those nodes (wherever their ownership went) are destroyed.
  */
 class ParseResult {
  public:
+  /** Create an empty parse result with its own arena. */
+  ParseResult() : arena_(new ParseArena) {}
+
+  DISALLOW_COPY_AND_MOVE(ParseResult);
+
+  /** Destroy the statements and expressions, and release the arena. */
+  ~ParseResult() {
+    statements_.clear();
+    expressions_.clear();
+    arena_->Release();
+  }
+
+  /**
+   * @return the arena that the parser allocates the nodes of this parse result from
+   */
+  ParseArena *GetArena() const { return arena_; }
+
   /**
    * @return true if no statements exist
    */
@@ -89,6 +111,7 @@ class ParseResult {
   std::vector<std::unique_ptr<AbstractExpression>> &&TakeExpressionsOwnership() { return std::move(expressions_); }
 
  private:
+  ParseArena *const arena_;
   std::vector<std::unique_ptr<SQLStatement>> statements_;
   std::vector<std::unique_ptr<AbstractExpression>> expressions_;
 };
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "common/json_header.h"
+#include "parser/parse_arena.h"
 #include "parser/sql_statement.h"
 #include "parser/table_ref.h"
 
@@ -23,7 +24,7 @@ using noisepage::parser::OrderType;
 /**
  * Describes OrderBy clause in a select statement.
  */
-class OrderByDescription {
+class OrderByDescription : public ParseArenaObject {
   // TODO(WAN): hold multiple expressions to be sorted by
 
  public:
@@ -131,7 +132,7 @@ DEFINE_JSON_HEADER_DECLARATIONS(OrderByDescription);
 /**
  * Describes the limit clause in a SELECT statement.
  */
-class LimitDescription {
+class LimitDescription : public ParseArenaObject {
  public:
   /**
    * Denotes that there is no limit.
@@ -221,7 +222,7 @@ DEFINE_JSON_HEADER_DECLARATIONS(LimitDescription);
 /**
  * Represents the sql "GROUP BY".
  */
-class GroupByDescription {
+class GroupByDescription : public ParseArenaObject {
  public:
   /**
    * @param columns group by columns
@@ -12,6 +12,7 @@
 #include "common/json_header.h"
 #include "common/macros.h"
 #include "parser/expression/abstract_expression.h"
+#include "parser/parse_arena.h"
 #include "parser/parser_defs.h"
 
 namespace noisepage {
@@ -28,7 +29,7 @@ class AbstractExpression;
 /**
  * Table location information (Database, Namespace, Table).
  */
-struct TableInfo {
+struct TableInfo : public ParseArenaObject {
   /**
    * @param table_name table name
    * @param namespace_name namespace name
@@ -114,7 +115,7 @@ DEFINE_JSON_HEADER_DECLARATIONS(TableInfo);
 /**
  * Base class for the parsed SQL statements.
  */
-class SQLStatement {
+class SQLStatement : public ParseArenaObject {
  public:
   /**
    * Create a new SQL statement.
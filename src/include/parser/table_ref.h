@@ -8,6 +8,7 @@
 #include "binder/sql_node_visitor.h"
 #include "common/json_header.h"
 #include "expression/abstract_expression.h"
+#include "parser/parse_arena.h"
 #include "parser/parser_defs.h"
 #include "parser/select_statement.h"
 
@@ -22,7 +23,7 @@ class TableRef;
 /**
  * Represents a join table.
  */
-class JoinDefinition {
+class JoinDefinition : public ParseArenaObject {
  public:
   /**
    * @param type join type
@@ -110,7 +111,7 @@ DEFINE_JSON_HEADER_DECLARATIONS(JoinDefinition);
 /**
  * Holds references to tables, either via table names or a select statement.
  */
-class TableRef {
+class TableRef : public ParseArenaObject {
  public:
   // TODO(WAN): was and is still a mess
 
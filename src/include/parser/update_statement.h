@@ -9,6 +9,7 @@
 #include "binder/sql_node_visitor.h"
 #include "common/managed_pointer.h"
 #include "expression/abstract_expression.h"
+#include "parser/parse_arena.h"
 #include "parser/sql_statement.h"
 #include "parser/table_ref.h"
 
@@ -19,7 +20,7 @@ namespace parser {
  * @struct UpdateClause
  * @brief Represents "column = value" expressions
  */
-class UpdateClause {
+class UpdateClause : public ParseArenaObject {
  public:
   /**
    * @param column column to be updated
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <unordered_map>
 #include <utility>
 
@@ -25,12 +26,17 @@ class PlanMetaData {
      * @param table_num_rows number of rows in the base table (for sequential or index scans)
      * @param filter_column_selectivities maps from column id to the selectivity on that column (multiplied
      *   with duplicates)
+     * @param cardinality_signature signature that keys the cardinality feedback of the plan node, 0 if none
+     * @param cardinality_from_feedback whether the cardinality was observed through feedback when the plan was chosen
      */
     explicit PlanNodeMetaData(size_t cardinality, size_t table_num_rows,
-                              std::unordered_map<catalog::col_oid_t, double> filter_column_selectivities)
+                              std::unordered_map<catalog::col_oid_t, double> filter_column_selectivities,
+                              size_t cardinality_signature = 0, bool cardinality_from_feedback = false)
         : cardinality_(cardinality),
           table_num_rows_(table_num_rows),
-          filter_column_selectivities_(std::move(filter_column_selectivities)) {}
+          filter_column_selectivities_(std::move(filter_column_selectivities)),
+          cardinality_signature_(cardinality_signature),
+          cardinality_from_feedback_(cardinality_from_feedback) {}
 
     /**
      * @return the output cardinality
@@ -42,6 +48,14 @@ class PlanMetaData {
      */
     size_t GetTableNumRows() const { return table_num_rows_; }
 
+    /**
+     * @return whether the number of rows in the table to scan was taken from statistics. It is 0 for tables that were
+     *   never analyzed, and the maximum size_t if the optimizer never derived it.
+     */
+    bool HasTableNumRows() const {
+      return table_num_rows_ != 0 && table_num_rows_ != std::numeric_limits<size_t>::max();
+    }
+
     /**
      * @return the number of rows in the table to scan
      */
@@ -53,10 +67,22 @@ class PlanMetaData {
       return filter_column_selectivities_.at(col_oid);
     }
 
+    /**
+     * @return the signature that keys the cardinality feedback of the plan node, 0 if none
+     */
+    size_t GetCardinalitySignature() const { return cardinality_signature_; }
+
+    /**
+     * @return whether the cardinality was observed through feedback, rather than estimated, when the plan was chosen
+     */
+    bool IsCardinalityFromFeedback() const { return cardinality_from_feedback_; }
+
    private:
     size_t cardinality_;
     size_t table_num_rows_;
     std::unordered_map<catalog::col_oid_t, double> filter_column_selectivities_;
+    size_t cardinality_signature_ = 0;
+    bool cardinality_from_feedback_ = false;
   };
 
   /**
@@ -69,6 +95,12 @@ class PlanMetaData {
     plan_node_meta_data_[plan_node_id] = meta_data;
   }
 
+  /**
+   * @param plan_node_id plan node id
+   * @return whether there is meta data for the plan node
+   */
+  bool HasPlanNodeMetaData(plan_node_id_t plan_node_id) const { return plan_node_meta_data_.count(plan_node_id) != 0; }
+
   /**
    * Get the meta data for a plan node
    * @param plan_node_id plan node id
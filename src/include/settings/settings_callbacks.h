@@ -80,6 +80,10 @@ class Callbacks {
   static void MetricsPipelineSampleRate(void *old_value, void *new_value, DBMain *db_main,
                                         common::ManagedPointer<common::ActionContext> action_context);
 
+  /** Update the metrics output type being used by the pipeline metrics. */
+  static void MetricsPipelineOutput(void *old_value, void *new_value, DBMain *db_main,
+                                    common::ManagedPointer<common::ActionContext> action_context);
+
   /** Enable or disable metrics collection for bind command. */
   static void MetricsBindCommand(void *old_value, void *new_value, DBMain *db_main,
                                  common::ManagedPointer<common::ActionContext> action_context);
@@ -88,6 +92,10 @@ class Callbacks {
   static void MetricsExecuteCommand(void *old_value, void *new_value, DBMain *db_main,
                                     common::ManagedPointer<common::ActionContext> action_context);
 
+  /** Enable or disable metrics collection for admission control. */
+  static void MetricsAdmissionControl(void *old_value, void *new_value, DBMain *db_main,
+                                      common::ManagedPointer<common::ActionContext> action_context);
+
   /** Enable or disable metrics collection for Query Trace component. */
   static void MetricsQueryTrace(void *old_value, void *new_value, DBMain *db_main,
                                 common::ManagedPointer<common::ActionContext> action_context);
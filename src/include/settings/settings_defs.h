@@ -33,6 +33,42 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Threads that accept connections, each with a listening socket of its own
+SETTING_int(
+    connection_acceptor_count,
+    "Threads that accept client connections and dispatch them to their share of the connection handler threads. Each "
+    "acceptor listens on a socket of its own bound with SO_REUSEPORT, so that the kernel spreads connection storms "
+    "across them (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Threads that execute queries on behalf of the connection handler threads
+SETTING_int(
+    execution_thread_count,
+    "Threads that execute queries so that a long query does not stall the other connections of its connection handler "
+    "thread. 0 executes queries on the connection handler threads (default: 0)",
+    0,
+    0,
+    256,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    execution_blocking_thread_limit,
+    "Threads that run the queries of portals fetched a few rows at a time, each of which waits for the client while the "
+    "portal is suspended. A portal that finds all of them busy fails its first Execute (default: 64)",
+    64,
+    1,
+    65535,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Path to socket file for Unix domain sockets
 SETTING_string(
     uds_file_directory,
@@ -172,6 +208,62 @@ SETTING_int(task_execution_timeout,
             "assuming one plan has been found (default 5000)",
             5000, 1000, 60000, false, noisepage::settings::Callbacks::NoOp)
 
+SETTING_int(optimizer_threads,
+            "Number of threads that optimize the independent subtrees of a query, such as the inputs of a bushy join. "
+            "1 optimizes every query on the connection's thread (default 1)",
+            1, 1, 64, false, noisepage::settings::Callbacks::NoOp)
+
+SETTING_int(cardinality_feedback_factor,
+            "Feeds the rows that plan nodes actually produced back into the optimizer's estimates, and re-optimizes a "
+            "cached plan whose estimates were off by at least this factor. Rows below the output are only observed "
+            "with counters_enable and pipeline_metrics_enable. 0 disables the feedback (default 0)",
+            0, 0, 1000000, true, noisepage::settings::Callbacks::NoOp)
+
+SETTING_int(custom_plan_executions,
+            "Number of executions of a prepared statement with parameters that are optimized for their parameter "
+            "values before a generic plan is considered. The generic plan is kept if its estimated cost is close to "
+            "the average cost of these custom plans. Only applies with use_query_cache (default 5)",
+            5, 0, 1000000, true, noisepage::settings::Callbacks::NoOp)
+
+SETTING_int(generic_plan_selectivity_factor,
+            "Optimizes an execution of a prepared statement for its parameter values instead of using the generic "
+            "plan when the selectivity of a parameter, estimated from the histograms, differs from the one the "
+            "generic plan assumed by at least this factor. A custom plan is likewise reused for later values within "
+            "this factor of the one it was optimized for. 0 always uses the generic plan, or the last custom plan "
+            "once the generic plan was rejected (default 10)",
+            10, 0, 1000000, true, noisepage::settings::Callbacks::NoOp)
+
+// Admission control
+SETTING_bool(admission_control_enable,
+             "Limits the number of queries that execute at the same time, queueing the others. Queries are either "
+             "OLTP or analytic depending on their estimated cost, and each class has its own slots. Requires "
+             "execution_thread_count > 0, since queries wait for admission on their execution thread (default: false)",
+             false, false, noisepage::settings::Callbacks::NoOp)
+
+SETTING_int(admission_oltp_slots,
+            "Number of OLTP queries that may execute at the same time with admission_control_enable (default: 64)",
+            64, 1, 65536, false, noisepage::settings::Callbacks::NoOp)
+
+SETTING_int(admission_analytic_slots,
+            "Number of analytic queries that may execute at the same time with admission_control_enable. Keep it below "
+            "the number of execution threads so that OLTP queries always find one (default: 2)",
+            2, 1, 65536, false, noisepage::settings::Callbacks::NoOp)
+
+SETTING_double(admission_analytic_cost_threshold,
+               "Estimated optimizer cost at which a query is admitted as analytic instead of OLTP (default: 100000)",
+               100000.0, 0.0, 1e18, false, noisepage::settings::Callbacks::NoOp)
+
+SETTING_int64(admission_memory_budget,
+              "Memory (bytes) that the queries admitted at the same time may be expected to use, based on the memory "
+              "that earlier executions of the same statement used, or on the optimizer's cardinality estimates before "
+              "the first execution. 0 disables the budget (default: 0)",
+              0, 0, 1099511627776, false, noisepage::settings::Callbacks::NoOp)
+
+SETTING_int(admission_queue_timeout,
+            "Time (ms) a query waits in the admission queue before it fails. 0 fails queries that cannot be admitted "
+            "right away (default: 10000)",
+            10000, 0, 3600000, false, noisepage::settings::Callbacks::NoOp)
+
 // Parallel Execution
 SETTING_bool(
     parallel_execution,
@@ -181,6 +273,31 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Degree of parallelism of a pipeline
+SETTING_int(
+    parallel_execution_rows_per_thread,
+    "Estimated number of input rows per thread of a parallel pipeline. Pipelines estimated to read fewer rows run "
+    "serially, larger ones get one thread per this many rows up to num_parallel_execution_threads (0 always uses all "
+    "threads) (default: 16384)",
+    16384,
+    0,
+    1000000000,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Number of blocks ANALYZE samples
+SETTING_int(
+    analyze_sample_blocks,
+    "Number of table blocks ANALYZE reads to compute statistics, larger tables are sampled (0 scans everything) "
+    "(default: 256)",
+    256,
+    0,
+    1000000,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Log file persisting threshold
 SETTING_int64(
     wal_persist_threshold,
@@ -281,6 +398,56 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_bool(
+    auto_analyze_enable,
+    "Use a thread that re-analyzes tables after many of their tuples changed (default: false).",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    auto_analyze_interval,
+    "Interval between checks for tables that need to be re-analyzed (default: 10000000, unit: micro-second)",
+    10000000,
+    100000,
+    10000000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    auto_analyze_threshold,
+    "Minimum number of inserted, updated, or deleted tuples before a table is re-analyzed (default: 50)",
+    50,
+    0,
+    1000000000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_double(
+    auto_analyze_scale_factor,
+    "Fraction of the rows of a table that must change, on top of auto_analyze_threshold, before the table is "
+    "re-analyzed (default: 0.1)",
+    0.1,
+    0.0,
+    100.0,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    stats_storage_memory_limit,
+    "Approximate memory budget of the optimizer statistics cache, least recently used tables are evicted beyond it "
+    "(default: 67108864, unit: byte)",
+    67108864,
+    0,
+    1000000000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     use_pilot_thread,
     "Use a thread for the pilot (default: false).",
@@ -371,6 +538,36 @@ SETTING_int(
     noisepage::settings::Callbacks::MetricsPipelineSampleRate
 )
 
+SETTING_string(
+    pipeline_metrics_output,
+    "Output type for ExecutionEngine pipeline Metrics (default: CSV, values: NONE, CSV, BINARY)",
+    "CSV",
+    true,
+    noisepage::settings::Callbacks::MetricsPipelineOutput
+)
+
+SETTING_int64(
+    metrics_buffer_capacity,
+    "Number of pipeline and transaction metrics records that each thread buffers until they are aggregated, rounded "
+    "up to a power of two. Records beyond it are dropped (default: 4096)",
+    4096,
+    1,
+    1048576,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    metrics_aggregation_limit,
+    "Maximum number of pipeline and transaction metrics records that a periodic aggregation takes from each thread, "
+    "which bounds how long it holds the metrics latch (default: 4096)",
+    4096,
+    1,
+    1048576,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_int(
   logging_metrics_sample_rate,
   "Sampling rate of metrics collection for logging.",
@@ -397,6 +594,14 @@ SETTING_bool(
     noisepage::settings::Callbacks::MetricsExecuteCommand
 )
 
+SETTING_bool(
+    admission_control_metrics_enable,
+    "Metrics collection for the admission control of queries.",
+    false,
+    true,
+    noisepage::settings::Callbacks::MetricsAdmissionControl
+)
+
 SETTING_bool(
     use_query_cache,
     "Extended Query protocol caches physical plans and generated code after first execution. Warning: bugs with DDL changes.",
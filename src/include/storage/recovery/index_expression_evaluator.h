@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+
+#include "catalog/index_schema.h"
+#include "catalog/schema.h"
+#include "common/managed_pointer.h"
+#include "parser/expression/constant_value_expression.h"
+#include "storage/projected_row.h"
+#include "storage/storage_defs.h"
+
+namespace noisepage::storage {
+
+/**
+ * Evaluates index key expressions and partial index predicates against a table ProjectedRow without going through the
+ * execution engine. Recovery replays tuples one at a time and has no compiled query to derive keys with, so this
+ * interprets the small subset of expressions that show up in index definitions: column references, constants,
+ * comparisons, boolean connectives, null tests, integer/real arithmetic and lower()/upper().
+ */
+class IndexExpressionEvaluator {
+ public:
+  /**
+   * @param table_schema schema of the table the ProjectedRow belongs to
+   * @param table_pr ProjectedRow holding every column of the table
+   * @param pr_map projection map of table_pr
+   */
+  IndexExpressionEvaluator(const catalog::Schema &table_schema, const ProjectedRow &table_pr,
+                           const ProjectionMap &pr_map)
+      : table_schema_(table_schema), table_pr_(table_pr), pr_map_(pr_map) {}
+
+  /**
+   * @param expr expression to check
+   * @return true if every node of the expression can be interpreted by this evaluator
+   */
+  static bool IsSupported(common::ManagedPointer<const parser::AbstractExpression> expr);
+
+  /**
+   * @param schema index schema to check
+   * @return true if every key column and the predicate (if any) can be interpreted by this evaluator
+   */
+  static bool IsSupported(const catalog::IndexSchema &schema);
+
+  /**
+   * Evaluates an expression against the table ProjectedRow. The expression must satisfy IsSupported.
+   * @param expr expression to evaluate
+   * @return the resulting value, which owns any varlen it produced
+   */
+  parser::ConstantValueExpression Evaluate(common::ManagedPointer<const parser::AbstractExpression> expr) const;
+
+  /**
+   * @param schema index schema
+   * @return true if the tuple belongs in the index, i.e. the index is not partial or its predicate is true
+   */
+  bool SatisfiesPredicate(const catalog::IndexSchema &schema) const;
+
+  /**
+   * Writes a value into an index key ProjectedRow, converting between widths of the same type family if needed.
+   * @param value value to write; varlens are referenced, so value must outlive the index operation
+   * @param type type of the index key column
+   * @param offset offset of the key column in index_pr
+   * @param index_pr ProjectedRow of the index key
+   */
+  static void WriteKey(const parser::ConstantValueExpression &value, type::TypeId type, uint16_t offset,
+                       ProjectedRow *index_pr);
+
+ private:
+  parser::ConstantValueExpression ReadColumn(catalog::col_oid_t col_oid) const;
+
+  const catalog::Schema &table_schema_;
+  const ProjectedRow &table_pr_;
+  const ProjectionMap &pr_map_;
+};
+
+}  // namespace noisepage::storage
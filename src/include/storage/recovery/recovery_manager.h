@@ -309,6 +309,28 @@ class RecoveryManager : public common::DedicatedThreadOwner {
            delete_record->GetTableOid() == catalog::postgres::PgAttribute::COLUMN_TABLE_OID;
   }
 
+  /**
+   * Takes the DDL lock of the database if the record changes its catalog tables. Replaying such a record is a DDL
+   * change like any other, so the lock keeps concurrent transactions, e.g., queries on a replica, from using the shared
+   * metadata snapshot of the database until the change commits and replaces it. @see DatabaseCatalog::GetSnapshot
+   * @param txn transaction that replays the record
+   * @param record record to be replayed
+   */
+  void LockCatalogForReplay(transaction::TransactionContext *txn, const LogRecord *record) {
+    const bool is_redo = record->RecordType() == LogRecordType::REDO;
+    const auto db_oid = is_redo ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetDatabaseOid()
+                                : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetDatabaseOid();
+    const auto table_oid = is_redo ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid()
+                                   : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid();
+    // All catalog tables have OIDs less than START_OID, pg_database belongs to no database
+    if (db_oid == catalog::INVALID_DATABASE_OID || table_oid.UnderlyingValue() >= catalog::START_OID) return;
+    // The database does not exist (anymore) while its creation (or drop) is replayed
+    const auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    if (db_catalog == nullptr) return;
+    bool result UNUSED_ATTRIBUTE = db_catalog->TryLock(common::ManagedPointer(txn));
+    NOISEPAGE_ASSERT(result, "Recovery is the only one changing the catalog, so it should always get the DDL lock.");
+  }
+
   /**
    * Returns whether a given record is an insert into a table. We know it is an insert record if the tuple slot it
    * contains is previously unseen. An update will contain a tuple slot that has been previously inserted.
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <set>
 #include <string>
@@ -97,6 +98,7 @@ class SqlTable {
                      "This RedoRecord is not the most recent entry in the txn's RedoBuffer. Was StageWrite called "
                      "immediately before?");
     const auto result = table_.data_table_->Update(txn, redo->GetTupleSlot(), *(redo->Delta()));
+    if (result) num_modifications_.fetch_add(1, std::memory_order_relaxed);
     if (!result) {
       // For MVCC correctness, this txn must now abort for the GC to clean up the version chain in the DataTable
       // correctly.
@@ -120,6 +122,7 @@ class SqlTable {
                      "This RedoRecord is not the most recent entry in the txn's RedoBuffer. Was StageWrite called "
                      "immediately before?");
     const auto slot = table_.data_table_->Insert(txn, *(redo->Delta()));
+    num_modifications_.fetch_add(1, std::memory_order_relaxed);
     redo->SetTupleSlot(slot);
     return slot;
   }
@@ -140,6 +143,7 @@ class SqlTable {
         "This Delete is not the most recent entry in the txn's RedoBuffer. Was StageDelete called immediately before?");
 
     const auto result = table_.data_table_->Delete(txn, slot);
+    if (result) num_modifications_.fetch_add(1, std::memory_order_relaxed);
     if (!result) {
       // For MVCC correctness, this txn must now abort for the GC to clean up the version chain in the DataTable
       // correctly.
@@ -247,6 +251,12 @@ class SqlTable {
    */
   size_t EstimateHeapUsage() const { return table_.data_table_->EstimateHeapUsage(); }
 
+  /**
+   * @return number of tuples inserted, updated or deleted in this table since it was created, including the changes of
+   * transactions that did not commit. Used to decide when the statistics of the table are stale.
+   */
+  uint64_t GetNumModifications() const { return num_modifications_.load(std::memory_order_relaxed); }
+
  private:
   friend class RecoveryManager;  // Needs access to OID and ID mappings
   friend class noisepage::RandomSqlTableTransaction;
@@ -272,6 +282,9 @@ class SqlTable {
   // Eventually we'll support adding more tables when schema changes. For now we'll always access the one DataTable.
   DataTableVersion table_;
 
+  // Insert and Update are const, so the counter has to be mutable
+  mutable std::atomic<uint64_t> num_modifications_{0};
+
   const ColumnMap &GetColumnMap() const { return table_.column_map_; }
 
   /**
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <array>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <list>
+#include <mutex>  // NOLINT
+#include <utility>
+
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+
+namespace noisepage::planner {
+class AbstractPlanNode;
+class PlanMetaData;
+}  // namespace noisepage::planner
+
+namespace noisepage::trafficcop {
+
+/** Classes of queries that are admitted separately from each other */
+enum class WorkloadClass : uint8_t { OLTP = 0, ANALYTIC };
+
+/**
+ * AdmissionController limits how many queries execute at the same time.
+ *
+ * Without a limit, a burst of analytical queries oversubscribes the execution threads and the latency of short OLTP
+ * queries collapses. Queries are therefore classified by the cost the optimizer estimated for their plan, and each
+ * class has its own number of slots, so that analytical queries can only take a bounded share of the system. On top of
+ * that, the memory that admitted queries are expected to use has to stay within a budget. A query that cannot be
+ * admitted waits in a FIFO queue of its class until a slot frees up, or fails once it waited longer than the timeout.
+ *
+ * The wait blocks the thread that is about to execute the query, which is why the server only enables admission control
+ * together with the execution threads of the ExecutionWorkerPool and never blocks a connection handler thread.
+ */
+class AdmissionController {
+ public:
+  /**
+   * A query's claim on a slot of its workload class and on part of the memory budget, both of which are given back when
+   * the ticket is destroyed or released.
+   */
+  class Ticket {
+   public:
+    /** Creates a ticket that holds nothing */
+    Ticket() = default;
+
+    /** @param other ticket whose claim this ticket takes over */
+    Ticket(Ticket &&other) noexcept { *this = std::move(other); }
+
+    /**
+     * @param other ticket whose claim this ticket takes over, after giving back its own claim
+     * @return self reference
+     */
+    Ticket &operator=(Ticket &&other) noexcept {
+      if (this != &other) {
+        Release();
+        controller_ = other.controller_;
+        workload_class_ = other.workload_class_;
+        memory_ = other.memory_;
+        queue_depth_ = other.queue_depth_;
+        wait_ = other.wait_;
+        other.controller_ = nullptr;
+      }
+      return *this;
+    }
+
+    DISALLOW_COPY(Ticket);
+
+    ~Ticket() { Release(); }
+
+    /** Gives back the slot and the memory, if the ticket holds them */
+    void Release();
+
+    /** @return true if the query was admitted and may execute */
+    bool IsAdmitted() const { return controller_ != nullptr; }
+
+    /** @return workload class the query was admitted to, or queued in */
+    WorkloadClass GetWorkloadClass() const { return workload_class_; }
+
+    /** @return number of queries of the same class that were queued ahead of the query when it arrived */
+    uint64_t GetQueueDepth() const { return queue_depth_; }
+
+    /** @return time the query waited in the queue */
+    std::chrono::microseconds GetWaitTime() const { return wait_; }
+
+   private:
+    friend class AdmissionController;
+
+    Ticket(AdmissionController *controller, WorkloadClass workload_class, uint64_t memory, uint64_t queue_depth,
+           std::chrono::microseconds wait)
+        : controller_(controller),
+          workload_class_(workload_class),
+          memory_(memory),
+          queue_depth_(queue_depth),
+          wait_(wait) {}
+
+    AdmissionController *controller_ = nullptr;
+    WorkloadClass workload_class_ = WorkloadClass::OLTP;
+    uint64_t memory_ = 0;
+    uint64_t queue_depth_ = 0;
+    std::chrono::microseconds wait_{0};
+  };
+
+  /**
+   * @param oltp_slots number of OLTP queries that may execute at the same time
+   * @param analytic_slots number of analytic queries that may execute at the same time
+   * @param analytic_cost_threshold estimated cost at which a query is analytic
+   * @param memory_budget memory (bytes) the admitted queries may be expected to use together, 0 for no budget
+   * @param queue_timeout how long a query may wait to be admitted
+   */
+  AdmissionController(uint32_t oltp_slots, uint32_t analytic_slots, double analytic_cost_threshold,
+                      uint64_t memory_budget, std::chrono::milliseconds queue_timeout);
+
+  DISALLOW_COPY_AND_MOVE(AdmissionController);
+
+  /**
+   * @param estimated_cost cost of the query's plan estimated by the optimizer
+   * @return workload class of the query
+   */
+  WorkloadClass Classify(double estimated_cost) const {
+    return estimated_cost >= analytic_cost_threshold_ ? WorkloadClass::ANALYTIC : WorkloadClass::OLTP;
+  }
+
+  /**
+   * Estimates the memory a plan needs from the cardinalities the optimizer estimated, for a statement that did not
+   * execute yet and so has no measured peak memory. Only the operators that hold their whole input are counted: the
+   * build side of hash joins, hash aggregations and sorts, at the width of the tuples they keep.
+   * @param plan root of the plan
+   * @param plan_meta_data cardinalities of the plan's nodes
+   * @return estimated memory (bytes) of the plan
+   */
+  static uint64_t EstimateMemory(common::ManagedPointer<planner::AbstractPlanNode> plan,
+                                 common::ManagedPointer<planner::PlanMetaData> plan_meta_data);
+
+  /**
+   * Admits a query, waiting in the queue of its class if a slot or memory is not available. Queries are admitted in the
+   * order in which they arrived within their class. A query that is expected to need more than the whole memory budget
+   * is admitted once no other admitted query holds memory.
+   * @param workload_class class of the query
+   * @param estimated_memory memory (bytes) the query is expected to use
+   * @return ticket that holds the query's slot, which is not admitted if the query timed out in the queue
+   */
+  Ticket Admit(WorkloadClass workload_class, uint64_t estimated_memory);
+
+  /**
+   * @param workload_class workload class
+   * @return number of queries of the class that wait to be admitted
+   */
+  uint64_t GetQueueDepth(WorkloadClass workload_class) const;
+
+  /**
+   * @param workload_class workload class
+   * @return number of queries of the class that are admitted and have not released their ticket
+   */
+  uint32_t GetNumRunning(WorkloadClass workload_class) const;
+
+  /** @return memory (bytes) that the admitted queries are expected to use */
+  uint64_t GetReservedMemory() const;
+
+  /**
+   * @param workload_class workload class
+   * @return number of queries of the class that timed out in the queue so far
+   */
+  uint64_t GetNumTimedOut(WorkloadClass workload_class) const;
+
+  /**
+   * @param workload_class workload class
+   * @return time that the admitted queries of the class spent waiting in the queue so far
+   */
+  std::chrono::microseconds GetTotalWaitTime(WorkloadClass workload_class) const;
+
+ private:
+  static constexpr uint8_t NUM_WORKLOAD_CLASSES = 2;
+
+  struct ClassState {
+    uint32_t slots_ = 0;
+    uint32_t running_ = 0;
+    // Expected memory of the queued queries, in the order they arrived
+    std::list<uint64_t> queue_;
+    uint64_t num_timed_out_ = 0;
+    std::chrono::microseconds total_wait_{0};
+  };
+
+  bool CanAdmit(const ClassState &state, uint64_t memory) const;
+  void Release(WorkloadClass workload_class, uint64_t memory);
+
+  ClassState &State(const WorkloadClass workload_class) { return classes_[static_cast<uint8_t>(workload_class)]; }
+  const ClassState &State(const WorkloadClass workload_class) const {
+    return classes_[static_cast<uint8_t>(workload_class)];
+  }
+
+  const double analytic_cost_threshold_;
+  const uint64_t memory_budget_;
+  const std::chrono::milliseconds queue_timeout_;
+
+  mutable std::mutex mutex_;
+  // Signalled whenever a query leaves a queue or gives back its slot, since either can let the head of a queue in
+  std::condition_variable admission_cv_;
+  std::array<ClassState, NUM_WORKLOAD_CLASSES> classes_;
+  uint64_t reserved_memory_ = 0;
+};
+
+}  // namespace noisepage::trafficcop
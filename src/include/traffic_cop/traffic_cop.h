@@ -1,14 +1,18 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
 #include "common/managed_pointer.h"
+#include "common/worker_pool.h"
 #include "execution/vm/vm_defs.h"
 #include "network/network_defs.h"
+#include "planner/plannodes/plan_node_defs.h"
+#include "traffic_cop/admission_controller.h"
 #include "traffic_cop/traffic_cop_defs.h"
 #include "transaction/transaction_defs.h"
 
@@ -18,6 +22,7 @@ class Catalog;
 
 namespace noisepage::network {
 class ConnectionContext;
+class PortalExecution;
 class PostgresPacketWriter;
 class Statement;
 class Portal;
@@ -78,8 +83,10 @@ class TrafficCop {
    * @param settings_manager the settings manager
    * @param stats_storage for optimizer calls
    * @param optimizer_timeout for optimizer calls
+   * @param optimizer_threads number of threads optimizing a query, 1 to optimize on the calling thread only
    * @param use_query_cache whether to cache physical plans and generated code for Extended Query protocol
    * @param execution_mode how to run executable queries after code generation
+   * @param admission_controller limits the queries that execute at the same time, nullptr to execute all right away
    */
   TrafficCop(common::ManagedPointer<transaction::TransactionManager> txn_manager,
              common::ManagedPointer<catalog::Catalog> catalog,
@@ -87,7 +94,8 @@ class TrafficCop {
              common::ManagedPointer<storage::RecoveryManager> recovery_manager,
              common::ManagedPointer<settings::SettingsManager> settings_manager,
              common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout,
-             bool use_query_cache, const execution::vm::ExecutionMode execution_mode)
+             uint32_t optimizer_threads, bool use_query_cache, const execution::vm::ExecutionMode execution_mode,
+             std::unique_ptr<AdmissionController> admission_controller = nullptr)
       : txn_manager_(txn_manager),
         catalog_(catalog),
         replication_manager_(replication_manager),
@@ -97,7 +105,14 @@ class TrafficCop {
         optimizer_timeout_(optimizer_timeout),
         use_query_cache_(use_query_cache),
         query_cache_timestamp_(transaction::INITIAL_TXN_TIMESTAMP),
-        execution_mode_(execution_mode) {}
+        execution_mode_(execution_mode),
+        admission_controller_(std::move(admission_controller)) {
+    // The thread that optimizes a query works on its subtrees too, so it only needs threads - 1 helpers
+    if (optimizer_threads > 1) {
+      optimizer_worker_pool_ = std::make_unique<common::WorkerPool>(optimizer_threads - 1, common::TaskQueue{});
+      optimizer_worker_pool_->Startup();
+    }
+  }
 
   virtual ~TrafficCop() = default;
 
@@ -143,6 +158,21 @@ class TrafficCop {
       common::ManagedPointer<parser::ParseResult> query,
       common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) const;
 
+  /**
+   * Gives a bound statement the plan to execute with the given parameters, re-using its cached plan where possible.
+   * A statement with parameters is optimized for the values of its first custom_plan_executions executions. After
+   * that, a generic plan optimized without the values is used as long as its estimated cost is close to the average
+   * of those custom plans, except for values whose selectivity the generic plan misjudges. Those values, and every
+   * value once the generic plan was rejected, keep the last custom plan and its code while their selectivity is close
+   * to the one it was optimized for.
+   * @param connection_ctx context containg txn and catalog accessor to be used
+   * @param statement bound statement
+   * @param parameters parameters for the query, can be nullptr if there are no parameters
+   */
+  void PlanBoundQuery(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                      common::ManagedPointer<network::Statement> statement,
+                      common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) const;
+
   /**
    * Calls to txn manager to begin txn, and updates ConnectionContext state
    * @param connection_ctx context to own this txn
@@ -250,11 +280,31 @@ class TrafficCop {
    * @param connection_ctx context to be used to access the internal txn
    * @param out packet writer to return results
    * @param portal to be executed, may contain parameters
+   * @param portal_execution if not null, the execution of a portal that the client fetches from with a row limit,
+   * which this call runs on
    * @return result of the operation
    */
   TrafficCopResult RunExecutableQuery(common::ManagedPointer<network::ConnectionContext> connection_ctx,
                                       common::ManagedPointer<network::PostgresPacketWriter> out,
-                                      common::ManagedPointer<network::Portal> portal) const;
+                                      common::ManagedPointer<network::Portal> portal,
+                                      common::ManagedPointer<network::PortalExecution> portal_execution =
+                                          nullptr) const;
+
+  /**
+   * Inserts a batch of rows sent by a COPY FROM STDIN. The rows are inserted rows_per_insert at a time by a compiled
+   * INSERT that takes all of their values as parameters, so that it runs once per rows_per_insert rows instead of once
+   * per row. The rows left over are inserted one at a time by a compiled INSERT of a single row.
+   * @param connection_ctx context to be used to access the internal txn
+   * @param portal INSERT of a single row, already compiled
+   * @param batch_portal INSERT of rows_per_insert rows, already compiled, or nullptr if rows_per_insert is 1
+   * @param rows_per_insert number of rows batch_portal inserts
+   * @param rows values of the rows to insert, which are moved out
+   * @return result of the operation, with the number of rows inserted if it completed
+   */
+  TrafficCopResult RunCopyIn(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                             common::ManagedPointer<network::Portal> portal,
+                             common::ManagedPointer<network::Portal> batch_portal, size_t rows_per_insert,
+                             std::vector<std::vector<parser::ConstantValueExpression>> *rows) const;
 
   /**
    * Adjust the TrafficCop's optimizer timeout value (for use by SettingsManager)
@@ -275,6 +325,11 @@ class TrafficCop {
    */
   bool UseQueryCache() const { return use_query_cache_; }
 
+  /** @return admission controller of the queries, nullptr if admission control is disabled */
+  common::ManagedPointer<AdmissionController> GetAdmissionController() const {
+    return common::ManagedPointer(admission_controller_);
+  }
+
   /**
    * Update the minimum generation timestamp required for the cached ExecutableQuery (resulting re-compilation for the
    * unsatisfied ExecutableQuery )
@@ -282,6 +337,32 @@ class TrafficCop {
   void UpdateQueryCacheTimestamp();
 
  private:
+  /**
+   * Feeds the rows that the plan nodes of a query produced back into the cardinality estimates of the optimizer. The
+   * cached plan is marked stale if one of its estimates was off by at least the given factor and the optimizer did not
+   * know the actual cardinality when it chose the plan.
+   * @param portal portal whose plan ran
+   * @param output_rows number of rows produced by every plan node that could be observed
+   * @param factor misestimation factor that makes the plan stale
+   */
+  void RecordCardinalityFeedback(common::ManagedPointer<network::Portal> portal,
+                                 const std::unordered_map<planner::plan_node_id_t, size_t> &output_rows,
+                                 double factor) const;
+
+  /**
+   * Checks whether the selectivities that a plan assumed for its parameters hold for the given values
+   * @param connection_ctx context containg txn and catalog accessor to be used
+   * @param plan generic plan, or custom plan optimized for other parameter values
+   * @param parameters parameters for the query
+   * @return whether the plan suits the parameter values
+   */
+  bool PlanFits(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                common::ManagedPointer<optimizer::OptimizeResult> plan,
+                common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) const;
+
+  /** How much more expensive than the average custom plan a generic plan may be estimated, since it saves planning */
+  static constexpr double GENERIC_PLAN_COST_MARGIN = 1.1;
+
   common::ManagedPointer<transaction::TransactionManager> txn_manager_;
   common::ManagedPointer<catalog::Catalog> catalog_;
   common::ManagedPointer<replication::ReplicationManager> replication_manager_;
@@ -292,6 +373,8 @@ class TrafficCop {
   const bool use_query_cache_;
   transaction::timestamp_t query_cache_timestamp_;
   execution::vm::ExecutionMode execution_mode_;
+  std::unique_ptr<common::WorkerPool> optimizer_worker_pool_;
+  std::unique_ptr<AdmissionController> admission_controller_;
 };
 
 }  // namespace noisepage::trafficcop
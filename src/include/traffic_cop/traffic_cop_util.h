@@ -13,8 +13,13 @@ namespace noisepage::catalog {
 class CatalogAccessor;
 }
 
+namespace noisepage::common {
+class WorkerPool;
+}  // namespace noisepage::common
+
 namespace noisepage::parser {
 class ConstantValueExpression;
+class CopyStatement;
 class ParseResult;
 class SQLStatement;
 class SelectStatement;
@@ -52,6 +57,7 @@ class TrafficCopUtil {
    * @param cost_model used by optimizer
    * @param optimizer_timeout used by optimizer
    * @param parameters parameters for the query, can be nullptr if there are no parameters
+   * @param optimizer_worker_pool used by optimizer for independent subtrees, nullptr to optimize serially
    * @return physical plan that can be executed
    */
   static std::unique_ptr<optimizer::OptimizeResult> Optimize(
@@ -59,7 +65,8 @@ class TrafficCopUtil {
       common::ManagedPointer<catalog::CatalogAccessor> accessor, common::ManagedPointer<parser::ParseResult> query,
       catalog::db_oid_t db_oid, common::ManagedPointer<optimizer::StatsStorage> stats_storage,
       std::unique_ptr<optimizer::AbstractCostModel> cost_model, uint64_t optimizer_timeout,
-      common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters);
+      common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters,
+      common::ManagedPointer<common::WorkerPool> optimizer_worker_pool = nullptr);
 
   /**
    * Converts parser statement types (which rely on multiple enums) to a single QueryType enum from the network layer
@@ -68,6 +75,19 @@ class TrafficCopUtil {
    */
   static network::QueryType QueryTypeForStatement(common::ManagedPointer<parser::SQLStatement> statement);
 
+  /**
+   * @param statement root statement of a query, may be nullptr
+   * @return the statement if it is a COPY FROM STDIN or COPY TO STDOUT, nullptr otherwise
+   */
+  static common::ManagedPointer<parser::CopyStatement> ClientCopyStatement(
+      common::ManagedPointer<parser::SQLStatement> statement);
+
+  /**
+   * @param copy_stmt COPY FROM STDIN or COPY TO STDOUT statement
+   * @return how the rows are encoded in the CopyData messages exchanged with the client
+   */
+  static network::CopyFormat CopyFormatForStatement(common::ManagedPointer<parser::CopyStatement> copy_stmt);
+
  private:
   static void CollectSelectProperties(common::ManagedPointer<parser::SelectStatement> sel_stmt,
                                       optimizer::PropertySet *property_set);
@@ -5,6 +5,7 @@
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "common/object_pool.h"
+#include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "storage/data_table.h"
 #include "storage/record_buffer.h"
@@ -164,7 +165,10 @@ class TransactionContext {
    * @param a the action to be executed. A handle to the system's deferred action manager is supplied
    * to enable further deferral of actions
    */
-  void RegisterAbortAction(const TransactionEndAction &a) { abort_actions_.push_front(a); }
+  void RegisterAbortAction(const TransactionEndAction &a) {
+    common::SpinLatch::ScopedSpinLatch guard(&end_actions_latch_);
+    abort_actions_.push_front(a);
+  }
 
   /**
    * Defers an action to be called if and only if the transaction aborts.  Actions executed LIFO.
@@ -180,7 +184,10 @@ class TransactionContext {
    * @param a the action to be executed. A handle to the system's deferred action manager is supplied
    * to enable further deferral of actions
    */
-  void RegisterCommitAction(const TransactionEndAction &a) { commit_actions_.push_front(a); }
+  void RegisterCommitAction(const TransactionEndAction &a) {
+    common::SpinLatch::ScopedSpinLatch guard(&end_actions_latch_);
+    commit_actions_.push_front(a);
+  }
 
   /**
    * Defers an action to be called if and only if the transaction commits.  Actions executed LIFO.
@@ -244,6 +251,8 @@ class TransactionContext {
   // These actions will be triggered (not deferred) at abort/commit.
   std::forward_list<TransactionEndAction> abort_actions_;
   std::forward_list<TransactionEndAction> commit_actions_;
+  // Actions may be registered from several threads working on behalf of the transaction, e.g. the optimizer's workers
+  common::SpinLatch end_actions_latch_;
 
   // We need to know if the transaction is aborted. Even aborted transactions need an "abort" timestamp in order to
   // eliminate the a-b-a race described in DataTable::Select.
@@ -89,6 +89,8 @@ void DBMain::ForceShutdown() {
   }
 
   // Shutdown the following resources to safely release the task manager.
+  (void)auto_analyzer_thread_.reset();
+  (void)auto_analyzer_.reset();
   (void)pilot_thread_.reset();
   (void)pilot_.reset();
   (void)metrics_thread_.reset();
@@ -1,7 +1,14 @@
 #include "messenger/messenger.h"
 
-#include <cinttypes>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
 #include <mutex>  // NOLINT
+#include <optional>
 #include <vector>
 #include <zmq.hpp>
 
@@ -44,6 +51,8 @@
  * # What pitfalls does ZeroMQ have?
  *
  *    1.  ZeroMQ is not truly zero-copy, copies are performed between userspace and kernelspace.
+ *        Within the process, the Messenger avoids copies: payloads are built straight into a buffer that is handed to
+ *        zmq::message_t, resends share that buffer, and received payloads are read in place out of the frame.
  *
  * # How does NoisePage use ZeroMQ?
  *
@@ -94,37 +103,58 @@
 namespace noisepage::messenger {
 
 ZmqMessage ZmqMessage::Build(message_id_t message_id, callback_id_t source_cb_id, callback_id_t dest_cb_id,
-                             const std::string &routing_id, std::string_view message) {
-  return ZmqMessage{routing_id, fmt::format("{}-{}-{}-{}", message_id.UnderlyingValue(), source_cb_id.UnderlyingValue(),
-                                            dest_cb_id.UnderlyingValue(), message)};
+                             const std::string &routing_id, std::string message) {
+  // Prefix the header in place, which reuses the buffer of the message when it has the capacity to spare.
+  const std::string header = fmt::format("{}-{}-{}-", message_id.UnderlyingValue(), source_cb_id.UnderlyingValue(),
+                                         dest_cb_id.UnderlyingValue());
+  message.insert(0, header);
+  // Hand the buffer to ZeroMQ without copying it. ZeroMQ frees it once this message and every frame sent from it is
+  // gone.
+  auto *buffer = new std::string(std::move(message));
+  auto free_buffer = [](void * /*data*/, void *hint) { delete static_cast<std::string *>(hint); };
+  auto payload = std::make_unique<zmq::message_t>(buffer->data(), buffer->size(), free_buffer, buffer);
+
+  // The header is known already, so there is no need to parse it back out of the payload.
+  ZmqMessage msg{routing_id, std::move(payload)};
+  msg.message_id_ = message_id;
+  msg.source_cb_id_ = source_cb_id;
+  msg.dest_cb_id_ = dest_cb_id;
+  msg.message_.remove_prefix(header.size());
+  return msg;
 }
 
-ZmqMessage ZmqMessage::Parse(const std::string &routing_id, const std::string &message) {
-  return ZmqMessage{routing_id, message};
-}
+std::optional<ZmqMessage> ZmqMessage::Parse(std::string routing_id, std::unique_ptr<zmq::message_t> payload) {
+  ZmqMessage msg{std::move(routing_id), std::move(payload)};
+
+  // Parse the header, which is of the form MESSAGE_ID-SOURCE_CB_ID-DEST_CB_ID-, and cut it off the message.
+  // The payload is not null-terminated, so the header is parsed without sscanf. It also comes from another process,
+  // which is why a malformed header is rejected instead of asserted against.
+  uint64_t header[3];
+  for (auto &field : header) {
+    const char *const end = msg.message_.data() + msg.message_.size();
+    const auto result = std::from_chars(msg.message_.data(), end, field);
+    if (result.ec != std::errc() || result.ptr == end || *result.ptr != '-') return std::nullopt;
+    msg.message_.remove_prefix(result.ptr - msg.message_.data() + 1);
+  }
 
-ZmqMessage::ZmqMessage(std::string routing_id, std::string payload)
-    : routing_id_(std::move(routing_id)), payload_(std::move(payload)), message_(payload_) {
-  uint64_t message_id;
-  uint64_t source_cb_id;
-  uint64_t dest_cb_id;
-
-  NOISEPAGE_ASSERT(!payload_.empty(), "Payload must be defined for valid messages.");
-  // TODO(WAN): atoi, stoull, from_chars, etc? Error checking in general.
-  UNUSED_ATTRIBUTE int check =
-      std::sscanf(payload_.c_str(), "%" SCNu64 "-%" SCNu64 "-%" SCNu64 "-", &message_id, &source_cb_id, &dest_cb_id);
-  NOISEPAGE_ASSERT(3 == check, "Couldn't parse the message header.");
-
-  // Remove the prefix up to the third '-'
-  message_.remove_prefix(message_.find_first_of('-') + 1);
-  message_.remove_prefix(message_.find_first_of('-') + 1);
-  message_.remove_prefix(message_.find_first_of('-') + 1);
-
-  message_id_ = message_id_t{message_id};
-  source_cb_id_ = callback_id_t{source_cb_id};
-  dest_cb_id_ = callback_id_t{dest_cb_id};
+  msg.message_id_ = message_id_t{header[0]};
+  msg.source_cb_id_ = callback_id_t{header[1]};
+  msg.dest_cb_id_ = callback_id_t{header[2]};
+  return msg;
 }
 
+ZmqMessage::ZmqMessage(std::string routing_id, std::unique_ptr<zmq::message_t> payload)
+    : routing_id_(std::move(routing_id)),
+      payload_(std::move(payload)),
+      raw_payload_(static_cast<const char *>(payload_->data()), payload_->size()),
+      message_(raw_payload_) {}
+
+ZmqMessage::ZmqMessage(ZmqMessage &&other) noexcept = default;
+
+ZmqMessage &ZmqMessage::operator=(ZmqMessage &&other) noexcept = default;
+
+ZmqMessage::~ZmqMessage() = default;
+
 /** An abstraction around all the ZeroMQ poll items that the Messenger holds. */
 class MessengerPolledSockets {
  public:
@@ -158,8 +188,6 @@ class MessengerPolledSockets {
     return read_;
   }
 
-  /** Include the specified @p socket on all subsequent calls to pollitems. */
-
   /**
    * Add a new socket to all subsequent calls to GetPollItems().
    * @param socket      The socket to be added.
@@ -177,6 +205,19 @@ class MessengerPolledSockets {
     }
   }
 
+  /**
+   * Add a file descriptor to all subsequent calls to GetPollItems(). Its poll item has no socket.
+   * @param fd          The file descriptor to be polled for reading.
+   */
+  void AddPollFd(int fd) {
+    zmq::pollitem_t pollitem{nullptr, fd, ZMQ_POLLIN, 0};
+    {
+      std::scoped_lock lock(mutex_);
+      writer_.items_.emplace_back(pollitem);
+      writer_.server_callbacks_.emplace_back(nullptr);
+    }
+  }
+
  private:
   /** The items to be polled (reader side). */
   PollItems read_;
@@ -191,8 +232,8 @@ class MessengerPolledSockets {
 namespace noisepage::messenger {
 
 /**
- * Useful ZeroMQ utility functions implemented in a naive manner. Most functions have wasteful copies.
- * If perf indicates that these functions are a bottleneck, switch to the zero-copy messages of ZeroMQ.
+ * Useful ZeroMQ utility functions. Payloads are never copied: received frames are kept as they are and sent frames
+ * share the buffer of the ZmqMessage that they come from.
  */
 class ZmqUtil {
  private:
@@ -214,30 +255,32 @@ class ZmqUtil {
   }
 
   /**
-   * @return    The next string to be read off the socket.
+   * @return    The next frame to be read off the socket.
    * @warning   Socket must be effectively latched!
    */
-  static std::string Recv(const common::ManagedPointer<zmq::socket_t> socket, zmq::recv_flags flags) {
+  static zmq::message_t Recv(const common::ManagedPointer<zmq::socket_t> socket, zmq::recv_flags flags) {
     zmq::message_t message;
     auto received = socket->recv(message, flags);
     if (!received.has_value()) {
       throw MESSENGER_EXCEPTION(fmt::format("Unable to receive on socket: {}", ZmqUtil::GetRoutingId(socket)));
     }
-    return std::string(static_cast<char *>(message.data()), received.value());
+    return message;
   }
 
   /**
-   * @return    The next ZmqMessage (identity and payload) read off the socket.
+   * @return    The next ZmqMessage (identity and payload) read off the socket, or std::nullopt if its payload does not
+   *            start with a well-formed header.
    * @warning   Socket must be effectively latched!
    */
-  static ZmqMessage RecvMsg(const common::ManagedPointer<zmq::socket_t> socket) {
-    std::string identity = Recv(socket, zmq::recv_flags::none);
+  static std::optional<ZmqMessage> RecvMsg(const common::ManagedPointer<zmq::socket_t> socket) {
+    zmq::message_t identity = Recv(socket, zmq::recv_flags::none);
     NOISEPAGE_ASSERT(HasMoreMessagePartsToReceive(socket), "Bad multipart message.");
-    std::string delimiter = Recv(socket, zmq::recv_flags::none);
+    UNUSED_ATTRIBUTE zmq::message_t delimiter = Recv(socket, zmq::recv_flags::none);
     NOISEPAGE_ASSERT(HasMoreMessagePartsToReceive(socket), "Bad multipart message.");
-    std::string payload = Recv(socket, zmq::recv_flags::none);
+    auto payload = std::make_unique<zmq::message_t>(Recv(socket, zmq::recv_flags::none));
 
-    return ZmqMessage::Parse(identity, payload);
+    return ZmqMessage::Parse(std::string(static_cast<const char *>(identity.data()), identity.size()),
+                             std::move(payload));
   }
 
   /**
@@ -259,7 +302,9 @@ class ZmqUtil {
    */
   static void SendMsgPayload(const common::ManagedPointer<zmq::socket_t> socket, const ZmqMessage &msg) {
     zmq::message_t delimiter_msg("", 0);
-    zmq::message_t payload_msg(msg.GetRawPayload().data(), msg.GetRawPayload().size());
+    // Share the payload buffer with the frame instead of copying it, so that resends stay cheap too.
+    zmq::message_t payload_msg;
+    payload_msg.copy(*msg.payload_);
     bool ok = true;
 
     ok = ok && socket->send(delimiter_msg, zmq::send_flags::sndmore).has_value();
@@ -377,12 +422,20 @@ Messenger::Messenger(const uint16_t port, std::string identity) : port_(port), i
     // zmq_ctx_set(zmq_ctx_, ZMQ_IO_THREADS, NUM_IO_THREADS);
   }
 
+  // Sending is fused into the same poll as receiving: other threads signal this eventfd after queueing work, which
+  // wakes the server loop up immediately.
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wakeup_fd_ < 0) {
+    throw MESSENGER_EXCEPTION(fmt::format("Unable to create the Messenger wakeup eventfd: {}", strerror(errno)));
+  }
+
   polled_sockets_ = std::make_unique<MessengerPolledSockets>();
+  polled_sockets_->AddPollFd(wakeup_fd_);
   polled_sockets_->AddPollItem(zmq_default_socket_.get(), nullptr);
   is_messenger_running_ = true;
 }
 
-Messenger::~Messenger() = default;
+Messenger::~Messenger() { close(wakeup_fd_); }
 
 void Messenger::RunTask() {
   try {
@@ -411,6 +464,7 @@ router_id_t Messenger::ListenForConnection(const ConnectionDestination &target,
   std::unique_lock lock(routers_add_mutex_);
   router_id_t router_id = next_router_id_++;
   routers_to_be_added_.emplace_back(RouterToBeAdded{router_id, target, identity, std::move(callback)});
+  WakeServerLoop();
   routers_add_cvar_.wait(lock);
   return router_id;
 }
@@ -421,11 +475,12 @@ connection_id_t Messenger::MakeConnection(const ConnectionDestination &target) {
   std::unique_lock lock(connections_add_mutex_);
   connection_id_t connection_id = next_connection_id_++;
   connections_to_be_added_.emplace_back(ConnectionToBeAdded{connection_id, target});
+  WakeServerLoop();
   connections_add_cvar_.wait(lock);
   return connection_id;
 }
 
-void Messenger::SendMessage(const connection_id_t connection_id, const std::string &message, CallbackFn callback,
+void Messenger::SendMessage(const connection_id_t connection_id, std::string message, CallbackFn callback,
                             callback_id_t remote_cb_id) {
   common::ManagedPointer<ConnectionId> connection = common::ManagedPointer(connections_.at(connection_id));
   message_id_t msg_id = next_message_id_++;
@@ -442,14 +497,13 @@ void Messenger::SendMessage(const connection_id_t connection_id, const std::stri
   common::ManagedPointer<zmq::socket_t> socket = common::ManagedPointer(connection->socket_);
   {
     std::unique_lock lock(pending_messages_mutex_);
-    pending_messages_.emplace(
-        msg_id,
-        PendingMessage{socket, connection->target_name_,
-                       ZmqMessage::Build(msg_id, sender_cb_id, remote_cb_id, connection->routing_id_, message), false});
+    ZmqMessage msg = ZmqMessage::Build(msg_id, sender_cb_id, remote_cb_id, connection->routing_id_, std::move(message));
+    pending_messages_.emplace(msg_id, PendingMessage{socket, connection->target_name_, std::move(msg), false});
   }
+  WakeServerLoop();
 }
 
-void Messenger::SendMessage(const router_id_t router_id, const std::string &recv_id, const std::string &message,
+void Messenger::SendMessage(const router_id_t router_id, const std::string &recv_id, std::string message,
                             CallbackFn callback, callback_id_t remote_cb_id) {
   common::ManagedPointer<ConnectionRouter> router = common::ManagedPointer(routers_.at(router_id));
   message_id_t msg_id = next_message_id_++;
@@ -466,10 +520,10 @@ void Messenger::SendMessage(const router_id_t router_id, const std::string &recv
   common::ManagedPointer<zmq::socket_t> socket = common::ManagedPointer(router->socket_);
   {
     std::unique_lock lock(pending_messages_mutex_);
-    pending_messages_.emplace(
-        msg_id, PendingMessage{socket, recv_id,
-                               ZmqMessage::Build(msg_id, send_cb_id, remote_cb_id, router->identity_, message), true});
+    ZmqMessage msg = ZmqMessage::Build(msg_id, send_cb_id, remote_cb_id, router->identity_, std::move(message));
+    pending_messages_.emplace(msg_id, PendingMessage{socket, recv_id, std::move(msg), true});
   }
+  WakeServerLoop();
 }
 
 callback_id_t Messenger::GetNextSendCallbackId() {
@@ -491,6 +545,13 @@ callback_id_t Messenger::GetNextSendCallbackId() {
   return send_cb_id;
 }
 
+void Messenger::WakeServerLoop() {
+  const uint64_t one = 1;
+  // The eventfd counter saturates long before this could fail, and a failed write only delays the work until the next
+  // MESSENGER_POLL_TIMER anyway.
+  UNUSED_ATTRIBUTE ssize_t written = write(wakeup_fd_, &one, sizeof(one));
+}
+
 void Messenger::ServerLoopAddRouters() {
   // Note that the stale read of empty() is probably undefined behavior. If wonky behavior is observed, watch out here.
   if (!routers_to_be_added_.empty()) {
@@ -556,8 +617,8 @@ void Messenger::ServerLoopSendMessages() {
 
 void Messenger::ServerLoopRecvAndProcessMessages() {
   // Get the latest set of poll items.
-  auto poll_items = polled_sockets_->GetPollItems();
-  // Poll on the current set of poll items.
+  auto &poll_items = polled_sockets_->GetPollItems();
+  // Poll on the current set of poll items. This returns as soon as a message arrives or another thread wakes us up.
   int num_sockets_with_data = zmq::poll(poll_items.items_, MESSENGER_POLL_TIMER);
   for (size_t i = 0; i < poll_items.items_.size(); ++i) {
     zmq::pollitem_t &item = poll_items.items_[i];
@@ -565,11 +626,27 @@ void Messenger::ServerLoopRecvAndProcessMessages() {
     if (0 == num_sockets_with_data) {
       break;
     }
+    // The wakeup eventfd is the only poll item without a socket. Reset it, the queued work is done by the server loop.
+    if (item.socket == nullptr) {
+      if ((item.revents & ZMQ_POLLIN) != 0) {
+        uint64_t count;
+        UNUSED_ATTRIBUTE ssize_t bytes_read = read(item.fd, &count, sizeof(count));
+        --num_sockets_with_data;
+      }
+      continue;
+    }
     // Otherwise, at least some socket has data. Is it the current socket?
     bool socket_has_data = (item.revents & ZMQ_POLLIN) != 0;
     if (socket_has_data) {
       common::ManagedPointer<zmq::socket_t> socket(reinterpret_cast<zmq::socket_t *>(&item.socket));
-      ZmqMessage msg = ZmqUtil::RecvMsg(socket);
+      std::optional<ZmqMessage> received = ZmqUtil::RecvMsg(socket);
+      if (!received.has_value()) {
+        // Without a header there is no message ID to acknowledge and no callback to invoke, so drop the message.
+        MESSENGER_LOG_ERROR(fmt::format("[PID={}] Messenger dropped a message with a malformed header.", ::getpid()));
+        --num_sockets_with_data;
+        continue;
+      }
+      const ZmqMessage &msg = *received;
 
       if (msg.GetDestinationCallbackId().UnderlyingValue() != static_cast<uint8_t>(BuiltinCallback::ACK)) {
         zmq::message_t router_data(msg.GetRoutingId().data(), msg.GetRoutingId().size());
@@ -577,7 +654,7 @@ void Messenger::ServerLoopRecvAndProcessMessages() {
           throw MESSENGER_EXCEPTION("Failed to set router recipient.");
         }
         ZmqMessage ack = ZmqMessage::Build(msg.GetMessageId(), GetBuiltinCallback(BuiltinCallback::NOOP),
-                                           GetBuiltinCallback(BuiltinCallback::ACK), identity_, "");
+                                           GetBuiltinCallback(BuiltinCallback::ACK), identity_, std::string());
         ZmqUtil::SendMsgIdentity(socket, identity_);
         ZmqUtil::SendMsgPayload(socket, ack);
       }
@@ -650,7 +727,7 @@ void Messenger::ProcessMessage(const ZmqMessage &msg) {
       zmq::message_t router_data(msg.GetRoutingId().data(), msg.GetRoutingId().size());
       if (zmq_default_socket_->send(router_data, zmq::send_flags::sndmore).has_value()) {
         ZmqMessage reply = ZmqMessage::Build(next_message_id_++, GetBuiltinCallback(BuiltinCallback::NOOP),
-                                             msg.GetSourceCallbackId(), identity_, msg.GetMessage());
+                                             msg.GetSourceCallbackId(), identity_, std::string(msg.GetMessage()));
         ZmqUtil::SendMsgIdentity(common::ManagedPointer(zmq_default_socket_.get()), identity_);
         ZmqUtil::SendMsgPayload(common::ManagedPointer(zmq_default_socket_.get()), reply);
       } else {
@@ -692,8 +769,8 @@ void Messenger::ServerLoop() {
 
     ServerLoopAddRouters();
     ServerLoopMakeConnections();
-    // TODO(WAN): For higher performance in the future, Send and Recv should be fused into the same zmq socket poll.
-    //            Right now, messages are only sent every MESSENGER_POLL_TIMER instead of being sent whenever available.
+    // Sending and receiving share one poll: SendMessage() wakes the poll below up, so queued messages go out on the
+    // next iteration instead of waiting for MESSENGER_POLL_TIMER. Resends still piggyback on the poll timeout.
     ServerLoopSendMessages();
     ServerLoopRecvAndProcessMessages();
   }
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include <random>
 #include <string>
@@ -11,6 +12,7 @@
 #include <vector>
 
 #include "common/macros.h"
+#include "loggers/metrics_logger.h"
 
 namespace noisepage::metrics {
 
@@ -36,7 +38,18 @@ void OpenFiles(std::vector<std::ofstream> *outfiles) {
   }
 }
 
-MetricsManager::MetricsManager() {
+template <typename abstract_raw_data>
+void OpenBinaryFiles(std::vector<std::ofstream> *outfiles) {
+  const auto num_files = abstract_raw_data::BINARY_FILES.size();
+  outfiles->reserve(num_files);
+  for (size_t file = 0; file < num_files; file++) {
+    outfiles->emplace_back(std::string(abstract_raw_data::BINARY_FILES[file]),
+                           std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+  }
+}
+
+MetricsManager::MetricsManager(const uint64_t buffer_capacity, const uint64_t aggregation_limit)
+    : buffer_capacity_(buffer_capacity), aggregation_limit_(aggregation_limit) {
   // construct a bitset of all true (sampling rate 100) by default
   std::vector<bool> samples_mask(100, true);
   for (uint8_t i = 0; i < NUM_COMPONENTS; i++) {
@@ -45,10 +58,14 @@ MetricsManager::MetricsManager() {
   }
 }
 
-void MetricsManager::Aggregate() {
+void MetricsManager::Aggregate(const bool drain) {
   common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  const auto buffered_limit = drain ? std::numeric_limits<uint64_t>::max() : aggregation_limit_;
+  std::array<uint64_t, NUM_COMPONENTS> dropped{};
   for (const auto &metrics_store : stores_map_) {
-    auto raw_data = metrics_store.second->GetDataToAggregate();
+    auto raw_data = metrics_store.second->GetDataToAggregate(buffered_limit);
+    const auto store_dropped = metrics_store.second->TakeDroppedRecords();
+    for (uint8_t component = 0; component < NUM_COMPONENTS; component++) dropped[component] += store_dropped[component];
 
     for (uint8_t component = 0; component < NUM_COMPONENTS; component++) {
       if (enabled_metrics_.test(component)) {
@@ -61,6 +78,14 @@ void MetricsManager::Aggregate() {
       }
     }
   }
+
+  for (uint8_t component = 0; component < NUM_COMPONENTS; component++) {
+    if (dropped[component] > 0) {
+      dropped_records_[component] += dropped[component];
+      METRICS_LOG_WARN("Dropped {} records of metrics component {} because aggregation is not keeping up.",
+                       dropped[component], component);
+    }
+  }
 }
 
 void MetricsManager::SetMetricSampleRate(const MetricsComponent component, const uint8_t sample_rate) {
@@ -124,6 +149,11 @@ void MetricsManager::ResetMetric(const MetricsComponent component) const {
         metric->Swap();
         break;
       }
+      case MetricsComponent::ADMISSION_CONTROL: {
+        const auto &metric = metrics_store.second->admission_control_metric_;
+        metric->Swap();
+        break;
+      }
     }
   }
 }
@@ -132,8 +162,8 @@ void MetricsManager::RegisterThread() {
   common::SpinLatch::ScopedSpinLatch guard(&latch_);
   const auto thread_id = std::this_thread::get_id();
   NOISEPAGE_ASSERT(stores_map_.count(thread_id) == 0, "This thread was already registered.");
-  auto result =
-      stores_map_.emplace(thread_id, new MetricsStore(common::ManagedPointer(this), enabled_metrics_, samples_mask_));
+  auto result = stores_map_.emplace(
+      thread_id, new MetricsStore(common::ManagedPointer(this), enabled_metrics_, samples_mask_, buffer_capacity_));
   NOISEPAGE_ASSERT(result.second, "Insertion to concurrent map failed.");
   common::thread_context.metrics_store_ = result.first->second;
 }
@@ -159,6 +189,10 @@ void MetricsManager::ToOutput(common::ManagedPointer<task::TaskManager> task_man
         ToCSV(component);
       }
 
+      if (output == MetricsOutput::BINARY) {
+        ToBinary(component);
+      }
+
       if (task_manager && (output == MetricsOutput::DB || output == MetricsOutput::CSV_AND_DB)) {
         ToDB(component, task_manager);
       }
@@ -206,6 +240,10 @@ void MetricsManager::ToCSV(uint8_t component) const {
       OpenFiles<QueryTraceMetricRawData>(&outfiles);
       break;
     }
+    case MetricsComponent::ADMISSION_CONTROL: {
+      OpenFiles<AdmissionControlMetricRawData>(&outfiles);
+      break;
+    }
   }
   aggregated_metrics_[component]->ToCSV(&outfiles);
   for (auto &file : outfiles) {
@@ -213,4 +251,26 @@ void MetricsManager::ToCSV(uint8_t component) const {
   }
 }
 
+void MetricsManager::ToBinary(uint8_t component) const {
+  std::vector<std::ofstream> outfiles;
+  switch (static_cast<MetricsComponent>(component)) {
+    case MetricsComponent::TRANSACTION: {
+      OpenBinaryFiles<TransactionMetricRawData>(&outfiles);
+      break;
+    }
+    case MetricsComponent::EXECUTION_PIPELINE: {
+      OpenBinaryFiles<PipelineMetricRawData>(&outfiles);
+      break;
+    }
+    default: {
+      ToCSV(component);
+      return;
+    }
+  }
+  aggregated_metrics_[component]->ToBinary(&outfiles);
+  for (auto &file : outfiles) {
+    file.close();
+  }
+}
+
 }  // namespace noisepage::metrics
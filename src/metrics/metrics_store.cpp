@@ -11,19 +11,22 @@ namespace noisepage::metrics {
 
 MetricsStore::MetricsStore(const common::ManagedPointer<metrics::MetricsManager> metrics_manager,
                            const std::bitset<NUM_COMPONENTS> &enabled_metrics,
-                           const std::array<std::vector<bool>, NUM_COMPONENTS> &samples_mask)
+                           const std::array<std::vector<bool>, NUM_COMPONENTS> &samples_mask,
+                           const uint64_t buffer_capacity)
     : metrics_manager_(metrics_manager), enabled_metrics_{enabled_metrics}, samples_mask_(samples_mask) {
   logging_metric_ = std::make_unique<LoggingMetric>();
-  txn_metric_ = std::make_unique<TransactionMetric>();
+  txn_metric_ = std::make_unique<TransactionMetric>(buffer_capacity);
   gc_metric_ = std::make_unique<GarbageCollectionMetric>();
   execution_metric_ = std::make_unique<ExecutionMetric>();
-  pipeline_metric_ = std::make_unique<PipelineMetric>();
+  pipeline_metric_ = std::make_unique<PipelineMetric>(buffer_capacity);
   bind_command_metric_ = std::make_unique<BindCommandMetric>();
   execute_command_metric_ = std::make_unique<ExecuteCommandMetric>();
   query_trace_metric_ = std::make_unique<QueryTraceMetric>();
+  admission_control_metric_ = std::make_unique<AdmissionControlMetric>();
 }
 
-std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> MetricsStore::GetDataToAggregate() {
+std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> MetricsStore::GetDataToAggregate(
+    const uint64_t buffered_limit) {
   std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> result;
 
   for (uint8_t component = 0; component < NUM_COMPONENTS; component++) {
@@ -40,7 +43,7 @@ std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> MetricsStore::GetDa
           NOISEPAGE_ASSERT(
               txn_metric_ != nullptr,
               "TransactionMetric cannot be a nullptr. Check the MetricsStore constructor that it was allocated.");
-          result[component] = txn_metric_->Swap();
+          result[component] = txn_metric_->Swap(buffered_limit);
           break;
         }
         case MetricsComponent::GARBAGECOLLECTION: {
@@ -61,7 +64,7 @@ std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> MetricsStore::GetDa
           NOISEPAGE_ASSERT(
               pipeline_metric_ != nullptr,
               "PipelineMetric cannot be a nullptr. Check the MetricsStore constructor that it was allocated.");
-          result[component] = pipeline_metric_->Swap();
+          result[component] = pipeline_metric_->Swap(buffered_limit);
           break;
         }
         case MetricsComponent::BIND_COMMAND: {
@@ -85,10 +88,25 @@ std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> MetricsStore::GetDa
           result[component] = query_trace_metric_->Swap();
           break;
         }
+        case MetricsComponent::ADMISSION_CONTROL: {
+          NOISEPAGE_ASSERT(
+              admission_control_metric_ != nullptr,
+              "AdmissionControlMetric cannot be a nullptr. Check the MetricsStore constructor that it was allocated.");
+          result[component] = admission_control_metric_->Swap();
+          break;
+        }
       }
     }
   }
 
   return result;
 }
+
+std::array<uint64_t, NUM_COMPONENTS> MetricsStore::TakeDroppedRecords() {
+  std::array<uint64_t, NUM_COMPONENTS> result{};
+  // Only the buffered metrics can drop records, the others grow until they are aggregated.
+  result[static_cast<uint8_t>(MetricsComponent::TRANSACTION)] = txn_metric_->TakeDropped();
+  result[static_cast<uint8_t>(MetricsComponent::EXECUTION_PIPELINE)] = pipeline_metric_->TakeDropped();
+  return result;
+}
 }  // namespace noisepage::metrics
@@ -1,5 +1,6 @@
 #include "network/connection_dispatcher_task.h"
 
+#include <cerrno>
 #include <csignal>
 
 #include "common/dedicated_thread_registry.h"
@@ -13,13 +14,14 @@ constexpr uint32_t MAIN_THREAD_ID = -1;
 namespace noisepage::network {
 
 ConnectionDispatcherTask::ConnectionDispatcherTask(
-    uint32_t num_handlers, common::DedicatedThreadOwner *dedicated_thread_owner,
+    uint32_t num_handlers, uint32_t first_handler_id, common::DedicatedThreadOwner *dedicated_thread_owner,
     common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider,
     common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory,
     common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
     std::initializer_list<int> file_descriptors)
     : NotifiableTask(MAIN_THREAD_ID),
       num_handlers_(num_handlers),
+      first_handler_id_(first_handler_id),
       dedicated_thread_owner_(dedicated_thread_owner),
       connection_handle_factory_(connection_handle_factory),
       thread_registry_(thread_registry),
@@ -54,29 +56,36 @@ ConnectionDispatcherTask::ConnectionDispatcherTask(
 
 void ConnectionDispatcherTask::DispatchConnection(uint32_t fd,
                                                   common::ManagedPointer<ProtocolInterpreterProvider> provider) {
-  // Wait for a new socket connection. Currently, addr and addrlen are unused.
-  struct sockaddr_storage addr;
-  socklen_t addrlen = sizeof(addr);
-  int new_conn_fd = accept(fd, reinterpret_cast<struct sockaddr *>(&addr), &addrlen);
-  if (new_conn_fd == -1) {
-    NETWORK_LOG_ERROR("Failed to accept a new connection: {}", strerror(errno));
-    return;
+  // Drain the connections that queued up since the last wakeup. Currently, addr and addrlen are unused.
+  for (uint32_t num_accepted = 0; num_accepted < MAX_ACCEPTS_PER_WAKEUP; num_accepted++) {
+    struct sockaddr_storage addr;
+    socklen_t addrlen = sizeof(addr);
+    int new_conn_fd = accept(fd, reinterpret_cast<struct sockaddr *>(&addr), &addrlen);
+    if (new_conn_fd == -1) {
+      // The socket is non-blocking. No pending connection is not an error: the backlog was drained, or another
+      // dispatcher that watches the same socket got to the connection first.
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+      // The client gave up on a connection before it was accepted, the connections behind it may still be fine.
+      if (errno == ECONNABORTED || errno == EINTR) continue;
+      NETWORK_LOG_ERROR("Failed to accept a new connection: {}", strerror(errno));
+      return;
+    }
+
+    // A new connection was successfully established.
+    // Get a ConnectionHandlerTask to pass the new connection off to.
+    auto handler_id = NextDispatchHandlerOffset();
+    auto handler = handlers_[handler_id];
+    NETWORK_LOG_TRACE("Dispatching connection to worker {}.", first_handler_id_ + handler_id);
+
+    // Notify the chosen ConnectionHandlerTask that it received a new connection.
+    handler->Notify(new_conn_fd, provider);
   }
-
-  // A new connection was successfully established.
-  // Get a ConnectionHandlerTask to pass the new connection off to.
-  auto handler_id = NextDispatchHandlerOffset();
-  auto handler = handlers_[handler_id];
-  NETWORK_LOG_TRACE("Dispatching connection to worker {}.", handler_id);
-
-  // Notify the chosen ConnectionHandlerTask that it received a new connection.
-  handler->Notify(new_conn_fd, provider->Get());
 }
 
 void ConnectionDispatcherTask::RunTask() {
   // Create a pool of num_handlers_ many ConnectionHandlerTask instances.
   // The handler tasks are created using the same DedicatedThreadOwner as this ConnectionDispatcherTask.
-  for (uint32_t task_id = 0; task_id < num_handlers_; task_id++) {
+  for (uint32_t task_id = first_handler_id_; task_id < first_handler_id_ + num_handlers_; task_id++) {
     auto handler = thread_registry_->RegisterDedicatedThread<ConnectionHandlerTask>(dedicated_thread_owner_, task_id,
                                                                                     connection_handle_factory_);
     handlers_.push_back(handler);
@@ -98,8 +107,7 @@ void ConnectionDispatcherTask::Terminate() {
 
 uint64_t ConnectionDispatcherTask::NextDispatchHandlerOffset() {
   // Get the handler that the next connection should be dispatched to.
-  // This is round-robin.
-  // TODO(WAN): as inherited from Tianyu, we can be smarter about scheduling dispatch.
+  // This is round-robin over the handlers of this dispatcher, which are only ever touched by this dispatcher's thread.
   uint64_t handler_id = next_handler_;
   next_handler_ = (next_handler_ + 1) % handlers_.size();
   return handler_id;
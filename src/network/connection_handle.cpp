@@ -4,6 +4,7 @@
 #include "network/connection_dispatcher_task.h"
 #include "network/connection_handle_factory.h"
 #include "network/connection_handler_task.h"
+#include "network/execution_worker_pool.h"
 #include "network/network_io_wrapper.h"
 
 namespace noisepage::network {
@@ -137,13 +138,17 @@ void ConnectionHandle::StateMachine::Accept(Transition action, const common::Man
 
 ConnectionHandle::ConnectionHandle(int sock_fd, common::ManagedPointer<ConnectionHandlerTask> task,
                                    common::ManagedPointer<trafficcop::TrafficCop> tcop,
-                                   std::unique_ptr<ProtocolInterpreter> interpreter)
+                                   common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider,
+                                   common::ManagedPointer<ExecutionWorkerPool> execution_pool)
     : io_wrapper_(std::make_unique<NetworkIoWrapper>(sock_fd)),
       conn_handler_task_(task),
       traffic_cop_(tcop),
-      protocol_interpreter_(std::move(interpreter)) {
+      interpreter_provider_(interpreter_provider),
+      protocol_interpreter_(interpreter_provider->Get()),
+      execution_pool_(execution_pool) {
   context_.SetCallback(Callback, this);
   context_.SetConnectionID(static_cast<connection_id_t>(sock_fd));
+  context_.SetExecutionPool(execution_pool);
 }
 
 ConnectionHandle::~ConnectionHandle() = default;
@@ -179,17 +184,43 @@ Transition ConnectionHandle::TryWrite() {
 }
 
 Transition ConnectionHandle::Process() {
+  if (execution_pool_ != nullptr && protocol_interpreter_->ShouldProcessOnWorker(io_wrapper_->GetReadBuffer()) &&
+      execution_pool_->Submit(common::ManagedPointer(this))) {
+    // The packet was handed to an execution worker. Stop listening to the client until the worker wakes us up, the
+    // worker owns the buffers and the connection context until then.
+    return Transition::NEED_RESULT;
+  }
+  return ProcessPacket();
+}
+
+Transition ConnectionHandle::ProcessPacket() {
   auto transition = protocol_interpreter_->Process(io_wrapper_->GetReadBuffer(), io_wrapper_->GetWriteQueue(),
                                                    traffic_cop_, common::ManagedPointer(&context_));
   return transition;
 }
 
+void ConnectionHandle::ProcessOnWorker() {
+  Transition transition;
+  try {
+    transition = ProcessPacket();
+  } catch (const NetworkProcessException &e) {
+    // Mirror StateMachine::Accept, which would have caught this on the handler thread.
+    NETWORK_LOG_ERROR("{0}\n", e.what());
+    transition = Transition::TERMINATE;
+  }
+  worker_transition_ = transition;
+  // Nothing may touch this handle past this point: the handler thread may resume it as soon as it is woken up.
+  Callback(this);
+}
+
 Transition ConnectionHandle::GetResult() {
-  // Wait until a network event happens.
+  // Resume listening to the client, which stopped when the packet was handed to an execution worker.
   EventUtil::EventAdd(network_event_, EventUtil::WAIT_FOREVER);
-  // TODO(WAN): It is not clear to me what this function is doing. If someone figures it out, please update comment.
   protocol_interpreter_->GetResult(io_wrapper_->GetWriteQueue());
-  return Transition::PROCEED;
+  // Continue with whatever processing the packet led to, as if it had been processed on this thread.
+  auto transition = worker_transition_;
+  worker_transition_ = Transition::PROCEED;
+  return transition;
 }
 
 Transition ConnectionHandle::TryCloseConnection() {
@@ -212,6 +243,8 @@ Transition ConnectionHandle::TryCloseConnection() {
   conn_handler_task_->UnregisterEvent(network_event_);
   conn_handler_task_->UnregisterEvent(workpool_event_);
 
+  // Nothing touches this handle after this transition, so the next connection of the task can take it over.
+  conn_handler_task_->ReleaseConnectionHandle(common::ManagedPointer(this));
   return Transition::NONE;
 }
 
@@ -238,25 +271,32 @@ void ConnectionHandle::UpdateEventFlags(int16_t flags, int timeout_secs) {
 void ConnectionHandle::StopReceivingNetworkEvent() { EventUtil::EventDel(network_event_); }
 
 void ConnectionHandle::Callback(void *callback_args) {
-  // TODO(WAN): this is currently unused.
+  // Called by the ExecutionWorkerPool once a packet has been processed. This runs on the worker thread, which is safe
+  // because libevent is initialized for multithreaded use (see TerrierServer::RunServer).
   auto *const handle = reinterpret_cast<ConnectionHandle *>(callback_args);
   NOISEPAGE_ASSERT(handle->state_machine_.CurrentState() == ConnState::PROCESS,
                    "Should be waking up a ConnectionHandle that's in PROCESS state waiting on query result.");
   event_active(handle->workpool_event_, EV_WRITE, 0);
 }
 
-void ConnectionHandle::ResetForReuse(connection_id_t connection_id, common::ManagedPointer<ConnectionHandlerTask> task,
-                                     std::unique_ptr<ProtocolInterpreter> interpreter) {
-  io_wrapper_->Restart();
+void ConnectionHandle::ResetForReuse(const int sock_fd, common::ManagedPointer<ConnectionHandlerTask> task,
+                                     common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider) {
+  io_wrapper_->Restart(sock_fd);
   conn_handler_task_ = task;
   // TODO(WAN): the same traffic cop is kept because the ConnectionHandleFactory always uses the same traffic cop
   //  anyway, but if this ever changes then we'll need to revisit this.
-  protocol_interpreter_ = std::move(interpreter);
+  if (interpreter_provider == interpreter_provider_) {
+    protocol_interpreter_->ResetForReuse();
+  } else {
+    interpreter_provider_ = interpreter_provider;
+    protocol_interpreter_ = interpreter_provider->Get();
+  }
   state_machine_ = ConnectionHandle::StateMachine();
   network_event_ = nullptr;
   workpool_event_ = nullptr;
+  worker_transition_ = Transition::PROCEED;
   context_.Reset();
-  context_.SetConnectionID(connection_id);
+  context_.SetConnectionID(static_cast<connection_id_t>(sock_fd));
 }
 
 }  // namespace noisepage::network
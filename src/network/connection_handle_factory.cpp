@@ -1,32 +1,28 @@
 #include "network/connection_handle_factory.h"
 
 #include "network/connection_handle.h"
+#include "network/connection_handler_task.h"
 #include "network/protocol_interpreter.h"
 
 namespace noisepage::network {
-ConnectionHandle &ConnectionHandleFactory::NewConnectionHandle(int conn_fd,
-                                                               std::unique_ptr<ProtocolInterpreter> interpreter,
-                                                               common::ManagedPointer<ConnectionHandlerTask> task) {
-  // Check if a mapping for the file descriptor already exists.
-  std::unordered_map<int, ConnectionHandle>::iterator it;
-  {
-    // Latch to prevent TOCTOU in between find() and try_emplace().
-    common::SpinLatch::ScopedSpinLatch guard(&reusable_handles_latch_);
-
-    it = reusable_handles_.find(conn_fd);
-    // If no mapping exists for the file descriptor, a new mapping is created.
-    if (it == reusable_handles_.end()) {
-      auto ret = reusable_handles_.try_emplace(conn_fd, conn_fd, task, traffic_cop_, std::move(interpreter));
-      NOISEPAGE_ASSERT(ret.second, "TOCTOU bug in reusable_handles_.");
-      return ret.first->second;
-    }
+ConnectionHandle &ConnectionHandleFactory::NewConnectionHandle(
+    int conn_fd, common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider,
+    common::ManagedPointer<ConnectionHandlerTask> task) {
+  // Reuse a handle that a closed connection of the same task gave back. Its buffers are kept, and so is its protocol
+  // interpreter if the connection speaks the same protocol.
+  auto reused_handle = task->AcquireConnectionHandle();
+  if (reused_handle != nullptr) {
+    reused_handle->ResetForReuse(conn_fd, task, interpreter_provider);
+    return *reused_handle;
   }
 
-  // An existing mapping for the file descriptor was found.
-  // It is assumed that the old mapping is no longer in use, so it is reused.
-  // TODO(WAN): How do we check that the mapping is actually no longer in use?
-  auto &reused_handle = it->second;
-  reused_handle.ResetForReuse(connection_id_t(conn_fd), task, std::move(interpreter));
-  return reused_handle;
+  auto handle = std::make_unique<ConnectionHandle>(conn_fd, task, traffic_cop_, interpreter_provider, execution_pool_);
+  auto &new_handle = *handle;
+  {
+    // Handler tasks create handles concurrently.
+    common::SpinLatch::ScopedSpinLatch guard(&handles_latch_);
+    handles_.emplace_back(std::move(handle));
+  }
+  return new_handle;
 }
 }  // namespace noisepage::network
@@ -16,13 +16,14 @@ ConnectionHandlerTask::ConnectionHandlerTask(const int task_id,
   notify_event_ = RegisterEvent(EventUtil::EVENT_ACTIVATE_OR_TIMEOUT_ONLY, EV_READ | EV_PERSIST, handle_dispatch, this);
 }
 
-void ConnectionHandlerTask::Notify(int conn_fd, std::unique_ptr<ProtocolInterpreter> protocol_interpreter) {
+void ConnectionHandlerTask::Notify(int conn_fd,
+                                   common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider) {
   // Add the new connection to the list of jobs to be handled.
   {
     // This latch prevents a race where one thread is calling Notify to add to the list of jobs, and
     // another thread is calling HandleDispatch to consume the list of jobs.
     common::SpinLatch::ScopedSpinLatch guard(&jobs_latch_);
-    jobs_.emplace_back(conn_fd, std::move(protocol_interpreter));
+    jobs_.emplace_back(conn_fd, interpreter_provider);
   }
   // Signal that there are jobs to be dispatched.
   event_active(notify_event_, 0 /* dummy arg */, 0 /* dummy arg */);
@@ -30,10 +31,10 @@ void ConnectionHandlerTask::Notify(int conn_fd, std::unique_ptr<ProtocolInterpre
 
 void ConnectionHandlerTask::HandleDispatch() {
   common::SpinLatch::ScopedSpinLatch guard(&jobs_latch_);
-  // For each connection that needs to be handled, a new ConnectionHandle is created and marked as ready to receive.
-  for (auto &job : jobs_) {
+  // For each connection that needs to be handled, a ConnectionHandle is created or reused and marked ready to receive.
+  for (const auto &job : jobs_) {
     auto task = common::ManagedPointer<ConnectionHandlerTask>(this);
-    auto &handle = connection_handle_factory_->NewConnectionHandle(job.first, std::move(job.second), task);
+    auto &handle = connection_handle_factory_->NewConnectionHandle(job.first, job.second, task);
     handle.RegisterToReceiveEvents();
   }
   jobs_.clear();
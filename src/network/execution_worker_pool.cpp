@@ -0,0 +1,114 @@
+#include "network/execution_worker_pool.h"
+
+#include "common/thread_context.h"
+#include "metrics/metrics_manager.h"
+#include "network/connection_handle.h"
+
+namespace noisepage::network {
+
+ExecutionWorkerPool::ExecutionWorkerPool(const uint32_t num_workers, const uint32_t max_blocking_workers,
+                                         const common::ManagedPointer<metrics::MetricsManager> metrics_manager)
+    : workers_(num_workers, {}), metrics_manager_(metrics_manager), max_blocking_workers_(max_blocking_workers) {
+  NOISEPAGE_ASSERT(max_blocking_workers > 0, "An execution worker pool needs at least one thread for blocking tasks.");
+  workers_.Startup();
+}
+
+bool ExecutionWorkerPool::Submit(const common::ManagedPointer<ConnectionHandle> handle) {
+  std::lock_guard<std::mutex> guard(running_mutex_);
+  if (!running_ || workers_.NumWorkers() == 0) return false;
+  num_pending_.fetch_add(1, std::memory_order_relaxed);
+  workers_.SubmitTask([this, handle] {
+    // Metrics are recorded into thread-local stores. Dedicated threads register with the metrics manager when they
+    // start, but the workers are plain threads, so they register on their first task. The registration is undone by
+    // the thread_context destructor when the worker exits.
+    if (metrics_manager_ != DISABLED && common::thread_context.metrics_store_ == nullptr) {
+      metrics_manager_->RegisterThread();
+    }
+    handle->ProcessOnWorker();
+    num_pending_.fetch_sub(1, std::memory_order_relaxed);
+  });
+  return true;
+}
+
+bool ExecutionWorkerPool::SubmitBlocking(const common::ManagedPointer<BlockingTask> task) {
+  std::lock_guard<std::mutex> guard(blocking_mutex_);
+  if (!blocking_running_) return false;
+  JoinExitedBlockingWorkers();
+  if (num_idle_blocking_workers_ > 0) {
+    num_idle_blocking_workers_--;
+    blocking_queue_.push_back(task.Get());
+    blocking_cv_.notify_one();
+    return true;
+  }
+  // Every thread is stuck in a task that may not return any time soon, so waiting for one is not an option
+  if (blocking_workers_.size() >= max_blocking_workers_) return false;
+  blocking_queue_.push_back(task.Get());
+  // The thread takes the latch before it looks at its iterator, which is assigned under the latch
+  const auto worker = blocking_workers_.emplace(blocking_workers_.end());
+  *worker = std::thread([this, worker] { RunBlockingTasks(worker); });
+  return true;
+}
+
+void ExecutionWorkerPool::RunBlockingTasks(const std::list<std::thread>::iterator worker) {
+  // The thread is new, so it has not registered with the metrics manager yet. See Submit().
+  if (metrics_manager_ != DISABLED) metrics_manager_->RegisterThread();
+
+  std::unique_lock<std::mutex> lock(blocking_mutex_);
+  while (true) {
+    if (blocking_queue_.empty() && blocking_running_) {
+      num_idle_blocking_workers_++;
+      const bool woken = blocking_cv_.wait_for(lock, BLOCKING_WORKER_IDLE_TIMEOUT,
+                                               [this] { return !blocking_queue_.empty() || !blocking_running_; });
+      if (!woken) {
+        // Nobody submitted a task in the meantime, so the thread is still counted as idle
+        num_idle_blocking_workers_--;
+        exited_blocking_workers_.splice(exited_blocking_workers_.end(), blocking_workers_, worker);
+        return;
+      }
+    }
+    // Tasks queued when the pool shut down were cancelled, but still run so that they are finished
+    if (blocking_queue_.empty()) return;
+    auto *const task = blocking_queue_.front();
+    blocking_queue_.pop_front();
+    running_blocking_tasks_.insert(task);
+
+    lock.unlock();
+    task->Run();
+    lock.lock();
+
+    // Under the latch, so that Shutdown() cannot cancel the task once its owner may destroy it
+    running_blocking_tasks_.erase(task);
+    task->Finished();
+  }
+}
+
+void ExecutionWorkerPool::JoinExitedBlockingWorkers() {
+  // The threads only return after they moved themselves here, so the joins do not wait for long
+  for (auto &worker : exited_blocking_workers_) worker.join();
+  exited_blocking_workers_.clear();
+}
+
+void ExecutionWorkerPool::Shutdown() {
+  {
+    std::lock_guard<std::mutex> guard(running_mutex_);
+    if (!running_) return;
+    running_ = false;
+  }
+  workers_.WaitUntilAllFinished();
+  workers_.Shutdown();
+
+  // Blocking tasks may wait for a client forever, so they are stopped instead of waited for
+  {
+    std::lock_guard<std::mutex> guard(blocking_mutex_);
+    blocking_running_ = false;
+    for (auto *const task : blocking_queue_) task->Cancel();
+    for (auto *const task : running_blocking_tasks_) task->Cancel();
+  }
+  blocking_cv_.notify_all();
+  // Threads no longer exit on their own, so the lists do not change anymore
+  for (auto &worker : blocking_workers_) worker.join();
+  blocking_workers_.clear();
+  JoinExitedBlockingWorkers();
+}
+
+}  // namespace noisepage::network
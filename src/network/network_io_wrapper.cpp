@@ -32,10 +32,17 @@ Transition NetworkIoWrapper::Close() {
   return Transition::PROCEED;
 }
 
-void NetworkIoWrapper::Restart() { RestartState(); }
+void NetworkIoWrapper::Restart(const int sock_fd) {
+  sock_fd_ = sock_fd;
+  RestartState();
+}
 
 Transition NetworkIoWrapper::FillReadBuffer() {
-  if (!in_->HasMore()) in_->Reset();
+  if (!in_->HasMore()) {
+    in_->Reset();
+    // Give back the memory of a message that required growing the buffer
+    in_->ShrinkIfEmpty();
+  }
   // If the read buffer still has content and the read buffer is full,
   // then the read buffer's contents is moved to the head.
   if (in_->HasMore() && in_->Full()) in_->MoveContentToHead();
@@ -115,6 +122,8 @@ void NetworkIoWrapper::RestartState() {
   }
 
   in_->Reset();
+  // Give back the memory of a large message that the previous connection on these buffers left behind
+  in_->ShrinkIfEmpty();
   out_->Reset();
 }
 
@@ -1,9 +1,12 @@
 #include "network/noisepage_server.h"
 
 #include <event2/thread.h>
+#include <fcntl.h>
 #include <sys/un.h>
 
+#include <algorithm>
 #include <csignal>
+#include <utility>
 
 #include "common/dedicated_thread_registry.h"
 #include "common/settings.h"
@@ -11,20 +14,25 @@
 #include "loggers/network_logger.h"
 #include "network/connection_dispatcher_task.h"
 #include "network/connection_handle_factory.h"
+#include "network/execution_worker_pool.h"
 
 namespace noisepage::network {
 
 TerrierServer::TerrierServer(common::ManagedPointer<ProtocolInterpreterProvider> protocol_provider,
                              common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory,
                              common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
-                             const uint16_t port, const uint16_t connection_thread_count, std::string socket_directory)
+                             const uint16_t port, const uint16_t connection_thread_count, std::string socket_directory,
+                             const uint16_t acceptor_count, common::ManagedPointer<ExecutionWorkerPool> execution_pool)
     : DedicatedThreadOwner(thread_registry),
       running_(false),
       port_(port),
       socket_directory_(std::move(socket_directory)),
       max_connections_(connection_thread_count),
+      // Every acceptor needs at least one handler thread of its own.
+      acceptor_count_(std::clamp<uint16_t>(acceptor_count, 1, connection_thread_count)),
       connection_handle_factory_(connection_handle_factory),
-      provider_(protocol_provider) {
+      provider_(protocol_provider),
+      execution_pool_(execution_pool) {
   // If a client disconnects, the server receives a broken pipe signal SIGPIPE.
   // SIGPIPE by default will kill the server process, which is a bad idea.
   // Instead, the server ignores SIGPIPE.
@@ -36,15 +44,13 @@ TerrierServer::TerrierServer(common::ManagedPointer<ProtocolInterpreterProvider>
 }
 
 template <TerrierServer::SocketType type>
-void TerrierServer::RegisterSocket() {
+int TerrierServer::RegisterSocket() {
   static_assert(type == NETWORKED_SOCKET || type == UNIX_DOMAIN_SOCKET, "There should only be two socket types.");
 
   constexpr auto conn_backlog = common::Settings::CONNECTION_BACKLOG;
   constexpr auto is_networked_socket = type == NETWORKED_SOCKET;
   constexpr auto socket_description = std::string_view(is_networked_socket ? "networked" : "Unix domain");
 
-  auto &socket_fd = is_networked_socket ? network_socket_fd_ : unix_domain_socket_fd_;
-
   // Get the appropriate sockaddr for the given SocketType. Abuse a lambda and auto to specialize the type.
   auto socket_addr = ([&] {
     if constexpr (is_networked_socket) {  // NOLINT
@@ -75,7 +81,7 @@ void TerrierServer::RegisterSocket() {
   })();
 
   // Create a new socket.
-  socket_fd = socket(is_networked_socket ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+  const int socket_fd = socket(is_networked_socket ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
 
   // Check if the socket was successfully created.
   if (socket_fd < 0) {
@@ -90,9 +96,23 @@ void TerrierServer::RegisterSocket() {
   // time (2 * /proc/sys/net/ipv4/tcp_fin_timeout seconds). This means that when a new server
   // comes along and tries to rebind to the same (IP address, TCP port), the socket binding
   // will fail. Enabling SO_REUSEADDR opts out of this protection.
+  //
+  // With several acceptors, SO_REUSEPORT lets each of them bind a socket of its own to the port. The kernel then
+  // spreads incoming connections across the sockets, so the acceptors do not contend over a single accept queue.
   if constexpr (is_networked_socket) {  // NOLINT
     int reuse = 1;
     setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (acceptor_count_ > 1 && setsockopt(socket_fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0) {
+      throw NETWORK_PROCESS_EXCEPTION(
+          fmt::format("Failed to enable SO_REUSEPORT on {} socket: {}", socket_description, strerror(errno)));
+    }
+  }
+
+  // Make the socket non-blocking, so that a dispatcher can drain its pending connections until accept() would block.
+  const int flags = fcntl(socket_fd, F_GETFL);
+  if (flags < 0 || fcntl(socket_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    throw NETWORK_PROCESS_EXCEPTION(
+        fmt::format("Failed to make {} socket non-blocking: {}", socket_description, strerror(errno)));
   }
 
   // Bind the socket.
@@ -130,22 +150,31 @@ void TerrierServer::RegisterSocket() {
   }
 
   NETWORK_LOG_INFO("Listening on {} socket with port {} [PID={}]", socket_description, port_, ::getpid());
+  return socket_fd;
 }
 
 void TerrierServer::RunServer() {
   // Initialize thread support for libevent as libevent will be invoked from multiple ConnectionHandlerTask threads.
   evthread_use_pthreads();
 
-  // Register the network socket.
-  RegisterSocket<NETWORKED_SOCKET>();
+  // Register a network socket for every acceptor.
+  for (uint16_t acceptor = 0; acceptor < acceptor_count_; acceptor++) {
+    network_socket_fds_.emplace_back(RegisterSocket<NETWORKED_SOCKET>());
+  }
 
   // Register the Unix domain socket.
-  RegisterSocket<UNIX_DOMAIN_SOCKET>();
-
-  // Register the ConnectionDispatcherTask. This handles connections to the sockets created above.
-  dispatcher_task_ = thread_registry_->RegisterDedicatedThread<ConnectionDispatcherTask>(
-      this, max_connections_, this, common::ManagedPointer(provider_.Get()), connection_handle_factory_,
-      thread_registry_, std::initializer_list<int>({unix_domain_socket_fd_, network_socket_fd_}));
+  unix_domain_socket_fd_ = RegisterSocket<UNIX_DOMAIN_SOCKET>();
+
+  // Register the ConnectionDispatcherTasks. These handle connections to the sockets created above. The handler threads
+  // are split as evenly as possible among them.
+  uint32_t first_handler_id = 0;
+  for (uint16_t acceptor = 0; acceptor < acceptor_count_; acceptor++) {
+    const uint32_t num_handlers = max_connections_ / acceptor_count_ + (acceptor < max_connections_ % acceptor_count_);
+    dispatcher_tasks_.emplace_back(thread_registry_->RegisterDedicatedThread<ConnectionDispatcherTask>(
+        this, num_handlers, first_handler_id, this, common::ManagedPointer(provider_.Get()), connection_handle_factory_,
+        thread_registry_, std::initializer_list<int>({unix_domain_socket_fd_, network_socket_fds_[acceptor]})));
+    first_handler_id += num_handlers;
+  }
 
   // Set the running_ flag for any waiting threads.
   {
@@ -155,16 +184,25 @@ void TerrierServer::RunServer() {
 }
 
 void TerrierServer::StopServer() {
-  // Stop the dispatcher task and close the socket's file descriptor.
-  const bool is_task_stopped UNUSED_ATTRIBUTE =
-      thread_registry_->StopTask(this, dispatcher_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  NOISEPAGE_ASSERT(is_task_stopped, "Failed to stop ConnectionDispatcherTask.");
+  // Let the execution workers finish first: they wake up connections on the handler threads stopped below.
+  if (execution_pool_ != nullptr) execution_pool_->Shutdown();
+
+  // Stop the dispatcher tasks and close the sockets' file descriptors.
+  for (const auto &dispatcher_task : dispatcher_tasks_) {
+    const bool is_task_stopped UNUSED_ATTRIBUTE =
+        thread_registry_->StopTask(this, dispatcher_task.CastManagedPointerTo<common::DedicatedThreadTask>());
+    NOISEPAGE_ASSERT(is_task_stopped, "Failed to stop ConnectionDispatcherTask.");
+  }
+  dispatcher_tasks_.clear();
 
-  // Close the network socket
-  TerrierClose(network_socket_fd_);
+  // Close the network sockets
+  for (const auto network_socket_fd : network_socket_fds_) TerrierClose(network_socket_fd);
+  network_socket_fds_.clear();
 
   // Close the Unix domain socket if it exists
   if (unix_domain_socket_fd_ >= 0) {
+    TerrierClose(unix_domain_socket_fd_);
+    unix_domain_socket_fd_ = -1;
     std::remove(fmt::format(UNIX_DOMAIN_SOCKET_FORMAT_STRING, socket_directory_, port_).c_str());
   }
 
@@ -0,0 +1,113 @@
+#include "network/postgres/portal_execution.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace noisepage::network {
+
+std::optional<trafficcop::TrafficCopResult> PortalExecution::Fetch(const uint32_t max_rows, uint32_t *const num_rows) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  fetched_rows_ = 0;
+  if (closed_) {
+    // The transaction ended, or the pool stopped the query because it shut down
+    cv_.wait(lock, [this] { return !started_ || finished_; });
+    *num_rows = 0;
+    return trafficcop::TrafficCopResult{
+        trafficcop::ResultType::ERROR,
+        common::ErrorData(common::ErrorSeverity::ERROR, "portal was closed before its query finished",
+                          common::ErrorCode::ERRCODE_INVALID_CURSOR_STATE)};
+  }
+  if (result_.has_value()) {
+    // The query finished with an earlier Fetch(), there is nothing left to write
+    *num_rows = 0;
+    return result_;
+  }
+
+  remaining_rows_ = max_rows == 0 ? std::numeric_limits<uint32_t>::max() : max_rows;
+  suspended_ = false;
+  if (!started_) {
+    started_ = true;
+    // The pool calls back into the execution with its own latch held, so it is not called with ours
+    lock.unlock();
+    const bool submitted =
+        execution_pool_ != nullptr && execution_pool_->SubmitBlocking(common::ManagedPointer<BlockingTask>(this));
+    lock.lock();
+    if (!submitted) {
+      // The query never runs, so the portal is as good as finished
+      finished_ = true;
+      result_ = trafficcop::TrafficCopResult{
+          trafficcop::ResultType::ERROR,
+          common::ErrorData(common::ErrorSeverity::ERROR,
+                            "too many portals are running their queries, or the server is shutting down",
+                            common::ErrorCode::ERRCODE_CONFIGURATION_LIMIT_EXCEEDED)};
+    }
+  } else {
+    cv_.notify_all();
+  }
+  cv_.wait(lock, [this] { return suspended_ || result_.has_value(); });
+
+  *num_rows = fetched_rows_;
+  if (result_.has_value()) return result_;
+  return std::nullopt;
+}
+
+void PortalExecution::Close() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  closed_ = true;
+  cv_.notify_all();
+  cv_.wait(lock, [this] { return !started_ || finished_; });
+}
+
+void PortalExecution::Run() {
+  auto result = runner_(common::ManagedPointer(&writer_), common::ManagedPointer<PortalExecution>(this));
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    result_ = std::move(result);
+  }
+  cv_.notify_all();
+}
+
+void PortalExecution::Cancel() {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    closed_ = true;
+  }
+  cv_.notify_all();
+}
+
+void PortalExecution::Finished() {
+  // Notify with the latch held: Close() may destroy the execution as soon as it sees finished_
+  std::lock_guard<std::mutex> guard(mutex_);
+  finished_ = true;
+  cv_.notify_all();
+}
+
+uint32_t PortalExecution::AwaitRows(const uint32_t num_rows) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (remaining_rows_ == 0 && !closed_) {
+    // The client got the rows it asked for, hand control back to it until the next Fetch(). The hooks may block, so
+    // they run without the latch. Fetch() keeps waiting for the query in the meantime.
+    if (on_suspend_) {
+      lock.unlock();
+      on_suspend_();
+      lock.lock();
+    }
+    suspended_ = true;
+    cv_.notify_all();
+    cv_.wait(lock, [this] { return remaining_rows_ > 0 || closed_; });
+    if (!closed_ && on_resume_) {
+      lock.unlock();
+      const bool may_resume = on_resume_();
+      lock.lock();
+      if (!may_resume) return 0;
+    }
+  }
+  if (closed_) return 0;
+
+  const auto allowed = std::min(num_rows, remaining_rows_);
+  remaining_rows_ -= allowed;
+  fetched_rows_ += allowed;
+  return allowed;
+}
+
+}  // namespace noisepage::network
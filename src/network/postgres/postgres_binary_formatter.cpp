@@ -0,0 +1,57 @@
+#include "network/postgres/postgres_binary_formatter.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "common/error/exception.h"
+#include "util/portable_endian.h"
+
+namespace noisepage::network {
+
+namespace {
+
+// Constants of the NUMERIC binary format, see numeric.c in Postgres
+constexpr uint16_t NUMERIC_POS = 0x0000;
+constexpr uint16_t NUMERIC_NEG = 0x4000;
+constexpr uint16_t NUMERIC_NAN = 0xC000;
+constexpr int16_t NUMERIC_NBASE = 10000;
+
+uint16_t ReadInt16(const std::string_view bytes, const size_t offset) {
+  uint16_t raw;
+  std::memcpy(&raw, bytes.data() + offset, sizeof(raw));
+  return be16toh(raw);
+}
+
+}  // namespace
+
+double PostgresBinaryFormatter::ParseNumeric(const std::string_view bytes) {
+  constexpr size_t header_length = 4 * sizeof(int16_t);
+  if (bytes.size() < header_length) throw NETWORK_PROCESS_EXCEPTION("NUMERIC value is too short.");
+  const auto num_digits = static_cast<int16_t>(ReadInt16(bytes, 0));
+  const auto weight = static_cast<int16_t>(ReadInt16(bytes, 2));
+  const auto sign = ReadInt16(bytes, 4);
+  if (num_digits < 0 || bytes.size() != header_length + num_digits * sizeof(int16_t)) {
+    throw NETWORK_PROCESS_EXCEPTION("Unexpected size for a NUMERIC value.");
+  }
+  if (sign == NUMERIC_NAN) return std::numeric_limits<double>::quiet_NaN();
+  if (sign != NUMERIC_POS && sign != NUMERIC_NEG) throw NETWORK_PROCESS_EXCEPTION("Invalid sign of a NUMERIC value.");
+
+  // Accumulate the digits as an integer first and scale by the weight once, so that a value like 0.1 comes out as the
+  // double closest to it
+  double result = 0;
+  for (int16_t i = 0; i < num_digits; i++) {
+    const auto digit = ReadInt16(bytes, header_length + i * sizeof(int16_t));
+    if (digit >= NUMERIC_NBASE) throw NETWORK_PROCESS_EXCEPTION("Invalid digit of a NUMERIC value.");
+    result = result * NUMERIC_NBASE + digit;
+  }
+  const int32_t exponent = weight - num_digits + 1;
+  if (exponent >= 0) {
+    result *= std::pow(static_cast<double>(NUMERIC_NBASE), exponent);
+  } else {
+    result /= std::pow(static_cast<double>(NUMERIC_NBASE), -exponent);
+  }
+  return sign == NUMERIC_NEG ? -result : result;
+}
+
+}  // namespace noisepage::network
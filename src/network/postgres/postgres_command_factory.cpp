@@ -20,6 +20,14 @@ std::unique_ptr<PostgresNetworkCommand> PostgresCommandFactory::PacketToCommand(
       return MAKE_POSTGRES_COMMAND(SyncCommand);
     case NetworkMessageType::PG_CLOSE_COMMAND:
       return MAKE_POSTGRES_COMMAND(CloseCommand);
+    case NetworkMessageType::PG_FLUSH_COMMAND:
+      return MAKE_POSTGRES_COMMAND(FlushCommand);
+    case NetworkMessageType::PG_COPY_DATA:
+      return MAKE_POSTGRES_COMMAND(CopyDataCommand);
+    case NetworkMessageType::PG_COPY_DONE:
+      return MAKE_POSTGRES_COMMAND(CopyDoneCommand);
+    case NetworkMessageType::PG_COPY_FAIL_COMMAND:
+      return MAKE_POSTGRES_COMMAND(CopyFailCommand);
     case NetworkMessageType::PG_TERMINATE_COMMAND:
       return MAKE_POSTGRES_COMMAND(TerminateCommand);
     default:
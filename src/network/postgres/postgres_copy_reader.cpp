@@ -0,0 +1,379 @@
+#include "network/postgres/postgres_copy_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/error/exception.h"
+#include "execution/sql/value.h"
+#include "network/postgres/postgres_defs.h"
+#include "network/postgres/postgres_packet_util.h"
+#include "spdlog/fmt/fmt.h"
+#include "type/type_util.h"
+#include "util/portable_endian.h"
+
+namespace noisepage::network {
+
+namespace {
+
+/** Read an int16 or int32 in network byte order. The caller checks that there are enough bytes. */
+template <typename T>
+T ReadNetworkInteger(const char *const bytes) {
+  static_assert(sizeof(T) == 2 || sizeof(T) == 4, "Invalid size for a COPY header field.");
+  if constexpr (sizeof(T) == 2) {
+    uint16_t raw;
+    std::memcpy(&raw, bytes, sizeof(raw));
+    return static_cast<T>(be16toh(raw));
+  } else {  // NOLINT: false positive on indentation with clang-tidy, fixed in upstream check-clang-tidy
+    uint32_t raw;
+    std::memcpy(&raw, bytes, sizeof(raw));
+    return static_cast<T>(be32toh(raw));
+  }
+}
+
+bool IsOctalDigit(const char c) { return c >= '0' && c <= '7'; }
+
+int32_t HexDigitValue(const char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+/**
+ * Decode the backslash escape of the text format that starts after the backslash at pos.
+ * @return position after the escape
+ */
+size_t Unescape(const std::string_view line, size_t pos, std::string *const out) {
+  if (pos == line.size()) throw NETWORK_PROCESS_EXCEPTION("unterminated escape sequence in COPY data");
+  const char c = line[pos++];
+  switch (c) {
+    case 'b':
+      *out += '\b';
+      return pos;
+    case 'f':
+      *out += '\f';
+      return pos;
+    case 'n':
+      *out += '\n';
+      return pos;
+    case 'r':
+      *out += '\r';
+      return pos;
+    case 't':
+      *out += '\t';
+      return pos;
+    case 'v':
+      *out += '\v';
+      return pos;
+    case 'x': {
+      // One or two hex digits, a lone \x is just an x
+      int32_t value = pos < line.size() ? HexDigitValue(line[pos]) : -1;
+      if (value < 0) {
+        *out += c;
+        return pos;
+      }
+      pos++;
+      if (pos < line.size() && HexDigitValue(line[pos]) >= 0) value = value * 16 + HexDigitValue(line[pos++]);
+      *out += static_cast<char>(value);
+      return pos;
+    }
+    default: {
+      if (!IsOctalDigit(c)) {
+        *out += c;
+        return pos;
+      }
+      // Up to three octal digits
+      int32_t value = c - '0';
+      for (uint32_t digits = 1; digits < 3 && pos < line.size() && IsOctalDigit(line[pos]); digits++) {
+        value = value * 8 + (line[pos++] - '0');
+      }
+      *out += static_cast<char>(value);
+      return pos;
+    }
+  }
+}
+
+}  // namespace
+
+bool PostgresCopyReader::SupportsType(const type::TypeId type, const parser::ExternalFileFormat format) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::REAL:
+    case type::TypeId::DATE:
+    case type::TypeId::VARCHAR:
+      return true;
+    case type::TypeId::TIMESTAMP:
+      return format != parser::ExternalFileFormat::BINARY;
+    default:
+      return false;
+  }
+}
+
+void PostgresCopyReader::Consume(const std::string_view data, std::vector<Row> *const rows) {
+  if (end_of_data_) return;
+
+  // Only a row that spans messages is copied, every other row is decoded straight out of the message
+  const bool buffered = !pending_.empty();
+  std::string_view input = data;
+  if (buffered) {
+    pending_.append(data);
+    input = pending_;
+  }
+  const auto consumed = Decode(input, false, rows);
+
+  if (end_of_data_) {
+    pending_.clear();
+  } else if (buffered) {
+    pending_.erase(0, consumed);
+  } else {
+    pending_.assign(input.substr(consumed));
+  }
+}
+
+void PostgresCopyReader::Finish(std::vector<Row> *const rows) {
+  if (end_of_data_) return;
+  const auto consumed = Decode(pending_, true, rows);
+  if (!end_of_data_ && consumed != pending_.size()) {
+    throw NETWORK_PROCESS_EXCEPTION("unexpected end of binary COPY data in the middle of a row");
+  }
+  pending_.clear();
+  end_of_data_ = true;
+}
+
+size_t PostgresCopyReader::Decode(const std::string_view input, const bool done, std::vector<Row> *const rows) {
+  switch (format_.format_) {
+    case parser::ExternalFileFormat::TEXT:
+      return DecodeText(input, done, rows);
+    case parser::ExternalFileFormat::CSV:
+      return DecodeCsv(input, done, rows);
+    case parser::ExternalFileFormat::BINARY:
+      return DecodeBinary(input, rows);
+  }
+  UNREACHABLE("Unknown COPY format.");
+}
+
+size_t PostgresCopyReader::DecodeText(const std::string_view input, const bool done, std::vector<Row> *const rows) {
+  size_t consumed = 0;
+  while (consumed < input.size()) {
+    auto line_end = input.find('\n', consumed);
+    if (line_end == std::string_view::npos) {
+      if (!done) break;
+      line_end = input.size();
+    }
+    auto line = input.substr(consumed, line_end - consumed);
+    consumed = std::min(line_end + 1, input.size());
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    if (line == POSTGRES_COPY_END_OF_DATA) {
+      end_of_data_ = true;
+      break;
+    }
+
+    Row row;
+    row.reserve(column_types_.size());
+    size_t pos = 0;
+    while (true) {
+      // Values without escapes are converted in place, the rest are unescaped into value_ first
+      size_t end = pos;
+      bool escaped = false;
+      while (end < line.size() && line[end] != format_.delimiter_) {
+        if (line[end] != '\\') {
+          if (escaped) value_ += line[end];
+          end++;
+          continue;
+        }
+        if (!escaped) {
+          value_.assign(line.substr(pos, end - pos));
+          escaped = true;
+        }
+        end = Unescape(line, end + 1, &value_);
+      }
+
+      const auto raw = line.substr(pos, end - pos);
+      if (row.size() == column_types_.size()) CheckColumnCount(row.size() + 1);
+      if (raw == POSTGRES_COPY_TEXT_NULL) {
+        row.emplace_back(column_types_[row.size()], execution::sql::Val(true));
+      } else {
+        row.emplace_back(TextValue(escaped ? std::string_view(value_) : raw, row.size()));
+      }
+      if (end == line.size()) break;
+      pos = end + 1;
+    }
+    CheckColumnCount(row.size());
+    rows->emplace_back(std::move(row));
+  }
+  return consumed;
+}
+
+size_t PostgresCopyReader::DecodeCsv(const std::string_view input, const bool done, std::vector<Row> *const rows) {
+  size_t consumed = 0;
+  while (consumed < input.size()) {
+    // The end-of-data marker has to be alone on its line and cannot be quoted
+    const auto rest = input.substr(consumed);
+    if (rest.substr(0, POSTGRES_COPY_END_OF_DATA.size()) == POSTGRES_COPY_END_OF_DATA) {
+      if (rest.size() == POSTGRES_COPY_END_OF_DATA.size()) {
+        if (!done) break;
+        end_of_data_ = true;
+        break;
+      }
+      const char next = rest[POSTGRES_COPY_END_OF_DATA.size()];
+      if (next == '\n' || next == '\r') {
+        end_of_data_ = true;
+        break;
+      }
+    } else if (!done && rest == POSTGRES_COPY_END_OF_DATA.substr(0, 1)) {
+      // Could still turn out to be the marker
+      break;
+    }
+
+    Row row;
+    row.reserve(column_types_.size());
+    size_t pos = consumed;
+    if (!DecodeCsvRow(input, done, &pos, &row)) break;
+    consumed = pos;
+    CheckColumnCount(row.size());
+    rows->emplace_back(std::move(row));
+  }
+  return consumed;
+}
+
+bool PostgresCopyReader::DecodeCsvRow(const std::string_view input, const bool done, size_t *const pos,
+                                      Row *const row) {
+  size_t i = *pos;
+  while (true) {
+    // Decode one value, which may mix quoted and unquoted parts
+    value_.clear();
+    bool in_quotes = false;
+    bool quoted = false;
+    bool end_of_row = false;
+    while (true) {
+      if (i == input.size()) {
+        if (!done) return false;
+        if (in_quotes) throw NETWORK_PROCESS_EXCEPTION("unterminated CSV quoted field");
+        end_of_row = true;
+        break;
+      }
+      const char c = input[i];
+      if (in_quotes) {
+        if (c == format_.escape_) {
+          // Whether the escape character escapes anything depends on the character after it
+          if (i + 1 == input.size() && !done) return false;
+          if (i + 1 < input.size() && (input[i + 1] == format_.quote_ || input[i + 1] == format_.escape_)) {
+            value_ += input[i + 1];
+            i += 2;
+            continue;
+          }
+        }
+        if (c == format_.quote_) in_quotes = false;
+        if (c != format_.quote_) value_ += c;
+        i++;
+        continue;
+      }
+      if (c == format_.quote_) {
+        in_quotes = quoted = true;
+        i++;
+        continue;
+      }
+      if (c == format_.delimiter_) {
+        i++;
+        break;
+      }
+      if (c == '\n' || c == '\r') {
+        // Both \n and \r\n end a row
+        if (c == '\r' && i + 1 == input.size() && !done) return false;
+        i += (c == '\r' && i + 1 < input.size() && input[i + 1] == '\n') ? 2 : 1;
+        end_of_row = true;
+        break;
+      }
+      value_ += c;
+      i++;
+    }
+
+    // Only an unquoted empty value is NULL, "" is an empty string
+    if (row->size() == column_types_.size()) CheckColumnCount(row->size() + 1);
+    if (!quoted && value_.empty()) {
+      row->emplace_back(column_types_[row->size()], execution::sql::Val(true));
+    } else {
+      row->emplace_back(TextValue(value_, row->size()));
+    }
+    if (end_of_row) break;
+  }
+  *pos = i;
+  return true;
+}
+
+size_t PostgresCopyReader::DecodeBinary(const std::string_view input, std::vector<Row> *const rows) {
+  size_t pos = 0;
+  if (!header_read_) {
+    // Signature, flags and the length of the header extension, which is skipped
+    const size_t fixed_size = POSTGRES_COPY_BINARY_SIGNATURE.size() + 2 * sizeof(int32_t);
+    if (input.size() < fixed_size) return 0;
+    if (input.substr(0, POSTGRES_COPY_BINARY_SIGNATURE.size()) != POSTGRES_COPY_BINARY_SIGNATURE) {
+      throw NETWORK_PROCESS_EXCEPTION("COPY file signature not recognized");
+    }
+    const auto flags = ReadNetworkInteger<int32_t>(input.data() + POSTGRES_COPY_BINARY_SIGNATURE.size());
+    if ((flags & (1 << 16)) != 0) throw NETWORK_PROCESS_EXCEPTION("COPY data with OIDs is not supported");
+    const auto extension_size = ReadNetworkInteger<int32_t>(input.data() + fixed_size - sizeof(int32_t));
+    if (extension_size < 0) throw NETWORK_PROCESS_EXCEPTION("invalid COPY file header (wrong length)");
+    if (input.size() < fixed_size + extension_size) return 0;
+    pos = fixed_size + extension_size;
+    header_read_ = true;
+  }
+
+  while (input.size() - pos >= sizeof(int16_t)) {
+    const size_t row_start = pos;
+    const auto num_values = ReadNetworkInteger<int16_t>(input.data() + pos);
+    pos += sizeof(int16_t);
+    if (num_values == -1) {
+      end_of_data_ = true;
+      return input.size();
+    }
+    CheckColumnCount(static_cast<size_t>(std::max<int16_t>(num_values, 0)));
+
+    Row row;
+    row.reserve(column_types_.size());
+    for (int16_t i = 0; i < num_values; i++) {
+      if (input.size() - pos < sizeof(int32_t)) return row_start;
+      const auto size = ReadNetworkInteger<int32_t>(input.data() + pos);
+      pos += sizeof(int32_t);
+      if (size == -1) {
+        row.emplace_back(column_types_[i], execution::sql::Val(true));
+        continue;
+      }
+      if (size < 0) throw NETWORK_PROCESS_EXCEPTION("invalid field size in binary COPY data");
+      if (input.size() - pos < static_cast<size_t>(size)) return row_start;
+      row.emplace_back(PostgresPacketUtil::BinaryValueToInternalValue(input.substr(pos, size), column_types_[i]));
+      pos += size;
+    }
+    rows->emplace_back(std::move(row));
+  }
+  return pos;
+}
+
+parser::ConstantValueExpression PostgresCopyReader::TextValue(const std::string_view text,
+                                                              const size_t num_values) const {
+  const auto type = column_types_[num_values];
+  try {
+    return PostgresPacketUtil::TextValueToInternalValue(text, type);
+  } catch (const std::exception &) {
+    throw CONVERSION_EXCEPTION(
+        fmt::format("invalid input syntax for type {}: \"{}\"", type::TypeUtil::TypeIdToString(type), text));
+  }
+}
+
+void PostgresCopyReader::CheckColumnCount(const size_t num_values) const {
+  if (num_values < column_types_.size()) {
+    throw NETWORK_PROCESS_EXCEPTION(fmt::format("missing data for column {}", num_values + 1));
+  }
+  if (num_values > column_types_.size()) {
+    throw NETWORK_PROCESS_EXCEPTION("extra data after last expected column");
+  }
+}
+
+}  // namespace noisepage::network
@@ -1,16 +1,25 @@
 #include "network/postgres/postgres_network_commands.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <variant>
+#include <vector>
 
+#include "catalog/catalog_accessor.h"
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
 #include "network/network_util.h"
+#include "network/postgres/portal_execution.h"
 #include "network/postgres/postgres_packet_util.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
 #include "network/postgres/statement.h"
+#include "parser/copy_statement.h"
+#include "spdlog/fmt/fmt.h"
 #include "traffic_cop/traffic_cop.h"
+#include "traffic_cop/traffic_cop_util.h"
 
 namespace noisepage::network {
 
@@ -29,8 +38,9 @@ static void ExecutePortal(const common::ManagedPointer<network::ConnectionContex
   const auto query_type = portal->GetStatement()->GetQueryType();
   const auto physical_plan = portal->OptimizeResult()->GetPlanNode();
 
-  // This logic relies on ordering of values in the enum's definition and is documented there as well.
-  if (NetworkUtil::DMLQueryType(query_type)) {
+  // This logic relies on ordering of values in the enum's definition and is documented there as well. COPY TO STDOUT
+  // runs its query like a SELECT.
+  if (NetworkUtil::DMLQueryType(query_type) || query_type == network::QueryType::QUERY_COPY) {
     // DML query to put through codegen
     result = t_cop->CodegenPhysicalPlan(connection_ctx, out, portal);
 
@@ -77,6 +87,230 @@ static void ExecutePortal(const common::ManagedPointer<network::ConnectionContex
   }
 }
 
+/**
+ * Runs a SELECT portal for an Execute message with a row limit, or resumes the query that an earlier Execute suspended.
+ * The query is suspended again once it wrote max_rows rows.
+ * @param max_rows maximum number of rows to write, 0 for no limit
+ */
+static void FetchPortal(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                        const common::ManagedPointer<Portal> portal,
+                        const common::ManagedPointer<network::PostgresPacketWriter> out,
+                        const common::ManagedPointer<trafficcop::TrafficCop> t_cop, const uint32_t max_rows) {
+  if (portal->Execution() == nullptr) {
+    t_cop->CodegenPhysicalPlan(connection_ctx, out, portal);
+    portal->SetExecution(std::make_unique<PortalExecution>(
+        out->GetWriteQueue(), [=](const common::ManagedPointer<PostgresPacketWriter> writer,
+                                  const common::ManagedPointer<PortalExecution> execution) {
+          return t_cop->RunExecutableQuery(connection_ctx, writer, portal, execution);
+        },
+        connection_ctx->ExecutionPool()));
+  }
+
+  uint32_t num_rows;
+  const auto result = portal->Execution()->Fetch(max_rows, &num_rows);
+  if (!result.has_value()) {
+    out->WritePortalSuspended();
+  } else if (result->type_ == trafficcop::ResultType::COMPLETE) {
+    // Like Postgres, the command tag counts the rows of this Execute, not those of the whole portal
+    out->WriteCommandComplete(QueryType::QUERY_SELECT, num_rows);
+  } else {
+    NOISEPAGE_ASSERT(result->type_ == trafficcop::ResultType::ERROR,
+                     "Currently only expecting COMPLETE or ERROR from TrafficCop here.");
+    out->WriteError(std::get<common::ErrorData>(result->extra_));
+  }
+}
+
+/**
+ * Prepares the INSERT of a COPY FROM STDIN, which takes the values of num_rows rows as its parameters, and compiles it.
+ * @param insert_into the INSERT up to its VALUES, naming the table and the columns the COPY fills in
+ * @return the statement and its compiled portal, or null pointers if an error was written instead
+ */
+static std::pair<std::unique_ptr<Statement>, std::unique_ptr<Portal>> PrepareCopyInsert(
+    const common::ManagedPointer<PostgresPacketWriter> out, const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+    const common::ManagedPointer<ConnectionContext> connection, const std::string &insert_into,
+    const std::vector<type::TypeId> &column_types, const size_t num_rows) {
+  const auto fail = [=](const common::ErrorData &error) {
+    out->WriteError(error);
+    connection->Transaction()->SetMustAbort();
+    return std::make_pair(std::unique_ptr<Statement>(nullptr), std::unique_ptr<Portal>(nullptr));
+  };
+
+  // VALUES ($1, $2), ($3, $4), ... with one parameter for every column of every row
+  std::string query_text = insert_into + " VALUES ";
+  std::vector<type::TypeId> param_types;
+  param_types.reserve(num_rows * column_types.size());
+  for (size_t row = 0; row < num_rows; row++) {
+    query_text += row == 0 ? "(" : ", (";
+    for (size_t i = 0; i < column_types.size(); i++) {
+      query_text += (i == 0 ? "$" : ", $") + std::to_string(param_types.size() + 1);
+      param_types.emplace_back(column_types[i]);
+    }
+    query_text += ")";
+  }
+
+  auto parse_result = t_cop->ParseQuery(query_text, connection);
+  if (std::holds_alternative<common::ErrorData>(parse_result)) {
+    return fail(std::get<common::ErrorData>(parse_result));
+  }
+  auto statement = std::make_unique<Statement>(std::move(query_text),
+                                               std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse_result)),
+                                               std::vector<type::TypeId>(param_types));
+
+  // Bind with typed NULLs in place of the rows, they only tell the binder the types of the parameters
+  std::vector<parser::ConstantValueExpression> params;
+  params.reserve(param_types.size());
+  for (const auto type : param_types) params.emplace_back(type, execution::sql::Val(true));
+  const auto bind_result =
+      t_cop->BindQuery(connection, common::ManagedPointer(statement), common::ManagedPointer(&params));
+  if (bind_result.type_ != trafficcop::ResultType::COMPLETE) {
+    NOISEPAGE_ASSERT(std::holds_alternative<common::ErrorData>(bind_result.extra_), "We're expecting a message here.");
+    return fail(std::get<common::ErrorData>(bind_result.extra_));
+  }
+  statement->SetOptimizeResult(
+      t_cop->OptimizeBoundQuery(connection, statement->ParseResult(), common::ManagedPointer(&params)));
+  auto portal = std::make_unique<Portal>(common::ManagedPointer(statement), std::move(params),
+                                         std::vector<FieldFormat>{FieldFormat::text});
+  const auto codegen_result = t_cop->CodegenPhysicalPlan(connection, out, common::ManagedPointer(portal));
+  if (codegen_result.type_ != trafficcop::ResultType::COMPLETE) {
+    NOISEPAGE_ASSERT(std::holds_alternative<common::ErrorData>(codegen_result.extra_),
+                     "We're expecting a message here.");
+    return fail(std::get<common::ErrorData>(codegen_result.extra_));
+  }
+  return std::make_pair(std::move(statement), std::move(portal));
+}
+
+/**
+ * Starts a COPY FROM STDIN. Its rows are inserted with INSERTs that take the values of the rows as parameters, which
+ * are compiled here once for the whole COPY: one for ROWS_PER_INSERT rows at a time and one for the rows left over.
+ * @return true if the client was asked for the rows, false if an error was written instead
+ */
+static bool BeginCopyIn(const common::ManagedPointer<PostgresProtocolInterpreter> postgres_interpreter,
+                        const common::ManagedPointer<PostgresPacketWriter> out,
+                        const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                        const common::ManagedPointer<ConnectionContext> connection,
+                        const common::ManagedPointer<parser::CopyStatement> copy_stmt) {
+  const auto fail = [=](const std::string &message, const common::ErrorCode code) {
+    out->WriteError({common::ErrorSeverity::ERROR, message, code});
+    connection->Transaction()->SetMustAbort();
+    return false;
+  };
+
+  // Look the table up the way the binder does
+  const auto &table_name = copy_stmt->GetCopyTable()->GetTableName();
+  const auto table_oid = connection->Accessor()->GetTableOid(table_name);
+  if (table_oid == catalog::INVALID_TABLE_OID) {
+    return fail(fmt::format("relation \"{}\" does not exist", table_name), common::ErrorCode::ERRCODE_UNDEFINED_TABLE);
+  }
+  const auto &schema = connection->Accessor()->GetSchema(table_oid);
+  std::vector<std::string> column_names = copy_stmt->GetColumns();
+  if (column_names.empty()) {
+    for (const auto &column : schema.GetColumns()) column_names.emplace_back(column.Name());
+  }
+
+  const auto copy_format = trafficcop::TrafficCopUtil::CopyFormatForStatement(copy_stmt);
+  std::vector<type::TypeId> column_types;
+  column_types.reserve(column_names.size());
+  for (const auto &name : column_names) {
+    const auto &columns = schema.GetColumns();
+    const auto column =
+        std::find_if(columns.cbegin(), columns.cend(), [&](const auto &col) { return col.Name() == name; });
+    if (column == columns.cend()) {
+      return fail(fmt::format("column \"{}\" of relation \"{}\" does not exist", name, table_name),
+                  common::ErrorCode::ERRCODE_UNDEFINED_COLUMN);
+    }
+    if (!PostgresCopyReader::SupportsType(column->Type(), copy_format.format_)) {
+      return fail(fmt::format("COPY does not support the type of column \"{}\" in this format yet", name),
+                  common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+    }
+    column_types.emplace_back(column->Type());
+  }
+
+  // INSERT INTO "table" ("a", "b"), with quoted identifiers so that names are taken as they are
+  const auto quote = [](const std::string &identifier) {
+    std::string quoted = "\"";
+    for (const char c : identifier) {
+      quoted += c;
+      if (c == '"') quoted += c;
+    }
+    return quoted + "\"";
+  };
+  std::string insert_into = "INSERT INTO " + quote(table_name) + " (";
+  for (size_t i = 0; i < column_names.size(); i++) {
+    insert_into += (i == 0 ? "" : ", ") + quote(column_names[i]);
+  }
+  insert_into += ")";
+
+  // As many rows per INSERT as the parameter limit allows, rounded down to a power of two so that it divides BATCH_SIZE
+  size_t rows_per_insert = CopyInState::ROWS_PER_INSERT;
+  while (rows_per_insert > 1 && rows_per_insert * column_types.size() > CopyInState::MAX_PARAMS_PER_INSERT) {
+    rows_per_insert /= 2;
+  }
+
+  // Codegen before answering with CopyInResponse, the client could not be told about a failure after that
+  auto [statement, portal] = PrepareCopyInsert(out, t_cop, connection, insert_into, column_types, 1);
+  if (portal == nullptr) return false;
+  std::unique_ptr<Statement> batch_statement;
+  std::unique_ptr<Portal> batch_portal;
+  if (rows_per_insert > 1) {
+    std::tie(batch_statement, batch_portal) =
+        PrepareCopyInsert(out, t_cop, connection, insert_into, column_types, rows_per_insert);
+    if (batch_portal == nullptr) return false;
+  }
+
+  out->WriteCopyInResponse(copy_format, static_cast<uint16_t>(column_types.size()));
+  postgres_interpreter->BeginCopyIn(std::make_unique<CopyInState>(
+      CopyInState{std::move(statement), std::move(portal), std::move(batch_statement), std::move(batch_portal),
+                  rows_per_insert, PostgresCopyReader(copy_format, std::move(column_types))}));
+  return true;
+}
+
+/**
+ * Inserts the rows of a COPY FROM STDIN decoded so far.
+ * @return true if they were inserted, false if the COPY failed
+ */
+static bool InsertCopyInRows(const common::ManagedPointer<PostgresProtocolInterpreter> postgres_interpreter,
+                             const common::ManagedPointer<PostgresPacketWriter> out,
+                             const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                             const common::ManagedPointer<ConnectionContext> connection) {
+  const auto copy_in = postgres_interpreter->GetCopyIn();
+  if (copy_in->rows_.empty()) return true;
+  const auto result = t_cop->RunCopyIn(connection, common::ManagedPointer(copy_in->portal_),
+                                       common::ManagedPointer(copy_in->batch_portal_), copy_in->rows_per_insert_,
+                                       &copy_in->rows_);
+  copy_in->rows_.clear();
+  if (result.type_ != trafficcop::ResultType::COMPLETE) {
+    NOISEPAGE_ASSERT(std::holds_alternative<common::ErrorData>(result.extra_), "We're expecting a message here.");
+    postgres_interpreter->FailCopyIn(out, t_cop, connection, std::get<common::ErrorData>(result.extra_));
+    return false;
+  }
+  copy_in->num_rows_ += std::get<uint32_t>(result.extra_);
+  return true;
+}
+
+/**
+ * Runs an action of a COPY FROM STDIN that decodes data, failing the COPY if the data is invalid.
+ * @return true if the COPY can go on
+ */
+template <typename F>
+static bool DecodeCopyInData(const common::ManagedPointer<PostgresProtocolInterpreter> postgres_interpreter,
+                             const common::ManagedPointer<PostgresPacketWriter> out,
+                             const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                             const common::ManagedPointer<ConnectionContext> connection, const F &decode) {
+  try {
+    decode();
+    return true;
+  } catch (const NetworkProcessException &e) {
+    postgres_interpreter->FailCopyIn(out, t_cop, connection,
+                                     {common::ErrorSeverity::ERROR, e.what(),
+                                      common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT});
+  } catch (const ConversionException &e) {
+    postgres_interpreter->FailCopyIn(out, t_cop, connection,
+                                     {common::ErrorSeverity::ERROR, e.what(),
+                                      common::ErrorCode::ERRCODE_INVALID_TEXT_REPRESENTATION});
+  }
+  return false;
+}
+
 Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
                                     const common::ManagedPointer<PostgresPacketWriter> out,
                                     const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
@@ -164,6 +398,7 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
 
   // This logic relies on ordering of values in the enum's definition and is documented there as well.
   if (NetworkUtil::TransactionalQueryType(query_type)) {
+    if (query_type != network::QueryType::QUERY_BEGIN) postgres_interpreter->ClosePortalExecutions();
     t_cop->ExecuteTransactionStatement(connection, out, postgres_interpreter->ExplicitTransactionBlock(), query_type);
     if (query_type == network::QueryType::QUERY_BEGIN) {
       if (!(postgres_interpreter->ExplicitTransactionBlock())) postgres_interpreter->SetExplicitTransactionBlock();
@@ -173,8 +408,16 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
     return FinishSimpleQueryCommand(out, connection);
   }
 
+  // COPY FROM STDIN and COPY TO STDOUT exchange their rows with the client, COPY with a file is not supported yet
+  const auto copy_stmt = trafficcop::TrafficCopUtil::ClientCopyStatement(statement->RootStatement());
+
   // This logic relies on ordering of values in the enum's definition and is documented there as well.
-  if (NetworkUtil::UnsupportedQueryType(query_type)) {
+  if (copy_stmt != nullptr && copy_stmt->IsFrom()) {
+    if (BeginCopyIn(postgres_interpreter, out, t_cop, connection, copy_stmt)) {
+      // The transaction stays open while the client sends the rows. CopyDone or CopyFail finishes the command.
+      return Transition::PROCEED;
+    }
+  } else if (copy_stmt == nullptr && NetworkUtil::UnsupportedQueryType(query_type)) {
     out->WriteError({common::ErrorSeverity::NOTICE, "we don't yet support that query type.",
                      common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED});
     out->WriteCommandComplete(query_type, 0);
@@ -216,6 +459,7 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
   }
 
   if (!postgres_interpreter->ExplicitTransactionBlock()) {
+    postgres_interpreter->ClosePortalExecutions();
     // Single statement transaction should be ended before returning
     // decide whether the txn should be committed or aborted based on the MustAbort flag, and then end the txn
     t_cop->EndTransaction(connection, connection->Transaction()->MustAbort() ? network::QueryType::QUERY_ROLLBACK
@@ -402,14 +646,8 @@ Transition BindCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> i
   // Bind it, plan it
   const auto bind_result = t_cop->BindQuery(connection, statement, common::ManagedPointer(&params));
   if (LIKELY(bind_result.type_ == trafficcop::ResultType::COMPLETE)) {
-    // Binding succeeded, optimize to generate a physical plan
-    if (statement->OptimizeResult() == nullptr || !t_cop->UseQueryCache()) {
-      // it's not cached, optimize it
-      auto optimize_result =
-          t_cop->OptimizeBoundQuery(connection, statement->ParseResult(), common::ManagedPointer(&params));
-
-      statement->SetOptimizeResult(std::move(optimize_result));
-    }
+    // Binding succeeded, pick the cached plan or optimize to generate a physical plan for these parameters
+    t_cop->PlanBoundQuery(connection, statement, common::ManagedPointer(&params));
 
     postgres_interpreter->SetPortal(portal_name,
                                     std::make_unique<Portal>(statement, std::move(params), std::move(result_formats)));
@@ -511,9 +749,8 @@ Transition ExecuteCommand::Exec(const common::ManagedPointer<ProtocolInterpreter
                    "caught at the protocol interpreter Process() level.");
 
   const auto portal_name = in_.ReadString();
-  const auto max_rows UNUSED_ATTRIBUTE = in_.ReadValue<int32_t>();
-  // TODO(Matt): here's where you would reason about PortalSuspend with max_rows. Maybe just the OutputWriter would
-  // buffer the results, since I'm not sure if we can actually pause execution engine
+  // A SELECT with a row limit runs on a thread of its own, so that it can be suspended at the limit
+  const auto max_rows = in_.ReadValue<int32_t>();
 
   const auto portal = postgres_interpreter->GetPortal(portal_name);
 
@@ -552,6 +789,7 @@ Transition ExecuteCommand::Exec(const common::ManagedPointer<ProtocolInterpreter
 
   // This logic relies on ordering of values in the enum's definition and is documented there as well.
   if (NetworkUtil::TransactionalQueryType(query_type)) {
+    if (query_type != network::QueryType::QUERY_BEGIN) postgres_interpreter->ClosePortalExecutions();
     t_cop->ExecuteTransactionStatement(connection, out, postgres_interpreter->ExplicitTransactionBlock(), query_type);
     if (query_type == network::QueryType::QUERY_BEGIN) {
       if (!(postgres_interpreter->ExplicitTransactionBlock())) postgres_interpreter->SetExplicitTransactionBlock();
@@ -574,7 +812,11 @@ Transition ExecuteCommand::Exec(const common::ManagedPointer<ProtocolInterpreter
   }
 
   if (portal->OptimizeResult() != nullptr) {
-    ExecutePortal(connection, portal, out, t_cop, postgres_interpreter->ExplicitTransactionBlock());
+    if (portal->Execution() != nullptr || (max_rows > 0 && query_type == network::QueryType::QUERY_SELECT)) {
+      FetchPortal(connection, portal, out, t_cop, max_rows > 0 ? static_cast<uint32_t>(max_rows) : 0);
+    } else {
+      ExecutePortal(connection, portal, out, t_cop, postgres_interpreter->ExplicitTransactionBlock());
+    }
     if (connection->TransactionState() == NetworkTransactionStateType::FAIL) {
       postgres_interpreter->SetWaitingForSync();
     }
@@ -593,6 +835,7 @@ Transition SyncCommand::Exec(common::ManagedPointer<ProtocolInterpreter> interpr
   const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
   if (!postgres_interpreter->ExplicitTransactionBlock() &&
       !(connection->TransactionState() == network::NetworkTransactionStateType::IDLE)) {
+    postgres_interpreter->ClosePortalExecutions();
     t_cop->EndTransaction(connection, connection->Transaction()->MustAbort() ? network::QueryType::QUERY_ROLLBACK
                                                                              : network::QueryType::QUERY_COMMIT);
     postgres_interpreter->ResetTransactionState();
@@ -627,6 +870,70 @@ Transition CloseCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>
   return Transition::PROCEED;
 }
 
+Transition FlushCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                              const common::ManagedPointer<PostgresPacketWriter> out,
+                              const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                              const common::ManagedPointer<ConnectionContext> connection) {
+  // Flush doesn't produce a response of its own, it only forces the output that is pending so far to be sent
+  return Transition::PROCEED;
+}
+
+Transition CopyDataCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  // Data that arrives after the COPY failed is dropped
+  const auto copy_in = postgres_interpreter->GetCopyIn();
+  if (copy_in == nullptr) return Transition::PROCEED;
+
+  const auto data = in_.ReadStringView(in_.BytesAvailable());
+  if (!DecodeCopyInData(postgres_interpreter, out, t_cop, connection,
+                        [&] { copy_in->reader_.Consume(data, &copy_in->rows_); })) {
+    return Transition::PROCEED;
+  }
+  // Rows are inserted in batches, so that neither the whole data nor a message worth of rows has to be kept around
+  if (copy_in->rows_.size() >= CopyInState::BATCH_SIZE) InsertCopyInRows(postgres_interpreter, out, t_cop, connection);
+  return Transition::PROCEED;
+}
+
+Transition CopyDoneCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  const auto copy_in = postgres_interpreter->GetCopyIn();
+  if (copy_in == nullptr) return Transition::PROCEED;
+
+  if (!DecodeCopyInData(postgres_interpreter, out, t_cop, connection,
+                        [&] { copy_in->reader_.Finish(&copy_in->rows_); }) ||
+      !InsertCopyInRows(postgres_interpreter, out, t_cop, connection)) {
+    return Transition::PROCEED;
+  }
+
+  out->WriteCommandComplete(QueryType::QUERY_COPY, copy_in->num_rows_);
+  postgres_interpreter->EndCopyIn();
+  if (!postgres_interpreter->ExplicitTransactionBlock()) {
+    postgres_interpreter->ClosePortalExecutions();
+    t_cop->EndTransaction(connection, connection->Transaction()->MustAbort() ? network::QueryType::QUERY_ROLLBACK
+                                                                             : network::QueryType::QUERY_COMMIT);
+    postgres_interpreter->ResetTransactionState();
+  }
+  return FinishSimpleQueryCommand(out, connection);
+}
+
+Transition CopyFailCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  if (postgres_interpreter->GetCopyIn() == nullptr) return Transition::PROCEED;
+  postgres_interpreter->FailCopyIn(out, t_cop, connection,
+                                   {common::ErrorSeverity::ERROR, "COPY from stdin failed: " + in_.ReadString(),
+                                    common::ErrorCode::ERRCODE_QUERY_CANCELED});
+  return Transition::PROCEED;
+}
+
 Transition TerminateCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
                                   const common::ManagedPointer<PostgresPacketWriter> out,
                                   const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
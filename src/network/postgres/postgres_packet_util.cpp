@@ -1,19 +1,90 @@
 #include "network/postgres/postgres_packet_util.h"
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include "execution/sql/value.h"
 #include "execution/sql/value_util.h"
 #include "execution/util/execution_common.h"
 #include "network/network_io_utils.h"
+#include "network/postgres/postgres_binary_formatter.h"
 #include "network/postgres/postgres_defs.h"
 #include "network/postgres/postgres_protocol_util.h"
 #include "parser/expression/constant_value_expression.h"
 #include "type/type_id.h"
+#include "util/portable_endian.h"
 
 namespace noisepage::network {
 
+namespace {
+
+/**
+ * Parse an integer parameter straight out of the packet. Accepts the same input as std::stoll, which needs a copy of
+ * the text, and throws the same exceptions.
+ */
+int64_t TextToInteger(std::string_view text) {
+  while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())) != 0) text.remove_prefix(1);
+  if (text.size() > 1 && text.front() == '+' && text[1] != '-') text.remove_prefix(1);
+  int64_t value = 0;
+  const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (result.ec == std::errc::result_out_of_range) throw std::out_of_range("Integer parameter out of range.");
+  if (result.ec != std::errc()) throw std::invalid_argument("Invalid integer parameter.");
+  return value;
+}
+
+/**
+ * Parse a boolean the way Postgres does, accepting any case of the spellings it accepts.
+ */
+bool TextToBoolean(std::string_view text) {
+  const auto matches = [text](const std::string_view spelling) {
+    return text.size() == spelling.size() &&
+           std::equal(text.begin(), text.end(), spelling.begin(), [](const char lhs, const char rhs) {
+             return std::tolower(static_cast<unsigned char>(lhs)) == std::tolower(static_cast<unsigned char>(rhs));
+           });
+  };
+  for (const auto &spelling : POSTGRES_BOOLEAN_STR_TRUES) {
+    if (matches(spelling)) return true;
+  }
+  for (const auto &spelling : POSTGRES_BOOLEAN_STR_FALSES) {
+    if (matches(spelling)) return false;
+  }
+  throw std::invalid_argument("Invalid boolean parameter.");
+}
+
+/**
+ * Read a fixed-size value in network byte order.
+ */
+template <typename T>
+T NetworkBytesToValue(const std::string_view bytes) {
+  static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Invalid size for numeric.");
+  if (bytes.size() != sizeof(T)) throw NETWORK_PROCESS_EXCEPTION("Unexpected size for a binary value.");
+  if constexpr (sizeof(T) == 1) {
+    return static_cast<T>(bytes[0]);
+  } else {  // NOLINT: false positive on indentation with clang-tidy, fixed in upstream check-clang-tidy
+    std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>> raw;
+    std::memcpy(&raw, bytes.data(), sizeof(T));
+    if constexpr (sizeof(T) == 2) {
+      raw = be16toh(raw);
+    } else if constexpr (sizeof(T) == 4) {
+      raw = be32toh(raw);
+    } else {
+      raw = be64toh(raw);
+    }
+    T value;
+    std::memcpy(&value, &raw, sizeof(T));
+    return value;
+  }
+}
+
+}  // namespace
+
 std::vector<FieldFormat> PostgresPacketUtil::ReadFormatCodes(const common::ManagedPointer<ReadBufferView> read_buffer) {
   const auto num_formats = read_buffer->ReadValue<int16_t>();
 
@@ -47,25 +118,29 @@ parser::ConstantValueExpression PostgresPacketUtil::TextValueToInternalValue(
     return {type, execution::sql::Val(true)};
   }
 
-  const auto string = read_buffer->ReadString(size);
+  // The value is only viewed in place, the returned expression copies what it needs
+  return TextValueToInternalValue(read_buffer->ReadStringView(size), type);
+}
+
+parser::ConstantValueExpression PostgresPacketUtil::TextValueToInternalValue(const std::string_view string,
+                                                                             const type::TypeId type) {
   switch (type) {
-    case type::TypeId::BOOLEAN: {
-      // Matt: as best as I can tell, we only expect 'TRUE' of 'FALSE' coming in here, rather than the 't' or 'f' that
-      // results use. We can simplify this logic a bit if that assumption can be verified
-      if (string == "TRUE") return {type, execution::sql::BoolVal(true)};
-      NOISEPAGE_ASSERT(string == "FALSE", "Input equals something other than TRUE or FALSE. We should check that.");
-      return {type, execution::sql::BoolVal(false)};
-    }
+    case type::TypeId::BOOLEAN:
+      return {type, execution::sql::BoolVal(TextToBoolean(string))};
     case type::TypeId::TINYINT:
-      return {type, execution::sql::Integer(static_cast<int8_t>(std::stoll(string)))};
+      return {type, execution::sql::Integer(static_cast<int8_t>(TextToInteger(string)))};
     case type::TypeId::SMALLINT:
-      return {type, execution::sql::Integer(static_cast<int16_t>(std::stoll(string)))};
+      return {type, execution::sql::Integer(static_cast<int16_t>(TextToInteger(string)))};
     case type::TypeId::INTEGER:
-      return {type, execution::sql::Integer(static_cast<int32_t>(std::stoll(string)))};
+      return {type, execution::sql::Integer(static_cast<int32_t>(TextToInteger(string)))};
     case type::TypeId::BIGINT:
-      return {type, execution::sql::Integer(static_cast<int64_t>(std::stoll(string)))};
+      return {type, execution::sql::Integer(TextToInteger(string))};
     case type::TypeId::REAL:
-      return {type, execution::sql::Real(std::stod(string))};
+      // Numbers almost always fit the small string optimization, so this copy rarely allocates
+      return {type, execution::sql::Real(std::stod(std::string(string)))};
+    case type::TypeId::DECIMAL:
+      // DECIMAL columns are stored as REAL (see ColumnDefinition), so a NUMERIC parameter is bound as one
+      return {type::TypeId::REAL, execution::sql::Real(std::stod(std::string(string)))};
     case type::TypeId::VARCHAR: {
       auto string_val = execution::sql::ValueUtil::CreateStringVal(string);
       return {type, string_val.first, std::move(string_val.second)};
@@ -109,33 +184,42 @@ parser::ConstantValueExpression PostgresPacketUtil::BinaryValueToInternalValue(
     return {type, execution::sql::Val(true)};
   }
 
+  return BinaryValueToInternalValue(read_buffer->ReadStringView(size), type);
+}
+
+parser::ConstantValueExpression PostgresPacketUtil::BinaryValueToInternalValue(const std::string_view bytes,
+                                                                               const type::TypeId type) {
   switch (type) {
-    case type::TypeId::TINYINT: {
-      NOISEPAGE_ASSERT(size == 1, "Unexpected size for this type.");
-      return {type, execution::sql::Integer(read_buffer->ReadValue<int8_t>())};
-    }
-    case type::TypeId::SMALLINT: {
-      NOISEPAGE_ASSERT(size == 2, "Unexpected size for this type.");
-      return {type, execution::sql::Integer(read_buffer->ReadValue<int16_t>())};
-    }
-    case type::TypeId::INTEGER: {
-      NOISEPAGE_ASSERT(size == 4, "Unexpected size for this type.");
-      return {type, execution::sql::Integer(read_buffer->ReadValue<int32_t>())};
-    }
-    case type::TypeId::BIGINT: {
-      NOISEPAGE_ASSERT(size == 8, "Unexpected size for this type.");
-      return {type, execution::sql::Integer(read_buffer->ReadValue<int64_t>())};
-    }
-    case type::TypeId::REAL: {
-      NOISEPAGE_ASSERT(size == 8, "Unexpected size for this type.");
-      return {type, execution::sql::Real(read_buffer->ReadValue<double>())};
-    }
-    case type::TypeId::DATE: {
-      // TODO(Matt): unsure if this is correct. Need tests.
-      return {type, execution::sql::DateVal(static_cast<uint32_t>(read_buffer->ReadValue<int32_t>()))};
+    case type::TypeId::BOOLEAN:
+      return {type, execution::sql::BoolVal(NetworkBytesToValue<int8_t>(bytes) != 0)};
+    case type::TypeId::TINYINT:
+      return {type, execution::sql::Integer(NetworkBytesToValue<int8_t>(bytes))};
+    case type::TypeId::SMALLINT:
+      return {type, execution::sql::Integer(NetworkBytesToValue<int16_t>(bytes))};
+    case type::TypeId::INTEGER:
+      return {type, execution::sql::Integer(NetworkBytesToValue<int32_t>(bytes))};
+    case type::TypeId::BIGINT:
+      return {type, execution::sql::Integer(NetworkBytesToValue<int64_t>(bytes))};
+    case type::TypeId::REAL:
+      // Both float4 and float8 parameters are bound as REAL, which tell themselves apart by their size
+      if (bytes.size() == sizeof(float)) return {type, execution::sql::Real(NetworkBytesToValue<float>(bytes))};
+      return {type, execution::sql::Real(NetworkBytesToValue<double>(bytes))};
+    case type::TypeId::DECIMAL:
+      // DECIMAL columns are stored as REAL (see ColumnDefinition), so a NUMERIC parameter is bound as one
+      return {type::TypeId::REAL, execution::sql::Real(PostgresBinaryFormatter::ParseNumeric(bytes))};
+    case type::TypeId::DATE:
+      return {type,
+              execution::sql::DateVal(PostgresBinaryFormatter::DateFromPostgres(NetworkBytesToValue<int32_t>(bytes)))};
+    case type::TypeId::TIMESTAMP:
+      return {type, execution::sql::TimestampVal(
+                        PostgresBinaryFormatter::TimestampFromPostgres(NetworkBytesToValue<int64_t>(bytes)))};
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      // The binary form of a string is its bytes
+      auto string_val = execution::sql::ValueUtil::CreateStringVal(bytes);
+      return {type, string_val.first, std::move(string_val.second)};
     }
     default:
-      // (Matt): from looking at jdbc source code, that seems like all the possible binary types
       UNREACHABLE("Unsupported type for parameter.");
   }
 }
@@ -152,7 +236,7 @@ std::vector<parser::ConstantValueExpression> PostgresPacketUtil::ReadParameters(
   for (uint16_t i = 0; i < num_params; i++) {
     const auto param_size = read_buffer->ReadValue<int32_t>();
 
-    const auto param_format = param_formats[i <= param_formats.size() ? i : 0];
+    const auto param_format = param_formats[i < param_formats.size() ? i : 0];
 
     params.emplace_back(param_format == FieldFormat::text
                             ? TextValueToInternalValue(read_buffer, param_size, param_types[i])
@@ -1,10 +1,13 @@
 #include "network/postgres/postgres_packet_writer.h"
 
+#include <cstring>
+
 #include "common/error/error_data.h"
 #include "execution/sql/value.h"
+#include "network/postgres/postgres_binary_formatter.h"
 #include "network/postgres/postgres_defs.h"
 #include "network/postgres/postgres_protocol_util.h"
-#include "spdlog/fmt/fmt.h"
+#include "network/postgres/postgres_text_formatter.h"
 
 namespace noisepage::network {
 
@@ -49,6 +52,10 @@ void PostgresPacketWriter::WriteEmptyQueryResponse() {
 
 void PostgresPacketWriter::WriteNoData() { BeginPacket(NetworkMessageType::PG_NO_DATA_RESPONSE).EndPacket(); }
 
+void PostgresPacketWriter::WritePortalSuspended() {
+  BeginPacket(NetworkMessageType::PG_PORTAL_SUSPENDED).EndPacket();
+}
+
 void PostgresPacketWriter::WriteParameterDescription(const std::vector<type::TypeId> &param_types) {
   BeginPacket(NetworkMessageType::PG_PARAMETER_DESCRIPTION);
   AppendValue<int16_t>(static_cast<int16_t>(param_types.size()));
@@ -102,8 +109,8 @@ void PostgresPacketWriter::WriteRowDescription(const std::vector<planner::Output
                                   // it's a column from a table), 0 otherwise.
         .AppendValue(
             static_cast<int32_t>(PostgresProtocolUtil::InternalValueTypeToPostgresValueType(col_type)));  // type oid
-    if (col_type == type::TypeId::VARCHAR || col_type == type::TypeId::VARBINARY ||
-        (field_format == FieldFormat::text && static_cast<uint8_t>(col_type) > 5)) {
+    // The size of the Postgres type, which does not depend on the format that the values are sent in
+    if (col_type == type::TypeId::VARCHAR || col_type == type::TypeId::VARBINARY || col_type == type::TypeId::DECIMAL) {
       AppendValue<int16_t>(-1);  // variable length
     } else {
       AppendValue<int16_t>(type::TypeUtil::GetTypeSize(col_type));  // data type size
@@ -186,6 +193,9 @@ void PostgresPacketWriter::WriteCommandComplete(const QueryType query_type, cons
     case QueryType::QUERY_ANALYZE:
       WriteCommandComplete("ANALYZE");
       break;
+    case QueryType::QUERY_COPY:
+      WriteCommandComplete("COPY ", num_rows);
+      break;
     default:
       WriteCommandComplete("This QueryType needs a completion message!");
       break;
@@ -260,26 +270,43 @@ void PostgresPacketWriter::WriteBindComplete() { BeginPacket(NetworkMessageType:
 void PostgresPacketWriter::WriteDataRow(const byte *const tuple,
                                         const std::vector<planner::OutputSchema::Column> &columns,
                                         const std::vector<FieldFormat> &field_formats) {
-  BeginPacket(NetworkMessageType::PG_DATA_ROW).AppendValue<int16_t>(static_cast<int16_t>(columns.size()));
+  WriteDataRows(tuple, 1, 0, ComputeDataRowLayout(columns, field_formats));
+}
+
+void PostgresPacketWriter::WriteDataRows(const byte *const tuples, const uint32_t num_tuples, const uint32_t tuple_size,
+                                         const std::vector<DataRowColumn> &layout) {
+  for (uint32_t row = 0; row < num_tuples; row++) {
+    const byte *const tuple = tuples + row * tuple_size;
+    BeginPacket(NetworkMessageType::PG_DATA_ROW).AppendValue<int16_t>(static_cast<int16_t>(layout.size()));
+    for (const auto &column : layout) {
+      const auto *const val = reinterpret_cast<const execution::sql::Val *const>(tuple + column.offset_);
+      if (column.format_ == FieldFormat::text) {
+        WriteTextAttribute(val, column.type_);
+      } else {
+        WriteBinaryAttribute(val, column.type_);
+      }
+    }
+    EndPacket();
+  }
+}
+
+std::vector<DataRowColumn> PostgresPacketWriter::ComputeDataRowLayout(
+    const std::vector<planner::OutputSchema::Column> &columns, const std::vector<FieldFormat> &field_formats) {
+  std::vector<DataRowColumn> layout;
+  layout.reserve(columns.size());
   uint32_t curr_offset = 0;
   for (uint32_t i = 0; i < columns.size(); i++) {
-    // Reinterpret to a base value type first and check if it's NULL
-    auto alignment = execution::sql::ValUtil::GetSqlAlignment(columns[i].GetType());
+    const auto type = columns[i].GetType();
+    auto alignment = execution::sql::ValUtil::GetSqlAlignment(type);
     if (!common::MathUtil::IsAligned(curr_offset, alignment)) {
       curr_offset = static_cast<uint32_t>(common::MathUtil::AlignTo(curr_offset, alignment));
     }
-    const auto *const val = reinterpret_cast<const execution::sql::Val *const>(tuple + curr_offset);
-
     // Field formats can either be the size of the number of columns, or size 1 where they all use the same format
-    const auto field_format = field_formats[i < field_formats.size() ? i : 0];
-
-    const auto type_size = field_format == FieldFormat::text ? WriteTextAttribute(val, columns[i].GetType())
-                                                             : WriteBinaryAttribute(val, columns[i].GetType());
-
+    layout.push_back({type, curr_offset, field_formats[i < field_formats.size() ? i : 0]});
     // Advance in the buffer based on the execution engine's type size
-    curr_offset += type_size;
+    curr_offset += execution::sql::ValUtil::GetSqlSize(type);
   }
-  EndPacket();
+  return layout;
 }
 
 template <class native_type, class val_type>
@@ -292,17 +319,7 @@ void PostgresPacketWriter::WriteBinaryVal(const execution::sql::Val *const val,
       .AppendValue<native_type>(static_cast<native_type>(casted_val->val_));
 }
 
-template <class native_type, class val_type>
-void PostgresPacketWriter::WriteBinaryValNeedsToNative(const execution::sql::Val *const val, const type::TypeId type) {
-  const auto *const casted_val = reinterpret_cast<const val_type *const>(val);
-  NOISEPAGE_ASSERT(type::TypeUtil::GetTypeSize(type) == sizeof(native_type),
-                   "Mismatched native type size and size reported by TypeUtil.");
-  // write the length, write the attribute
-  AppendValue<int32_t>(static_cast<int32_t>(type::TypeUtil::GetTypeSize(type)))
-      .AppendValue<native_type>(static_cast<native_type>(casted_val->val_.ToNative()));
-}
-
-uint32_t PostgresPacketWriter::WriteBinaryAttribute(const execution::sql::Val *const val, const type::TypeId type) {
+void PostgresPacketWriter::WriteBinaryAttribute(const execution::sql::Val *const val, const type::TypeId type) {
   if (val->is_null_) {
     // write a -1 for the length of the column value and continue to the next value
     AppendValue<int32_t>(static_cast<int32_t>(-1));
@@ -334,85 +351,243 @@ uint32_t PostgresPacketWriter::WriteBinaryAttribute(const execution::sql::Val *c
         break;
       }
       case type::TypeId::DATE: {
-        WriteBinaryValNeedsToNative<uint32_t, execution::sql::DateVal>(val, type);
+        const auto *const date_val = reinterpret_cast<const execution::sql::DateVal *const>(val);
+        AppendValue<int32_t>(static_cast<int32_t>(sizeof(int32_t)))
+            .AppendValue<int32_t>(PostgresBinaryFormatter::DateToPostgres(date_val->val_));
         break;
       }
       case type::TypeId::TIMESTAMP: {
-        WriteBinaryValNeedsToNative<uint64_t, execution::sql::TimestampVal>(val, type);
+        const auto *const ts_val = reinterpret_cast<const execution::sql::TimestampVal *const>(val);
+        AppendValue<int32_t>(static_cast<int32_t>(sizeof(int64_t)))
+            .AppendValue<int64_t>(PostgresBinaryFormatter::TimestampToPostgres(ts_val->val_));
+        break;
+      }
+      case type::TypeId::DECIMAL:
+        // A DecimalVal does not know its scale, so its raw value is not the number it stands for
+        UNREACHABLE("TrafficCop::BindQuery rejects queries with DECIMAL results.");
+      case type::TypeId::VARCHAR:
+      case type::TypeId::VARBINARY: {
+        // The binary form of a string is its bytes
+        const auto *const string_val = reinterpret_cast<const execution::sql::StringVal *const>(val);
+        AppendValue<int32_t>(static_cast<int32_t>(string_val->GetLength()))
+            .AppendStringView(string_val->StringView(), false);
         break;
       }
       default:
-        UNREACHABLE(
-            "Unsupported type for binary serialization. This is either a new type, or an oversight when reading JDBC "
-            "source code.");
+        UNREACHABLE("Unsupported type for binary serialization. This is a new type that needs a binary form.");
     }
   }
-
-  // Advance in the buffer based on the execution engine's type size
-  return execution::sql::ValUtil::GetSqlSize(type);
 }
 
-uint32_t PostgresPacketWriter::WriteTextAttribute(const execution::sql::Val *const val, const type::TypeId type) {
+void PostgresPacketWriter::WriteTextAttribute(const execution::sql::Val *const val, const type::TypeId type) {
   if (val->is_null_) {
     // write a -1 for the length of the column value and continue to the next value
     AppendValue<int32_t>(static_cast<int32_t>(-1));
-  } else {
-    // Convert the field to text format
-    std::string string_value;
-    switch (type) {
-      case type::TypeId::TINYINT:
-      case type::TypeId::SMALLINT:
-      case type::TypeId::BIGINT:
-      case type::TypeId::INTEGER: {
-        auto *int_val = reinterpret_cast<const execution::sql::Integer *const>(val);
-        string_value = std::to_string(int_val->val_);
-        break;
+    return;
+  }
+
+  switch (type) {
+    case type::TypeId::BOOLEAN: {
+      // Write the constant string directly
+      auto *bool_val = reinterpret_cast<const execution::sql::BoolVal *const>(val);
+      const auto str_view = static_cast<bool>(bool_val->val_) ? POSTGRES_BOOLEAN_STR_TRUE : POSTGRES_BOOLEAN_STR_FALSE;
+      AppendValue<int32_t>(static_cast<int32_t>(str_view.length())).AppendStringView(str_view, false);
+      return;
+    }
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      // Don't allocate an actual string for a VARCHAR, just wrap a std::string_view, write the value directly, and
+      // continue
+      const auto *const string_val = reinterpret_cast<const execution::sql::StringVal *const>(val);
+      AppendValue<int32_t>(static_cast<int32_t>(string_val->GetLength()))
+          .AppendStringView(string_val->StringView(), false);
+      return;
+    }
+    default:
+      break;
+  }
+
+  // Format the value right behind the space reserved for its length in a stack buffer, so that the length and the
+  // text are appended to the write queue with a single copy and without allocating a temporary string
+  char buf[sizeof(int32_t) + PostgresTextFormatter::MAX_TEXT_LENGTH];
+  char *const text = buf + sizeof(int32_t);
+  char *const text_end = FormatTextValue(val, type, text);
+
+  // write the size in network byte order, then the size and the attribute together
+  const auto text_length = static_cast<uint32_t>(text_end - text);
+  NOISEPAGE_ASSERT(text_length <= PostgresTextFormatter::MAX_TEXT_LENGTH, "Text form overflowed the stack buffer.");
+  const auto network_length = htobe32(text_length);
+  std::memcpy(buf, &network_length, sizeof(network_length));
+  AppendRaw(buf, sizeof(int32_t) + text_length);
+}
+
+char *PostgresPacketWriter::FormatTextValue(const execution::sql::Val *const val, const type::TypeId type,
+                                            char *const out) {
+  switch (type) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::BIGINT:
+    case type::TypeId::INTEGER: {
+      auto *int_val = reinterpret_cast<const execution::sql::Integer *const>(val);
+      return PostgresTextFormatter::FormatInteger(int_val->val_, out);
+    }
+    case type::TypeId::REAL: {
+      auto *real_val = reinterpret_cast<const execution::sql::Real *const>(val);
+      return PostgresTextFormatter::FormatReal(real_val->val_, out);
+    }
+    case type::TypeId::DATE: {
+      auto *date_val = reinterpret_cast<const execution::sql::DateVal *const>(val);
+      return PostgresTextFormatter::FormatDate(date_val->val_, out);
+    }
+    case type::TypeId::TIMESTAMP: {
+      auto *ts_val = reinterpret_cast<const execution::sql::TimestampVal *const>(val);
+      return PostgresTextFormatter::FormatTimestamp(ts_val->val_, out);
+    }
+    case type::TypeId::DECIMAL:
+      // A DecimalVal does not know its scale, so its raw value is not the number it stands for
+      UNREACHABLE("TrafficCop::BindQuery rejects queries with DECIMAL results.");
+    default:
+      UNREACHABLE(
+          "Unsupported type for text serialization. This is either a new type, or an oversight when reading JDBC "
+          "source code.");
+  }
+}
+
+void PostgresPacketWriter::WriteCopyInResponse(const CopyFormat &format, const uint16_t num_columns) {
+  const auto field_format = static_cast<int16_t>(format.format_ == parser::ExternalFileFormat::BINARY);
+  BeginPacket(NetworkMessageType::PG_COPY_IN_RESPONSE)
+      .AppendValue<int8_t>(static_cast<int8_t>(field_format))
+      .AppendValue<int16_t>(static_cast<int16_t>(num_columns));
+  for (uint16_t i = 0; i < num_columns; i++) AppendValue<int16_t>(field_format);
+  EndPacket();
+}
+
+void PostgresPacketWriter::WriteCopyOutResponse(const CopyFormat &format, const uint16_t num_columns) {
+  const auto field_format = static_cast<int16_t>(format.format_ == parser::ExternalFileFormat::BINARY);
+  BeginPacket(NetworkMessageType::PG_COPY_OUT_RESPONSE)
+      .AppendValue<int8_t>(static_cast<int8_t>(field_format))
+      .AppendValue<int16_t>(static_cast<int16_t>(num_columns));
+  for (uint16_t i = 0; i < num_columns; i++) AppendValue<int16_t>(field_format);
+  EndPacket();
+
+  if (format.format_ == parser::ExternalFileFormat::BINARY) {
+    // Signature, then no flags and no header extension
+    BeginPacket(NetworkMessageType::PG_COPY_DATA)
+        .AppendStringView(POSTGRES_COPY_BINARY_SIGNATURE, false)
+        .AppendValue<int32_t>(0)
+        .AppendValue<int32_t>(0)
+        .EndPacket();
+  }
+}
+
+void PostgresPacketWriter::WriteCopyDataRows(const byte *const tuples, const uint32_t num_tuples,
+                                             const uint32_t tuple_size, const std::vector<DataRowColumn> &layout,
+                                             const CopyFormat &format) {
+  for (uint32_t row = 0; row < num_tuples; row++) {
+    const byte *const tuple = tuples + row * tuple_size;
+    BeginPacket(NetworkMessageType::PG_COPY_DATA);
+    if (format.format_ == parser::ExternalFileFormat::BINARY) {
+      // Same layout as the values of a DataRow
+      AppendValue<int16_t>(static_cast<int16_t>(layout.size()));
+      for (const auto &column : layout) {
+        WriteBinaryAttribute(reinterpret_cast<const execution::sql::Val *const>(tuple + column.offset_), column.type_);
       }
-      case type::TypeId::BOOLEAN: {
-        // Don't allocate an actual string for a BOOLEAN, just wrap a std::string_view, write the value directly, and
-        // continue
-        auto *bool_val = reinterpret_cast<const execution::sql::BoolVal *const>(val);
-        const auto str_view =
-            static_cast<bool>(bool_val->val_) ? POSTGRES_BOOLEAN_STR_TRUE : POSTGRES_BOOLEAN_STR_FALSE;
-        AppendValue<int32_t>(static_cast<int32_t>(str_view.length())).AppendStringView(str_view, false);
-        return execution::sql::ValUtil::GetSqlSize(type);
+    } else {
+      for (uint32_t i = 0; i < layout.size(); i++) {
+        if (i > 0) AppendRawValue(format.delimiter_);
+        WriteCopyTextAttribute(reinterpret_cast<const execution::sql::Val *const>(tuple + layout[i].offset_),
+                               layout[i].type_, format);
       }
-      case type::TypeId::REAL: {
-        auto *real_val = reinterpret_cast<const execution::sql::Real *const>(val);
-        string_value = fmt::to_string(real_val->val_);
-        break;
+      AppendRawValue('\n');
+    }
+    EndPacket();
+  }
+}
+
+void PostgresPacketWriter::WriteCopyOutDone(const CopyFormat &format) {
+  if (format.format_ == parser::ExternalFileFormat::BINARY) {
+    BeginPacket(NetworkMessageType::PG_COPY_DATA).AppendValue<int16_t>(-1).EndPacket();
+  }
+  BeginPacket(NetworkMessageType::PG_COPY_DONE).EndPacket();
+}
+
+void PostgresPacketWriter::WriteCopyTextAttribute(const execution::sql::Val *const val, const type::TypeId type,
+                                                  const CopyFormat &format) {
+  const bool csv = format.format_ == parser::ExternalFileFormat::CSV;
+  if (val->is_null_) {
+    // CSV writes NULL as an unquoted empty value, which is why empty strings are quoted below
+    if (!csv) AppendStringView(POSTGRES_COPY_TEXT_NULL, false);
+    return;
+  }
+
+  if (type == type::TypeId::BOOLEAN) {
+    const auto *const bool_val = reinterpret_cast<const execution::sql::BoolVal *const>(val);
+    AppendStringView(static_cast<bool>(bool_val->val_) ? POSTGRES_BOOLEAN_STR_TRUE : POSTGRES_BOOLEAN_STR_FALSE,
+                     false);
+    return;
+  }
+
+  if (type != type::TypeId::VARCHAR && type != type::TypeId::VARBINARY) {
+    // Numbers, dates and timestamps never contain characters that need to be escaped
+    char buf[PostgresTextFormatter::MAX_TEXT_LENGTH];
+    AppendRaw(buf, static_cast<size_t>(FormatTextValue(val, type, buf) - buf));
+    return;
+  }
+
+  const auto str = reinterpret_cast<const execution::sql::StringVal *const>(val)->StringView();
+  if (csv) {
+    const char special[] = {format.delimiter_, format.quote_, '\r', '\n'};
+    const bool needs_quotes = str.empty() || str == POSTGRES_COPY_END_OF_DATA ||
+                              str.find_first_of(std::string_view(special, sizeof(special))) != std::string_view::npos;
+    if (!needs_quotes) {
+      AppendStringView(str, false);
+      return;
+    }
+    AppendRawValue(format.quote_);
+    size_t start = 0;
+    for (size_t i = 0; i < str.size(); i++) {
+      if (str[i] == format.quote_ || str[i] == format.escape_) {
+        AppendStringView(str.substr(start, i - start), false).AppendRawValue(format.escape_);
+        start = i;
       }
-      case type::TypeId::DATE: {
-        auto *date_val = reinterpret_cast<const execution::sql::DateVal *const>(val);
-        string_value = date_val->val_.ToString();
+    }
+    AppendStringView(str.substr(start), false).AppendRawValue(format.quote_);
+    return;
+  }
+
+  // The text format escapes backslashes, the delimiter, and control characters with a backslash. Runs of characters
+  // that need no escaping are appended in one go.
+  size_t start = 0;
+  for (size_t i = 0; i < str.size(); i++) {
+    char escaped;
+    switch (str[i]) {
+      case '\b':
+        escaped = 'b';
         break;
-      }
-      case type::TypeId::TIMESTAMP: {
-        auto *ts_val = reinterpret_cast<const execution::sql::TimestampVal *const>(val);
-        string_value = ts_val->val_.ToString();
+      case '\f':
+        escaped = 'f';
+        break;
+      case '\n':
+        escaped = 'n';
+        break;
+      case '\r':
+        escaped = 'r';
+        break;
+      case '\t':
+        escaped = 't';
+        break;
+      case '\v':
+        escaped = 'v';
         break;
-      }
-      case type::TypeId::VARCHAR:
-      case type::TypeId::VARBINARY: {
-        // Don't allocate an actual string for a VARCHAR, just wrap a std::string_view, write the value directly, and
-        // continue
-        const auto *const string_val = reinterpret_cast<const execution::sql::StringVal *const>(val);
-        AppendValue<int32_t>(static_cast<int32_t>(string_val->GetLength()))
-            .AppendStringView(string_val->StringView(), false);
-        return execution::sql::ValUtil::GetSqlSize(type);
-      }
       default:
-        UNREACHABLE(
-            "Unsupported type for text serialization. This is either a new type, or an oversight when reading JDBC "
-            "source code.");
+        if (str[i] != '\\' && str[i] != format.delimiter_) continue;
+        escaped = str[i];
     }
-
-    // write the size, write the attribute
-    AppendValue<int32_t>(static_cast<int32_t>(string_value.length())).AppendString(string_value, false);
+    const char escape_sequence[] = {'\\', escaped};
+    AppendStringView(str.substr(start, i - start), false).AppendRaw(escape_sequence, sizeof(escape_sequence));
+    start = i + 1;
   }
-
-  // Advance in the buffer based on the execution engine's type size
-  return execution::sql::ValUtil::GetSqlSize(type);
+  AppendStringView(str.substr(start), false);
 }
 
 }  // namespace noisepage::network
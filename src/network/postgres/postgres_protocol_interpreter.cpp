@@ -9,6 +9,7 @@
 #include "common/error/error_defs.h"
 #include "network/network_defs.h"
 #include "network/postgres/postgres_network_commands.h"
+#include "spdlog/fmt/fmt.h"
 #include "traffic_cop/traffic_cop.h"
 
 constexpr uint32_t SSL_MESSAGE_VERNO = 80877103;
@@ -19,33 +20,111 @@ Transition PostgresProtocolInterpreter::Process(common::ManagedPointer<ReadBuffe
                                                 common::ManagedPointer<WriteQueue> out,
                                                 common::ManagedPointer<trafficcop::TrafficCop> t_cop,
                                                 common::ManagedPointer<ConnectionContext> context) {
-  try {
-    if (!TryBuildPacket(in)) return Transition::NEED_READ_TIMEOUT;
-  } catch (std::exception &e) {
-    NETWORK_LOG_ERROR("Encountered exception {0} when parsing packet", e.what());
-    return Transition::TERMINATE;
-  }
-  if (startup_) {
-    // Always flush startup packet response
-    out->ForceFlush();
+  // This call may process the messages that follow, and in particular execute queries, only if it was handed to an
+  // execution worker or if there are no execution workers at all
+  const bool may_execute = processing_on_worker_ || !execution_offloaded_;
+  processing_on_worker_ = false;
+
+  // Drivers pipeline many Parse/Bind/Execute messages before a Sync (e.g., JDBC batches, libpq pipeline mode). Process
+  // every complete message in the ReadBuffer back to back instead of going through the state machine, and thus
+  // TryWrite, after every single one of them. The WriteQueue is flushed when a command asks for it (Sync, Flush,
+  // Simple Query) or once it spilled past its first buffer.
+  for (bool first = true;; first = false) {
+    try {
+      if (!TryBuildPacket(in)) return Transition::NEED_READ_TIMEOUT;
+    } catch (std::exception &e) {
+      NETWORK_LOG_ERROR("Encountered exception {0} when parsing packet", e.what());
+      return Transition::TERMINATE;
+    }
+    if (startup_) {
+      // Always flush startup packet response
+      out->ForceFlush();
+      curr_input_packet_.Clear();
+      return ProcessStartup(in, out, t_cop, context);
+    }
+
+    // Leave the packet in place for the next call, which the ConnectionHandle hands to an execution worker
+    if (!first && !may_execute && !WaitingForSync() && IsQueryExecution()) return Transition::PROCEED;
+
+    if (copy_in_ != nullptr && !IsCopyInMessage() &&
+        curr_input_packet_.msg_type_ != NetworkMessageType::PG_TERMINATE_COMMAND) {
+      // Flush and Sync are ignored in copy-in mode, any other message aborts the COPY
+      const auto msg_type = curr_input_packet_.msg_type_;
+      curr_input_packet_.Clear();
+      if (msg_type == NetworkMessageType::PG_FLUSH_COMMAND || msg_type == NetworkMessageType::PG_SYNC_COMMAND) {
+        continue;
+      }
+      PostgresPacketWriter writer(out);
+      const auto message =
+          fmt::format("unexpected message type 0x{:02X} during COPY from stdin", static_cast<uint8_t>(msg_type));
+      FailCopyIn(common::ManagedPointer<PostgresPacketWriter>(&writer), t_cop, context,
+                 {common::ErrorSeverity::ERROR, message, common::ErrorCode::ERRCODE_PROTOCOL_VIOLATION});
+      return Transition::PROCEED;
+    }
+
+    auto command = command_factory_->PacketToCommand(common::ManagedPointer<InputPacket>(&curr_input_packet_));
+    PostgresPacketWriter writer(out);
+    if (command->FlushOnComplete()) out->ForceFlush();
+
+    if (WaitingForSync() && curr_input_packet_.msg_type_ != NetworkMessageType::PG_SYNC_COMMAND) {
+      // When an error is detected while processing any Extended Query message, the backend issues ErrorResponse, then
+      // reads and discards messages until a Sync is reached
+      curr_input_packet_.Clear();
+      if (out->ShouldFlush()) return Transition::PROCEED;
+      continue;
+    }
+
+    const Transition ret = command->Exec(common::ManagedPointer<ProtocolInterpreter>(this),
+                                         common::ManagedPointer<PostgresPacketWriter>(&writer), t_cop, context);
     curr_input_packet_.Clear();
-    return ProcessStartup(in, out, t_cop, context);
+    if (ret != Transition::PROCEED || out->ShouldFlush()) return ret;
   }
-  auto command = command_factory_->PacketToCommand(common::ManagedPointer<InputPacket>(&curr_input_packet_));
-  PostgresPacketWriter writer(out);
-  if (command->FlushOnComplete()) out->ForceFlush();
+}
 
-  if (WaitingForSync() && curr_input_packet_.msg_type_ != NetworkMessageType::PG_SYNC_COMMAND) {
-    // When an error is detected while processing any Extended Query message, the backend issues ErrorResponse, then
-    // reads and discards messages until a Sync is reached
-    curr_input_packet_.Clear();
-    return Transition::PROCEED;
+bool PostgresProtocolInterpreter::ShouldProcessOnWorker(const common::ManagedPointer<ReadBuffer> in) {
+  // The ConnectionHandle only asks when it has execution workers, so queries must not run on the handler thread
+  execution_offloaded_ = true;
+  if (startup_) return false;
+  try {
+    // Building the packet is idempotent once it is complete, so Process() picks it up where this left off.
+    if (!TryBuildPacket(in)) return false;
+  } catch (std::exception &e) {
+    // Let Process() run into the same error on the handler thread and terminate the connection.
+    return false;
   }
+  // Messages discarded while waiting for Sync are cheap.
+  if (WaitingForSync()) return false;
+  processing_on_worker_ = IsQueryExecution();
+  return processing_on_worker_;
+}
 
-  const Transition ret = command->Exec(common::ManagedPointer<ProtocolInterpreter>(this),
-                                       common::ManagedPointer<PostgresPacketWriter>(&writer), t_cop, context);
-  curr_input_packet_.Clear();
-  return ret;
+bool PostgresProtocolInterpreter::IsQueryExecution() const {
+  // The rows of a COPY FROM STDIN are inserted as its CopyData messages come in
+  return curr_input_packet_.msg_type_ == NetworkMessageType::PG_SIMPLE_QUERY_COMMAND ||
+         curr_input_packet_.msg_type_ == NetworkMessageType::PG_EXECUTE_COMMAND || IsCopyInMessage();
+}
+
+bool PostgresProtocolInterpreter::IsCopyInMessage() const {
+  return curr_input_packet_.msg_type_ == NetworkMessageType::PG_COPY_DATA ||
+         curr_input_packet_.msg_type_ == NetworkMessageType::PG_COPY_DONE ||
+         curr_input_packet_.msg_type_ == NetworkMessageType::PG_COPY_FAIL_COMMAND;
+}
+
+void PostgresProtocolInterpreter::FailCopyIn(const common::ManagedPointer<PostgresPacketWriter> out,
+                                             const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                             const common::ManagedPointer<ConnectionContext> connection,
+                                             const common::ErrorData &error) {
+  out->WriteError(error);
+  copy_in_.reset();
+  connection->Transaction()->SetMustAbort();
+  if (!ExplicitTransactionBlock()) {
+    ClosePortalExecutions();
+    t_cop->EndTransaction(connection, QueryType::QUERY_ROLLBACK);
+    ResetTransactionState();
+  }
+  out->WriteReadyForQuery(connection->TransactionState());
+  // The client may still be sending data, let it know right away that it can stop
+  out->ForceFlush();
 }
 
 Transition PostgresProtocolInterpreter::ProcessStartup(const common::ManagedPointer<ReadBuffer> in,
@@ -139,8 +218,10 @@ void PostgresProtocolInterpreter::Teardown(const common::ManagedPointer<ReadBuff
                                            const common::ManagedPointer<WriteQueue> out,
                                            const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
                                            const common::ManagedPointer<ConnectionContext> context) {
-  // Close any open transaction
+  // Close any open transaction, along with a COPY that was still running in it
+  copy_in_.reset();
   if (context->Transaction() != nullptr) {
+    ClosePortalExecutions();
     t_cop->EndTransaction(context, QueryType::QUERY_ROLLBACK);
     // We're about to destruct this object (probably), but reset state anyway
     ResetTransactionState();
@@ -162,6 +243,20 @@ void PostgresProtocolInterpreter::Teardown(const common::ManagedPointer<ReadBuff
   }
 }
 
+void PostgresProtocolInterpreter::ResetForReuse() {
+  startup_ = true;
+  waiting_for_sync_ = false;
+  explicit_txn_block_ = false;
+  execution_offloaded_ = false;
+  processing_on_worker_ = false;
+  copy_in_.reset();
+  // Portals refer to statements, which in turn are owned by the cache, so they are released in that order
+  portals_.clear();
+  statements_.clear();
+  cache_.Clear();
+  curr_input_packet_.Clear();
+}
+
 size_t PostgresProtocolInterpreter::GetPacketHeaderSize() { return startup_ ? sizeof(uint32_t) : 1 + sizeof(uint32_t); }
 
 void PostgresProtocolInterpreter::SetPacketMessageType(const common::ManagedPointer<ReadBuffer> in) {
@@ -0,0 +1,47 @@
+#include "network/postgres/postgres_text_formatter.h"
+
+#include <utility>
+
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::network {
+
+char *PostgresTextFormatter::FormatReal(const double value, char *const out) {
+  // fmt formats into the iterator through a fixed-size stack buffer, so this does not allocate either
+  return fmt::format_to(out, "{}", value);
+}
+
+char *PostgresTextFormatter::FormatDate(execution::sql::Date value, char *out) {
+  int32_t year, month, day;
+  value.ExtractComponents(&year, &month, &day);
+  out = FormatInteger(year, out);
+  *out++ = '-';
+  WriteTwoDigits(static_cast<uint32_t>(month), out);
+  out += 2;
+  *out++ = '-';
+  WriteTwoDigits(static_cast<uint32_t>(day), out);
+  return out + 2;
+}
+
+char *PostgresTextFormatter::FormatTimestamp(const execution::sql::Timestamp value, char *out) {
+  int32_t year, month, day, hour, min, sec, millisec, microsec;
+  value.ExtractComponents(&year, &month, &day, &hour, &min, &sec, &millisec, &microsec);
+  out = FormatInteger(year, out);
+  const std::array<std::pair<char, int32_t>, 5> components = {
+      {{'-', month}, {'-', day}, {' ', hour}, {':', min}, {':', sec}}};
+  for (const auto &[separator, component] : components) {
+    *out++ = separator;
+    WriteTwoDigits(static_cast<uint32_t>(component), out);
+    out += 2;
+  }
+
+  // Fractional seconds are always printed with six digits
+  const auto fraction = static_cast<uint32_t>(millisec * 1000 + microsec);
+  *out++ = '.';
+  WriteTwoDigits(fraction / 10000, out);
+  WriteTwoDigits(fraction / 100 % 100, out + 2);
+  WriteTwoDigits(fraction % 100, out + 4);
+  return out + 6;
+}
+
+}  // namespace noisepage::network
@@ -0,0 +1,163 @@
+#include "optimizer/cost_model/cardinality_cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "catalog/catalog_accessor.h"
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/memo.h"
+#include "optimizer/physical_operators.h"
+#include "parser/expression/column_value_expression.h"
+
+namespace noisepage::optimizer {
+
+double CardinalityCostModel::CalculateCost(transaction::TransactionContext *txn, catalog::CatalogAccessor *accessor,
+                                           Memo *memo, GroupExpression *gexpr) {
+  gexpr_ = gexpr;
+  memo_ = memo;
+  txn_ = txn;
+  accessor_ = accessor;
+  output_cost_ = 0;
+  gexpr_->Contents()->Accept(common::ManagedPointer<OperatorVisitor>(this));
+  return output_cost_;
+}
+
+double CardinalityCostModel::GetGroupRows(Group *group) const {
+  if (!group->HasNumRows()) return static_cast<double>(params_.default_table_rows_);
+  // Never let a group look free to its consumers, even if it is estimated to be empty
+  return std::max(static_cast<double>(group->GetNumRows()), 1.0);
+}
+
+double CardinalityCostModel::GetOutputRows() const { return GetGroupRows(memo_->GetGroupByID(gexpr_->GetGroupID())); }
+
+double CardinalityCostModel::GetChildRows(size_t child_idx) const {
+  NOISEPAGE_ASSERT(child_idx < gexpr_->GetChildrenGroupsSize(), "Child index out of bounds");
+  return GetGroupRows(memo_->GetGroupByID(gexpr_->GetChildGroupId(static_cast<int>(child_idx))));
+}
+
+double CardinalityCostModel::GetTableRows() const {
+  auto table_rows = memo_->GetGroupByID(gexpr_->GetGroupID())->GetTableNumRows();
+  // An empty or never analyzed table is indistinguishable here, so assume the default size in both cases
+  if (table_rows == Group::UNINITIALIZED_NUM_ROWS || table_rows == 0) {
+    return static_cast<double>(params_.default_table_rows_);
+  }
+  return static_cast<double>(table_rows);
+}
+
+void CardinalityCostModel::Visit(const SeqScan *op) {
+  auto table_rows = GetTableRows();
+  auto num_predicates = static_cast<double>(op->GetPredicates().size());
+  output_cost_ = table_rows * (params_.seq_io_cost_ + num_predicates * params_.operator_cpu_cost_) +
+                 GetOutputRows() * params_.tuple_cpu_cost_;
+}
+
+void CardinalityCostModel::Visit(const IndexScan *op) {
+  auto *group = memo_->GetGroupByID(gexpr_->GetGroupID());
+  auto table_rows = GetTableRows();
+  bool has_stats = group->GetTableNumRows() != Group::UNINITIALIZED_NUM_ROWS && group->GetTableNumRows() != 0;
+
+  // Estimate the number of index entries that fall within the bounds of the scan. Every bound key column narrows the
+  // range by the selectivity that StatsCalculator derived for the underlying table column.
+  double index_rows = table_rows;
+  if (!op->GetBounds().empty()) {
+    const auto &filter_selectivities = group->GetFilterColumnSelectivities();
+    const auto &index_schema = accessor_->GetIndexSchema(op->GetIndexOID());
+    for (const auto &index_col : index_schema.GetColumns()) {
+      if (op->GetBounds().count(index_col.Oid()) == 0) continue;
+
+      double selectivity = params_.default_key_selectivity_;
+      auto expr = index_col.StoredExpression();
+      if (has_stats && expr->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
+        auto col_oid = expr.CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid();
+        auto it = filter_selectivities.find(col_oid);
+        if (it != filter_selectivities.end()) selectivity = it->second;
+      }
+      index_rows *= selectivity;
+    }
+    index_rows = std::max(index_rows, 1.0);
+  }
+
+  auto num_predicates = static_cast<double>(op->GetPredicates().size());
+  auto traversal_cost = std::log2(table_rows + 1) * params_.index_tuple_cpu_cost_;
+  auto fetch_cost = index_rows * (params_.index_tuple_cpu_cost_ + params_.random_io_cost_ +
+                                  num_predicates * params_.operator_cpu_cost_);
+  output_cost_ = traversal_cost + fetch_cost + GetOutputRows() * params_.tuple_cpu_cost_;
+}
+
+void CardinalityCostModel::Visit(const OrderBy *op) {
+  // OrderBy is added as an enforcer, so it sorts the output of its own group
+  auto num_keys = std::max<size_t>(op->GetNumSortKeys(), 1);
+  output_cost_ = SortCost(GetOutputRows(), num_keys);
+}
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const Limit *op) {
+  output_cost_ = GetOutputRows() * params_.tuple_cpu_cost_;
+}
+
+void CardinalityCostModel::Visit(const InnerIndexJoin *op) {
+  // The outer child drives one index probe per tuple, every match is fetched from the inner table
+  auto outer_rows = GetChildRows(0);
+  auto output_rows = GetOutputRows();
+  auto num_predicates = static_cast<double>(op->GetJoinPredicates().size());
+  output_cost_ = outer_rows * params_.index_probe_cost_ +
+                 output_rows * (params_.index_tuple_cpu_cost_ + params_.random_io_cost_ +
+                                num_predicates * params_.operator_cpu_cost_ + params_.tuple_cpu_cost_);
+}
+
+void CardinalityCostModel::Visit(const InnerNLJoin *op) { CostNLJoin(op->GetJoinPredicates().size()); }
+
+void CardinalityCostModel::Visit(const InnerHashJoin *op) { CostHashJoin(op->GetJoinPredicates().size()); }
+
+void CardinalityCostModel::Visit(const LeftHashJoin *op) { CostHashJoin(op->GetJoinPredicates().size()); }
+
+void CardinalityCostModel::Visit(const LeftSemiHashJoin *op) { CostHashJoin(op->GetJoinPredicates().size()); }
+
+void CardinalityCostModel::Visit(const HashGroupBy *op) {
+  auto input_rows = GetChildRows(0);
+  auto num_groups = GetOutputRows();
+  auto num_exprs = static_cast<double>(op->GetColumns().size() + op->GetHaving().size());
+  output_cost_ = input_rows * (params_.hash_build_cost_ + num_exprs * params_.operator_cpu_cost_) +
+                 num_groups * (params_.memory_tuple_cost_ + params_.tuple_cpu_cost_);
+}
+
+void CardinalityCostModel::Visit(const SortGroupBy *op) {
+  auto input_rows = GetChildRows(0);
+  auto num_groups = GetOutputRows();
+  auto num_keys = std::max<size_t>(op->GetColumns().size(), 1);
+  auto num_exprs = static_cast<double>(op->GetColumns().size() + op->GetHaving().size());
+  output_cost_ = SortCost(input_rows, num_keys) + input_rows * num_exprs * params_.operator_cpu_cost_ +
+                 num_groups * params_.tuple_cpu_cost_;
+}
+
+void CardinalityCostModel::CostNLJoin(size_t num_predicates) {
+  auto left_rows = GetChildRows(0);
+  auto right_rows = GetChildRows(1);
+  auto predicate_cost = static_cast<double>(std::max<size_t>(num_predicates, 1)) * params_.operator_cpu_cost_;
+  output_cost_ = left_rows * right_rows * (params_.seq_io_cost_ + predicate_cost) +
+                 GetOutputRows() * params_.tuple_cpu_cost_;
+}
+
+void CardinalityCostModel::CostHashJoin(size_t num_predicates) {
+  auto build_rows = GetChildRows(0);
+  auto probe_rows = GetChildRows(1);
+  auto output_rows = GetOutputRows();
+  auto predicate_cost = static_cast<double>(num_predicates) * params_.operator_cpu_cost_;
+  output_cost_ = build_rows * (params_.hash_build_cost_ + params_.memory_tuple_cost_) +
+                 probe_rows * params_.hash_probe_cost_ + output_rows * (predicate_cost + params_.tuple_cpu_cost_);
+}
+
+void CardinalityCostModel::CostPassThrough() {
+  if (gexpr_->GetChildrenGroupsSize() == 0) {
+    output_cost_ = 0.f;
+    return;
+  }
+  output_cost_ = GetChildRows(0) * params_.tuple_cpu_cost_;
+}
+
+double CardinalityCostModel::SortCost(double num_rows, size_t num_keys) const {
+  return num_rows * std::log2(num_rows + 1) * static_cast<double>(num_keys) * params_.sort_compare_cost_ +
+         num_rows * params_.memory_tuple_cost_;
+}
+
+}  // namespace noisepage::optimizer
@@ -1,5 +1,6 @@
 #include "optimizer/index_util.h"
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -9,6 +10,9 @@
 #include "catalog/catalog_accessor.h"
 #include "catalog/index_schema.h"
 #include "optimizer/properties.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/function_expression.h"
 #include "parser/expression_util.h"
 
 namespace noisepage::optimizer {
@@ -20,6 +24,11 @@ bool IndexUtil::SatisfiesSortWithIndex(catalog::CatalogAccessor *accessor, const
     return false;
   }
 
+  if (index_schema.IsPartial()) {
+    // Without the query predicates, there is no way to tell whether the index holds every tuple to be sorted
+    return false;
+  }
+
   std::vector<catalog::col_oid_t> mapped_cols;
   std::unordered_map<catalog::col_oid_t, catalog::indexkeycol_oid_t> lookup;
   if (!ConvertIndexKeyOidToColOid(accessor, tbl_oid, index_schema, &lookup, &mapped_cols)) {
@@ -58,8 +67,16 @@ std::pair<bool, bool> IndexUtil::SatisfiesPredicateWithIndex(
     planner::IndexScanType *scan_type,
     std::unordered_map<catalog::indexkeycol_oid_t, std::vector<planner::IndexExpression>> *bounds) {
   auto &index_schema = accessor->GetIndexSchema(index_oid);
-  if (!SatisfiesBaseColumnRequirement(index_schema)) {
-    return std::make_pair(false, false);
+
+  // A partial index can only be used if the query predicates guarantee that every qualifying tuple is in the index.
+  // Query predicates that the index predicate already guarantees do not need to be turned into key bounds.
+  std::vector<AnnotatedExpression> residual;
+  const auto *key_predicates = &predicates;
+  if (index_schema.IsPartial()) {
+    if (!ImpliesIndexPredicate(index_schema, predicates, &residual)) {
+      return std::make_pair(false, false);
+    }
+    key_predicates = &residual;
   }
 
   std::vector<catalog::col_oid_t> mapped_cols;
@@ -73,8 +90,20 @@ std::pair<bool, bool> IndexUtil::SatisfiesPredicateWithIndex(
   std::unordered_set<catalog::col_oid_t> mapped_set;
   for (auto col : mapped_cols) mapped_set.insert(col);
 
-  return CheckPredicates(index_schema, tbl_oid, tbl_alias, lookup, mapped_set, predicates, allow_cves, scan_type,
-                         bounds);
+  auto satisfaction = CheckPredicates(index_schema, tbl_oid, tbl_alias, lookup, mapped_set, *key_predicates,
+                                      allow_cves, scan_type, bounds);
+  if (!satisfaction.first && index_schema.IsPartial() && bounds->empty() &&
+      index_schema.Type() != storage::index::IndexType::HASHMAP) {
+    // No key column can be bounded, but the index still only holds the tuples that can qualify, so scan all of it.
+    // The scan re-applies every predicate, so the residual predicates do not need to be usable as bounds.
+    bool has_subquery = std::any_of(predicates.cbegin(), predicates.cend(),
+                                    [](const AnnotatedExpression &pred) { return pred.GetExpr()->HasSubquery(); });
+    if (!has_subquery) {
+      *scan_type = planner::IndexScanType::AscendingOpenBoth;
+      return std::make_pair(true, satisfaction.second);
+    }
+  }
+  return satisfaction;
 }
 
 std::pair<bool, bool> IndexUtil::CheckPredicates(
@@ -104,16 +133,31 @@ std::pair<bool, bool> IndexUtil::CheckPredicates(
       case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO: {
         // TODO(wz2): Support more complex/predicates on indexes
 
-        // Currently supports [column] (=/!=/>/>=/</<=) [value/parameter]
+        // Currently supports [column or expression key] (=/!=/>/>=/</<=) [value/parameter]
         // [column] = [column] will force a seq scan
         // [value] = [value] will force a seq scan (rewriter should fix this)
         auto ltype = expr->GetChild(0)->GetExpressionType();
         auto rtype = expr->GetChild(1)->GetExpressionType();
 
+        auto lvalue =
+            ltype == parser::ExpressionType::VALUE_CONSTANT || ltype == parser::ExpressionType::VALUE_PARAMETER;
+        auto rvalue =
+            rtype == parser::ExpressionType::VALUE_CONSTANT || rtype == parser::ExpressionType::VALUE_PARAMETER;
+
         common::ManagedPointer<parser::ColumnValueExpression> tv_expr;
         common::ManagedPointer<parser::AbstractExpression> idx_expr;
-        if (ltype == parser::ExpressionType::COLUMN_VALUE &&
-            (rtype == parser::ExpressionType::VALUE_CONSTANT || rtype == parser::ExpressionType::VALUE_PARAMETER)) {
+        catalog::indexkeycol_oid_t expr_key = catalog::INVALID_INDEXKEYCOL_OID;
+        if (ltype != parser::ExpressionType::COLUMN_VALUE && rvalue &&
+            (expr_key = MatchExpressionKey(schema, expr->GetChild(0))) != catalog::INVALID_INDEXKEYCOL_OID) {
+          // [expression key] (=/!=/>/>=/</<=) [value/parameter]
+          idx_expr = expr->GetChild(1);
+          left_side = true;
+        } else if (rtype != parser::ExpressionType::COLUMN_VALUE && lvalue &&
+                   (expr_key = MatchExpressionKey(schema, expr->GetChild(1))) != catalog::INVALID_INDEXKEYCOL_OID) {
+          idx_expr = expr->GetChild(0);
+          type = parser::ExpressionUtil::ReverseComparisonExpressionType(type);
+          left_side = true;
+        } else if (ltype == parser::ExpressionType::COLUMN_VALUE && rvalue) {
           tv_expr = expr->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
           idx_expr = expr->GetChild(1);
         } else if (rtype == parser::ExpressionType::COLUMN_VALUE &&
@@ -142,9 +186,13 @@ std::pair<bool, bool> IndexUtil::CheckPredicates(
           continue;
         }
 
-        auto col_oid = tv_expr->GetColumnOid();
-        if (mapped_cols.find(col_oid) != mapped_cols.end()) {
-          auto idxkey = lookup.find(col_oid)->second;
+        if (expr_key == catalog::INVALID_INDEXKEYCOL_OID &&
+            mapped_cols.find(tv_expr->GetColumnOid()) != mapped_cols.end()) {
+          expr_key = lookup.find(tv_expr->GetColumnOid())->second;
+        }
+
+        if (expr_key != catalog::INVALID_INDEXKEYCOL_OID) {
+          auto idxkey = expr_key;
           if (type == parser::ExpressionType::COMPARE_EQUAL) {
             // Exact is simulated as open high of idx_expr and open low of idx_expr
             open_highs[idxkey] = idx_expr;
@@ -245,7 +293,6 @@ bool IndexUtil::ConvertIndexKeyOidToColOid(catalog::CatalogAccessor *accessor, c
                                            const catalog::IndexSchema &schema,
                                            std::unordered_map<catalog::col_oid_t, catalog::indexkeycol_oid_t> *key_map,
                                            std::vector<catalog::col_oid_t> *col_oids) {
-  NOISEPAGE_ASSERT(SatisfiesBaseColumnRequirement(schema), "GetIndexColOid() pre-cond not satisfied");
   auto &tbl_schema = accessor->GetSchema(tbl_oid);
   if (tbl_schema.GetColumns().size() < schema.GetColumns().size()) {
     return false;
@@ -276,4 +323,201 @@ bool IndexUtil::ConvertIndexKeyOidToColOid(catalog::CatalogAccessor *accessor, c
   return true;
 }
 
+bool IndexUtil::ImpliesIndexPredicate(const catalog::IndexSchema &schema,
+                                      const std::vector<AnnotatedExpression> &predicates,
+                                      std::vector<AnnotatedExpression> *residual) {
+  std::vector<common::ManagedPointer<const parser::AbstractExpression>> conjuncts;
+  std::vector<common::ManagedPointer<const parser::AbstractExpression>> stack{schema.GetPredicate()};
+  while (!stack.empty()) {
+    auto expr = stack.back();
+    stack.pop_back();
+    if (expr->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
+      for (const auto &child : expr->GetChildren()) {
+        stack.emplace_back(child.CastManagedPointerTo<const parser::AbstractExpression>());
+      }
+    } else {
+      conjuncts.emplace_back(expr);
+    }
+  }
+
+  std::vector<bool> guaranteed(predicates.size(), false);
+  for (const auto &conjunct : conjuncts) {
+    bool implied = false;
+    for (size_t i = 0; i < predicates.size(); i++) {
+      auto pred = predicates[i].GetExpr().CastManagedPointerTo<const parser::AbstractExpression>();
+      if (ExpressionsMatch(pred, conjunct)) {
+        // The index predicate alone already guarantees this query predicate
+        guaranteed[i] = true;
+        implied = true;
+      } else if (!implied) {
+        implied = ImpliesConjunct(pred, conjunct);
+      }
+    }
+    if (!implied) return false;
+  }
+
+  for (size_t i = 0; i < predicates.size(); i++) {
+    if (!guaranteed[i]) residual->emplace_back(predicates[i]);
+  }
+  return true;
+}
+
+catalog::indexkeycol_oid_t IndexUtil::MatchExpressionKey(const catalog::IndexSchema &schema,
+                                                         common::ManagedPointer<parser::AbstractExpression> expr) {
+  auto target = expr.CastManagedPointerTo<const parser::AbstractExpression>();
+  for (const auto &column : schema.GetColumns()) {
+    if (column.StoredExpression()->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE &&
+        ExpressionsMatch(column.StoredExpression(), target)) {
+      return column.Oid();
+    }
+  }
+  return catalog::INVALID_INDEXKEYCOL_OID;
+}
+
+bool IndexUtil::ExpressionsMatch(common::ManagedPointer<const parser::AbstractExpression> lhs,
+                                 common::ManagedPointer<const parser::AbstractExpression> rhs) {
+  if (lhs->GetExpressionType() != rhs->GetExpressionType() || lhs->GetChildrenSize() != rhs->GetChildrenSize()) {
+    return false;
+  }
+
+  switch (lhs->GetExpressionType()) {
+    case parser::ExpressionType::COLUMN_VALUE: {
+      auto lcve = lhs.CastManagedPointerTo<const parser::ColumnValueExpression>();
+      auto rcve = rhs.CastManagedPointerTo<const parser::ColumnValueExpression>();
+      return lcve->GetColumnOid() != catalog::INVALID_COLUMN_OID && lcve->GetColumnOid() == rcve->GetColumnOid();
+    }
+    case parser::ExpressionType::VALUE_CONSTANT:
+      return *lhs == *rhs;
+    case parser::ExpressionType::FUNCTION: {
+      auto lfunc = lhs.CastManagedPointerTo<const parser::FunctionExpression>();
+      auto rfunc = rhs.CastManagedPointerTo<const parser::FunctionExpression>();
+      if (lfunc->GetFuncName() != rfunc->GetFuncName()) return false;
+      break;
+    }
+    case parser::ExpressionType::VALUE_PARAMETER:
+      // Parameter values are not known until execution
+      return false;
+    default:
+      break;
+  }
+
+  for (size_t i = 0; i < lhs->GetChildrenSize(); i++) {
+    auto lchild = lhs->GetChild(i).CastManagedPointerTo<const parser::AbstractExpression>();
+    auto rchild = rhs->GetChild(i).CastManagedPointerTo<const parser::AbstractExpression>();
+    if (!ExpressionsMatch(lchild, rchild)) return false;
+  }
+  return true;
+}
+
+bool IndexUtil::ImpliesConjunct(common::ManagedPointer<const parser::AbstractExpression> pred,
+                                common::ManagedPointer<const parser::AbstractExpression> conjunct) {
+  catalog::col_oid_t pred_col;
+  parser::ExpressionType pred_type;
+  common::ManagedPointer<const parser::AbstractExpression> pred_value;
+  if (!DecomposeComparison(pred, &pred_col, &pred_type, &pred_value)) return false;
+
+  if (conjunct->GetExpressionType() == parser::ExpressionType::OPERATOR_IS_NOT_NULL) {
+    // Comparisons are never true on NULL, so "col op value" implies "col IS NOT NULL"
+    auto child = conjunct->GetChild(0);
+    return child->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
+           child.CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid() == pred_col;
+  }
+
+  catalog::col_oid_t conj_col;
+  parser::ExpressionType conj_type;
+  common::ManagedPointer<const parser::AbstractExpression> conj_value;
+  if (!DecomposeComparison(conjunct, &conj_col, &conj_type, &conj_value) || conj_col != pred_col) return false;
+
+  double p;
+  double c;
+  if (!NumericConstant(pred_value, &p) || !NumericConstant(conj_value, &c)) return false;
+
+  switch (conj_type) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      return pred_type == parser::ExpressionType::COMPARE_EQUAL && p == c;
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+      return (pred_type == parser::ExpressionType::COMPARE_EQUAL && p != c) ||
+             (pred_type == parser::ExpressionType::COMPARE_LESS_THAN && p <= c) ||
+             (pred_type == parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO && p < c) ||
+             (pred_type == parser::ExpressionType::COMPARE_GREATER_THAN && p >= c) ||
+             (pred_type == parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO && p > c);
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      return ((pred_type == parser::ExpressionType::COMPARE_EQUAL ||
+               pred_type == parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO) &&
+              p < c) ||
+             (pred_type == parser::ExpressionType::COMPARE_LESS_THAN && p <= c);
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      return (pred_type == parser::ExpressionType::COMPARE_EQUAL ||
+              pred_type == parser::ExpressionType::COMPARE_LESS_THAN ||
+              pred_type == parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO) &&
+             p <= c;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      return ((pred_type == parser::ExpressionType::COMPARE_EQUAL ||
+               pred_type == parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO) &&
+              p > c) ||
+             (pred_type == parser::ExpressionType::COMPARE_GREATER_THAN && p >= c);
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      return (pred_type == parser::ExpressionType::COMPARE_EQUAL ||
+              pred_type == parser::ExpressionType::COMPARE_GREATER_THAN ||
+              pred_type == parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO) &&
+             p >= c;
+    default:
+      return false;
+  }
+}
+
+bool IndexUtil::DecomposeComparison(common::ManagedPointer<const parser::AbstractExpression> expr,
+                                    catalog::col_oid_t *col_oid, parser::ExpressionType *type,
+                                    common::ManagedPointer<const parser::AbstractExpression> *value) {
+  *type = expr->GetExpressionType();
+  switch (*type) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      break;
+    default:
+      return false;
+  }
+
+  auto lhs = expr->GetChild(0);
+  auto rhs = expr->GetChild(1);
+  if (rhs->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
+      lhs->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+    // Normalize to [column] op [value]
+    std::swap(lhs, rhs);
+    *type = parser::ExpressionUtil::ReverseComparisonExpressionType(*type);
+  }
+  if (lhs->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE ||
+      (rhs->GetExpressionType() != parser::ExpressionType::VALUE_CONSTANT &&
+       rhs->GetExpressionType() != parser::ExpressionType::VALUE_PARAMETER)) {
+    return false;
+  }
+
+  *col_oid = lhs.CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid();
+  *value = rhs.CastManagedPointerTo<const parser::AbstractExpression>();
+  return *col_oid != catalog::INVALID_COLUMN_OID;
+}
+
+bool IndexUtil::NumericConstant(common::ManagedPointer<const parser::AbstractExpression> expr, double *value) {
+  if (expr->GetExpressionType() != parser::ExpressionType::VALUE_CONSTANT) return false;
+  auto cve = expr.CastManagedPointerTo<const parser::ConstantValueExpression>();
+  if (cve->IsNull()) return false;
+  switch (cve->GetReturnValueType()) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      *value = static_cast<double>(cve->Peek<int64_t>());
+      return true;
+    case type::TypeId::REAL:
+      *value = cve->Peek<double>();
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace noisepage::optimizer
@@ -0,0 +1,264 @@
+#include "optimizer/join_order_enumerator.h"
+
+#include <cstddef>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace noisepage::optimizer {
+
+namespace {
+
+/** @return set containing only the given relation */
+constexpr JoinOrderEnumerator::RelationSet Singleton(size_t relation) {
+  return JoinOrderEnumerator::RelationSet{1} << relation;
+}
+
+/** @return index of the lowest relation in a non-empty set */
+size_t LowestRelation(JoinOrderEnumerator::RelationSet set) {
+  NOISEPAGE_ASSERT(set != 0, "Set must not be empty");
+  return static_cast<size_t>(__builtin_ctzll(set));
+}
+
+/** @return set with every relation i moved to position mapping[i] */
+JoinOrderEnumerator::RelationSet RemapSet(JoinOrderEnumerator::RelationSet set, const std::vector<size_t> &mapping) {
+  JoinOrderEnumerator::RelationSet result = 0;
+  for (; set != 0; set &= set - 1) result |= Singleton(mapping[LowestRelation(set)]);
+  return result;
+}
+
+/**
+ * Calls fn on every non-empty subset of set, in increasing numeric order. Every subset of a subset is therefore
+ * visited before the subset itself, which is the order DPccp relies on.
+ */
+template <typename Fn>
+void ForEachSubset(JoinOrderEnumerator::RelationSet set, Fn fn) {
+  for (JoinOrderEnumerator::RelationSet subset = (0 - set) & set; subset != 0; subset = (subset - set) & set) {
+    fn(subset);
+  }
+}
+
+}  // namespace
+
+size_t JoinOrderEnumerator::AddRelation(double num_rows) {
+  NOISEPAGE_ASSERT(relation_rows_.size() < MAX_RELATIONS, "Too many relations to enumerate");
+  relation_rows_.push_back(num_rows);
+  return relation_rows_.size() - 1;
+}
+
+void JoinOrderEnumerator::AddPredicate(RelationSet relations, double selectivity) {
+  NOISEPAGE_ASSERT((relations & ~GetAllRelations()) == 0, "Predicate references unknown relation");
+  predicates_.emplace_back(relations, selectivity);
+}
+
+void JoinOrderEnumerator::Enumerate() {
+  NOISEPAGE_ASSERT(!relation_rows_.empty(), "Nothing to enumerate");
+  NOISEPAGE_ASSERT(best_plans_.empty(), "Enumerate should only be called once");
+  BuildJoinGraph();
+
+  if (relation_rows_.size() > MAX_DP_RELATIONS) {
+    EnumerateGreedy();
+    return;
+  }
+
+  // DPccp only emits every connected pair in a valid dynamic programming order if relations are numbered breadth-first,
+  // so enumerate in that numbering and translate the resulting plans back afterwards
+  auto order = BreadthFirstOrder();
+  std::vector<size_t> position(order.size());
+  for (size_t i = 0; i < order.size(); i++) position[order[i]] = i;
+
+  auto original_rows = relation_rows_;
+  auto original_predicates = predicates_;
+  auto original_neighbors = neighbors_;
+  for (size_t i = 0; i < order.size(); i++) {
+    relation_rows_[i] = original_rows[order[i]];
+    neighbors_[i] = RemapSet(original_neighbors[order[i]], position);
+  }
+  for (auto &predicate : predicates_) predicate.first = RemapSet(predicate.first, position);
+
+  EnumerateDP();
+
+  relation_rows_ = std::move(original_rows);
+  predicates_ = std::move(original_predicates);
+  neighbors_ = std::move(original_neighbors);
+  RestoreNumbering(order);
+  used_dp_ = true;
+}
+
+void JoinOrderEnumerator::BuildJoinGraph() {
+  const auto num_relations = relation_rows_.size();
+  for (size_t i = 0; i < num_relations; i++) join_graph_.AddVertex(i);
+  for (const auto &predicate : predicates_) {
+    // A predicate over more than two relations connects every pair of them
+    for (auto src = predicate.first; src != 0; src &= src - 1) {
+      for (auto dst = predicate.first; dst != 0; dst &= dst - 1) {
+        if (LowestRelation(src) != LowestRelation(dst)) join_graph_.AddEdge(LowestRelation(src), LowestRelation(dst));
+      }
+    }
+  }
+
+  auto collect_neighbors = [&] {
+    neighbors_.assign(num_relations, 0);
+    for (size_t i = 0; i < num_relations; i++) {
+      for (const auto adjacent : join_graph_.AdjacenciesFor(i)) neighbors_[i] |= Singleton(adjacent);
+    }
+  };
+  collect_neighbors();
+
+  // Connect every component of the join graph to the previous one so that a cross product can be placed between them
+  RelationSet visited = 0;
+  size_t previous_root = 0;
+  for (size_t root = 0; root < num_relations; root++) {
+    if ((visited & Singleton(root)) != 0) continue;
+    RelationSet component = Singleton(root);
+    for (RelationSet frontier = component; frontier != 0;) {
+      frontier = Neighbors(component);
+      component |= frontier;
+    }
+    if (visited != 0) {
+      join_graph_.AddEdge(previous_root, root);
+      join_graph_.AddEdge(root, previous_root);
+    }
+    visited |= component;
+    previous_root = root;
+  }
+  collect_neighbors();
+}
+
+std::vector<size_t> JoinOrderEnumerator::BreadthFirstOrder() const {
+  std::vector<size_t> order;
+  order.reserve(relation_rows_.size());
+  RelationSet visited = Singleton(0);
+  std::queue<size_t> frontier;
+  frontier.push(0);
+  while (!frontier.empty()) {
+    auto relation = frontier.front();
+    frontier.pop();
+    order.push_back(relation);
+    for (auto adjacent = neighbors_[relation] & ~visited; adjacent != 0; adjacent &= adjacent - 1) {
+      visited |= Singleton(LowestRelation(adjacent));
+      frontier.push(LowestRelation(adjacent));
+    }
+  }
+  NOISEPAGE_ASSERT(order.size() == relation_rows_.size(), "Join graph should be connected");
+  return order;
+}
+
+void JoinOrderEnumerator::EnumerateDP() {
+  const auto num_relations = relation_rows_.size();
+  for (size_t i = 0; i < num_relations; i++) {
+    best_plans_[Singleton(i)] = {0, 0, relation_rows_[i], 0};
+  }
+  for (size_t i = num_relations; i-- > 0;) {
+    EmitCsg(Singleton(i));
+    EnumerateCsgRec(Singleton(i), (Singleton(i) << 1) - 1);
+  }
+}
+
+void JoinOrderEnumerator::EnumerateGreedy() {
+  std::vector<RelationSet> trees;
+  for (size_t i = 0; i < relation_rows_.size(); i++) {
+    best_plans_[Singleton(i)] = {0, 0, relation_rows_[i], 0};
+    trees.push_back(Singleton(i));
+  }
+
+  while (trees.size() > 1) {
+    // Join the connected pair of subtrees with the smallest result, the join graph is connected so one always exists
+    size_t best_left = 0;
+    size_t best_right = 0;
+    double best_cardinality = 0;
+    for (size_t left = 0; left < trees.size(); left++) {
+      const auto neighbors = Neighbors(trees[left]);
+      for (size_t right = left + 1; right < trees.size(); right++) {
+        if ((neighbors & trees[right]) == 0) continue;
+        auto cardinality = EstimateCardinality(trees[left] | trees[right]);
+        if (best_left == best_right || cardinality < best_cardinality) {
+          best_left = left;
+          best_right = right;
+          best_cardinality = cardinality;
+        }
+      }
+    }
+    NOISEPAGE_ASSERT(best_left != best_right, "Join graph should be connected");
+    EmitCsgCmp(trees[best_left], trees[best_right]);
+    trees[best_left] |= trees[best_right];
+    trees.erase(trees.begin() + static_cast<std::ptrdiff_t>(best_right));
+  }
+}
+
+void JoinOrderEnumerator::EnumerateCsgRec(RelationSet set, RelationSet excluded) {
+  const auto neighbors = Neighbors(set) & ~excluded;
+  if (neighbors == 0) return;
+  ForEachSubset(neighbors, [&](RelationSet subset) { EmitCsg(set | subset); });
+  ForEachSubset(neighbors, [&](RelationSet subset) { EnumerateCsgRec(set | subset, excluded | neighbors); });
+}
+
+void JoinOrderEnumerator::EmitCsg(RelationSet set) {
+  // Only consider complements whose relations all come after the lowest relation of the set, so that every pair is
+  // emitted exactly once
+  const auto excluded = set | ((Singleton(LowestRelation(set)) << 1) - 1);
+  const auto neighbors = Neighbors(set) & ~excluded;
+  for (size_t relation = relation_rows_.size(); relation-- > 0;) {
+    if ((neighbors & Singleton(relation)) == 0) continue;
+    EmitCsgCmp(set, Singleton(relation));
+    EnumerateCmpRec(set, Singleton(relation), excluded | (neighbors & ((Singleton(relation) << 1) - 1)));
+  }
+}
+
+void JoinOrderEnumerator::EnumerateCmpRec(RelationSet set, RelationSet complement, RelationSet excluded) {
+  const auto neighbors = Neighbors(complement) & ~excluded;
+  if (neighbors == 0) return;
+  ForEachSubset(neighbors, [&](RelationSet subset) { EmitCsgCmp(set, complement | subset); });
+  ForEachSubset(neighbors,
+                [&](RelationSet subset) { EnumerateCmpRec(set, complement | subset, excluded | neighbors); });
+}
+
+void JoinOrderEnumerator::EmitCsgCmp(RelationSet left, RelationSet right) {
+  const auto &left_plan = best_plans_.at(left);
+  const auto &right_plan = best_plans_.at(right);
+  const auto set = left | right;
+
+  auto it = best_plans_.find(set);
+  const auto cardinality = it != best_plans_.end() ? it->second.cardinality_ : EstimateCardinality(set);
+  const auto cost = cardinality + left_plan.cost_ + right_plan.cost_;
+  if (it != best_plans_.end() && it->second.cost_ <= cost) return;
+
+  // C_out is symmetric, but default to building the hash table on the smaller input
+  if (left_plan.cardinality_ > right_plan.cardinality_) std::swap(left, right);
+  best_plans_[set] = {left, right, cardinality, cost};
+}
+
+JoinOrderEnumerator::RelationSet JoinOrderEnumerator::Neighbors(RelationSet set) const {
+  RelationSet result = 0;
+  for (auto remaining = set; remaining != 0; remaining &= remaining - 1) {
+    result |= neighbors_[LowestRelation(remaining)];
+  }
+  return result & ~set;
+}
+
+double JoinOrderEnumerator::EstimateCardinality(RelationSet set) const {
+  double cardinality = 1.0;
+  for (auto remaining = set; remaining != 0; remaining &= remaining - 1) {
+    cardinality *= relation_rows_[LowestRelation(remaining)];
+  }
+  for (const auto &predicate : predicates_) {
+    if ((predicate.first & ~set) == 0) cardinality *= predicate.second;
+  }
+  return cardinality;
+}
+
+void JoinOrderEnumerator::RestoreNumbering(const std::vector<size_t> &order) {
+  std::unordered_map<RelationSet, JoinPlan> plans;
+  plans.reserve(best_plans_.size());
+  for (const auto &entry : best_plans_) {
+    auto plan = entry.second;
+    plan.left_ = RemapSet(plan.left_, order);
+    plan.right_ = RemapSet(plan.right_, order);
+    plans[RemapSet(entry.first, order)] = plan;
+  }
+  best_plans_ = std::move(plans);
+}
+
+}  // namespace noisepage::optimizer
@@ -857,6 +857,7 @@ BaseOperatorNodeContents *LogicalCreateIndex::Copy() const {
   op->index_name_ = index_name_;
   op->index_attrs_ = index_attrs_;
   op->index_options_ = catalog::IndexOptions(index_options_);
+  op->index_predicate_ = index_predicate_;
   return op;
 }
 
@@ -864,7 +865,8 @@ Operator LogicalCreateIndex::Make(catalog::db_oid_t database_oid, catalog::names
                                   catalog::table_oid_t table_oid, parser::IndexType index_type, bool unique,
                                   std::string index_name,
                                   std::vector<common::ManagedPointer<parser::AbstractExpression>> index_attrs,
-                                  catalog::IndexOptions index_options) {
+                                  catalog::IndexOptions index_options,
+                                  common::ManagedPointer<parser::AbstractExpression> index_predicate) {
   auto *op = new LogicalCreateIndex();
   op->database_oid_ = database_oid;
   op->namespace_oid_ = namespace_oid;
@@ -874,6 +876,7 @@ Operator LogicalCreateIndex::Make(catalog::db_oid_t database_oid, catalog::names
   op->index_name_ = std::move(index_name);
   op->index_attrs_ = std::move(index_attrs);
   op->index_options_ = std::move(index_options);
+  op->index_predicate_ = index_predicate;
   return Operator(common::ManagedPointer<BaseOperatorNodeContents>(op));
 }
 
@@ -889,6 +892,7 @@ common::hash_t LogicalCreateIndex::Hash() const {
     hash = common::HashUtil::CombineHashes(hash, attr->Hash());
   }
   hash = common::HashUtil::CombineHashes(hash, index_options_.Hash());
+  if (index_predicate_ != nullptr) hash = common::HashUtil::CombineHashes(hash, index_predicate_->Hash());
   return hash;
 }
 
@@ -905,6 +909,8 @@ bool LogicalCreateIndex::operator==(const BaseOperatorNodeContents &r) {
   for (size_t i = 0; i < index_attrs_.size(); i++) {
     if (*(index_attrs_[i]) != *(node.index_attrs_[i])) return false;
   }
+  if ((index_predicate_ == nullptr) != (node.index_predicate_ == nullptr)) return false;
+  if (index_predicate_ != nullptr && *index_predicate_ != *node.index_predicate_) return false;
   return index_options_ == node.index_options_;
 }
 
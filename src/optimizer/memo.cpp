@@ -23,15 +23,18 @@ GroupExpression *Memo::InsertExpression(GroupExpression *gexpr, group_id_t targe
   }
 
   gexpr->SetGroupID(target_group);
-  // Lookup in hash table
-  auto it = group_expressions_.find(gexpr);
-  if (it != group_expressions_.end()) {
+  // Lookup in hash table. The stripe stays latched until the expression is in its group, so that a concurrent
+  // duplicate never observes it without a group.
+  auto &stripe = GetStripe(gexpr);
+  common::SpinLatch::ScopedSpinLatch guard(&stripe.latch_);
+  auto it = stripe.group_expressions_.find(gexpr);
+  if (it != stripe.group_expressions_.end()) {
     NOISEPAGE_ASSERT(*gexpr == *(*it), "GroupExpression should be equal");
     delete gexpr;
     return *it;
   }
 
-  group_expressions_.insert(gexpr);
+  stripe.group_expressions_.insert(gexpr);
 
   // New expression, so try to insert into an existing group or
   // create a new group if none specified
@@ -48,8 +51,6 @@ GroupExpression *Memo::InsertExpression(GroupExpression *gexpr, group_id_t targe
 }
 
 group_id_t Memo::AddNewGroup(GroupExpression *gexpr) {
-  auto new_group_id = group_id_t(groups_.size());
-
   // Find out the table alias that this group represents
   std::unordered_set<std::string> table_aliases;
   auto op_type = gexpr->Contents()->GetOpType();
@@ -74,6 +75,8 @@ group_id_t Memo::AddNewGroup(GroupExpression *gexpr) {
     }
   }
 
+  common::SharedLatch::ScopedExclusiveLatch guard(&groups_latch_);
+  auto new_group_id = group_id_t(groups_.size());
   groups_.push_back(new Group(new_group_id, std::move(table_aliases)));
   return new_group_id;
 }
@@ -11,10 +11,12 @@
 #include "optimizer/operator_visitor.h"
 #include "optimizer/optimization_context.h"
 #include "optimizer/optimizer_task_pool.h"
+#include "optimizer/parallel_group_optimizer.h"
 #include "optimizer/plan_generator.h"
 #include "optimizer/properties.h"
 #include "optimizer/property_enforcer.h"
 #include "optimizer/rule.h"
+#include "optimizer/statistics/stats_storage.h"
 #include "planner/plannodes/abstract_plan_node.h"
 #include "planner/plannodes/cte_scan_plan_node.h"
 #include "planner/plannodes/output_schema.h"
@@ -32,6 +34,8 @@ std::unique_ptr<OptimizeResult> Optimizer::BuildPlanTree(
   context_->SetStatsStorage(storage);
   context_->SetParams(parameters);
   auto optimize_result = std::make_unique<OptimizeResult>();
+  // Read before any statistics are, so that a table marked stale while optimizing makes the plan outdated
+  if (storage != nullptr) optimize_result->SetStatsEpoch(storage->GetInvalidationEpoch());
 
   // Generate initial operator tree from query tree
   GroupExpression *gexpr = nullptr;
@@ -44,13 +48,10 @@ std::unique_ptr<OptimizeResult> Optimizer::BuildPlanTree(
   PropertySet *phys_properties = query_info.GetPhysicalProperties();
 
   // Give ManagedPointers to ChooseBestPlan
-  std::vector<common::ManagedPointer<parser::AbstractExpression>> output_exprs;
-  for (auto expr : query_info.GetOutputExprs()) {
-    output_exprs.push_back(expr);
-  }
+  const auto &output_exprs = query_info.GetOutputExprs();
 
   try {
-    OptimizeLoop(root_id, phys_properties);
+    OptimizeLoop(root_id, phys_properties, optimize_result.get());
   } catch (OptimizerException &e) {
     OPTIMIZER_LOG_WARN("Optimize Loop ended prematurely: {0}", e.what());
   }
@@ -58,6 +59,9 @@ std::unique_ptr<OptimizeResult> Optimizer::BuildPlanTree(
   try {
     PlanGenerator generator(optimize_result->GetPlanMetaData());
     auto best_plan = ChooseBestPlan(txn, accessor, root_id, phys_properties, output_exprs, &generator);
+    auto *best_expr = context_->GetMemo().GetGroupByID(root_id)->GetBestExpression(phys_properties);
+    optimize_result->SetCost(best_expr->GetCost(phys_properties));
+    optimize_result->SetParameterSelectivities(context_->TakeParameterSelectivities());
 
     // Assign CTE Schema to each CTE Node
     for (auto &table : context_->GetCTETables()) {
@@ -184,7 +188,9 @@ std::unique_ptr<planner::AbstractPlanNode> Optimizer::ChooseBestPlan(
   auto *op = new OperatorNode(gexpr->Contents(), {}, txn);
 
   planner::PlanMetaData::PlanNodeMetaData plan_node_meta_data(group->GetNumRows(), group->GetTableNumRows(),
-                                                              group->GetFilterColumnSelectivities());
+                                                              group->GetFilterColumnSelectivities(),
+                                                              group->GetCardinalitySignature(),
+                                                              group->IsCardinalityFromFeedback());
   auto plan = generator->ConvertOpNode(txn, accessor, op, required_props, required_cols, output_cols,
                                        std::move(children_plans), std::move(children_expr_map), plan_node_meta_data);
   OPTIMIZER_LOG_TRACE("Finish Choosing best plan for group " + std::to_string(id.UnderlyingValue()));
@@ -206,7 +212,8 @@ std::unique_ptr<planner::AbstractPlanNode> Optimizer::ChooseBestPlan(
   return plan;
 }
 
-void Optimizer::OptimizeLoop(group_id_t root_group_id, PropertySet *required_props) {
+void Optimizer::OptimizeLoop(group_id_t root_group_id, PropertySet *required_props,
+                             OptimizeResult *optimize_result) {
   auto root_context = new OptimizationContext(context_.get(), required_props->Copy());
   auto task_stack = new OptimizerTaskStack();
   context_->SetTaskPool(task_stack);
@@ -219,12 +226,23 @@ void Optimizer::OptimizeLoop(group_id_t root_group_id, PropertySet *required_pro
 
   // Perform optimization after the rewrite
   Memo &memo = context_->GetMemo();
-  task_stack->Push(new OptimizeGroup(memo.GetGroupByID(root_group_id), root_context));
+
+  // Choose join orders once the cardinalities of all base relations are known
+  task_stack->Push(new EnumerateJoinOrder(root_group_id, root_context));
 
   // Derive stats for the only one logical expression before optimizing
   task_stack->Push(new DeriveStats(memo.GetGroupByID(root_group_id)->GetLogicalExpression(), root_context));
 
   ExecuteTaskStack(task_stack, root_group_id, root_context);
+
+  // Optimize the independent subtrees of the query concurrently, the serial search below then reuses their winners
+  if (worker_pool_ != nullptr) {
+    ParallelGroupOptimizer parallel_optimizer(context_.get(), worker_pool_, task_execution_timeout_);
+    optimize_result->SetNumParallelGroups(parallel_optimizer.Optimize(root_group_id));
+  }
+
+  task_stack->Push(new OptimizeGroup(memo.GetGroupByID(root_group_id), root_context));
+  ExecuteTaskStack(task_stack, root_group_id, root_context);
 }
 
 void Optimizer::ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id,
@@ -3,11 +3,17 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "loggers/optimizer_logger.h"
 #include "optimizer/binding.h"
 #include "optimizer/child_property_deriver.h"
+#include "optimizer/join_order_enumerator.h"
+#include "optimizer/logical_operators.h"
 #include "optimizer/optimizer_context.h"
 #include "optimizer/property_enforcer.h"
 #include "optimizer/statistics/stats_calculator.h"
@@ -39,6 +45,15 @@ void OptimizerTask::ConstructValidRules(GroupExpression *group_expr, const std::
   }
 }
 
+void OptimizerTask::RemoveJoinReorderingRules(GroupExpression *group_expr, std::vector<RuleWithPromise> *valid_rules) {
+  if (!context_->GetOptimizerContext()->IsJoinOrderFixed(group_expr->GetGroupID())) return;
+  valid_rules->erase(std::remove_if(valid_rules->begin(), valid_rules->end(),
+                                    [](RuleWithPromise &rule) {
+                                      return rule.GetRule()->GetType() == RuleType::INNER_JOIN_ASSOCIATE;
+                                    }),
+                     valid_rules->end());
+}
+
 void OptimizerTask::PushTask(OptimizerTask *task) { context_->GetOptimizerContext()->PushTask(task); }
 
 Memo &OptimizerTask::GetMemo() const { return context_->GetOptimizerContext()->GetMemo(); }
@@ -82,6 +97,7 @@ void OptimizeExpression::Execute() {
   auto phys_rules = GetRuleSet().GetRulesByName(RuleSetName::PHYSICAL_IMPLEMENTATION);
   ConstructValidRules(group_expr_, logical_rules, &valid_rules);
   ConstructValidRules(group_expr_, phys_rules, &valid_rules);
+  RemoveJoinReorderingRules(group_expr_, &valid_rules);
 
   std::sort(valid_rules.begin(), valid_rules.end());
   OPTIMIZER_LOG_DEBUG("OptimizeExpression::execute() op {0}, valid rules : {1}",
@@ -129,6 +145,7 @@ void ExploreExpression::Execute() {
   // Construct valid transformation rules from rule set
   auto logical_rules = GetRuleSet().GetRulesByName(RuleSetName::LOGICAL_TRANSFORMATION);
   ConstructValidRules(group_expr_, logical_rules, &valid_rules);
+  RemoveJoinReorderingRules(group_expr_, &valid_rules);
   std::sort(valid_rules.begin(), valid_rules.end());
 
   // Apply rule
@@ -159,6 +176,10 @@ void ApplyRule::Execute() {
                                     context_->GetOptimizerContext()->GetTxn());
   while (iterator.HasNext()) {
     auto before = iterator.Next();
+    // Implementation rules look up the catalog, e.g. for the indexes of a table
+    std::unique_lock<std::mutex> shared_state_guard(context_->GetOptimizerContext()->GetSharedStateLatch(),
+                                                    std::defer_lock);
+    if (rule_->IsPhysical()) shared_state_guard.lock();
     if (!rule_->Check(common::ManagedPointer(before.get()), context_)) {
       continue;
     }
@@ -166,6 +187,7 @@ void ApplyRule::Execute() {
     // Caller frees after
     std::vector<std::unique_ptr<AbstractOptimizerNode>> after;
     rule_->Transform(common::ManagedPointer(before.get()), &after, context_);
+    if (shared_state_guard.owns_lock()) shared_state_guard.unlock();
     for (const auto &new_expr : after) {
       GroupExpression *new_gexpr = nullptr;
       auto g_id = group_expr_->GetGroupID();
@@ -212,12 +234,155 @@ void DeriveStats::Execute() {
       PushTask(new DeriveStats(child_group_gexpr, context_));
     }
   } else {
+    std::lock_guard<std::mutex> shared_state_guard(context_->GetOptimizerContext()->GetSharedStateLatch());
     StatsCalculator calculator;
     calculator.CalculateStats(gexpr_, context_->GetOptimizerContext());
     gexpr_->SetDerivedStats();
   }
 }
 
+//===--------------------------------------------------------------------===//
+// EnumerateJoinOrder
+//===--------------------------------------------------------------------===//
+namespace {
+
+/**
+ * Builds the join tree chosen by the enumerator for a set of relations. Every predicate is placed at the lowest join
+ * that covers all of the relations it references.
+ */
+std::unique_ptr<AbstractOptimizerNode> BuildJoinTree(
+    const JoinOrderEnumerator &enumerator, JoinOrderEnumerator::RelationSet set,
+    const std::vector<group_id_t> &relations, const std::vector<AnnotatedExpression> &predicates,
+    const std::vector<JoinOrderEnumerator::RelationSet> &predicate_sets, std::vector<bool> *placed,
+    transaction::TransactionContext *txn) {
+  auto children = enumerator.GetChildren(set);
+  if (children.first == 0) {
+    auto relation = relations[static_cast<size_t>(__builtin_ctzll(set))];
+    return std::make_unique<OperatorNode>(LeafOperator::Make(relation).RegisterWithTxnContext(txn),
+                                          std::vector<std::unique_ptr<AbstractOptimizerNode>>{}, txn);
+  }
+
+  std::vector<std::unique_ptr<AbstractOptimizerNode>> join_children;
+  join_children.emplace_back(
+      BuildJoinTree(enumerator, children.first, relations, predicates, predicate_sets, placed, txn));
+  join_children.emplace_back(
+      BuildJoinTree(enumerator, children.second, relations, predicates, predicate_sets, placed, txn));
+
+  std::vector<AnnotatedExpression> join_predicates;
+  for (size_t i = 0; i < predicates.size(); i++) {
+    if ((*placed)[i] || (predicate_sets[i] & ~set) != 0) continue;
+    (*placed)[i] = true;
+    join_predicates.emplace_back(predicates[i]);
+  }
+  return std::make_unique<OperatorNode>(LogicalInnerJoin::Make(std::move(join_predicates)).RegisterWithTxnContext(txn),
+                                        std::move(join_children), txn);
+}
+
+}  // namespace
+
+void EnumerateJoinOrder::Execute() {
+  OPTIMIZER_LOG_TRACE("EnumerateJoinOrder::Execute() group " + std::to_string(group_id_.UnderlyingValue()));
+  auto &memo = GetMemo();
+  auto *gexpr = memo.GetGroupByID(group_id_)->GetLogicalExpression();
+  if (gexpr->Contents()->GetOpType() != OpType::LOGICALINNERJOIN) {
+    for (const auto child_group_id : gexpr->GetChildGroupIDs()) {
+      PushTask(new EnumerateJoinOrder(child_group_id, context_));
+    }
+    return;
+  }
+
+  std::vector<group_id_t> relations;
+  std::vector<AnnotatedExpression> predicates;
+  std::vector<group_id_t> joins;
+  FlattenJoinRegion(group_id_, &relations, &predicates, &joins);
+
+  // Joins below the relations of this region (e.g., in derived tables) form regions of their own
+  for (const auto relation : relations) {
+    PushTask(new EnumerateJoinOrder(relation, context_));
+  }
+  if (relations.size() < MIN_REORDER_RELATIONS || relations.size() > JoinOrderEnumerator::MAX_RELATIONS) return;
+
+  JoinOrderEnumerator enumerator;
+  std::unordered_map<std::string, JoinOrderEnumerator::RelationSet> alias_relations;
+  std::vector<double> relation_rows;
+  for (const auto relation : relations) {
+    auto *group = memo.GetGroupByID(relation);
+    auto num_rows =
+        group->HasNumRows() ? std::max(static_cast<double>(group->GetNumRows()), 1.0) : DEFAULT_RELATION_ROWS;
+    auto relation_idx = enumerator.AddRelation(num_rows);
+    relation_rows.push_back(num_rows);
+    for (const auto &alias : group->GetTableAliases()) {
+      alias_relations[alias] |= JoinOrderEnumerator::RelationSet{1} << relation_idx;
+    }
+  }
+
+  std::vector<JoinOrderEnumerator::RelationSet> predicate_sets;
+  for (const auto &predicate : predicates) {
+    JoinOrderEnumerator::RelationSet set = 0;
+    for (const auto &alias : predicate.GetTableAliasSet()) {
+      auto it = alias_relations.find(alias);
+      if (it != alias_relations.end()) set |= it->second;
+    }
+    predicate_sets.push_back(set);
+    if (__builtin_popcountll(set) < 2) continue;
+
+    // Same estimate as StatsCalculator: an equi-join matches every tuple of the smaller side at most once
+    double selectivity = 1.0;
+    auto expr = predicate.GetExpr();
+    if (__builtin_popcountll(set) == 2 && expr->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL &&
+        expr->GetChild(0)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
+        expr->GetChild(1)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
+      auto first = static_cast<size_t>(__builtin_ctzll(set));
+      auto second = static_cast<size_t>(63 - __builtin_clzll(set));
+      selectivity = 1.0 / std::max(relation_rows[first], relation_rows[second]);
+    }
+    enumerator.AddPredicate(set, selectivity);
+  }
+  enumerator.Enumerate();
+  OPTIMIZER_LOG_DEBUG("EnumerateJoinOrder::Execute() ordered {0} relations {1}, estimated cost {2}", relations.size(),
+                      enumerator.UsedDynamicProgramming() ? "exhaustively" : "greedily",
+                      enumerator.GetCost(enumerator.GetAllRelations()));
+
+  auto *optimizer_context = context_->GetOptimizerContext();
+  std::vector<bool> placed(predicates.size(), false);
+  auto join_tree = BuildJoinTree(enumerator, enumerator.GetAllRelations(), relations, predicates, predicate_sets,
+                                 &placed, optimizer_context->GetTxn());
+
+  for (const auto join : joins) optimizer_context->MarkJoinOrderFixed(join);
+  GroupExpression *new_gexpr;
+  if (optimizer_context->RecordOptimizerNodeIntoGroup(common::ManagedPointer(join_tree.get()), &new_gexpr,
+                                                      group_id_)) {
+    MarkJoinTree(new_gexpr, relations);
+    PushTask(new DeriveStats(new_gexpr, context_));
+  }
+}
+
+void EnumerateJoinOrder::FlattenJoinRegion(group_id_t group_id, std::vector<group_id_t> *relations,
+                                           std::vector<AnnotatedExpression> *predicates,
+                                           std::vector<group_id_t> *joins) {
+  auto *gexpr = GetMemo().GetGroupByID(group_id)->GetLogicalExpression();
+  if (gexpr->Contents()->GetOpType() != OpType::LOGICALINNERJOIN) {
+    relations->push_back(group_id);
+    return;
+  }
+
+  joins->push_back(group_id);
+  const auto &join_predicates = gexpr->Contents()->GetContentsAs<LogicalInnerJoin>()->GetJoinPredicates();
+  predicates->insert(predicates->end(), join_predicates.begin(), join_predicates.end());
+  for (const auto child_group_id : gexpr->GetChildGroupIDs()) {
+    FlattenJoinRegion(child_group_id, relations, predicates, joins);
+  }
+}
+
+void EnumerateJoinOrder::MarkJoinTree(GroupExpression *gexpr, const std::vector<group_id_t> &relations) {
+  auto *optimizer_context = context_->GetOptimizerContext();
+  optimizer_context->MarkJoinOrderFixed(gexpr->GetGroupID());
+  for (const auto child_group_id : gexpr->GetChildGroupIDs()) {
+    if (std::find(relations.begin(), relations.end(), child_group_id) != relations.end()) continue;
+    MarkJoinTree(GetMemo().GetGroupByID(child_group_id)->GetLogicalExpressions()[0], relations);
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // OptimizeExpressionCostWithEnforcedProperty
 //===--------------------------------------------------------------------===//
@@ -235,6 +400,7 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
     if (cur_total_cost_ > context_->GetCostUpperBound()) return;
 
     // Derive output and input properties
+    std::lock_guard<std::mutex> shared_state_guard(context_->GetOptimizerContext()->GetSharedStateLatch());
     ChildPropertyDeriver prop_deriver;
     output_input_properties_ = prop_deriver.GetProperties(context_->GetOptimizerContext()->GetCatalogAccessor(),
                                                           &context_->GetOptimizerContext()->GetMemo(),
@@ -258,6 +424,7 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
       // Compute the cost of the root operator
       // 1. Collect stats needed and cache them in the group
       // 2. Calculate cost based on children's stats
+      std::lock_guard<std::mutex> shared_state_guard(context_->GetOptimizerContext()->GetSharedStateLatch());
       cur_total_cost_ += context_->GetOptimizerContext()->GetCostModel()->CalculateCost(
           context_->GetOptimizerContext()->GetTxn(), context_->GetOptimizerContext()->GetCatalogAccessor(),
           &context_->GetOptimizerContext()->GetMemo(), group_expr_);
@@ -332,9 +499,12 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
           // Cost the enforced expression
           auto extended_prop_set = output_prop->Copy();
           extended_prop_set->AddProperty(prop->Copy());
-          cur_total_cost_ += context_->GetOptimizerContext()->GetCostModel()->CalculateCost(
-              context_->GetOptimizerContext()->GetTxn(), context_->GetOptimizerContext()->GetCatalogAccessor(),
-              &context_->GetOptimizerContext()->GetMemo(), memo_enforced_expr);
+          {
+            std::lock_guard<std::mutex> shared_state_guard(context_->GetOptimizerContext()->GetSharedStateLatch());
+            cur_total_cost_ += context_->GetOptimizerContext()->GetCostModel()->CalculateCost(
+                context_->GetOptimizerContext()->GetTxn(), context_->GetOptimizerContext()->GetCatalogAccessor(),
+                &context_->GetOptimizerContext()->GetMemo(), memo_enforced_expr);
+          }
 
           // Update hash tables for group and group expression
           memo_enforced_expr->SetLocalHashTable(extended_prop_set, {pre_output_prop_set}, cur_total_cost_);
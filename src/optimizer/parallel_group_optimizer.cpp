@@ -0,0 +1,166 @@
+#include "optimizer/parallel_group_optimizer.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/worker_pool.h"
+#include "loggers/optimizer_logger.h"
+#include "optimizer/optimization_context.h"
+#include "optimizer/optimizer_context.h"
+#include "optimizer/optimizer_task.h"
+#include "optimizer/optimizer_task_pool.h"
+#include "optimizer/property_set.h"
+
+namespace noisepage::optimizer {
+
+size_t ParallelGroupOptimizer::Optimize(group_id_t root_group_id) {
+  start_time_ = std::chrono::steady_clock::now();
+  std::vector<std::vector<group_id_t>> waves;
+  ScheduleBelow(root_group_id, &waves);
+
+  size_t num_groups = 0;
+  for (const auto &wave : waves) {
+    if (timed_out_) {
+      OPTIMIZER_LOG_WARN("ParallelGroupOptimizer::Optimize() timed out after {0} groups", num_groups);
+      break;
+    }
+    RunWave(wave);
+    num_groups += wave.size();
+  }
+  OPTIMIZER_LOG_DEBUG("ParallelGroupOptimizer::Optimize() optimized {0} groups in {1} waves", num_groups,
+                      waves.size());
+  return num_groups;
+}
+
+size_t ParallelGroupOptimizer::ScheduleBelow(group_id_t group_id, std::vector<std::vector<group_id_t>> *waves) const {
+  auto split = ChooseSplit(group_id);
+  if (split.empty()) {
+    // Look through operators with a single input, such as the projections and aggregations above a join
+    const auto &logical_exprs = context_->GetMemo().GetGroupByID(group_id)->GetLogicalExpressions();
+    if (logical_exprs.size() == 1 && logical_exprs[0]->GetChildrenGroupsSize() == 1) {
+      return ScheduleBelow(logical_exprs[0]->GetChildGroupId(0), waves);
+    }
+    return 0;
+  }
+
+  size_t height = 0;
+  for (const auto child_group_id : split) {
+    const auto child_height = ScheduleBelow(child_group_id, waves);
+    if (waves->size() <= child_height) waves->resize(child_height + 1);
+    (*waves)[child_height].push_back(child_group_id);
+    height = std::max(height, child_height + 1);
+  }
+  return height;
+}
+
+std::vector<group_id_t> ParallelGroupOptimizer::ChooseSplit(group_id_t group_id) const {
+  auto &memo = context_->GetMemo();
+  std::vector<group_id_t> best_split;
+  size_t best_largest_child = std::numeric_limits<size_t>::max();
+
+  for (const auto *gexpr : memo.GetGroupByID(group_id)->GetLogicalExpressions()) {
+    const auto &children = gexpr->GetChildGroupIDs();
+    if (children.size() < 2) continue;
+
+    // The children must cover disjoint, non-empty sets of tables and must not share any group
+    bool independent = true;
+    size_t largest_child = 0;
+    std::unordered_set<std::string> seen_aliases;
+    std::unordered_set<group_id_t> seen_groups;
+    for (const auto child_group_id : children) {
+      const auto &aliases = memo.GetGroupByID(child_group_id)->GetTableAliases();
+      std::unordered_set<group_id_t> child_groups;
+      CollectGroups(child_group_id, &child_groups);
+      auto seen_alias = [&](const std::string &alias) { return seen_aliases.count(alias) > 0; };
+      auto seen_group = [&](group_id_t id) { return seen_groups.count(id) > 0; };
+      if (aliases.empty() || std::any_of(aliases.begin(), aliases.end(), seen_alias) ||
+          std::any_of(child_groups.begin(), child_groups.end(), seen_group)) {
+        independent = false;
+        break;
+      }
+      seen_aliases.insert(aliases.begin(), aliases.end());
+      seen_groups.insert(child_groups.begin(), child_groups.end());
+      largest_child = std::max(largest_child, child_groups.size());
+    }
+
+    if (independent && largest_child < best_largest_child) {
+      best_split = children;
+      best_largest_child = largest_child;
+    }
+  }
+  return best_split;
+}
+
+void ParallelGroupOptimizer::CollectGroups(group_id_t group_id, std::unordered_set<group_id_t> *groups) const {
+  if (!groups->insert(group_id).second) return;
+  for (const auto *gexpr : context_->GetMemo().GetGroupByID(group_id)->GetLogicalExpressions()) {
+    for (const auto child_group_id : gexpr->GetChildGroupIDs()) CollectGroups(child_group_id, groups);
+  }
+}
+
+void ParallelGroupOptimizer::RunWave(const std::vector<group_id_t> &wave) {
+  {
+    std::lock_guard<std::mutex> lock(wave_latch_);
+    running_subtrees_ = wave.size();
+  }
+
+  auto run = [this](group_id_t group_id) {
+    try {
+      OptimizeSubtree(group_id);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(wave_latch_);
+      if (error_ == nullptr) error_ = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(wave_latch_);
+    if (--running_subtrees_ == 0) wave_cv_.notify_all();
+  };
+
+  // The calling thread takes the last group of the wave itself instead of idling
+  for (size_t i = 0; i + 1 < wave.size(); i++) {
+    const auto group_id = wave[i];
+    worker_pool_->SubmitTask([run, group_id] { run(group_id); });
+  }
+  run(wave.back());
+
+  std::unique_lock<std::mutex> lock(wave_latch_);
+  wave_cv_.wait(lock, [this] { return running_subtrees_ == 0; });
+  if (error_ != nullptr) std::rethrow_exception(error_);
+}
+
+void ParallelGroupOptimizer::OptimizeSubtree(group_id_t group_id) {
+  OPTIMIZER_LOG_TRACE("ParallelGroupOptimizer::OptimizeSubtree() group " + std::to_string(group_id.UnderlyingValue()));
+  auto optimization_context = new OptimizationContext(context_, new PropertySet());
+  context_->AddOptimizationContext(optimization_context);
+
+  // Tasks push to the task stack of this thread for as long as the subtree is being optimized
+  auto *group = context_->GetMemo().GetGroupByID(group_id);
+  const auto &required_props = optimization_context->GetRequiredProperties();
+  OptimizerTaskStack task_stack;
+  OptimizerContext::SetWorkerTaskPool(&task_stack);
+  try {
+    task_stack.Push(new OptimizeGroup(group, optimization_context));
+    while (!task_stack.Empty()) {
+      // Check to see if we have at least one plan for the subtree, and if we have exceeded our timeout limit. The tasks
+      // left on the stack are dropped, as the serial search does when it times out.
+      const auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::steady_clock::now() - start_time_)
+                                    .count();
+      if (static_cast<uint64_t>(elapsed_time) >= task_execution_timeout_ && group->HasExpressions(required_props)) {
+        timed_out_ = true;
+        break;
+      }
+
+      std::unique_ptr<OptimizerTask> task(task_stack.Pop());
+      task->Execute();
+    }
+  } catch (...) {
+    OptimizerContext::SetWorkerTaskPool(nullptr);
+    throw;
+  }
+  OptimizerContext::SetWorkerTaskPool(nullptr);
+}
+
+}  // namespace noisepage::optimizer
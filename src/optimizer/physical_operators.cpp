@@ -222,19 +222,21 @@ common::hash_t QueryDerivedScan::Hash() const {
 //===--------------------------------------------------------------------===//
 BaseOperatorNodeContents *OrderBy::Copy() const { return new OrderBy(*this); }
 
-Operator OrderBy::Make() {
+Operator OrderBy::Make(size_t num_sort_keys) {
   auto *order_by = new OrderBy();
+  order_by->num_sort_keys_ = num_sort_keys;
   return Operator(common::ManagedPointer<BaseOperatorNodeContents>(order_by));
 }
 
 bool OrderBy::operator==(const BaseOperatorNodeContents &r) {
-  return (r.GetOpType() == OpType::ORDERBY);
-  // Again, there isn't any internal data so I guess we're always equal!
+  if (r.GetOpType() != OpType::ORDERBY) return false;
+  const OrderBy &node = *dynamic_cast<const OrderBy *>(&r);
+  return num_sort_keys_ == node.num_sort_keys_;
 }
 
 common::hash_t OrderBy::Hash() const {
   common::hash_t hash = BaseOperatorNodeContents::Hash();
-  // I guess every OrderBy object hashes to the same thing?
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(num_sort_keys_));
   return hash;
 }
 
@@ -973,9 +975,10 @@ BaseOperatorNodeContents *CreateIndex::Copy() const {
   for (auto &col : schema_->GetColumns()) {
     columns.emplace_back(col);
   }
-  auto schema =
-      std::make_unique<catalog::IndexSchema>(std::move(columns), schema_->Type(), schema_->Unique(), schema_->Primary(),
-                                             schema_->Exclusion(), schema_->Immediate(), schema_->GetIndexOptions());
+  auto predicate = schema_->GetPredicate() != nullptr ? schema_->GetPredicate()->Copy() : nullptr;
+  auto schema = std::make_unique<catalog::IndexSchema>(std::move(columns), schema_->Type(), schema_->Unique(),
+                                                       schema_->Primary(), schema_->Exclusion(), schema_->Immediate(),
+                                                       schema_->GetIndexOptions(), std::move(predicate));
 
   auto op = new CreateIndex();
   op->namespace_oid_ = namespace_oid_;
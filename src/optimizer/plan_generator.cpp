@@ -293,6 +293,9 @@ void PlanGenerator::Visit(const ExternalFileScan *op) {
     case parser::ExternalFileFormat::BINARY: {
       NOISEPAGE_ASSERT(0, "Missing BinaryScanPlanNode");
     }
+    case parser::ExternalFileFormat::TEXT: {
+      NOISEPAGE_ASSERT(0, "Missing TextScanPlanNode");
+    }
   }
 }
 
@@ -904,6 +907,11 @@ void PlanGenerator::Visit(const Update *op) {
       parser::ExpressionUtil::GetTupleValueExprs(
           &cves, common::ManagedPointer(const_cast<parser::AbstractExpression *>(column.StoredExpression().Get())));
     }
+    // Updating a column referenced by a partial index predicate can move the tuple into or out of the index
+    if (index.second.IsPartial()) {
+      parser::ExpressionUtil::GetTupleValueExprs(
+          &cves, common::ManagedPointer(const_cast<parser::AbstractExpression *>(index.second.GetPredicate().Get())));
+    }
   }
 
   std::unordered_set<std::string> update_column_names;
@@ -989,9 +997,10 @@ void PlanGenerator::Visit(const CreateIndex *create_index) {
   for (const auto &col : schema->GetColumns()) {
     cols.emplace_back(col);
   }
-  auto idx_schema =
-      std::make_unique<catalog::IndexSchema>(std::move(cols), schema->Type(), schema->Unique(), schema->Primary(),
-                                             schema->Exclusion(), schema->Immediate(), schema->GetIndexOptions());
+  auto predicate = schema->GetPredicate() != nullptr ? schema->GetPredicate()->Copy() : nullptr;
+  auto idx_schema = std::make_unique<catalog::IndexSchema>(std::move(cols), schema->Type(), schema->Unique(),
+                                                           schema->Primary(), schema->Exclusion(), schema->Immediate(),
+                                                           schema->GetIndexOptions(), std::move(predicate));
   auto out_schema = std::make_unique<planner::OutputSchema>();
 
   output_plan_ = planner::CreateIndexPlanNode::Builder()
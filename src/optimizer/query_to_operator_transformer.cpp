@@ -484,7 +484,8 @@ void QueryToOperatorTransformer::Visit(common::ManagedPointer<parser::CreateStat
       create_expr = std::make_unique<OperatorNode>(
           LogicalCreateIndex::Make(db_oid_, accessor_->GetDefaultNamespace(),
                                    accessor_->GetTableOid(op->GetTableName()), op->GetIndexType(), op->IsUniqueIndex(),
-                                   op->GetIndexName(), std::move(entries), op->MoveIndexOptions())
+                                   op->GetIndexName(), std::move(entries), op->MoveIndexOptions(),
+                                   op->GetIndexPredicate())
               .RegisterWithTxnContext(txn_context),
           std::vector<std::unique_ptr<AbstractOptimizerNode>>{}, txn_context);
       break;
@@ -727,6 +728,8 @@ void QueryToOperatorTransformer::Visit(common::ManagedPointer<parser::CopyStatem
     } else {
       op->GetCopyTable()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
     }
+    // COPY TO STDOUT streams the result of the query to the client like a SELECT, there is no file to export to
+    if (op->IsStdio()) return;
     auto export_op = std::make_unique<OperatorNode>(
         LogicalExportExternalFile::Make(op->GetExternalFileFormat(), op->GetFilePath(), op->GetDelimiter(),
                                         op->GetQuoteChar(), op->GetEscapeChar())
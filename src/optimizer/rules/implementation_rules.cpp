@@ -883,6 +883,7 @@ void LogicalCreateIndexToPhysicalCreateIndex::Transform(
   const auto &tbl_schema = accessor->GetSchema(ci_op->GetTableOid());
 
   std::vector<catalog::IndexSchema::Column> cols;
+  uint32_t num_expr_cols = 0;
   for (auto attr : ci_op->GetIndexAttr()) {
     // Information should already be derived
     auto name = attr->GetExpressionName();
@@ -899,7 +900,9 @@ void LogicalCreateIndexToPhysicalCreateIndex::Transform(
       nullable = col.Nullable();
       if (is_var) varlen_size = col.TypeModifier();
     } else {
-      // TODO(Matt): derive a unique name
+      // Key columns share a namespace in pg_attribute, so expression keys are named like Postgres does: expr, expr1...
+      name = num_expr_cols == 0 ? "expr" : "expr" + std::to_string(num_expr_cols);
+      num_expr_cols++;
       // TODO(wz2): Derive nullability/varlen from non ColumnValue
       nullable = true;
       varlen_size = UINT16_MAX;
@@ -931,7 +934,10 @@ void LogicalCreateIndexToPhysicalCreateIndex::Transform(
                                                        false,  // is_primary
                                                        false,  // is_exclusion
                                                        false,  // is_immediate
-                                                       ci_op->GetIndexOptions());
+                                                       ci_op->GetIndexOptions(),
+                                                       ci_op->GetIndexPredicate() != nullptr
+                                                           ? ci_op->GetIndexPredicate()->Copy()
+                                                           : nullptr);
 
   auto op = std::make_unique<OperatorNode>(
       CreateIndex::Make(ci_op->GetNamespaceOid(), ci_op->GetTableOid(), ci_op->GetIndexName(), std::move(schema))
@@ -0,0 +1,88 @@
+#include "optimizer/statistics/auto_analyzer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/catalog_accessor.h"
+#include "common/future.h"
+#include "loggers/optimizer_logger.h"
+#include "optimizer/cost_model/trivial_cost_model.h"
+#include "storage/sql_table.h"
+#include "task/task.h"
+#include "task/task_manager.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage::optimizer {
+
+namespace {
+
+/** @return the name as a quoted SQL identifier */
+std::string QuoteIdentifier(std::string_view name) {
+  std::string quoted = "\"";
+  for (const auto c : name) {
+    if (c == '"') quoted += '"';
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+}  // namespace
+
+uint32_t AutoAnalyzer::PerformAutoAnalyze() {
+  /** A table that has to be analyzed */
+  struct Candidate {
+    TableStatsKey key_;
+    std::string name_;
+    std::vector<catalog::col_oid_t> col_oids_;
+    uint64_t num_modifications_;
+  };
+  std::vector<Candidate> candidates;
+
+  auto *txn = txn_manager_->BeginTransaction();
+  for (const auto &key : stats_storage_->GetTableStatsKeys()) {
+    auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), key.db_oid_, DISABLED);
+    if (accessor == nullptr) continue;
+    auto table = accessor->GetTable(key.table_oid_);
+    // The table may have been dropped since its statistics were cached
+    if (table == nullptr) continue;
+
+    // The first time a table is seen, its cached statistics are taken to be as fresh as the table itself. Otherwise
+    // the first pass would re-analyze every table that has been loaded since the server started.
+    const auto num_modifications = table->GetNumModifications();
+    const auto analyzed = analyzed_modifications_.emplace(key, num_modifications).first->second;
+    const auto limit = static_cast<double>(threshold_) + scale_factor_ * static_cast<double>(table->GetNumTuple());
+    if (static_cast<double>(num_modifications - analyzed) < limit) continue;
+
+    std::vector<catalog::col_oid_t> col_oids;
+    for (const auto &column : accessor->GetSchema(key.table_oid_).GetColumns()) col_oids.emplace_back(column.Oid());
+    candidates.push_back({key, std::string(accessor->GetTableName(key.table_oid_)), std::move(col_oids),
+                          num_modifications});
+  }
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  uint32_t num_analyzed = 0;
+  for (const auto &candidate : candidates) {
+    common::Future<task::DummyResult> sync;
+    task_manager_->AddTask(std::make_unique<task::TaskDML>(
+        candidate.key_.db_oid_, "ANALYZE " + QuoteIdentifier(candidate.name_) + ";",
+        std::make_unique<optimizer::TrivialCostModel>(), true, nullptr, common::ManagedPointer(&sync)));
+    // The task manager is always shut down after the auto analyzer, so the task is guaranteed to finish
+    auto result = sync.DangerousWait();
+
+    // Advance the baseline even if ANALYZE failed so that a broken table is not retried on every invocation
+    analyzed_modifications_[candidate.key_] = candidate.num_modifications_;
+    if (!result.second) {
+      OPTIMIZER_LOG_DEBUG("Auto analyze of table {} failed: {}", candidate.name_, sync.FailMessage());
+      continue;
+    }
+    stats_storage_->MarkStatsStale(candidate.key_.db_oid_, candidate.key_.table_oid_, candidate.col_oids_);
+    num_analyzed++;
+  }
+  return num_analyzed;
+}
+
+}  // namespace noisepage::optimizer
@@ -0,0 +1,13 @@
+#include "optimizer/statistics/auto_analyzer_thread.h"
+
+namespace noisepage::optimizer {
+
+AutoAnalyzerThread::AutoAnalyzerThread(common::ManagedPointer<AutoAnalyzer> auto_analyzer,
+                                       std::chrono::microseconds auto_analyze_period)
+    : auto_analyzer_(auto_analyzer),
+      run_auto_analyze_(true),
+      auto_analyze_paused_(false),
+      auto_analyze_period_(auto_analyze_period),
+      auto_analyze_thread_(std::thread([this] { AutoAnalyzeThreadLoop(); })) {}
+
+}  // namespace noisepage::optimizer
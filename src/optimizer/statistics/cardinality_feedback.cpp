@@ -0,0 +1,65 @@
+#include "optimizer/statistics/cardinality_feedback.h"
+
+#include <algorithm>
+
+namespace noisepage::optimizer {
+
+std::optional<CardinalityFeedback::Observation> CardinalityFeedback::Record(size_t signature, size_t estimated_rows,
+                                                                            size_t actual_rows) {
+  NOISEPAGE_ASSERT(signature != NO_SIGNATURE, "Cannot record feedback without a signature");
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+
+  auto it = observations_.find(signature);
+  if (it != observations_.end()) {
+    const auto previous = it->second;
+    it->second = {estimated_rows, actual_rows};
+    return previous;
+  }
+
+  while (observations_.size() >= max_entries_) {
+    observations_.erase(insertion_order_.front());
+    insertion_order_.pop_front();
+  }
+  observations_.emplace(signature, Observation{estimated_rows, actual_rows});
+  insertion_order_.push_back(signature);
+  return std::nullopt;
+}
+
+std::optional<size_t> CardinalityFeedback::GetActualRows(size_t signature) {
+  if (signature == NO_SIGNATURE) return std::nullopt;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  auto it = observations_.find(signature);
+  if (it == observations_.end()) return std::nullopt;
+  return it->second.actual_rows_;
+}
+
+size_t CardinalityFeedback::GetNumEntries() {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  return observations_.size();
+}
+
+void CardinalityFeedback::Clear() {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  observations_.clear();
+  insertion_order_.clear();
+}
+
+uint64_t CardinalityFeedback::GetTableVersion(catalog::db_oid_t db_oid, catalog::table_oid_t table_oid) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  auto it = table_versions_.find(TableKey(db_oid, table_oid));
+  return it == table_versions_.end() ? 0 : it->second;
+}
+
+void CardinalityFeedback::InvalidateTable(catalog::db_oid_t db_oid, catalog::table_oid_t table_oid) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  table_versions_[TableKey(db_oid, table_oid)]++;
+}
+
+bool CardinalityFeedback::IsMisestimate(size_t estimated_rows, size_t actual_rows, double factor) {
+  NOISEPAGE_ASSERT(factor >= 1, "A misestimation factor below 1 would flag exact estimates");
+  const auto estimated = static_cast<double>(std::max<size_t>(estimated_rows, 1));
+  const auto actual = static_cast<double>(std::max<size_t>(actual_rows, 1));
+  return std::max(estimated, actual) >= factor * std::min(estimated, actual);
+}
+
+}  // namespace noisepage::optimizer
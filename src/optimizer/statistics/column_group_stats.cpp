@@ -0,0 +1,103 @@
+#include "optimizer/statistics/column_group_stats.h"
+
+#include <algorithm>
+
+#include "parser/expression/constant_value_expression.h"
+
+namespace noisepage::optimizer {
+
+double ColumnGroupStats::GetDependencyDegree(size_t determining_distinct_values) const {
+  if (distinct_values_ == 0) return 0;
+  // Every distinct value of the determining column maps to exactly one combination if the dependency holds perfectly
+  return std::min(1.0, static_cast<double>(determining_distinct_values) / static_cast<double>(distinct_values_));
+}
+
+double ColumnGroupStats::EstimateEqualitySelectivity(std::optional<common::hash_t> value_hash,
+                                                     double first_selectivity, size_t first_distinct_values,
+                                                     double second_selectivity, size_t second_distinct_values) const {
+  // The conjunction never selects more rows than either of its predicates
+  double upper_bound = std::min(first_selectivity, second_selectivity);
+  if (num_rows_ == 0) return first_selectivity * second_selectivity;
+
+  if (value_hash.has_value() && top_k_->GetTotalCount() != 0) {
+    const auto key = static_cast<int64_t>(*value_hash);
+    const auto count = static_cast<double>(top_k_->EstimateItemCount(key));
+    // The top-k list may only summarize a sample of the rows
+    const auto scale = static_cast<double>(non_null_rows_) / static_cast<double>(top_k_->GetTotalCount());
+    const auto frequency = std::min(1.0, count * scale / static_cast<double>(num_rows_));
+    // A most common combination is counted directly
+    if (top_k_->IsTopKey(key)) return frequency;
+    if (top_k_->GetSize() < top_k_->GetK()) {
+      // The list has room for every combination that was seen, so this one appeared in less than one sampled row
+      upper_bound = std::min(upper_bound, (scale - 1) / static_cast<double>(num_rows_));
+    } else if (count > 0) {
+      // Otherwise the sketch still never underestimates the number of times the combination was seen
+      upper_bound = std::min(upper_bound, frequency);
+    }
+  }
+
+  // Combine the per-column selectivities through the stronger of the two dependencies:
+  // sel(a = x AND b = y) = sel(a = x) * (degree(a -> b) + (1 - degree(a -> b)) * sel(b = y))
+  const auto first_degree = GetDependencyDegree(first_distinct_values);
+  const auto second_degree = GetDependencyDegree(second_distinct_values);
+  const auto selectivity = first_degree >= second_degree
+                               ? first_selectivity * (first_degree + (1 - first_degree) * second_selectivity)
+                               : second_selectivity * (second_degree + (1 - second_degree) * first_selectivity);
+  return std::min(selectivity, upper_bound);
+}
+
+bool ColumnGroupStats::IsSupportedType(type::TypeId type) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::REAL:
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+    case type::TypeId::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::optional<common::hash_t> ColumnGroupStats::HashValue(type::TypeId column_type,
+                                                          const parser::ConstantValueExpression &value) {
+  if (value.IsNull()) return std::nullopt;
+
+  const auto value_type = value.GetReturnValueType();
+  const bool is_integral = value_type == type::TypeId::TINYINT || value_type == type::TypeId::SMALLINT ||
+                           value_type == type::TypeId::INTEGER || value_type == type::TypeId::BIGINT;
+  switch (column_type) {
+    case type::TypeId::BOOLEAN:
+      if (value_type == type::TypeId::BOOLEAN) return HashValue(value.Peek<bool>());
+      break;
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      if (is_integral) return HashValue(value.Peek<int64_t>());
+      break;
+    case type::TypeId::REAL:
+      if (value_type == type::TypeId::REAL) return HashValue(value.Peek<double>());
+      if (is_integral) return HashValue(static_cast<double>(value.Peek<int64_t>()));
+      break;
+    case type::TypeId::DATE:
+      if (value_type == type::TypeId::DATE) return HashValue(value.Peek<execution::sql::Date>());
+      break;
+    case type::TypeId::TIMESTAMP:
+      if (value_type == type::TypeId::TIMESTAMP) return HashValue(value.Peek<execution::sql::Timestamp>());
+      break;
+    case type::TypeId::VARCHAR:
+      // Stored strings are hashed through VarlenEntry::StringView()
+      if (value_type == type::TypeId::VARCHAR) return common::HashUtil::Hash(value.Peek<std::string_view>());
+      break;
+    default:
+      break;
+  }
+  return std::nullopt;
+}
+
+}  // namespace noisepage::optimizer
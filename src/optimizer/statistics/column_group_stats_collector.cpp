@@ -0,0 +1,135 @@
+#include "optimizer/statistics/column_group_stats_collector.h"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "catalog/catalog_accessor.h"
+#include "execution/exec/execution_context.h"
+#include "execution/sql/table_vector_iterator.h"
+#include "execution/sql/vector_projection_iterator.h"
+#include "optimizer/statistics/hyperloglog.h"
+
+namespace noisepage::optimizer {
+
+namespace {
+
+/** The running statistics of one pair of columns */
+struct ColumnGroupState {
+  uint32_t first_idx_;
+  uint32_t second_idx_;
+  size_t non_null_rows_{0};
+  std::unique_ptr<HyperLogLog<common::hash_t>> distinct_;
+  std::unique_ptr<TopKElements<int64_t>> top_k_;
+};
+
+/** @return hash of the value of the column at the current position of the iterator, std::nullopt if it is NULL */
+template <typename T>
+std::optional<common::hash_t> HashCurrentValue(const execution::sql::VectorProjectionIterator &vpi, uint32_t col_idx) {
+  bool null = false;
+  const auto *value = vpi.GetValue<T, true>(col_idx, &null);
+  if (null) return std::nullopt;
+  return ColumnGroupStats::HashValue(*value);
+}
+
+std::optional<common::hash_t> HashCurrentValue(const execution::sql::VectorProjectionIterator &vpi, uint32_t col_idx,
+                                               type::TypeId type) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+      return HashCurrentValue<bool>(vpi, col_idx);
+    case type::TypeId::TINYINT:
+      return HashCurrentValue<int8_t>(vpi, col_idx);
+    case type::TypeId::SMALLINT:
+      return HashCurrentValue<int16_t>(vpi, col_idx);
+    case type::TypeId::INTEGER:
+      return HashCurrentValue<int32_t>(vpi, col_idx);
+    case type::TypeId::BIGINT:
+      return HashCurrentValue<int64_t>(vpi, col_idx);
+    case type::TypeId::REAL:
+      return HashCurrentValue<double>(vpi, col_idx);
+    case type::TypeId::DATE:
+      return HashCurrentValue<execution::sql::Date>(vpi, col_idx);
+    case type::TypeId::TIMESTAMP:
+      return HashCurrentValue<execution::sql::Timestamp>(vpi, col_idx);
+    case type::TypeId::VARCHAR:
+      return HashCurrentValue<storage::VarlenEntry>(vpi, col_idx);
+    default:
+      UNREACHABLE("Column groups are only collected for supported types");
+  }
+}
+
+}  // namespace
+
+std::vector<ColumnGroupStats> ColumnGroupStatsCollector::Collect(
+    common::ManagedPointer<execution::exec::ExecutionContext> exec_ctx, catalog::table_oid_t table_oid,
+    const std::vector<catalog::col_oid_t> &col_oids) {
+  // Pick the columns in oid order, so that every pair is already ordered the way ColumnGroupStats expects
+  const auto &schema = exec_ctx->GetAccessor()->GetSchema(table_oid);
+  std::vector<catalog::col_oid_t> group_col_oids;
+  for (const auto &column : schema.GetColumns()) {
+    if (std::find(col_oids.begin(), col_oids.end(), column.Oid()) == col_oids.end()) continue;
+    if (!ColumnGroupStats::IsSupportedType(column.Type())) continue;
+    if (column.Oid().UnderlyingValue() >= (1U << ColumnGroupStats::GROUP_OID_BITS)) continue;
+    group_col_oids.emplace_back(column.Oid());
+  }
+  std::sort(group_col_oids.begin(), group_col_oids.end());
+  if (group_col_oids.size() > ColumnGroupStats::MAX_GROUP_COLUMNS) {
+    group_col_oids.resize(ColumnGroupStats::MAX_GROUP_COLUMNS);
+  }
+  if (group_col_oids.size() < 2) return {};
+
+  std::vector<type::TypeId> types;
+  std::vector<uint32_t> scan_col_oids;
+  for (const auto &col_oid : group_col_oids) {
+    types.emplace_back(schema.GetColumn(col_oid).Type());
+    scan_col_oids.emplace_back(col_oid.UnderlyingValue());
+  }
+
+  std::vector<ColumnGroupState> groups;
+  for (uint32_t first = 0; first < group_col_oids.size(); first++) {
+    for (uint32_t second = first + 1; second < group_col_oids.size(); second++) {
+      groups.push_back({first, second, 0, std::make_unique<HyperLogLog<common::hash_t>>(HLL_PRECISION),
+                        std::make_unique<TopKElements<int64_t>>()});
+    }
+  }
+
+  // The scan goes through the same sample of blocks as the rest of ANALYZE
+  size_t num_rows = 0;
+  std::vector<std::optional<common::hash_t>> hashes(group_col_oids.size());
+  execution::sql::TableVectorIterator iter(exec_ctx.Get(), table_oid.UnderlyingValue(), scan_col_oids.data(),
+                                           static_cast<uint32_t>(scan_col_oids.size()));
+  iter.Init();
+  while (iter.Advance()) {
+    auto *vpi = iter.GetVectorProjectionIterator();
+    for (; vpi->HasNext(); vpi->Advance()) {
+      num_rows++;
+      for (uint32_t i = 0; i < hashes.size(); i++) hashes[i] = HashCurrentValue(*vpi, i, types[i]);
+      for (auto &group : groups) {
+        const auto &first_hash = hashes[group.first_idx_];
+        const auto &second_hash = hashes[group.second_idx_];
+        if (!first_hash.has_value() || !second_hash.has_value()) continue;
+        const auto hash = ColumnGroupStats::CombineValueHashes(*first_hash, *second_hash);
+        group.non_null_rows_++;
+        group.distinct_->Update(hash);
+        group.top_k_->Increment(static_cast<int64_t>(hash), 1);
+      }
+    }
+  }
+
+  // Scale the counts of a sample back up, like ANALYZE does for the single column statistics
+  const auto stride = exec_ctx->GetTableSampleStride(table_oid);
+  std::vector<ColumnGroupStats> group_stats;
+  for (auto &group : groups) {
+    auto distinct_values = std::min<size_t>(group.distinct_->EstimateCardinality(), group.non_null_rows_);
+    // A column group without duplicates in the sample is assumed to be unique
+    const auto unique_threshold =
+        static_cast<double>(group.non_null_rows_) * (1 - group.distinct_->RelativeError());
+    if (static_cast<double>(distinct_values) >= unique_threshold) distinct_values *= stride;
+    group_stats.emplace_back(group_col_oids[group.first_idx_], group_col_oids[group.second_idx_], num_rows * stride,
+                             group.non_null_rows_ * stride, distinct_values, std::move(group.top_k_));
+  }
+  return group_stats;
+}
+
+}  // namespace noisepage::optimizer
@@ -58,6 +58,34 @@ double SelectivityUtil::ComputeSelectivity(const TableStats &table_stats, const
   }
 }
 
+double SelectivityUtil::ComputeGenericSelectivity(const TableStats &table_stats, catalog::col_oid_t col_oid,
+                                                  parser::ExpressionType type) {
+  if (table_stats.GetNumRows() == 0) {
+    return 0.0;
+  }
+  if (!table_stats.HasColumnStats(col_oid)) {
+    return DEFAULT_SELECTIVITY_VALUE;
+  }
+
+  auto column_stats = table_stats.GetColumnStats(col_oid);
+  const double non_null = 1.0 - column_stats->GetFracNull();
+  const auto distinct_values = column_stats->GetDistinctValues();
+  const double equal = distinct_values == 0 ? 0.0 : non_null / static_cast<double>(distinct_values);
+  switch (type) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      return equal;
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+      return std::max(non_null - equal, 0.0);
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      return non_null * DEFAULT_INEQUALITY_SELECTIVITY;
+    default:
+      return DEFAULT_SELECTIVITY_VALUE;
+  }
+}
+
 template <typename T>
 double SelectivityUtil::ComputeSelectivity(common::ManagedPointer<ColumnStats<T>> column_stats,
                                            const ValueCondition &condition) {
@@ -108,8 +136,9 @@ double SelectivityUtil::LessThanOrEqualTo(common::ManagedPointer<ColumnStats<T>>
 
   if (histogram->IsLessThanMinValue(value)) return 0;
   if (histogram->IsGreaterThanOrEqualToMaxValue(value)) return 1.0 - column_stats->GetFracNull();
-  double res =
-      static_cast<double>(histogram->EstimateItemCount(value)) / static_cast<double>(column_stats->GetNumRows());
+  double res = static_cast<double>(histogram->EstimateItemCount(value)) *
+               SampleScaleFactor(column_stats, histogram->GetTotalValueCount()) /
+               static_cast<double>(column_stats->GetNumRows());
   // There is a possibility that histogram's <= estimate is lesser than it is supposed to be.
   // In the case where the estimate is smaller than estimate for equal, we adjust the selectivity to
   // that of the Equal operator.
@@ -135,16 +164,29 @@ double SelectivityUtil::Equal(common::ManagedPointer<ColumnStats<T>> column_stat
   // Find frequency of the value if present in the top K elements.
   auto value_frequency_estimate = top_k->EstimateItemCount(value);
 
-  // If all values are distinct, then there can be at most one value equal to the specified value
-  if (column_stats->GetDistinctValues() == numrows)
-    value_frequency_estimate = std::min<uint64_t>(value_frequency_estimate, 1lu);
-
-  double res = value_frequency_estimate / static_cast<double>(numrows);
+  double res;
+  if (column_stats->GetDistinctValues() == numrows) {
+    // If all values are distinct, then there can be at most one value equal to the specified value
+    res = static_cast<double>(std::min<uint64_t>(value_frequency_estimate, 1lu)) / static_cast<double>(numrows);
+  } else {
+    res = std::min(static_cast<double>(value_frequency_estimate) *
+                       SampleScaleFactor(column_stats, static_cast<double>(top_k->GetTotalCount())) /
+                       static_cast<double>(numrows),
+                   1.0);
+  }
 
   NOISEPAGE_ASSERT(res >= 0 && res <= 1, "Selectivity of operator must be within valid range");
   return res;
 }
 
+template <typename T>
+double SelectivityUtil::SampleScaleFactor(common::ManagedPointer<ColumnStats<T>> column_stats, double num_summarized) {
+  // ANALYZE builds the top-k list and the histogram from a sample of the table on large tables, while the row counts
+  // are extrapolated to the whole table. Scale the counts of the summaries up to the number of non-null rows.
+  if (num_summarized <= 0) return 1.0;
+  return static_cast<double>(column_stats->GetNonNullRows()) / num_summarized;
+}
+
 // Explicit instantitation of template functions.
 template double SelectivityUtil::Equal<execution::sql::Real>(
     common::ManagedPointer<ColumnStats<execution::sql::Real>> column_stats, const ValueCondition &condition);
@@ -1,22 +1,39 @@
 #include "optimizer/statistics/stats_calculator.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
+#include "loggers/optimizer_logger.h"
 #include "optimizer/logical_operators.h"
 #include "optimizer/memo.h"
 #include "optimizer/optimizer_context.h"
 #include "optimizer/physical_operators.h"
+#include "optimizer/statistics/cardinality_feedback.h"
+#include "optimizer/statistics/column_group_stats.h"
 #include "optimizer/statistics/selectivity_util.h"
+#include "optimizer/statistics/stats_storage.h"
 #include "optimizer/statistics/table_stats.h"
 #include "optimizer/statistics/value_condition.h"
 #include "parser/expression/column_value_expression.h"
 #include "parser/expression/constant_value_expression.h"
+#include "parser/expression/parameter_value_expression.h"
 #include "parser/expression_util.h"
 
 namespace noisepage::optimizer {
 
+namespace {
+
+bool HasParameter(common::ManagedPointer<parser::AbstractExpression> expr) {
+  if (expr->GetExpressionType() == parser::ExpressionType::VALUE_PARAMETER) return true;
+  const auto &children = expr->GetChildren();
+  return std::any_of(children.begin(), children.end(), [](const auto &child) { return HasParameter(child); });
+}
+
+}  // namespace
+
 void StatsCalculator::CalculateStats(GroupExpression *gexpr, OptimizerContext *context) {
   gexpr_ = gexpr;
   context_ = context;
@@ -33,17 +50,32 @@ void StatsCalculator::Visit(const LogicalGet *op) {
 
   // Compute selectivity at the first time
   if (root_group->GetNumRows() == Group::UNINITIALIZED_NUM_ROWS) {
-    const auto latched_table_stats_reference = context_->GetStatsStorage()->GetTableStats(
+    const auto table_stats_snapshot = context_->GetStatsStorage()->GetTableStats(
         op->GetDatabaseOid(), op->GetTableOid(), context_->GetCatalogAccessor());
 
-    NOISEPAGE_ASSERT(latched_table_stats_reference.table_stats_.GetColumnCount() != 0,
-                     "Should have table stats for all tables");
+    NOISEPAGE_ASSERT(table_stats_snapshot.table_stats_.GetColumnCount() != 0, "Should have table stats for all tables");
     // Use predicates to estimate cardinality.
-    size_t table_num_rows = latched_table_stats_reference.table_stats_.GetNumRows();
+    size_t table_num_rows = table_stats_snapshot.table_stats_.GetNumRows();
     root_group->SetTableNumRows(table_num_rows);
-    auto est = EstimateCardinalityForFilter(root_group, table_num_rows, latched_table_stats_reference.table_stats_,
+    filtered_db_oid_ = op->GetDatabaseOid();
+    filtered_table_oid_ = op->GetTableOid();
+    auto est = EstimateCardinalityForFilter(root_group, table_num_rows, table_stats_snapshot.table_stats_,
                                             op->GetPredicates());
-    root_group->SetNumRows(static_cast<size_t>(est));
+
+    // The signature covers the table, the version of its feedback and its predicates, independent of the order of the
+    // predicates
+    const auto feedback = context_->GetStatsStorage()->GetCardinalityFeedback();
+    auto signature = common::HashUtil::CombineHashes(common::HashUtil::Hash(op->GetDatabaseOid()),
+                                                     common::HashUtil::Hash(op->GetTableOid()));
+    signature = common::HashUtil::CombineHashes(
+        signature, common::HashUtil::Hash(feedback->GetTableVersion(op->GetDatabaseOid(), op->GetTableOid())));
+    bool has_parameter = false;
+    for (const auto &annotated_expr : op->GetPredicates()) {
+      signature = common::HashUtil::SumHashes(signature, annotated_expr.GetExpr()->Hash());
+      has_parameter = has_parameter || HasParameter(annotated_expr.GetExpr());
+    }
+    // The signature of a parameter does not cover its value, which the rows produced depend on
+    SetNumRowsWithFeedback(root_group, has_parameter ? CardinalityFeedback::NO_SIGNATURE : signature, est);
   }
 }
 
@@ -106,7 +138,8 @@ void StatsCalculator::Visit(const LogicalInnerJoin *op) {
         curr_rows /= std::max(std::max(left_child_group->GetNumRows(), right_child_group->GetNumRows()), 1UL);
       }
     }
-    root_group->SetNumRows(static_cast<size_t>(curr_rows));
+    auto signature = ComputeJoinSignature(left_child_group, right_child_group, op->GetJoinPredicates(), false);
+    SetNumRowsWithFeedback(root_group, signature, curr_rows);
   }
 
   // TODO(boweic): calculate stats based on predicates other than join conditions
@@ -137,7 +170,8 @@ void StatsCalculator::Visit(const LogicalSemiJoin *op) {
         curr_rows /= std::max(std::max(left_child_group->GetNumRows(), right_child_group->GetNumRows()), 1UL);
       }
     }
-    root_group->SetNumRows(static_cast<size_t>(curr_rows));
+    auto signature = ComputeJoinSignature(left_child_group, right_child_group, op->GetJoinPredicates(), true);
+    SetNumRowsWithFeedback(root_group, signature, curr_rows);
   }
 }
 
@@ -195,21 +229,57 @@ void StatsCalculator::Visit(const LogicalCreateIndex *op) {
 
   // Compute selectivity at the first time
   if (root_group->GetNumRows() == Group::UNINITIALIZED_NUM_ROWS) {
-    const auto latched_table_stats_reference = context_->GetStatsStorage()->GetTableStats(
+    const auto table_stats_snapshot = context_->GetStatsStorage()->GetTableStats(
         op->GetDatabaseOid(), op->GetTableOid(), context_->GetCatalogAccessor());
 
-    size_t table_num_rows = latched_table_stats_reference.table_stats_.GetNumRows();
+    size_t table_num_rows = table_stats_snapshot.table_stats_.GetNumRows();
     root_group->SetTableNumRows(table_num_rows);
     root_group->SetNumRows(table_num_rows);
   }
 }
 
+size_t StatsCalculator::ComputeJoinSignature(Group *left_group, Group *right_group,
+                                             const std::vector<AnnotatedExpression> &predicates,
+                                             bool is_semi_join) const {
+  const auto left_signature = left_group->GetCardinalitySignature();
+  const auto right_signature = right_group->GetCardinalitySignature();
+  if (left_signature == CardinalityFeedback::NO_SIGNATURE || right_signature == CardinalityFeedback::NO_SIGNATURE) {
+    return CardinalityFeedback::NO_SIGNATURE;
+  }
+
+  common::hash_t signature;
+  if (is_semi_join) {
+    // A semi join is not commutative, and must not flatten into the inner joins around it
+    signature = common::HashUtil::CombineHashes(common::HashUtil::Hash("semi_join"),
+                                                common::HashUtil::CombineHashes(left_signature, right_signature));
+  } else {
+    signature = common::HashUtil::SumHashes(left_signature, right_signature);
+  }
+  for (const auto &annotated_expr : predicates) {
+    signature = common::HashUtil::SumHashes(signature, annotated_expr.GetExpr()->Hash());
+  }
+  return signature;
+}
+
+void StatsCalculator::SetNumRowsWithFeedback(Group *group, size_t signature, size_t estimated_rows) {
+  group->SetCardinalitySignature(signature);
+  auto actual_rows = context_->GetStatsStorage()->GetCardinalityFeedback()->GetActualRows(signature);
+  group->SetCardinalityFromFeedback(actual_rows.has_value());
+  if (actual_rows.has_value()) {
+    OPTIMIZER_LOG_TRACE("Cardinality feedback replaces an estimate of {0} rows with {1} rows", estimated_rows,
+                        *actual_rows);
+  }
+  group->SetNumRows(actual_rows.value_or(estimated_rows));
+}
+
 size_t StatsCalculator::EstimateCardinalityForFilter(Group *group, size_t num_rows, const TableStats &predicate_stats,
                                                      const std::vector<AnnotatedExpression> &predicates) {
-  double selectivity = 1.F;
-  for (const auto &annotated_expr : predicates) {
-    // Loop over conjunction exprs
-    selectivity *= CalculateSelectivityForPredicate(group, predicate_stats, annotated_expr.GetExpr());
+  std::vector<bool> estimated(predicates.size(), false);
+  double selectivity = CalculateSelectivityForColumnGroups(group, predicate_stats, predicates, &estimated);
+  for (size_t i = 0; i < predicates.size(); i++) {
+    // Loop over the conjunction exprs that are not covered by column group statistics
+    if (estimated[i]) continue;
+    selectivity *= CalculateSelectivityForPredicate(group, predicate_stats, predicates[i].GetExpr());
   }
 
   // Update selectivity
@@ -271,21 +341,23 @@ double StatsCalculator::CalculateSelectivityForPredicate(Group *group, const Tab
       expr_type = parser::ExpressionUtil::ReverseComparisonExpressionType(expr_type);
     }
 
-    std::unique_ptr<parser::ConstantValueExpression> value;
-    if (expr->GetChild(right_index)->GetExpressionType() == parser::ExpressionType::VALUE_CONSTANT) {
-      auto cve = expr->GetChild(right_index).CastManagedPointerTo<parser::ConstantValueExpression>();
-      value = std::unique_ptr<parser::ConstantValueExpression>{
-          reinterpret_cast<parser::ConstantValueExpression *>(cve->Copy().release())};
+    auto value = GetComparedValue(expr->GetChild(right_index));
+    if (value == nullptr) {
+      // Optimizing a generic plan, so the plan has to work for whatever value the parameter is bound to later
+      selectivity = SelectivityUtil::ComputeGenericSelectivity(predicate_table_stats, col_oid, expr_type);
+      const auto pve = expr->GetChild(right_index).CastManagedPointerTo<parser::ParameterValueExpression>();
+      context_->AddParameterSelectivity(
+          {pve->GetValueIdx(), filtered_db_oid_, filtered_table_oid_, col_oid, expr_type, selectivity});
     } else {
-      auto pve = expr->GetChild(right_index).CastManagedPointerTo<parser::ParameterValueExpression>();
-      NOISEPAGE_ASSERT(context_->GetParams() != nullptr, "Query expected to have parameters");
-      NOISEPAGE_ASSERT(context_->GetParams()->size() > pve->GetValueIdx(), "Query expected to have enough parameters");
-      value = std::unique_ptr<parser::ConstantValueExpression>{reinterpret_cast<parser::ConstantValueExpression *>(
-          context_->GetParams()->at(pve->GetValueIdx()).Copy().release())};
+      ValueCondition condition(col_oid, col_name, expr_type, std::move(value));
+      selectivity = SelectivityUtil::ComputeSelectivity(predicate_table_stats, condition);
+      // A custom plan is only reused for later parameter values that are about as selective as this one
+      if (expr->GetChild(right_index)->GetExpressionType() == parser::ExpressionType::VALUE_PARAMETER) {
+        const auto pve = expr->GetChild(right_index).CastManagedPointerTo<parser::ParameterValueExpression>();
+        context_->AddParameterSelectivity(
+            {pve->GetValueIdx(), filtered_db_oid_, filtered_table_oid_, col_oid, expr_type, selectivity});
+      }
     }
-
-    ValueCondition condition(col_oid, col_name, expr_type, std::move(value));
-    selectivity = SelectivityUtil::ComputeSelectivity(predicate_table_stats, condition);
     group->AddFilterColumnSelectivity(col_oid, selectivity);
   } else if (expr->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND ||
              expr->GetExpressionType() == parser::ExpressionType::CONJUNCTION_OR) {
@@ -301,4 +373,105 @@ double StatsCalculator::CalculateSelectivityForPredicate(Group *group, const Tab
   return selectivity;
 }
 
+double StatsCalculator::CalculateSelectivityForColumnGroups(Group *group, const TableStats &predicate_table_stats,
+                                                            const std::vector<AnnotatedExpression> &predicates,
+                                                            std::vector<bool> *estimated) {
+  double selectivity = 1.F;
+  if (predicate_table_stats.GetColumnGroupCount() == 0) {
+    return selectivity;
+  }
+
+  /** A [column = value] conjunct */
+  struct ColumnEquality {
+    size_t predicate_idx_;
+    catalog::col_oid_t col_oid_;
+    std::unique_ptr<parser::ConstantValueExpression> value_;
+  };
+  std::vector<ColumnEquality> equalities;
+  for (size_t i = 0; i < predicates.size(); i++) {
+    auto expr = predicates[i].GetExpr();
+    if (expr->GetExpressionType() != parser::ExpressionType::COMPARE_EQUAL || expr->GetChildrenSize() != 2) continue;
+
+    const auto is_value = [](common::ManagedPointer<parser::AbstractExpression> child) {
+      return child->GetExpressionType() == parser::ExpressionType::VALUE_CONSTANT ||
+             child->GetExpressionType() == parser::ExpressionType::VALUE_PARAMETER;
+    };
+    int right_index;
+    if (expr->GetChild(0)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE && is_value(expr->GetChild(1))) {
+      right_index = 1;
+    } else if (expr->GetChild(1)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
+               is_value(expr->GetChild(0))) {
+      right_index = 0;
+    } else {
+      continue;
+    }
+
+    auto col_expr = expr->GetChild(1 - right_index).CastManagedPointerTo<parser::ColumnValueExpression>();
+    auto col_oid = col_expr->GetColumnOid();
+    if (!predicate_table_stats.HasColumnStats(col_oid)) continue;
+    // A column that is compared against several values is left to the per-column estimates
+    if (std::any_of(equalities.begin(), equalities.end(),
+                    [col_oid](const ColumnEquality &equality) { return equality.col_oid_ == col_oid; })) {
+      continue;
+    }
+    equalities.push_back({i, col_oid, GetComparedValue(expr->GetChild(right_index))});
+  }
+
+  // Pair up the equalities greedily, in the order of the predicates
+  std::vector<bool> paired(equalities.size(), false);
+  for (size_t i = 0; i < equalities.size(); i++) {
+    for (size_t j = i + 1; j < equalities.size() && !paired[i]; j++) {
+      if (paired[j]) continue;
+      auto group_stats = predicate_table_stats.GetColumnGroupStats(equalities[i].col_oid_, equalities[j].col_oid_);
+      if (group_stats == nullptr) continue;
+
+      const bool in_order = equalities[i].col_oid_ == group_stats->GetFirstColumnID();
+      const auto &first = in_order ? equalities[i] : equalities[j];
+      const auto &second = in_order ? equalities[j] : equalities[i];
+      auto first_stats = predicate_table_stats.GetColumnStats(first.col_oid_);
+      auto second_stats = predicate_table_stats.GetColumnStats(second.col_oid_);
+
+      // The per-column estimates are still recorded for the columns of the group
+      const auto first_selectivity =
+          CalculateSelectivityForPredicate(group, predicate_table_stats, predicates[first.predicate_idx_].GetExpr());
+      const auto second_selectivity =
+          CalculateSelectivityForPredicate(group, predicate_table_stats, predicates[second.predicate_idx_].GetExpr());
+
+      // Without parameter values, the most common value pairs cannot be looked up
+      std::optional<common::hash_t> first_hash;
+      std::optional<common::hash_t> second_hash;
+      if (first.value_ != nullptr && second.value_ != nullptr) {
+        first_hash = ColumnGroupStats::HashValue(first_stats->GetTypeId(), *first.value_);
+        second_hash = ColumnGroupStats::HashValue(second_stats->GetTypeId(), *second.value_);
+      }
+      std::optional<common::hash_t> value_hash;
+      if (first_hash.has_value() && second_hash.has_value()) {
+        value_hash = ColumnGroupStats::CombineValueHashes(*first_hash, *second_hash);
+      }
+
+      selectivity *= group_stats->EstimateEqualitySelectivity(value_hash, first_selectivity,
+                                                              first_stats->GetDistinctValues(), second_selectivity,
+                                                              second_stats->GetDistinctValues());
+      paired[i] = paired[j] = true;
+      (*estimated)[first.predicate_idx_] = (*estimated)[second.predicate_idx_] = true;
+    }
+  }
+
+  return selectivity;
+}
+
+std::unique_ptr<parser::ConstantValueExpression> StatsCalculator::GetComparedValue(
+    common::ManagedPointer<parser::AbstractExpression> expr) const {
+  if (expr->GetExpressionType() == parser::ExpressionType::VALUE_CONSTANT) {
+    auto cve = expr.CastManagedPointerTo<parser::ConstantValueExpression>();
+    return std::unique_ptr<parser::ConstantValueExpression>{
+        reinterpret_cast<parser::ConstantValueExpression *>(cve->Copy().release())};
+  }
+  auto pve = expr.CastManagedPointerTo<parser::ParameterValueExpression>();
+  if (context_->GetParams() == nullptr) return nullptr;
+  NOISEPAGE_ASSERT(context_->GetParams()->size() > pve->GetValueIdx(), "Query expected to have enough parameters");
+  return std::unique_ptr<parser::ConstantValueExpression>{reinterpret_cast<parser::ConstantValueExpression *>(
+      context_->GetParams()->at(pve->GetValueIdx()).Copy().release())};
+}
+
 }  // namespace noisepage::optimizer
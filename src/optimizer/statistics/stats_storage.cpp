@@ -1,7 +1,10 @@
 #include "optimizer/statistics/stats_storage.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "loggers/optimizer_logger.h"
 
@@ -12,83 +15,105 @@ namespace noisepage::optimizer {
  * large tables are filling up the cache when we only need some of the columns, we may want to revisit this so we only
  * cache the columns we use.
  */
-LatchedTableStatsReference StatsStorage::GetTableStats(const catalog::db_oid_t database_id,
-                                                       const catalog::table_oid_t table_id,
-                                                       catalog::CatalogAccessor *accessor) {
-  if (!ContainsTableStats(database_id, table_id)) {
-    InsertTableStats(database_id, table_id, accessor);
-  }
-
-  common::SharedLatchGuard shared_stats_storage_latch{&stats_storage_latch_};
-
+TableStatsSnapshot StatsStorage::GetTableStats(const catalog::db_oid_t database_id, const catalog::table_oid_t table_id,
+                                               catalog::CatalogAccessor *accessor) {
   TableStatsKey table_stats_key{database_id, table_id};
-  auto table_it = table_stats_storage_.find(table_stats_key);
-
-  auto &table_stats_value = table_it->second;
-
-  UpdateStaleColumns(table_id, &table_stats_value, accessor);
+  // Read before the catalog is, so that an invalidation of the table while it is loaded is noticed at install time
+  const uint64_t epoch = invalidation_epoch_.load(std::memory_order_acquire);
+  uint64_t generation = 0;
+  {
+    common::SharedLatch::ScopedSharedLatch shared_stats_storage_latch{&stats_storage_latch_};
+    auto table_it = table_stats_storage_.find(table_stats_key);
+    if (table_it != table_stats_storage_.end()) {
+      auto &entry = table_it->second;
+      entry.last_access_.store(access_clock_.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      generation = entry.generation_.load(std::memory_order_acquire);
+      if (generation == entry.snapshot_generation_) return TableStatsSnapshot(entry.snapshot_);
+    }
+  }
 
-  common::SharedLatchGuard shared_table_stats_latch{&table_stats_value.shared_latch_};
-  return LatchedTableStatsReference(table_stats_value.table_stats_, std::move(shared_stats_storage_latch),
-                                    std::move(shared_table_stats_latch));
+  return TableStatsSnapshot(LoadTableStats(database_id, table_id, generation, epoch, accessor));
 }
 
 void StatsStorage::MarkStatsStale(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
-                                  const std::vector<catalog::col_oid_t> &col_ids) {
+                                  UNUSED_ATTRIBUTE const std::vector<catalog::col_oid_t> &col_ids) {
+  // Rows observed before the statistics changed must not override the estimates derived from the new statistics
+  feedback_.InvalidateTable(database_id, table_id);
+
+  // Bumped before the entry is looked up: a concurrent load either finds the entry bumped below or sees the new epoch
+  invalidation_epoch_.fetch_add(1, std::memory_order_acq_rel);
+
   TableStatsKey table_stats_key{database_id, table_id};
   common::SharedLatch::ScopedSharedLatch shared_stats_storage_latch{&stats_storage_latch_};
   auto table_stats_value_it = table_stats_storage_.find(table_stats_key);
   if (table_stats_value_it != table_stats_storage_.end()) {
-    auto &stats_storage_value = table_stats_storage_.at(table_stats_key);
     /*
-     * We don't need an exclusive latch because it's ok to mark something stale while someone is reading it. The worst
-     * that happens is they end up using slightly stale statistics without realizing it.
+     * Snapshots are immutable, so the whole table is reloaded on the next lookup. Consumers that already hold the
+     * current snapshot keep using slightly stale statistics without realizing it, which is fine.
      */
-    common::SharedLatch::ScopedSharedLatch shared_table_stats_latch{&stats_storage_value.shared_latch_};
-    for (const auto &col_id : col_ids) {
-      stats_storage_value.table_stats_.GetColumnStats(col_id)->MarkStale();
-    }
+    table_stats_value_it->second.generation_.fetch_add(1, std::memory_order_release);
   }
 }
 
-bool StatsStorage::ContainsTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id) {
+std::vector<TableStatsKey> StatsStorage::GetTableStatsKeys() {
   common::SharedLatch::ScopedSharedLatch shared_stats_storage_latch{&stats_storage_latch_};
-  TableStatsKey table_stats_key{database_id, table_id};
-  return table_stats_storage_.count(table_stats_key) > 0;
+  std::vector<TableStatsKey> keys;
+  keys.reserve(table_stats_storage_.size());
+  for (const auto &entry : table_stats_storage_) keys.emplace_back(entry.first);
+  return keys;
 }
 
-void StatsStorage::InsertTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
-                                    catalog::CatalogAccessor *accessor) {
-  common::SharedLatch::ScopedExclusiveLatch exclusive_stats_storage_latch{&stats_storage_latch_};
+std::shared_ptr<const TableStats> StatsStorage::LoadTableStats(catalog::db_oid_t database_id,
+                                                               catalog::table_oid_t table_id, uint64_t generation,
+                                                               uint64_t epoch, catalog::CatalogAccessor *accessor) {
+  // Read the catalog without holding the latch, concurrent lookups of other tables are not blocked by it
+  auto snapshot = std::make_shared<const TableStats>(accessor->GetTableStatistics(table_id));
+  const uint64_t memory_usage = snapshot->EstimateHeapUsage();
 
   TableStatsKey table_stats_key{database_id, table_id};
-  if (table_stats_storage_.count(table_stats_key) == 0) {
-    table_stats_storage_.emplace(table_stats_key, accessor->GetTableStatistics(table_id));
+  common::SharedLatch::ScopedExclusiveLatch exclusive_stats_storage_latch{&stats_storage_latch_};
+  // Some table was marked stale while this snapshot was loaded. The entry of this table may have been evicted at the
+  // time, so conservatively treat the snapshot as possibly predating the invalidation.
+  const bool invalidated = invalidation_epoch_.load(std::memory_order_acquire) != epoch;
+  auto [table_it, inserted] = table_stats_storage_.try_emplace(table_stats_key);
+  auto &entry = table_it->second;
+  if (inserted) entry.generation_.store(invalidated ? generation + 1 : generation, std::memory_order_relaxed);
+
+  // Another thread may have installed a snapshot that was loaded after a later invalidation, never go back in time.
+  // A snapshot that may predate an invalidation only fills an empty entry, where it is installed but stays stale.
+  if (entry.snapshot_ == nullptr || (!invalidated && generation >= entry.snapshot_generation_)) {
+    memory_usage_.store(memory_usage_.load(std::memory_order_relaxed) - entry.memory_usage_ + memory_usage,
+                        std::memory_order_relaxed);
+    entry.snapshot_ = snapshot;
+    entry.memory_usage_ = memory_usage;
+    entry.snapshot_generation_ = generation;
   }
+  entry.last_access_.store(access_clock_.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+  EvictIfNeeded(table_stats_key);
+  return snapshot;
 }
 
-void StatsStorage::UpdateStaleColumns(catalog::table_oid_t table_id, TableStatsValue *table_stats_value,
-                                      catalog::CatalogAccessor *accessor) {
-  {
-    common::SharedLatch::ScopedSharedLatch shared_table_latch{&table_stats_value->shared_latch_};
-    if (!table_stats_value->table_stats_.HasStaleValues()) {
-      return;
-    }
-  }
+void StatsStorage::EvictIfNeeded(const TableStatsKey &keep) {
+  if (memory_usage_.load(std::memory_order_relaxed) <= memory_limit_) return;
 
-  common::SharedLatch::ScopedExclusiveLatch exclusive_table_latch{&table_stats_value->shared_latch_};
-
-  auto &table_stats = table_stats_value->table_stats_;
-  for (auto column_stat : table_stats.GetColumnStats()) {
-    if (column_stat->IsStale()) {
-      auto col_oid = column_stat->GetColumnID();
-      table_stats.RemoveColumnStats(col_oid);
-      auto new_column_stat = accessor->GetColumnStatistics(table_id, col_oid);
-      if (new_column_stat->GetNumRows() != table_stats.GetNumRows()) {
-        table_stats.SetNumRows(new_column_stat->GetNumRows());
-      }
-      table_stats.AddColumnStats(std::move(new_column_stat));
-    }
+  std::vector<std::pair<uint64_t, TableStatsKey>> candidates;
+  candidates.reserve(table_stats_storage_.size());
+  for (const auto &[key, entry] : table_stats_storage_) {
+    if (std::equal_to<TableStatsKey>()(key, keep)) continue;
+    candidates.emplace_back(entry.last_access_.load(std::memory_order_relaxed), key);
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+  for (const auto &candidate : candidates) {
+    if (memory_usage_.load(std::memory_order_relaxed) <= memory_limit_) break;
+    auto table_it = table_stats_storage_.find(candidate.second);
+    memory_usage_.store(memory_usage_.load(std::memory_order_relaxed) - table_it->second.memory_usage_,
+                        std::memory_order_relaxed);
+    OPTIMIZER_LOG_TRACE("Evicting statistics of table {} from StatsStorage",
+                        candidate.second.table_oid_.UnderlyingValue());
+    table_stats_storage_.erase(table_it);
   }
 }
 
@@ -42,6 +42,20 @@ void TableStats::RemoveColumnStats(catalog::col_oid_t column_id) {
   column_stats_.erase(col_it);
 }
 
+void TableStats::AddColumnGroupStats(std::unique_ptr<ColumnGroupStats> group_stats) {
+  const auto group_oid =
+      ColumnGroupStats::EncodeGroupOid(group_stats->GetFirstColumnID(), group_stats->GetSecondColumnID());
+  column_group_stats_[group_oid] = std::move(group_stats);
+}
+
+common::ManagedPointer<ColumnGroupStats> TableStats::GetColumnGroupStats(catalog::col_oid_t first_column_id,
+                                                                         catalog::col_oid_t second_column_id) const {
+  if (!ColumnGroupStats::CanEncodeGroupOid(first_column_id, second_column_id)) return nullptr;
+  auto group_it = column_group_stats_.find(ColumnGroupStats::EncodeGroupOid(first_column_id, second_column_id));
+  if (group_it == column_group_stats_.end()) return nullptr;
+  return common::ManagedPointer<ColumnGroupStats>(group_it->second);
+}
+
 nlohmann::json TableStats::ToJson() const {
   nlohmann::json j;
   j["database_id"] = database_id_;
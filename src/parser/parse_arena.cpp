@@ -0,0 +1,28 @@
+#include "parser/parse_arena.h"
+
+#include <new>
+
+namespace noisepage::parser {
+
+thread_local ParseArena *ParseArena::current = nullptr;
+
+void *ParseArenaObject::operator new(const std::size_t size) {
+  ParseArena *const arena = ParseArena::current;
+  void *const block = arena != nullptr ? arena->Allocate(HEADER_SIZE + size, HEADER_SIZE)
+                                       : ::operator new(HEADER_SIZE + size);
+  *static_cast<ParseArena **>(block) = arena;
+  return static_cast<std::byte *>(block) + HEADER_SIZE;
+}
+
+void ParseArenaObject::operator delete(void *const ptr) {
+  if (ptr == nullptr) return;
+  void *const block = static_cast<std::byte *>(ptr) - HEADER_SIZE;
+  ParseArena *const arena = *static_cast<ParseArena **>(block);
+  if (arena != nullptr) {
+    arena->Release();
+  } else {
+    ::operator delete(block);
+  }
+}
+
+}  // namespace noisepage::parser
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -61,6 +62,7 @@ std::unique_ptr<parser::ParseResult> PostgresParser::BuildParseTree(const std::s
   // Transform the Postgres parse tree to a Terrier representation.
   auto parse_result = std::make_unique<ParseResult>();
   try {
+    ParseArena::Scope arena_scope(parse_result->GetArena());
     ListTransform(parse_result.get(), result.tree);
   } catch (const Exception &e) {
     pg_query_parse_finish(ctx);
@@ -1133,6 +1135,13 @@ std::unique_ptr<CopyStatement> PostgresParser::CopyTransform(ParseResult *parse_
   static constexpr char k_quote_tok[] = "quote";
   static constexpr char k_escape_tok[] = "escape";
 
+  std::vector<std::string> columns;
+  if (root->attlist_ != nullptr) {
+    for (ListCell *cell = root->attlist_->head; cell != nullptr; cell = cell->next) {
+      columns.emplace_back(reinterpret_cast<value *>(cell->data.ptr_value)->val_.str_);
+    }
+  }
+
   std::unique_ptr<TableRef> table;
   std::unique_ptr<SelectStatement> select_stmt;
   if (root->relation_ != nullptr) {
@@ -1144,8 +1153,28 @@ std::unique_ptr<CopyStatement> PostgresParser::CopyTransform(ParseResult *parse_
   auto file_path = root->filename_ != nullptr ? root->filename_ : "";
   auto is_from = root->is_from_;
 
-  char delimiter = ',';
-  ExternalFileFormat format = ExternalFileFormat::CSV;
+  if (!is_from && table != nullptr) {
+    // COPY table TO is COPY (SELECT columns FROM table) TO, so that the rest of the system only handles the latter
+    std::vector<common::ManagedPointer<AbstractExpression>> target;
+    if (columns.empty()) {
+      auto star = std::make_unique<TableStarExpression>();
+      target.emplace_back(common::ManagedPointer(star).CastManagedPointerTo<AbstractExpression>());
+      parse_result->AddExpression(std::move(star));
+    }
+    for (const auto &column : columns) {
+      auto column_expr = std::make_unique<ColumnValueExpression>("", column);
+      target.emplace_back(common::ManagedPointer(column_expr).CastManagedPointerTo<AbstractExpression>());
+      parse_result->AddExpression(std::move(column_expr));
+    }
+    select_stmt = std::make_unique<SelectStatement>(
+        std::move(target), false, std::move(table), nullptr, nullptr, nullptr,
+        std::make_unique<LimitDescription>(LimitDescription::NO_LIMIT, LimitDescription::NO_OFFSET),
+        std::vector<std::unique_ptr<TableRef>>{});
+  }
+
+  // Postgres' defaults: the text format delimits columns with tabs, CSV with commas
+  ExternalFileFormat format = ExternalFileFormat::TEXT;
+  std::optional<char> delimiter;
   char quote = '"';
   char escape = '"';
   if (root->options_ != nullptr) {
@@ -1159,6 +1188,8 @@ std::unique_ptr<CopyStatement> PostgresParser::CopyTransform(ParseResult *parse_
           format = ExternalFileFormat::CSV;
         } else if (strcmp(format_cstr, "binary") == 0) {
           format = ExternalFileFormat::BINARY;
+        } else if (strcmp(format_cstr, "text") == 0) {
+          format = ExternalFileFormat::TEXT;
         }
       }
 
@@ -1176,8 +1207,9 @@ std::unique_ptr<CopyStatement> PostgresParser::CopyTransform(ParseResult *parse_
     }
   }
 
-  auto result = std::make_unique<CopyStatement>(std::move(table), std::move(select_stmt), file_path, format, is_from,
-                                                delimiter, quote, escape);
+  auto result = std::make_unique<CopyStatement>(
+      std::move(table), std::move(select_stmt), std::move(columns), file_path, format, is_from,
+      delimiter.value_or(format == ExternalFileFormat::CSV ? ',' : '\t'), quote, escape);
   return result;
 }
 
@@ -1426,8 +1458,10 @@ std::unique_ptr<SQLStatement> PostgresParser::CreateIndexTransform(ParseResult *
     }
   }
 
+  auto index_predicate = WhereTransform(parse_result, root->where_clause_);
+
   return std::make_unique<CreateStatement>(std::move(table_info), index_type, unique, index_name,
-                                           std::move(index_attrs), std::move(options));
+                                           std::move(index_attrs), std::move(options), index_predicate);
 }
 
 // Postgres.CreateSchemaStmt -> noisepage.CreateStatement
@@ -227,6 +227,9 @@ std::unique_ptr<metrics::PipelineMetricRawData> PilotUtil::CollectPipelineFeatur
       if (!future_result.has_value()) {
         throw PILOT_EXCEPTION("Future timed out.", common::ErrorCode::ERRCODE_IO_ERROR);
       }
+      // Drain the features of this query now, so that the queries together cannot overflow the metrics ring of the
+      // thread that executes them and lose features
+      metrics_manager->Aggregate(true);
     } else {
       // Just compile the queries (generate the bytecodes) to get features with statistics
       auto &query_util = planning_context.GetQueryExecUtil();
@@ -257,7 +260,7 @@ std::unique_ptr<metrics::PipelineMetricRawData> PilotUtil::CollectPipelineFeatur
 
   if (execute_query) {
     // retrieve the features
-    metrics_manager->Aggregate();
+    metrics_manager->Aggregate(true);
 
     aggregated_data.reset(reinterpret_cast<metrics::PipelineMetricRawData *>(
         metrics_manager->AggregatedMetrics()
@@ -133,6 +133,19 @@ void Callbacks::MetricsPipelineSampleRate(void *old_value, void *new_value, DBMa
   action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::MetricsPipelineOutput(void *const old_value, void *const new_value, DBMain *const db_main,
+                                      common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  auto metrics_output = metrics::MetricsUtil::FromMetricsOutputString(metrics::MetricsComponent::EXECUTION_PIPELINE,
+                                                                      *static_cast<std::string_view *>(new_value));
+  if (metrics_output == std::nullopt) {
+    action_context->SetState(common::ActionState::FAILURE);
+    return;
+  }
+  db_main->GetMetricsManager()->SetMetricOutput(metrics::MetricsComponent::EXECUTION_PIPELINE, *metrics_output);
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
 void Callbacks::MetricsLoggingSampleRate(void *old_value, void *new_value, DBMain *db_main,
                                          common::ManagedPointer<common::ActionContext> action_context) {
   action_context->SetState(common::ActionState::IN_PROGRESS);
@@ -163,6 +176,17 @@ void Callbacks::MetricsExecuteCommand(void *const old_value, void *const new_val
   action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::MetricsAdmissionControl(void *const old_value, void *const new_value, DBMain *const db_main,
+                                        common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  bool new_status = *static_cast<bool *>(new_value);
+  if (new_status)
+    db_main->GetMetricsManager()->EnableMetric(metrics::MetricsComponent::ADMISSION_CONTROL);
+  else
+    db_main->GetMetricsManager()->DisableMetric(metrics::MetricsComponent::ADMISSION_CONTROL);
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
 void Callbacks::MetricsQueryTrace(void *const old_value, void *const new_value, DBMain *const db_main,
                                   common::ManagedPointer<common::ActionContext> action_context) {
   action_context->SetState(common::ActionState::IN_PROGRESS);
@@ -177,7 +201,8 @@ void Callbacks::MetricsQueryTrace(void *const old_value, void *const new_value,
 void Callbacks::MetricsQueryTraceOutput(void *const old_value, void *const new_value, DBMain *const db_main,
                                         common::ManagedPointer<common::ActionContext> action_context) {
   action_context->SetState(common::ActionState::IN_PROGRESS);
-  auto metrics_output = metrics::MetricsUtil::FromMetricsOutputString(*static_cast<std::string_view *>(new_value));
+  auto metrics_output = metrics::MetricsUtil::FromMetricsOutputString(metrics::MetricsComponent::QUERY_TRACE,
+                                                                      *static_cast<std::string_view *>(new_value));
   if (metrics_output == std::nullopt) {
     action_context->SetState(common::ActionState::FAILURE);
     return;
@@ -0,0 +1,316 @@
+#include "storage/recovery/index_expression_evaluator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "execution/sql/value_util.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/function_expression.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+bool IsIntegral(const type::TypeId type) {
+  return type == type::TypeId::TINYINT || type == type::TypeId::SMALLINT || type == type::TypeId::INTEGER ||
+         type == type::TypeId::BIGINT;
+}
+
+bool IsNumeric(const type::TypeId type) { return IsIntegral(type) || type == type::TypeId::REAL; }
+
+bool IsString(const type::TypeId type) { return type == type::TypeId::VARCHAR || type == type::TypeId::VARBINARY; }
+
+double AsDouble(const parser::ConstantValueExpression &value) {
+  return IsIntegral(value.GetReturnValueType()) ? static_cast<double>(value.Peek<int64_t>()) : value.Peek<double>();
+}
+
+parser::ConstantValueExpression MakeBool(const bool value) {
+  return parser::ConstantValueExpression(type::TypeId::BOOLEAN, execution::sql::BoolVal(value));
+}
+
+parser::ConstantValueExpression MakeString(const type::TypeId type, const std::string &value) {
+  auto string_val = execution::sql::ValueUtil::CreateStringVal(value);
+  return parser::ConstantValueExpression(type, string_val.first, std::move(string_val.second));
+}
+
+/** @return negative, zero or positive like strcmp. Both values must be non-NULL. */
+int Compare(const parser::ConstantValueExpression &lhs, const parser::ConstantValueExpression &rhs) {
+  const auto ltype = lhs.GetReturnValueType();
+  const auto rtype = rhs.GetReturnValueType();
+  if (IsIntegral(ltype) && IsIntegral(rtype)) {
+    const auto l = lhs.Peek<int64_t>();
+    const auto r = rhs.Peek<int64_t>();
+    return static_cast<int>(l > r) - static_cast<int>(l < r);
+  }
+  if (IsNumeric(ltype) && IsNumeric(rtype)) {
+    const auto l = AsDouble(lhs);
+    const auto r = AsDouble(rhs);
+    return static_cast<int>(l > r) - static_cast<int>(l < r);
+  }
+  if (IsString(ltype) && IsString(rtype)) {
+    return lhs.Peek<std::string_view>().compare(rhs.Peek<std::string_view>());
+  }
+  if (ltype != rtype) {
+    throw std::runtime_error("Index expression compares values of incompatible types during recovery");
+  }
+  switch (ltype) {
+    case type::TypeId::BOOLEAN:
+      return static_cast<int>(lhs.Peek<bool>()) - static_cast<int>(rhs.Peek<bool>());
+    case type::TypeId::DATE: {
+      const auto l = lhs.Peek<execution::sql::Date>().ToNative();
+      const auto r = rhs.Peek<execution::sql::Date>().ToNative();
+      return static_cast<int>(l > r) - static_cast<int>(l < r);
+    }
+    case type::TypeId::TIMESTAMP: {
+      const auto l = lhs.Peek<execution::sql::Timestamp>().ToNative();
+      const auto r = rhs.Peek<execution::sql::Timestamp>().ToNative();
+      return static_cast<int>(l > r) - static_cast<int>(l < r);
+    }
+    default:
+      throw std::runtime_error("Index expression compares values of an unsupported type during recovery");
+  }
+}
+
+common::ManagedPointer<const parser::AbstractExpression> ChildOf(
+    common::ManagedPointer<const parser::AbstractExpression> expr, const size_t idx) {
+  return expr->GetChild(idx).CastManagedPointerTo<const parser::AbstractExpression>();
+}
+
+bool CompareResult(const parser::ExpressionType type, const int cmp) {
+  switch (type) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      return cmp == 0;
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+      return cmp != 0;
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      return cmp < 0;
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      return cmp <= 0;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      return cmp > 0;
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      return cmp >= 0;
+    default:
+      UNREACHABLE("Not a comparison.");
+  }
+}
+
+}  // namespace
+
+bool IndexExpressionEvaluator::IsSupported(common::ManagedPointer<const parser::AbstractExpression> expr) {
+  switch (expr->GetExpressionType()) {
+    case parser::ExpressionType::COLUMN_VALUE:
+      if (expr->GetReturnValueType() == type::TypeId::DECIMAL) return false;
+      break;
+    case parser::ExpressionType::VALUE_CONSTANT:
+    case parser::ExpressionType::COMPARE_EQUAL:
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::CONJUNCTION_AND:
+    case parser::ExpressionType::CONJUNCTION_OR:
+    case parser::ExpressionType::OPERATOR_NOT:
+    case parser::ExpressionType::OPERATOR_IS_NULL:
+    case parser::ExpressionType::OPERATOR_IS_NOT_NULL:
+      break;
+    case parser::ExpressionType::OPERATOR_UNARY_MINUS:
+    case parser::ExpressionType::OPERATOR_PLUS:
+    case parser::ExpressionType::OPERATOR_MINUS:
+    case parser::ExpressionType::OPERATOR_MULTIPLY:
+      if (!IsNumeric(expr->GetReturnValueType())) return false;
+      break;
+    case parser::ExpressionType::FUNCTION: {
+      const auto &name = expr.CastManagedPointerTo<const parser::FunctionExpression>()->GetFuncName();
+      if (name != "lower" && name != "upper") return false;
+      break;
+    }
+    default:
+      return false;
+  }
+
+  const auto children = expr->GetChildren();
+  return std::all_of(children.cbegin(), children.cend(), [](const auto &child) {
+    return IsSupported(child.template CastManagedPointerTo<const parser::AbstractExpression>());
+  });
+}
+
+bool IndexExpressionEvaluator::IsSupported(const catalog::IndexSchema &schema) {
+  for (const auto &col : schema.GetColumns()) {
+    if (!IsSupported(col.StoredExpression())) return false;
+  }
+  return !schema.IsPartial() || IsSupported(schema.GetPredicate());
+}
+
+parser::ConstantValueExpression IndexExpressionEvaluator::ReadColumn(const catalog::col_oid_t col_oid) const {
+  const auto type = table_schema_.GetColumn(col_oid).Type();
+  const byte *value = table_pr_.AccessWithNullCheck(pr_map_.at(col_oid));
+  if (value == nullptr) return parser::ConstantValueExpression(type);
+
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+      return MakeBool(*reinterpret_cast<const bool *>(value));
+    case type::TypeId::TINYINT:
+      return parser::ConstantValueExpression(type, execution::sql::Integer(*reinterpret_cast<const int8_t *>(value)));
+    case type::TypeId::SMALLINT:
+      return parser::ConstantValueExpression(type, execution::sql::Integer(*reinterpret_cast<const int16_t *>(value)));
+    case type::TypeId::INTEGER:
+      return parser::ConstantValueExpression(type, execution::sql::Integer(*reinterpret_cast<const int32_t *>(value)));
+    case type::TypeId::BIGINT:
+      return parser::ConstantValueExpression(type, execution::sql::Integer(*reinterpret_cast<const int64_t *>(value)));
+    case type::TypeId::REAL:
+      return parser::ConstantValueExpression(type, execution::sql::Real(*reinterpret_cast<const double *>(value)));
+    case type::TypeId::DATE:
+      return parser::ConstantValueExpression(
+          type, execution::sql::DateVal(*reinterpret_cast<const execution::sql::Date *>(value)));
+    case type::TypeId::TIMESTAMP:
+      return parser::ConstantValueExpression(
+          type, execution::sql::TimestampVal(*reinterpret_cast<const execution::sql::Timestamp *>(value)));
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      const auto *varlen = reinterpret_cast<const VarlenEntry *>(value);
+      return MakeString(type, std::string(varlen->StringView()));
+    }
+    default:
+      throw std::runtime_error("Unsupported column type in index expression during recovery");
+  }
+}
+
+parser::ConstantValueExpression IndexExpressionEvaluator::Evaluate(
+    common::ManagedPointer<const parser::AbstractExpression> expr) const {
+  const auto expr_type = expr->GetExpressionType();
+  switch (expr_type) {
+    case parser::ExpressionType::COLUMN_VALUE:
+      return ReadColumn(expr.CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid());
+    case parser::ExpressionType::VALUE_CONSTANT:
+      return *expr.CastManagedPointerTo<const parser::ConstantValueExpression>();
+    case parser::ExpressionType::COMPARE_EQUAL:
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO: {
+      const auto lhs = Evaluate(ChildOf(expr, 0));
+      const auto rhs = Evaluate(ChildOf(expr, 1));
+      if (lhs.IsNull() || rhs.IsNull()) return parser::ConstantValueExpression(type::TypeId::BOOLEAN);
+      return MakeBool(CompareResult(expr_type, Compare(lhs, rhs)));
+    }
+    case parser::ExpressionType::CONJUNCTION_AND:
+    case parser::ExpressionType::CONJUNCTION_OR: {
+      // Three-valued logic: a FALSE (AND) or TRUE (OR) child decides the result even if another child is NULL
+      const bool is_and = expr_type == parser::ExpressionType::CONJUNCTION_AND;
+      bool saw_null = false;
+      for (const auto &child : expr->GetChildren()) {
+        const auto value = Evaluate(child.CastManagedPointerTo<const parser::AbstractExpression>());
+        if (value.IsNull()) {
+          saw_null = true;
+        } else if (value.Peek<bool>() != is_and) {
+          return MakeBool(!is_and);
+        }
+      }
+      return saw_null ? parser::ConstantValueExpression(type::TypeId::BOOLEAN) : MakeBool(is_and);
+    }
+    case parser::ExpressionType::OPERATOR_NOT: {
+      const auto value = Evaluate(ChildOf(expr, 0));
+      return value.IsNull() ? value : MakeBool(!value.Peek<bool>());
+    }
+    case parser::ExpressionType::OPERATOR_IS_NULL:
+      return MakeBool(Evaluate(ChildOf(expr, 0)).IsNull());
+    case parser::ExpressionType::OPERATOR_IS_NOT_NULL:
+      return MakeBool(!Evaluate(ChildOf(expr, 0)).IsNull());
+    case parser::ExpressionType::OPERATOR_UNARY_MINUS:
+    case parser::ExpressionType::OPERATOR_PLUS:
+    case parser::ExpressionType::OPERATOR_MINUS:
+    case parser::ExpressionType::OPERATOR_MULTIPLY: {
+      const auto result_type = expr->GetReturnValueType();
+      const auto lhs = Evaluate(ChildOf(expr, 0));
+      if (lhs.IsNull()) return parser::ConstantValueExpression(result_type);
+      if (expr_type == parser::ExpressionType::OPERATOR_UNARY_MINUS) {
+        if (IsIntegral(result_type)) {
+          return parser::ConstantValueExpression(result_type, execution::sql::Integer(-lhs.Peek<int64_t>()));
+        }
+        return parser::ConstantValueExpression(result_type, execution::sql::Real(-AsDouble(lhs)));
+      }
+      const auto rhs = Evaluate(ChildOf(expr, 1));
+      if (rhs.IsNull()) return parser::ConstantValueExpression(result_type);
+      if (IsIntegral(result_type)) {
+        const auto l = lhs.Peek<int64_t>();
+        const auto r = rhs.Peek<int64_t>();
+        const int64_t result = expr_type == parser::ExpressionType::OPERATOR_PLUS    ? l + r
+                               : expr_type == parser::ExpressionType::OPERATOR_MINUS ? l - r
+                                                                                     : l * r;
+        return parser::ConstantValueExpression(result_type, execution::sql::Integer(result));
+      }
+      const auto l = AsDouble(lhs);
+      const auto r = AsDouble(rhs);
+      const double result = expr_type == parser::ExpressionType::OPERATOR_PLUS    ? l + r
+                            : expr_type == parser::ExpressionType::OPERATOR_MINUS ? l - r
+                                                                                  : l * r;
+      return parser::ConstantValueExpression(result_type, execution::sql::Real(result));
+    }
+    case parser::ExpressionType::FUNCTION: {
+      const auto value = Evaluate(ChildOf(expr, 0));
+      if (value.IsNull()) return value;
+      const bool to_lower = expr.CastManagedPointerTo<const parser::FunctionExpression>()->GetFuncName() == "lower";
+      std::string str(value.Peek<std::string_view>());
+      std::transform(str.begin(), str.end(), str.begin(),
+                     [to_lower](unsigned char c) { return to_lower ? std::tolower(c) : std::toupper(c); });
+      return MakeString(value.GetReturnValueType(), str);
+    }
+    default:
+      throw std::runtime_error("Unsupported index expression during recovery");
+  }
+}
+
+bool IndexExpressionEvaluator::SatisfiesPredicate(const catalog::IndexSchema &schema) const {
+  if (!schema.IsPartial()) return true;
+  const auto result = Evaluate(schema.GetPredicate());
+  return !result.IsNull() && result.Peek<bool>();
+}
+
+void IndexExpressionEvaluator::WriteKey(const parser::ConstantValueExpression &value, const type::TypeId type,
+                                        const uint16_t offset, ProjectedRow *const index_pr) {
+  if (value.IsNull()) {
+    index_pr->SetNull(offset);
+    return;
+  }
+  byte *const dest = index_pr->AccessForceNotNull(offset);
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+      *reinterpret_cast<bool *>(dest) = value.Peek<bool>();
+      break;
+    case type::TypeId::TINYINT:
+      *reinterpret_cast<int8_t *>(dest) = value.Peek<int8_t>();
+      break;
+    case type::TypeId::SMALLINT:
+      *reinterpret_cast<int16_t *>(dest) = value.Peek<int16_t>();
+      break;
+    case type::TypeId::INTEGER:
+      *reinterpret_cast<int32_t *>(dest) = value.Peek<int32_t>();
+      break;
+    case type::TypeId::BIGINT:
+      *reinterpret_cast<int64_t *>(dest) = value.Peek<int64_t>();
+      break;
+    case type::TypeId::REAL:
+      *reinterpret_cast<double *>(dest) = AsDouble(value);
+      break;
+    case type::TypeId::DATE:
+      *reinterpret_cast<execution::sql::Date *>(dest) = value.Peek<execution::sql::Date>();
+      break;
+    case type::TypeId::TIMESTAMP:
+      *reinterpret_cast<execution::sql::Timestamp *>(dest) = value.Peek<execution::sql::Timestamp>();
+      break;
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY:
+      *reinterpret_cast<VarlenEntry *>(dest) = value.Peek<VarlenEntry>();
+      break;
+    default:
+      throw std::runtime_error("Unsupported index key type during recovery");
+  }
+}
+
+}  // namespace noisepage::storage
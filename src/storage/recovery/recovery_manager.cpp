@@ -22,6 +22,7 @@
 #include "storage/index/index.h"
 #include "storage/index/index_builder.h"
 #include "storage/index/index_metadata.h"
+#include "storage/recovery/index_expression_evaluator.h"
 #include "storage/recovery/replication_log_provider.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "transaction/deferred_action_manager.h"
@@ -164,6 +165,7 @@ uint32_t RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::ti
         buffered_record->RecordType() == LogRecordType::REDO || buffered_record->RecordType() == LogRecordType::DELETE,
         "Buffered record must be a redo or delete.");
 
+    LockCatalogForReplay(txn, buffered_record);
     if (IsSpecialCaseCatalogRecord(buffered_record)) {
       idx += ProcessSpecialCaseCatalogRecord(txn, &buffered_changes_map_[txn_id], idx);
     } else if (buffered_record->RecordType() == LogRecordType::REDO) {
@@ -411,30 +413,48 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
   auto pr_map = table_ptr->ProjectionMapForOids(all_table_oids);
   NOISEPAGE_ASSERT(pr_map.size() == table_pr->NumColumns(), "Projected row should contain all attributes");
 
-  // TODO(Gus): We are going to assume no indexes on expressions below. Having indexes on expressions would require to
-  // evaluate expressions and that's a nightmare
   for (const auto &index_obj : index_objects) {
     auto index = index_obj.first;
     const auto &schema = index_obj.second;
-    const auto &indexed_attributes = schema.GetIndexedColOids();
 
     // Build the index PR
     auto *index_pr = index->GetProjectedRowInitializer().InitializeRow(index_buffer);
 
-    // Copy in each value from the table PR into the index PR
-    auto num_index_cols = schema.GetColumns().size();
-    NOISEPAGE_ASSERT(num_index_cols == indexed_attributes.size(),
-                     "Only support index keys that are a single column oid");
-    for (uint32_t col_idx = 0; col_idx < num_index_cols; col_idx++) {
-      const auto &col = schema.GetColumn(col_idx);
-      auto index_col_oid = col.Oid();
-      const catalog::col_oid_t &table_col_oid = indexed_attributes[col_idx];
-      if (table_pr->IsNull(pr_map[table_col_oid])) {
-        index_pr->SetNull(index->GetKeyOidToOffsetMap().at(index_col_oid));
-      } else {
-        auto size = AttrSizeBytes(col.AttributeLength());
-        std::memcpy(index_pr->AccessForceNotNull(index->GetKeyOidToOffsetMap().at(index_col_oid)),
-                    table_pr->AccessWithNullCheck(pr_map[table_col_oid]), size);
+    // Keys computed from expressions. Varlen keys point into these values, so they must outlive the index operation.
+    std::vector<parser::ConstantValueExpression> computed_keys;
+    if (schema.HasExpressionKeys() || schema.IsPartial()) {
+      // There is no compiled query to derive keys with during recovery, so interpret the key expressions and the
+      // partial index predicate against the replayed tuple instead
+      if (!IndexExpressionEvaluator::IsSupported(schema)) {
+        throw std::runtime_error("Recovery does not support the expressions of this index");
+      }
+      IndexExpressionEvaluator evaluator(table_schema, *table_pr, pr_map);
+      if (!evaluator.SatisfiesPredicate(schema)) continue;
+
+      computed_keys.reserve(schema.GetColumns().size());
+      for (const auto &col : schema.GetColumns()) {
+        computed_keys.emplace_back(evaluator.Evaluate(col.StoredExpression()));
+        IndexExpressionEvaluator::WriteKey(computed_keys.back(), col.Type(),
+                                           index->GetKeyOidToOffsetMap().at(col.Oid()), index_pr);
+      }
+    } else {
+      const auto &indexed_attributes = schema.GetIndexedColOids();
+
+      // Copy in each value from the table PR into the index PR
+      auto num_index_cols = schema.GetColumns().size();
+      NOISEPAGE_ASSERT(num_index_cols == indexed_attributes.size(),
+                       "Only support index keys that are a single column oid");
+      for (uint32_t col_idx = 0; col_idx < num_index_cols; col_idx++) {
+        const auto &col = schema.GetColumn(col_idx);
+        auto index_col_oid = col.Oid();
+        const catalog::col_oid_t &table_col_oid = indexed_attributes[col_idx];
+        if (table_pr->IsNull(pr_map[table_col_oid])) {
+          index_pr->SetNull(index->GetKeyOidToOffsetMap().at(index_col_oid));
+        } else {
+          auto size = AttrSizeBytes(col.AttributeLength());
+          std::memcpy(index_pr->AccessForceNotNull(index->GetKeyOidToOffsetMap().at(index_col_oid)),
+                      table_pr->AccessWithNullCheck(pr_map[table_col_oid]), size);
+        }
       }
     }
 
@@ -739,7 +759,7 @@ uint32_t RecoveryManager::ProcessSpecialCasePGClassRecord(
             col_oids.clear();
             col_oids = {catalog::postgres::PgIndex::INDISUNIQUE.oid_, catalog::postgres::PgIndex::INDISPRIMARY.oid_,
                         catalog::postgres::PgIndex::INDISEXCLUSION.oid_, catalog::postgres::PgIndex::INDIMMEDIATE.oid_,
-                        catalog::postgres::PgIndex::IND_TYPE.oid_};
+                        catalog::postgres::PgIndex::IND_TYPE.oid_, catalog::postgres::PgIndex::INDPRED.oid_};
             auto pg_index_pr_init = db_catalog->pg_core_.indexes_->InitializerForProjectedRow(col_oids);
             auto pg_index_pr_map = db_catalog->pg_core_.indexes_->ProjectionMapForOids(col_oids);
 
@@ -765,10 +785,17 @@ uint32_t RecoveryManager::ProcessSpecialCasePGClassRecord(
                 pr->AccessWithNullCheck(pg_index_pr_map[catalog::postgres::PgIndex::INDIMMEDIATE.oid_])));
             storage::index::IndexType index_type = *(reinterpret_cast<storage::index::IndexType *>(
                 pr->AccessWithNullCheck(pg_index_pr_map[catalog::postgres::PgIndex::IND_TYPE.oid_])));
+            std::unique_ptr<parser::AbstractExpression> predicate = nullptr;
+            const auto *predicate_json = reinterpret_cast<const VarlenEntry *>(
+                pr->AccessWithNullCheck(pg_index_pr_map[catalog::postgres::PgIndex::INDPRED.oid_]));
+            if (predicate_json != nullptr) {
+              auto deserialized = parser::DeserializeExpression(nlohmann::json::parse(predicate_json->StringView()));
+              predicate = std::move(deserialized.result_);
+            }
 
             // Step 4: Create and set IndexSchema in catalog
             auto *index_schema = new catalog::IndexSchema(index_cols, index_type, is_unique, is_primary, is_exclusion,
-                                                          is_immediate, idx_options);
+                                                          is_immediate, idx_options, std::move(predicate));
             result = db_catalog->SetIndexSchemaPointer<RecoveryManager>(common::ManagedPointer(txn),
                                                                         catalog::index_oid_t(class_oid), index_schema);
             NOISEPAGE_ASSERT(result,
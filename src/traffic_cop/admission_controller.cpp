@@ -0,0 +1,152 @@
+#include "traffic_cop/admission_controller.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "execution/sql/hash_table_entry.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/output_schema.h"
+#include "planner/plannodes/plan_meta_data.h"
+#include "type/type_util.h"
+
+namespace noisepage::trafficcop {
+
+void AdmissionController::Ticket::Release() {
+  if (controller_ == nullptr) return;
+  controller_->Release(workload_class_, memory_);
+  controller_ = nullptr;
+}
+
+AdmissionController::AdmissionController(const uint32_t oltp_slots, const uint32_t analytic_slots,
+                                         const double analytic_cost_threshold, const uint64_t memory_budget,
+                                         const std::chrono::milliseconds queue_timeout)
+    : analytic_cost_threshold_(analytic_cost_threshold), memory_budget_(memory_budget), queue_timeout_(queue_timeout) {
+  NOISEPAGE_ASSERT(oltp_slots > 0 && analytic_slots > 0, "Every workload class needs at least one slot.");
+  State(WorkloadClass::OLTP).slots_ = oltp_slots;
+  State(WorkloadClass::ANALYTIC).slots_ = analytic_slots;
+}
+
+/**
+ * @param plan plan node
+ * @param plan_meta_data cardinalities of the plan's nodes
+ * @param per_tuple_overhead bytes that the operator keeps for every tuple besides its values
+ * @return estimated bytes of the plan node's output, if all of it is held at once
+ */
+static double EstimateOutputMemory(const planner::AbstractPlanNode &plan,
+                                   const common::ManagedPointer<planner::PlanMetaData> plan_meta_data,
+                                   const double per_tuple_overhead) {
+  if (!plan_meta_data->HasPlanNodeMetaData(plan.GetPlanNodeId())) return 0;
+  double tuple_size = per_tuple_overhead;
+  for (const auto &column : plan.GetOutputSchema()->GetColumns()) {
+    if (column.GetType() != type::TypeId::INVALID) tuple_size += type::TypeUtil::GetTypeTrueSize(column.GetType());
+  }
+  return tuple_size * static_cast<double>(plan_meta_data->GetPlanNodeMetaData(plan.GetPlanNodeId()).GetCardinality());
+}
+
+uint64_t AdmissionController::EstimateMemory(const common::ManagedPointer<planner::AbstractPlanNode> plan,
+                                             const common::ManagedPointer<planner::PlanMetaData> plan_meta_data) {
+  double memory = 0;
+  std::vector<common::ManagedPointer<planner::AbstractPlanNode>> nodes{plan};
+  while (!nodes.empty()) {
+    const auto node = nodes.back();
+    nodes.pop_back();
+    switch (node->GetPlanNodeType()) {
+      case planner::PlanNodeType::HASHJOIN:
+        memory += EstimateOutputMemory(*node->GetChild(0), plan_meta_data, sizeof(execution::sql::HashTableEntry));
+        break;
+      case planner::PlanNodeType::AGGREGATE:
+        memory += EstimateOutputMemory(*node, plan_meta_data, sizeof(execution::sql::HashTableEntry));
+        break;
+      case planner::PlanNodeType::ORDERBY:
+        memory += EstimateOutputMemory(*node->GetChild(0), plan_meta_data, sizeof(byte *));
+        break;
+      default:
+        break;
+    }
+    const auto children = node->GetChildren();
+    nodes.insert(nodes.end(), children.cbegin(), children.cend());
+  }
+  // Cardinalities of tables without statistics can be huge, which must not wrap around
+  return memory >= static_cast<double>(std::numeric_limits<uint64_t>::max()) ? std::numeric_limits<uint64_t>::max()
+                                                                               : static_cast<uint64_t>(memory);
+}
+
+bool AdmissionController::CanAdmit(const ClassState &state, const uint64_t memory) const {
+  if (state.running_ >= state.slots_) return false;
+  // A query that needs more than the whole budget would never fit, so it runs once it has the memory to itself
+  return memory_budget_ == 0 || reserved_memory_ == 0 || reserved_memory_ + memory <= memory_budget_;
+}
+
+AdmissionController::Ticket AdmissionController::Admit(const WorkloadClass workload_class,
+                                                       const uint64_t estimated_memory) {
+  const auto memory = memory_budget_ == 0 ? 0 : estimated_memory;
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto &state = State(workload_class);
+  const uint64_t queue_depth = state.queue_.size();
+  if (state.queue_.empty() && CanAdmit(state, memory)) {
+    state.running_++;
+    reserved_memory_ += memory;
+    return Ticket(this, workload_class, memory, queue_depth, std::chrono::microseconds(0));
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto waiter = state.queue_.insert(state.queue_.end(), memory);
+  const bool admitted = admission_cv_.wait_until(lock, start + queue_timeout_, [&] {
+    return waiter == state.queue_.begin() && CanAdmit(state, memory);
+  });
+  const auto wait = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  state.queue_.erase(waiter);
+  // The next query in the queue may be able to run now, or at least is at the head of the queue
+  admission_cv_.notify_all();
+  if (!admitted) {
+    state.num_timed_out_++;
+    Ticket ticket;
+    ticket.workload_class_ = workload_class;
+    ticket.queue_depth_ = queue_depth;
+    ticket.wait_ = wait;
+    return ticket;
+  }
+  state.running_++;
+  state.total_wait_ += wait;
+  reserved_memory_ += memory;
+  return Ticket(this, workload_class, memory, queue_depth, wait);
+}
+
+void AdmissionController::Release(const WorkloadClass workload_class, const uint64_t memory) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto &state = State(workload_class);
+    NOISEPAGE_ASSERT(state.running_ > 0 && reserved_memory_ >= memory, "Released a slot that was not admitted.");
+    state.running_--;
+    reserved_memory_ -= memory;
+  }
+  admission_cv_.notify_all();
+}
+
+uint64_t AdmissionController::GetQueueDepth(const WorkloadClass workload_class) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return State(workload_class).queue_.size();
+}
+
+uint32_t AdmissionController::GetNumRunning(const WorkloadClass workload_class) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return State(workload_class).running_;
+}
+
+uint64_t AdmissionController::GetReservedMemory() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return reserved_memory_;
+}
+
+uint64_t AdmissionController::GetNumTimedOut(const WorkloadClass workload_class) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return State(workload_class).num_timed_out_;
+}
+
+std::chrono::microseconds AdmissionController::GetTotalWaitTime(const WorkloadClass workload_class) const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return State(workload_class).total_wait_;
+}
+
+}  // namespace noisepage::trafficcop
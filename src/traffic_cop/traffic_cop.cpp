@@ -1,8 +1,12 @@
 #include "traffic_cop/traffic_cop.h"
 
+#include <algorithm>
 #include <future>  // NOLINT
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -20,13 +24,20 @@
 #include "execution/sql/ddl_executors.h"
 #include "execution/sql/value.h"
 #include "execution/vm/module.h"
+#include "loggers/optimizer_logger.h"
 #include "metrics/metrics_store.h"
 #include "network/connection_context.h"
 #include "network/postgres/portal.h"
+#include "network/postgres/portal_execution.h"
 #include "network/postgres/postgres_packet_writer.h"
 #include "network/postgres/statement.h"
-#include "optimizer/cost_model/trivial_cost_model.h"
+#include "optimizer/cost_model/cardinality_cost_model.h"
+#include "optimizer/optimize_result.h"
+#include "optimizer/statistics/cardinality_feedback.h"
+#include "optimizer/statistics/selectivity_util.h"
 #include "optimizer/statistics/stats_storage.h"
+#include "optimizer/statistics/value_condition.h"
+#include "parser/copy_statement.h"
 #include "parser/drop_statement.h"
 #include "parser/explain_statement.h"
 #include "parser/expression/constant_value_expression.h"
@@ -191,7 +202,88 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCop::OptimizeBoundQuery(
 
   return TrafficCopUtil::Optimize(connection_ctx->Transaction(), connection_ctx->Accessor(), query,
                                   connection_ctx->GetDatabaseOid(), stats_storage_,
-                                  std::make_unique<optimizer::TrivialCostModel>(), optimizer_timeout_, parameters);
+                                  std::make_unique<optimizer::CardinalityCostModel>(), optimizer_timeout_, parameters,
+                                  common::ManagedPointer(optimizer_worker_pool_));
+}
+
+void TrafficCop::PlanBoundQuery(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<network::Statement> statement,
+    const common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) const {
+  if (!use_query_cache_ || parameters == nullptr || parameters->empty()) {
+    // Without parameters, a cached plan suits every execution
+    if (statement->OptimizeResult() == nullptr || !use_query_cache_) {
+      statement->SetOptimizeResult(OptimizeBoundQuery(connection_ctx, statement->ParseResult(), parameters));
+    }
+    return;
+  }
+
+  const auto custom_plan_executions =
+      static_cast<uint32_t>(settings_manager_->GetInt(settings::Param::custom_plan_executions));
+  if (statement->GetNumCustomPlans() < custom_plan_executions) {
+    auto custom_plan = OptimizeBoundQuery(connection_ctx, statement->ParseResult(), parameters);
+    statement->RecordCustomPlan(custom_plan->GetCost());
+    statement->SetOptimizeResult(std::move(custom_plan));
+    return;
+  }
+
+  if (!statement->HasGenericPlan() && !statement->IsGenericPlanRejected()) {
+    auto generic_plan = OptimizeBoundQuery(connection_ctx, statement->ParseResult(), nullptr);
+    const auto average_custom_cost = statement->GetAverageCustomPlanCost();
+    const bool cheap_enough = generic_plan->GetCost() <= average_custom_cost * GENERIC_PLAN_COST_MARGIN;
+    if (statement->GetNumCustomPlans() == 0 || cheap_enough) {
+      statement->SetGenericPlan(std::move(generic_plan));
+    } else {
+      OPTIMIZER_LOG_DEBUG("Rejected generic plan with cost {} against an average custom plan cost of {}",
+                          generic_plan->GetCost(), average_custom_cost);
+      statement->RejectGenericPlan();
+    }
+  }
+
+  if (statement->HasGenericPlan() && PlanFits(connection_ctx, statement->GenericOptimizeResult(), parameters)) {
+    statement->UseGenericPlan();
+    return;
+  }
+
+  // The custom plan of an earlier execution, and the code compiled for it, are as good as a new one for values of
+  // about the same selectivity
+  if (!statement->IsGenericPlanActive() && statement->OptimizeResult() != nullptr &&
+      PlanFits(connection_ctx, statement->OptimizeResult(), parameters)) {
+    return;
+  }
+  statement->SetOptimizeResult(OptimizeBoundQuery(connection_ctx, statement->ParseResult(), parameters));
+}
+
+bool TrafficCop::PlanFits(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                          const common::ManagedPointer<optimizer::OptimizeResult> plan,
+                          const common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) const {
+  const auto factor = settings_manager_->GetInt(settings::Param::generic_plan_selectivity_factor);
+  if (factor == 0) return true;
+
+  for (const auto &assumed : plan->GetParameterSelectivities()) {
+    const auto snapshot =
+        stats_storage_->GetTableStats(assumed.db_oid_, assumed.table_oid_, connection_ctx->Accessor().Get());
+    const auto &table_stats = snapshot.table_stats_;
+    if (!table_stats.HasColumnStats(assumed.col_oid_)) continue;
+
+    // Comparisons with NULL produce no rows
+    const auto &value = parameters->at(assumed.param_idx_);
+    double selectivity = 0;
+    if (!value.IsNull()) {
+      optimizer::ValueCondition condition(assumed.col_oid_, "", assumed.type_,
+                                          std::make_unique<parser::ConstantValueExpression>(value));
+      selectivity = optimizer::SelectivityUtil::ComputeSelectivity(table_stats, condition);
+    }
+
+    const auto num_rows = static_cast<double>(table_stats.GetNumRows());
+    if (optimizer::CardinalityFeedback::IsMisestimate(static_cast<size_t>(assumed.selectivity_ * num_rows),
+                                                      static_cast<size_t>(selectivity * num_rows), factor)) {
+      OPTIMIZER_LOG_DEBUG("Parameter {} has selectivity {} where the plan assumed {}", assumed.param_idx_, selectivity,
+                          assumed.selectivity_);
+      return false;
+    }
+  }
+  return true;
 }
 
 TrafficCopResult TrafficCop::ExecuteSetStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
@@ -374,7 +466,35 @@ TrafficCopResult TrafficCop::ExecuteExplainStatement(
       portal->GetStatement()->RootStatement().CastManagedPointerTo<parser::ExplainStatement>()->GetFormat();
   std::string plan_string;
   if (format == parser::ExplainStatementFormat::JSON) {
-    plan_string = portal->OptimizeResult()->GetPlanNode()->ToJson().dump(4);
+    auto plan_json = portal->OptimizeResult()->GetPlanNode()->ToJson();
+
+    // Show how each pipeline of a compiled query would run. Other statements are explained without pipelines. The
+    // pipelines are only laid out, no code is generated or compiled for them.
+    const auto explained_type = trafficcop::TrafficCopUtil::QueryTypeForStatement(
+        portal->GetStatement()->RootStatement().CastManagedPointerTo<parser::ExplainStatement>()->GetSQLStatement());
+    const bool compiled = explained_type == network::QueryType::QUERY_SELECT ||
+                          explained_type == network::QueryType::QUERY_INSERT ||
+                          explained_type == network::QueryType::QUERY_UPDATE ||
+                          explained_type == network::QueryType::QUERY_DELETE;
+    if (compiled) {
+      execution::exec::ExecutionSettings exec_settings{};
+      exec_settings.UpdateFromSettingsManager(settings_manager_);
+      const auto pipeline_infos = execution::compiler::CompilationContext::DescribePipelines(
+          *portal->OptimizeResult()->GetPlanNode(), exec_settings, connection_ctx->Accessor().Get(),
+          portal->OptimizeResult()->GetPlanMetaData());
+
+      auto pipelines = nlohmann::json::array();
+      for (const auto &info : pipeline_infos) {
+        nlohmann::json pipeline;
+        pipeline["id"] = info.pipeline_id_;
+        pipeline["steps"] = info.steps_;
+        pipeline["degree_of_parallelism"] = info.degree_of_parallelism_;
+        if (info.estimated_input_rows_.has_value()) pipeline["estimated_input_rows"] = *info.estimated_input_rows_;
+        pipelines.push_back(std::move(pipeline));
+      }
+      plan_json["pipelines"] = std::move(pipelines);
+    }
+    plan_string = plan_json.dump(4);
   } else {
     NOISEPAGE_ASSERT(format == parser::ExplainStatementFormat::TPL || format == parser::ExplainStatementFormat::TBC,
                      "We only support JSON, TPL, and TBC formats.");
@@ -419,6 +539,23 @@ std::variant<std::unique_ptr<parser::ParseResult>, common::ErrorData> TrafficCop
   return result;
 }
 
+/**
+ * @param statement bound statement
+ * @return true if the statement returns a DECIMAL column to the client
+ */
+static bool HasDecimalResult(const common::ManagedPointer<parser::SQLStatement> statement) {
+  common::ManagedPointer<parser::SelectStatement> select = nullptr;
+  if (statement->GetType() == parser::StatementType::SELECT) {
+    select = statement.CastManagedPointerTo<parser::SelectStatement>();
+  } else if (statement->GetType() == parser::StatementType::COPY) {
+    select = statement.CastManagedPointerTo<parser::CopyStatement>()->GetSelectStatement();
+  }
+  if (select == nullptr) return false;
+  const auto &columns = select->GetSelectColumns();
+  return std::any_of(columns.cbegin(), columns.cend(),
+                     [](const auto &column) { return column->GetReturnValueType() == type::TypeId::DECIMAL; });
+}
+
 TrafficCopResult TrafficCop::BindQuery(
     const common::ManagedPointer<network::ConnectionContext> connection_ctx,
     const common::ManagedPointer<network::Statement> statement,
@@ -458,6 +595,13 @@ TrafficCopResult TrafficCop::BindQuery(
     return {ResultType::ERROR, error};
   }
 
+  // A DecimalVal does not know its scale, so a DECIMAL result could not be sent as the number it stands for
+  if (HasDecimalResult(statement->RootStatement())) {
+    return {ResultType::ERROR,
+            common::ErrorData(common::ErrorSeverity::ERROR, "DECIMAL results are not supported, cast them to REAL",
+                              common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED)};
+  }
+
   return {ResultType::COMPLETE, 0u};
 }
 
@@ -480,7 +624,8 @@ TrafficCopResult TrafficCop::CodegenPhysicalPlan(
   NOISEPAGE_ASSERT(
       query_type == network::QueryType::QUERY_SELECT || query_type == network::QueryType::QUERY_INSERT ||
           query_type == network::QueryType::QUERY_CREATE_INDEX || query_type == network::QueryType::QUERY_UPDATE ||
-          query_type == network::QueryType::QUERY_DELETE || query_type == network::QueryType::QUERY_ANALYZE,
+          query_type == network::QueryType::QUERY_DELETE || query_type == network::QueryType::QUERY_ANALYZE ||
+          query_type == network::QueryType::QUERY_COPY,
       "CodegenPhysicalPlan called with invalid QueryType.");
 
   if (portal->GetStatement()->GetExecutableQuery() != nullptr && use_query_cache_) {
@@ -528,20 +673,29 @@ TrafficCopResult TrafficCop::CodegenPhysicalPlan(
 
 TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
                                                 const common::ManagedPointer<network::PostgresPacketWriter> out,
-                                                const common::ManagedPointer<network::Portal> portal) const {
+                                                const common::ManagedPointer<network::Portal> portal,
+                                                const common::ManagedPointer<network::PortalExecution> portal_execution)
+    const {
   NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
                    "Not in a valid txn. This should have been caught before calling this function.");
   const auto query_type = portal->GetStatement()->GetQueryType();
   NOISEPAGE_ASSERT(
       query_type == network::QueryType::QUERY_SELECT || query_type == network::QueryType::QUERY_INSERT ||
           query_type == network::QueryType::QUERY_CREATE_INDEX || query_type == network::QueryType::QUERY_UPDATE ||
-          query_type == network::QueryType::QUERY_DELETE || query_type == network::QueryType::QUERY_ANALYZE,
+          query_type == network::QueryType::QUERY_DELETE || query_type == network::QueryType::QUERY_ANALYZE ||
+          query_type == network::QueryType::QUERY_COPY,
       "CodegenAndRunPhysicalPlan called with invalid QueryType.");
 
-  if (query_cache_timestamp_ > portal->GetStatement()->GetExecutableQuery()->GetTimestamp()) {
-    // ExecutableQuery is outdated. Re-generate it
+  // The degrees of parallelism and the join orders of the plan are chosen from the statistics, which ANALYZE may have
+  // changed since the plan was optimized
+  if (portal->GetStatement()->IsPlanStale() ||
+      query_cache_timestamp_ > portal->GetStatement()->GetExecutableQuery()->GetTimestamp() ||
+      portal->OptimizeResult()->GetStatsEpoch() != stats_storage_->GetInvalidationEpoch()) {
+    // ExecutableQuery is outdated, or its plan was based on misestimated or outdated statistics. Re-generate it
     auto statement = portal->GetStatement();
     statement->SetExecutableQuery(nullptr);
+    // A generic plan set aside is just as outdated, so the statement starts over with custom plans
+    statement->ClearGenericPlan();
     // Re-optimize the query (e.g., there can be new indexes that the query can use)
     auto optimize_result = OptimizeBoundQuery(connection_ctx, statement->ParseResult(), portal->ModifiableParameters());
     statement->SetOptimizeResult(std::move(optimize_result));
@@ -549,7 +703,51 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
     CodegenPhysicalPlan(connection_ctx, out, portal);
   }
 
-  const auto physical_plan = portal->OptimizeResult()->GetPlanNode();
+  // Hold on to the plan and its code. A query that is suspended in the middle of its result resumes with them, even if
+  // the statement was planned again for another portal in the meantime.
+  const auto optimize_result = portal->GetStatement()->ShareOptimizeResult();
+  const auto executable_query = portal->GetStatement()->ShareExecutableQuery();
+  const auto physical_plan = optimize_result->GetPlanNode();
+
+  // Queries that would oversubscribe the execution threads or the memory wait for the ones ahead of them to finish
+  AdmissionController::Ticket admission_ticket;
+  bool readmission_timed_out = false;
+  if (admission_controller_ != nullptr) {
+    const auto estimated_cost = optimize_result->GetCost();
+    // The memory the statement used before, or what the optimizer's cardinalities suggest if it did not execute yet
+    const auto peak_memory = portal->GetStatement()->GetPeakMemory();
+    const auto estimated_memory =
+        peak_memory != 0 ? peak_memory
+                         : AdmissionController::EstimateMemory(physical_plan, optimize_result->GetPlanMetaData());
+    admission_ticket = admission_controller_->Admit(admission_controller_->Classify(estimated_cost), estimated_memory);
+
+    if (common::thread_context.metrics_store_ != nullptr &&
+        common::thread_context.metrics_store_->ComponentToRecord(metrics::MetricsComponent::ADMISSION_CONTROL)) {
+      common::thread_context.metrics_store_->RecordAdmission(
+          static_cast<uint8_t>(admission_ticket.GetWorkloadClass()), estimated_cost, estimated_memory,
+          admission_ticket.GetQueueDepth(), admission_ticket.GetWaitTime().count(), admission_ticket.IsAdmitted());
+    }
+
+    if (!admission_ticket.IsAdmitted()) {
+      connection_ctx->Transaction()->SetMustAbort();
+      return {ResultType::ERROR,
+              common::ErrorData(common::ErrorSeverity::ERROR, "canceling statement due to admission queue timeout",
+                                common::ErrorCode::ERRCODE_QUERY_CANCELED)};
+    }
+
+    if (portal_execution != nullptr) {
+      // A portal that is fetched a few rows at a time does not run while it waits for the client's next Execute, which
+      // may take arbitrarily long. It gives back its slot in the meantime and queues up again to resume.
+      const auto workload_class = admission_ticket.GetWorkloadClass();
+      portal_execution->SetSuspendHooks([&admission_ticket] { admission_ticket.Release(); },
+                                        [&, workload_class, estimated_memory] {
+                                          admission_ticket = admission_controller_->Admit(workload_class,
+                                                                                          estimated_memory);
+                                          readmission_timed_out = !admission_ticket.IsAdmitted();
+                                          return !readmission_timed_out;
+                                        });
+    }
+  }
 
   /*
    * ANALYZE will update the statistics held in the pg_statistic catalog table. These statistics are also cached in
@@ -564,7 +762,17 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
         [=]() { stats_storage_->MarkStatsStale(db_oid, table_oid, col_oids); });
   }
 
-  execution::exec::OutputWriter writer(physical_plan->GetOutputSchema(), out, portal->ResultFormats());
+  // COPY TO STDOUT sends the rows of its query as CopyData messages instead of DataRows
+  std::optional<network::CopyFormat> copy_format;
+  if (query_type == network::QueryType::QUERY_COPY) {
+    copy_format = TrafficCopUtil::CopyFormatForStatement(
+        portal->GetStatement()->RootStatement().CastManagedPointerTo<parser::CopyStatement>());
+    out->WriteCopyOutResponse(*copy_format,
+                              static_cast<uint16_t>(physical_plan->GetOutputSchema()->GetColumns().size()));
+  }
+
+  execution::exec::OutputWriter writer(physical_plan->GetOutputSchema(), out, portal->ResultFormats(),
+                                       copy_format.has_value() ? &copy_format.value() : nullptr, portal_execution);
 
   // A std::function<> requires the target to be CopyConstructible and CopyAssignable. In certain
   // cases constructing a std::function<> copies the target. This can lead to cases where invoking
@@ -592,7 +800,12 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
 
   exec_ctx->SetParams(portal->Parameters());
 
-  const auto exec_query = portal->GetStatement()->GetExecutableQuery();
+  // Rows below the output are only counted when the query was compiled with counters and pipeline metrics
+  const auto feedback_factor = settings_manager_->GetInt(settings::Param::cardinality_feedback_factor);
+  exec_ctx->SetObserveRows(feedback_factor > 0 && exec_settings.GetIsCountersEnabled() &&
+                           exec_settings.GetIsPipelineMetricsEnabled());
+
+  const auto exec_query = common::ManagedPointer(executable_query.get());
 
   try {
     exec_query->Run(common::ManagedPointer(exec_ctx), execution_mode_);
@@ -609,6 +822,24 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
     return {ResultType::ERROR, error};
   }
 
+  if (readmission_timed_out) {
+    connection_ctx->Transaction()->SetMustAbort();
+    return {ResultType::ERROR,
+            common::ErrorData(common::ErrorSeverity::ERROR, "canceling statement due to admission queue timeout",
+                              common::ErrorCode::ERRCODE_QUERY_CANCELED)};
+  }
+
+  if (portal_execution != nullptr && portal_execution->IsClosed()) {
+    // The portal was closed before the client fetched all of its rows, so the query stopped early and neither its
+    // memory nor its cardinalities are representative
+    return {ResultType::COMPLETE, writer.NumRows()};
+  }
+
+  if (admission_controller_ != nullptr) {
+    // Later executions of the statement are expected to need as much memory as this one
+    portal->GetStatement()->RecordPeakMemory(exec_ctx->GetMemoryPool()->GetTracker()->GetPeakAllocatedSize());
+  }
+
   const bool query_trace_metrics_enabled =
       common::thread_context.metrics_store_ != nullptr &&
       common::thread_context.metrics_store_->ComponentToRecord(metrics::MetricsComponent::QUERY_TRACE);
@@ -620,6 +851,19 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
 
   if (connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK) {
     // Execution didn't set us to FAIL state, go ahead and return command complete
+    // The feedback is about the statement's current plan, which a suspended query may no longer be running
+    if (feedback_factor > 0 && portal->OptimizeResult().Get() == optimize_result.get()) {
+      auto output_rows = exec_query->GetObservedOutputRows(*exec_ctx);
+      if (query_type == network::QueryType::QUERY_SELECT || query_type == network::QueryType::QUERY_COPY) {
+        output_rows[physical_plan->GetPlanNodeId()] = writer.NumRows();
+      }
+      RecordCardinalityFeedback(portal, output_rows, static_cast<double>(feedback_factor));
+    }
+
+    if (copy_format.has_value()) {
+      out->WriteCopyOutDone(*copy_format);
+      return {ResultType::COMPLETE, writer.NumRows()};
+    }
     if (query_type == network::QueryType::QUERY_SELECT) {
       // For selects we rely on the OutputWriter to store the number of rows affected because sequential scan
       // iteration can happen in multiple pipelines
@@ -636,6 +880,105 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
                                                common::ErrorCode::ERRCODE_T_R_SERIALIZATION_FAILURE)};
 }
 
+TrafficCopResult TrafficCop::RunCopyIn(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                       const common::ManagedPointer<network::Portal> portal,
+                                       const common::ManagedPointer<network::Portal> batch_portal,
+                                       const size_t rows_per_insert,
+                                       std::vector<std::vector<parser::ConstantValueExpression>> *const rows) const {
+  NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                   "Not in a valid txn. This should have been caught before calling this function.");
+  NOISEPAGE_ASSERT(portal->GetStatement()->GetQueryType() == network::QueryType::QUERY_INSERT,
+                   "COPY FROM STDIN inserts its rows with an INSERT.");
+  NOISEPAGE_ASSERT(rows_per_insert == 1 || batch_portal != nullptr, "Batches of rows need the batch INSERT.");
+
+  // An INSERT has no output
+  execution::exec::OutputCallback callback = [](byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {};
+
+  execution::exec::ExecutionSettings exec_settings{};
+  exec_settings.UpdateFromSettingsManager(settings_manager_);
+
+  common::ManagedPointer<metrics::MetricsManager> metrics = nullptr;
+  if (common::thread_context.metrics_store_ != nullptr) {
+    metrics = common::thread_context.metrics_store_->MetricsManager();
+  }
+
+  uint32_t rows_affected = 0;
+  // Runs one of the INSERTs with the given values as its parameters, in an ExecutionContext of its own per INSERT
+  std::unique_ptr<execution::exec::ExecutionContext> exec_ctx;
+  std::unique_ptr<execution::exec::ExecutionContext> batch_exec_ctx;
+  const auto run = [&](const common::ManagedPointer<network::Portal> insert,
+                       std::unique_ptr<execution::exec::ExecutionContext> *const ctx,
+                       const std::vector<parser::ConstantValueExpression> &params) -> std::optional<TrafficCopResult> {
+    if (*ctx == nullptr) {
+      *ctx = std::make_unique<execution::exec::ExecutionContext>(
+          connection_ctx->GetDatabaseOid(), connection_ctx->Transaction(), callback,
+          insert->OptimizeResult()->GetPlanNode()->GetOutputSchema().Get(), connection_ctx->Accessor(), exec_settings,
+          metrics, replication_manager_, recovery_manager_);
+    }
+    (*ctx)->SetParams(common::ManagedPointer(&params));
+    try {
+      insert->GetStatement()->GetExecutableQuery()->Run(common::ManagedPointer(*ctx), execution_mode_);
+    } catch (ExecutionException &e) {
+      connection_ctx->Transaction()->SetMustAbort();
+      auto error = common::ErrorData(common::ErrorSeverity::ERROR, e.what(), e.code_);
+      error.AddField(common::ErrorField::LINE, std::to_string(e.GetLine()));
+      error.AddField(common::ErrorField::FILE, e.GetFile());
+      return TrafficCopResult{ResultType::ERROR, error};
+    }
+    if (connection_ctx->TransactionState() != network::NetworkTransactionStateType::BLOCK) {
+      return TrafficCopResult{ResultType::ERROR,
+                              common::ErrorData(common::ErrorSeverity::ERROR, "Query failed.",
+                                                common::ErrorCode::ERRCODE_T_R_SERIALIZATION_FAILURE)};
+    }
+    return std::nullopt;
+  };
+
+  // Whole batches go through the batch INSERT with the values of all of their rows, one row after the other
+  size_t row = 0;
+  if (rows_per_insert > 1) {
+    std::vector<parser::ConstantValueExpression> params;
+    for (; row + rows_per_insert <= rows->size(); row += rows_per_insert) {
+      params.clear();
+      for (size_t i = row; i < row + rows_per_insert; i++) {
+        std::move((*rows)[i].begin(), (*rows)[i].end(), std::back_inserter(params));
+      }
+      if (auto error = run(batch_portal, &batch_exec_ctx, params)) return *std::move(error);
+    }
+    if (batch_exec_ctx != nullptr) rows_affected += batch_exec_ctx->GetRowsAffected();
+  }
+  for (; row < rows->size(); row++) {
+    if (auto error = run(portal, &exec_ctx, (*rows)[row])) return *std::move(error);
+  }
+  if (exec_ctx != nullptr) rows_affected += exec_ctx->GetRowsAffected();
+
+  return {ResultType::COMPLETE, rows_affected};
+}
+
+void TrafficCop::RecordCardinalityFeedback(const common::ManagedPointer<network::Portal> portal,
+                                           const std::unordered_map<planner::plan_node_id_t, size_t> &output_rows,
+                                           const double factor) const {
+  const auto plan_meta_data = portal->OptimizeResult()->GetPlanMetaData();
+  const auto feedback = stats_storage_->GetCardinalityFeedback();
+
+  bool plan_stale = false;
+  for (const auto &[plan_node_id, actual_rows] : output_rows) {
+    if (!plan_meta_data->HasPlanNodeMetaData(plan_node_id)) continue;
+    const auto &meta_data = plan_meta_data->GetPlanNodeMetaData(plan_node_id);
+    const auto signature = meta_data.GetCardinalitySignature();
+    if (signature == optimizer::CardinalityFeedback::NO_SIGNATURE) continue;
+
+    // A plan that was already chosen with an observed cardinality in mind is not re-optimized over and over again
+    // when the cardinality keeps changing, e.g. with the parameters of a prepared statement
+    feedback->Record(signature, meta_data.GetCardinality(), actual_rows);
+    if (!meta_data.IsCardinalityFromFeedback() &&
+        optimizer::CardinalityFeedback::IsMisestimate(meta_data.GetCardinality(), actual_rows, factor)) {
+      plan_stale = true;
+    }
+  }
+
+  if (plan_stale && use_query_cache_) portal->GetStatement()->MarkPlanStale();
+}
+
 std::pair<catalog::db_oid_t, catalog::namespace_oid_t> TrafficCop::CreateTempNamespace(
     const network::connection_id_t connection_id, const std::string &database_name) {
   auto *const txn = txn_manager_->BeginTransaction();
@@ -11,6 +11,7 @@
 #include "optimizer/query_to_operator_transformer.h"
 #include "optimizer/statistics/stats_storage.h"
 #include "parser/analyze_statement.h"
+#include "parser/copy_statement.h"
 #include "parser/drop_statement.h"
 #include "parser/explain_statement.h"
 #include "parser/insert_statement.h"
@@ -27,7 +28,8 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCopUtil::Optimize(
     const common::ManagedPointer<parser::ParseResult> query, const catalog::db_oid_t db_oid,
     common::ManagedPointer<optimizer::StatsStorage> stats_storage,
     std::unique_ptr<optimizer::AbstractCostModel> cost_model, const uint64_t optimizer_timeout,
-    common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) {
+    common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters,
+    common::ManagedPointer<common::WorkerPool> optimizer_worker_pool) {
   // Optimizer transforms annotated ParseResult to logical expressions (ephemeral Optimizer structure)
   optimizer::QueryToOperatorTransformer transformer(accessor, db_oid);
   auto query_statement = query->GetStatement(0);
@@ -42,7 +44,7 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCopUtil::Optimize(
   auto logical_exprs = transformer.ConvertToOpExpression(query_statement, query);
 
   // TODO(Matt): is the cost model to use going to become an arg to this function eventually?
-  optimizer::Optimizer optimizer(std::move(cost_model), optimizer_timeout);
+  optimizer::Optimizer optimizer(std::move(cost_model), optimizer_timeout, optimizer_worker_pool);
   optimizer::PropertySet property_set;
   std::vector<common::ManagedPointer<parser::AbstractExpression>> output;
 
@@ -55,8 +57,7 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCopUtil::Optimize(
     const auto sel_stmt = query->GetStatement(0).CastManagedPointerTo<parser::SelectStatement>();
 
     // Output
-    output = sel_stmt->GetSelectColumns();  // TODO(Matt): this is making a local copy. Revisit the life cycle and
-    // immutability of all of these Optimizer inputs to reduce copies.
+    output = sel_stmt->GetSelectColumns();
 
     CollectSelectProperties(sel_stmt, &property_set);
   } else if (type == parser::StatementType::INSERT &&
@@ -64,9 +65,14 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCopUtil::Optimize(
     const auto sel_stmt = query->GetStatement(0).CastManagedPointerTo<parser::InsertStatement>()->GetSelect();
 
     // Inset into select output will be pushed down to select
-    output = sel_stmt->GetSelectColumns();  // TODO(Matt): this is making a local copy. Revisit the life cycle and
-    // immutability of all of these Optimizer inputs to reduce copies.
+    output = sel_stmt->GetSelectColumns();
 
+    CollectSelectProperties(sel_stmt, &property_set);
+  } else if (const auto copy_stmt = ClientCopyStatement(query->GetStatement(0));
+             copy_stmt != nullptr && !copy_stmt->IsFrom()) {
+    // COPY TO STDOUT produces the output of its query
+    const auto sel_stmt = copy_stmt->GetSelectStatement();
+    output = sel_stmt->GetSelectColumns();
     CollectSelectProperties(sel_stmt, &property_set);
   }
 
@@ -74,12 +80,8 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCopUtil::Optimize(
   // TODO(Matt): QueryInfo holding a raw pointer to PropertySet obfuscates the required life cycle of PropertySet
 
   // Optimize, consuming the logical expressions in the process
-  return optimizer.BuildPlanTree(txn.Get(), accessor.Get(), stats_storage.Get(), query_info, std::move(logical_exprs),
-                                 parameters);
-  // TODO(Matt): I see a lot of copying going on in the Optimizer that maybe shouldn't be happening. BuildPlanTree's
-  // signature is copying QueryInfo object (contains a vector of output columns), which then immediately makes a local
-  // copy of that vector anyway. Presumably those are immutable expressions, in which case they should be const & to the
-  // original vector (or parent object) all the way down.
+  return optimizer.BuildPlanTree(txn.Get(), accessor.Get(), stats_storage.Get(), std::move(query_info),
+                                 std::move(logical_exprs), parameters);
   // TODO(Matt): Why does the Optimizer need a TransactionContext? It looks like it's an arg all the way down to the
   // cost model. Do we expect that can be transactional?
 }
@@ -185,4 +187,17 @@ network::QueryType TrafficCopUtil::QueryTypeForStatement(const common::ManagedPo
   }
 }
 
+common::ManagedPointer<parser::CopyStatement> TrafficCopUtil::ClientCopyStatement(
+    const common::ManagedPointer<parser::SQLStatement> statement) {
+  if (statement == nullptr || statement->GetType() != parser::StatementType::COPY) return nullptr;
+  const auto copy_stmt = statement.CastManagedPointerTo<parser::CopyStatement>();
+  return copy_stmt->IsStdio() ? copy_stmt : nullptr;
+}
+
+network::CopyFormat TrafficCopUtil::CopyFormatForStatement(
+    const common::ManagedPointer<parser::CopyStatement> copy_stmt) {
+  return {copy_stmt->GetExternalFileFormat(), copy_stmt->GetDelimiter(), copy_stmt->GetQuoteChar(),
+          copy_stmt->GetEscapeChar()};
+}
+
 }  // namespace noisepage::trafficcop
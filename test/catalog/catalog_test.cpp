@@ -7,7 +7,9 @@
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
+#include "catalog/catalog_cache.h"
 #include "catalog/catalog_defs.h"
+#include "catalog/catalog_snapshot.h"
 #include "catalog/database_catalog.h"
 #include "catalog/postgres/pg_namespace.h"
 #include "execution/functions/function_context.h"
@@ -59,6 +61,24 @@ struct CatalogTests : public TerrierTest {
     EXPECT_EQ(table_oid, catalog::INVALID_TABLE_OID);
   }
 
+  /** @return oid of a new table with a single integer column in the default namespace */
+  catalog::table_oid_t CreateTestTable(catalog::CatalogAccessor *accessor, const std::string &table_name) {
+    std::vector<catalog::Schema::Column> cols;
+    cols.emplace_back("id", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+    const auto table_oid = accessor->CreateTable(accessor->GetDefaultNamespace(), table_name, catalog::Schema(cols));
+    EXPECT_NE(table_oid, catalog::INVALID_TABLE_OID);
+    return table_oid;
+  }
+
+  /** @return oid of a new table with a single integer column in the default namespace, created by a committed DDL */
+  catalog::table_oid_t CreateCommittedTable(const std::string &table_name) {
+    auto *txn = txn_manager_->BeginTransaction();
+    auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, DISABLED);
+    const auto table_oid = CreateTestTable(accessor.get(), table_name);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    return table_oid;
+  }
+
   std::unique_ptr<DBMain> db_main_;
   common::ManagedPointer<transaction::TransactionManager> txn_manager_;
   common::ManagedPointer<catalog::Catalog> catalog_;
@@ -854,6 +874,218 @@ TEST_F(CatalogTests, DDLLockTest) {
   txn_manager_->Commit(txn5, transaction::TransactionUtil::EmptyCallback, nullptr);  // txn5 releases the lock
 }
 
+/*
+ * Check that transactions share the metadata snapshot of the catalog version they see, and that DDL replaces it.
+ */
+// NOLINTNEXTLINE
+TEST_F(CatalogTests, SnapshotTest) {
+  catalog::CatalogCache cache;
+  auto *txn = txn_manager_->BeginTransaction();
+  auto dbc = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_);
+  auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, common::ManagedPointer(&cache));
+  auto table_oid = CreateTestTable(accessor.get(), "test_table");
+  EXPECT_TRUE(dbc->IsLockedBy(common::ManagedPointer(txn)));
+  EXPECT_EQ(dbc->GetSnapshot(common::ManagedPointer(txn)), nullptr);  // the DDL transaction never uses a snapshot
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  const auto first_version = txn->FinishTime();
+
+  // Transactions that start after the DDL commit share the snapshot of its version
+  auto *txn1 = txn_manager_->BeginTransaction();
+  auto *txn2 = txn_manager_->BeginTransaction();
+  auto snapshot = dbc->GetSnapshot(common::ManagedPointer(txn1));
+  EXPECT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->Version(), first_version);
+  EXPECT_EQ(snapshot, dbc->GetSnapshot(common::ManagedPointer(txn2)));
+  EXPECT_FALSE(dbc->IsLockedBy(common::ManagedPointer(txn1)));
+
+  // Lookups through the snapshot see the committed table
+  catalog::CatalogCache cache1;
+  auto accessor1 = catalog_->GetAccessor(common::ManagedPointer(txn1), db_, common::ManagedPointer(&cache1));
+  EXPECT_EQ(table_oid, accessor1->GetTableOid("test_table"));
+
+  // The next DDL commit replaces the snapshot, which older transactions then no longer use
+  auto *txn3 = txn_manager_->BeginTransaction();
+  accessor = catalog_->GetAccessor(common::ManagedPointer(txn3), db_, common::ManagedPointer(&cache));
+  EXPECT_TRUE(accessor->DropTable(table_oid));
+  txn_manager_->Commit(txn3, transaction::TransactionUtil::EmptyCallback, nullptr);
+  EXPECT_EQ(dbc->GetSnapshot(common::ManagedPointer(txn1)), nullptr);
+
+  auto *txn4 = txn_manager_->BeginTransaction();
+  snapshot = dbc->GetSnapshot(common::ManagedPointer(txn4));
+  EXPECT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->Version(), txn3->FinishTime());
+  EXPECT_TRUE(transaction::TransactionUtil::NewerThan(snapshot->Version(), first_version));
+  accessor = catalog_->GetAccessor(common::ManagedPointer(txn4), db_, common::ManagedPointer(&cache));
+  EXPECT_EQ(accessor->GetTableOid("test_table"), catalog::INVALID_TABLE_OID);
+
+  txn_manager_->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn_manager_->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn_manager_->Commit(txn4, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+/*
+ * Check that caching connections look metadata up in the shared snapshot before the catalog tables, and that
+ * connections without a cache never do.
+ */
+// NOLINTNEXTLINE
+TEST_F(CatalogTests, SnapshotLookupTest) {
+  const auto table_oid = CreateCommittedTable("test_table");
+
+  catalog::CatalogCache cache;
+  auto *txn = txn_manager_->BeginTransaction();
+  auto snapshot =
+      catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_)->GetSnapshot(common::ManagedPointer(txn));
+  ASSERT_NE(snapshot, nullptr);
+  auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, common::ManagedPointer(&cache));
+  const auto ns = accessor->GetDefaultNamespace().UnderlyingValue();
+
+  // The first lookups load their entries into the snapshot
+  EXPECT_EQ(accessor->GetTableOid("test_table"), table_oid);
+  const auto table = accessor->GetTable(table_oid);
+  auto oid_entry = snapshot->table_oids_.Find({ns, "test_table"});
+  ASSERT_NE(oid_entry, snapshot->table_oids_.end());
+  EXPECT_EQ(oid_entry->second, table_oid);
+  auto table_entry = snapshot->tables_.Find(table_oid);
+  ASSERT_NE(table_entry, snapshot->tables_.end());
+  EXPECT_EQ(table_entry->second, table.Get());
+
+  // Other connections are served from those entries: an entry that only exists in the snapshot is found
+  snapshot->table_oids_.Insert({ns, "snapshot_only"}, table_oid);
+  catalog::CatalogCache other_cache;
+  auto *other_txn = txn_manager_->BeginTransaction();
+  auto other_accessor =
+      catalog_->GetAccessor(common::ManagedPointer(other_txn), db_, common::ManagedPointer(&other_cache));
+  EXPECT_EQ(other_accessor->GetTableOid("snapshot_only"), table_oid);
+  EXPECT_EQ(other_accessor->GetTable(table_oid), table);
+
+  // Connections that do not cache catalog lookups always read the catalog tables
+  auto uncached_accessor = catalog_->GetAccessor(common::ManagedPointer(other_txn), db_, DISABLED);
+  EXPECT_EQ(uncached_accessor->GetTableOid("snapshot_only"), catalog::INVALID_TABLE_OID);
+
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn_manager_->Commit(other_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+/*
+ * Check that the snapshot remembers objects that do not exist, and that the DDL commit creating them replaces it.
+ */
+// NOLINTNEXTLINE
+TEST_F(CatalogTests, SnapshotNegativeEntryTest) {
+  catalog::CatalogCache cache;
+  auto *txn = txn_manager_->BeginTransaction();
+  auto dbc = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_);
+  auto snapshot = dbc->GetSnapshot(common::ManagedPointer(txn));
+  ASSERT_NE(snapshot, nullptr);
+  auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, common::ManagedPointer(&cache));
+  const auto ns = accessor->GetDefaultNamespace().UnderlyingValue();
+
+  EXPECT_EQ(accessor->GetNamespaceOid("missing_namespace"), catalog::INVALID_NAMESPACE_OID);
+  EXPECT_EQ(accessor->GetTableOid("missing_table"), catalog::INVALID_TABLE_OID);
+  EXPECT_EQ(accessor->GetIndexOid("missing_index"), catalog::INVALID_INDEX_OID);
+
+  const auto ns_entry = snapshot->namespace_oids_.Find("missing_namespace");
+  ASSERT_NE(ns_entry, snapshot->namespace_oids_.end());
+  EXPECT_EQ(ns_entry->second, catalog::INVALID_NAMESPACE_OID);
+  // Name lookups go through the whole search path, so every namespace on it remembers the missing name
+  for (const auto path : {catalog::postgres::PgNamespace::NAMESPACE_CATALOG_NAMESPACE_OID,
+                          catalog::postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID}) {
+    const auto table_entry = snapshot->table_oids_.Find({path.UnderlyingValue(), "missing_table"});
+    ASSERT_NE(table_entry, snapshot->table_oids_.end());
+    EXPECT_EQ(table_entry->second, catalog::INVALID_TABLE_OID);
+    const auto index_entry = snapshot->index_oids_.Find({path.UnderlyingValue(), "missing_index"});
+    ASSERT_NE(index_entry, snapshot->index_oids_.end());
+    EXPECT_EQ(index_entry->second, catalog::INVALID_INDEX_OID);
+  }
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Creating the object is a DDL change, so transactions after it no longer see the remembered miss
+  const auto table_oid = CreateCommittedTable("missing_table");
+  txn = txn_manager_->BeginTransaction();
+  const auto new_snapshot = dbc->GetSnapshot(common::ManagedPointer(txn));
+  ASSERT_NE(new_snapshot, nullptr);
+  EXPECT_EQ(new_snapshot->table_oids_.Find({ns, "missing_table"}), new_snapshot->table_oids_.end());
+  accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, common::ManagedPointer(&cache));
+  EXPECT_EQ(accessor->GetTableOid("missing_table"), table_oid);
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+/*
+ * Check that a transaction holding the DDL lock sees its own changes instead of the snapshot, and does not put them
+ * into the snapshot that other transactions share.
+ */
+// NOLINTNEXTLINE
+TEST_F(CatalogTests, SnapshotDDLBypassTest) {
+  catalog::CatalogCache reader_cache;
+  auto *reader_txn = txn_manager_->BeginTransaction();
+  auto dbc = catalog_->GetDatabaseCatalog(common::ManagedPointer(reader_txn), db_);
+  auto snapshot = dbc->GetSnapshot(common::ManagedPointer(reader_txn));
+  ASSERT_NE(snapshot, nullptr);
+  auto reader = catalog_->GetAccessor(common::ManagedPointer(reader_txn), db_, common::ManagedPointer(&reader_cache));
+  EXPECT_EQ(reader->GetTableOid("new_table"), catalog::INVALID_TABLE_OID);
+
+  // The writer gets the same snapshot, which remembers that new_table does not exist
+  catalog::CatalogCache writer_cache;
+  auto *writer_txn = txn_manager_->BeginTransaction();
+  auto writer = catalog_->GetAccessor(common::ManagedPointer(writer_txn), db_, common::ManagedPointer(&writer_cache));
+  EXPECT_EQ(dbc->GetSnapshot(common::ManagedPointer(writer_txn)), snapshot);
+  EXPECT_EQ(writer->GetTableOid("new_table"), catalog::INVALID_TABLE_OID);
+
+  const auto table_oid = CreateTestTable(writer.get(), "new_table");
+  EXPECT_TRUE(dbc->IsLockedBy(common::ManagedPointer(writer_txn)));
+  EXPECT_FALSE(dbc->IsLockedBy(common::ManagedPointer(reader_txn)));
+  EXPECT_EQ(writer->GetTableOid("new_table"), table_oid);
+  EXPECT_EQ(writer->GetSchema(table_oid).GetColumns().size(), 1);
+
+  // The uncommitted table stays invisible to the reader, in the snapshot and in the catalog tables
+  const auto entry = snapshot->table_oids_.Find({writer->GetDefaultNamespace().UnderlyingValue(), "new_table"});
+  ASSERT_NE(entry, snapshot->table_oids_.end());
+  EXPECT_EQ(entry->second, catalog::INVALID_TABLE_OID);
+  EXPECT_EQ(snapshot->schemas_.Find(table_oid), snapshot->schemas_.end());
+  EXPECT_EQ(reader->GetTableOid("new_table"), catalog::INVALID_TABLE_OID);
+
+  txn_manager_->Commit(writer_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn_manager_->Commit(reader_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+/*
+ * Check that a replaced snapshot stays readable by the transactions that use it, and is freed once they are gone.
+ */
+// NOLINTNEXTLINE
+TEST_F(CatalogTests, SnapshotFreeTest) {
+  const auto table_oid = CreateCommittedTable("test_table");
+  const auto deferred_action_manager = db_main_->GetTransactionLayer()->GetDeferredActionManager();
+  const auto gc = db_main_->GetStorageLayer()->GetGarbageCollector();
+
+  catalog::CatalogCache cache;
+  auto *old_txn = txn_manager_->BeginTransaction();
+  auto dbc = catalog_->GetDatabaseCatalog(common::ManagedPointer(old_txn), db_);
+  const auto old_snapshot = dbc->GetSnapshot(common::ManagedPointer(old_txn));
+  ASSERT_NE(old_snapshot, nullptr);
+  const auto old_version = old_snapshot->Version();
+  auto old_accessor = catalog_->GetAccessor(common::ManagedPointer(old_txn), db_, common::ManagedPointer(&cache));
+  EXPECT_EQ(old_accessor->GetTableOid("test_table"), table_oid);
+
+  auto *ddl_txn = txn_manager_->BeginTransaction();
+  auto ddl_accessor = catalog_->GetAccessor(common::ManagedPointer(ddl_txn), db_, DISABLED);
+  EXPECT_TRUE(ddl_accessor->DropTable(table_oid));
+  txn_manager_->Commit(ddl_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Garbage collection cannot free the replaced snapshot while a transaction that reads it is running
+  for (uint8_t i = 0; i < 3; i++) gc->PerformGarbageCollection();
+  EXPECT_EQ(old_snapshot->Version(), old_version);
+  EXPECT_EQ(old_accessor->GetTableOid("test_table"), table_oid);
+  EXPECT_EQ(old_accessor->GetTableOid("other_table"), catalog::INVALID_TABLE_OID);
+  txn_manager_->Commit(old_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // The deferred action that frees it runs once the transaction is gone, the leak checker catches it if it does not
+  deferred_action_manager->FullyPerformGC(gc, DISABLED);
+  auto *txn = txn_manager_->BeginTransaction();
+  const auto snapshot = dbc->GetSnapshot(common::ManagedPointer(txn));
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->Version(), ddl_txn->FinishTime());
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 TEST_F(CatalogTests, StatisticTest) {
   auto txn = txn_manager_->BeginTransaction();
   auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, DISABLED);
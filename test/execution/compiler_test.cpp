@@ -36,6 +36,7 @@
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/output_schema.h"
+#include "planner/plannodes/plan_meta_data.h"
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
@@ -200,6 +201,91 @@ TEST_F(CompilerTest, SimpleSeqScanTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec, exp_vec));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SeqScanDegreeOfParallelismTest) {
+  // SELECT colA FROM test_1, with different estimates of the size of test_1
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto cola_oid = accessor->GetSchema(table_oid).GetColumn("colA").Oid();
+  ExpressionMaker expr_maker;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  seq_scan_out.AddOutput("colA", common::ManagedPointer(expr_maker.CVE(cola_oid, type::TypeId::INTEGER)));
+  planner::SeqScanPlanNode::Builder builder;
+  auto seq_scan = builder.SetOutputSchema(seq_scan_out.MakeSchema())
+                      .SetColumnOids({cola_oid})
+                      .SetIsForUpdateFlag(false)
+                      .SetTableOid(table_oid)
+                      .SetPlanNodeId(planner::plan_node_id_t(1))
+                      .Build();
+
+  auto exec_ctx = MakeExecCtx();
+  const auto &settings = exec_ctx->GetExecutionSettings();
+  ASSERT_TRUE(settings.GetIsParallelQueryExecutionEnabled());
+  const uint64_t rows_per_thread = settings.GetParallelExecutionRowsPerThread();
+  ASSERT_GT(rows_per_thread, 0);
+  const auto max_dop = Pipeline::GetMaxDegreeOfParallelism(settings);
+
+  auto describe = [&](std::optional<uint64_t> table_num_rows) {
+    planner::PlanMetaData plan_meta_data;
+    if (table_num_rows.has_value()) {
+      plan_meta_data.AddPlanNodeMetaData(seq_scan->GetPlanNodeId(),
+                                         planner::PlanMetaData::PlanNodeMetaData(*table_num_rows, *table_num_rows, {}));
+    }
+    auto infos = CompilationContext::DescribePipelines(*seq_scan, settings, exec_ctx->GetAccessor(),
+                                                       common::ManagedPointer(&plan_meta_data));
+    EXPECT_EQ(infos.size(), 1);
+    return infos.at(0);
+  };
+
+  // Without an estimate, the scan runs on every thread
+  auto info = describe(std::nullopt);
+  EXPECT_FALSE(info.estimated_input_rows_.has_value());
+  EXPECT_EQ(info.degree_of_parallelism_, max_dop);
+
+  // Neither does a table that was never analyzed (0 rows) or whose size the optimizer never derived
+  info = describe(0);
+  EXPECT_FALSE(info.estimated_input_rows_.has_value());
+  EXPECT_EQ(info.degree_of_parallelism_, max_dop);
+  info = describe(std::numeric_limits<size_t>::max());
+  EXPECT_FALSE(info.estimated_input_rows_.has_value());
+  EXPECT_EQ(info.degree_of_parallelism_, max_dop);
+
+  // A single thread's worth of rows runs serially
+  info = describe(rows_per_thread);
+  EXPECT_EQ(info.estimated_input_rows_, rows_per_thread);
+  EXPECT_EQ(info.degree_of_parallelism_, 1);
+
+  // Larger estimates use one thread per rows_per_thread rows, up to every thread
+  info = describe(rows_per_thread + 1);
+  EXPECT_EQ(info.degree_of_parallelism_, std::min<uint32_t>(2, max_dop));
+  info = describe(rows_per_thread * (max_dop + 1));
+  EXPECT_EQ(info.degree_of_parallelism_, max_dop);
+  info = describe(std::numeric_limits<size_t>::max() - 1);
+  EXPECT_EQ(info.degree_of_parallelism_, max_dop);
+
+  // Compiling the plan lays out its pipelines the same way, and the query still returns every row on fewer threads
+  planner::PlanMetaData plan_meta_data;
+  plan_meta_data.AddPlanNodeMetaData(seq_scan->GetPlanNodeId(),
+                                     planner::PlanMetaData::PlanNodeMetaData(sql::TEST1_SIZE, rows_per_thread + 1, {}));
+  const auto described = CompilationContext::DescribePipelines(*seq_scan, settings, exec_ctx->GetAccessor(),
+                                                               common::ManagedPointer(&plan_meta_data));
+  NumChecker num_checker(sql::TEST1_SIZE);
+  OutputStore store{&num_checker, seq_scan->GetOutputSchema().Get()};
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store}};
+  exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+  auto run_ctx = MakeExecCtx(&callback_fn, seq_scan->GetOutputSchema().Get());
+  auto executable = CompilationContext::Compile(*seq_scan, run_ctx->GetExecutionSettings(), run_ctx->GetAccessor(),
+                                                CompilationMode::Interleaved, std::nullopt,
+                                                common::ManagedPointer(&plan_meta_data));
+  const auto &compiled = executable->GetPipelineInfos();
+  ASSERT_EQ(compiled.size(), described.size());
+  EXPECT_EQ(compiled[0].steps_, described[0].steps_);
+  EXPECT_EQ(compiled[0].degree_of_parallelism_, described[0].degree_of_parallelism_);
+  EXPECT_EQ(compiled[0].estimated_input_rows_, described[0].estimated_input_rows_);
+  executable->Run(common::ManagedPointer(run_ctx), MODE);
+  num_checker.CheckCorrectness();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleSeqScanNonVecFilterTest) {
   // SELECT col1, col2, col1 * col2, col1 >= 100*col2 FROM test_1
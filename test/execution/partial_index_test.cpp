@@ -0,0 +1,111 @@
+#include <string>
+#include <vector>
+
+#include "catalog/catalog_accessor.h"
+#include "execution/compiler/output_checker.h"
+#include "gtest/gtest.h"
+#include "storage/index/index.h"
+#include "test_util/end_to_end_test.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::execution::sql::test {
+
+/**
+ * Checks that CREATE INDEX and the insert/update/delete translators only maintain the tuples that satisfy the predicate
+ * of a partial index, and that they derive expression keys from the tuple.
+ */
+class PartialIndexTest : public noisepage::test::EndToEndTest {
+ public:
+  void SetUp() override {
+    EndToEndTest::SetUp();
+    auto exec_ctx = MakeExecCtx();
+    GenerateTestTables(exec_ctx.get());
+
+    // test_1.colA is serial in [0, TEST1_SIZE), so both predicates select a known number of tuples
+    RunQuery("CREATE INDEX test_1_partial ON test_1 (colA) WHERE colA < 100");
+    RunQuery("CREATE INDEX test_1_expr ON test_1 ((colA * 2)) WHERE colA >= 9990");
+  }
+
+ protected:
+  /** @return number of index entries visible to the test transaction */
+  uint64_t NumEntries(const std::string &index_name) {
+    auto index = accessor_->GetIndex(accessor_->GetIndexOid(index_name));
+    std::vector<storage::TupleSlot> slots;
+    index->ScanAscending(*test_txn_, storage::index::ScanType::OpenBoth, 1, nullptr, nullptr, 0, &slots);
+    return slots.size();
+  }
+
+  /** Run a query that is expected to return num_rows rows. */
+  void ExpectRows(const std::string &query, int64_t num_rows) {
+    execution::compiler::test::NumChecker checker(num_rows);
+    RunQuery(query, &checker);
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(PartialIndexTest, CreateIndexTest) {
+  EXPECT_EQ(NumEntries("test_1_partial"), 100);
+  EXPECT_EQ(NumEntries("test_1_expr"), 10);
+
+  // The expression key is computed from the tuple rather than copied from colA
+  ExpectRows("SELECT colA FROM test_1 WHERE colA * 2 = 19998", 1);
+  ExpectRows("SELECT colA FROM test_1 WHERE colA < 100 AND colA >= 50", 50);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PartialIndexTest, InsertTest) {
+  // Satisfies only the predicate of test_1_partial
+  RunQuery("INSERT INTO test_1 VALUES (-1, 0, 0, 0)");
+  EXPECT_EQ(NumEntries("test_1_partial"), 101);
+  EXPECT_EQ(NumEntries("test_1_expr"), 10);
+
+  // Satisfies only the predicate of test_1_expr
+  RunQuery("INSERT INTO test_1 VALUES (20000, 0, 0, 0)");
+  EXPECT_EQ(NumEntries("test_1_partial"), 101);
+  EXPECT_EQ(NumEntries("test_1_expr"), 11);
+
+  // Satisfies neither
+  RunQuery("INSERT INTO test_1 VALUES (5000, 0, 0, 0)");
+  EXPECT_EQ(NumEntries("test_1_partial"), 101);
+  EXPECT_EQ(NumEntries("test_1_expr"), 11);
+
+  ExpectRows("SELECT colA FROM test_1 WHERE colA < 0", 1);
+  ExpectRows("SELECT colA FROM test_1 WHERE colA * 2 = 40000", 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PartialIndexTest, DeleteTest) {
+  // Deleting tuples outside of a partial index must not touch it
+  RunQuery("DELETE FROM test_1 WHERE colA >= 100 AND colA < 200");
+  EXPECT_EQ(NumEntries("test_1_partial"), 100);
+  EXPECT_EQ(NumEntries("test_1_expr"), 10);
+
+  RunQuery("DELETE FROM test_1 WHERE colA >= 95 AND colA < 9995");
+  EXPECT_EQ(NumEntries("test_1_partial"), 95);
+  EXPECT_EQ(NumEntries("test_1_expr"), 5);
+
+  ExpectRows("SELECT colA FROM test_1 WHERE colA < 100", 95);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PartialIndexTest, UpdateTest) {
+  // Moves a tuple out of test_1_partial and into test_1_expr
+  RunQuery("UPDATE test_1 SET colA = 30000 WHERE colA = 10");
+  EXPECT_EQ(NumEntries("test_1_partial"), 99);
+  EXPECT_EQ(NumEntries("test_1_expr"), 11);
+
+  // Moves a tuple out of test_1_expr and into test_1_partial
+  RunQuery("UPDATE test_1 SET colA = 10 WHERE colA = 9999");
+  EXPECT_EQ(NumEntries("test_1_partial"), 100);
+  EXPECT_EQ(NumEntries("test_1_expr"), 10);
+
+  // Stays outside of both indexes
+  RunQuery("UPDATE test_1 SET colA = 5001 WHERE colA = 5000");
+  EXPECT_EQ(NumEntries("test_1_partial"), 100);
+  EXPECT_EQ(NumEntries("test_1_expr"), 10);
+
+  ExpectRows("SELECT colA FROM test_1 WHERE colA * 2 = 60000", 1);
+  ExpectRows("SELECT colA FROM test_1 WHERE colA * 2 = 19998", 0);
+}
+
+}  // namespace noisepage::execution::sql::test
@@ -6,6 +6,8 @@
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql_test.h"
 #include "execution/util/timer.h"
+#include "storage/sql_table.h"
+#include "transaction/transaction_context.h"
 
 namespace noisepage::execution::sql::test {
 
@@ -131,6 +133,52 @@ TEST_F(TableVectorIteratorTest, IteratorColOidsTest) {
   EXPECT_EQ(sql::TEST2_SIZE, num_tuples);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, SampledIteratorTest) {
+  //
+  // Ensure a sampled scan visits exactly the blocks selected by the stride and the offset of the transaction
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "index_test_table");
+  const auto num_blocks = static_cast<uint32_t>(exec_ctx_->GetAccessor()->GetTable(table_oid)->GetNumBlocks());
+  ASSERT_GT(num_blocks, 3);
+  std::array<uint32_t, 1> col_oids{1};
+
+  auto count_tuples = [&](uint32_t block_start, uint32_t block_end) {
+    TableVectorIterator iter(exec_ctx_.get(), table_oid.UnderlyingValue(), col_oids.data(),
+                             static_cast<uint32_t>(col_oids.size()));
+    iter.Init(block_start, block_end);
+    uint32_t num_tuples = 0;
+    while (iter.Advance()) {
+      for (auto *vpi = iter.GetVectorProjectionIterator(); vpi->HasNext(); vpi->Advance()) {
+        num_tuples++;
+      }
+    }
+    return num_tuples;
+  };
+
+  std::vector<uint32_t> block_sizes;
+  for (uint32_t block = 0; block < num_blocks; block++) block_sizes.push_back(count_tuples(block, block + 1));
+
+  constexpr uint32_t stride = 2;
+  exec_ctx_->SetTableSample(table_oid, stride);
+  const auto offset = static_cast<uint32_t>(exec_ctx_->GetTxn()->StartTime().UnderlyingValue() % stride);
+
+  // The whole table and a range that starts on a block that is not sampled
+  for (const uint32_t block_start : {0U, (stride - offset) % stride + 1}) {
+    uint32_t expected = 0;
+    for (uint32_t block = block_start; block < num_blocks; block++) {
+      if ((block + offset) % stride == 0) expected += block_sizes[block];
+    }
+    EXPECT_GT(expected, 0);
+    EXPECT_EQ(expected, count_tuples(block_start, storage::DataTable::GetMaxBlocks()));
+  }
+
+  // A range without any sampled block is empty
+  const uint32_t unsampled_block = (stride - offset) % stride + 1;
+  EXPECT_EQ(0, count_tuples(unsampled_block, unsampled_block + 1));
+}
+
 // NOLINTNEXTLINE
 TEST_F(TableVectorIteratorTest, ParallelScanTest) {
   //
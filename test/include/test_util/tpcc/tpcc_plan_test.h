@@ -11,6 +11,7 @@
 
 #include "catalog/catalog_accessor.h"
 #include "main/db_main.h"
+#include "optimizer/cost_model/abstract_cost_model.h"
 #include "optimizer/optimizer.h"
 #include "parser/postgresparser.h"
 #include "planner/plannodes/abstract_plan_node.h"
@@ -29,6 +30,10 @@ class TpccPlanTest : public TerrierTest {
 
   void SetUp() override;
   void TearDown() override;
+
+  // Cost model used to optimize every statement, defaults to the TrivialCostModel
+  virtual std::unique_ptr<optimizer::AbstractCostModel> MakeCostModel();
+
   void BeginTransaction();
   void EndTransaction(bool commit);
 
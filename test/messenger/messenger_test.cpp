@@ -0,0 +1,188 @@
+#include "messenger/messenger.h"
+
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+#include "common/dedicated_thread_registry.h"
+#include "gtest/gtest.h"
+#include "messenger/connection_destination.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::messenger {
+
+class MessengerTests : public TerrierTest {
+ protected:
+  /** Ports of the two Messengers, away from the default ports of a running server. */
+  static constexpr uint16_t SERVER_PORT = 19022;
+  static constexpr uint16_t CLIENT_PORT = 19023;
+  /** How long the server loop polls when there is nothing to do, Messenger::MESSENGER_POLL_TIMER. */
+  static constexpr std::chrono::milliseconds POLL_TIMER{250};
+  /** How long a test waits for a message before it gives up. */
+  static constexpr std::chrono::seconds TIMEOUT{10};
+
+  void SetUp() override {
+    TerrierTest::SetUp();
+    server_ = std::make_unique<MessengerManager>(common::ManagedPointer(&thread_registry_), SERVER_PORT, "server");
+    client_ = std::make_unique<MessengerManager>(common::ManagedPointer(&thread_registry_), CLIENT_PORT, "client");
+    connection_ = client_->GetMessenger()->MakeConnection(Messenger::GetEndpointIPC("server", SERVER_PORT));
+  }
+
+  void TearDown() override {
+    thread_registry_.TearDown();
+    TerrierTest::TearDown();
+  }
+
+  /** @return the replies of the server's ECHO callback to the given messages, which are sent one after another */
+  std::vector<std::string> Echo(const std::vector<std::string> &messages) {
+    std::vector<std::string> replies;
+    for (const auto &message : messages) {
+      // The callback may outlive this call if the reply times out, so it owns what it writes to
+      auto reply = std::make_shared<std::promise<std::string>>();
+      client_->GetMessenger()->SendMessage(
+          connection_, message,
+          [reply](common::ManagedPointer<Messenger> /*messenger*/, const ZmqMessage &msg) {
+            reply->set_value(std::string(msg.GetMessage()));
+          },
+          Messenger::GetBuiltinCallback(Messenger::BuiltinCallback::ECHO));
+      auto future = reply->get_future();
+      if (future.wait_for(TIMEOUT) != std::future_status::ready) {
+        ADD_FAILURE() << "No reply to the message " << message;
+        break;
+      }
+      replies.emplace_back(future.get());
+    }
+    return replies;
+  }
+
+  /** @return the payload of the next message read off a raw socket, after the identity and delimiter frames */
+  static std::string RecvPayload(zmq::socket_t *socket) {
+    zmq::message_t frame;
+    for (uint8_t i = 0; i < 3; i++) {
+      if (!socket->recv(frame, zmq::recv_flags::none).has_value()) {
+        ADD_FAILURE() << "Timed out waiting for a frame.";
+        return std::string();
+      }
+    }
+    return std::string(static_cast<const char *>(frame.data()), frame.size());
+  }
+
+  /** Send a message consisting of a delimiter and the given payload over a raw socket. */
+  static void SendPayload(zmq::socket_t *socket, const std::string &payload) {
+    zmq::message_t delimiter("", 0);
+    zmq::message_t frame(payload.data(), payload.size());
+    EXPECT_TRUE(socket->send(delimiter, zmq::send_flags::sndmore).has_value());
+    EXPECT_TRUE(socket->send(frame, zmq::send_flags::none).has_value());
+  }
+
+  common::DedicatedThreadRegistry thread_registry_{DISABLED};
+  std::unique_ptr<MessengerManager> server_;
+  std::unique_ptr<MessengerManager> client_;
+  connection_id_t connection_;
+};
+
+/*
+ * Check that queued messages are sent as soon as they are queued, instead of once the server loop's poll times out.
+ */
+// NOLINTNEXTLINE
+TEST_F(MessengerTests, WakeupTest) {
+  // The first message waits for the connection to be established, which is not what is timed here
+  EXPECT_EQ(Echo({"connect"}), std::vector<std::string>{"connect"});
+
+  const std::vector<std::string> messages(10, "ping");
+  const auto start = std::chrono::steady_clock::now();
+  const auto replies = Echo(messages);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(replies, messages);
+  // Waiting for the poll timeout used to cost every round trip up to a whole POLL_TIMER
+  EXPECT_LT(elapsed, POLL_TIMER);
+}
+
+/*
+ * Check that payloads are read in place out of frames that are not null-terminated, whatever bytes they hold.
+ */
+// NOLINTNEXTLINE
+TEST_F(MessengerTests, PayloadTest) {
+  const std::vector<std::string> messages{
+      std::string(), "1234", std::string("a\0b\0", 4), "-1-2-3-", "4-5-6-message", std::string(100000, 'x')};
+  EXPECT_EQ(Echo(messages), messages);
+}
+
+/*
+ * Check that messages whose header cannot be parsed are dropped, and that the server keeps serving others.
+ */
+// NOLINTNEXTLINE
+TEST_F(MessengerTests, MalformedHeaderTest) {
+  zmq::context_t context;
+  zmq::socket_t socket(context, ZMQ_DEALER);
+  socket.set(zmq::sockopt::routing_id, "raw");
+  socket.set(zmq::sockopt::linger, 0);
+  socket.set(zmq::sockopt::rcvtimeo, static_cast<int>(std::chrono::milliseconds(TIMEOUT).count()));
+  socket.connect(Messenger::GetEndpointIPC("server", SERVER_PORT).GetDestination());
+
+  for (const auto &payload : {"", "garbage", "1-2", "1-2-3", "-1-2-3-", "1-2-99999999999999999999999-"}) {
+    SendPayload(&socket, payload);
+  }
+  const auto echo = std::to_string(Messenger::GetBuiltinCallback(Messenger::BuiltinCallback::ECHO).UnderlyingValue());
+  SendPayload(&socket, "7-0-" + echo + "-hello");
+
+  // Only the well-formed message is acknowledged and echoed
+  const auto ack = std::to_string(Messenger::GetBuiltinCallback(Messenger::BuiltinCallback::ACK).UnderlyingValue());
+  EXPECT_EQ(RecvPayload(&socket), "7-0-" + ack + "-");
+  const auto reply = RecvPayload(&socket);
+  const std::string suffix = "-0-0-hello";
+  ASSERT_GT(reply.size(), suffix.size());
+  EXPECT_EQ(reply.substr(reply.size() - suffix.size()), suffix);
+}
+
+/*
+ * Check that a message that is not acknowledged is resent from the buffer that it was built into, which every send
+ * shares instead of consuming it.
+ */
+// NOLINTNEXTLINE
+TEST_F(MessengerTests, ResendTest) {
+  // A raw ROUTER socket receives the messages but never acknowledges them
+  const auto destination = ConnectionDestination::MakeIPC("raw", "./noisepage-ipc-messenger-test");
+  zmq::context_t context;
+  zmq::socket_t socket(context, ZMQ_ROUTER);
+  socket.set(zmq::sockopt::linger, 0);
+  socket.set(zmq::sockopt::rcvtimeo, static_cast<int>(std::chrono::milliseconds(TIMEOUT).count()));
+  socket.bind(destination.GetDestination());
+
+  auto messenger = client_->GetMessenger();
+  const auto connection = messenger->MakeConnection(destination);
+  messenger->SendMessage(connection, "resend me", nullptr,
+                         Messenger::GetBuiltinCallback(Messenger::BuiltinCallback::NOOP));
+  const auto sent = RecvPayload(&socket);
+  const std::string suffix = "-resend me";
+  ASSERT_GT(sent.size(), suffix.size());
+  EXPECT_EQ(sent.substr(sent.size() - suffix.size()), suffix);
+
+  const char *buffer;
+  {
+    // Make the message due for a resend now instead of after MESSENGER_RESEND_TIMER
+    std::lock_guard lock(messenger->pending_messages_mutex_);
+    ASSERT_EQ(messenger->pending_messages_.size(), 1);
+    auto &pending = messenger->pending_messages_.begin()->second;
+    EXPECT_EQ(pending.msg_.GetRawPayload(), sent);
+    buffer = pending.msg_.GetRawPayload().data();
+    pending.last_send_time_ = 0;
+  }
+  messenger->WakeServerLoop();
+  EXPECT_EQ(RecvPayload(&socket), sent);
+
+  {
+    std::lock_guard lock(messenger->pending_messages_mutex_);
+    ASSERT_EQ(messenger->pending_messages_.size(), 1);
+    const auto &pending = messenger->pending_messages_.begin()->second;
+    EXPECT_EQ(pending.msg_.GetRawPayload().data(), buffer);
+    EXPECT_EQ(pending.msg_.GetRawPayload(), sent);
+    EXPECT_EQ(pending.msg_.GetMessage(), "resend me");
+  }
+}
+
+}  // namespace noisepage::messenger
@@ -0,0 +1,65 @@
+#include "metrics/metrics_ring_buffer.h"
+
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace noisepage::metrics {
+
+// Records are drained in order, and records pushed into a full ring are dropped and counted
+// NOLINTNEXTLINE
+TEST(MetricsRingBufferTests, DropWhenFullTest) {
+  MetricsRingBuffer<uint64_t> ring(6);
+  EXPECT_EQ(ring.Capacity(), 8);
+  EXPECT_EQ(ring.Drain([](uint64_t &&) {}), 0);
+
+  for (uint64_t i = 0; i < 10; i++) {
+    EXPECT_EQ(ring.Push(uint64_t{i}), i < 8);
+  }
+  EXPECT_EQ(ring.TakeDropped(), 2);
+  EXPECT_EQ(ring.TakeDropped(), 0);
+
+  // A limited drain frees up exactly that many slots
+  std::vector<uint64_t> drained;
+  EXPECT_EQ(ring.Drain([&drained](uint64_t &&record) { drained.push_back(record); }, 3), 3);
+  for (uint64_t i = 0; i < 4; i++) {
+    EXPECT_EQ(ring.Push(uint64_t{100 + i}), i < 3);
+  }
+  EXPECT_EQ(ring.TakeDropped(), 1);
+
+  EXPECT_EQ(ring.Drain([&drained](uint64_t &&record) { drained.push_back(record); }), 8);
+  const std::vector<uint64_t> expected = {0, 1, 2, 3, 4, 5, 6, 7, 100, 101, 102};
+  EXPECT_EQ(drained, expected);
+}
+
+// A producer and a consumer running concurrently see every record exactly once, in order, or count it as dropped
+// NOLINTNEXTLINE
+TEST(MetricsRingBufferTests, ConcurrentDrainTest) {
+  const uint64_t num_records = 1000000;
+  MetricsRingBuffer<std::vector<uint64_t>> ring(64);
+
+  std::thread producer([&ring] {
+    for (uint64_t i = 0; i < num_records; i++) ring.Push(std::vector<uint64_t>{i, i * 2});
+  });
+
+  uint64_t received = 0;
+  uint64_t dropped = 0;
+  uint64_t last = 0;
+  bool in_order = true;
+  while (received + dropped < num_records) {
+    ring.Drain([&](std::vector<uint64_t> &&record) {
+      in_order &= record.size() == 2 && record[1] == record[0] * 2 && (received == 0 || record[0] > last);
+      last = record[0];
+      received++;
+    });
+    dropped += ring.TakeDropped();
+  }
+  producer.join();
+
+  EXPECT_TRUE(in_order);
+  EXPECT_EQ(received + dropped, num_records);
+  EXPECT_EQ(ring.Drain([](std::vector<uint64_t> &&) {}), 0);
+}
+
+}  // namespace noisepage::metrics
@@ -9,6 +9,7 @@
 #include "main/db_main.h"
 #include "metrics/metrics_manager.h"
 #include "metrics/metrics_store.h"
+#include "metrics/metrics_util.h"
 #include "settings/settings_callbacks.h"
 #include "settings/settings_manager.h"
 #include "storage/sql_table.h"
@@ -440,4 +441,75 @@ TEST_F(MetricsTests, ToggleSettings) {
   EXPECT_EQ(action_context->GetState(), common::ActionState::SUCCESS);
   EXPECT_FALSE(metrics_manager_->ComponentEnabled(metrics::MetricsComponent::QUERY_TRACE));
 }
+
+/**
+ *  Testing that a periodic aggregation takes at most the aggregation limit of buffered records, and a draining one
+ *  takes the rest
+ */
+// NOLINTNEXTLINE
+TEST_F(MetricsTests, AggregationLimitTest) {
+  MetricsManager metrics_manager(8, 3);
+  metrics_manager.EnableMetric(MetricsComponent::TRANSACTION);
+  // This thread may already record into the metrics of the DBMain
+  const auto old_metrics_store = common::thread_context.metrics_store_;
+  metrics_manager.RegisterThread();
+
+  // Two of these do not fit into the buffer
+  const auto &resource_metrics = common::thread_context.resource_tracker_.GetMetrics();
+  for (uint8_t i = 0; i < 10; i++) common::thread_context.metrics_store_->RecordBeginData(resource_metrics);
+
+  metrics_manager.Aggregate();
+  const auto aggregated_data = reinterpret_cast<TransactionMetricRawData *>(
+      metrics_manager.AggregatedMetrics().at(static_cast<uint8_t>(MetricsComponent::TRANSACTION)).get());
+  ASSERT_NE(aggregated_data, nullptr);
+  EXPECT_EQ(aggregated_data->begin_data_.size(), 3);
+  EXPECT_EQ(metrics_manager.DroppedRecords(MetricsComponent::TRANSACTION), 2);
+
+  metrics_manager.Aggregate();
+  EXPECT_EQ(aggregated_data->begin_data_.size(), 6);
+
+  metrics_manager.Aggregate(true);
+  EXPECT_EQ(aggregated_data->begin_data_.size(), 8);
+
+  metrics_manager.UnregisterThread();
+  common::thread_context.metrics_store_ = old_metrics_store;
+}
+
+/**
+ *  Testing that the output settings accept exactly the outputs that each component can write
+ */
+// NOLINTNEXTLINE
+TEST_F(MetricsTests, OutputStringTest) {
+  for (const auto component : {MetricsComponent::EXECUTION_PIPELINE, MetricsComponent::QUERY_TRACE}) {
+    EXPECT_EQ(MetricsUtil::FromMetricsOutputString(component, "NONE"), MetricsOutput::NONE);
+    EXPECT_EQ(MetricsUtil::FromMetricsOutputString(component, "CSV"), MetricsOutput::CSV);
+    EXPECT_EQ(MetricsUtil::FromMetricsOutputString(component, "csv"), std::nullopt);
+  }
+
+  // Pipeline metrics have no internal tables
+  EXPECT_EQ(MetricsUtil::FromMetricsOutputString(MetricsComponent::EXECUTION_PIPELINE, "BINARY"),
+            MetricsOutput::BINARY);
+  EXPECT_EQ(MetricsUtil::FromMetricsOutputString(MetricsComponent::EXECUTION_PIPELINE, "DB"), std::nullopt);
+  EXPECT_EQ(MetricsUtil::FromMetricsOutputString(MetricsComponent::EXECUTION_PIPELINE, "CSV_AND_DB"), std::nullopt);
+
+  // Query traces have no binary format
+  EXPECT_EQ(MetricsUtil::FromMetricsOutputString(MetricsComponent::QUERY_TRACE, "DB"), MetricsOutput::DB);
+  EXPECT_EQ(MetricsUtil::FromMetricsOutputString(MetricsComponent::QUERY_TRACE, "CSV_AND_DB"),
+            MetricsOutput::CSV_AND_DB);
+  EXPECT_EQ(MetricsUtil::FromMetricsOutputString(MetricsComponent::QUERY_TRACE, "BINARY"), std::nullopt);
+
+  // The settings reject the outputs that the component cannot write
+  auto action_context = std::make_unique<common::ActionContext>(common::action_id_t(1));
+  EXPECT_THROW(settings_manager_->SetString(settings::Param::pipeline_metrics_output, "DB",
+                                            common::ManagedPointer(action_context), EmptySetterCallback),
+               SettingsException);
+  EXPECT_EQ(action_context->GetState(), common::ActionState::FAILURE);
+  EXPECT_EQ(metrics_manager_->GetMetricOutput(MetricsComponent::EXECUTION_PIPELINE), MetricsOutput::CSV);
+
+  action_context = std::make_unique<common::ActionContext>(common::action_id_t(2));
+  settings_manager_->SetString(settings::Param::pipeline_metrics_output, "NONE", common::ManagedPointer(action_context),
+                               EmptySetterCallback);
+  EXPECT_EQ(action_context->GetState(), common::ActionState::SUCCESS);
+  EXPECT_EQ(metrics_manager_->GetMetricOutput(MetricsComponent::EXECUTION_PIPELINE), MetricsOutput::NONE);
+}
 }  // namespace noisepage::metrics
@@ -1,3 +1,4 @@
+#include <chrono>  // NOLINT
 #include <cstring>
 #include <memory>
 #include <pqxx/pqxx>  // NOLINT
@@ -11,6 +12,7 @@
 #include "common/settings.h"
 #include "gtest/gtest.h"
 #include "network/connection_handle_factory.h"
+#include "network/execution_worker_pool.h"
 #include "network/noisepage_server.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
 #include "storage/garbage_collector.h"
@@ -48,12 +50,15 @@ class NetworkTests : public TerrierTest {
   transaction::TransactionManager *txn_manager_;
 
   storage::GarbageCollector *gc_;
+  std::unique_ptr<ExecutionWorkerPool> execution_pool_;
   std::unique_ptr<TerrierServer> server_;
   std::unique_ptr<ConnectionHandleFactory> handle_factory_;
   common::DedicatedThreadRegistry thread_registry_ = common::DedicatedThreadRegistry(DISABLED);
   uint16_t port_ = 15721;
   std::string socket_directory_ = "/tmp/";
   uint16_t connection_thread_count_ = 4;
+  uint16_t acceptor_count_ = 1;
+  uint16_t execution_thread_count_ = 0;
   FakeCommandFactory fake_command_factory_;
   PostgresProtocolInterpreter::Provider protocol_provider_{
       common::ManagedPointer<PostgresCommandFactory>(&fake_command_factory_)};
@@ -72,7 +77,8 @@ class NetworkTests : public TerrierTest {
                                     common::ManagedPointer(gc_));
 
     tcop_ = new trafficcop::TrafficCop(common::ManagedPointer(txn_manager_), common::ManagedPointer(catalog_), DISABLED,
-                                       DISABLED, DISABLED, DISABLED, 0, false, execution::vm::ExecutionMode::Interpret);
+                                       DISABLED, DISABLED, DISABLED, 0, 1, false,
+                                       execution::vm::ExecutionMode::Interpret);
 
     auto txn = txn_manager_->BeginTransaction();
     catalog_->CreateDatabase(common::ManagedPointer(txn), catalog::DEFAULT_DATABASE, true);
@@ -84,11 +90,13 @@ class NetworkTests : public TerrierTest {
 #endif
 
     try {
-      handle_factory_ = std::make_unique<ConnectionHandleFactory>(common::ManagedPointer(tcop_));
+      execution_pool_ = std::make_unique<ExecutionWorkerPool>(execution_thread_count_, 64, DISABLED);
+      handle_factory_ = std::make_unique<ConnectionHandleFactory>(common::ManagedPointer(tcop_),
+                                                                  common::ManagedPointer(execution_pool_));
       server_ = std::make_unique<TerrierServer>(
           common::ManagedPointer<ProtocolInterpreterProvider>(&protocol_provider_),
           common::ManagedPointer(handle_factory_.get()), common::ManagedPointer(&thread_registry_), port_,
-          connection_thread_count_, socket_directory_);
+          connection_thread_count_, socket_directory_, acceptor_count_, common::ManagedPointer(execution_pool_));
       server_->RunServer();
     } catch (NetworkProcessException &exception) {
       NETWORK_LOG_ERROR("[LaunchServer] exception when launching server");
@@ -312,6 +320,24 @@ TEST_F(NetworkTests, MultipleConnectionTest) {
   }
 }
 
+/**
+ * Connects and disconnects one client after the other, which should keep reusing the handles of closed connections
+ * instead of creating a new one per connection.
+ */
+// NOLINTNEXTLINE
+TEST_F(NetworkTests, ConnectionReuseTest) {
+  const size_t num_connections = connection_thread_count_ * 5;
+  for (size_t i = 0; i < num_connections; i++) {
+    auto io_socket = network::ManualPacketUtil::StartConnection(port_);
+    ASSERT_NE(io_socket, nullptr);
+    ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+    // Wait for the server to close the connection
+    EXPECT_FALSE(ManualPacketUtil::ReadUntilReadyOrClose(common::ManagedPointer(io_socket)));
+    io_socket->Close();
+  }
+  EXPECT_LT(handle_factory_->NumConnectionHandles(), num_connections);
+}
+
 /**
  * This is meant to overload the network layer with multiple concurrent client threads. It was made to uncover
  * a bug where ConnectionHandlerTask had a few race conditions amongst its fields. Two threads using the same
@@ -377,7 +403,7 @@ TEST_F(NetworkTests, GusThesisSaver) {
     auto io_socket = common::ManagedPointer(io_socket_unique_ptr);
     PostgresPacketWriter writer(io_socket->GetWriteQueue());
 
-    // Create a large packet that will require the InputPacket to be extended
+    // Create a large packet that will require the read buffer to grow
     std::string big_query;
     for (uint32_t i = 0; i < 1000; i++) {
       big_query.append("SELECT A FROM B;");
@@ -401,4 +427,122 @@ TEST_F(NetworkTests, GusThesisSaver) {
   NETWORK_LOG_INFO("[GusThesisSaver] Completed");
 }
 
+/** Runs the same traffic as the tests above, but with queries executed on an ExecutionWorkerPool. */
+class NetworkExecutionPoolTests : public NetworkTests {
+ protected:
+  void SetUp() override {
+    // Fewer workers than handler threads, so that connections of different handlers share workers.
+    execution_thread_count_ = 2;
+    NetworkTests::SetUp();
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(NetworkExecutionPoolTests, SimpleQueryTest) {
+  try {
+    pqxx::connection c(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql", port_,
+                                   catalog::DEFAULT_DATABASE));
+
+    pqxx::work txn1(c);
+    txn1.exec("INSERT INTO employee VALUES (1, 'Han LI');");
+    txn1.exec("INSERT INTO employee VALUES (2, 'Shaokun ZOU');");
+
+    pqxx::result r = txn1.exec("SELECT name FROM employee where id=1;");
+    txn1.commit();
+    EXPECT_EQ(r.size(), 0);
+  } catch (const std::exception &e) {
+    NETWORK_LOG_ERROR("[SimpleQueryTest] Exception occurred: {0}", e.what());
+    EXPECT_TRUE(false);
+  }
+
+  // Closing the connection sends a Terminate packet that the pool processes asynchronously, and a worker only retires
+  // its task after waking up the connection. Wait for the pool to quiesce rather than sampling it once.
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (execution_pool_->NumPending() != 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(execution_pool_->NumPending(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(NetworkExecutionPoolTests, PgNetworkCommandsTest) {
+  try {
+    TestExtendedQuery(port_);
+  } catch (const std::exception &e) {
+    NETWORK_LOG_ERROR("[PgNetworkCommandsTest] Exception occurred: {0}", e.what());
+    EXPECT_TRUE(false);
+  }
+}
+
+/** More concurrent clients than workers, each issuing several queries, must all be served. */
+// NOLINTNEXTLINE
+TEST_F(NetworkExecutionPoolTests, ConcurrentClientsTest) {
+  const size_t num_clients = connection_thread_count_ * 2ul;
+  std::atomic_int successes = 0;
+  std::vector<std::thread> threads;
+  threads.reserve(num_clients);
+  for (size_t i = 0; i < num_clients; i++) {
+    threads.emplace_back([this, &successes] {
+      try {
+        pqxx::connection c(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                       port_, catalog::DEFAULT_DATABASE));
+        pqxx::work txn(c);
+        for (uint32_t q = 0; q < 10; q++) txn.exec("SELECT name FROM employee where id=1;");
+        txn.commit();
+        successes++;
+      } catch (const std::exception &e) {
+        NETWORK_LOG_ERROR("[ConcurrentClientsTest] Exception occurred: {0}", e.what());
+      }
+    });
+  }
+  for (auto &t : threads) t.join();
+  EXPECT_EQ(successes, num_clients);
+}
+
+/** Runs the traffic with several acceptors, each with a networked socket of its own and a share of the handlers. */
+class NetworkMultipleAcceptorTests : public NetworkTests {
+ protected:
+  void SetUp() override {
+    acceptor_count_ = 3;
+    NetworkTests::SetUp();
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(NetworkMultipleAcceptorTests, PgNetworkCommandsTest) {
+  EXPECT_EQ(server_->GetAcceptorCount(), 3);
+  try {
+    TestExtendedQuery(port_);
+  } catch (const std::exception &e) {
+    NETWORK_LOG_ERROR("[PgNetworkCommandsTest] Exception occurred: {0}", e.what());
+    EXPECT_TRUE(false);
+  }
+}
+
+/** A burst of clients connecting at once over both kinds of sockets must all be served. */
+// NOLINTNEXTLINE
+TEST_F(NetworkMultipleAcceptorTests, ConnectionStormTest) {
+  const size_t num_clients = 32;
+  std::atomic_int successes = 0;
+  std::vector<std::thread> threads;
+  threads.reserve(num_clients);
+  for (size_t i = 0; i < num_clients; i++) {
+    const std::string host = i % 2 == 0 ? "127.0.0.1" : socket_directory_;
+    threads.emplace_back([this, host, &successes] {
+      try {
+        pqxx::connection c(fmt::format("host={0} port={1} user={2} sslmode=disable application_name=psql", host,
+                                       port_, catalog::DEFAULT_DATABASE));
+        pqxx::work txn(c);
+        txn.exec("SELECT name FROM employee where id=1;");
+        txn.commit();
+        successes++;
+      } catch (const std::exception &e) {
+        NETWORK_LOG_ERROR("[ConnectionStormTest] Exception occurred: {0}", e.what());
+      }
+    });
+  }
+  for (auto &t : threads) t.join();
+  EXPECT_EQ(successes, num_clients);
+}
+
 }  // namespace noisepage::network
@@ -0,0 +1,141 @@
+#include "network/postgres/portal_execution.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "network/execution_worker_pool.h"
+#include "network/network_io_utils.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::network {
+
+class PortalExecutionTests : public TerrierTest {
+ protected:
+  /** @return runner that writes num_rows rows in batches of batch_size, and the number of rows it wrote */
+  static PortalExecution::Runner Runner(const uint32_t num_rows, const uint32_t batch_size) {
+    return [=](common::ManagedPointer<PostgresPacketWriter> /*writer*/,
+               common::ManagedPointer<PortalExecution> execution) {
+      uint32_t written = 0;
+      while (written < num_rows) {
+        const auto allowed = execution->AwaitRows(std::min(batch_size, num_rows - written));
+        if (allowed == 0) break;
+        written += allowed;
+      }
+      return trafficcop::TrafficCopResult{trafficcop::ResultType::COMPLETE, written};
+    };
+  }
+
+  /** Fetches the rows of a query with 10 rows in three Execute messages */
+  static void CheckFetches(const common::ManagedPointer<ExecutionWorkerPool> execution_pool) {
+    WriteQueue write_queue;
+    PortalExecution execution(common::ManagedPointer<WriteQueue>(&write_queue), Runner(10, 3), execution_pool);
+
+    uint32_t num_rows;
+    EXPECT_FALSE(execution.Fetch(4, &num_rows).has_value());
+    EXPECT_EQ(num_rows, 4);
+    EXPECT_FALSE(execution.Fetch(4, &num_rows).has_value());
+    EXPECT_EQ(num_rows, 4);
+
+    const auto result = execution.Fetch(0, &num_rows);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->type_, trafficcop::ResultType::COMPLETE);
+    EXPECT_EQ(std::get<uint32_t>(result->extra_), 10);
+    EXPECT_EQ(num_rows, 2);
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(PortalExecutionTests, FetchTest) {
+  // Without execution threads, the pool still runs the queries of portals
+  ExecutionWorkerPool execution_pool(0, 1, DISABLED);
+  CheckFetches(common::ManagedPointer(&execution_pool));
+  EXPECT_EQ(execution_pool.NumBlockingWorkers(), 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PortalExecutionTests, FetchOnPoolTest) {
+  ExecutionWorkerPool execution_pool(1, 2, DISABLED);
+  // The query of a second portal has to run while the first one is suspended, even though the pool has one worker
+  WriteQueue write_queue;
+  PortalExecution suspended(common::ManagedPointer<WriteQueue>(&write_queue), Runner(10, 3),
+                            common::ManagedPointer(&execution_pool));
+  uint32_t num_rows;
+  EXPECT_FALSE(suspended.Fetch(1, &num_rows).has_value());
+  EXPECT_EQ(execution_pool.NumBlocking(), 1);
+
+  CheckFetches(common::ManagedPointer(&execution_pool));
+  suspended.Close();
+  EXPECT_EQ(execution_pool.NumBlocking(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PortalExecutionTests, CloseTest) {
+  ExecutionWorkerPool execution_pool(1, 1, DISABLED);
+  WriteQueue write_queue;
+  PortalExecution execution(common::ManagedPointer<WriteQueue>(&write_queue), Runner(10, 3),
+                            common::ManagedPointer(&execution_pool));
+
+  uint32_t num_rows;
+  EXPECT_FALSE(execution.Fetch(5, &num_rows).has_value());
+  execution.Close();
+  EXPECT_TRUE(execution.IsClosed());
+  EXPECT_EQ(execution_pool.NumBlocking(), 0);
+
+  // A closed portal cannot be fetched from anymore
+  const auto result = execution.Fetch(0, &num_rows);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->type_, trafficcop::ResultType::ERROR);
+  EXPECT_EQ(num_rows, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PortalExecutionTests, ShutdownTest) {
+  ExecutionWorkerPool execution_pool(1, 1, DISABLED);
+  WriteQueue write_queue;
+  PortalExecution execution(common::ManagedPointer<WriteQueue>(&write_queue), Runner(10, 3),
+                            common::ManagedPointer(&execution_pool));
+
+  uint32_t num_rows;
+  EXPECT_FALSE(execution.Fetch(5, &num_rows).has_value());
+
+  // Shutting down does not wait for the client to fetch the rest, the suspended query is stopped instead
+  execution_pool.Shutdown();
+  EXPECT_TRUE(execution.IsClosed());
+  EXPECT_EQ(execution_pool.NumBlocking(), 0);
+
+  // Once the pool is shut down, the query of a new portal fails to start
+  PortalExecution late(common::ManagedPointer<WriteQueue>(&write_queue), Runner(10, 3),
+                       common::ManagedPointer(&execution_pool));
+  const auto result = late.Fetch(5, &num_rows);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->type_, trafficcop::ResultType::ERROR);
+  EXPECT_EQ(num_rows, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PortalExecutionTests, BlockingThreadLimitTest) {
+  ExecutionWorkerPool execution_pool(1, 1, DISABLED);
+  WriteQueue write_queue;
+  PortalExecution suspended(common::ManagedPointer<WriteQueue>(&write_queue), Runner(10, 3),
+                            common::ManagedPointer(&execution_pool));
+  uint32_t num_rows;
+  EXPECT_FALSE(suspended.Fetch(1, &num_rows).has_value());
+
+  // The only thread for blocking tasks is taken by the suspended query, so another portal cannot start its query
+  PortalExecution refused(common::ManagedPointer<WriteQueue>(&write_queue), Runner(10, 3),
+                          common::ManagedPointer(&execution_pool));
+  const auto result = refused.Fetch(5, &num_rows);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->type_, trafficcop::ResultType::ERROR);
+  EXPECT_EQ(std::get<common::ErrorData>(result->extra_).GetCode(),
+            common::ErrorCode::ERRCODE_CONFIGURATION_LIMIT_EXCEEDED);
+  EXPECT_EQ(execution_pool.NumBlocking(), 1);
+
+  // Once the suspended query stopped, its thread runs the next one
+  suspended.Close();
+  CheckFetches(common::ManagedPointer(&execution_pool));
+  EXPECT_EQ(execution_pool.NumBlockingWorkers(), 1);
+}
+
+}  // namespace noisepage::network
@@ -0,0 +1,78 @@
+#include "network/postgres/postgres_binary_formatter.h"
+
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/error/exception.h"
+#include "gtest/gtest.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::network {
+
+class PostgresBinaryFormatterTests : public TerrierTest {
+ protected:
+  /** Binary form of a NUMERIC from its header fields and base-10000 digits */
+  static std::string Numeric(const int16_t num_digits, const int16_t weight, const uint16_t sign, const int16_t dscale,
+                             const std::vector<uint16_t> &digits) {
+    std::string bytes;
+    const auto append = [&bytes](const uint16_t value) {
+      bytes += static_cast<char>(value >> 8);
+      bytes += static_cast<char>(value & 0xFF);
+    };
+    append(static_cast<uint16_t>(num_digits));
+    append(static_cast<uint16_t>(weight));
+    append(sign);
+    append(static_cast<uint16_t>(dscale));
+    for (const auto digit : digits) append(digit);
+    return bytes;
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(PostgresBinaryFormatterTests, DateTest) {
+  // Postgres counts days from 2000-01-01
+  EXPECT_EQ(PostgresBinaryFormatter::DateToPostgres(execution::sql::Date::FromYMD(2000, 1, 1)), 0);
+  EXPECT_EQ(PostgresBinaryFormatter::DateToPostgres(execution::sql::Date::FromYMD(1999, 12, 31)), -1);
+  EXPECT_EQ(PostgresBinaryFormatter::DateToPostgres(execution::sql::Date::FromYMD(2020, 3, 1)), 7365);
+  for (const auto &date : {execution::sql::Date::FromYMD(1970, 1, 1), execution::sql::Date::FromYMD(2024, 2, 29)}) {
+    EXPECT_EQ(PostgresBinaryFormatter::DateFromPostgres(PostgresBinaryFormatter::DateToPostgres(date)), date);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(PostgresBinaryFormatterTests, TimestampTest) {
+  // Postgres counts microseconds from 2000-01-01 00:00:00
+  EXPECT_EQ(PostgresBinaryFormatter::TimestampToPostgres(execution::sql::Timestamp::FromYMDHMS(2000, 1, 1, 0, 0, 0)),
+            0);
+  EXPECT_EQ(PostgresBinaryFormatter::TimestampToPostgres(execution::sql::Timestamp::FromYMDHMS(2000, 1, 1, 0, 0, 1)),
+            1000000);
+  EXPECT_EQ(
+      PostgresBinaryFormatter::TimestampToPostgres(execution::sql::Timestamp::FromYMDHMS(1999, 12, 31, 23, 59, 59)),
+      -1000000);
+  const auto timestamp = execution::sql::Timestamp::FromYMDHMSMU(2021, 6, 15, 12, 34, 56, 789, 123);
+  EXPECT_EQ(PostgresBinaryFormatter::TimestampFromPostgres(PostgresBinaryFormatter::TimestampToPostgres(timestamp)),
+            timestamp);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PostgresBinaryFormatterTests, NumericTest) {
+  // The layout that numeric_send() in Postgres produces for integers
+  EXPECT_EQ(PostgresBinaryFormatter::ParseNumeric(Numeric(0, 0, 0x0000, 0, {})), 0);
+  EXPECT_EQ(PostgresBinaryFormatter::ParseNumeric(Numeric(1, 0, 0x0000, 0, {1})), 1);
+  EXPECT_EQ(PostgresBinaryFormatter::ParseNumeric(Numeric(3, 2, 0x4000, 0, {1, 2345, 6789})), -123456789);
+  EXPECT_EQ(PostgresBinaryFormatter::ParseNumeric(Numeric(1, 2, 0x0000, 0, {1})), 100000000);
+
+  // Fractions, which clients send for NUMERIC parameters
+  EXPECT_EQ(PostgresBinaryFormatter::ParseNumeric(Numeric(1, -1, 0x0000, 1, {1000})), 0.1);
+  EXPECT_EQ(PostgresBinaryFormatter::ParseNumeric(Numeric(2, 0, 0x4000, 2, {3, 1400})), -3.14);
+  EXPECT_TRUE(std::isnan(PostgresBinaryFormatter::ParseNumeric(Numeric(0, 0, 0xC000, 0, {}))));
+
+  EXPECT_THROW(PostgresBinaryFormatter::ParseNumeric(std::string_view("\0\1", 2)), NetworkProcessException);
+  EXPECT_THROW(PostgresBinaryFormatter::ParseNumeric(Numeric(2, 0, 0x0000, 0, {1})), NetworkProcessException);
+  EXPECT_THROW(PostgresBinaryFormatter::ParseNumeric(Numeric(1, 0, 0x0000, 0, {10000})), NetworkProcessException);
+  EXPECT_THROW(PostgresBinaryFormatter::ParseNumeric(Numeric(1, 0, 0x1234, 0, {1})), NetworkProcessException);
+}
+
+}  // namespace noisepage::network
@@ -0,0 +1,145 @@
+#include "network/postgres/postgres_copy_reader.h"
+
+#include <arpa/inet.h>
+
+#include <string>
+#include <vector>
+
+#include "common/error/exception.h"
+#include "gtest/gtest.h"
+#include "network/postgres/postgres_defs.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::network {
+
+class PostgresCopyReaderTests : public TerrierTest {
+ protected:
+  /** Render decoded rows as text, one string per row with the values separated by | */
+  static std::vector<std::string> Render(const std::vector<PostgresCopyReader::Row> &rows) {
+    std::vector<std::string> rendered;
+    for (const auto &row : rows) {
+      std::string line;
+      for (const auto &value : row) {
+        if (!line.empty()) line += '|';
+        if (value.IsNull()) {
+          line += "NULL";
+          continue;
+        }
+        switch (value.GetReturnValueType()) {
+          case type::TypeId::BOOLEAN:
+            line += value.Peek<bool>() ? "true" : "false";
+            break;
+          case type::TypeId::INTEGER:
+            line += std::to_string(value.Peek<int32_t>());
+            break;
+          case type::TypeId::VARCHAR:
+            line += value.Peek<std::string_view>();
+            break;
+          default:
+            ADD_FAILURE() << "Unexpected type.";
+        }
+      }
+      rendered.emplace_back(std::move(line));
+    }
+    return rendered;
+  }
+
+  /**
+   * Decode the data split into two CopyData messages at every possible position, which has to give the same rows
+   * every time.
+   */
+  static void CheckEverySplit(const CopyFormat &format, const std::string &data,
+                              const std::vector<std::string> &expected) {
+    for (size_t split = 0; split <= data.size(); split++) {
+      PostgresCopyReader reader(format, COLUMN_TYPES);
+      std::vector<PostgresCopyReader::Row> rows;
+      reader.Consume(std::string_view(data).substr(0, split), &rows);
+      reader.Consume(std::string_view(data).substr(split), &rows);
+      reader.Finish(&rows);
+      EXPECT_EQ(Render(rows), expected) << "split at " << split;
+    }
+  }
+
+  static std::vector<std::string> Decode(const CopyFormat &format, const std::string &data) {
+    PostgresCopyReader reader(format, COLUMN_TYPES);
+    std::vector<PostgresCopyReader::Row> rows;
+    reader.Consume(data, &rows);
+    reader.Finish(&rows);
+    return Render(rows);
+  }
+
+  static inline const std::vector<type::TypeId> COLUMN_TYPES = {type::TypeId::INTEGER, type::TypeId::VARCHAR,
+                                                                 type::TypeId::BOOLEAN};
+  static constexpr CopyFormat TEXT_FORMAT{parser::ExternalFileFormat::TEXT, '\t', '"', '"'};
+  static constexpr CopyFormat CSV_FORMAT{parser::ExternalFileFormat::CSV, ',', '"', '"'};
+  static constexpr CopyFormat BINARY_FORMAT{parser::ExternalFileFormat::BINARY, ',', '"', '"'};
+};
+
+// NOLINTNEXTLINE
+TEST_F(PostgresCopyReaderTests, TextTest) {
+  // Escapes, \N for NULL, a \r\n line ending, and data after the end-of-data marker that has to be ignored
+  const std::string data = "1\tone\tt\n2\ttab\\there\\n\\101\\x42\tOFF\r\n3\t\\N\t\\N\n-4\t\tyes\n\\.\nignored";
+  CheckEverySplit(TEXT_FORMAT, data, {"1|one|true", "2|tab\there\nAB|false", "3|NULL|NULL", "-4||true"});
+
+  // The last line does not need a line ending
+  EXPECT_EQ(Decode(TEXT_FORMAT, "5\tfive\tf"), std::vector<std::string>({"5|five|false"}));
+}
+
+// NOLINTNEXTLINE
+TEST_F(PostgresCopyReaderTests, CsvTest) {
+  // Quoted delimiters, doubled quotes, line breaks in quotes, and the difference between NULL and ""
+  const std::string data = "1,\"a,b\",t\r\n2,\"say \"\"hi\"\"\",f\n3,,\n4,\"\",true\n5,\"multi\nline\",f";
+  CheckEverySplit(CSV_FORMAT, data,
+                  {"1|a,b|true", "2|say \"hi\"|false", "3|NULL|NULL", "4||true", "5|multi\nline|false"});
+
+  // An escape character that differs from the quote character
+  const CopyFormat backslash_escape{parser::ExternalFileFormat::CSV, ',', '"', '\\'};
+  EXPECT_EQ(Decode(backslash_escape, "6,\"x\\\"y\\\\z\",t\n\\.\n"), std::vector<std::string>({"6|x\"y\\z|true"}));
+}
+
+// NOLINTNEXTLINE
+TEST_F(PostgresCopyReaderTests, BinaryTest) {
+  std::string data(POSTGRES_COPY_BINARY_SIGNATURE);
+  const auto append_int16 = [&data](const int16_t value) {
+    const auto raw = htons(static_cast<uint16_t>(value));
+    data.append(reinterpret_cast<const char *>(&raw), sizeof(raw));
+  };
+  const auto append_int32 = [&data](const int32_t value) {
+    const auto raw = htonl(static_cast<uint32_t>(value));
+    data.append(reinterpret_cast<const char *>(&raw), sizeof(raw));
+  };
+  // Flags, then a header extension that has to be skipped
+  append_int32(0);
+  append_int32(3);
+  data += "ext";
+
+  append_int16(3);
+  append_int32(4);
+  append_int32(-7);
+  append_int32(5);
+  data += "seven";
+  append_int32(1);
+  data += '\1';
+
+  append_int16(3);
+  append_int32(4);
+  append_int32(8);
+  append_int32(-1);
+  append_int32(-1);
+
+  append_int16(-1);
+  CheckEverySplit(BINARY_FORMAT, data, {"-7|seven|true", "8|NULL|NULL"});
+}
+
+// NOLINTNEXTLINE
+TEST_F(PostgresCopyReaderTests, ErrorTest) {
+  EXPECT_THROW(Decode(TEXT_FORMAT, "1\tone\n"), NetworkProcessException);
+  EXPECT_THROW(Decode(TEXT_FORMAT, "1\tone\tt\textra\n"), NetworkProcessException);
+  EXPECT_THROW(Decode(TEXT_FORMAT, "one\tone\tt\n"), ConversionException);
+  EXPECT_THROW(Decode(TEXT_FORMAT, "1\tone\tmaybe\n"), ConversionException);
+  EXPECT_THROW(Decode(CSV_FORMAT, "1,\"unterminated,t\n"), NetworkProcessException);
+  EXPECT_THROW(Decode(BINARY_FORMAT, "PGCOPY\n"), NetworkProcessException);
+  EXPECT_THROW(Decode(BINARY_FORMAT, "not a binary COPY header"), NetworkProcessException);
+}
+
+}  // namespace noisepage::network
@@ -0,0 +1,78 @@
+#include "network/postgres/postgres_text_formatter.h"
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "spdlog/fmt/fmt.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::network {
+
+class PostgresTextFormatterTests : public TerrierTest {};
+
+// NOLINTNEXTLINE
+TEST_F(PostgresTextFormatterTests, IntegerTest) {
+  // The formatter has to produce exactly what std::to_string used to send to clients
+  std::vector<int64_t> values = {0, 1, -1, 9, 10, -10, 99, 100, -100, 999, 1000, 9999, 10000, 999999, 100000000};
+  values.emplace_back(std::numeric_limits<int32_t>::min());
+  values.emplace_back(std::numeric_limits<int64_t>::min());
+  values.emplace_back(std::numeric_limits<int64_t>::max());
+  std::default_random_engine generator;
+  std::uniform_int_distribution<int64_t> distribution(std::numeric_limits<int64_t>::min(),
+                                                      std::numeric_limits<int64_t>::max());
+  for (uint32_t i = 0; i < 10000; i++) {
+    // Shift to cover every number of digits, not just the 18 and 19 digit numbers that dominate the distribution
+    values.emplace_back(distribution(generator) >> (i % 64));
+  }
+
+  char buf[PostgresTextFormatter::MAX_TEXT_LENGTH];
+  for (const auto value : values) {
+    char *const end = PostgresTextFormatter::FormatInteger(value, buf);
+    EXPECT_EQ(std::to_string(value), std::string(buf, end));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(PostgresTextFormatterTests, RealTest) {
+  const std::vector<double> values = {0.0,
+                                      -0.0,
+                                      1.0,
+                                      -1.5,
+                                      0.1,
+                                      3.141592653589793,
+                                      1e20,
+                                      1e-7,
+                                      std::numeric_limits<double>::max(),
+                                      std::numeric_limits<double>::lowest(),
+                                      std::numeric_limits<double>::denorm_min()};
+  char buf[PostgresTextFormatter::MAX_TEXT_LENGTH];
+  for (const auto value : values) {
+    char *const end = PostgresTextFormatter::FormatReal(value, buf);
+    EXPECT_EQ(fmt::to_string(value), std::string(buf, end));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(PostgresTextFormatterTests, DateTimestampTest) {
+  std::default_random_engine generator;
+  std::uniform_int_distribution<int32_t> year(1, 9999), month(1, 12), day(1, 28), hour(0, 23), minute(0, 59),
+      milli(0, 999);
+  char buf[PostgresTextFormatter::MAX_TEXT_LENGTH];
+  for (uint32_t i = 0; i < 1000; i++) {
+    const auto date = execution::sql::Date::FromYMD(year(generator), month(generator), day(generator));
+    char *end = PostgresTextFormatter::FormatDate(date, buf);
+    EXPECT_EQ(date.ToString(), std::string(buf, end));
+
+    const auto timestamp = execution::sql::Timestamp::FromYMDHMSMU(year(generator), month(generator), day(generator),
+                                                                   hour(generator), minute(generator),
+                                                                   minute(generator), milli(generator),
+                                                                   milli(generator));
+    end = PostgresTextFormatter::FormatTimestamp(timestamp, buf);
+    EXPECT_EQ(timestamp.ToString(), std::string(buf, end));
+  }
+}
+
+}  // namespace noisepage::network
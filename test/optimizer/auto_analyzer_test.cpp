@@ -0,0 +1,114 @@
+#include "optimizer/statistics/auto_analyzer.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "catalog/catalog.h"
+#include "catalog/catalog_accessor.h"
+#include "common/future.h"
+#include "main/db_main.h"
+#include "optimizer/cost_model/trivial_cost_model.h"
+#include "task/task.h"
+#include "task/task_manager.h"
+#include "test_util/test_harness.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage::optimizer {
+
+class AutoAnalyzerTests : public TerrierTest {
+ public:
+  /** Number of modifications after which a table is analyzed */
+  static constexpr uint64_t THRESHOLD = 5;
+
+  void SetUp() final {
+    std::unordered_map<settings::Param, settings::ParamInfo> param_map;
+    settings::SettingsManager::ConstructParamMap(param_map);
+
+    db_main_ = noisepage::DBMain::Builder()
+                   .SetSettingsParameterMap(std::move(param_map))
+                   .SetUseSettingsManager(true)
+                   .SetUseGC(true)
+                   .SetUseCatalog(true)
+                   .SetUseGCThread(true)
+                   .SetUseTrafficCop(true)
+                   .SetUseStatsStorage(true)
+                   .SetUseLogging(true)
+                   .SetUseNetwork(true)
+                   .SetUseExecution(true)
+                   .Build();
+
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    stats_storage_ = db_main_->GetStatsStorage();
+    task_manager_ = db_main_->GetTaskManager();
+    auto_analyzer_ =
+        std::make_unique<AutoAnalyzer>(catalog_, txn_manager_, stats_storage_, task_manager_, THRESHOLD, 0.0);
+
+    auto *txn = txn_manager_->BeginTransaction();
+    db_oid_ = catalog_->GetDatabaseOid(common::ManagedPointer(txn), catalog::DEFAULT_DATABASE);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    task_manager_->AddTask(std::make_unique<task::TaskDDL>(db_oid_, "CREATE TABLE t (a INT)", nullptr));
+    task_manager_->WaitForFlush();
+  }
+
+  void InsertRows(uint32_t num_rows) {
+    std::string query = "INSERT INTO t VALUES ";
+    for (uint32_t i = 0; i < num_rows; i++) query += (i == 0 ? "(" : ", (") + std::to_string(i) + ")";
+    common::Future<task::DummyResult> sync;
+    task_manager_->AddTask(std::make_unique<task::TaskDML>(
+        db_oid_, query, std::make_unique<optimizer::TrivialCostModel>(), true, nullptr, common::ManagedPointer(&sync)));
+    ASSERT_TRUE(sync.DangerousWait().second);
+  }
+
+  /** @return number of rows of t according to the statistics in StatsStorage, loading them if they are not cached */
+  size_t GetStatsNumRows() {
+    auto *txn = txn_manager_->BeginTransaction();
+    auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_oid_, DISABLED);
+    const auto num_rows =
+        stats_storage_->GetTableStats(db_oid_, accessor->GetTableOid("t"), accessor.get()).table_stats_.GetNumRows();
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    return num_rows;
+  }
+
+ protected:
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<catalog::Catalog> catalog_;
+  common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  common::ManagedPointer<StatsStorage> stats_storage_;
+  common::ManagedPointer<task::TaskManager> task_manager_;
+  std::unique_ptr<AutoAnalyzer> auto_analyzer_;
+  catalog::db_oid_t db_oid_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(AutoAnalyzerTests, IgnoresUncachedTables) {
+  InsertRows(2 * THRESHOLD);
+  EXPECT_EQ(auto_analyzer_->PerformAutoAnalyze(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AutoAnalyzerTests, BaselineStartsAtFirstSighting) {
+  // Modifications made before the AutoAnalyzer first sees the table do not trigger an ANALYZE
+  InsertRows(2 * THRESHOLD);
+  EXPECT_EQ(GetStatsNumRows(), 0);
+  EXPECT_EQ(auto_analyzer_->PerformAutoAnalyze(), 0);
+
+  // Stay below the threshold
+  InsertRows(THRESHOLD - 1);
+  EXPECT_EQ(auto_analyzer_->PerformAutoAnalyze(), 0);
+  EXPECT_EQ(GetStatsNumRows(), 0);
+
+  // Reach the threshold, which analyzes the table and refreshes the cached statistics
+  InsertRows(1);
+  EXPECT_EQ(auto_analyzer_->PerformAutoAnalyze(), 1);
+  EXPECT_EQ(GetStatsNumRows(), 3 * THRESHOLD);
+
+  // The baseline moved, so the table is not analyzed again until it changes again
+  EXPECT_EQ(auto_analyzer_->PerformAutoAnalyze(), 0);
+}
+
+}  // namespace noisepage::optimizer
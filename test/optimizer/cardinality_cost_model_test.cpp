@@ -0,0 +1,137 @@
+#include "optimizer/cost_model/cardinality_cost_model.h"
+
+#include <memory>
+#include <string>
+
+#include "binder/bind_node_visitor.h"
+#include "gtest/gtest.h"
+#include "optimizer/optimize_result.h"
+#include "parser/postgresparser.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/index_scan_plan_node.h"
+#include "spdlog/fmt/fmt.h"
+#include "test_util/end_to_end_test.h"
+#include "test_util/test_harness.h"
+#include "test_util/tpcc/tpcc_plan_test.h"
+#include "traffic_cop/traffic_cop_util.h"
+
+namespace noisepage::optimizer {
+
+/**
+ * Returns the first plan node of the given type in a pre-order traversal of the plan, or nullptr if there is none
+ */
+static const planner::AbstractPlanNode *FindPlanNode(const planner::AbstractPlanNode *plan,
+                                                     planner::PlanNodeType type) {
+  if (plan->GetPlanNodeType() == type) return plan;
+  for (const auto child : plan->GetChildren()) {
+    auto *found = FindPlanNode(child.Get(), type);
+    if (found != nullptr) return found;
+  }
+  return nullptr;
+}
+
+class TpccPlanCardinalityCostModelTests : public TpccPlanTest {
+ public:
+  std::unique_ptr<optimizer::AbstractCostModel> MakeCostModel() override {
+    return std::make_unique<optimizer::CardinalityCostModel>();
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(TpccPlanCardinalityCostModelTests, PrimaryKeyLookupUsesIndex) {
+  auto check = [](TpccPlanTest *test, parser::SelectStatement *sel_stmt, catalog::table_oid_t tbl_oid,
+                  std::unique_ptr<planner::AbstractPlanNode> plan) {
+    EXPECT_EQ(plan->GetPlanNodeType(), planner::PlanNodeType::INDEXSCAN);
+    EXPECT_EQ(plan->GetChildrenSize(), 0);
+    auto index_plan = reinterpret_cast<planner::IndexScanPlanNode *>(plan.get());
+    EXPECT_EQ(index_plan->GetIndexOid(), test->pk_new_order_);
+  };
+
+  std::string query = "SELECT NO_O_ID FROM \"NEW ORDER\" WHERE NO_W_ID = 1 AND NO_D_ID = 2 AND NO_O_ID = 3";
+  OptimizeQuery(query, tbl_new_order_, check);
+}
+
+// NOLINTNEXTLINE
+TEST_F(TpccPlanCardinalityCostModelTests, DeliveryUsesIndex) {
+  std::string query =
+      "SELECT NO_O_ID FROM \"NEW ORDER\" WHERE NO_W_ID = 1 AND NO_D_ID = 2 AND NO_O_ID > 0 "
+      "ORDER BY NO_O_ID LIMIT 1";
+  OptimizeQuery(query, tbl_new_order_, TpccPlanTest::CheckIndexScan);
+}
+
+// NOLINTNEXTLINE
+TEST_F(TpccPlanCardinalityCostModelTests, NoPredicateUsesSeqScan) {
+  auto check = [](TpccPlanTest *test, parser::SelectStatement *sel_stmt, catalog::table_oid_t tbl_oid,
+                  std::unique_ptr<planner::AbstractPlanNode> plan) {
+    EXPECT_EQ(plan->GetPlanNodeType(), planner::PlanNodeType::SEQSCAN);
+    EXPECT_EQ(plan->GetChildrenSize(), 0);
+  };
+
+  std::string query = "SELECT NO_O_ID FROM \"NEW ORDER\"";
+  OptimizeQuery(query, tbl_new_order_, check);
+}
+
+/**
+ * Plan quality tests on a scaled-down TPC-H lineitem/orders pair with real statistics
+ */
+class TpchCardinalityCostModelTests : public test::EndToEndTest {
+ public:
+  static constexpr uint32_t NUM_ORDERS = 100;
+  static constexpr uint32_t LINEITEMS_PER_ORDER = 8;
+
+  void SetUp() override {
+    EndToEndTest::SetUp();
+    RunQuery("CREATE TABLE orders (o_orderkey INT, o_custkey INT);");
+    RunQuery("CREATE TABLE lineitem (l_orderkey INT, l_linenumber INT, l_quantity INT);");
+    RunQuery("CREATE INDEX lineitem_orderkey ON lineitem (l_orderkey);");
+
+    std::string orders = "INSERT INTO orders VALUES ";
+    std::string lineitems = "INSERT INTO lineitem VALUES ";
+    for (uint32_t order = 0; order < NUM_ORDERS; order++) {
+      orders += (order == 0 ? "" : ", ") + fmt::format("({}, {})", order, order % 10);
+      for (uint32_t line = 0; line < LINEITEMS_PER_ORDER; line++) {
+        lineitems += (order == 0 && line == 0 ? "" : ", ") + fmt::format("({}, {}, {})", order, line, line + 1);
+      }
+    }
+    RunQuery(orders + ";");
+    RunQuery(lineitems + ";");
+    RunQuery("ANALYZE orders;");
+    RunQuery("ANALYZE lineitem;");
+    txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+    test_txn_ = txn_manager_->BeginTransaction();
+  }
+
+  std::unique_ptr<planner::AbstractPlanNode> Optimize(const std::string &query) {
+    auto stmt_list = parser::PostgresParser::BuildParseTree(query);
+    auto accessor = MakeAccessor();
+    binder::BindNodeVisitor binder{common::ManagedPointer(accessor), test_db_oid_};
+    binder.BindNameToNode(common::ManagedPointer(stmt_list.get()), nullptr, nullptr);
+    return trafficcop::TrafficCopUtil::Optimize(common::ManagedPointer(test_txn_), common::ManagedPointer(accessor),
+                                                common::ManagedPointer(stmt_list), test_db_oid_, stats_storage_,
+                                                std::make_unique<CardinalityCostModel>(), 1000000, nullptr)
+        ->TakePlanNodeOwnership();
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(TpchCardinalityCostModelTests, SelectivePredicateUsesIndex) {
+  auto plan = Optimize("SELECT l_quantity FROM lineitem WHERE l_orderkey = 5;");
+  EXPECT_NE(FindPlanNode(plan.get(), planner::PlanNodeType::INDEXSCAN), nullptr);
+  EXPECT_EQ(FindPlanNode(plan.get(), planner::PlanNodeType::SEQSCAN), nullptr);
+}
+
+// NOLINTNEXTLINE
+TEST_F(TpchCardinalityCostModelTests, UnselectiveRangeUsesSeqScan) {
+  // Every lineitem qualifies, so walking the index only adds random accesses on top of a full scan
+  auto plan = Optimize("SELECT l_quantity FROM lineitem WHERE l_orderkey >= 0;");
+  EXPECT_NE(FindPlanNode(plan.get(), planner::PlanNodeType::SEQSCAN), nullptr);
+  EXPECT_EQ(FindPlanNode(plan.get(), planner::PlanNodeType::INDEXSCAN), nullptr);
+}
+
+// NOLINTNEXTLINE
+TEST_F(TpchCardinalityCostModelTests, EquiJoinAvoidsNestedLoops) {
+  auto plan = Optimize("SELECT o_custkey, l_quantity FROM orders, lineitem WHERE o_orderkey = l_orderkey;");
+  EXPECT_EQ(FindPlanNode(plan.get(), planner::PlanNodeType::NESTLOOP), nullptr);
+}
+
+}  // namespace noisepage::optimizer
@@ -0,0 +1,101 @@
+#include "optimizer/statistics/cardinality_feedback.h"
+
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::optimizer {
+
+class CardinalityFeedbackTests : public TerrierTest {};
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityFeedbackTests, RecordAndLookup) {
+  CardinalityFeedback feedback;
+  EXPECT_FALSE(feedback.GetActualRows(42).has_value());
+  EXPECT_FALSE(feedback.GetActualRows(CardinalityFeedback::NO_SIGNATURE).has_value());
+
+  // The first observation of a signature has no predecessor
+  EXPECT_FALSE(feedback.Record(42, 10, 5000).has_value());
+  EXPECT_EQ(feedback.GetActualRows(42), 5000);
+
+  // A later observation replaces the earlier one and returns it
+  auto previous = feedback.Record(42, 5000, 4000);
+  ASSERT_TRUE(previous.has_value());
+  EXPECT_EQ(previous->estimated_rows_, 10);
+  EXPECT_EQ(previous->actual_rows_, 5000);
+  EXPECT_EQ(feedback.GetActualRows(42), 4000);
+  EXPECT_EQ(feedback.GetNumEntries(), 1);
+
+  feedback.Clear();
+  EXPECT_EQ(feedback.GetNumEntries(), 0);
+  EXPECT_FALSE(feedback.GetActualRows(42).has_value());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityFeedbackTests, EvictOldestSignature) {
+  CardinalityFeedback feedback(3);
+  for (size_t signature = 1; signature <= 3; signature++) feedback.Record(signature, 1, signature * 10);
+
+  // Updating a signature does not make it younger
+  feedback.Record(1, 1, 100);
+  feedback.Record(4, 1, 40);
+  EXPECT_EQ(feedback.GetNumEntries(), 3);
+  EXPECT_FALSE(feedback.GetActualRows(1).has_value());
+  EXPECT_EQ(feedback.GetActualRows(2), 20);
+  EXPECT_EQ(feedback.GetActualRows(4), 40);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityFeedbackTests, Misestimate) {
+  EXPECT_FALSE(CardinalityFeedback::IsMisestimate(100, 100, 10));
+  EXPECT_FALSE(CardinalityFeedback::IsMisestimate(100, 999, 10));
+  EXPECT_TRUE(CardinalityFeedback::IsMisestimate(100, 1000, 10));
+  EXPECT_TRUE(CardinalityFeedback::IsMisestimate(1000, 100, 10));
+
+  // Empty results are treated as one row
+  EXPECT_FALSE(CardinalityFeedback::IsMisestimate(0, 5, 10));
+  EXPECT_TRUE(CardinalityFeedback::IsMisestimate(0, 10, 10));
+}
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityFeedbackTests, InvalidateTable) {
+  CardinalityFeedback feedback;
+  const catalog::db_oid_t db_oid{1};
+  const catalog::table_oid_t table_oid{2};
+  EXPECT_EQ(feedback.GetTableVersion(db_oid, table_oid), 0);
+
+  // Only the invalidated table gets a new version
+  feedback.InvalidateTable(db_oid, table_oid);
+  feedback.InvalidateTable(db_oid, table_oid);
+  EXPECT_EQ(feedback.GetTableVersion(db_oid, table_oid), 2);
+  EXPECT_EQ(feedback.GetTableVersion(db_oid, catalog::table_oid_t(3)), 0);
+  EXPECT_EQ(feedback.GetTableVersion(catalog::db_oid_t(2), table_oid), 0);
+
+  // Dropping the observations does not reset the versions
+  feedback.Clear();
+  EXPECT_EQ(feedback.GetTableVersion(db_oid, table_oid), 2);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityFeedbackTests, ConcurrentRecord) {
+  const size_t num_threads = 8;
+  const size_t num_signatures = 1000;
+  CardinalityFeedback feedback(num_signatures);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&feedback, num_signatures] {
+      for (size_t signature = 1; signature <= num_signatures; signature++) {
+        feedback.Record(signature, 1, signature);
+        EXPECT_EQ(feedback.GetActualRows(signature), signature);
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  EXPECT_EQ(feedback.GetNumEntries(), num_signatures);
+}
+
+}  // namespace noisepage::optimizer
@@ -0,0 +1,297 @@
+#include "optimizer/index_util.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_accessor.h"
+#include "gtest/gtest.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/comparison_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/operator_expression.h"
+#include "test_util/end_to_end_test.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::optimizer {
+
+class IndexUtilTests : public test::EndToEndTest {
+ public:
+  void SetUp() override {
+    EndToEndTest::SetUp();
+    auto exec_ctx = MakeExecCtx();
+    GenerateTestTables(exec_ctx.get());
+    table_oid_ = accessor_->GetTableOid("test_1");
+
+    // colA is serial, colB is in [0, 9] and colC is in [0, 9999]
+    RunQuery("CREATE INDEX test_1_partial ON test_1 (colA) WHERE colB = 0 AND colA < 100");
+    RunQuery("CREATE INDEX test_1_expr ON test_1 ((colA + colB))");
+  }
+
+ protected:
+  common::ManagedPointer<parser::AbstractExpression> Col(const std::string &name) {
+    const auto &col = accessor_->GetSchema(table_oid_).GetColumn(name);
+    return Own(std::make_unique<parser::ColumnValueExpression>("test_1", name, test_db_oid_, table_oid_, col.Oid(),
+                                                               col.Type()));
+  }
+
+  common::ManagedPointer<parser::AbstractExpression> Int(int64_t value) {
+    return Own(
+        std::make_unique<parser::ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(value)));
+  }
+
+  common::ManagedPointer<parser::AbstractExpression> Compare(parser::ExpressionType type,
+                                                             common::ManagedPointer<parser::AbstractExpression> lhs,
+                                                             common::ManagedPointer<parser::AbstractExpression> rhs) {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+    children.emplace_back(lhs->Copy());
+    children.emplace_back(rhs->Copy());
+    return Own(std::make_unique<parser::ComparisonExpression>(type, std::move(children)));
+  }
+
+  common::ManagedPointer<parser::AbstractExpression> Plus(common::ManagedPointer<parser::AbstractExpression> lhs,
+                                                          common::ManagedPointer<parser::AbstractExpression> rhs) {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+    children.emplace_back(lhs->Copy());
+    children.emplace_back(rhs->Copy());
+    return Own(std::make_unique<parser::OperatorExpression>(parser::ExpressionType::OPERATOR_PLUS,
+                                                            type::TypeId::INTEGER, std::move(children)));
+  }
+
+  common::ManagedPointer<parser::AbstractExpression> IsNotNull(
+      common::ManagedPointer<parser::AbstractExpression> child) {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+    children.emplace_back(child->Copy());
+    return Own(std::make_unique<parser::OperatorExpression>(parser::ExpressionType::OPERATOR_IS_NOT_NULL,
+                                                            type::TypeId::BOOLEAN, std::move(children)));
+  }
+
+  static std::vector<AnnotatedExpression> Predicates(
+      const std::vector<common::ManagedPointer<parser::AbstractExpression>> &exprs) {
+    std::vector<AnnotatedExpression> predicates;
+    for (const auto &expr : exprs) predicates.emplace_back(expr, std::unordered_set<std::string>{"test_1"});
+    return predicates;
+  }
+
+  const catalog::IndexSchema &GetIndexSchema(const std::string &name) {
+    return accessor_->GetIndexSchema(accessor_->GetIndexOid(name));
+  }
+
+  std::pair<bool, bool> SatisfiesPredicateWithIndex(
+      const std::string &index_name, const std::vector<AnnotatedExpression> &predicates,
+      planner::IndexScanType *scan_type,
+      std::unordered_map<catalog::indexkeycol_oid_t, std::vector<planner::IndexExpression>> *bounds) {
+    return IndexUtil::SatisfiesPredicateWithIndex(accessor_.get(), table_oid_, "test_1",
+                                                  accessor_->GetIndexOid(index_name), predicates, false, scan_type,
+                                                  bounds);
+  }
+
+  static bool ImpliesIndexPredicate(const catalog::IndexSchema &schema,
+                                    const std::vector<AnnotatedExpression> &predicates,
+                                    std::vector<AnnotatedExpression> *residual) {
+    return IndexUtil::ImpliesIndexPredicate(schema, predicates, residual);
+  }
+
+  static bool ImpliesConjunct(common::ManagedPointer<parser::AbstractExpression> pred,
+                              common::ManagedPointer<parser::AbstractExpression> conjunct) {
+    return IndexUtil::ImpliesConjunct(pred.CastManagedPointerTo<const parser::AbstractExpression>(),
+                                      conjunct.CastManagedPointerTo<const parser::AbstractExpression>());
+  }
+
+  static catalog::indexkeycol_oid_t MatchExpressionKey(const catalog::IndexSchema &schema,
+                                                       common::ManagedPointer<parser::AbstractExpression> expr) {
+    return IndexUtil::MatchExpressionKey(schema, expr);
+  }
+
+  catalog::table_oid_t table_oid_;
+
+ private:
+  common::ManagedPointer<parser::AbstractExpression> Own(std::unique_ptr<parser::AbstractExpression> expr) {
+    exprs_.emplace_back(std::move(expr));
+    return common::ManagedPointer(exprs_.back());
+  }
+
+  std::vector<std::unique_ptr<parser::AbstractExpression>> exprs_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(IndexUtilTests, ImpliesConjunctTest) {
+  using Type = parser::ExpressionType;
+  auto col_a = Col("colA");
+  auto col_b = Col("colB");
+
+  // Ranges
+  EXPECT_TRUE(ImpliesConjunct(Compare(Type::COMPARE_LESS_THAN, col_a, Int(10)),
+                              Compare(Type::COMPARE_LESS_THAN, col_a, Int(100))));
+  EXPECT_TRUE(ImpliesConjunct(Compare(Type::COMPARE_LESS_THAN, col_a, Int(100)),
+                              Compare(Type::COMPARE_LESS_THAN, col_a, Int(100))));
+  EXPECT_FALSE(ImpliesConjunct(Compare(Type::COMPARE_LESS_THAN_OR_EQUAL_TO, col_a, Int(100)),
+                               Compare(Type::COMPARE_LESS_THAN, col_a, Int(100))));
+  EXPECT_FALSE(ImpliesConjunct(Compare(Type::COMPARE_LESS_THAN, col_a, Int(100)),
+                               Compare(Type::COMPARE_LESS_THAN, col_a, Int(10))));
+  EXPECT_TRUE(ImpliesConjunct(Compare(Type::COMPARE_GREATER_THAN, col_a, Int(5)),
+                              Compare(Type::COMPARE_GREATER_THAN_OR_EQUAL_TO, col_a, Int(5))));
+  EXPECT_FALSE(ImpliesConjunct(Compare(Type::COMPARE_GREATER_THAN, col_a, Int(5)),
+                               Compare(Type::COMPARE_LESS_THAN, col_a, Int(100))));
+
+  // The column may be on either side of the comparison
+  EXPECT_TRUE(ImpliesConjunct(Compare(Type::COMPARE_GREATER_THAN, Int(10), col_a),
+                              Compare(Type::COMPARE_LESS_THAN, col_a, Int(100))));
+  EXPECT_TRUE(ImpliesConjunct(Compare(Type::COMPARE_LESS_THAN, col_a, Int(10)),
+                              Compare(Type::COMPARE_GREATER_THAN, Int(100), col_a)));
+
+  // Equality
+  EXPECT_TRUE(ImpliesConjunct(Compare(Type::COMPARE_EQUAL, col_a, Int(5)),
+                              Compare(Type::COMPARE_LESS_THAN_OR_EQUAL_TO, col_a, Int(5))));
+  EXPECT_TRUE(ImpliesConjunct(Compare(Type::COMPARE_EQUAL, col_a, Int(5)),
+                              Compare(Type::COMPARE_NOT_EQUAL, col_a, Int(6))));
+  EXPECT_FALSE(ImpliesConjunct(Compare(Type::COMPARE_EQUAL, col_a, Int(5)),
+                               Compare(Type::COMPARE_NOT_EQUAL, col_a, Int(5))));
+  EXPECT_TRUE(ImpliesConjunct(Compare(Type::COMPARE_LESS_THAN, col_a, Int(5)),
+                              Compare(Type::COMPARE_NOT_EQUAL, col_a, Int(5))));
+  EXPECT_FALSE(ImpliesConjunct(Compare(Type::COMPARE_LESS_THAN, col_a, Int(5)),
+                               Compare(Type::COMPARE_EQUAL, col_a, Int(4))));
+
+  // Different columns never imply each other
+  EXPECT_FALSE(ImpliesConjunct(Compare(Type::COMPARE_LESS_THAN, col_b, Int(10)),
+                               Compare(Type::COMPARE_LESS_THAN, col_a, Int(100))));
+
+  // A comparison is never true on NULL
+  EXPECT_TRUE(ImpliesConjunct(Compare(Type::COMPARE_GREATER_THAN, col_a, Int(3)), IsNotNull(col_a)));
+  EXPECT_FALSE(ImpliesConjunct(Compare(Type::COMPARE_GREATER_THAN, col_b, Int(3)), IsNotNull(col_a)));
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexUtilTests, ImpliesIndexPredicateTest) {
+  using Type = parser::ExpressionType;
+  const auto &schema = GetIndexSchema("test_1_partial");
+  ASSERT_TRUE(schema.IsPartial());
+  auto col_a = Col("colA");
+  auto col_b = Col("colB");
+  auto col_c = Col("colC");
+
+  // colB = 0 matches a conjunct exactly, so it is guaranteed by the index and does not need to be kept
+  {
+    auto b_eq = Compare(Type::COMPARE_EQUAL, col_b, Int(0));
+    auto a_lt = Compare(Type::COMPARE_LESS_THAN, col_a, Int(50));
+    auto c_gt = Compare(Type::COMPARE_GREATER_THAN, col_c, Int(5));
+    std::vector<AnnotatedExpression> residual;
+    EXPECT_TRUE(ImpliesIndexPredicate(schema, Predicates({b_eq, a_lt, c_gt}), &residual));
+    ASSERT_EQ(residual.size(), 2);
+    EXPECT_EQ(residual[0].GetExpr(), a_lt);
+    EXPECT_EQ(residual[1].GetExpr(), c_gt);
+  }
+
+  // Both query predicates are exactly the index conjuncts
+  {
+    std::vector<AnnotatedExpression> residual;
+    EXPECT_TRUE(ImpliesIndexPredicate(schema,
+                                      Predicates({Compare(Type::COMPARE_LESS_THAN, col_a, Int(100)),
+                                                  Compare(Type::COMPARE_EQUAL, col_b, Int(0))}),
+                                      &residual));
+    EXPECT_TRUE(residual.empty());
+  }
+
+  // colB = 0 is missing, so the index may lack qualifying tuples
+  {
+    std::vector<AnnotatedExpression> residual;
+    EXPECT_FALSE(
+        ImpliesIndexPredicate(schema, Predicates({Compare(Type::COMPARE_LESS_THAN, col_a, Int(50))}), &residual));
+  }
+
+  // colA < 200 does not imply colA < 100
+  {
+    std::vector<AnnotatedExpression> residual;
+    EXPECT_FALSE(ImpliesIndexPredicate(schema,
+                                       Predicates({Compare(Type::COMPARE_EQUAL, col_b, Int(0)),
+                                                   Compare(Type::COMPARE_LESS_THAN, col_a, Int(200))}),
+                                       &residual));
+  }
+
+  // A different constant does not match
+  {
+    std::vector<AnnotatedExpression> residual;
+    EXPECT_FALSE(ImpliesIndexPredicate(schema,
+                                       Predicates({Compare(Type::COMPARE_EQUAL, col_b, Int(1)),
+                                                   Compare(Type::COMPARE_LESS_THAN, col_a, Int(50))}),
+                                       &residual));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexUtilTests, MatchExpressionKeyTest) {
+  const auto &schema = GetIndexSchema("test_1_expr");
+  ASSERT_EQ(schema.GetColumns().size(), 1);
+  ASSERT_TRUE(schema.HasExpressionKeys());
+  auto col_a = Col("colA");
+  auto col_b = Col("colB");
+
+  EXPECT_EQ(MatchExpressionKey(schema, Plus(col_a, col_b)), schema.GetColumn(0).Oid());
+  EXPECT_EQ(MatchExpressionKey(schema, Plus(col_b, col_a)), catalog::INVALID_INDEXKEYCOL_OID);
+  EXPECT_EQ(MatchExpressionKey(schema, Plus(col_a, Int(1))), catalog::INVALID_INDEXKEYCOL_OID);
+  // Plain columns are matched through the base column lookup instead
+  EXPECT_EQ(MatchExpressionKey(schema, col_a), catalog::INVALID_INDEXKEYCOL_OID);
+  EXPECT_EQ(MatchExpressionKey(GetIndexSchema("test_1_partial"), col_a), catalog::INVALID_INDEXKEYCOL_OID);
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexUtilTests, SatisfiesPredicateWithExpressionIndexTest) {
+  using Type = parser::ExpressionType;
+  planner::IndexScanType scan_type;
+  std::unordered_map<catalog::indexkeycol_oid_t, std::vector<planner::IndexExpression>> bounds;
+
+  auto result = SatisfiesPredicateWithIndex(
+      "test_1_expr", Predicates({Compare(Type::COMPARE_EQUAL, Plus(Col("colA"), Col("colB")), Int(10))}), &scan_type,
+      &bounds);
+  EXPECT_TRUE(result.first);
+  EXPECT_EQ(scan_type, planner::IndexScanType::Exact);
+  EXPECT_EQ(bounds.size(), 1);
+
+  bounds.clear();
+  result = SatisfiesPredicateWithIndex("test_1_expr",
+                                       Predicates({Compare(Type::COMPARE_EQUAL, Col("colA"), Int(10))}), &scan_type,
+                                       &bounds);
+  EXPECT_FALSE(result.first);
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexUtilTests, SatisfiesPredicateWithPartialIndexTest) {
+  using Type = parser::ExpressionType;
+  auto col_a = Col("colA");
+  auto col_b = Col("colB");
+  auto col_c = Col("colC");
+  auto b_eq = Compare(Type::COMPARE_EQUAL, col_b, Int(0));
+  planner::IndexScanType scan_type;
+  std::unordered_map<catalog::indexkeycol_oid_t, std::vector<planner::IndexExpression>> bounds;
+
+  // The residual predicates on the key bound the scan
+  auto result = SatisfiesPredicateWithIndex(
+      "test_1_partial", Predicates({b_eq, Compare(Type::COMPARE_GREATER_THAN, col_a, Int(5)),
+                                    Compare(Type::COMPARE_LESS_THAN, col_a, Int(50))}),
+      &scan_type, &bounds);
+  EXPECT_TRUE(result.first);
+  EXPECT_EQ(scan_type, planner::IndexScanType::AscendingClosed);
+  EXPECT_EQ(bounds.size(), 1);
+
+  // Nothing bounds the key, but the index only holds qualifying tuples, so the whole index is scanned
+  bounds.clear();
+  result = SatisfiesPredicateWithIndex("test_1_partial",
+                                       Predicates({b_eq, Compare(Type::COMPARE_LESS_THAN, col_a, Int(100)),
+                                                   Compare(Type::COMPARE_GREATER_THAN, col_c, Int(5))}),
+                                       &scan_type, &bounds);
+  EXPECT_TRUE(result.first);
+  EXPECT_EQ(scan_type, planner::IndexScanType::AscendingOpenBoth);
+  EXPECT_TRUE(bounds.empty());
+
+  // The query may return tuples that are not in the index
+  bounds.clear();
+  result = SatisfiesPredicateWithIndex(
+      "test_1_partial", Predicates({b_eq, Compare(Type::COMPARE_GREATER_THAN, col_c, Int(5))}), &scan_type, &bounds);
+  EXPECT_FALSE(result.first);
+  EXPECT_FALSE(result.second);
+}
+
+}  // namespace noisepage::optimizer
@@ -0,0 +1,299 @@
+#include "optimizer/join_order_enumerator.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "binder/bind_node_visitor.h"
+#include "common/worker_pool.h"
+#include "gtest/gtest.h"
+#include "optimizer/cost_model/cardinality_cost_model.h"
+#include "optimizer/optimize_result.h"
+#include "parser/postgresparser.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "spdlog/fmt/fmt.h"
+#include "test_util/end_to_end_test.h"
+#include "test_util/test_harness.h"
+#include "traffic_cop/traffic_cop_util.h"
+
+namespace noisepage::optimizer {
+
+using RelationSet = JoinOrderEnumerator::RelationSet;
+
+class JoinOrderEnumeratorTests : public TerrierTest {
+ public:
+  static RelationSet Rel(size_t relation) { return RelationSet{1} << relation; }
+
+  /** Checks that the join tree below set is well formed and returns its C_out cost */
+  static double CheckTree(const JoinOrderEnumerator &enumerator, RelationSet set) {
+    auto children = enumerator.GetChildren(set);
+    if (children.first == 0) {
+      EXPECT_EQ(children.second, 0);
+      EXPECT_EQ(__builtin_popcountll(set), 1);
+      return 0;
+    }
+    EXPECT_EQ(children.first | children.second, set);
+    EXPECT_EQ(children.first & children.second, 0);
+    return enumerator.GetCardinality(set) + CheckTree(enumerator, children.first) +
+           CheckTree(enumerator, children.second);
+  }
+
+  /** @return whether the join tree below set joins two relations that are not connected by any predicate */
+  static bool HasCrossProduct(const JoinOrderEnumerator &enumerator, RelationSet set,
+                              const std::vector<RelationSet> &predicates) {
+    auto children = enumerator.GetChildren(set);
+    if (children.first == 0) return false;
+    bool connected = std::any_of(predicates.begin(), predicates.end(), [&](RelationSet predicate) {
+      return (predicate & children.first) != 0 && (predicate & children.second) != 0 && (predicate & ~set) == 0;
+    });
+    return !connected || HasCrossProduct(enumerator, children.first, predicates) ||
+           HasCrossProduct(enumerator, children.second, predicates);
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, ChainJoinsSelectiveEndFirst) {
+  // A(1000) - B(1000) - C(10) - D(1000), with only the C-D join being selective
+  JoinOrderEnumerator enumerator;
+  enumerator.AddRelation(1000);
+  enumerator.AddRelation(1000);
+  enumerator.AddRelation(10);
+  enumerator.AddRelation(1000);
+  enumerator.AddPredicate(Rel(0) | Rel(1), 1.0 / 1000);
+  enumerator.AddPredicate(Rel(1) | Rel(2), 1.0 / 1000);
+  enumerator.AddPredicate(Rel(2) | Rel(3), 1.0 / 100000);
+  enumerator.Enumerate();
+
+  EXPECT_TRUE(enumerator.UsedDynamicProgramming());
+  auto all = enumerator.GetAllRelations();
+  EXPECT_EQ(all, 0xF);
+  EXPECT_DOUBLE_EQ(CheckTree(enumerator, all), enumerator.GetCost(all));
+  EXPECT_FALSE(HasCrossProduct(enumerator, all, {Rel(0) | Rel(1), Rel(1) | Rel(2), Rel(2) | Rel(3)}));
+
+  // C-D produces 0.1 rows, so it must be joined before anything else
+  EXPECT_DOUBLE_EQ(enumerator.GetCardinality(Rel(2) | Rel(3)), 0.1);
+  std::function<bool(RelationSet)> contains_cd = [&](RelationSet set) -> bool {
+    if (set == (Rel(2) | Rel(3))) return true;
+    auto children = enumerator.GetChildren(set);
+    return children.first != 0 && (contains_cd(children.first) || contains_cd(children.second));
+  };
+  EXPECT_TRUE(contains_cd(all));
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, StarJoinAvoidsCrossProducts) {
+  // Fact table joined with five dimension tables, dimensions are never joined with each other directly
+  JoinOrderEnumerator enumerator;
+  enumerator.AddRelation(100000);
+  std::vector<RelationSet> predicates;
+  for (size_t dim = 1; dim <= 5; dim++) {
+    enumerator.AddRelation(static_cast<double>(10 * dim));
+    enumerator.AddPredicate(Rel(0) | Rel(dim), 1.0 / 100000);
+    predicates.push_back(Rel(0) | Rel(dim));
+  }
+  enumerator.Enumerate();
+
+  auto all = enumerator.GetAllRelations();
+  EXPECT_DOUBLE_EQ(CheckTree(enumerator, all), enumerator.GetCost(all));
+  EXPECT_FALSE(HasCrossProduct(enumerator, all, predicates));
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, DisconnectedGraphGetsCrossProduct) {
+  JoinOrderEnumerator enumerator;
+  for (size_t i = 0; i < 4; i++) enumerator.AddRelation(100);
+  enumerator.AddPredicate(Rel(0) | Rel(1), 0.01);
+  enumerator.AddPredicate(Rel(2) | Rel(3), 0.01);
+  enumerator.Enumerate();
+
+  auto all = enumerator.GetAllRelations();
+  EXPECT_DOUBLE_EQ(CheckTree(enumerator, all), enumerator.GetCost(all));
+  EXPECT_DOUBLE_EQ(enumerator.GetCardinality(all), 10000);
+  // The only cross product is between the two connected components
+  auto root = enumerator.GetChildren(all);
+  EXPECT_TRUE((root.first == (Rel(0) | Rel(1)) && root.second == (Rel(2) | Rel(3))) ||
+              (root.first == (Rel(2) | Rel(3)) && root.second == (Rel(0) | Rel(1))));
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, DynamicProgrammingIsOptimal) {
+  std::default_random_engine generator(42);
+  std::uniform_int_distribution<uint32_t> rows(1, 10000);
+  std::uniform_real_distribution<double> selectivity(0.0001, 1.0);
+
+  for (uint32_t trial = 0; trial < 50; trial++) {
+    const size_t num_relations = 2 + trial % 7;
+    JoinOrderEnumerator enumerator;
+    std::vector<double> relation_rows;
+    std::vector<std::pair<RelationSet, double>> predicates;
+    for (size_t i = 0; i < num_relations; i++) {
+      relation_rows.push_back(rows(generator));
+      enumerator.AddRelation(relation_rows.back());
+    }
+    // Random spanning tree plus a few extra edges keeps the join graph connected
+    for (size_t i = 1; i < num_relations; i++) {
+      predicates.emplace_back(Rel(generator() % i) | Rel(i), selectivity(generator));
+    }
+    for (size_t i = 0; i < num_relations / 2; i++) {
+      auto first = generator() % num_relations;
+      auto second = generator() % num_relations;
+      if (first != second) predicates.emplace_back(Rel(first) | Rel(second), selectivity(generator));
+    }
+    for (const auto &predicate : predicates) enumerator.AddPredicate(predicate.first, predicate.second);
+    enumerator.Enumerate();
+
+    // Exhaustive search over all bushy trees without cross products
+    auto cardinality = [&](RelationSet set) {
+      double result = 1.0;
+      for (size_t i = 0; i < num_relations; i++) {
+        if ((set & Rel(i)) != 0) result *= relation_rows[i];
+      }
+      for (const auto &predicate : predicates) {
+        if ((predicate.first & ~set) == 0) result *= predicate.second;
+      }
+      return result;
+    };
+    auto joined = [&](RelationSet left, RelationSet right) {
+      return std::any_of(predicates.begin(), predicates.end(), [&](const std::pair<RelationSet, double> &predicate) {
+        return (predicate.first & left) != 0 && (predicate.first & right) != 0;
+      });
+    };
+    std::unordered_map<RelationSet, double> best;
+    const auto all = enumerator.GetAllRelations();
+    for (RelationSet set = 1; set <= all; set++) {
+      if (__builtin_popcountll(set) == 1) {
+        best[set] = 0;
+        continue;
+      }
+      for (RelationSet left = (set - 1) & set; left != 0; left = (left - 1) & set) {
+        auto right = set & ~left;
+        if (best.count(left) == 0 || best.count(right) == 0 || !joined(left, right)) continue;
+        auto cost = cardinality(set) + best[left] + best[right];
+        if (best.count(set) == 0 || cost < best[set]) best[set] = cost;
+      }
+    }
+
+    EXPECT_TRUE(enumerator.UsedDynamicProgramming());
+    EXPECT_DOUBLE_EQ(CheckTree(enumerator, all), enumerator.GetCost(all));
+    EXPECT_NEAR(enumerator.GetCost(all), best[all], best[all] * 1e-9);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, LargeRegionUsesGreedy) {
+  const size_t num_relations = JoinOrderEnumerator::MAX_DP_RELATIONS + 5;
+  JoinOrderEnumerator enumerator;
+  std::vector<RelationSet> predicates;
+  for (size_t i = 0; i < num_relations; i++) {
+    enumerator.AddRelation(static_cast<double>(100 + i));
+    if (i > 0) {
+      enumerator.AddPredicate(Rel(i - 1) | Rel(i), 0.01);
+      predicates.push_back(Rel(i - 1) | Rel(i));
+    }
+  }
+  enumerator.Enumerate();
+
+  auto all = enumerator.GetAllRelations();
+  EXPECT_FALSE(enumerator.UsedDynamicProgramming());
+  EXPECT_DOUBLE_EQ(CheckTree(enumerator, all), enumerator.GetCost(all));
+  EXPECT_FALSE(HasCrossProduct(enumerator, all, predicates));
+}
+
+/**
+ * Multi-way joins planned end to end, with the join order enumerator feeding the memo
+ */
+class JoinOrderEnumeratorEndToEndTests : public test::EndToEndTest {
+ public:
+  void SetUp() override {
+    EndToEndTest::SetUp();
+    for (uint32_t table = 0; table < NUM_TABLES; table++) {
+      RunQuery(fmt::format("CREATE TABLE t{} (id INT, next_id INT);", table));
+      std::string insert = fmt::format("INSERT INTO t{} VALUES ", table);
+      // Table sizes alternate between small and large so that the written order is a poor join order
+      const uint32_t num_rows = table % 2 == 0 ? 200 : 5;
+      for (uint32_t row = 0; row < num_rows; row++) {
+        insert += (row == 0 ? "" : ", ") + fmt::format("({}, {})", row, row);
+      }
+      RunQuery(insert + ";");
+      RunQuery(fmt::format("ANALYZE t{};", table));
+    }
+    txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+    test_txn_ = txn_manager_->BeginTransaction();
+  }
+
+  std::unique_ptr<OptimizeResult> Optimize(const std::string &query,
+                                           common::ManagedPointer<common::WorkerPool> worker_pool = nullptr) {
+    auto stmt_list = parser::PostgresParser::BuildParseTree(query);
+    auto accessor = MakeAccessor();
+    binder::BindNodeVisitor binder{common::ManagedPointer(accessor), test_db_oid_};
+    binder.BindNameToNode(common::ManagedPointer(stmt_list.get()), nullptr, nullptr);
+    return trafficcop::TrafficCopUtil::Optimize(common::ManagedPointer(test_txn_), common::ManagedPointer(accessor),
+                                                common::ManagedPointer(stmt_list), test_db_oid_, stats_storage_,
+                                                std::make_unique<CardinalityCostModel>(), 1000000, nullptr,
+                                                worker_pool);
+  }
+
+  static size_t CountJoins(const planner::AbstractPlanNode *plan) {
+    size_t joins = 0;
+    switch (plan->GetPlanNodeType()) {
+      case planner::PlanNodeType::HASHJOIN:
+      case planner::PlanNodeType::NESTLOOP:
+      case planner::PlanNodeType::INDEXNLJOIN:
+        joins++;
+        break;
+      default:
+        break;
+    }
+    for (const auto child : plan->GetChildren()) joins += CountJoins(child.Get());
+    return joins;
+  }
+
+  static constexpr uint32_t NUM_TABLES = 6;
+};
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorEndToEndTests, ChainJoin) {
+  std::string query = "SELECT t0.id FROM t0, t1, t2, t3, t4, t5 WHERE t0.next_id = t1.id AND t1.next_id = t2.id AND "
+                      "t2.next_id = t3.id AND t3.next_id = t4.id AND t4.next_id = t5.id;";
+  auto result = Optimize(query);
+  EXPECT_EQ(CountJoins(result->GetPlanNode().Get()), NUM_TABLES - 1);
+  EXPECT_EQ(result->GetNumParallelGroups(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorEndToEndTests, StarJoin) {
+  std::string query = "SELECT t0.id FROM t0, t1, t2, t3, t4 WHERE t0.id = t1.id AND t0.id = t2.id AND "
+                      "t0.id = t3.id AND t0.id = t4.id;";
+  auto result = Optimize(query);
+  EXPECT_EQ(CountJoins(result->GetPlanNode().Get()), 4);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorEndToEndTests, ParallelStarJoin) {
+  // Whatever order the enumerator picks, every join of a star splits into a side with the center and a side without
+  // it, so the inputs of all the joins but the top one are optimized on the worker pool before the serial search
+  std::string query = "SELECT t0.id, t5.id FROM t0, t1, t2, t3, t4, t5 WHERE t0.id = t1.id AND t0.id = t2.id AND "
+                      "t0.id = t3.id AND t0.id = t4.id AND t0.id = t5.id;";
+  common::WorkerPool worker_pool(3, {});
+  worker_pool.Startup();
+  auto serial_result = Optimize(query);
+  auto parallel_result = Optimize(query, common::ManagedPointer(&worker_pool));
+  worker_pool.Shutdown();
+
+  // A tree of NUM_TABLES - 1 joins has 2 * (NUM_TABLES - 1) groups below its top join
+  EXPECT_EQ(serial_result->GetNumParallelGroups(), 0);
+  EXPECT_EQ(parallel_result->GetNumParallelGroups(), 2 * (NUM_TABLES - 1));
+
+  // Optimizing the subtrees ahead of time must not change the plan the search settles on
+  EXPECT_EQ(CountJoins(parallel_result->GetPlanNode().Get()), NUM_TABLES - 1);
+  EXPECT_DOUBLE_EQ(parallel_result->GetCost(), serial_result->GetCost());
+  EXPECT_EQ(parallel_result->GetPlanNode()->GetOutputSchema()->GetColumns().size(),
+            serial_result->GetPlanNode()->GetOutputSchema()->GetColumns().size());
+}
+
+}  // namespace noisepage::optimizer
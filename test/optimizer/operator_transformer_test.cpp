@@ -1169,6 +1169,70 @@ TEST_F(OperatorTransformerTest, CreateIndexTest) {
   EXPECT_EQ(cipn->GetSchema()->GetColumns(), ci->GetSchema()->GetColumns());
 }
 
+// NOLINTNEXTLINE
+TEST_F(OperatorTransformerTest, CreatePartialIndexTest) {
+  std::string create_sql = "CREATE INDEX idx_p ON A (lower(A2)) WHERE A1 > 10;";
+  std::string ref = R"({"Op":"LogicalCreateIndex",})";
+
+  auto parse_tree = parser::PostgresParser::BuildParseTree(create_sql);
+  auto statement = parse_tree->GetStatements()[0];
+  binder_->BindNameToNode(common::ManagedPointer(parse_tree), nullptr, nullptr);
+  auto col_a1_oid = accessor_->GetSchema(table_a_oid_).GetColumn("a1").Oid();
+
+  operator_transformer_ =
+      std::make_unique<optimizer::QueryToOperatorTransformer>(common::ManagedPointer(accessor_), db_oid_);
+  operator_tree_ = operator_transformer_->ConvertToOpExpression(statement, common::ManagedPointer(parse_tree));
+  auto info = GenerateOperatorAudit(common::ManagedPointer<optimizer::AbstractOptimizerNode>(operator_tree_));
+
+  EXPECT_EQ(ref, info);
+
+  // The bound predicate is carried by the logical operator
+  auto logical_create = operator_tree_->Contents()->GetContentsAs<optimizer::LogicalCreateIndex>();
+  auto create_stmt = statement.CastManagedPointerTo<parser::CreateStatement>();
+  EXPECT_EQ(logical_create->GetIndexPredicate(), create_stmt->GetIndexPredicate());
+  auto pred = logical_create->GetIndexPredicate();
+  EXPECT_EQ(pred->GetExpressionType(), parser::ExpressionType::COMPARE_GREATER_THAN);
+  EXPECT_EQ(pred->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid(), col_a1_oid);
+
+  auto optree_ptr = common::ManagedPointer(operator_tree_);
+  auto *op_ctx = optimization_context_.get();
+  std::vector<std::unique_ptr<optimizer::AbstractOptimizerNode>> transformed;
+
+  optimizer::LogicalCreateIndexToPhysicalCreateIndex rule;
+  EXPECT_TRUE(rule.Check(optree_ptr, op_ctx));
+  rule.Transform(optree_ptr.CastManagedPointerTo<optimizer::AbstractOptimizerNode>(), &transformed, op_ctx);
+
+  auto ci = transformed[0]->Contents()->GetContentsAs<optimizer::CreateIndex>();
+  const auto &schema = *ci->GetSchema();
+  EXPECT_TRUE(schema.IsPartial());
+  EXPECT_TRUE(schema.HasExpressionKeys());
+  EXPECT_EQ(schema.GetColumns()[0].Name(), "expr");
+  EXPECT_EQ(*schema.GetPredicate(), *pred);
+
+  // The predicate survives copies and serialization, which is how it reaches the catalog and recovery
+  catalog::IndexSchema copy(schema);
+  EXPECT_EQ(copy, schema);
+  EXPECT_EQ(copy.Hash(), schema.Hash());
+  auto deserialized = catalog::IndexSchema::DeserializeSchema(schema.ToJson());
+  EXPECT_TRUE(deserialized->IsPartial());
+  EXPECT_EQ(*deserialized->GetPredicate(), *schema.GetPredicate());
+
+  planner::PlanMetaData plan_meta_data{};
+  optimizer::PlanGenerator plan_generator(common::ManagedPointer<planner::PlanMetaData>{&plan_meta_data});
+  optimizer::PropertySet property_set{};
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> required_cols{};
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> output_cols{};
+  std::vector<std::unique_ptr<planner::AbstractPlanNode>> children_plans{};
+  std::vector<optimizer::ExprMap> children_expr_map{};
+
+  auto plan_node = plan_generator.ConvertOpNode(
+      txn_, accessor_.get(), transformed[0].get(), &property_set, required_cols, output_cols, std::move(children_plans),
+      std::move(children_expr_map), planner::PlanMetaData::PlanNodeMetaData());
+  auto cipn = common::ManagedPointer(plan_node).CastManagedPointerTo<planner::CreateIndexPlanNode>();
+  EXPECT_TRUE(cipn->GetSchema()->IsPartial());
+  EXPECT_EQ(*cipn->GetSchema()->GetPredicate(), *pred);
+}
+
 // NOLINTNEXTLINE
 TEST_F(OperatorTransformerTest, CreateFunctionTest) {
   std::string create_sql =
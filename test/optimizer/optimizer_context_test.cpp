@@ -5,6 +5,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/worker_pool.h"
 #include "optimizer/binding.h"
 #include "optimizer/logical_operators.h"
 #include "optimizer/optimizer_defs.h"
@@ -12,6 +13,7 @@
 #include "optimizer/optimizer_task_pool.h"
 #include "optimizer/pattern.h"
 #include "optimizer/physical_operators.h"
+#include "test_util/multithread_test_util.h"
 #include "test_util/test_harness.h"
 #include "transaction/deferred_action_manager.h"
 #include "transaction/timestamp_manager.h"
@@ -299,6 +301,53 @@ TEST_F(OptimizerContextTest, RecordOperatorNodeIntoGroupDuplicate) {
   delete txn_context;
 }
 
+// NOLINTNEXTLINE
+TEST_F(OptimizerContextTest, RecordOperatorNodeIntoGroupConcurrent) {
+  auto context = OptimizerContext(nullptr);
+
+  // Due to the deferred action framework being used to manage memory, we need to
+  // simulate a transaction to prevent leaks
+  auto timestamp_manager = transaction::TimestampManager();
+  auto *deferred_action_manager = new transaction::DeferredActionManager(common::ManagedPointer(&timestamp_manager));
+  auto *buffer_pool = new storage::RecordBufferSegmentPool(100, 2);
+  transaction::TransactionManager txn_manager = transaction::TransactionManager(
+      common::ManagedPointer(&timestamp_manager), common::ManagedPointer(deferred_action_manager),
+      common::ManagedPointer(buffer_pool), false, false, nullptr);
+
+  transaction::TransactionContext *txn_context = txn_manager.BeginTransaction();
+
+  // Every thread records the same gets, so the memo must end up with exactly one group per table
+  const uint32_t num_threads = 8;
+  const uint32_t num_tables = 100;
+  std::vector<std::vector<group_id_t>> group_ids(num_threads, std::vector<group_id_t>(num_tables));
+  common::WorkerPool thread_pool(num_threads, {});
+  thread_pool.Startup();
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, [&](uint32_t thread_id) {
+    for (uint32_t table = 0; table < num_tables; table++) {
+      std::vector<std::unique_ptr<AbstractOptimizerNode>> c;
+      auto get = std::make_unique<OperatorNode>(
+          LogicalGet::Make(catalog::db_oid_t(1), catalog::table_oid_t(table), {}, "tbl", false)
+              .RegisterWithTxnContext(txn_context),
+          std::move(c), txn_context);
+      GroupExpression *gexpr;
+      context.RecordOptimizerNodeIntoGroup(common::ManagedPointer<AbstractOptimizerNode>(get.get()), &gexpr);
+      group_ids[thread_id][table] = gexpr->GetGroupID();
+    }
+  });
+
+  EXPECT_EQ(context.GetMemo().GetNumGroups(), num_tables);
+  for (uint32_t thread_id = 1; thread_id < num_threads; thread_id++) {
+    EXPECT_EQ(group_ids[thread_id], group_ids[0]);
+  }
+
+  // All operators created during optimization should be cleaned up on abort
+  txn_manager.Abort(txn_context);
+
+  delete deferred_action_manager;
+  delete buffer_pool;
+  delete txn_context;
+}
+
 // NOLINTNEXTLINE
 TEST_F(OptimizerContextTest, SimpleBindingTest) {
   auto context = OptimizerContext(nullptr);
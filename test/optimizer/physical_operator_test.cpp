@@ -398,13 +398,18 @@ TEST(OperatorTests, OrderByTest) {
 
   transaction::TransactionContext *txn_context = txn_manager.BeginTransaction();
 
-  Operator op1 = OrderBy::Make().RegisterWithTxnContext(txn_context);
+  Operator op1 = OrderBy::Make(2).RegisterWithTxnContext(txn_context);
   EXPECT_EQ(op1.GetOpType(), OpType::ORDERBY);
+  EXPECT_EQ(op1.GetContentsAs<OrderBy>()->GetNumSortKeys(), 2);
 
-  Operator op2 = OrderBy::Make().RegisterWithTxnContext(txn_context);
+  Operator op2 = OrderBy::Make(2).RegisterWithTxnContext(txn_context);
   EXPECT_TRUE(op1 == op2);
   EXPECT_EQ(op1.Hash(), op2.Hash());
 
+  Operator op3 = OrderBy::Make(1).RegisterWithTxnContext(txn_context);
+  EXPECT_FALSE(op1 == op3);
+  EXPECT_NE(op1.Hash(), op3.Hash());
+
   txn_manager.Abort(txn_context);
   delete txn_context;
 }
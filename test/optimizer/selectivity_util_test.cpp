@@ -658,4 +658,36 @@ TEST_F(SelectivityUtilTests, TestEmptyEqual) {
   ASSERT_DOUBLE_EQ(0, res);
 }
 
+// NOLINTNEXTLINE
+TEST_F(SelectivityUtilTests, TestSampledEqualAndLessThan) {
+  // ANALYZE read every tenth block of a 1000 row table: the row counts are extrapolated to the whole table, while the
+  // top-k list and the histogram only summarize the 100 sampled rows. Value i was sampled 10 times for i in [0, 10).
+  auto int_col_stats = std::make_unique<ColumnStats<execution::sql::Integer>>(
+      db_oid_, table1_oid_, table1_int_col_oid_, 1000, 1000, 10, std::make_unique<TopKElements<int64_t>>(),
+      std::make_unique<Histogram<int64_t>>(), type::TypeId::INTEGER);
+  for (int64_t i = 0; i < 10; i++) {
+    int_col_stats->GetTopK()->Increment(i, 10);
+    for (int j = 0; j < 10; j++) int_col_stats->GetHistogram()->Increment(i);
+  }
+  std::vector<std::unique_ptr<ColumnStatsBase>> column_stats;
+  column_stats.emplace_back(std::move(int_col_stats));
+  TableStats sampled_table_stats(db_oid_, table1_oid_, &column_stats);
+
+  auto const_value_expr_ptr =
+      std::make_unique<parser::ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(3));
+  ValueCondition equal_condition(table1_int_col_oid_, "", parser::ExpressionType::COMPARE_EQUAL,
+                                 std::move(const_value_expr_ptr));
+  // Without scaling the sample up to the table, this would be 10 / 1000
+  ASSERT_DOUBLE_EQ(0.1, SelectivityUtil::ComputeSelectivity(sampled_table_stats, equal_condition));
+
+  const_value_expr_ptr =
+      std::make_unique<parser::ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(5));
+  ValueCondition less_condition(table1_int_col_oid_, "", parser::ExpressionType::COMPARE_LESS_THAN,
+                                std::move(const_value_expr_ptr));
+  double res = SelectivityUtil::ComputeSelectivity(sampled_table_stats, less_condition);
+  // Half of the values are below 5, the histogram may be off by a bucket
+  ASSERT_GT(res, 0.3);
+  ASSERT_LT(res, 0.7);
+}
+
 }  // namespace noisepage::optimizer
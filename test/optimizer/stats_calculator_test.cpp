@@ -3,6 +3,8 @@
 #include "gtest/gtest.h"
 #include "optimizer/logical_operators.h"
 #include "optimizer/optimizer_context.h"
+#include "optimizer/statistics/cardinality_feedback.h"
+#include "optimizer/statistics/stats_storage.h"
 #include "parser/expression/column_value_expression.h"
 #include "parser/expression/comparison_expression.h"
 #include "parser/expression/conjunction_expression.h"
@@ -77,6 +79,59 @@ TEST_F(StatsCalculatorTests, TestLogicalGet) {
   EXPECT_TRUE(root_group->HasNumRows());
 }
 
+// NOLINTNEXTLINE
+TEST_F(StatsCalculatorTests, TestLogicalGetCardinalityFeedback) {
+  RunQuery("INSERT INTO " + table_name_1_ + " VALUES(1), (NULL), (3);");
+  RunQuery("ANALYZE " + table_name_1_ + ";");
+  txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  test_txn_ = txn_manager_->BeginTransaction();
+
+  Operator logical_get =
+      LogicalGet::Make(test_db_oid_, table_oid_1_, {}, table_name_1_, false).RegisterWithTxnContext(test_txn_);
+  GroupExpression *gexpr = new GroupExpression(logical_get, {}, test_txn_);
+  gexpr->SetGroupID(group_id_t(1));
+  context_.GetMemo().InsertExpression(gexpr, false);
+  stats_calculator_.CalculateStats(gexpr, &context_);
+
+  auto *root_group = context_.GetMemo().GetGroupByID(gexpr->GetGroupID());
+  EXPECT_EQ(root_group->GetNumRows(), 3);
+  EXPECT_FALSE(root_group->IsCardinalityFromFeedback());
+  const auto signature = root_group->GetCardinalitySignature();
+  EXPECT_NE(signature, CardinalityFeedback::NO_SIGNATURE);
+
+  // Once execution observed a different cardinality, the next optimization of the same scan uses it
+  stats_storage_->GetCardinalityFeedback()->Record(signature, 3, 300);
+
+  OptimizerContext other_context{nullptr};
+  other_context.SetStatsStorage(stats_storage_.Get());
+  other_context.SetCatalogAccessor(accessor_.get());
+  GroupExpression *other_gexpr = new GroupExpression(logical_get, {}, test_txn_);
+  other_gexpr->SetGroupID(group_id_t(1));
+  other_context.GetMemo().InsertExpression(other_gexpr, false);
+  stats_calculator_.CalculateStats(other_gexpr, &other_context);
+
+  auto *other_group = other_context.GetMemo().GetGroupByID(other_gexpr->GetGroupID());
+  EXPECT_EQ(other_group->GetCardinalitySignature(), signature);
+  EXPECT_EQ(other_group->GetNumRows(), 300);
+  EXPECT_TRUE(other_group->IsCardinalityFromFeedback());
+
+  // New statistics invalidate the observation, so the scan is estimated from the statistics again
+  stats_storage_->MarkStatsStale(test_db_oid_, table_oid_1_, {});
+
+  OptimizerContext fresh_context{nullptr};
+  fresh_context.SetStatsStorage(stats_storage_.Get());
+  fresh_context.SetCatalogAccessor(accessor_.get());
+  GroupExpression *fresh_gexpr = new GroupExpression(logical_get, {}, test_txn_);
+  fresh_gexpr->SetGroupID(group_id_t(1));
+  fresh_context.GetMemo().InsertExpression(fresh_gexpr, false);
+  stats_calculator_.CalculateStats(fresh_gexpr, &fresh_context);
+
+  auto *fresh_group = fresh_context.GetMemo().GetGroupByID(fresh_gexpr->GetGroupID());
+  EXPECT_NE(fresh_group->GetCardinalitySignature(), signature);
+  EXPECT_EQ(fresh_group->GetNumRows(), 3);
+  EXPECT_FALSE(fresh_group->IsCardinalityFromFeedback());
+}
+
 // NOLINTNEXTLINE
 TEST_F(StatsCalculatorTests, TestInvalidLogicalGet) {
   // Constructing logical get with no predicates from invalid table
@@ -245,6 +300,46 @@ TEST_F(StatsCalculatorTests, TestLeftSideParamPredicate) {
   EXPECT_TRUE(root_group->HasNumRows());
 }
 
+// NOLINTNEXTLINE
+TEST_F(StatsCalculatorTests, TestGenericParamPredicate) {
+  RunQuery("INSERT INTO " + table_name_1_ + " VALUES(1), (NULL), (3);");
+  RunQuery("ANALYZE " + table_name_1_ + ";");
+  txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  test_txn_ = txn_manager_->BeginTransaction();
+
+  // "colA = param" from "empty_nullable_table" optimized without a value for the parameter
+  parser::ColumnValueExpression col_a(table_name_1_, table_1_col_1_name_, test_db_oid_, table_oid_1_, table_1_col_oid_,
+                                      type::TypeId::INTEGER);
+  auto param = std::make_unique<parser::ParameterValueExpression>(0, type::TypeId::INTEGER);
+  std::vector<std::unique_ptr<parser::AbstractExpression>> equal_child_exprs;
+  equal_child_exprs.emplace_back(col_a.Copy());
+  equal_child_exprs.emplace_back(std::move(param));
+  parser::ComparisonExpression equals(parser::ExpressionType::COMPARE_EQUAL, std::move(equal_child_exprs));
+  common::ManagedPointer<parser::AbstractExpression> equal_expr(&equals);
+  AnnotatedExpression annotated_equals(equal_expr, {});
+
+  Operator logical_get = LogicalGet::Make(test_db_oid_, table_oid_1_, {annotated_equals}, table_name_1_, false)
+                             .RegisterWithTxnContext(test_txn_);
+  GroupExpression *gexpr = new GroupExpression(logical_get, {}, test_txn_);
+  gexpr->SetGroupID(group_id_t(1));
+  context_.GetMemo().InsertExpression(gexpr, false);
+
+  stats_calculator_.CalculateStats(gexpr, &context_);
+
+  // Two thirds of the rows are not null and spread over two distinct values
+  auto *root_group = context_.GetMemo().GetGroupByID(gexpr->GetGroupID());
+  EXPECT_EQ(root_group->GetNumRows(), 1);
+  EXPECT_EQ(root_group->GetCardinalitySignature(), CardinalityFeedback::NO_SIGNATURE);
+
+  auto assumed = context_.TakeParameterSelectivities();
+  ASSERT_EQ(assumed.size(), 1);
+  EXPECT_EQ(assumed[0].param_idx_, 0);
+  EXPECT_EQ(assumed[0].table_oid_, table_oid_1_);
+  EXPECT_EQ(assumed[0].col_oid_, table_1_col_oid_);
+  EXPECT_EQ(assumed[0].type_, parser::ExpressionType::COMPARE_EQUAL);
+  EXPECT_DOUBLE_EQ(assumed[0].selectivity_, 1.0 / 3);
+}
+
 // NOLINTNEXTLINE
 TEST_F(StatsCalculatorTests, TestRightSidePredicate) {
   RunQuery("INSERT INTO " + table_name_1_ + " VALUES(1), (NULL), (3);");
@@ -371,11 +466,72 @@ TEST_F(StatsCalculatorTests, TestMultipleParamPredicate) {
   stats_calculator_.CalculateStats(gexpr, &context_);
 
   auto *root_group = context_.GetMemo().GetGroupByID(gexpr->GetGroupID());
-  // Unfortunately the calculation is not that accurate
-  EXPECT_EQ(root_group->GetNumRows(), 0);
+  // (1, TRUE) is one of the most common combinations of the column group (colA, colB)
+  EXPECT_EQ(root_group->GetNumRows(), 1);
   EXPECT_TRUE(root_group->HasNumRows());
 }
 
+// NOLINTNEXTLINE
+TEST_F(StatsCalculatorTests, TestCorrelatedPredicates) {
+  // colB is true exactly when colA is 1, so the two columns are perfectly correlated
+  RunQuery("INSERT INTO " + table_name_2_ +
+           " VALUES(1, TRUE), (1, TRUE), (1, TRUE), (1, TRUE), (1, TRUE), "
+           "(2, FALSE), (2, FALSE), (2, FALSE), (2, FALSE), (2, FALSE);");
+  RunQuery("ANALYZE " + table_name_2_ + ";");
+  txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  test_txn_ = txn_manager_->BeginTransaction();
+
+  {
+    const auto table_stats_snapshot = stats_storage_->GetTableStats(test_db_oid_, table_oid_2_, accessor_.get());
+    auto group_stats = table_stats_snapshot.table_stats_.GetColumnGroupStats(table_2_col_2_oid_, table_2_col_1_oid_);
+    ASSERT_NE(group_stats, nullptr);
+    EXPECT_EQ(group_stats->GetNumRows(), 10);
+    EXPECT_EQ(group_stats->GetNonNullRows(), 10);
+    EXPECT_EQ(group_stats->GetDistinctValues(), 2);
+    EXPECT_DOUBLE_EQ(group_stats->GetDependencyDegree(2), 1.0);
+  }
+
+  parser::ColumnValueExpression col_a(table_name_2_, table_2_col_1_name_, test_db_oid_, table_oid_2_,
+                                      table_2_col_1_oid_, type::TypeId::INTEGER);
+  parser::ColumnValueExpression col_b(table_name_2_, table_2_col_2_name_, test_db_oid_, table_oid_2_,
+                                      table_2_col_2_oid_, type::TypeId::BOOLEAN);
+
+  // Estimates the number of rows of "colA = a AND colB = b"
+  const auto estimate = [&](int64_t a, bool b) {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> equal1_child_exprs;
+    equal1_child_exprs.emplace_back(col_a.Copy());
+    equal1_child_exprs.emplace_back(
+        std::make_unique<parser::ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(a)));
+    parser::ComparisonExpression equals1(parser::ExpressionType::COMPARE_EQUAL, std::move(equal1_child_exprs));
+    AnnotatedExpression annotated_equals1(common::ManagedPointer<parser::AbstractExpression>(&equals1), {});
+
+    std::vector<std::unique_ptr<parser::AbstractExpression>> equal2_child_exprs;
+    equal2_child_exprs.emplace_back(
+        std::make_unique<parser::ConstantValueExpression>(type::TypeId::BOOLEAN, execution::sql::BoolVal(b)));
+    equal2_child_exprs.emplace_back(col_b.Copy());
+    parser::ComparisonExpression equals2(parser::ExpressionType::COMPARE_EQUAL, std::move(equal2_child_exprs));
+    AnnotatedExpression annotated_equals2(common::ManagedPointer<parser::AbstractExpression>(&equals2), {});
+
+    OptimizerContext context{nullptr};
+    context.SetStatsStorage(stats_storage_.Get());
+    context.SetCatalogAccessor(accessor_.get());
+    Operator logical_get =
+        LogicalGet::Make(test_db_oid_, table_oid_2_, {annotated_equals1, annotated_equals2}, table_name_2_, false)
+            .RegisterWithTxnContext(test_txn_);
+    GroupExpression *gexpr = new GroupExpression(logical_get, {}, test_txn_);
+    gexpr->SetGroupID(group_id_t(1));
+    context.GetMemo().InsertExpression(gexpr, false);
+
+    StatsCalculator stats_calculator;
+    stats_calculator.CalculateStats(gexpr, &context);
+    return context.GetMemo().GetGroupByID(gexpr->GetGroupID())->GetNumRows();
+  };
+
+  // Assuming independence would estimate 10 * 0.5 * 0.5 rows for both
+  EXPECT_EQ(estimate(1, true), 5);
+  EXPECT_EQ(estimate(2, true), 0);
+}
+
 // NOLINTNEXTLINE
 TEST_F(StatsCalculatorTests, TestAndPredicate) {
   RunQuery("INSERT INTO " + table_name_1_ + " VALUES(1), (NULL), (3);");
@@ -24,7 +24,10 @@ TEST_F(StatsStorageTests, EmptyTableTest) {
   auto table_oid = accessor_->GetTableOid(table_name_);
 
   std::vector<catalog::col_oid_t> col_oids{col_oid_};
+  const auto epoch = stats_storage_->GetInvalidationEpoch();
   EXPECT_NO_THROW(stats_storage_->MarkStatsStale(test_db_oid_, table_oid, col_oids));
+  // Plans optimized before are outdated even though the table was never cached
+  EXPECT_EQ(stats_storage_->GetInvalidationEpoch(), epoch + 1);
 
   const auto latched_table_stats_reference = stats_storage_->GetTableStats(test_db_oid_, table_oid, accessor_.get());
   const auto &table_stats = latched_table_stats_reference.table_stats_;
@@ -133,4 +136,93 @@ TEST_F(StatsStorageTests, MultithreadedTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(StatsStorageTests, SnapshotOutlivesRefreshTest) {
+  RunQuery("INSERT INTO " + table_name_ + " VALUES(1), (NULL), (1);");
+  RunQuery("ANALYZE " + table_name_ + ";");
+  txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  test_txn_ = txn_manager_->BeginTransaction();
+
+  auto table_oid = accessor_->GetTableOid(table_name_);
+  const auto old_snapshot = stats_storage_->GetTableStats(test_db_oid_, table_oid, accessor_.get());
+  EXPECT_EQ(old_snapshot.table_stats_.GetNumRows(), 3);
+
+  RunQuery("INSERT INTO " + table_name_ + " VALUES (3);");
+  RunQuery("ANALYZE " + table_name_ + ";");
+  txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  test_txn_ = txn_manager_->BeginTransaction();
+
+  // The refreshed statistics are swapped in without touching the snapshot that is still in use
+  const auto new_snapshot = stats_storage_->GetTableStats(test_db_oid_, table_oid, accessor_.get());
+  EXPECT_EQ(new_snapshot.table_stats_.GetNumRows(), 4);
+  EXPECT_EQ(old_snapshot.table_stats_.GetNumRows(), 3);
+  EXPECT_EQ(old_snapshot.table_stats_.GetColumnStats(col_oid_)->GetNumRows(), 3);
+}
+
+// NOLINTNEXTLINE
+TEST_F(StatsStorageTests, EvictionTest) {
+  std::vector<std::string> test_tables{"empty_table", "empty_nullable_table", "empty_table2"};
+
+  // A budget of zero bytes only ever keeps the most recently loaded table
+  StatsStorage bounded_stats_storage{0};
+  for (const std::string &test_table : test_tables) {
+    const auto snapshot =
+        bounded_stats_storage.GetTableStats(test_db_oid_, accessor_->GetTableOid(test_table), accessor_.get());
+    EXPECT_EQ(snapshot.table_stats_.GetNumRows(), 0);
+    auto keys = bounded_stats_storage.GetTableStatsKeys();
+    ASSERT_EQ(keys.size(), 1);
+    EXPECT_EQ(keys[0].table_oid_, accessor_->GetTableOid(test_table));
+    EXPECT_GT(bounded_stats_storage.GetMemoryUsage(), 0);
+  }
+
+  // A large budget keeps every table
+  StatsStorage unbounded_stats_storage;
+  for (const std::string &test_table : test_tables) {
+    unbounded_stats_storage.GetTableStats(test_db_oid_, accessor_->GetTableOid(test_table), accessor_.get());
+  }
+  EXPECT_EQ(unbounded_stats_storage.GetTableStatsKeys().size(), test_tables.size());
+}
+
+// NOLINTNEXTLINE
+TEST_F(StatsStorageTests, StaleTableInvalidatesFeedbackTest) {
+  auto table_oid = accessor_->GetTableOid(table_name_);
+  const auto feedback = stats_storage_->GetCardinalityFeedback();
+  const auto version = feedback->GetTableVersion(test_db_oid_, table_oid);
+
+  // ANALYZE marks the statistics stale, whether or not they are cached
+  std::vector<catalog::col_oid_t> col_oids{col_oid_};
+  stats_storage_->MarkStatsStale(test_db_oid_, table_oid, col_oids);
+  EXPECT_EQ(feedback->GetTableVersion(test_db_oid_, table_oid), version + 1);
+
+  stats_storage_->GetTableStats(test_db_oid_, table_oid, accessor_.get());
+  stats_storage_->MarkStatsStale(test_db_oid_, table_oid, col_oids);
+  EXPECT_EQ(feedback->GetTableVersion(test_db_oid_, table_oid), version + 2);
+}
+
+// NOLINTNEXTLINE
+TEST_F(StatsStorageTests, InvalidateDuringLoadTest) {
+  auto table_oid = accessor_->GetTableOid(table_name_);
+  std::vector<catalog::col_oid_t> col_oids{col_oid_};
+  StatsStorage stats_storage;
+
+  // A lookup of the uncached table starts loading it, then ANALYZE invalidates the table before the load installs
+  // what it read from the catalog
+  const auto epoch = stats_storage.invalidation_epoch_.load();
+  stats_storage.MarkStatsStale(test_db_oid_, table_oid, col_oids);
+  const auto loaded = stats_storage.LoadTableStats(test_db_oid_, table_oid, 0, epoch, accessor_.get());
+
+  // The loaded snapshot may predate the invalidation, so the next lookup reloads the table instead of serving it
+  const auto reloaded = stats_storage.GetTableStats(test_db_oid_, table_oid, accessor_.get());
+  EXPECT_NE(reloaded.snapshot_, loaded);
+  EXPECT_EQ(stats_storage.GetTableStats(test_db_oid_, table_oid, accessor_.get()).snapshot_, reloaded.snapshot_);
+
+  // A slow load of an uncached table must not replace a snapshot that a later lookup loaded after the invalidation
+  StatsStorage other_stats_storage;
+  const auto slow_epoch = other_stats_storage.invalidation_epoch_.load();
+  other_stats_storage.MarkStatsStale(test_db_oid_, table_oid, col_oids);
+  const auto current = other_stats_storage.GetTableStats(test_db_oid_, table_oid, accessor_.get());
+  other_stats_storage.LoadTableStats(test_db_oid_, table_oid, 0, slow_epoch, accessor_.get());
+  EXPECT_EQ(other_stats_storage.GetTableStats(test_db_oid_, table_oid, accessor_.get()).snapshot_, current.snapshot_);
+}
+
 }  // namespace noisepage::optimizer
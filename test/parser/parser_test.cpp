@@ -76,6 +76,25 @@ TEST_F(ParserTestBase, CopyTest) {
   auto copy_stmt = result->GetStatement(0).CastManagedPointerTo<CopyStatement>();
   EXPECT_EQ(copy_stmt->GetType(), StatementType::COPY);
   EXPECT_EQ(copy_stmt->GetExternalFileFormat(), ExternalFileFormat::BINARY);
+
+  // The text format is the default, and it delimits columns with tabs
+  result = parser::PostgresParser::BuildParseTree("COPY foo FROM STDIN;");
+  copy_stmt = result->GetStatement(0).CastManagedPointerTo<CopyStatement>();
+  EXPECT_TRUE(copy_stmt->IsStdio());
+  EXPECT_TRUE(copy_stmt->IsFrom());
+  EXPECT_EQ(copy_stmt->GetExternalFileFormat(), ExternalFileFormat::TEXT);
+  EXPECT_EQ(copy_stmt->GetDelimiter(), '\t');
+
+  // COPY table TO is turned into COPY (SELECT columns FROM table) TO
+  result = parser::PostgresParser::BuildParseTree("COPY foo (a, b) TO STDOUT WITH (FORMAT csv);");
+  copy_stmt = result->GetStatement(0).CastManagedPointerTo<CopyStatement>();
+  EXPECT_FALSE(copy_stmt->IsFrom());
+  EXPECT_EQ(copy_stmt->GetCopyTable(), nullptr);
+  EXPECT_EQ(copy_stmt->GetColumns(), std::vector<std::string>({"a", "b"}));
+  EXPECT_EQ(copy_stmt->GetSelectStatement()->GetSelectTable()->GetTableName(), "foo");
+  EXPECT_EQ(copy_stmt->GetSelectStatement()->GetSelectColumns().size(), 2);
+  EXPECT_EQ(copy_stmt->GetExternalFileFormat(), ExternalFileFormat::CSV);
+  EXPECT_EQ(copy_stmt->GetDelimiter(), ',');
 }
 
 // NOLINTNEXTLINE
@@ -1774,4 +1793,25 @@ TEST_F(ParserTestBase, OldTypeCastInExpressionTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, ArenaTest) {
+  // The parse tree comes from the parse result's arena
+  auto result = parser::PostgresParser::BuildParseTree("SELECT a, b + 1 FROM foo WHERE c = 2 ORDER BY a LIMIT 3;");
+  EXPECT_GT(result->GetArena()->Allocated(), 0);
+
+  // Nodes created after parsing, e.g., by the binder, do not come from the arena
+  const auto allocated = result->GetArena()->Allocated();
+  result->AddExpression(std::make_unique<ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(1)));
+  EXPECT_EQ(allocated, result->GetArena()->Allocated());
+
+  // A statement whose ownership is taken out of the parse result outlives it
+  auto statement = std::move(result->TakeStatementsOwnership()[0]);
+  result.reset();
+  auto select = common::ManagedPointer(statement).CastManagedPointerTo<SelectStatement>();
+  EXPECT_EQ(select->GetSelectColumns().size(), 2);
+  EXPECT_EQ(select->GetSelectTable()->GetTableName(), "foo");
+  EXPECT_EQ(select->GetSelectCondition()->GetExpressionType(), ExpressionType::COMPARE_EQUAL);
+  EXPECT_EQ(select->GetSelectLimit()->GetLimit(), 3);
+}
+
 }  // namespace noisepage::parser
@@ -0,0 +1,299 @@
+#include "storage/recovery/index_expression_evaluator.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/index_schema.h"
+#include "catalog/schema.h"
+#include "common/allocator.h"
+#include "gtest/gtest.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/comparison_expression.h"
+#include "parser/expression/conjunction_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/function_expression.h"
+#include "parser/expression/operator_expression.h"
+#include "storage/index/index.h"
+#include "storage/index/index_builder.h"
+#include "storage/sql_table.h"
+#include "test_util/storage_test_util.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage {
+
+class IndexExpressionEvaluatorTests : public TerrierTest {
+ public:
+  void SetUp() override {
+    std::vector<catalog::Schema::Column> cols;
+    cols.emplace_back("id", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+    cols.emplace_back("name", type::TypeId::VARCHAR, 32, true, parser::ConstantValueExpression(type::TypeId::VARCHAR));
+    cols.emplace_back("score", type::TypeId::REAL, true, parser::ConstantValueExpression(type::TypeId::REAL));
+    for (uint32_t i = 0; i < cols.size(); i++) StorageTestUtil::ForceOid(&cols[i], catalog::col_oid_t(i + 1));
+    schema_ = std::make_unique<catalog::Schema>(cols);
+    table_ = std::make_unique<SqlTable>(common::ManagedPointer(&block_store_), *schema_);
+
+    const std::vector<catalog::col_oid_t> col_oids{ID, NAME, SCORE};
+    auto initializer = table_->InitializerForProjectedRow(col_oids);
+    buffer_ = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    table_pr_ = initializer.InitializeRow(buffer_);
+    pr_map_ = table_->ProjectionMapForOids(col_oids);
+  }
+
+  void TearDown() override { delete[] buffer_; }
+
+ protected:
+  static constexpr catalog::col_oid_t ID{1};
+  static constexpr catalog::col_oid_t NAME{2};
+  static constexpr catalog::col_oid_t SCORE{3};
+
+  void SetRow(int32_t id, std::optional<std::string_view> name, std::optional<double> score) {
+    *reinterpret_cast<int32_t *>(table_pr_->AccessForceNotNull(pr_map_.at(ID))) = id;
+    if (name.has_value()) {
+      *reinterpret_cast<VarlenEntry *>(table_pr_->AccessForceNotNull(pr_map_.at(NAME))) = VarlenEntry::Create(*name);
+    } else {
+      table_pr_->SetNull(pr_map_.at(NAME));
+    }
+    if (score.has_value()) {
+      *reinterpret_cast<double *>(table_pr_->AccessForceNotNull(pr_map_.at(SCORE))) = *score;
+    } else {
+      table_pr_->SetNull(pr_map_.at(SCORE));
+    }
+  }
+
+  IndexExpressionEvaluator Evaluator() const { return IndexExpressionEvaluator(*schema_, *table_pr_, pr_map_); }
+
+  std::unique_ptr<parser::AbstractExpression> Col(catalog::col_oid_t oid) const {
+    return std::make_unique<parser::ColumnValueExpression>(catalog::table_oid_t(1), oid,
+                                                           schema_->GetColumn(oid).Type());
+  }
+
+  static std::unique_ptr<parser::AbstractExpression> Int(int64_t value) {
+    return std::make_unique<parser::ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(value));
+  }
+
+  static std::unique_ptr<parser::AbstractExpression> Real(double value) {
+    return std::make_unique<parser::ConstantValueExpression>(type::TypeId::REAL, execution::sql::Real(value));
+  }
+
+  static std::unique_ptr<parser::AbstractExpression> Make(parser::ExpressionType type, type::TypeId return_type,
+                                                          std::unique_ptr<parser::AbstractExpression> lhs,
+                                                          std::unique_ptr<parser::AbstractExpression> rhs = nullptr) {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+    children.emplace_back(std::move(lhs));
+    if (rhs != nullptr) children.emplace_back(std::move(rhs));
+    switch (type) {
+      case parser::ExpressionType::CONJUNCTION_AND:
+      case parser::ExpressionType::CONJUNCTION_OR:
+        return std::make_unique<parser::ConjunctionExpression>(type, std::move(children));
+      case parser::ExpressionType::COMPARE_EQUAL:
+      case parser::ExpressionType::COMPARE_LESS_THAN:
+      case parser::ExpressionType::COMPARE_GREATER_THAN:
+        return std::make_unique<parser::ComparisonExpression>(type, std::move(children));
+      default:
+        return std::make_unique<parser::OperatorExpression>(type, return_type, std::move(children));
+    }
+  }
+
+  static std::unique_ptr<parser::AbstractExpression> Function(std::string name,
+                                                              std::unique_ptr<parser::AbstractExpression> arg) {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+    children.emplace_back(std::move(arg));
+    return std::make_unique<parser::FunctionExpression>(std::move(name), type::TypeId::VARCHAR, std::move(children));
+  }
+
+  static common::ManagedPointer<const parser::AbstractExpression> Ptr(
+      const std::unique_ptr<parser::AbstractExpression> &expr) {
+    return common::ManagedPointer<const parser::AbstractExpression>(expr.get());
+  }
+
+  static catalog::IndexSchema PartialSchema(std::unique_ptr<parser::AbstractExpression> key,
+                                            std::unique_ptr<parser::AbstractExpression> predicate) {
+    std::vector<catalog::IndexSchema::Column> keycols;
+    keycols.emplace_back("", key->GetReturnValueType(), false, *key);
+    StorageTestUtil::ForceOid(&(keycols[0]), catalog::indexkeycol_oid_t(1));
+    return catalog::IndexSchema(keycols, index::IndexType::BPLUSTREE, false, false, false, true,
+                                catalog::IndexOptions(), std::move(predicate));
+  }
+
+  BlockStore block_store_{10, 10};
+  std::unique_ptr<catalog::Schema> schema_;
+  std::unique_ptr<SqlTable> table_;
+  byte *buffer_ = nullptr;
+  ProjectedRow *table_pr_ = nullptr;
+  ProjectionMap pr_map_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(IndexExpressionEvaluatorTests, IsSupportedTest) {
+  using Type = parser::ExpressionType;
+  EXPECT_TRUE(IndexExpressionEvaluator::IsSupported(Ptr(Function("lower", Col(NAME)))));
+  EXPECT_TRUE(IndexExpressionEvaluator::IsSupported(
+      Ptr(Make(Type::OPERATOR_PLUS, type::TypeId::INTEGER, Col(ID), Int(1)))));
+  EXPECT_TRUE(IndexExpressionEvaluator::IsSupported(Ptr(Make(
+      Type::CONJUNCTION_AND, type::TypeId::BOOLEAN, Make(Type::OPERATOR_IS_NOT_NULL, type::TypeId::BOOLEAN, Col(SCORE)),
+      Make(Type::COMPARE_LESS_THAN, type::TypeId::BOOLEAN, Col(ID), Int(10))))));
+
+  // Anything outside of the interpreted subset, even nested, must be rejected up front
+  EXPECT_FALSE(IndexExpressionEvaluator::IsSupported(Ptr(Function("md5", Col(NAME)))));
+  EXPECT_FALSE(IndexExpressionEvaluator::IsSupported(
+      Ptr(Make(Type::OPERATOR_DIVIDE, type::TypeId::INTEGER, Col(ID), Int(2)))));
+  EXPECT_FALSE(IndexExpressionEvaluator::IsSupported(
+      Ptr(Make(Type::OPERATOR_PLUS, type::TypeId::VARCHAR, Col(NAME), Col(NAME)))));
+  EXPECT_FALSE(IndexExpressionEvaluator::IsSupported(Ptr(Make(
+      Type::COMPARE_EQUAL, type::TypeId::BOOLEAN, Function("lower", Function("md5", Col(NAME))), Col(NAME)))));
+  EXPECT_FALSE(IndexExpressionEvaluator::IsSupported(
+      Ptr(std::make_unique<parser::ColumnValueExpression>(catalog::table_oid_t(1), ID, type::TypeId::DECIMAL))));
+
+  EXPECT_TRUE(IndexExpressionEvaluator::IsSupported(PartialSchema(
+      Function("upper", Col(NAME)), Make(Type::COMPARE_GREATER_THAN, type::TypeId::BOOLEAN, Col(ID), Int(0)))));
+  EXPECT_FALSE(IndexExpressionEvaluator::IsSupported(
+      PartialSchema(Col(ID), Make(Type::COMPARE_EQUAL, type::TypeId::BOOLEAN, Function("md5", Col(NAME)), Col(NAME)))));
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexExpressionEvaluatorTests, ArithmeticTest) {
+  using Type = parser::ExpressionType;
+  SetRow(20, "Bob", 1.5);
+
+  // id * 2 + 1
+  auto int_expr = Make(Type::OPERATOR_PLUS, type::TypeId::INTEGER,
+                       Make(Type::OPERATOR_MULTIPLY, type::TypeId::INTEGER, Col(ID), Int(2)), Int(1));
+  auto value = Evaluator().Evaluate(Ptr(int_expr));
+  ASSERT_FALSE(value.IsNull());
+  EXPECT_EQ(value.Peek<int64_t>(), 41);
+
+  // -(score - 4)
+  auto real_expr = Make(Type::OPERATOR_UNARY_MINUS, type::TypeId::REAL,
+                        Make(Type::OPERATOR_MINUS, type::TypeId::REAL, Col(SCORE), Int(4)));
+  value = Evaluator().Evaluate(Ptr(real_expr));
+  ASSERT_FALSE(value.IsNull());
+  EXPECT_DOUBLE_EQ(value.Peek<double>(), 2.5);
+
+  // NULL propagates through arithmetic
+  SetRow(20, "Bob", std::nullopt);
+  EXPECT_TRUE(Evaluator().Evaluate(Ptr(real_expr)).IsNull());
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexExpressionEvaluatorTests, StringFunctionTest) {
+  SetRow(1, "MiXeD CaSe and longer than inline", std::nullopt);
+  auto lower = Function("lower", Col(NAME));
+  auto upper = Function("upper", Col(NAME));
+  EXPECT_EQ(Evaluator().Evaluate(Ptr(lower)).Peek<std::string_view>(), "mixed case and longer than inline");
+  EXPECT_EQ(Evaluator().Evaluate(Ptr(upper)).Peek<std::string_view>(), "MIXED CASE AND LONGER THAN INLINE");
+
+  SetRow(1, std::nullopt, std::nullopt);
+  EXPECT_TRUE(Evaluator().Evaluate(Ptr(lower)).IsNull());
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexExpressionEvaluatorTests, ThreeValuedLogicTest) {
+  using Type = parser::ExpressionType;
+  SetRow(5, "Bob", std::nullopt);
+  auto score_gt = [this] { return Make(Type::COMPARE_GREATER_THAN, type::TypeId::BOOLEAN, Col(SCORE), Real(1.0)); };
+  auto id_lt = [this](int64_t value) {
+    return Make(Type::COMPARE_LESS_THAN, type::TypeId::BOOLEAN, Col(ID), Int(value));
+  };
+
+  // Comparing against NULL is NULL, and so is its negation
+  auto null_cmp = score_gt();
+  EXPECT_TRUE(Evaluator().Evaluate(Ptr(null_cmp)).IsNull());
+  auto not_null_cmp = Make(Type::OPERATOR_NOT, type::TypeId::BOOLEAN, score_gt());
+  EXPECT_TRUE(Evaluator().Evaluate(Ptr(not_null_cmp)).IsNull());
+
+  // FALSE AND NULL is FALSE, TRUE AND NULL is NULL
+  auto false_and = Make(Type::CONJUNCTION_AND, type::TypeId::BOOLEAN, score_gt(), id_lt(0));
+  auto value = Evaluator().Evaluate(Ptr(false_and));
+  ASSERT_FALSE(value.IsNull());
+  EXPECT_FALSE(value.Peek<bool>());
+  auto true_and = Make(Type::CONJUNCTION_AND, type::TypeId::BOOLEAN, score_gt(), id_lt(10));
+  EXPECT_TRUE(Evaluator().Evaluate(Ptr(true_and)).IsNull());
+
+  // TRUE OR NULL is TRUE, FALSE OR NULL is NULL
+  auto true_or = Make(Type::CONJUNCTION_OR, type::TypeId::BOOLEAN, score_gt(), id_lt(10));
+  value = Evaluator().Evaluate(Ptr(true_or));
+  ASSERT_FALSE(value.IsNull());
+  EXPECT_TRUE(value.Peek<bool>());
+  auto false_or = Make(Type::CONJUNCTION_OR, type::TypeId::BOOLEAN, score_gt(), id_lt(0));
+  EXPECT_TRUE(Evaluator().Evaluate(Ptr(false_or)).IsNull());
+
+  // Null tests are never NULL
+  auto is_null = Make(Type::OPERATOR_IS_NULL, type::TypeId::BOOLEAN, Col(SCORE));
+  EXPECT_TRUE(Evaluator().Evaluate(Ptr(is_null)).Peek<bool>());
+  auto is_not_null = Make(Type::OPERATOR_IS_NOT_NULL, type::TypeId::BOOLEAN, Col(NAME));
+  EXPECT_TRUE(Evaluator().Evaluate(Ptr(is_not_null)).Peek<bool>());
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexExpressionEvaluatorTests, SatisfiesPredicateTest) {
+  using Type = parser::ExpressionType;
+  // Index on lower(name) WHERE id < 100 AND score IS NOT NULL
+  auto schema = PartialSchema(Function("lower", Col(NAME)),
+                              Make(Type::CONJUNCTION_AND, type::TypeId::BOOLEAN,
+                                   Make(Type::COMPARE_LESS_THAN, type::TypeId::BOOLEAN, Col(ID), Int(100)),
+                                   Make(Type::OPERATOR_IS_NOT_NULL, type::TypeId::BOOLEAN, Col(SCORE))));
+
+  SetRow(1, "Bob", 2.0);
+  EXPECT_TRUE(Evaluator().SatisfiesPredicate(schema));
+  SetRow(100, "Bob", 2.0);
+  EXPECT_FALSE(Evaluator().SatisfiesPredicate(schema));
+  SetRow(1, "Bob", std::nullopt);
+  EXPECT_FALSE(Evaluator().SatisfiesPredicate(schema));
+
+  // A predicate that evaluates to NULL excludes the tuple
+  auto null_schema = PartialSchema(
+      Col(ID), Make(Type::COMPARE_GREATER_THAN, type::TypeId::BOOLEAN, Col(SCORE), Real(0.0)));
+  EXPECT_FALSE(Evaluator().SatisfiesPredicate(null_schema));
+
+  // Every tuple belongs in an index that is not partial
+  auto full_schema = PartialSchema(Col(ID), nullptr);
+  EXPECT_TRUE(Evaluator().SatisfiesPredicate(full_schema));
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexExpressionEvaluatorTests, WriteKeyTest) {
+  std::vector<catalog::IndexSchema::Column> keycols;
+  keycols.emplace_back("", type::TypeId::INTEGER, true, *Col(ID));
+  keycols.emplace_back("", type::TypeId::BIGINT, true, *Col(ID));
+  keycols.emplace_back("", type::TypeId::VARCHAR, 32, true, *Col(NAME));
+  for (uint32_t i = 0; i < keycols.size(); i++) {
+    StorageTestUtil::ForceOid(&(keycols[i]), catalog::indexkeycol_oid_t(i + 1));
+  }
+  const catalog::IndexSchema schema(keycols, index::IndexType::BPLUSTREE, false, false, false, true,
+                                    catalog::IndexOptions());
+  std::unique_ptr<index::Index> index(index::IndexBuilder().SetKeySchema(schema).Build());
+  const auto &offsets = index->GetKeyOidToOffsetMap();
+  const auto int_key = offsets.at(catalog::indexkeycol_oid_t(1));
+  const auto bigint_key = offsets.at(catalog::indexkeycol_oid_t(2));
+  const auto varchar_key = offsets.at(catalog::indexkeycol_oid_t(3));
+  byte *key_buffer = common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+  auto *key = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+
+  // Values are narrowed or widened to the width of the key column
+  const parser::ConstantValueExpression big(type::TypeId::BIGINT, execution::sql::Integer(42));
+  IndexExpressionEvaluator::WriteKey(big, type::TypeId::INTEGER, int_key, key);
+  EXPECT_EQ(*reinterpret_cast<int32_t *>(key->AccessWithNullCheck(int_key)), 42);
+  const parser::ConstantValueExpression small(type::TypeId::INTEGER, execution::sql::Integer(-7));
+  IndexExpressionEvaluator::WriteKey(small, type::TypeId::BIGINT, bigint_key, key);
+  EXPECT_EQ(*reinterpret_cast<int64_t *>(key->AccessWithNullCheck(bigint_key)), -7);
+
+  // Varlen keys reference the evaluated value
+  SetRow(1, "a string that does not fit inline", std::nullopt);
+  auto lower = Function("lower", Col(NAME));
+  const auto value = Evaluator().Evaluate(Ptr(lower));
+  IndexExpressionEvaluator::WriteKey(value, type::TypeId::VARCHAR, varchar_key, key);
+  EXPECT_EQ(reinterpret_cast<VarlenEntry *>(key->AccessWithNullCheck(varchar_key))->StringView(),
+            "a string that does not fit inline");
+
+  // NULL values produce NULL keys
+  IndexExpressionEvaluator::WriteKey(parser::ConstantValueExpression(type::TypeId::INTEGER), type::TypeId::INTEGER,
+                                     int_key, key);
+  EXPECT_EQ(key->AccessWithNullCheck(int_key), nullptr);
+
+  delete[] key_buffer;
+}
+
+}  // namespace noisepage::storage
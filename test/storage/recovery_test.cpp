@@ -7,7 +7,11 @@
 #include "catalog/postgres/pg_namespace.h"
 #include "gtest/gtest.h"
 #include "main/db_main.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/comparison_expression.h"
+#include "parser/expression/operator_expression.h"
 #include "storage/garbage_collector_thread.h"
+#include "storage/index/index.h"
 #include "storage/index/index_builder.h"
 #include "storage/recovery/disk_log_provider.h"
 #include "storage/recovery/recovery_manager.h"
@@ -154,6 +158,11 @@ class RecoveryTests : public TerrierTest {
 
   storage::RedoBuffer &GetRedoBuffer(transaction::TransactionContext *txn) { return txn->redo_buffer_; }
 
+  void LockCatalogForReplay(RecoveryManager *recovery_manager, transaction::TransactionContext *txn,
+                            const LogRecord *record) {
+    recovery_manager->LockCatalogForReplay(txn, record);
+  }
+
   storage::BlockLayout &GetBlockLayout(common::ManagedPointer<storage::SqlTable> table) const {
     return table->table_.layout_;
   }
@@ -378,6 +387,147 @@ TEST_F(RecoveryTests, DropIndexTest) {
   recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+// Tests that recovery rebuilds a partial index on an expression by evaluating its definition on the replayed tuples.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, PartialExpressionIndexTest) {
+  std::string database_name = "testdb";
+  auto namespace_oid = catalog::postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID;
+  std::string table_name = "testtable";
+  std::string index_name = "testindex";
+  const uint32_t num_tuples = 20;
+  const uint32_t predicate_bound = 10;
+
+  // Create database, table and an index on (attribute * 2) WHERE attribute < 10
+  auto *txn = txn_manager_->BeginTransaction();
+  auto db_oid = CreateDatabase(txn, catalog_, database_name);
+  auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  auto table_oid = CreateTable(txn, db_catalog, namespace_oid, table_name);
+  const auto col_oid = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid).GetColumn(0).Oid();
+
+  std::vector<std::unique_ptr<parser::AbstractExpression>> key_children;
+  key_children.emplace_back(
+      std::make_unique<parser::ColumnValueExpression>(table_oid, col_oid, type::TypeId::INTEGER));
+  key_children.emplace_back(
+      std::make_unique<parser::ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(2)));
+  parser::OperatorExpression key_expr(parser::ExpressionType::OPERATOR_MULTIPLY, type::TypeId::INTEGER,
+                                      std::move(key_children));
+  std::vector<std::unique_ptr<parser::AbstractExpression>> predicate_children;
+  predicate_children.emplace_back(
+      std::make_unique<parser::ColumnValueExpression>(table_oid, col_oid, type::TypeId::INTEGER));
+  predicate_children.emplace_back(std::make_unique<parser::ConstantValueExpression>(
+      type::TypeId::INTEGER, execution::sql::Integer(static_cast<int64_t>(predicate_bound))));
+  auto predicate = std::make_unique<parser::ComparisonExpression>(parser::ExpressionType::COMPARE_LESS_THAN,
+                                                                  std::move(predicate_children));
+
+  std::vector<catalog::IndexSchema::Column> keycols;
+  keycols.emplace_back("", type::TypeId::INTEGER, false, key_expr);
+  StorageTestUtil::ForceOid(&(keycols[0]), catalog::indexkeycol_oid_t(1));
+  catalog::IndexSchema index_schema(keycols, storage::index::IndexType::BPLUSTREE, false, false, false, true,
+                                    catalog::IndexOptions(), std::move(predicate));
+  auto index_oid =
+      db_catalog->CreateIndex(common::ManagedPointer(txn), namespace_oid, index_name, table_oid, index_schema);
+  EXPECT_NE(index_oid, catalog::INVALID_INDEX_OID);
+  auto *index_ptr = storage::index::IndexBuilder().SetKeySchema(index_schema).Build();
+  EXPECT_TRUE(db_catalog->SetIndexPointer(common::ManagedPointer(txn), index_oid, index_ptr));
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Insert 0, 1, ..., num_tuples - 1. Only the first predicate_bound tuples belong in the index.
+  txn = txn_manager_->BeginTransaction();
+  db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  auto table_ptr = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+  auto initializer = table_ptr->InitializerForProjectedRow({col_oid});
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    auto *redo_record = txn->StageWrite(db_oid, table_oid, initializer);
+    *reinterpret_cast<int32_t *>(redo_record->Delta()->AccessForceNotNull(0)) = static_cast<int32_t>(i);
+    table_ptr->Insert(common::ManagedPointer(txn), redo_record);
+  }
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  ShutdownAndRestartSystem();
+
+  // Instantiate recovery manager, and recover the catalog
+  SingleRecovery();
+
+  txn = recovery_txn_manager_->BeginTransaction();
+  db_catalog = recovery_catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  ASSERT_TRUE(db_catalog);
+  EXPECT_EQ(index_oid, db_catalog->GetIndexOid(common::ManagedPointer(txn), namespace_oid, index_name));
+  EXPECT_TRUE(db_catalog->GetIndexSchema(common::ManagedPointer(txn), index_oid).IsPartial());
+  auto index = db_catalog->GetIndex(common::ManagedPointer(txn), index_oid);
+  ASSERT_TRUE(index);
+
+  // Tuples failing the predicate were left out
+  std::vector<storage::TupleSlot> slots;
+  index->ScanAscending(*txn, storage::index::ScanType::OpenBoth, 1, nullptr, nullptr, 0, &slots);
+  EXPECT_EQ(slots.size(), predicate_bound);
+
+  // Keys were computed from the expression, not copied from the column
+  auto *key_buffer = common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+  auto *key = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+  const auto key_offset = index->GetKeyOidToOffsetMap().at(catalog::indexkeycol_oid_t(1));
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    *reinterpret_cast<int32_t *>(key->AccessForceNotNull(key_offset)) = static_cast<int32_t>(2 * i);
+    slots.clear();
+    index->ScanKey(*txn, *key, &slots);
+    EXPECT_EQ(slots.size(), i < predicate_bound ? 1 : 0);
+  }
+  delete[] key_buffer;
+  recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+// Tests that replaying a change to the catalog tables takes the DDL lock of the database, so that queries on the
+// recovering system do not use the metadata snapshot the change makes stale.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, LockCatalogForReplayTest) {
+  auto *txn = recovery_txn_manager_->BeginTransaction();
+  auto db_oid = CreateDatabase(txn, recovery_catalog_, "testdb");
+  recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  DiskLogProvider log_provider(RECOVERY_TEST_LOG_FILE_NAME);
+  RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_};
+
+  auto *reader_txn = recovery_txn_manager_->BeginTransaction();
+  auto db_catalog = recovery_catalog_->GetDatabaseCatalog(common::ManagedPointer(reader_txn), db_oid);
+  EXPECT_NE(db_catalog->GetSnapshot(common::ManagedPointer(reader_txn)), nullptr);
+
+  auto *replay_txn = recovery_txn_manager_->BeginTransaction();
+  auto *buffer = common::AllocationUtil::AllocateAligned(DeleteRecord::Size());
+
+  // Changes to user tables are not DDL
+  auto *record = DeleteRecord::Initialize(buffer, replay_txn->StartTime(), db_oid,
+                                          catalog::table_oid_t(catalog::START_OID), TupleSlot());
+  LockCatalogForReplay(&recovery_manager, replay_txn, record);
+  EXPECT_FALSE(db_catalog->IsLockedBy(common::ManagedPointer(replay_txn)));
+
+  // Changes to catalog tables, which all have OIDs below START_OID, are
+  record = DeleteRecord::Initialize(buffer, replay_txn->StartTime(), db_oid,
+                                    catalog::table_oid_t(catalog::START_OID - 1), TupleSlot());
+  LockCatalogForReplay(&recovery_manager, replay_txn, record);
+  EXPECT_TRUE(db_catalog->IsLockedBy(common::ManagedPointer(replay_txn)));
+  delete[] buffer;
+
+  // Queries that start while the change is replayed do not use any snapshot
+  auto *concurrent_txn = recovery_txn_manager_->BeginTransaction();
+  EXPECT_EQ(db_catalog->GetSnapshot(common::ManagedPointer(concurrent_txn)), nullptr);
+  recovery_txn_manager_->Commit(replay_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Queries that start after the replayed change commits use a new snapshot of its version
+  auto *later_txn = recovery_txn_manager_->BeginTransaction();
+  const auto snapshot = db_catalog->GetSnapshot(common::ManagedPointer(later_txn));
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->Version(), replay_txn->FinishTime());
+
+  recovery_txn_manager_->Commit(reader_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  recovery_txn_manager_->Commit(concurrent_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  recovery_txn_manager_->Commit(later_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 // Tests that we correctly process records corresponding to a drop namespace command.
 // NOLINTNEXTLINE
 TEST_F(RecoveryTests, DropNamespaceTest) {
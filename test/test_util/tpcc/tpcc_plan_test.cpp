@@ -80,6 +80,10 @@ void TpccPlanTest::SetUp() {
 
 void TpccPlanTest::TearDown() { delete tpcc_db_; }
 
+std::unique_ptr<optimizer::AbstractCostModel> TpccPlanTest::MakeCostModel() {
+  return std::make_unique<optimizer::TrivialCostModel>();
+}
+
 void TpccPlanTest::BeginTransaction() {
   txn_ = txn_manager_->BeginTransaction();
   accessor_ = catalog_->GetAccessor(common::ManagedPointer(txn_), db_, DISABLED).release();
@@ -107,7 +111,7 @@ std::unique_ptr<planner::AbstractPlanNode> TpccPlanTest::Optimize(const std::str
   delete binder;
   delete transformer;
 
-  auto optimizer = new optimizer::Optimizer(std::make_unique<optimizer::TrivialCostModel>(), task_execution_timeout_);
+  auto optimizer = new optimizer::Optimizer(MakeCostModel(), task_execution_timeout_);
   std::unique_ptr<optimizer::OptimizeResult> optimize_result;
   if (stmt_type == parser::StatementType::SELECT) {
     auto sel_stmt = stmt_list->GetStatement(0).CastManagedPointerTo<parser::SelectStatement>();
@@ -0,0 +1,161 @@
+#include "traffic_cop/admission_controller.h"
+
+#include <chrono>  // NOLINT
+#include <memory>
+#include <mutex>   // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "execution/sql/value.h"
+#include "gtest/gtest.h"
+#include "parser/expression/constant_value_expression.h"
+#include "planner/plannodes/order_by_plan_node.h"
+#include "planner/plannodes/output_schema.h"
+#include "planner/plannodes/plan_meta_data.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::trafficcop {
+
+class AdmissionControllerTests : public TerrierTest {
+ protected:
+  /** Spin until the queue of the class holds the given number of queries */
+  static void WaitForQueueDepth(const AdmissionController &controller, const WorkloadClass workload_class,
+                                const uint64_t depth) {
+    while (controller.GetQueueDepth(workload_class) != depth) std::this_thread::yield();
+  }
+
+  static std::unique_ptr<planner::OutputSchema> BuildOneColumnSchema(std::string name, const type::TypeId type) {
+    auto expr = std::make_unique<parser::ConstantValueExpression>(type::TypeId::BOOLEAN, execution::sql::BoolVal(true));
+    std::vector<planner::OutputSchema::Column> cols;
+    cols.emplace_back(planner::OutputSchema::Column(std::move(name), type, std::move(expr)));
+    return std::make_unique<planner::OutputSchema>(std::move(cols));
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(AdmissionControllerTests, SlotTest) {
+  AdmissionController controller(2, 1, 1000.0, 0, std::chrono::milliseconds(0));
+  EXPECT_EQ(controller.Classify(10.0), WorkloadClass::OLTP);
+  EXPECT_EQ(controller.Classify(1000.0), WorkloadClass::ANALYTIC);
+
+  auto oltp1 = controller.Admit(WorkloadClass::OLTP, 0);
+  auto oltp2 = controller.Admit(WorkloadClass::OLTP, 0);
+  EXPECT_TRUE(oltp1.IsAdmitted());
+  EXPECT_TRUE(oltp2.IsAdmitted());
+  EXPECT_EQ(controller.GetNumRunning(WorkloadClass::OLTP), 2);
+
+  // The OLTP slots are taken, which does not keep an analytic query from running
+  EXPECT_FALSE(controller.Admit(WorkloadClass::OLTP, 0).IsAdmitted());
+  EXPECT_EQ(controller.GetNumTimedOut(WorkloadClass::OLTP), 1);
+  auto analytic = controller.Admit(WorkloadClass::ANALYTIC, 0);
+  EXPECT_TRUE(analytic.IsAdmitted());
+  EXPECT_FALSE(controller.Admit(WorkloadClass::ANALYTIC, 0).IsAdmitted());
+
+  // Releasing a ticket, explicitly or by destroying it, frees its slot
+  oltp1.Release();
+  EXPECT_FALSE(oltp1.IsAdmitted());
+  EXPECT_EQ(controller.GetNumRunning(WorkloadClass::OLTP), 1);
+  { auto moved = std::move(oltp2); }
+  EXPECT_EQ(controller.GetNumRunning(WorkloadClass::OLTP), 0);
+  EXPECT_TRUE(controller.Admit(WorkloadClass::OLTP, 0).IsAdmitted());
+}
+
+// NOLINTNEXTLINE
+TEST_F(AdmissionControllerTests, QueueTest) {
+  AdmissionController controller(1, 1, 1000.0, 0, std::chrono::minutes(1));
+  auto running = controller.Admit(WorkloadClass::OLTP, 0);
+  ASSERT_TRUE(running.IsAdmitted());
+
+  // Queries that wait for the slot are admitted in the order in which they arrived
+  std::mutex order_mutex;
+  std::vector<uint32_t> order;
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < 3; i++) {
+    threads.emplace_back([&, i] {
+      auto ticket = controller.Admit(WorkloadClass::OLTP, 0);
+      EXPECT_TRUE(ticket.IsAdmitted());
+      EXPECT_EQ(ticket.GetQueueDepth(), i);
+      std::lock_guard<std::mutex> guard(order_mutex);
+      order.emplace_back(i);
+    });
+    WaitForQueueDepth(controller, WorkloadClass::OLTP, i + 1);
+  }
+
+  running.Release();
+  for (auto &thread : threads) thread.join();
+  EXPECT_EQ(order, std::vector<uint32_t>({0, 1, 2}));
+  EXPECT_EQ(controller.GetQueueDepth(WorkloadClass::OLTP), 0);
+  EXPECT_EQ(controller.GetNumRunning(WorkloadClass::OLTP), 0);
+  EXPECT_GT(controller.GetTotalWaitTime(WorkloadClass::OLTP).count(), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AdmissionControllerTests, TimeoutTest) {
+  AdmissionController controller(1, 1, 1000.0, 0, std::chrono::milliseconds(50));
+  auto running = controller.Admit(WorkloadClass::ANALYTIC, 0);
+
+  const auto ticket = controller.Admit(WorkloadClass::ANALYTIC, 0);
+  EXPECT_FALSE(ticket.IsAdmitted());
+  EXPECT_EQ(ticket.GetWorkloadClass(), WorkloadClass::ANALYTIC);
+  EXPECT_GE(ticket.GetWaitTime(), std::chrono::milliseconds(50));
+  EXPECT_EQ(controller.GetQueueDepth(WorkloadClass::ANALYTIC), 0);
+  EXPECT_EQ(controller.GetNumTimedOut(WorkloadClass::ANALYTIC), 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AdmissionControllerTests, MemoryTest) {
+  AdmissionController controller(10, 10, 1000.0, 100, std::chrono::milliseconds(0));
+  auto first = controller.Admit(WorkloadClass::OLTP, 60);
+  EXPECT_TRUE(first.IsAdmitted());
+  EXPECT_EQ(controller.GetReservedMemory(), 60);
+
+  // The budget is shared by the workload classes
+  EXPECT_FALSE(controller.Admit(WorkloadClass::ANALYTIC, 60).IsAdmitted());
+  auto second = controller.Admit(WorkloadClass::ANALYTIC, 40);
+  EXPECT_TRUE(second.IsAdmitted());
+  EXPECT_EQ(controller.GetReservedMemory(), 100);
+
+  // A query that needs more than the whole budget runs once nothing else holds memory
+  EXPECT_FALSE(controller.Admit(WorkloadClass::OLTP, 500).IsAdmitted());
+  first.Release();
+  second.Release();
+  EXPECT_EQ(controller.GetReservedMemory(), 0);
+  auto large = controller.Admit(WorkloadClass::OLTP, 500);
+  EXPECT_TRUE(large.IsAdmitted());
+  EXPECT_FALSE(controller.Admit(WorkloadClass::OLTP, 1).IsAdmitted());
+}
+
+// NOLINTNEXTLINE
+TEST_F(AdmissionControllerTests, EstimateMemoryTest) {
+  auto scan = planner::SeqScanPlanNode::Builder()
+                  .SetOutputSchema(BuildOneColumnSchema("a", type::TypeId::BIGINT))
+                  .SetTableOid(catalog::table_oid_t(1))
+                  .SetDatabaseOid(catalog::db_oid_t(0))
+                  .SetIsForUpdateFlag(false)
+                  .SetPlanNodeId(planner::plan_node_id_t(1))
+                  .Build();
+  auto sort = planner::OrderByPlanNode::Builder()
+                  .SetOutputSchema(BuildOneColumnSchema("a", type::TypeId::BIGINT))
+                  .SetPlanNodeId(planner::plan_node_id_t(2))
+                  .AddChild(std::move(scan))
+                  .Build();
+  const auto plan = common::ManagedPointer(sort).CastManagedPointerTo<planner::AbstractPlanNode>();
+
+  // Without cardinalities nothing is known about the plan
+  planner::PlanMetaData plan_meta_data;
+  EXPECT_EQ(AdmissionController::EstimateMemory(plan, common::ManagedPointer(&plan_meta_data)), 0);
+
+  // A sort holds every tuple of its input, along with a pointer to it
+  plan_meta_data.AddPlanNodeMetaData(planner::plan_node_id_t(1),
+                                     planner::PlanMetaData::PlanNodeMetaData(1000, 1000, {}));
+  plan_meta_data.AddPlanNodeMetaData(planner::plan_node_id_t(2),
+                                     planner::PlanMetaData::PlanNodeMetaData(1000, 0, {}));
+  EXPECT_EQ(AdmissionController::EstimateMemory(plan, common::ManagedPointer(&plan_meta_data)),
+            1000 * (sizeof(int64_t) + sizeof(byte *)));
+}
+
+}  // namespace noisepage::trafficcop
@@ -0,0 +1,185 @@
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "execution/sql/value.h"
+#include "gtest/gtest.h"
+#include "main/db_main.h"
+#include "network/connection_context.h"
+#include "network/network_io_utils.h"
+#include "network/postgres/portal.h"
+#include "network/postgres/postgres_packet_writer.h"
+#include "network/postgres/statement.h"
+#include "optimizer/optimize_result.h"
+#include "parser/expression/constant_value_expression.h"
+#include "settings/settings_manager.h"
+#include "test_util/test_harness.h"
+#include "traffic_cop/traffic_cop.h"
+#include "traffic_cop/traffic_cop_defs.h"
+
+namespace noisepage::trafficcop {
+
+/**
+ * Drives the plan cache of prepared statements with parameters through Bind, the way the network layer does
+ */
+class PlanCacheTests : public TerrierTest {
+ protected:
+  void SetUp() override {
+    TerrierTest::SetUp();
+    std::unordered_map<settings::Param, settings::ParamInfo> param_map;
+    settings::SettingsManager::ConstructParamMap(param_map);
+    db_main_ = DBMain::Builder()
+                   .SetSettingsParameterMap(std::move(param_map))
+                   .SetUseSettingsManager(true)
+                   .SetUseGC(true)
+                   .SetUseCatalog(true)
+                   .SetUseStatsStorage(true)
+                   .SetUseTrafficCop(true)
+                   .SetUseExecution(true)
+                   .Build();
+    tcop_ = db_main_->GetTrafficCop();
+    ASSERT_TRUE(tcop_->UseQueryCache());
+    custom_plan_executions_ =
+        static_cast<uint32_t>(db_main_->GetSettingsManager()->GetInt(settings::Param::custom_plan_executions));
+    ASSERT_GT(custom_plan_executions_, 0);
+
+    auto oids = tcop_->CreateTempNamespace(network::connection_id_t(0), "noisepage");
+    context_.SetDatabaseName("noisepage");
+    context_.SetDatabaseOid(oids.first);
+    context_.SetTempNamespaceOid(oids.second);
+
+    // a is unique from 1 to NUM_ROWS, so the selectivity of a range over it follows its bound
+    RunQuery("CREATE TABLE t (a INT, b INT);");
+    std::string insert = "INSERT INTO t VALUES ";
+    for (uint32_t row = 1; row <= NUM_ROWS; row++) {
+      insert += (row == 1 ? "(" : ", (") + std::to_string(row) + ", " + std::to_string(row) + ")";
+    }
+    RunQuery(insert + ";");
+    RunQuery("ANALYZE t;");
+  }
+
+  /** Runs a query without parameters in a transaction of its own */
+  void RunQuery(std::string query) {
+    tcop_->BeginTransaction(common::ManagedPointer(&context_));
+    auto parse = tcop_->ParseQuery(query, common::ManagedPointer(&context_));
+    network::Statement statement(std::move(query), std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse)));
+    const auto statement_ptr = common::ManagedPointer(&statement);
+    auto result = tcop_->BindQuery(common::ManagedPointer(&context_), statement_ptr, nullptr);
+    ASSERT_EQ(result.type_, ResultType::COMPLETE);
+    tcop_->PlanBoundQuery(common::ManagedPointer(&context_), statement_ptr, nullptr);
+
+    network::WriteQueue queue;
+    auto writer = network::PostgresPacketWriter(common::ManagedPointer(&queue));
+    if (statement.GetQueryType() == network::QueryType::QUERY_CREATE_TABLE) {
+      result = tcop_->ExecuteCreateStatement(common::ManagedPointer(&context_),
+                                             statement.OptimizeResult()->GetPlanNode(), statement.GetQueryType());
+    } else {
+      network::Portal portal(statement_ptr);
+      result = tcop_->CodegenPhysicalPlan(common::ManagedPointer(&context_), common::ManagedPointer(&writer),
+                                          common::ManagedPointer(&portal));
+      ASSERT_EQ(result.type_, ResultType::COMPLETE);
+      result = tcop_->RunExecutableQuery(common::ManagedPointer(&context_), common::ManagedPointer(&writer),
+                                         common::ManagedPointer(&portal));
+    }
+    ASSERT_EQ(result.type_, ResultType::COMPLETE);
+    tcop_->EndTransaction(common::ManagedPointer(&context_), network::QueryType::QUERY_COMMIT);
+  }
+
+  /** @return a prepared statement with a single INTEGER parameter */
+  std::unique_ptr<network::Statement> Prepare(std::string query) {
+    auto parse = tcop_->ParseQuery(query, common::ManagedPointer(&context_));
+    return std::make_unique<network::Statement>(std::move(query),
+                                                std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse)),
+                                                std::vector<type::TypeId>{type::TypeId::INTEGER});
+  }
+
+  /**
+   * Binds a prepared statement to a value, as a Bind message does
+   * @return the plan the statement was given for the value
+   */
+  common::ManagedPointer<optimizer::OptimizeResult> Bind(network::Statement *statement, int32_t value) {
+    std::vector<parser::ConstantValueExpression> params;
+    params.emplace_back(type::TypeId::INTEGER, execution::sql::Integer(value));
+    const auto statement_ptr = common::ManagedPointer(statement);
+    tcop_->BeginTransaction(common::ManagedPointer(&context_));
+    const auto result =
+        tcop_->BindQuery(common::ManagedPointer(&context_), statement_ptr, common::ManagedPointer(&params));
+    EXPECT_EQ(result.type_, ResultType::COMPLETE);
+    tcop_->PlanBoundQuery(common::ManagedPointer(&context_), statement_ptr, common::ManagedPointer(&params));
+    tcop_->EndTransaction(common::ManagedPointer(&context_), network::QueryType::QUERY_COMMIT);
+    return statement->OptimizeResult();
+  }
+
+  /** Binds a prepared statement custom_plan_executions times, each of which must be optimized for its value */
+  void BindCustomPlans(network::Statement *statement, int32_t value) {
+    common::ManagedPointer<optimizer::OptimizeResult> previous = nullptr;
+    for (uint32_t i = 0; i < custom_plan_executions_; i++) {
+      const auto plan = Bind(statement, value);
+      EXPECT_NE(plan, previous);
+      EXPECT_EQ(statement->GetNumCustomPlans(), i + 1);
+      EXPECT_FALSE(statement->HasGenericPlan());
+      previous = plan;
+    }
+  }
+
+  static constexpr uint32_t NUM_ROWS = 2000;
+
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<TrafficCop> tcop_;
+  network::ConnectionContext context_;
+  uint32_t custom_plan_executions_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(PlanCacheTests, GenericPlanTest) {
+  // The generic plan assumes a third of the rows, fewer than the custom plans for half of them and so cheaper
+  auto statement = Prepare("SELECT b FROM t WHERE a > $1;");
+  BindCustomPlans(statement.get(), NUM_ROWS / 2);
+
+  // The generic plan is kept and used for values about as selective as it assumed
+  const auto generic_plan = Bind(statement.get(), NUM_ROWS / 2);
+  ASSERT_TRUE(statement->HasGenericPlan());
+  EXPECT_FALSE(statement->IsGenericPlanRejected());
+  EXPECT_TRUE(statement->IsGenericPlanActive());
+  EXPECT_EQ(generic_plan, statement->GenericOptimizeResult());
+  EXPECT_EQ(Bind(statement.get(), NUM_ROWS * 3 / 5), generic_plan);
+
+  // A handful of rows is too far off, so the value gets a custom plan while the generic plan is set aside
+  const auto custom_plan = Bind(statement.get(), NUM_ROWS - 10);
+  EXPECT_NE(custom_plan, generic_plan);
+  EXPECT_FALSE(statement->IsGenericPlanActive());
+  EXPECT_EQ(statement->GenericOptimizeResult(), generic_plan);
+
+  // That custom plan, with its code, serves the next value of about the same selectivity
+  EXPECT_EQ(Bind(statement.get(), NUM_ROWS - 5), custom_plan);
+  EXPECT_FALSE(statement->IsGenericPlanActive());
+
+  // Values that suit the generic plan switch back to it
+  EXPECT_EQ(Bind(statement.get(), NUM_ROWS / 2), generic_plan);
+  EXPECT_TRUE(statement->IsGenericPlanActive());
+}
+
+// NOLINTNEXTLINE
+TEST_F(PlanCacheTests, RejectedGenericPlanTest) {
+  // The custom plans expect no rows at all, against a third of the rows for the generic plan
+  auto statement = Prepare("SELECT b FROM t WHERE a < $1;");
+  BindCustomPlans(statement.get(), 1);
+  const auto last_custom_plan = statement->OptimizeResult();
+
+  // The generic plan is rejected, and the last custom plan still suits the value
+  EXPECT_EQ(Bind(statement.get(), 1), last_custom_plan);
+  EXPECT_TRUE(statement->IsGenericPlanRejected());
+  EXPECT_FALSE(statement->HasGenericPlan());
+
+  // A value that selects most of the table is re-optimized, and its plan is kept for similar values
+  const auto custom_plan = Bind(statement.get(), NUM_ROWS * 3 / 4);
+  EXPECT_NE(custom_plan, last_custom_plan);
+  EXPECT_EQ(Bind(statement.get(), NUM_ROWS * 7 / 10), custom_plan);
+  EXPECT_EQ(statement->GetNumCustomPlans(), custom_plan_executions_);
+  EXPECT_FALSE(statement->HasGenericPlan());
+}
+
+}  // namespace noisepage::trafficcop
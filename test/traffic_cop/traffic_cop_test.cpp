@@ -1,15 +1,21 @@
 #include "traffic_cop/traffic_cop.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <pqxx/pqxx>  // NOLINT
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "common/json.h"
 #include "common/settings.h"
 #include "gtest/gtest.h"
 #include "main/db_main.h"
+#include "network/postgres/postgres_packet_writer.h"
+#include "test_util/manual_packet_util.h"
 #include "test_util/test_harness.h"
 
 namespace noisepage::trafficcop {
@@ -144,6 +150,35 @@ TEST_F(TrafficCopTests, BasicTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, ExplainPipelinesTest) {
+  StartServer(false);
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data TEXT);");
+    txn1.exec("INSERT INTO TableA VALUES (1, 'abc');");
+
+    // The JSON plan of a compiled query lists how each of its pipelines would run
+    pqxx::result r = txn1.exec("EXPLAIN (FORMAT JSON) SELECT * FROM TableA WHERE data = 'abc'");
+    ASSERT_EQ(r.size(), 1);
+    const auto plan = nlohmann::json::parse(r[0][0].as<std::string>());
+    ASSERT_TRUE(plan.contains("pipelines"));
+    ASSERT_EQ(plan["pipelines"].size(), 1);
+    const auto &pipeline = plan["pipelines"][0];
+    EXPECT_EQ(pipeline["steps"].get<std::string>().rfind("seqscan", 0), 0);
+    EXPECT_TRUE(pipeline.contains("estimated_input_rows"));
+    // TableA is far too small to be worth a second thread
+    EXPECT_EQ(pipeline["degree_of_parallelism"], 1);
+
+    txn1.commit();
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
 /**
  * Test whether a temporary namespace is created for a connection to the database
  */
@@ -210,4 +245,283 @@ TEST_F(TrafficCopTests, AsyncCommitTest) {
   }
 }
 
+/**
+ * Pipeline many Bind/Execute pairs behind a single Parse and Sync, as JDBC batches and libpq pipeline mode do, and
+ * check that every one of them is executed and committed with the implicit transaction.
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, PipelinedExtendedQueryTest) {
+  StartServer(false);
+  constexpr uint32_t num_inserts = 200;
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY);");
+    txn1.commit();
+
+    auto io_socket_unique_ptr = network::ManualPacketUtil::StartConnection(port_);
+    auto io_socket = common::ManagedPointer(io_socket_unique_ptr);
+    io_socket->GetWriteQueue()->Reset();
+    network::PostgresPacketWriter writer(io_socket->GetWriteQueue());
+    writer.WriteParseCommand("insert", "INSERT INTO TableA VALUES ($1);",
+                             {static_cast<int32_t>(network::PostgresValueType::INTEGER)});
+    for (uint32_t i = 0; i < num_inserts; i++) {
+      const auto text = std::to_string(i);
+      std::vector<char> param(text.begin(), text.end());
+      writer.WriteBindCommand("", "insert", {}, {&param}, {});
+      writer.WriteExecuteCommand("", 0);
+    }
+    writer.WriteSyncCommand();
+    io_socket->FlushAllWrites();
+
+    EXPECT_TRUE(network::ManualPacketUtil::ReadUntilReadyOrClose(io_socket));
+    network::ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+    io_socket->Close();
+
+    pqxx::work txn2(connection);
+    pqxx::result r = txn2.exec("SELECT * FROM TableA");
+    EXPECT_EQ(r.size(), num_inserts);
+    txn2.commit();
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
+/**
+ * Bind a parameter that is much larger than the connection's read buffer, which has to grow to read it in place.
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, LargeParameterTest) {
+  StartServer(false);
+  const std::string large_value(1 << 20, 'x');
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data VARCHAR);");
+    txn1.commit();
+
+    auto io_socket_unique_ptr = network::ManualPacketUtil::StartConnection(port_);
+    auto io_socket = common::ManagedPointer(io_socket_unique_ptr);
+    io_socket->GetWriteQueue()->Reset();
+    network::PostgresPacketWriter writer(io_socket->GetWriteQueue());
+    writer.WriteParseCommand("", "INSERT INTO TableA VALUES ($1, $2);",
+                             {static_cast<int32_t>(network::PostgresValueType::INTEGER),
+                              static_cast<int32_t>(network::PostgresValueType::VARCHAR)});
+    std::vector<char> id{'1'};
+    std::vector<char> data(large_value.begin(), large_value.end());
+    writer.WriteBindCommand("", "", {}, {&id, &data}, {});
+    writer.WriteExecuteCommand("", 0);
+    writer.WriteSyncCommand();
+    io_socket->FlushAllWrites();
+    EXPECT_TRUE(network::ManualPacketUtil::ReadUntilReadyOrClose(io_socket));
+    network::ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+    io_socket->Close();
+
+    pqxx::work txn2(connection);
+    pqxx::result r = txn2.exec("SELECT data FROM TableA WHERE id = 1");
+    ASSERT_EQ(r.size(), 1);
+    EXPECT_EQ(r[0][0].as<std::string>(), large_value);
+    txn2.commit();
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
+/**
+ * Reads the server's messages up to ReadyForQuery.
+ * @return type and payload of every message, including the ReadyForQuery, or nullopt if the connection was closed
+ */
+static std::optional<std::vector<std::pair<network::NetworkMessageType, std::string>>> ReadMessages(
+    const common::ManagedPointer<network::NetworkIoWrapper> io_socket) {
+  std::string bytes;
+  std::vector<std::pair<network::NetworkMessageType, std::string>> messages;
+  size_t pos = 0;
+  while (true) {
+    // Go through the complete messages received so far
+    while (bytes.size() - pos >= 1 + sizeof(int32_t)) {
+      const auto type = static_cast<network::NetworkMessageType>(bytes[pos]);
+      int32_t size;
+      std::memcpy(&size, bytes.data() + pos + 1, sizeof(size));
+      size = static_cast<int32_t>(ntohl(static_cast<uint32_t>(size)));
+      if (bytes.size() - pos < 1 + static_cast<size_t>(size)) break;
+      messages.emplace_back(type, bytes.substr(pos + 1 + sizeof(int32_t), size - sizeof(int32_t)));
+      pos += 1 + size;
+      if (type == network::NetworkMessageType::PG_READY_FOR_QUERY) return messages;
+    }
+
+    io_socket->GetReadBuffer()->Reset();
+    if (io_socket->FillReadBuffer() == network::Transition::TERMINATE) return std::nullopt;
+    const auto available = io_socket->GetReadBuffer()->BytesAvailable();
+    bytes += io_socket->GetReadBuffer()->ReadIntoView(available).ReadString(available);
+  }
+}
+
+/**
+ * Reads the server's messages up to ReadyForQuery.
+ * @return payloads of the CopyData messages among them, or nullopt if the COPY TO STDOUT was not answered as expected
+ */
+static std::optional<std::vector<std::string>> ReadCopyOutData(
+    const common::ManagedPointer<network::NetworkIoWrapper> io_socket) {
+  const auto messages = ReadMessages(io_socket);
+  if (!messages.has_value()) return std::nullopt;
+  std::vector<std::string> copy_data;
+  bool copy_out_response = false, copy_done = false;
+  for (const auto &[type, payload] : *messages) {
+    if (type == network::NetworkMessageType::PG_COPY_OUT_RESPONSE) copy_out_response = true;
+    if (type == network::NetworkMessageType::PG_COPY_DATA) copy_data.emplace_back(payload);
+    if (type == network::NetworkMessageType::PG_COPY_DONE) copy_done = true;
+  }
+  if (!copy_out_response || !copy_done) return std::nullopt;
+  return copy_data;
+}
+
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, CopyTest) {
+  StartServer(false);
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY, name VARCHAR, flag BOOLEAN);");
+    txn1.commit();
+
+    auto io_socket_unique_ptr = network::ManualPacketUtil::StartConnection(port_);
+    auto io_socket = common::ManagedPointer(io_socket_unique_ptr);
+    io_socket->GetWriteQueue()->Reset();
+    network::PostgresPacketWriter writer{io_socket->GetWriteQueue()};
+
+    const auto copy_in = [&](const std::string &query, const std::vector<std::string> &data) {
+      writer.WriteSimpleQuery(query);
+      io_socket->FlushAllWrites();
+      EXPECT_TRUE(network::ManualPacketUtil::ReadUntilMessageOrClose(
+          io_socket, network::NetworkMessageType::PG_COPY_IN_RESPONSE));
+      for (const auto &chunk : data) {
+        writer.BeginPacket(network::NetworkMessageType::PG_COPY_DATA).AppendStringView(chunk, false).EndPacket();
+      }
+      writer.WriteSingleTypePacket(network::NetworkMessageType::PG_COPY_DONE);
+      io_socket->FlushAllWrites();
+      EXPECT_TRUE(network::ManualPacketUtil::ReadUntilReadyOrClose(io_socket));
+    };
+
+    // Text format, with a row that spans two CopyData messages
+    copy_in("COPY TableA FROM STDIN", {"1\tone\tt\n2\ttwo\\t", "tab\tf\n3\t\\N\ttrue\n"});
+    // CSV with a column list, up to the end-of-data marker
+    copy_in("COPY TableA (id, name) FROM STDIN WITH (FORMAT csv)", {"4,\"quoted, \"\"name\"\"\"\n5,\n\\.\n"});
+    // A value that does not fit its column fails the whole COPY
+    copy_in("COPY TableA FROM STDIN", {"6\tsix\tt\nseven\tseven\tf\n"});
+
+    pqxx::work txn2(connection);
+    pqxx::result r = txn2.exec("SELECT COUNT(*) FROM TableA");
+    EXPECT_EQ(r[0][0].as<int>(), 5);
+    r = txn2.exec("SELECT name FROM TableA WHERE id = 2");
+    EXPECT_EQ(r[0][0].as<std::string>(), "two\ttab");
+    r = txn2.exec("SELECT name FROM TableA WHERE id = 4");
+    EXPECT_EQ(r[0][0].as<std::string>(), "quoted, \"name\"");
+    r = txn2.exec("SELECT name, flag FROM TableA WHERE id = 5");
+    EXPECT_TRUE(r[0][0].is_null());
+    EXPECT_TRUE(r[0][1].is_null());
+    txn2.commit();
+
+    writer.WriteSimpleQuery(
+        "COPY (SELECT id, name, flag FROM TableA WHERE id < 6 ORDER BY id) TO STDOUT WITH (FORMAT csv)");
+    io_socket->FlushAllWrites();
+    auto rows = ReadCopyOutData(io_socket);
+    ASSERT_TRUE(rows.has_value());
+    EXPECT_EQ(*rows, std::vector<std::string>({"1,one,t\n", "2,two\ttab,f\n", "3,,t\n",
+                                                "4,\"quoted, \"\"name\"\"\",\n", "5,,\n"}));
+
+    // COPY table TO STDOUT in the text format, which does not guarantee an order
+    writer.WriteSimpleQuery("COPY TableA (id, name) TO STDOUT");
+    io_socket->FlushAllWrites();
+    rows = ReadCopyOutData(io_socket);
+    ASSERT_TRUE(rows.has_value());
+    std::sort(rows->begin(), rows->end());
+    EXPECT_EQ(*rows, std::vector<std::string>({"1\tone\n", "2\ttwo\\ttab\n", "3\t\\N\n",
+                                                "4\tquoted, \"name\"\n", "5\t\\N\n"}));
+
+    // More rows than a batch, which are inserted many rows per INSERT and then one by one for the rows left over
+    pqxx::work txn3(connection);
+    txn3.exec("CREATE TABLE TableB (id INT PRIMARY KEY, value INT);");
+    txn3.commit();
+    constexpr int num_rows = 1500;
+    std::string data;
+    for (int id = 1; id <= num_rows; id++) data += std::to_string(id) + "\t" + std::to_string(id * 2) + "\n";
+    copy_in("COPY TableB FROM STDIN", {data});
+
+    pqxx::work txn4(connection);
+    r = txn4.exec("SELECT COUNT(*), SUM(id), SUM(value) FROM TableB");
+    EXPECT_EQ(r[0][0].as<int>(), num_rows);
+    EXPECT_EQ(r[0][1].as<int64_t>(), int64_t{num_rows} * (num_rows + 1) / 2);
+    EXPECT_EQ(r[0][2].as<int64_t>(), int64_t{num_rows} * (num_rows + 1));
+    r = txn4.exec("SELECT value FROM TableB WHERE id = 1499");
+    EXPECT_EQ(r[0][0].as<int>(), 2998);
+    txn4.commit();
+
+    network::ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+    io_socket->Close();
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, PortalSuspendTest) {
+  StartServer(false);
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY);");
+    for (int32_t i = 1; i <= 10; i++) txn1.exec(fmt::format("INSERT INTO TableA VALUES ({0});", i));
+    txn1.commit();
+
+    auto io_socket_unique_ptr = network::ManualPacketUtil::StartConnection(port_);
+    auto io_socket = common::ManagedPointer(io_socket_unique_ptr);
+    io_socket->GetWriteQueue()->Reset();
+    network::PostgresPacketWriter writer{io_socket->GetWriteQueue()};
+
+    // Summarizes the server's answer as one letter per message, e.g. "DDs" for two rows and a PortalSuspended
+    const auto read_answer = [&] {
+      const auto messages = ReadMessages(io_socket);
+      std::string answer;
+      if (messages.has_value()) {
+        for (const auto &message : *messages) answer += static_cast<char>(message.first);
+      }
+      return answer;
+    };
+
+    // Fetch the result four rows at a time
+    writer.WriteParseCommand("", "SELECT id FROM TableA ORDER BY id", {});
+    writer.WriteBindCommand("", "", {}, {}, {});
+    for (uint32_t i = 0; i < 3; i++) writer.WriteExecuteCommand("", 4);
+    writer.WriteSyncCommand();
+    io_socket->FlushAllWrites();
+    EXPECT_EQ(read_answer(), "12DDDDsDDDDsDDCZ");
+
+    // A portal that is closed while suspended stops its query, and the connection stays usable
+    writer.WriteParseCommand("", "SELECT id FROM TableA ORDER BY id", {});
+    writer.WriteBindCommand("", "", {}, {}, {});
+    writer.WriteExecuteCommand("", 2);
+    writer.WriteCloseCommand(network::DescribeCommandObjectType::PORTAL, "");
+    writer.WriteSyncCommand();
+    io_socket->FlushAllWrites();
+    EXPECT_EQ(read_answer(), "12DDs3Z");
+
+    // Without a row limit, the whole result is sent at once
+    writer.WriteParseCommand("", "SELECT id FROM TableA ORDER BY id", {});
+    writer.WriteBindCommand("", "", {}, {}, {});
+    writer.WriteExecuteCommand("", 0);
+    writer.WriteSyncCommand();
+    io_socket->FlushAllWrites();
+    EXPECT_EQ(read_answer(), "12DDDDDDDDDDCZ");
+
+    network::ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+    io_socket->Close();
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
 }  // namespace noisepage::trafficcop